@@ -760,6 +760,31 @@ void DOTPROD(_print)(DOTPROD() _q);                                         \
 void DOTPROD(_execute)(DOTPROD() _q,                                        \
                        TI *      _x,                                        \
                        TO *      _y);                                       \
+                                                                            \
+/* Execute dot products on _m consecutive windows of an input array,    */  \
+/* _y[i] = dot(h, _x[i:i+_n-1]), reusing each coefficient across        */  \
+/* several outputs                                                      */  \
+/*  _q      : dotprod object                                            */  \
+/*  _x      : input array [size: _n+_m-1 x 1]                           */  \
+/*  _m      : number of outputs                                         */  \
+/*  _y      : output array [size: _m x 1]                               */  \
+void DOTPROD(_execute_block)(DOTPROD()    _q,                               \
+                             TI *         _x,                               \
+                             unsigned int _m,                               \
+                             TO *         _y);                              \
+                                                                            \
+/* Execute a bank of _m dot products sharing one input array. The      */  \
+/* object's _n coefficients are read as an _m-column matrix stored one  */  \
+/* tap at a time, _y[i] = sum_k v[k*_m+i] _x[k], so that each input     */  \
+/* sample is loaded once for all _m outputs.                            */  \
+/*  _q      : dotprod object of length _n, a multiple of _m             */  \
+/*  _x      : input array [size: _n/_m x 1]                             */  \
+/*  _m      : number of outputs                                         */  \
+/*  _y      : output array [size: _m x 1]                               */  \
+void DOTPROD(_execute_bank)(DOTPROD()    _q,                                \
+                            TI *         _x,                                \
+                            unsigned int _m,                                \
+                            TO *         _y);                               \
 
 LIQUID_DOTPROD_DEFINE_API(LIQUID_DOTPROD_MANGLE_RRRF,
                           float,
@@ -1084,7 +1109,7 @@ unsigned int crc_sizeof_key(crc_scheme _scheme);
 
 
 // available FEC schemes
-#define LIQUID_FEC_NUM_SCHEMES  28
+#define LIQUID_FEC_NUM_SCHEMES  31
 typedef enum {
     LIQUID_FEC_UNKNOWN=0,       // unknown/unsupported scheme
     LIQUID_FEC_NONE,            // no error-correction
@@ -1121,7 +1146,12 @@ typedef enum {
     LIQUID_FEC_CONV_V29P78,     // r7/8, K=9, dfree=4
 
     // Reed-Solomon codes
-    LIQUID_FEC_RS_M8            // m=8, n=255, k=223
+    LIQUID_FEC_RS_M8,           // m=8, n=255, k=223
+
+    // quasi-cyclic low-density parity-check codes (IEEE 802.11n)
+    LIQUID_FEC_LDPC_N648,       // r1/2, n=648
+    LIQUID_FEC_LDPC_N1296,      // r1/2, n=1296
+    LIQUID_FEC_LDPC_N1944       // r1/2, n=1944
 } fec_scheme;
 
 // pretty names for fec schemes
@@ -1138,6 +1168,9 @@ typedef struct fec_s * fec;
 
 // return the encoded message length using a particular error-
 // correction scheme (object-independent method)
+// NOTE: LIQUID_FEC_RS_M8 assumes the default RS(255,223) code; use
+//       fecrsprops_get_enc_msg_length() or fec_get_enc_msg_len() for
+//       codes created with other properties
 //  _scheme     :   forward error-correction scheme
 //  _msg_len    :   raw, uncoded message length
 unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
@@ -1145,18 +1178,42 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
 
 // get the theoretical rate of a particular forward error-
 // correction scheme (object-independent method)
+// NOTE: LIQUID_FEC_RS_M8 assumes the default RS(255,223) code; use
+//       fec_get_code_rate() for codes created with other properties
 float fec_get_rate(fec_scheme _scheme);
 
+// Reed-Solomon code properties, passed as the _opts argument of
+// fec_create() with LIQUID_FEC_RS_M8; messages are split into blocks
+// of at most kk data symbols, each followed by nroots parity symbols
+// and shortened to fit the message
+typedef struct {
+    unsigned int nroots;    // parity symbols per block, 0 < nroots < 255
+    unsigned int kk;        // data symbols per block, kk + nroots <= 255
+} fecrsprops_s;
+
+// initialize Reed-Solomon properties to the defaults, RS(255,223)
+void fecrsprops_init_default(fecrsprops_s * _props);
+
+// return the encoded message length using a Reed-Solomon code with
+// particular properties (NULL selects the defaults); this must be used
+// instead of fec_get_enc_msg_length() for non-default codes
+//  _props      :   code properties
+//  _msg_len    :   raw, uncoded message length
+unsigned int fecrsprops_get_enc_msg_length(fecrsprops_s * _props,
+                                           unsigned int   _msg_len);
+
 // create a fec object of a particular scheme
 //  _scheme     :   error-correction scheme
-//  _opts       :   (ignored)
+//  _opts       :   scheme options: fecrsprops_s for LIQUID_FEC_RS_M8,
+//                  ignored otherwise (NULL selects defaults)
 fec fec_create(fec_scheme _scheme,
                void *_opts);
 
 // recreate fec object
 //  _q          :   old fec object
 //  _scheme     :   new error-correction scheme
-//  _opts       :   (ignored)
+//  _opts       :   scheme options (see fec_create()); the object is
+//                  rebuilt if the scheme changes or _opts is not NULL
 fec fec_recreate(fec _q,
                  fec_scheme _scheme,
                  void *_opts);
@@ -1167,6 +1224,17 @@ void fec_destroy(fec _q);
 // print fec object internals
 void fec_print(fec _q);
 
+// get the rate of a fec object, including options given at creation
+// (e.g. Reed-Solomon properties)
+float fec_get_code_rate(fec _q);
+
+// return the encoded message length for a fec object, including
+// options given at creation (e.g. Reed-Solomon properties)
+//  _q          :   fec object
+//  _msg_len    :   raw, uncoded message length
+unsigned int fec_get_enc_msg_len(fec          _q,
+                                 unsigned int _msg_len);
+
 // encode a block of data using a fec scheme
 //  _q              :   fec object
 //  _dec_msg_len    :   decoded message length
@@ -1197,6 +1265,31 @@ void fec_decode_soft(fec _q,
                      unsigned char * _msg_enc,
                      unsigned char * _msg_dec);
 
+// decode several blocks of data stored one after another; Reed-Solomon
+// codewords of all blocks are decoded together
+//  _q              :   fec object
+//  _dec_msg_len    :   decoded message length (each block)
+//  _num            :   number of blocks
+//  _msg_enc        :   encoded messages [size: _num*enc_msg_len x 1]
+//  _msg_dec        :   decoded messages [size: _num*_dec_msg_len x 1]
+void fec_decode_block(fec _q,
+                      unsigned int _dec_msg_len,
+                      unsigned int _num,
+                      unsigned char * _msg_enc,
+                      unsigned char * _msg_dec);
+
+// decode several blocks of data stored one after another (soft decision)
+//  _q              :   fec object
+//  _dec_msg_len    :   decoded message length (each block)
+//  _num            :   number of blocks
+//  _msg_enc        :   encoded messages (soft bits) [size: 8*_num*enc_msg_len x 1]
+//  _msg_dec        :   decoded messages [size: _num*_dec_msg_len x 1]
+void fec_decode_soft_block(fec _q,
+                           unsigned int _dec_msg_len,
+                           unsigned int _num,
+                           unsigned char * _msg_enc,
+                           unsigned char * _msg_dec);
+
 // 
 // Packetizer
 //
@@ -1292,6 +1385,66 @@ int packetizer_decode_soft(packetizer            _p,
                            const unsigned char * _pkt,
                            unsigned char *       _msg);
 
+// get length of scratch buffer required by the _scratch methods below
+// (bytes); the length only depends on the encoded message length
+unsigned int packetizer_get_scratch_len(packetizer _p);
+
+// Execute the packetizer on an input message using caller-supplied
+// scratch memory in place of the object's internal buffer; _msg and _pkt
+// may point to the same memory
+//
+//  _p      :   packetizer object
+//  _msg    :   input message (uncoded bytes)
+//  _pkt    :   encoded output message
+//  _buf    :   scratch memory [size: packetizer_get_scratch_len() x 1]
+void packetizer_encode_scratch(packetizer            _p,
+                               const unsigned char * _msg,
+                               unsigned char *       _pkt,
+                               unsigned char *       _buf);
+
+// Decode an input message using caller-supplied scratch memory, return
+// validity check of resulting data; _pkt and _msg may point to the same
+// memory
+//
+//  _p      :   packetizer object
+//  _pkt    :   input message (coded bytes)
+//  _msg    :   decoded output message
+//  _buf    :   scratch memory [size: packetizer_get_scratch_len() x 1]
+int packetizer_decode_scratch(packetizer            _p,
+                              const unsigned char * _pkt,
+                              unsigned char *       _msg,
+                              unsigned char *       _buf);
+
+// Decode an input message of soft bits using caller-supplied scratch
+// memory, return validity check of resulting data
+//
+//  _p      :   packetizer object
+//  _pkt    :   input message (coded soft bits)
+//  _msg    :   decoded output message
+//  _buf    :   scratch memory [size: packetizer_get_scratch_len() x 1]
+int packetizer_decode_soft_scratch(packetizer            _p,
+                                   const unsigned char * _pkt,
+                                   unsigned char *       _msg,
+                                   unsigned char *       _buf);
+
+// Decode a block of input messages of soft bits, returning the number
+// of messages which pass the validity check; each stage of error
+// correction runs across all messages at once (e.g. the Reed-Solomon
+// codewords of every message are decoded together)
+//
+//  _p      :   packetizer object
+//  _pkts   :   input messages (coded soft bits) [size: _num*_stride x 1]
+//  _stride :   distance between input messages, _stride >= 8*enc_msg_len
+//  _num    :   number of messages
+//  _msgs   :   decoded output messages [size: _num*msg_len x 1]
+//  _valid  :   validity check of each message [size: _num x 1] (ignored if NULL)
+unsigned int packetizer_decode_soft_block(packetizer            _p,
+                                          const unsigned char * _pkts,
+                                          unsigned int          _stride,
+                                          unsigned int          _num,
+                                          unsigned char *       _msgs,
+                                          int *                 _valid);
+
 
 //
 // interleaver
@@ -1375,8 +1528,16 @@ typedef enum {
     // modified discrete cosine transform
     LIQUID_FFT_MDCT     =  30,  // MDCT
     LIQUID_FFT_IMDCT    =  31,  // IMDCT
+
+    // real-input transforms (non-negative half of spectrum)
+    LIQUID_FFT_R2C      =  40,  // real-to-complex one-dimensional FFT
+    LIQUID_FFT_C2R      =  41,  // complex-to-real one-dimensional inverse FFT
 } liquid_fft_type;
 
+// transform plan options (_flags)
+#define LIQUID_FFT_ESTIMATE (0)     // choose method from transform size
+#define LIQUID_FFT_MEASURE  (1<<0)  // time candidate methods, record wisdom
+
 #define LIQUID_FFT_MANGLE_FLOAT(name) LIQUID_CONCAT(fft,name)
 
 // Macro    :   FFT
@@ -1412,6 +1573,54 @@ FFT(plan) FFT(_create_plan_r2r_1d)(unsigned int _n,                         \
                                    int          _type,                      \
                                    int          _flags);                    \
                                                                             \
+/* Create real-to-complex one-dimensional transform. Only the _n/2+1   */  \
+/* non-negative frequency bins of the (Hermitian) spectrum are written. */  \
+/*  _n      :   transform size                                          */  \
+/*  _x      :   pointer to input array  [size: _n x 1]                  */  \
+/*  _y      :   pointer to output array [size: _n/2+1 x 1]              */  \
+/*  _flags  :   options, optimization                                   */  \
+FFT(plan) FFT(_create_plan_r2c)(unsigned int _n,                            \
+                                T *          _x,                            \
+                                TC *         _y,                            \
+                                int          _flags);                       \
+                                                                            \
+/* Create complex-to-real one-dimensional (inverse) transform from the  */  \
+/* _n/2+1 non-negative frequency bins; output is not normalized         */  \
+/*  _n      :   transform size                                          */  \
+/*  _x      :   pointer to input array  [size: _n/2+1 x 1]              */  \
+/*  _y      :   pointer to output array [size: _n x 1]                  */  \
+/*  _flags  :   options, optimization                                   */  \
+FFT(plan) FFT(_create_plan_c2r)(unsigned int _n,                            \
+                                TC *         _x,                            \
+                                T *          _y,                            \
+                                int          _flags);                       \
+                                                                            \
+/* Create batch of regular complex one-dimensional transforms of the   */  \
+/* same size, run together with each call to execute. Sample k of       */  \
+/* transform b is read from _x[b*_idist + k*_istride] and written to    */  \
+/* _y[b*_odist + k*_ostride]; short power-of-two transforms are         */  \
+/* interleaved across SIMD lanes.                                       */  \
+/*  _n          :   transform size                                      */  \
+/*  _howmany    :   number of transforms                                */  \
+/*  _x          :   pointer to input array                              */  \
+/*  _istride    :   input sample stride, _istride > 0                   */  \
+/*  _idist      :   input distance between transforms                   */  \
+/*  _y          :   pointer to output array                             */  \
+/*  _ostride    :   output sample stride, _ostride > 0                  */  \
+/*  _odist      :   output distance between transforms                  */  \
+/*  _dir        :   direction (e.g. LIQUID_FFT_FORWARD)                 */  \
+/*  _flags      :   options, optimization                               */  \
+FFT(plan) FFT(_create_plan_many)(unsigned int _n,                           \
+                                 unsigned int _howmany,                     \
+                                 TC *         _x,                           \
+                                 unsigned int _istride,                     \
+                                 unsigned int _idist,                       \
+                                 TC *         _y,                           \
+                                 unsigned int _ostride,                     \
+                                 unsigned int _odist,                       \
+                                 int          _dir,                         \
+                                 int          _flags);                      \
+                                                                            \
 /* Destroy transform and free all internally-allocated memory           */  \
 void FFT(_destroy_plan)(FFT(plan) _p);                                      \
                                                                             \
@@ -1452,6 +1661,26 @@ void FFT(_r2r_1d_run)(unsigned int _n,                                      \
 /*  _n      : input array size                                          */  \
 void FFT(_shift)(TC *         _x,                                           \
                  unsigned int _n);                                          \
+                                                                            \
+/* Free tables (twiddle factors, index sequences) in the process-wide   */  \
+/* plan cache that are no longer used by any plan. Plans of the same    */  \
+/* size, direction and method share these tables, and they are kept     */  \
+/* after the last plan is destroyed so that new plans are cheap.        */  \
+void FFT(_cache_purge)(void);                                               \
+                                                                            \
+/* Import wisdom (fastest measured method for each transform size),     */  \
+/* adding to or replacing wisdom already recorded in this process.      */  \
+/* Returns 0 on success, -1 if file cannot be opened or parsed.         */  \
+/*  _filename   : input file name                                       */  \
+int FFT(_wisdom_import)(const char * _filename);                            \
+                                                                            \
+/* Export wisdom recorded in this process, e.g. by plans created with   */  \
+/* the LIQUID_FFT_MEASURE flag. Returns 0 on success, -1 otherwise.     */  \
+/*  _filename   : output file name                                      */  \
+int FFT(_wisdom_export)(const char * _filename);                            \
+                                                                            \
+/* Forget all wisdom recorded in this process                           */  \
+void FFT(_wisdom_forget)(void);                                             \
 
 
 LIQUID_FFT_DEFINE_API(LIQUID_FFT_MANGLE_FLOAT,float,liquid_float_complex)
@@ -3157,6 +3386,14 @@ void FIRPFB(_execute)(FIRPFB()     _q,                                      \
                       unsigned int _i,                                      \
                       TO *         _y);                                     \
                                                                             \
+/* Execute all sub-filters on the filter's internal buffer in a single  */  \
+/* pass, loading each buffered sample once for the whole bank;          */  \
+/* equivalent to calling execute() with each index in turn              */  \
+/*  _q      : firpfb object                                             */  \
+/*  _y      : output array, one sample per sub-filter [size: _M x 1]    */  \
+void FIRPFB(_execute_all)(FIRPFB() _q,                                      \
+                          TO *     _y);                                     \
+                                                                            \
 /* Execute the filter on a block of input samples, all using index _i.  */  \
 /* In-place operation is permitted (_x and _y may point to the same     */  \
 /* place in memory)                                                     */  \
@@ -3170,6 +3407,27 @@ void FIRPFB(_execute_block)(FIRPFB()     _q,                                \
                             TI *         _x,                                \
                             unsigned int _n,                                \
                             TO *         _y);                               \
+                                                                            \
+/* Execute the filter on a block of input samples, computing outputs    */  \
+/* on a schedule: output _y[j] is the result of execute() with index    */  \
+/* _i[j] once input _x[_k[j]] has been pushed. All _nx input samples    */  \
+/* are pushed into the buffer. The output array must not overlap the    */  \
+/* input array.                                                         */  \
+/*  _q      : firpfb object                                             */  \
+/*  _x      : pointer to input array [size: _nx x 1]                    */  \
+/*  _nx     : number of input samples                                   */  \
+/*  _k      : input index of each output, non-decreasing                */  \
+/*            [size: _ny x 1]                                           */  \
+/*  _i      : filter index of each output [size: _ny x 1]               */  \
+/*  _ny     : number of output samples                                  */  \
+/*  _y      : pointer to output array [size: _ny x 1]                   */  \
+void FIRPFB(_execute_schedule)(FIRPFB()       _q,                           \
+                               TI *           _x,                           \
+                               unsigned int   _nx,                          \
+                               unsigned int * _k,                           \
+                               unsigned int * _i,                           \
+                               unsigned int   _ny,                          \
+                               TO *           _y);                          \
 
 LIQUID_FIRPFB_DEFINE_API(LIQUID_FIRPFB_MANGLE_RRRF,
                          float,
@@ -4560,6 +4818,24 @@ int qpacketmodem_decode_soft(qpacketmodem           _q,
                              liquid_float_complex * _frame,
                              unsigned char *        _payload);
 
+// decode block of packets from modulated frame samples, all with the
+// object's configuration, returning the number of frames whose CRC
+// passed
+// NOTE: soft-decision decoding; the results match those of calling
+//       qpacketmodem_decode_soft() on each frame, but all frames are
+//       demodulated in one pass and each stage of error correction runs
+//       across all frames (see packetizer_decode_soft_block())
+//  _q          :   qpacketmodem object
+//  _frames     :   encoded/modulated payload symbols, [size: _num_frames*frame_len x 1]
+//  _num_frames :   number of frames
+//  _payloads   :   recovered decoded payload bytes, [size: _num_frames*payload_len x 1]
+//  _valid      :   CRC flag for each frame, [size: _num_frames x 1] (ignored if NULL)
+unsigned int qpacketmodem_decode_soft_block(qpacketmodem           _q,
+                                            liquid_float_complex * _frames,
+                                            unsigned int           _num_frames,
+                                            unsigned char *        _payloads,
+                                            int *                  _valid);
+
 int qpacketmodem_decode_soft_sym(qpacketmodem  _q,
                                  liquid_float_complex _symbol);
 
@@ -6670,6 +6946,15 @@ T SMATRIX(_get)(SMATRIX()    _q,                                            \
                 unsigned int _m,                                            \
                 unsigned int _n);                                           \
                                                                             \
+/* Get the (sorted) column indices of the non-zero elements in a row,   */  \
+/* returning the number of non-zero elements                            */  \
+/*  _q      : sparse matrix object                                      */  \
+/*  _m      : row index                                                 */  \
+/*  _idx    : output column indices (ignored if NULL)                   */  \
+unsigned int SMATRIX(_get_row_indices)(SMATRIX()      _q,                   \
+                                       unsigned int   _m,                   \
+                                       unsigned int * _idx);                \
+                                                                            \
 /* Initialize to identity matrix; set all diagonal elements to 1, all   */  \
 /* others to 0. This is done with both square and non-square matrices.  */  \
 void SMATRIX(_eye)(SMATRIX() _q);                                           \
@@ -6933,6 +7218,18 @@ void MODEM(_demodulate_soft)(MODEM()         _q,                            \
                              unsigned int  * _s,                            \
                              unsigned char * _soft_bits);                   \
                                                                             \
+/* Demodulate block of input samples and provide soft bits as an        */  \
+/* output, equivalent to calling demodulate_soft() on each sample but   */  \
+/* vectorized for BPSK and QPSK.                                        */  \
+/*  _q          : modem object                                          */  \
+/*  _x          : input samples, [size: _n x 1]                         */  \
+/*  _n          : number of input samples                               */  \
+/*  _soft_bits  : output soft bits, [size: _n*log2(M) x 1]              */  \
+void MODEM(_demodulate_soft_block)(MODEM()         _q,                      \
+                                   TC *            _x,                      \
+                                   unsigned int    _n,                      \
+                                   unsigned char * _soft_bits);             \
+                                                                            \
 /* Get demodulator's estimated transmit sample                          */  \
 void MODEM(_get_demodulator_sample)(MODEM() _q,                             \
                                     TC *    _x_hat);                        \
@@ -7468,6 +7765,85 @@ LIQUID_FIRPFBCH2_DEFINE_API(LIQUID_FIRPFBCH2_MANGLE_CRCF,
                             float,
                             liquid_float_complex)
 
+//
+// Threaded firpfbch2 analyzer with per-channel worker dispatch
+//
+
+#define LIQUID_FIRPFBCH2MT_MANGLE_CRCF(name) LIQUID_CONCAT(firpfbch2mt_crcf,name)
+
+#define LIQUID_FIRPFBCH2MT_DEFINE_API(FIRPFBCH2MT,TO,TC,TI)                 \
+                                                                            \
+/* Callback invoked with a block of outputs for one channel             */  \
+/*  _y          : channel output samples [size: _n x 1]                 */  \
+/*  _n          : number of output samples                              */  \
+/*  _channel    : channel index, 0 <= _channel < M                      */  \
+/*  _userdata   : user-defined data pointer                             */  \
+/* The return value is currently ignored.                               */  \
+typedef int (*FIRPFBCH2MT(_callback))(TO *         _y,                      \
+                                      unsigned int _n,                      \
+                                      unsigned int _channel,                \
+                                      void *       _userdata);              \
+                                                                            \
+/* Threaded firpfbch2 analysis pipeline: a producer thread runs         */  \
+/* the polyphase filterbank and transform, and each channel's           */  \
+/* output is handed to a pool of worker threads through                 */  \
+/* single-producer, single-consumer ring buffers. Channel k is          */  \
+/* always served by worker k % num_workers, so callbacks for a          */  \
+/* channel run in order on one thread and may use objects that          */  \
+/* are not thread-safe without locking.                                 */  \
+typedef struct FIRPFBCH2MT(_s) * FIRPFBCH2MT();                             \
+                                                                            \
+/* create threaded analyzer using Kaiser window prototype               */  \
+/*  _M          : number of channels (must be even)                     */  \
+/*  _m          : prototype filter semi-length, length=2*M*m+1          */  \
+/*  _As         : filter stop-band attenuation [dB]                     */  \
+/*  _num_workers: number of worker threads; 0 runs the                  */  \
+/*                analyzer and callbacks on the calling thread          */  \
+/*  _block_len  : output samples per channel per callback               */  \
+/*  _callback   : user-defined callback function                        */  \
+/*  _userdata   : user-defined data pointer                             */  \
+FIRPFBCH2MT() FIRPFBCH2MT(_create)(unsigned int           _M,               \
+                                   unsigned int           _m,               \
+                                   float                  _As,              \
+                                   unsigned int           _num_workers,     \
+                                   unsigned int           _block_len,       \
+                                   FIRPFBCH2MT(_callback) _callback,        \
+                                   void *                 _userdata);       \
+                                                                            \
+/* destroy object, delivering all pending outputs to the                */  \
+/* callbacks before stopping threads and freeing memory                 */  \
+void FIRPFBCH2MT(_destroy)(FIRPFBCH2MT() _q);                               \
+                                                                            \
+/* deliver pending outputs, then reset the filterbank                   */  \
+void FIRPFBCH2MT(_reset)(FIRPFBCH2MT() _q);                                 \
+                                                                            \
+/* print object internals                                               */  \
+void FIRPFBCH2MT(_print)(FIRPFBCH2MT() _q);                                 \
+                                                                            \
+/* get number of channels                                               */  \
+unsigned int FIRPFBCH2MT(_get_M)(FIRPFBCH2MT() _q);                         \
+                                                                            \
+/* get number of worker threads                                         */  \
+unsigned int FIRPFBCH2MT(_get_num_workers)(FIRPFBCH2MT() _q);               \
+                                                                            \
+/* push block of input samples into the pipeline; blocks                */  \
+/* only while the pipeline is full                                      */  \
+/*  _q      : channelizer object                                        */  \
+/*  _x      : input samples [size: _n x 1]                              */  \
+/*  _n      : number of input samples, a multiple of M/2                */  \
+void FIRPFBCH2MT(_execute)(FIRPFBCH2MT() _q,                                \
+                           TI *          _x,                                \
+                           unsigned int  _n);                               \
+                                                                            \
+/* wait until outputs for all input pushed so far have been             */  \
+/* passed to the callbacks, including partial blocks                    */  \
+void FIRPFBCH2MT(_flush)(FIRPFBCH2MT() _q);
+
+LIQUID_FIRPFBCH2MT_DEFINE_API(LIQUID_FIRPFBCH2MT_MANGLE_CRCF,
+                              liquid_float_complex,
+                              float,
+                              liquid_float_complex)
+
 //
 // Finite impulse response polyphase filterbank channelizer
 // with output rate Fs * P / M
@@ -7538,6 +7914,98 @@ LIQUID_FIRPFBCHR_DEFINE_API(LIQUID_FIRPFBCHR_MANGLE_CRCF,
                             liquid_float_complex)
 
 
+// fast-convolution channelizer
+#define LIQUID_FCCH_MANGLE_CRCF(name) LIQUID_CONCAT(fcch_crcf,name)
+
+#define LIQUID_FCCH_DEFINE_API(FCCH,TO,TC,TI)                               \
+                                                                            \
+/* Fast-convolution (overlap-save) channelizer for extracting many      */  \
+/* channels at arbitrary center frequencies from one input stream. One  */  \
+/* forward transform of the input is shared by all channels; each       */  \
+/* channel selects the bins around its center frequency, applies its    */  \
+/* own filter response, and runs a small inverse transform that also    */  \
+/* decimates its output.                                                */  \
+typedef struct FCCH(_s) * FCCH();                                           \
+                                                                            \
+/* Create fast-convolution channelizer object with no channels          */  \
+/*  _nfft   : forward transform size, _nfft >= 2                        */  \
+/*  _hop    : input samples consumed per transform, 0 < _hop <= _nfft   */  \
+FCCH() FCCH(_create)(unsigned int _nfft,                                    \
+                     unsigned int _hop);                                    \
+                                                                            \
+/* Destroy channelizer object, freeing all internal memory              */  \
+void FCCH(_destroy)(FCCH() _q);                                             \
+                                                                            \
+/* Reset channelizer internal state, clearing the input buffer          */  \
+void FCCH(_reset)(FCCH() _q);                                               \
+                                                                            \
+/* Print channelizer object internals to stdout                         */  \
+void FCCH(_print)(FCCH() _q);                                               \
+                                                                            \
+/* Get forward transform size                                           */  \
+unsigned int FCCH(_get_nfft)(FCCH() _q);                                    \
+                                                                            \
+/* Get number of input samples consumed by each call to execute()       */  \
+unsigned int FCCH(_get_hop)(FCCH() _q);                                     \
+                                                                            \
+/* Get number of channels                                               */  \
+unsigned int FCCH(_get_num_channels)(FCCH() _q);                            \
+                                                                            \
+/* Get total number of output samples written by each call to execute() */  \
+unsigned int FCCH(_get_num_outputs)(FCCH() _q);                             \
+                                                                            \
+/* Add channel from external filter coefficients, returning its index.  */  \
+/* The channel's center frequency is rounded to the nearest multiple of */  \
+/* 1/_nfft; its output rate is the input rate divided by _decim.        */  \
+/*  _q      : channelizer object                                        */  \
+/*  _fc     : channel center frequency, -0.5 <= _fc <= 0.5              */  \
+/*  _decim  : decimation factor, which must divide both nfft and hop    */  \
+/*  _h      : filter coefficients at the input rate [size: _h_len x 1]  */  \
+/*  _h_len  : filter length, 0 < _h_len <= nfft - hop + 1               */  \
+unsigned int FCCH(_add_channel)(FCCH()       _q,                            \
+                                float        _fc,                           \
+                                unsigned int _decim,                        \
+                                TC *         _h,                            \
+                                unsigned int _h_len);                       \
+                                                                            \
+/* Add channel with a Kaiser-window filter of the longest length the    */  \
+/* transform allows (nfft - hop + 1) and unity pass-band gain,          */  \
+/* returning its index                                                  */  \
+/*  _q      : channelizer object                                        */  \
+/*  _fc     : channel center frequency, -0.5 <= _fc <= 0.5              */  \
+/*  _decim  : decimation factor, which must divide both nfft and hop    */  \
+/*  _bw     : filter cut-off frequency, 0 < _bw < 0.5                   */  \
+/*  _As     : filter stop-band attenuation [dB], _As > 0                */  \
+unsigned int FCCH(_add_channel_kaiser)(FCCH()       _q,                     \
+                                       float        _fc,                    \
+                                       unsigned int _decim,                 \
+                                       float        _bw,                    \
+                                       float        _As);                   \
+                                                                            \
+/* Get decimation factor of channel _i                                  */  \
+unsigned int FCCH(_get_decim)(FCCH()       _q,                              \
+                              unsigned int _i);                             \
+                                                                            \
+/* Get (rounded) center frequency of channel _i                         */  \
+float FCCH(_get_frequency)(FCCH()       _q,                                 \
+                           unsigned int _i);                                \
+                                                                            \
+/* Execute channelizer on a block of _hop input samples. Each channel   */  \
+/* writes _hop/decim baseband samples; channels are stored one after    */  \
+/* another in the order in which they were added.                       */  \
+/*  _q      : channelizer object                                        */  \
+/*  _x      : input array [size: _hop x 1]                              */  \
+/*  _y      : output array [size: get_num_outputs() x 1]                */  \
+void FCCH(_execute)(FCCH() _q,                                              \
+                    TI *   _x,                                              \
+                    TO *   _y);                                             \
+
+LIQUID_FCCH_DEFINE_API(LIQUID_FCCH_MANGLE_CRCF,
+                       liquid_float_complex,
+                       float,
+                       liquid_float_complex)
+
+
 
 #define OFDMFRAME_SCTYPE_NULL   0
 #define OFDMFRAME_SCTYPE_PILOT  1
@@ -8296,6 +8764,60 @@ float randricekf(float _K, float _omega);
 float randricekf_cdf(float _x, float _K, float _omega);
 float randricekf_pdf(float _x, float _K, float _omega);
 
+// Fill arrays with uniform [0,1) and Gauss N(0,1) random numbers
+void randf_fill (float * _y, unsigned int _n);
+void randnf_fill(float * _y, unsigned int _n);
+
+// Pseudo-random number generator (xoshiro256**) with ziggurat Gauss
+// sampler. Each object holds its own state so streams are reproducible
+// and need no locking. The block fills draw from eight interleaved
+// lanes of the object, separate from the stream of the single-sample
+// methods, and consume a multiple of eight outputs per call.
+// randf(), randnf(), etc. draw from rand(), and randf_fill() and
+// randnf_fill() from a generator seeded from rand(), so srand() selects
+// the sequence of all of them.
+typedef struct randgen_s * randgen;
+
+// Create generator object with particular seed
+randgen randgen_create(uint64_t _seed);
+
+// Destroy generator object, freeing all internal memory
+void randgen_destroy(randgen _q);
+
+// Print generator object internals
+void randgen_print(randgen _q);
+
+// Reset generator state from seed
+void randgen_seed(randgen _q, uint64_t _seed);
+
+// Generate uniform 64-bit integer
+uint64_t randgen_u64(randgen _q);
+
+// Generate uniform random number in [0,1)
+float randgen_randf(randgen _q);
+
+// Generate Gauss random number, N(0,1)
+float randgen_randnf(randgen _q);
+
+// Fill array with uniform random numbers in [0,1)
+//  _q  : generator object
+//  _y  : output array [size: _n x 1]
+//  _n  : number of samples
+void randgen_randf_fill(randgen _q, float * _y, unsigned int _n);
+
+// Fill array with Gauss random numbers, N(0,1)
+//  _q  : generator object
+//  _y  : output array [size: _n x 1]
+//  _n  : number of samples
+void randgen_randnf_fill(randgen _q, float * _y, unsigned int _n);
+
+// Fill array with complex Gauss random numbers (unit variance in each
+// of the real and imaginary components, as crandnf())
+//  _q  : generator object
+//  _y  : output array [size: _n x 1]
+//  _n  : number of samples
+void randgen_crandnf_fill(randgen _q, liquid_float_complex * _y, unsigned int _n);
+
 
 // Data scrambler : whiten data sequence
 void scramble_data(unsigned char * _x, unsigned int _len);
@@ -8336,6 +8858,19 @@ void bsequence_circshift(bsequence _bs);
 // Correlate two binary sequences together
 int bsequence_correlate(bsequence _bs1, bsequence _bs2);
 
+// Correlate binary sequence against a packed bit stream (read most-
+// significant bit first) at every bit offset; _rxy[k] is the value
+// bsequence_correlate() would give after pushing stream bits
+// [k, k+num_bits) into a sequence of the same length
+//  _bs     :   binary sequence
+//  _v      :   packed input bits [size: _n x 1]
+//  _n      :   number of input bytes, 8*_n >= num_bits
+//  _rxy    :   correlation at each offset [size: 8*_n-num_bits+1 x 1]
+void bsequence_correlate_bytes(bsequence       _bs,
+                               unsigned char * _v,
+                               unsigned int    _n,
+                               int *           _rxy);
+
 // compute the binary addition of two bit sequences
 void bsequence_add(bsequence _bs1, bsequence _bs2, bsequence _bs3);
 
@@ -38,10 +38,6 @@
 #include <complex.h>
 #include "liquid.h"
 
-#if defined HAVE_FEC_H && defined HAVE_LIBFEC
-#  define LIBFEC_ENABLED 1
-#endif
-
 
 //
 // Debugging macros
@@ -73,6 +69,35 @@
 // MODULE : dotprod
 //
 
+// Wide-vector kernels (x86). Each is built in its own translation unit
+// with the required instruction-set flags whenever the compiler supports
+// them (LIQUID_SIMD_AVX2, LIQUID_SIMD_AVX512F); the SSE objects select
+// between them at run time based on liquid_cpu_features().
+//
+// The coefficient layouts match those of the SSE objects: dotprod_crcf
+// repeats each real coefficient twice, and dotprod_cccf splits the
+// coefficients into repeated real (_hi) and imaginary (_hq) arrays.
+void dotprod_rrrf_run_avx2(float * _h, float * _x, unsigned int _n, float * _y);
+void dotprod_rrrf_run_avx512f(float * _h, float * _x, unsigned int _n, float * _y);
+void dotprod_crcf_run_avx2(float * _h, float complex * _x, unsigned int _n, float complex * _y);
+void dotprod_crcf_run_avx512f(float * _h, float complex * _x, unsigned int _n, float complex * _y);
+void dotprod_cccf_run_avx2(float * _hi, float * _hq, float complex * _x, unsigned int _n, float complex * _y);
+void dotprod_cccf_run_avx512f(float * _hi, float * _hq, float complex * _x, unsigned int _n, float complex * _y);
+float liquid_sumsqf_avx2(float * _v, unsigned int _n);
+float liquid_sumsqf_avx512f(float * _v, unsigned int _n);
+
+// Multi-output (block) kernels: _y[i] = dot(h, _x[i:i+_n-1]) for i < _m,
+// each coefficient broadcast once and applied to several outputs
+void dotprod_rrrf_run_block_avx2(float * _h, float * _x, unsigned int _n, unsigned int _m, float * _y);
+void dotprod_crcf_run_block_avx2(float * _h, float complex * _x, unsigned int _n, unsigned int _m, float complex * _y);
+void dotprod_cccf_run_block_avx2(float * _hi, float * _hq, float complex * _x, unsigned int _n, unsigned int _m, float complex * _y);
+
+// Bank kernels: _m outputs over a common input of _n samples, with the
+// coefficients stored tap by tap (_m per tap, in the layouts above)
+void dotprod_rrrf_run_bank_avx2(float * _h, float * _x, unsigned int _n, unsigned int _m, float * _y);
+void dotprod_crcf_run_bank_avx2(float * _h, float complex * _x, unsigned int _n, unsigned int _m, float complex * _y);
+void dotprod_cccf_run_bank_avx2(float * _hi, float * _hq, float complex * _x, unsigned int _n, unsigned int _m, float complex * _y);
+
 
 //
 // MODULE : fec (forward error-correction)
@@ -91,6 +116,39 @@ unsigned int crc16_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc24_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc32_generate_key(unsigned char * _msg, unsigned int _msg_len);
 
+// copy message to _dst while generating its error-detection key, and
+// append the key to the end of the copy (as crc_append_key)
+//  _scheme     :   error-detection scheme (resulting in 'p' bytes)
+//  _src        :   input data message, [size: _n x 1]
+//  _n          :   input data message size
+//  _dst        :   output message, [size: _n+p x 1]; may equal _src
+void crc_copy_append_key(crc_scheme            _scheme,
+                         const unsigned char * _src,
+                         unsigned int          _n,
+                         unsigned char *       _dst);
+
+// fold _n bytes of _msg (a multiple of 16, at least 64) into a 16-byte
+// residue _r with the same crc, using carry-less multiplies (PCLMULQDQ)
+//  _k      :   folding constants x^{575,511,191,127} mod Q(x), reflected
+//  _key    :   initial register value, xor-ed onto the first four bytes
+//  _msg    :   input message [size: _n x 1]
+//  _n      :   input message length
+//  _r      :   output residue [size: 16 x 1]
+void crc_fold_pclmul(const uint64_t *      _k,
+                     uint32_t              _key,
+                     const unsigned char * _msg,
+                     unsigned int          _n,
+                     unsigned char *       _r);
+
+
+// Viterbi decoder for convolutional codes
+typedef struct fec_viterbi_s * fec_viterbi;
+
+// Reed-Solomon codec over GF(256)
+typedef struct fec_rscodec_s * fec_rscodec;
+
+// quasi-cyclic LDPC code (encoder, layered decoder)
+typedef struct fec_ldpc_code_s * fec_ldpc_code;
 
 // fec : basic object
 struct fec_s {
@@ -106,21 +164,13 @@ struct fec_s {
 
     // convolutional : internal memory structure
     unsigned char * enc_bits;
-    void * vp;      // decoder object
+    fec_viterbi vp; // decoder object
     int * poly;     // polynomial
     unsigned int R; // primitive rate, inverted (e.g. R=3 for 1/3)
     unsigned int K; // constraint length
     unsigned int P; // puncturing rate (e.g. p=3 for 3/4)
     int * puncturing_matrix;
 
-    // viterbi decoder function pointers
-    void*(*create_viterbi)(int);
-    //void (*set_viterbi_polynomial)(int*);
-    int  (*init_viterbi)(void*,int);
-    int  (*update_viterbi_blk)(void*,unsigned char*,int);
-    int  (*chainback_viterbi)(void*,unsigned char*,unsigned int,unsigned int);
-    void (*delete_viterbi)(void*);
-
     // Reed-Solomon
     int symsize;    // symbol size (bits per symbol)
     int genpoly;    // generator polynomial
@@ -131,7 +181,7 @@ struct fec_s {
     unsigned int rspad; // number of implicit padded symbols
     int nn;         // 2^symsize - 1
     int kk;         // nn - nroots
-    void * rs;      // Reed-Solomon internal object
+    fec_rscodec rs; // Reed-Solomon internal object
 
     // Reed-Solomon decoder
     unsigned int num_blocks;    // number of blocks: ceil(dec_msg_len / nn)
@@ -140,9 +190,9 @@ struct fec_s {
     unsigned int res_block_len; // residual bytes in last block
     unsigned int pad;           // padding for each block
     unsigned char * tblock;     // decoder input sequence [size: 1 x n]
-    int * errlocs;              // error locations [size: 1 x n]
-    int * derrlocs;             // decoded error locations [size: 1 x n]
-    int erasures;               // number of erasures
+
+    // LDPC
+    fec_ldpc_code lp;           // code object
 
     // encode function pointer
     void (*encode_func)(fec _q,
@@ -237,6 +287,10 @@ void fec_hamming74_decode_soft(fec _q,
                                unsigned char * _msg_dec);
 // soft decoding of one symbol
 unsigned char fecsoft_hamming74_decode(unsigned char * _soft_bits);
+// soft decoding of a sequence of symbols
+void fecsoft_hamming74_decode_block(unsigned char * _soft_bits,
+                                    unsigned int    _num,
+                                    unsigned char * _sym);
 
 // Hamming(8,4)
 extern unsigned char hamming84_enc_gentab[16];
@@ -258,6 +312,10 @@ void fec_hamming84_decode_soft(fec _q,
                                unsigned char * _msg_dec);
 // soft decoding of one symbol
 unsigned char fecsoft_hamming84_decode(unsigned char * _soft_bits);
+// soft decoding of a sequence of symbols
+void fecsoft_hamming84_decode_block(unsigned char * _soft_bits,
+                                    unsigned int    _num,
+                                    unsigned char * _sym);
 
 // Hamming(12,8)
 
@@ -311,6 +369,9 @@ unsigned int golay2412_matrix_mul(unsigned int   _v,
 // search for p[i] such that w(v+p[i]) <= 2, return -1 on fail
 int golay2412_parity_search(unsigned int _v);
 
+// estimate error vector from 12-bit syndrome
+unsigned int golay2412_estimate_ehat(unsigned int _s);
+
 fec fec_golay2412_create(void *_opts);
 void fec_golay2412_destroy(fec _q);
 void fec_golay2412_print(fec _q);
@@ -322,6 +383,12 @@ void fec_golay2412_decode(fec _q,
                           unsigned int _dec_msg_len,
                           unsigned char * _msg_enc,
                           unsigned char * _msg_dec);
+void fec_golay2412_decode_soft(fec _q,
+                               unsigned int _dec_msg_len,
+                               unsigned char * _msg_enc,
+                               unsigned char * _msg_dec);
+// soft decoding of one symbol
+unsigned int fecsoft_golay2412_decode(unsigned char * _soft_bits);
 
 // SEC-DED (22,16)
 
@@ -366,6 +433,15 @@ void fec_secded2216_decode(fec _q,
                            unsigned int _dec_msg_len,
                            unsigned char * _msg_enc,
                            unsigned char * _msg_dec);
+void fec_secded2216_decode_soft(fec _q,
+                                unsigned int _dec_msg_len,
+                                unsigned char * _msg_enc,
+                                unsigned char * _msg_dec);
+// soft decoding of one symbol
+//  _soft_bits  :   soft bits of encoded symbol [size: 24 x 1]
+//  _sym_dec    :   decoded symbol [size: 2 x 1]
+void fecsoft_secded2216_decode(unsigned char * _soft_bits,
+                              unsigned char * _sym_dec);
 
 // SEC-DED (39,32)
 
@@ -410,6 +486,15 @@ void fec_secded3932_decode(fec _q,
                            unsigned int _dec_msg_len,
                            unsigned char * _msg_enc,
                            unsigned char * _msg_dec);
+void fec_secded3932_decode_soft(fec _q,
+                                unsigned int _dec_msg_len,
+                                unsigned char * _msg_enc,
+                                unsigned char * _msg_dec);
+// soft decoding of one symbol
+//  _soft_bits  :   soft bits of encoded symbol [size: 40 x 1]
+//  _sym_dec    :   decoded symbol [size: 4 x 1]
+void fecsoft_secded3932_decode(unsigned char * _soft_bits,
+                              unsigned char * _sym_dec);
 
 // SEC-DED (72,64)
 
@@ -451,6 +536,15 @@ void fec_secded7264_decode(fec _q,
                            unsigned int _dec_msg_len,
                            unsigned char * _msg_enc,
                            unsigned char * _msg_dec);
+void fec_secded7264_decode_soft(fec _q,
+                                unsigned int _dec_msg_len,
+                                unsigned char * _msg_enc,
+                                unsigned char * _msg_dec);
+// soft decoding of one symbol
+//  _soft_bits  :   soft bits of encoded symbol [size: 72 x 1]
+//  _sym_dec    :   decoded symbol [size: 8 x 1]
+void fecsoft_secded7264_decode(unsigned char * _soft_bits,
+                              unsigned char * _sym_dec);
 
 
 // Convolutional: r1/2 K=7
@@ -466,6 +560,92 @@ unsigned int fec_block_get_enc_msg_len(unsigned int _dec_msg_len,
                                        unsigned int _m,
                                        unsigned int _k);
 
+// pack hard decisions of soft bits into bytes
+//  _soft_bits  :   soft bits [size: 8*_n x 1]
+//  _n          :   number of output bytes
+//  _hard       :   hard decisions [size: _n x 1]
+void fecsoft_hard_decision(unsigned char * _soft_bits,
+                           unsigned int    _n,
+                           unsigned char * _hard);
+
+// reliability of soft bit (distance from decision threshold), [0,127]
+#define FECSOFT_RELIABILITY(b) ((b) & 0x80 ? (b) & 0x7f : 0x7f - (b))
+
+// find least reliable soft bits for Chase decoding, sorted by
+// increasing reliability
+//  _soft_bits  :   soft bits [size: _n x 1]
+//  _n          :   number of soft bits
+//  _p          :   number of positions to find, _p <= _n
+//  _index      :   output positions [size: _p x 1]
+void fecsoft_chase_find_positions(unsigned char * _soft_bits,
+                                  unsigned int    _n,
+                                  unsigned int    _p,
+                                  unsigned int *  _index);
+
+// syndrome of a hard-decision SEC-DED symbol
+typedef unsigned char (*fecsoft_chase_syndrome_func)(unsigned char * _v);
+
+// errors detected for a SEC-DED syndrome (0/1/2 for zero/one/multiple),
+// setting _pos to the erroneous bit for a single error
+typedef int (*fecsoft_chase_locate_func)(unsigned char  _s,
+                                         unsigned int * _pos);
+
+// soft decoding of one SEC-DED symbol (Chase-II), shared by the codecs
+//  _soft_bits  :   soft bits of encoded symbol [size: 8*(_msg_len+1) x 1]
+//  _n          :   number of codeword bits
+//  _offset     :   position of first codeword bit (leading bits unused)
+//  _msg_len    :   number of message bytes, following the parity byte
+//  _p          :   number of least reliable positions to test
+//  _syndrome   :   syndrome of hard-decision symbol
+//  _locate     :   error locator for syndrome
+//  _sym_dec    :   decoded symbol [size: _msg_len x 1]
+void fecsoft_chase_decode(unsigned char *             _soft_bits,
+                          unsigned int                _n,
+                          unsigned int                _offset,
+                          unsigned int                _msg_len,
+                          unsigned int                _p,
+                          fecsoft_chase_syndrome_func _syndrome,
+                          fecsoft_chase_locate_func   _locate,
+                          unsigned char *             _sym_dec);
+
+// expand codeword into byte mask for fecsoft_nearest(): byte k is 0xff
+// if bit k of the codeword (most-significant bit first) is set
+//  _c      :   codeword
+//  _n      :   codeword length (bits), _n <= 16
+//  _mask   :   output mask [size: 16 x 1]
+void fecsoft_codeword_mask(unsigned int    _c,
+                           unsigned int    _n,
+                           unsigned char * _mask);
+
+// find codeword nearest to soft bits by exhaustive search over a list
+// of candidates, returning its position in the list (first on ties)
+//  _soft_bits  :   soft bits [size: _n x 1]
+//  _n          :   codeword length (bits), _n <= 16
+//  _masks      :   byte masks of all codewords [size: 16*M x 1]
+//  _index      :   codeword of each candidate, or NULL for 0,1,...
+//  _num        :   number of candidates
+unsigned int fecsoft_nearest(const unsigned char * _soft_bits,
+                             unsigned int          _n,
+                             const unsigned char * _masks,
+                             const unsigned char * _index,
+                             unsigned int          _num);
+
+// find nearest codeword for each of a sequence of received symbols
+//  _soft_bits  :   soft bits of all symbols [size: _n*_num_sym x 1]
+//  _n          :   codeword length (bits), _n <= 16
+//  _num_sym    :   number of received symbols
+//  _masks      :   byte masks of all codewords [size: 16*M x 1]
+//  _index      :   codeword of each candidate, or NULL for 0,1,...
+//  _num        :   number of candidates
+//  _sym        :   candidate position for each symbol [size: _num_sym x 1]
+void fecsoft_nearest_block(const unsigned char * _soft_bits,
+                           unsigned int          _n,
+                           unsigned int          _num_sym,
+                           const unsigned char * _masks,
+                           const unsigned char * _index,
+                           unsigned int          _num,
+                           unsigned char *       _sym);
+
 // compute encoded message length for convolutional codes
 //  _dec_msg_len    :   decoded message length
 //  _K              :   constraint length
@@ -495,6 +675,79 @@ extern int fec_conv29p56_matrix[10];    // [2 x 5]
 extern int fec_conv29p67_matrix[12];    // [2 x 6]
 extern int fec_conv29p78_matrix[14];    // [2 x 7]
 
+// Viterbi decoder (soft-decision, 16-bit path metrics)
+//  _K          :   constraint length, 6 <= _K <= 16
+//  _R          :   inverse rate (number of polynomials), 1 <= _R <= 8
+//  _poly       :   generator polynomials [size: _R x 1]
+//  _num_bits   :   maximum number of decoded bits (excluding tail)
+fec_viterbi fec_viterbi_create(unsigned int _K,
+                               unsigned int _R,
+                               int *        _poly,
+                               unsigned int _num_bits);
+void fec_viterbi_destroy(fec_viterbi _q);
+
+// reset path metrics to the all-zeros starting state
+void fec_viterbi_reset(fec_viterbi _q);
+
+// run trellis over _num_steps x _R soft bits (0: strong 0, 255: strong 1)
+void fec_viterbi_update(fec_viterbi     _q,
+                        unsigned char * _sym,
+                        unsigned int    _num_steps);
+
+// trace back from the all-zeros end state, writing _num_bits packed
+// (msb first) decoded bits; trellis must contain _num_bits+K-1 steps
+void fec_viterbi_chainback(fec_viterbi     _q,
+                           unsigned char * _msg_dec,
+                           unsigned int    _num_bits);
+
+// add-compare-select kernel: run _num_steps trellis steps, reading path
+// metrics from _m0 and writing them alternately to _m1, _m0, ... so the
+// result is in _m1 after an odd number of steps
+//  _bt         :   branch table for input bit 0, low four state bits [size: _R x 16]
+//  _idx        :   per block of 16 states, mask of inverted outputs [size: _half/16 x 1]
+//  _R          :   inverse rate
+//  _half       :   half the number of states (multiple of 16)
+//  _sym        :   soft input bits [size: _num_steps x _R]
+//  _num_steps  :   number of trellis steps
+//  _m0, _m1    :   path metric buffers (aligned) [size: 2*_half x 1]
+//  _d          :   decision bits, one per state [size: _num_steps x 2*_half/32]
+typedef void (*fec_viterbi_acs_func)(const int16_t *       _bt,
+                                     const unsigned char * _idx,
+                                     unsigned int          _R,
+                                     unsigned int          _half,
+                                     const unsigned char * _sym,
+                                     unsigned int          _num_steps,
+                                     int16_t *             _m0,
+                                     int16_t *             _m1,
+                                     uint32_t *            _d);
+void fec_viterbi_acs_port(const int16_t *       _bt,
+                          const unsigned char * _idx,
+                          unsigned int          _R,
+                          unsigned int          _half,
+                          const unsigned char * _sym,
+                          unsigned int          _num_steps,
+                          int16_t *             _m0,
+                          int16_t *             _m1,
+                          uint32_t *            _d);
+void fec_viterbi_acs_sse2(const int16_t *       _bt,
+                          const unsigned char * _idx,
+                          unsigned int          _R,
+                          unsigned int          _half,
+                          const unsigned char * _sym,
+                          unsigned int          _num_steps,
+                          int16_t *             _m0,
+                          int16_t *             _m1,
+                          uint32_t *            _d);
+void fec_viterbi_acs_avx2(const int16_t *       _bt,
+                          const unsigned char * _idx,
+                          unsigned int          _R,
+                          unsigned int          _half,
+                          const unsigned char * _sym,
+                          unsigned int          _num_steps,
+                          int16_t *             _m0,
+                          int16_t *             _m1,
+                          uint32_t *            _d);
+
 fec fec_conv_create(fec_scheme _fs);
 void fec_conv_destroy(fec _q);
 void fec_conv_print(fec _q);
@@ -515,7 +768,7 @@ void fec_conv_decode(fec _q,
 void fec_conv_setlength(fec _q,
                         unsigned int _dec_msg_len);
 
-// internal initialization methods (sets r, K, viterbi methods)
+// internal initialization methods (sets r, K, polynomial)
 void fec_conv_init_v27(fec _q);
 void fec_conv_init_v29(fec _q);
 void fec_conv_init_v39(fec _q);
@@ -569,7 +822,39 @@ unsigned int fec_rs_get_enc_msg_len(unsigned int _dec_msg_len,
                                     unsigned int _kk);
 
 
-fec fec_rs_create(fec_scheme _fs);
+// create Reed-Solomon codec (libfec-compatible code definition)
+//  _gfpoly     :   field generator polynomial, e.g. 0x11d
+//  _fcr        :   first consecutive root of the generator polynomial
+//  _prim       :   primitive element used to generate roots
+//  _nroots     :   number of parity symbols, 0 < _nroots < 255
+fec_rscodec fec_rscodec_create(unsigned int _gfpoly,
+                               unsigned int _fcr,
+                               unsigned int _prim,
+                               unsigned int _nroots);
+void fec_rscodec_destroy(fec_rscodec _q);
+
+// compute parity symbols for block of _n data symbols (_n + nroots <= 255)
+void fec_rscodec_encode(fec_rscodec     _q,
+                        unsigned char * _msg,
+                        unsigned int    _n,
+                        unsigned char * _parity);
+
+// decode block of _n symbols (data followed by parity) in place,
+// returning the number of corrected errors, or -1 on failure
+int fec_rscodec_decode(fec_rscodec     _q,
+                       unsigned char * _block,
+                       unsigned int    _n);
+
+// decode _num contiguous blocks of _n symbols in place, several at a
+// time; _nerr receives the result of each block as fec_rscodec_decode()
+// would return it (ignored if NULL)
+void fec_rscodec_decode_block(fec_rscodec     _q,
+                              unsigned char * _blocks,
+                              unsigned int    _n,
+                              unsigned int    _num,
+                              int *           _nerr);
+
+fec fec_rs_create(fec_scheme _fs, void * _opts);
 void fec_rs_destroy(fec _q);
 void fec_rs_init_p8(fec _q);
 void fec_rs_setlength(fec _q,
@@ -582,6 +867,100 @@ void fec_rs_decode(fec _q,
                    unsigned int _dec_msg_len,
                    unsigned char * _msg_enc,
                    unsigned char * _msg_dec);
+void fec_rs_decode_block(fec _q,
+                         unsigned int _dec_msg_len,
+                         unsigned int _num,
+                         unsigned char * _msg_enc,
+                         unsigned char * _msg_dec);
+
+// LDPC : quasi-cyclic codes with dual-diagonal parity structure
+
+// base matrices [12 x 24]
+extern short int fec_ldpc648_base[288];     // n=648,  Z=27
+extern short int fec_ldpc1296_base[288];    // n=1296, Z=54
+extern short int fec_ldpc1944_base[288];    // n=1944, Z=81
+
+// compute encoded message length for LDPC codes; the message is split
+// evenly into ceil(8*_dec_msg_len/_k) blocks, each shortened to carry
+// its own message bits followed by all _n-_k parity bits
+//  _dec_msg_len    :   decoded message length (bytes)
+//  _n              :   codeword length (bits)
+//  _k              :   message length (bits)
+unsigned int fec_ldpc_get_enc_msg_len(unsigned int _dec_msg_len,
+                                      unsigned int _n,
+                                      unsigned int _k);
+
+fec fec_ldpc_create(fec_scheme _fs);
+void fec_ldpc_destroy(fec _q);
+void fec_ldpc_encode(fec _q,
+                     unsigned int _dec_msg_len,
+                     unsigned char * _msg_dec,
+                     unsigned char * _msg_enc);
+void fec_ldpc_decode_hard(fec _q,
+                          unsigned int _dec_msg_len,
+                          unsigned char * _msg_enc,
+                          unsigned char * _msg_dec);
+void fec_ldpc_decode_soft(fec _q,
+                          unsigned int _dec_msg_len,
+                          unsigned char * _msg_enc,
+                          unsigned char * _msg_dec);
+
+// create quasi-cyclic LDPC code
+//  _mb     :   number of block rows
+//  _nb     :   number of block columns, _nb > _mb
+//  _Z      :   lifting size
+//  _base   :   base matrix of shifts, -1 for zero blocks [size: _mb x _nb]
+fec_ldpc_code fec_ldpc_code_create(unsigned int _mb,
+                                   unsigned int _nb,
+                                   unsigned int _Z,
+                                   short int *  _base);
+void fec_ldpc_code_destroy(fec_ldpc_code _q);
+void fec_ldpc_code_print(fec_ldpc_code _q);
+unsigned int fec_ldpc_code_get_n(fec_ldpc_code _q);
+unsigned int fec_ldpc_code_get_k(fec_ldpc_code _q);
+smatrixb fec_ldpc_code_get_H(fec_ldpc_code _q);
+
+// encode block, codeword is systematic: message followed by parity
+//  _msg    :   message bits [size: k x 1]
+//  _cw     :   codeword bits [size: n x 1]
+void fec_ldpc_code_encode(fec_ldpc_code   _q,
+                          unsigned char * _msg,
+                          unsigned char * _cw);
+
+// decode block using layered offset min-sum, returning 1 if all
+// parity checks pass, 0 otherwise
+//  _llr    :   input LLRs, positive values favor 0 [size: n x 1]
+//  _msg    :   decoded message bits [size: k x 1]
+int fec_ldpc_code_decode(fec_ldpc_code   _q,
+                         int16_t *       _llr,
+                         unsigned char * _msg);
+
+// check-node update for one layer of _Zp check nodes (one per lane)
+//  _t      :   a posteriori LLRs of each block [size: _dc x _Zp]
+//  _r      :   check-to-variable messages of each block [size: _dc x _Zp]
+//  _dc     :   number of blocks in layer (check node degree)
+//  _Zp     :   number of lanes (multiple of 16)
+//  _offset :   min-sum magnitude offset
+typedef void (*fec_ldpc_layer_func)(int16_t *    _t,
+                                    int16_t *    _r,
+                                    unsigned int _dc,
+                                    unsigned int _Zp,
+                                    int16_t      _offset);
+void fec_ldpc_layer_port(int16_t *    _t,
+                         int16_t *    _r,
+                         unsigned int _dc,
+                         unsigned int _Zp,
+                         int16_t      _offset);
+void fec_ldpc_layer_sse2(int16_t *    _t,
+                         int16_t *    _r,
+                         unsigned int _dc,
+                         unsigned int _Zp,
+                         int16_t      _offset);
+void fec_ldpc_layer_avx2(int16_t *    _t,
+                         int16_t *    _r,
+                         unsigned int _dc,
+                         unsigned int _Zp,
+                         int16_t      _offset);
 
 // phi(x) = -logf( tanhf( x/2 ) )
 float sumproduct_phi(float _x);
@@ -602,26 +981,30 @@ int fec_sumproduct(unsigned int    _m,
                    unsigned int    _max_steps);
 
 // sum-product algorithm, returns 1 if parity checks, 0 otherwise
-//  _m      :   rows
-//  _n      :   cols
-//  _H      :   sparse binary parity check matrix [size: _m x _n]
-//  _c_hat  :   estimated transmitted signal [size: _n x 1]
+//  _m          :   rows
+//  _n          :   cols
+//  _row_ptr    :   first edge of each check [size: _m+1 x 1]
+//  _col_idx    :   variable (column) of each edge [size: num_edges x 1]
+//  _col_ptr    :   first entry in _col_edge of each variable [size: _n+1 x 1]
+//  _col_edge   :   edges grouped by variable [size: num_edges x 1]
+//  _c_hat      :   estimated transmitted signal [size: _n x 1]
 //
 // internal state arrays
-//  _Lq     :   [size: _m x _n]
-//  _Lr     :   [size: _m x _n]
-//  _Lc     :   [size: _n x 1]
-//  _LQ     :   [size: _n x 1]
-//  _parity :   _H * _c_hat [size: _m x 1]
+//  _Lq     :   variable-to-check messages [size: num_edges x 1]
+//  _Lr     :   check-to-variable messages [size: num_edges x 1]
+//  _Lc     :   channel LLRs [size: _n x 1]
+//  _LQ     :   a posteriori LLRs [size: _n x 1]
 int fec_sumproduct_step(unsigned int    _m,
                         unsigned int    _n,
-                        smatrixb        _H,
+                        unsigned int *  _row_ptr,
+                        unsigned int *  _col_idx,
+                        unsigned int *  _col_ptr,
+                        unsigned int *  _col_edge,
                         unsigned char * _c_hat,
                         float *         _Lq,
                         float *         _Lr,
                         float *         _Lc,
-                        float *         _LQ,
-                        unsigned char * _parity);
+                        float *         _LQ);
 
 //
 // packetizer
@@ -653,10 +1036,10 @@ struct packetizer_s {
     struct fecintlv_plan * plan;
     unsigned int plan_len;
 
-    // buffers (ping-pong)
+    // scratch memory for the encoder and decoders, kept across
+    // packetizer_recreate() and only grown when necessary
     unsigned int buffer_len;
-    unsigned char * buffer_0;
-    unsigned char * buffer_1;
+    unsigned char * buffer;
 };
 
 
@@ -672,8 +1055,13 @@ typedef enum {
     LIQUID_FFT_METHOD_RADER,        // Rader's method for FFTs of prime length
     LIQUID_FFT_METHOD_RADER2,       // Rader's method for FFTs of prime length (alternate)
     LIQUID_FFT_METHOD_DFT,          // regular discrete Fourier transform
+    LIQUID_FFT_METHOD_MANY,         // batch of same-size transforms
 } liquid_fft_method;
 
+// number of transforms computed together by batched plans, one
+// per single-precision lane of a 256-bit register
+#define LIQUID_FFT_MANY_LANES (8)
+
 // Macro    :   FFT (internal)
 //  FFT     :   name-mangling macro
 //  T       :   primitive data type
@@ -693,6 +1081,61 @@ typedef FFT(plan)(FFT(_create_t)) (unsigned int _nfft,          \
 typedef void (FFT(_destroy_t))(FFT(plan) _q);                   \
 typedef void (FFT(_execute_t))(FFT(plan) _q);                   \
                                                                 \
+/* read-only tables shared between plans (plan cache) */        \
+typedef struct FFT(table_s) * FFT(table);                       \
+                                                                \
+/* fill newly-allocated table for plan being created */         \
+typedef void (FFT(_table_init_t))(FFT(plan) _q,                 \
+                                  FFT(table) _t);               \
+                                                                \
+/* get table for plan's size, direction and method, running  */ \
+/* _init only if no other plan has created it yet            */ \
+FFT(table) FFT(_cache_acquire)(FFT(plan)             _q,        \
+                               FFT(_table_init_t) *  _init);    \
+                                                                \
+/* release table obtained with FFT(_cache_acquire) */           \
+void FFT(_cache_release)(FFT(table) _t);                        \
+                                                                \
+/* select method for transform size from wisdom, measuring  */  \
+/* candidates first if _flags has LIQUID_FFT_MEASURE set    */  \
+liquid_fft_method FFT(_cache_method)(unsigned int _nfft,        \
+                                     int          _flags);      \
+                                                                \
+/* radix-4 butterfly pass kernel for radix-2 transforms */      \
+typedef void (FFT(_pass_t))(TC *         _y,                    \
+                            unsigned int _n,                    \
+                            unsigned int _h,                    \
+                            TC *         _w,                    \
+                            int          _dir);                 \
+FFT(_pass_t) FFT(_radix2_pass4);        /* portable C       */  \
+FFT(_pass_t) FFT(_radix2_pass4_sse);    /* SSE3             */  \
+FFT(_pass_t) FFT(_radix2_pass4_avx2);   /* AVX2/FMA         */  \
+                                                                \
+/* kernels for batched transforms across lanes */              \
+typedef void (FFT(_many_butterflies_t))(T *          _re,       \
+                                        T *          _im,       \
+                                        unsigned int _n,        \
+                                        T *          _w,        \
+                                        int          _dir);     \
+typedef void (FFT(_many_gather_t))(TC *           _x,           \
+                                   unsigned int   _idist,       \
+                                   unsigned int   _n,           \
+                                   unsigned int * _rev,         \
+                                   T *            _re,          \
+                                   T *            _im);         \
+typedef void (FFT(_many_scatter_t))(T *          _re,           \
+                                    T *          _im,           \
+                                    unsigned int _n,            \
+                                    TC *         _y,            \
+                                    unsigned int _odist);       \
+FFT(_many_butterflies_t) FFT(_many_butterflies);      /* C   */ \
+FFT(_many_butterflies_t) FFT(_many_butterflies_sse);  /* SSE */ \
+FFT(_many_butterflies_t) FFT(_many_butterflies_avx2); /* AVX2*/ \
+FFT(_many_gather_t)      FFT(_many_gather_sse);                 \
+FFT(_many_gather_t)      FFT(_many_gather_avx2);                \
+FFT(_many_scatter_t)     FFT(_many_scatter_sse);                \
+FFT(_many_scatter_t)     FFT(_many_scatter_avx2);               \
+                                                                \
 /* FFT create methods */                                        \
 FFT(_create_t) FFT(_create_plan_dft);                           \
 FFT(_create_t) FFT(_create_plan_radix2);                        \
@@ -700,12 +1143,21 @@ FFT(_create_t) FFT(_create_plan_mixed_radix);                   \
 FFT(_create_t) FFT(_create_plan_rader);                         \
 FFT(_create_t) FFT(_create_plan_rader2);                        \
                                                                 \
+/* FFT table initialization methods (plan cache) */            \
+FFT(_table_init_t) FFT(_table_init_dft);                        \
+FFT(_table_init_t) FFT(_table_init_radix2);                     \
+FFT(_table_init_t) FFT(_table_init_mixed_radix);                \
+FFT(_table_init_t) FFT(_table_init_rader);                      \
+FFT(_table_init_t) FFT(_table_init_rader2);                     \
+                                                                \
 /* FFT destroy methods */                                       \
 FFT(_destroy_t) FFT(_destroy_plan_dft);                         \
 FFT(_destroy_t) FFT(_destroy_plan_radix2);                      \
 FFT(_destroy_t) FFT(_destroy_plan_mixed_radix);                 \
 FFT(_destroy_t) FFT(_destroy_plan_rader);                       \
 FFT(_destroy_t) FFT(_destroy_plan_rader2);                      \
+FFT(_destroy_t) FFT(_destroy_plan_many);                        \
+FFT(_destroy_t) FFT(_destroy_plan_r2c);                         \
                                                                 \
 /* FFT execute methods */                                       \
 FFT(_execute_t) FFT(_execute_dft);                              \
@@ -713,6 +1165,14 @@ FFT(_execute_t) FFT(_execute_radix2);                           \
 FFT(_execute_t) FFT(_execute_mixed_radix);                      \
 FFT(_execute_t) FFT(_execute_rader);                            \
 FFT(_execute_t) FFT(_execute_rader2);                           \
+FFT(_execute_t) FFT(_execute_many);                             \
+FFT(_execute_t) FFT(_execute_r2c);                              \
+FFT(_execute_t) FFT(_execute_c2r);                              \
+                                                                \
+/* real-to-complex/complex-to-real plan (common part) */        \
+FFT(plan) FFT(_create_plan_r2c_internal)(unsigned int _nfft,    \
+                                         int          _type,    \
+                                         int          _flags);  \
                                                                 \
 /* specific codelets for small DFTs */                          \
 FFT(_execute_t) FFT(_execute_dft_2);                            \
@@ -768,6 +1228,8 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #   define FFT_DIR_FORWARD      FFTW_FORWARD
 #   define FFT_DIR_BACKWARD     FFTW_BACKWARD
 #   define FFT_METHOD           FFTW_ESTIMATE
+#   define FFT_CREATE_PLAN_R2C  fftwf_plan_dft_r2c_1d
+#   define FFT_CREATE_PLAN_C2R  fftwf_plan_dft_c2r_1d
 #else
 #   define FFT_PLAN             fftplan
 #   define FFT_CREATE_PLAN      fft_create_plan
@@ -776,6 +1238,8 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #   define FFT_DIR_FORWARD      LIQUID_FFT_FORWARD
 #   define FFT_DIR_BACKWARD     LIQUID_FFT_BACKWARD
 #   define FFT_METHOD           0
+#   define FFT_CREATE_PLAN_R2C  fft_create_plan_r2c
+#   define FFT_CREATE_PLAN_C2R  fft_create_plan_c2r
 #endif
 
 
@@ -1075,6 +1539,9 @@ void bpacketgen_assemble_header(bpacketgen _q);
 // synchronizer
 void bpacketsync_assemble_pnsequence(bpacketsync _q);
 void bpacketsync_execute_seekpn(bpacketsync _q, unsigned char _bit);
+unsigned int bpacketsync_execute_seekpn_block(bpacketsync     _q,
+                                              unsigned char * _bytes,
+                                              unsigned int    _n);
 void bpacketsync_execute_rxheader(bpacketsync _q, unsigned char _bit);
 void bpacketsync_execute_rxpayload(bpacketsync _q, unsigned char _bit);
 void bpacketsync_decode_header(bpacketsync _q);
@@ -1448,6 +1915,19 @@ void MODEM(_demodulate_soft_arb)( MODEM()         _q,           \
                                   unsigned int *  _sym_out,     \
                                   unsigned char * _soft_bits);  \
                                                                 \
+/* modem demodulate (soft, block) routines */                   \
+void MODEM(_demodulate_soft_block_bpsk)(MODEM()         _q,     \
+                                        TC *            _x,     \
+                                        unsigned int    _n,     \
+                                        unsigned char * _soft); \
+void MODEM(_demodulate_soft_block_qpsk)(MODEM()         _q,     \
+                                        TC *            _x,     \
+                                        unsigned int    _n,     \
+                                        unsigned char * _soft); \
+                                                                \
+/* soft bit from in-phase/quadrature component (BPSK, QPSK) */  \
+unsigned char MODEM(_soft_bit_llr)(T _v, T _gamma);             \
+                                                                \
 /* generate soft demodulation look-up table */                  \
 void MODEM(_demodsoft_gentab)(MODEM()      _q,                  \
                               unsigned int _p);                 \
@@ -1817,6 +2297,62 @@ void optim_sort(float *_v,
 
 #define randf_inline() ((float) rand() / (float) RAND_MAX)
 
+// draw a 64-bit seed from rand(), so that srand() selects the stream
+uint64_t randgen_seed_from_rand(void);
+
+// Gauss sample (ziggurat) drawn from rand() outputs
+float randgen_gauss_rand(void);
+
+// number of ziggurat layers
+#define RANDGEN_ZIG_LAYERS  (128)
+
+// number of independent xoshiro256** lanes used by the block fills
+#define RANDGEN_LANES       (8)
+
+// block fill lane kernels: advance all lanes _num_steps times, writing
+// output of lane j at step i to _v[i*RANDGEN_LANES + j]
+//  _b          :   lane states, word-major [size: 4*RANDGEN_LANES x 1]
+//  _num_steps  :   number of steps
+//  _v          :   outputs [size: _num_steps*RANDGEN_LANES x 1]
+void randgen_lanes_run_port(uint64_t *   _b,
+                            unsigned int _num_steps,
+                            uint64_t *   _v);
+void randgen_lanes_run_avx2(uint64_t *   _b,
+                            unsigned int _num_steps,
+                            uint64_t *   _v);
+
+// uniform kernels: convert 64-bit generator outputs _v to uniform
+// samples in [0,1) _y from their upper 24 bits
+//  _v      :   generator outputs [size: _n x 1]
+//  _n      :   number of outputs
+//  _y      :   output samples [size: _n x 1]
+void randgen_uniform_run_port(const uint64_t * _v,
+                              unsigned int     _n,
+                              float *          _y);
+void randgen_uniform_run_avx2(const uint64_t * _v,
+                              unsigned int     _n,
+                              float *          _y);
+
+// ziggurat fast path kernels: convert 64-bit generator outputs _v to
+// Gauss samples _y (the abscissa from the low word, the layer index from
+// bits 32-38) and return a mask with bit i set where output i lies
+// outside its layer's inner rectangle and needs the slow path
+//  _v      :   generator outputs [size: _n x 1]
+//  _n      :   number of outputs, _n <= 64
+//  _kn     :   acceptance thresholds [size: RANDGEN_ZIG_LAYERS x 1]
+//  _wn     :   layer widths [size: RANDGEN_ZIG_LAYERS x 1]
+//  _y      :   output samples [size: _n x 1]
+uint64_t randgen_zig_run_port(const uint64_t * _v,
+                              unsigned int     _n,
+                              const uint32_t * _kn,
+                              const float *    _wn,
+                              float *          _y);
+uint64_t randgen_zig_run_avx2(const uint64_t * _v,
+                              unsigned int     _n,
+                              const uint32_t * _kn,
+                              const float *    _wn,
+                              float *          _y);
+
 float complex icrandnf();
 
 // generate x ~ Gamma(delta,1)
@@ -1846,11 +2382,79 @@ struct msequence_s {
 // Default msequence generator objects
 extern struct msequence_s msequence_default[16];
 
+// bsequence correlator kernels: for each byte position p in [0,_num_pos)
+// and bit shift s in [0,8), correlate the reference against the stream
+// window starting at bit 8p+s, writing _num_bits minus the number of
+// disagreeing bits to _rxy[8p+s]; input is read up to byte
+// _num_pos-1 + 8*_num_words
+//  _ref        :   reference bits, msb first [size: _num_words x 1]
+//  _num_words  :   number of 64-bit words in reference
+//  _mask       :   valid bits of the last reference word
+//  _num_bits   :   number of reference bits
+//  _v          :   packed input bits
+//  _num_pos    :   number of byte positions
+//  _rxy        :   correlation output [size: 8*_num_pos x 1]
+void bsequence_scan_port(const uint64_t *      _ref,
+                         unsigned int          _num_words,
+                         uint64_t              _mask,
+                         unsigned int          _num_bits,
+                         const unsigned char * _v,
+                         unsigned int          _num_pos,
+                         int *                 _rxy);
+void bsequence_scan_popcnt(const uint64_t *      _ref,
+                           unsigned int          _num_words,
+                           uint64_t              _mask,
+                           unsigned int          _num_bits,
+                           const unsigned char * _v,
+                           unsigned int          _num_pos,
+                           int *                 _rxy);
+void bsequence_scan_avx2(const uint64_t *      _ref,
+                         unsigned int          _num_words,
+                         uint64_t              _mask,
+                         unsigned int          _num_bits,
+                         const unsigned char * _v,
+                         unsigned int          _num_pos,
+                         int *                 _rxy);
+
+// load 64 bits (big endian) starting at _v
+#define BSEQUENCE_LOAD_BE64(_v) (                   \
+    ((uint64_t)(_v)[0] << 56) |                     \
+    ((uint64_t)(_v)[1] << 48) |                     \
+    ((uint64_t)(_v)[2] << 40) |                     \
+    ((uint64_t)(_v)[3] << 32) |                     \
+    ((uint64_t)(_v)[4] << 24) |                     \
+    ((uint64_t)(_v)[5] << 16) |                     \
+    ((uint64_t)(_v)[6] <<  8) |                     \
+    ((uint64_t)(_v)[7]      ) )
+
 
 //
 // MODULE : utility
 //
 
+// processor SIMD extensions, detected at run time
+#define LIQUID_CPU_DETECTED     (1<< 0) // detection has been run
+#define LIQUID_CPU_SSE2         (1<< 1)
+#define LIQUID_CPU_SSE3         (1<< 2)
+#define LIQUID_CPU_SSSE3        (1<< 3)
+#define LIQUID_CPU_SSE41        (1<< 4)
+#define LIQUID_CPU_POPCNT       (1<< 5)
+#define LIQUID_CPU_PCLMUL       (1<< 6)
+#define LIQUID_CPU_AVX          (1<< 7)
+#define LIQUID_CPU_AVX2         (1<< 8)
+#define LIQUID_CPU_FMA          (1<< 9)
+#define LIQUID_CPU_AVX512F      (1<<10)
+#define LIQUID_CPU_AVX512BW     (1<<11)
+#define LIQUID_CPU_NEON         (1<<12)
+
+// get processor features as a bit field of LIQUID_CPU_* flags; the
+// LIQUID_CPU_MASK environment variable can be used to disable
+// extensions (e.g. LIQUID_CPU_MASK=0 forces baseline kernels)
+unsigned int liquid_cpu_features(void);
+
+// test if all extensions in _flags are supported by the host
+int liquid_cpu_has(unsigned int _flags);
+
 // number of ones in a byte
 //  0   0000 0000   :   0
 //  1   0000 0001   :   1
@@ -1923,5 +2527,52 @@ extern unsigned int liquid_c_leading_zeros[256];
 
 // byte reversal and manipulation
 extern const unsigned char liquid_reverse_byte_gentab[256];
+
+//
+// MODULE : vector
+//
+
+// Wide-vector kernels (x86), selected at run time by the SSE objects.
+// Element-wise real kernels also serve complex arrays, which are passed
+// as interleaved (real,imag) float arrays of twice the length.
+void liquid_vectorf_add_avx2       (float * _x, float * _y, unsigned int _n, float * _z);
+void liquid_vectorf_addscalar_avx2 (float * _x, unsigned int _n, float _v, float * _y);
+void liquid_vectorf_mul_avx2       (float * _x, float * _y, unsigned int _n, float * _z);
+void liquid_vectorf_mulscalar_avx2 (float * _x, unsigned int _n, float _v, float * _y);
+void liquid_vectorcf_addscalar_avx2(float complex * _x, unsigned int _n, float complex _v, float complex * _y);
+void liquid_vectorcf_mul_avx2      (float complex * _x, float complex * _y, unsigned int _n, float complex * _z);
+void liquid_vectorcf_mulscalar_avx2(float complex * _x, unsigned int _n, float complex _v, float complex * _y);
+void liquid_vectorcf_cexpj_avx2    (float * _theta, unsigned int _n, float complex * _x);
+void liquid_vectorcf_carg_avx2     (float complex * _x, unsigned int _n, float * _theta);
+void liquid_vectorcf_abs_avx2      (float complex * _x, unsigned int _n, float * _y);
+
+void liquid_vectorf_add_avx512f       (float * _x, float * _y, unsigned int _n, float * _z);
+void liquid_vectorf_addscalar_avx512f (float * _x, unsigned int _n, float _v, float * _y);
+void liquid_vectorf_mul_avx512f       (float * _x, float * _y, unsigned int _n, float * _z);
+void liquid_vectorf_mulscalar_avx512f (float * _x, unsigned int _n, float _v, float * _y);
+void liquid_vectorcf_addscalar_avx512f(float complex * _x, unsigned int _n, float complex _v, float complex * _y);
+void liquid_vectorcf_mul_avx512f      (float complex * _x, float complex * _y, unsigned int _n, float complex * _z);
+void liquid_vectorcf_mulscalar_avx512f(float complex * _x, unsigned int _n, float complex _v, float complex * _y);
+
+// Polynomial approximations shared by the vectorized cexpj/carg kernels
+// (Cephes single-precision sinf/cosf/atanf). The sin/cos reduction is
+// theta = j*pi/2 + r with |r| <= pi/4 and pi/2 split into three parts;
+// accuracy holds for |theta| well beyond the usual [-pi,pi) phase range.
+#define LIQUID_VECTOR_2_OVER_PI     ( 0.636619772367581343f)
+#define LIQUID_VECTOR_PIO2_1        ( 1.5703125f)
+#define LIQUID_VECTOR_PIO2_2        ( 4.837512969970703125e-4f)
+#define LIQUID_VECTOR_PIO2_3        ( 7.54978995489188216e-8f)
+#define LIQUID_VECTOR_SIN_C0        (-1.9515295891e-4f)
+#define LIQUID_VECTOR_SIN_C1        ( 8.3321608736e-3f)
+#define LIQUID_VECTOR_SIN_C2        (-1.6666654611e-1f)
+#define LIQUID_VECTOR_COS_C0        ( 2.443315711809948e-5f)
+#define LIQUID_VECTOR_COS_C1        (-1.388731625493765e-3f)
+#define LIQUID_VECTOR_COS_C2        ( 4.166664568298827e-2f)
+#define LIQUID_VECTOR_TAN_PI_8      ( 0.414213562373095f)
+#define LIQUID_VECTOR_ATAN_C0       ( 8.05374449538e-2f)
+#define LIQUID_VECTOR_ATAN_C1       (-1.38776856032e-1f)
+#define LIQUID_VECTOR_ATAN_C2       ( 1.99777106478e-1f)
+#define LIQUID_VECTOR_ATAN_C3       (-3.33329491539e-1f)
+
 #endif // __LIQUID_INTERNAL_H__
 
@@ -29,6 +29,9 @@
 #include <stdio.h>
 #include <math.h>
 
+// number of samples processed together in CHANNEL(_execute_block)
+#define LIQUID_CHANNEL_BLOCK_LEN    (256)
+
 // portable structured channel object
 struct CHANNEL(_s) {
     // additive white Gauss noise
@@ -55,8 +58,13 @@ struct CHANNEL(_s) {
     IIRFILT()       shadowing_filter;   // shadowing filter object
     float           shadowing_std;      // shadowing standard deviation
     float           shadowing_fd;       // shadowing Doppler frequency
+
+    randgen         rng;                // noise generator
 };
 
+// compute gain of next shadowing sample
+float CHANNEL(_shadowing_gain)(CHANNEL() _q);
+
 // create structured channel object with default parameters
 CHANNEL() CHANNEL(_create)(void)
 {
@@ -76,6 +84,9 @@ CHANNEL() CHANNEL(_create)(void)
     q->channel_filter   = FIRFILT(_create)(q->h, q->h_len);
     q->shadowing_filter = NULL;
 
+    // private noise stream, seeded from rand() so that srand() selects it
+    q->rng = randgen_create(randgen_seed_from_rand());
+
     // return object
     return q;
 }
@@ -88,6 +99,7 @@ void CHANNEL(_destroy)(CHANNEL() _q)
     FIRFILT(_destroy)(_q->channel_filter);
     if (_q->shadowing_filter != NULL)
         IIRFILT(_destroy)(_q->shadowing_filter);
+    randgen_destroy(_q->rng);
     free(_q->h);
 
     // free main object memory
@@ -246,14 +258,8 @@ void CHANNEL(_execute)(CHANNEL() _q,
     }
 
     // apply shadowing if enabled
-    if (_q->enabled_shadowing) {
-        // TODO: use type-specific value other than float
-        float g = 0;
-        IIRFILT(_execute)(_q->shadowing_filter, randnf()*_q->shadowing_std, &g);
-        g /= _q->shadowing_fd * 6.9f;
-        g = powf(10.0f, g/20.0f);
-        r *= g;
-    }
+    if (_q->enabled_shadowing)
+        r *= CHANNEL(_shadowing_gain)(_q);
 
     // apply carrier if enabled
     if (_q->enabled_carrier) {
@@ -264,14 +270,15 @@ void CHANNEL(_execute)(CHANNEL() _q,
     // apply AWGN if enabled
     if (_q->enabled_awgn) {
         r *= _q->gamma;
-        r += _q->nstd * ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2;
+        float complex v = randgen_randnf(_q->rng) + _Complex_I*randgen_randnf(_q->rng);
+        r += _q->nstd * v * M_SQRT1_2;
     }
 
     // set output value
     *_y = r;
 }
 
-// apply channel impairments on single input sample
+// apply channel impairments on block of samples
 //  _q      : channel object
 //  _x      : input array [size: _n x 1]
 //  _n      : input array length
@@ -281,10 +288,47 @@ void CHANNEL(_execute_block)(CHANNEL()    _q,
                              unsigned int _n,
                              TO *         _y)
 {
-    // apply channel effects on each input sample
-    // TODO: apply in blocks
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        CHANNEL(_execute)(_q, _x[i], &_y[i]);
+    unsigned int i, n;
+
+    // apply filter
+    if (_q->enabled_multipath)
+        FIRFILT(_execute_block)(_q->channel_filter, _x, _n, _y);
+    else if (_x != _y)
+        memmove(_y, _x, _n*sizeof(TO));
+
+    // apply shadowing if enabled
+    if (_q->enabled_shadowing) {
+        for (i=0; i<_n; i++)
+            _y[i] *= CHANNEL(_shadowing_gain)(_q);
+    }
+
+    // apply carrier if enabled
+    if (_q->enabled_carrier)
+        NCO(_mix_block_up)(_q->nco, _y, _y, _n);
+
+    // apply AWGN if enabled, generating noise a block at a time
+    if (_q->enabled_awgn) {
+        float complex v[LIQUID_CHANNEL_BLOCK_LEN];
+        T nstd = _q->nstd * M_SQRT1_2;
+        for (n=0; n<_n; n+=LIQUID_CHANNEL_BLOCK_LEN) {
+            unsigned int m = _n - n < LIQUID_CHANNEL_BLOCK_LEN ? _n - n : LIQUID_CHANNEL_BLOCK_LEN;
+            randgen_crandnf_fill(_q->rng, v, m);
+            for (i=0; i<m; i++)
+                _y[n+i] = _y[n+i]*_q->gamma + v[i]*nstd;
+        }
+    }
 }
 
+//
+// internal methods
+//
+
+// compute gain of next shadowing sample
+float CHANNEL(_shadowing_gain)(CHANNEL() _q)
+{
+    // TODO: use type-specific value other than float
+    float g = 0;
+    IIRFILT(_execute)(_q->shadowing_filter, randgen_randnf(_q->rng)*_q->shadowing_std, &g);
+    g /= _q->shadowing_fd * 6.9f;
+    return powf(10.0f, g/20.0f);
+}
@@ -40,6 +40,9 @@ struct TVMPCH(_s) {
     float std;
     float alpha;
     float beta;
+
+    randgen rng;        // coefficient noise generator
+    TC * v;             // coefficient noise [size: h_len x 1]
 };
 
 // create time-varying multi-path channel emulator object
@@ -69,6 +72,8 @@ TVMPCH() TVMPCH(_create)(unsigned int _n,
     q->beta  = _tau;
     q->std   = 2.0f * _std / sqrtf(q->beta);
     q->alpha = 1.0f - q->beta;
+    q->rng   = randgen_create(randgen_seed_from_rand());
+    q->v     = (TC *) malloc((q->h_len)*sizeof(TC));
 
     // time-reverse coefficients
     unsigned int i;
@@ -90,6 +95,8 @@ TVMPCH() TVMPCH(_create)(unsigned int _n,
 void TVMPCH(_destroy)(TVMPCH() _q)
 {
     WINDOW(_destroy)(_q->w);
+    randgen_destroy(_q->rng);
+    free(_q->v);
     free(_q->h);
     free(_q);
 }
@@ -122,8 +129,10 @@ void TVMPCH(_push)(TVMPCH() _q,
 {
     // update coefficients
     unsigned int i;
+    float g = _q->beta * _q->std * M_SQRT1_2;
+    randgen_crandnf_fill(_q->rng, _q->v, _q->h_len-1);
     for (i=0; i<_q->h_len-1; i++)
-        _q->h[i] = _q->alpha*_q->h[i] + _q->beta*(randnf() + _Complex_I*randnf()) * _q->std * M_SQRT1_2;
+        _q->h[i] = _q->alpha*_q->h[i] + g*_q->v[i];
 
     // push sample into window buffer
     WINDOW(_push)(_q->w, _x);
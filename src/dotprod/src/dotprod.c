@@ -166,3 +166,58 @@ void DOTPROD(_execute)(DOTPROD() _q,
     DOTPROD(_run4)(_q->h, _x, _q->n, _y);
 }
 
+// execute dot products on _m consecutive windows of input, computing
+// four outputs at a time so that each coefficient is loaded once
+//  _q      :   dotprod object
+//  _x      :   input array [size: _n+_m-1 x 1]
+//  _m      :   number of outputs
+//  _y      :   output array [size: _m x 1]
+void DOTPROD(_execute_block)(DOTPROD()    _q,
+                             TI *         _x,
+                             unsigned int _m,
+                             TO *         _y)
+{
+    unsigned int i, k;
+    for (i=0; i+4<=_m; i+=4) {
+        TO y0 = 0, y1 = 0, y2 = 0, y3 = 0;
+        for (k=0; k<_q->n; k++) {
+            TC h = _q->h[k];
+            y0 += h * _x[i+k  ];
+            y1 += h * _x[i+k+1];
+            y2 += h * _x[i+k+2];
+            y3 += h * _x[i+k+3];
+        }
+        _y[i  ] = y0;
+        _y[i+1] = y1;
+        _y[i+2] = y2;
+        _y[i+3] = y3;
+    }
+
+    // remaining outputs
+    for ( ; i<_m; i++)
+        DOTPROD(_execute)(_q, &_x[i], &_y[i]);
+}
+
+
+// execute bank of _m dot products over the same input, with
+// coefficients stored tap by tap: _y[i] = sum_k h[k*_m+i] _x[k]
+//  _q      :   dotprod object
+//  _x      :   input array [size: _n/_m x 1]
+//  _m      :   number of outputs
+//  _y      :   output array [size: _m x 1]
+void DOTPROD(_execute_bank)(DOTPROD()    _q,
+                            TI *         _x,
+                            unsigned int _m,
+                            TO *         _y)
+{
+    unsigned int n = _q->n / _m;
+    unsigned int i, k;
+    for (i=0; i<_m; i++)
+        _y[i] = 0;
+    for (k=0; k<n; k++) {
+        TI x = _x[k];
+        TC * h = &_q->h[k*_m];
+        for (i=0; i<_m; i++)
+            _y[i] += h[i] * x;
+    }
+}
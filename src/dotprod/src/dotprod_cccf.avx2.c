@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Floating-point dot product, complex input, complex coefficients (AVX2/FMA)
+//
+// This file is compiled with -mavx2 -mfma regardless of the build host;
+// the kernel is only called when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX, AVX2, FMA
+
+// dot product using 256-bit FMA, two-way unrolled
+//
+// (a + jb)(c + jd) = (ac - bd) + j(ad + bc)
+//
+// The products of the input with the real and imaginary parts of the
+// coefficients are accumulated separately; the imaginary accumulator
+// is swapped pair-wise and combined with addsub once at the end.
+//
+//  _hi     :   coefficients (real), each value repeated
+//              { hi[0], hi[0], hi[1], hi[1], ... } [size: 1 x 2*_n]
+//  _hq     :   coefficients (imag), each value repeated [size: 1 x 2*_n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   input lengths
+//  _y      :   output dot product
+void dotprod_cccf_run_avx2(float *         _hi,
+                           float *         _hq,
+                           float complex * _x,
+                           unsigned int    _n,
+                           float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m256 sumi0 = _mm256_setzero_ps();
+    __m256 sumq0 = _mm256_setzero_ps();
+    __m256 sumi1 = _mm256_setzero_ps();
+    __m256 sumq1 = _mm256_setzero_ps();
+
+    // r = 16*floor(n/16)
+    unsigned int r = (n >> 4) << 4;
+
+    __m256 v0, v1;
+    unsigned int i;
+    for (i=0; i<r; i+=16) {
+        // load inputs into register (unaligned)
+        v0 = _mm256_loadu_ps(&x[i+0]);
+        v1 = _mm256_loadu_ps(&x[i+8]);
+
+        // multiply and accumulate
+        sumi0 = _mm256_fmadd_ps(v0, _mm256_loadu_ps(&_hi[i+0]), sumi0);
+        sumq0 = _mm256_fmadd_ps(v0, _mm256_loadu_ps(&_hq[i+0]), sumq0);
+        sumi1 = _mm256_fmadd_ps(v1, _mm256_loadu_ps(&_hi[i+8]), sumi1);
+        sumq1 = _mm256_fmadd_ps(v1, _mm256_loadu_ps(&_hq[i+8]), sumq1);
+    }
+
+    // remaining groups of 8 (four complex samples)
+    for ( ; i+8<=n; i+=8) {
+        v0 = _mm256_loadu_ps(&x[i]);
+        sumi0 = _mm256_fmadd_ps(v0, _mm256_loadu_ps(&_hi[i]), sumi0);
+        sumq0 = _mm256_fmadd_ps(v0, _mm256_loadu_ps(&_hq[i]), sumq0);
+    }
+
+    // fold down
+    sumi0 = _mm256_add_ps(sumi0, sumi1);
+    sumq0 = _mm256_add_ps(sumq0, sumq1);
+
+    // shuffle values and combine: { re, im, re, im, ... }
+    sumq0 = _mm256_permute_ps(sumq0, _MM_SHUFFLE(2,3,0,1));
+    __m256 sum = _mm256_addsub_ps(sumi0, sumq0);
+
+    // fold down to { re, im, re, im } and then to { re, im, x, x }
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(sum),
+                          _mm256_extractf128_ps(sum, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+
+    // unload
+    float w[4] __attribute__((aligned(16)));
+    _mm_store_ps(w, s);
+    float complex total = w[0] + _Complex_I*w[1];
+
+    // cleanup
+    for (i/=2; i<_n; i++)
+        total += _x[i] * ( _hi[2*i] + _hq[2*i]*_Complex_I );
+
+    // set return value
+    *_y = total;
+}
+
+// multi-output dot product: the real and imaginary parts of each
+// coefficient are broadcast once and applied to 8 consecutive (complex)
+// outputs; the partial products are combined as in the kernel above
+//  _hi     :   in-phase coefficients, repeated [size: 1 x 2*_n]
+//  _hq     :   quadrature coefficients, repeated [size: 1 x 2*_n]
+//  _x      :   input array [size: 1 x _n+_m-1]
+//  _n      :   coefficients length
+//  _m      :   number of outputs
+//  _y      :   output array [size: 1 x _m]
+void dotprod_cccf_run_block_avx2(float *         _hi,
+                                 float *         _hq,
+                                 float complex * _x,
+                                 unsigned int    _n,
+                                 unsigned int    _m,
+                                 float complex * _y)
+{
+    unsigned int i, k;
+    for (i=0; i+8<=_m; i+=8) {
+        __m256 sumi0 = _mm256_setzero_ps();
+        __m256 sumq0 = _mm256_setzero_ps();
+        __m256 sumi1 = _mm256_setzero_ps();
+        __m256 sumq1 = _mm256_setzero_ps();
+        for (k=0; k<_n; k++) {
+            __m256 hi = _mm256_broadcast_ss(&_hi[2*k]);
+            __m256 hq = _mm256_broadcast_ss(&_hq[2*k]);
+            float * x = (float*) &_x[i+k];
+            __m256 v0 = _mm256_loadu_ps(&x[0]);
+            __m256 v1 = _mm256_loadu_ps(&x[8]);
+            sumi0 = _mm256_fmadd_ps(hi, v0, sumi0);
+            sumq0 = _mm256_fmadd_ps(hq, v0, sumq0);
+            sumi1 = _mm256_fmadd_ps(hi, v1, sumi1);
+            sumq1 = _mm256_fmadd_ps(hq, v1, sumq1);
+        }
+        // { re, im, re, im, ... }
+        sumq0 = _mm256_permute_ps(sumq0, _MM_SHUFFLE(2,3,0,1));
+        sumq1 = _mm256_permute_ps(sumq1, _MM_SHUFFLE(2,3,0,1));
+        float * y = (float*) &_y[i];
+        _mm256_storeu_ps(&y[0], _mm256_addsub_ps(sumi0, sumq0));
+        _mm256_storeu_ps(&y[8], _mm256_addsub_ps(sumi1, sumq1));
+    }
+
+    // remaining outputs
+    for ( ; i<_m; i++) {
+        float complex sum = 0.0f;
+        for (k=0; k<_n; k++)
+            sum += (_hi[2*k] + _Complex_I*_hq[2*k]) * _x[i+k];
+        _y[i] = sum;
+    }
+}
+
+// bank of dot products over a common input: each (complex) input sample
+// is broadcast once as { re, im, re, im, ... } and applied to rows of
+// repeated real and imaginary coefficients, _m outputs wide; the partial
+// products are combined as in the kernels above
+//  _hi     :   in-phase coefficients, tap by tap, repeated [size: 1 x 2*_n*_m]
+//  _hq     :   quadrature coefficients, tap by tap, repeated [size: 1 x 2*_n*_m]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   input length (number of taps)
+//  _m      :   number of outputs
+//  _y      :   output array [size: 1 x _m]
+void dotprod_cccf_run_bank_avx2(float *         _hi,
+                                float *         _hq,
+                                float complex * _x,
+                                unsigned int    _n,
+                                unsigned int    _m,
+                                float complex * _y)
+{
+    unsigned int i, k;
+    unsigned int w = 2*_m;  // row width (floats)
+    float * y = (float*) _y;
+
+    // groups of 8 outputs
+    for (i=0; i+8<=_m; i+=8) {
+        __m256 sumi0 = _mm256_setzero_ps();
+        __m256 sumq0 = _mm256_setzero_ps();
+        __m256 sumi1 = _mm256_setzero_ps();
+        __m256 sumq1 = _mm256_setzero_ps();
+        unsigned int o = 2*i;
+        for (k=0; k<_n; k++, o+=w) {
+            __m256 x = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k]));
+            sumi0 = _mm256_fmadd_ps(x, _mm256_loadu_ps(&_hi[o  ]), sumi0);
+            sumq0 = _mm256_fmadd_ps(x, _mm256_loadu_ps(&_hq[o  ]), sumq0);
+            sumi1 = _mm256_fmadd_ps(x, _mm256_loadu_ps(&_hi[o+8]), sumi1);
+            sumq1 = _mm256_fmadd_ps(x, _mm256_loadu_ps(&_hq[o+8]), sumq1);
+        }
+        // { re, im, re, im, ... }
+        sumq0 = _mm256_permute_ps(sumq0, _MM_SHUFFLE(2,3,0,1));
+        sumq1 = _mm256_permute_ps(sumq1, _MM_SHUFFLE(2,3,0,1));
+        _mm256_storeu_ps(&y[2*i  ], _mm256_addsub_ps(sumi0, sumq0));
+        _mm256_storeu_ps(&y[2*i+8], _mm256_addsub_ps(sumi1, sumq1));
+    }
+
+    // group of 4 outputs, even and odd taps separately
+    if (i+4 <= _m) {
+        __m256 sumi0 = _mm256_setzero_ps();
+        __m256 sumq0 = _mm256_setzero_ps();
+        __m256 sumi1 = _mm256_setzero_ps();
+        __m256 sumq1 = _mm256_setzero_ps();
+        unsigned int o = 2*i;
+        for (k=0; k+2<=_n; k+=2, o+=2*w) {
+            __m256 x0 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k  ]));
+            __m256 x1 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k+1]));
+            sumi0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&_hi[o  ]), sumi0);
+            sumq0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&_hq[o  ]), sumq0);
+            sumi1 = _mm256_fmadd_ps(x1, _mm256_loadu_ps(&_hi[o+w]), sumi1);
+            sumq1 = _mm256_fmadd_ps(x1, _mm256_loadu_ps(&_hq[o+w]), sumq1);
+        }
+        if (k < _n) {
+            __m256 x0 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k]));
+            sumi0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&_hi[o]), sumi0);
+            sumq0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&_hq[o]), sumq0);
+        }
+        sumi0 = _mm256_add_ps(sumi0, sumi1);
+        sumq0 = _mm256_permute_ps(_mm256_add_ps(sumq0, sumq1), _MM_SHUFFLE(2,3,0,1));
+        _mm256_storeu_ps(&y[2*i], _mm256_addsub_ps(sumi0, sumq0));
+        i += 4;
+    }
+
+    // group of 2 outputs, even and odd taps separately
+    if (i+2 <= _m) {
+        __m128 sumi0 = _mm_setzero_ps();
+        __m128 sumq0 = _mm_setzero_ps();
+        __m128 sumi1 = _mm_setzero_ps();
+        __m128 sumq1 = _mm_setzero_ps();
+        unsigned int o = 2*i;
+        for (k=0; k+2<=_n; k+=2, o+=2*w) {
+            __m128 x0 = _mm_castpd_ps(_mm_loaddup_pd((double*)&_x[k  ]));
+            __m128 x1 = _mm_castpd_ps(_mm_loaddup_pd((double*)&_x[k+1]));
+            sumi0 = _mm_fmadd_ps(x0, _mm_loadu_ps(&_hi[o  ]), sumi0);
+            sumq0 = _mm_fmadd_ps(x0, _mm_loadu_ps(&_hq[o  ]), sumq0);
+            sumi1 = _mm_fmadd_ps(x1, _mm_loadu_ps(&_hi[o+w]), sumi1);
+            sumq1 = _mm_fmadd_ps(x1, _mm_loadu_ps(&_hq[o+w]), sumq1);
+        }
+        if (k < _n) {
+            __m128 x0 = _mm_castpd_ps(_mm_loaddup_pd((double*)&_x[k]));
+            sumi0 = _mm_fmadd_ps(x0, _mm_loadu_ps(&_hi[o]), sumi0);
+            sumq0 = _mm_fmadd_ps(x0, _mm_loadu_ps(&_hq[o]), sumq0);
+        }
+        sumi0 = _mm_add_ps(sumi0, sumi1);
+        sumq0 = _mm_permute_ps(_mm_add_ps(sumq0, sumq1), _MM_SHUFFLE(2,3,0,1));
+        _mm_storeu_ps(&y[2*i], _mm_addsub_ps(sumi0, sumq0));
+        i += 2;
+    }
+
+    // remaining output
+    for ( ; i<_m; i++) {
+        float complex sum = 0.0f;
+        for (k=0; k<_n; k++)
+            sum += (_hi[2*(k*_m+i)] + _Complex_I*_hq[2*(k*_m+i)]) * _x[k];
+        _y[i] = sum;
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Floating-point dot product, complex input, complex coefficients (AVX-512F)
+//
+// This file is compiled with -mavx512f regardless of the build host;
+// the kernel is only called when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX-512F
+
+// dot product using 512-bit FMA, two-way unrolled with masked tail
+// (see dotprod_cccf.avx2.c for a description of the method)
+//  _hi     :   coefficients (real), each value repeated
+//              { hi[0], hi[0], hi[1], hi[1], ... } [size: 1 x 2*_n]
+//  _hq     :   coefficients (imag), each value repeated [size: 1 x 2*_n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   input lengths
+//  _y      :   output dot product
+void dotprod_cccf_run_avx512f(float *         _hi,
+                              float *         _hq,
+                              float complex * _x,
+                              unsigned int    _n,
+                              float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m512 sumi0 = _mm512_setzero_ps();
+    __m512 sumq0 = _mm512_setzero_ps();
+    __m512 sumi1 = _mm512_setzero_ps();
+    __m512 sumq1 = _mm512_setzero_ps();
+
+    // r = 32*floor(n/32)
+    unsigned int r = (n >> 5) << 5;
+
+    __m512 v0, v1;
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        // load inputs into register (unaligned)
+        v0 = _mm512_loadu_ps(&x[i+ 0]);
+        v1 = _mm512_loadu_ps(&x[i+16]);
+
+        // multiply and accumulate
+        sumi0 = _mm512_fmadd_ps(v0, _mm512_loadu_ps(&_hi[i+ 0]), sumi0);
+        sumq0 = _mm512_fmadd_ps(v0, _mm512_loadu_ps(&_hq[i+ 0]), sumq0);
+        sumi1 = _mm512_fmadd_ps(v1, _mm512_loadu_ps(&_hi[i+16]), sumi1);
+        sumq1 = _mm512_fmadd_ps(v1, _mm512_loadu_ps(&_hq[i+16]), sumq1);
+    }
+
+    // remaining groups of 16 (eight complex samples)
+    for ( ; i+16<=n; i+=16) {
+        v0 = _mm512_loadu_ps(&x[i]);
+        sumi0 = _mm512_fmadd_ps(v0, _mm512_loadu_ps(&_hi[i]), sumi0);
+        sumq0 = _mm512_fmadd_ps(v0, _mm512_loadu_ps(&_hq[i]), sumq0);
+    }
+
+    // cleanup using masked loads (inactive lanes are zeroed)
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+        v1 = _mm512_maskz_loadu_ps(m, &x[i]);
+        sumi1 = _mm512_fmadd_ps(v1, _mm512_maskz_loadu_ps(m, &_hi[i]), sumi1);
+        sumq1 = _mm512_fmadd_ps(v1, _mm512_maskz_loadu_ps(m, &_hq[i]), sumq1);
+    }
+
+    // fold down
+    sumi0 = _mm512_add_ps(sumi0, sumi1);
+    sumq0 = _mm512_add_ps(sumq0, sumq1);
+
+    // swap quadrature products pair-wise
+    sumq0 = _mm512_permute_ps(sumq0, _MM_SHUFFLE(2,3,0,1));
+
+    // combine even (real) and odd (imaginary) lanes
+    float yi = _mm512_mask_reduce_add_ps(0x5555, sumi0) -
+               _mm512_mask_reduce_add_ps(0x5555, sumq0);
+    float yq = _mm512_mask_reduce_add_ps(0xaaaa, sumi0) +
+               _mm512_mask_reduce_add_ps(0xaaaa, sumq0);
+
+    // set return value
+    *_y = yi + _Complex_I*yq;
+}
@@ -109,6 +109,15 @@ struct dotprod_cccf_s {
     unsigned int n;     // length
     float * hi;         // in-phase
     float * hq;         // quadrature
+
+    // wide-vector kernel selected at run time (NULL if unavailable)
+    void (*run)(float *, float *, float complex *, unsigned int, float complex *);
+
+    // multi-output kernel selected at run time (NULL if unavailable)
+    void (*run_block)(float *, float *, float complex *, unsigned int, unsigned int, float complex *);
+
+    // bank kernel selected at run time (NULL if unavailable)
+    void (*run_bank)(float *, float *, float complex *, unsigned int, unsigned int, float complex *);
 };
 
 dotprod_cccf dotprod_cccf_create(float complex * _h,
@@ -117,9 +126,9 @@ dotprod_cccf dotprod_cccf_create(float complex * _h,
     dotprod_cccf q = (dotprod_cccf)malloc(sizeof(struct dotprod_cccf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->hi = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
-    q->hq = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
+    // allocate memory for coefficients, 64-byte aligned
+    q->hi = (float*) _mm_malloc( 2*q->n*sizeof(float), 64 );
+    q->hq = (float*) _mm_malloc( 2*q->n*sizeof(float), 64 );
 
     // set coefficients, repeated
     //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
@@ -133,6 +142,27 @@ dotprod_cccf dotprod_cccf_create(float complex * _h,
         q->hq[2*i+1] = cimagf(_h[i]);
     }
 
+    // select kernel based on length and processor extensions
+    q->run = NULL;
+#if LIQUID_SIMD_AVX512F
+    if (q->run == NULL && q->n >= 32 && liquid_cpu_has(LIQUID_CPU_AVX512F))
+        q->run = dotprod_cccf_run_avx512f;
+#endif
+#if LIQUID_SIMD_AVX2
+    if (q->run == NULL && q->n >= 8 && liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+        q->run = dotprod_cccf_run_avx2;
+#endif
+    q->run_block = NULL;
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+        q->run_block = dotprod_cccf_run_block_avx2;
+#endif
+    q->run_bank = NULL;
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+        q->run_bank = dotprod_cccf_run_bank_avx2;
+#endif
+
     // return object
     return q;
 }
@@ -171,14 +201,53 @@ void dotprod_cccf_execute(dotprod_cccf    _q,
                           float complex * _x,
                           float complex * _y)
 {
-    // switch based on size
-    if (_q->n < 32) {
+    // switch based on size and available kernels
+    if (_q->run != NULL) {
+        _q->run(_q->hi, _q->hq, _x, _q->n, _y);
+    } else if (_q->n < 32) {
         dotprod_cccf_execute_mmx(_q, _x, _y);
     } else {
         dotprod_cccf_execute_mmx4(_q, _x, _y);
     }
 }
 
+// execute dot products on _m consecutive windows of input
+void dotprod_cccf_execute_block(dotprod_cccf    _q,
+                                float complex * _x,
+                                unsigned int    _m,
+                                float complex * _y)
+{
+    if (_q->run_block != NULL) {
+        _q->run_block(_q->hi, _q->hq, _x, _q->n, _m, _y);
+        return;
+    }
+
+    unsigned int i;
+    for (i=0; i<_m; i++)
+        dotprod_cccf_execute(_q, &_x[i], &_y[i]);
+}
+
+// execute bank of _m dot products over the same input
+void dotprod_cccf_execute_bank(dotprod_cccf    _q,
+                               float complex * _x,
+                               unsigned int    _m,
+                               float complex * _y)
+{
+    unsigned int n = _q->n / _m;
+    if (_q->run_bank != NULL) {
+        _q->run_bank(_q->hi, _q->hq, _x, n, _m, _y);
+        return;
+    }
+
+    unsigned int i, k;
+    for (i=0; i<_m; i++)
+        _y[i] = 0.0f;
+    for (k=0; k<n; k++) {
+        for (i=0; i<_m; i++)
+            _y[i] += (_q->hi[2*(k*_m+i)] + _Complex_I*_q->hq[2*(k*_m+i)]) * _x[k];
+    }
+}
+
 // use MMX/SSE extensions
 //
 // (a + jb)(c + jd) = (ac - bd) + j(ad + bc)
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Floating-point dot product, complex input, real coefficients (AVX2/FMA)
+//
+// This file is compiled with -mavx2 -mfma regardless of the build host;
+// the kernel is only called when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX, AVX2, FMA
+
+// dot product using 256-bit FMA, four-way unrolled
+//  _h      :   coefficients array, each value repeated
+//              { h[0], h[0], h[1], h[1], ... } [size: 1 x 2*_n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   input lengths
+//  _y      :   output dot product
+void dotprod_crcf_run_avx2(float *         _h,
+                           float complex * _x,
+                           unsigned int    _n,
+                           float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+
+    // r = 32*floor(n/32)
+    unsigned int r = (n >> 5) << 5;
+
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+ 0]), _mm256_loadu_ps(&_h[i+ 0]), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+ 8]), _mm256_loadu_ps(&_h[i+ 8]), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+16]), _mm256_loadu_ps(&_h[i+16]), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+24]), _mm256_loadu_ps(&_h[i+24]), sum3);
+    }
+
+    // remaining groups of 8 (four complex samples)
+    for ( ; i+8<=n; i+=8)
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i]), _mm256_loadu_ps(&_h[i]), sum0);
+
+    // fold down into single 8-element register
+    sum0 = _mm256_add_ps(sum0, sum1);
+    sum2 = _mm256_add_ps(sum2, sum3);
+    sum0 = _mm256_add_ps(sum0, sum2);
+
+    // fold down to { re, im, re, im } and then to { re, im, x, x }
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(sum0),
+                          _mm256_extractf128_ps(sum0, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+
+    // unload
+    float w[4] __attribute__((aligned(16)));
+    _mm_store_ps(w, s);
+
+    // cleanup (note: n _must_ be even)
+    for ( ; i<n; i+=2) {
+        w[0] += x[i  ] * _h[i  ];
+        w[1] += x[i+1] * _h[i+1];
+    }
+
+    // set return value
+    *_y = w[0] + _Complex_I*w[1];
+}
+
+// multi-output dot product: each coefficient is broadcast once and
+// applied to 16 consecutive (complex) outputs held in four accumulators
+//  _h      :   coefficients array, each value repeated
+//              { h[0], h[0], h[1], h[1], ... } [size: 1 x 2*_n]
+//  _x      :   input array [size: 1 x _n+_m-1]
+//  _n      :   coefficients length
+//  _m      :   number of outputs
+//  _y      :   output array [size: 1 x _m]
+void dotprod_crcf_run_block_avx2(float *         _h,
+                                 float complex * _x,
+                                 unsigned int    _n,
+                                 unsigned int    _m,
+                                 float complex * _y)
+{
+    unsigned int i, k;
+    for (i=0; i+16<=_m; i+=16) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        __m256 sum2 = _mm256_setzero_ps();
+        __m256 sum3 = _mm256_setzero_ps();
+        for (k=0; k<_n; k++) {
+            __m256 h = _mm256_broadcast_ss(&_h[2*k]);
+            float * x = (float*) &_x[i+k];
+            sum0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[ 0]), sum0);
+            sum1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[ 8]), sum1);
+            sum2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[16]), sum2);
+            sum3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[24]), sum3);
+        }
+        float * y = (float*) &_y[i];
+        _mm256_storeu_ps(&y[ 0], sum0);
+        _mm256_storeu_ps(&y[ 8], sum1);
+        _mm256_storeu_ps(&y[16], sum2);
+        _mm256_storeu_ps(&y[24], sum3);
+    }
+
+    // remaining groups of 4 outputs
+    for ( ; i+4<=_m; i+=4) {
+        __m256 sum = _mm256_setzero_ps();
+        for (k=0; k<_n; k++)
+            sum = _mm256_fmadd_ps(_mm256_broadcast_ss(&_h[2*k]), _mm256_loadu_ps((float*)&_x[i+k]), sum);
+        _mm256_storeu_ps((float*)&_y[i], sum);
+    }
+
+    // remaining outputs
+    for ( ; i<_m; i++) {
+        float complex sum = 0.0f;
+        for (k=0; k<_n; k++)
+            sum += _h[2*k] * _x[i+k];
+        _y[i] = sum;
+    }
+}
+
+// bank of dot products over a common input: each (complex) input sample
+// is broadcast once as { re, im, re, im, ... } and applied to a row of
+// repeated coefficients, _m outputs wide; taps are split across several
+// accumulators to hide FMA latency
+//  _h      :   coefficients, tap by tap, each value repeated [size: 1 x 2*_n*_m]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   input length (number of taps)
+//  _m      :   number of outputs
+//  _y      :   output array [size: 1 x _m]
+void dotprod_crcf_run_bank_avx2(float *         _h,
+                                float complex * _x,
+                                unsigned int    _n,
+                                unsigned int    _m,
+                                float complex * _y)
+{
+    unsigned int i, k;
+    unsigned int w = 2*_m;  // row width (floats)
+    float * y = (float*) _y;
+
+    // groups of 8 outputs, even and odd taps separately
+    for (i=0; i+8<=_m; i+=8) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        __m256 sum2 = _mm256_setzero_ps();
+        __m256 sum3 = _mm256_setzero_ps();
+        float * h = &_h[2*i];
+        for (k=0; k+2<=_n; k+=2, h+=2*w) {
+            __m256 x0 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k  ]));
+            __m256 x1 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k+1]));
+            sum0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&h[  0]), sum0);
+            sum1 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&h[  8]), sum1);
+            sum2 = _mm256_fmadd_ps(x1, _mm256_loadu_ps(&h[w+0]), sum2);
+            sum3 = _mm256_fmadd_ps(x1, _mm256_loadu_ps(&h[w+8]), sum3);
+        }
+        if (k < _n) {
+            __m256 x0 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k]));
+            sum0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&h[0]), sum0);
+            sum1 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&h[8]), sum1);
+        }
+        _mm256_storeu_ps(&y[2*i  ], _mm256_add_ps(sum0, sum2));
+        _mm256_storeu_ps(&y[2*i+8], _mm256_add_ps(sum1, sum3));
+    }
+
+    // group of 4 outputs, four taps at a time
+    if (i+4 <= _m) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        __m256 sum2 = _mm256_setzero_ps();
+        __m256 sum3 = _mm256_setzero_ps();
+        float * h = &_h[2*i];
+        for (k=0; k+4<=_n; k+=4, h+=4*w) {
+            sum0 = _mm256_fmadd_ps(_mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k  ])), _mm256_loadu_ps(&h[   0]), sum0);
+            sum1 = _mm256_fmadd_ps(_mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k+1])), _mm256_loadu_ps(&h[   w]), sum1);
+            sum2 = _mm256_fmadd_ps(_mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k+2])), _mm256_loadu_ps(&h[ 2*w]), sum2);
+            sum3 = _mm256_fmadd_ps(_mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k+3])), _mm256_loadu_ps(&h[ 3*w]), sum3);
+        }
+        for ( ; k<_n; k++, h+=w)
+            sum0 = _mm256_fmadd_ps(_mm256_castpd_ps(_mm256_broadcast_sd((double*)&_x[k])), _mm256_loadu_ps(h), sum0);
+        sum0 = _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3));
+        _mm256_storeu_ps(&y[2*i], sum0);
+        i += 4;
+    }
+
+    // group of 2 outputs, four taps at a time
+    if (i+2 <= _m) {
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        __m128 sum2 = _mm_setzero_ps();
+        __m128 sum3 = _mm_setzero_ps();
+        float * h = &_h[2*i];
+        for (k=0; k+4<=_n; k+=4, h+=4*w) {
+            sum0 = _mm_fmadd_ps(_mm_castpd_ps(_mm_loaddup_pd((double*)&_x[k  ])), _mm_loadu_ps(&h[   0]), sum0);
+            sum1 = _mm_fmadd_ps(_mm_castpd_ps(_mm_loaddup_pd((double*)&_x[k+1])), _mm_loadu_ps(&h[   w]), sum1);
+            sum2 = _mm_fmadd_ps(_mm_castpd_ps(_mm_loaddup_pd((double*)&_x[k+2])), _mm_loadu_ps(&h[ 2*w]), sum2);
+            sum3 = _mm_fmadd_ps(_mm_castpd_ps(_mm_loaddup_pd((double*)&_x[k+3])), _mm_loadu_ps(&h[ 3*w]), sum3);
+        }
+        for ( ; k<_n; k++, h+=w)
+            sum0 = _mm_fmadd_ps(_mm_castpd_ps(_mm_loaddup_pd((double*)&_x[k])), _mm_loadu_ps(h), sum0);
+        sum0 = _mm_add_ps(_mm_add_ps(sum0, sum1), _mm_add_ps(sum2, sum3));
+        _mm_storeu_ps(&y[2*i], sum0);
+        i += 2;
+    }
+
+    // remaining output
+    for ( ; i<_m; i++) {
+        float complex sum = 0.0f;
+        for (k=0; k<_n; k++)
+            sum += _h[2*(k*_m+i)] * _x[k];
+        _y[i] = sum;
+    }
+}
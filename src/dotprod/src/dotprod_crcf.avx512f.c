@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Floating-point dot product, complex input, real coefficients (AVX-512F)
+//
+// This file is compiled with -mavx512f regardless of the build host;
+// the kernel is only called when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX-512F
+
+// dot product using 512-bit FMA, four-way unrolled with masked tail
+//  _h      :   coefficients array, each value repeated
+//              { h[0], h[0], h[1], h[1], ... } [size: 1 x 2*_n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   input lengths
+//  _y      :   output dot product
+void dotprod_crcf_run_avx512f(float *         _h,
+                              float complex * _x,
+                              unsigned int    _n,
+                              float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    __m512 sum2 = _mm512_setzero_ps();
+    __m512 sum3 = _mm512_setzero_ps();
+
+    // r = 64*floor(n/64)
+    unsigned int r = (n >> 6) << 6;
+
+    unsigned int i;
+    for (i=0; i<r; i+=64) {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+ 0]), _mm512_loadu_ps(&_h[i+ 0]), sum0);
+        sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+16]), _mm512_loadu_ps(&_h[i+16]), sum1);
+        sum2 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+32]), _mm512_loadu_ps(&_h[i+32]), sum2);
+        sum3 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+48]), _mm512_loadu_ps(&_h[i+48]), sum3);
+    }
+
+    // remaining groups of 16 (eight complex samples)
+    for ( ; i+16<=n; i+=16)
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i]), _mm512_loadu_ps(&_h[i]), sum0);
+
+    // cleanup using masked loads (inactive lanes are zeroed)
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+        sum1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &x[i]),
+                               _mm512_maskz_loadu_ps(m, &_h[i]), sum1);
+    }
+
+    // fold down
+    sum0 = _mm512_add_ps(sum0, sum1);
+    sum2 = _mm512_add_ps(sum2, sum3);
+    sum0 = _mm512_add_ps(sum0, sum2);
+
+    // reduce even (real) and odd (imaginary) lanes separately
+    float yi = _mm512_mask_reduce_add_ps(0x5555, sum0);
+    float yq = _mm512_mask_reduce_add_ps(0xaaaa, sum0);
+
+    // set return value
+    *_y = yi + _Complex_I*yq;
+}
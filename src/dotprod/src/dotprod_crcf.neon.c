@@ -163,6 +163,33 @@ void dotprod_crcf_execute(dotprod_crcf    _q,
     }
 }
 
+// execute dot products on _m consecutive windows of input
+void dotprod_crcf_execute_block(dotprod_crcf    _q,
+                                float complex * _x,
+                                unsigned int    _m,
+                                float complex * _y)
+{
+    unsigned int i;
+    for (i=0; i<_m; i++)
+        dotprod_crcf_execute(_q, &_x[i], &_y[i]);
+}
+
+// execute bank of _m dot products over the same input
+void dotprod_crcf_execute_bank(dotprod_crcf    _q,
+                               float complex * _x,
+                               unsigned int    _m,
+                               float complex * _y)
+{
+    unsigned int n = _q->n / _m;
+    unsigned int i, k;
+    for (i=0; i<_m; i++)
+        _y[i] = 0.0f;
+    for (k=0; k<n; k++) {
+        for (i=0; i<_m; i++)
+            _y[i] += _q->h[2*(k*_m+i)] * _x[k];
+    }
+}
+
 // use ARM Neon extensions
 void dotprod_crcf_execute_neon(dotprod_crcf    _q,
                                float complex * _x,
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Floating-point dot product (AVX2/FMA)
+//
+// This file is compiled with -mavx2 -mfma regardless of the build host;
+// the kernel is only called when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX, AVX2, FMA
+
+// dot product using 256-bit FMA, four-way unrolled
+//  _h      :   coefficients array [size: 1 x _n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   input lengths
+//  _y      :   output dot product
+void dotprod_rrrf_run_avx2(float *      _h,
+                           float *      _x,
+                           unsigned int _n,
+                           float *      _y)
+{
+    // load zeros into sum registers
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+
+    // r = 32*floor(n/32)
+    unsigned int r = (_n >> 5) << 5;
+
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+ 0]), _mm256_loadu_ps(&_h[i+ 0]), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+ 8]), _mm256_loadu_ps(&_h[i+ 8]), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+16]), _mm256_loadu_ps(&_h[i+16]), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+24]), _mm256_loadu_ps(&_h[i+24]), sum3);
+    }
+
+    // remaining groups of 8
+    for ( ; i+8<=_n; i+=8)
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i]), _mm256_loadu_ps(&_h[i]), sum0);
+
+    // fold down into single 8-element register
+    sum0 = _mm256_add_ps(sum0, sum1);
+    sum2 = _mm256_add_ps(sum2, sum3);
+    sum0 = _mm256_add_ps(sum0, sum2);
+
+    // fold down to single value
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(sum0),
+                          _mm256_extractf128_ps(sum0, 1));
+    s = _mm_hadd_ps(s, s);
+    s = _mm_hadd_ps(s, s);
+    float total = _mm_cvtss_f32(s);
+
+    // cleanup
+    for ( ; i<_n; i++)
+        total += _x[i] * _h[i];
+
+    // set return value
+    *_y = total;
+}
+
+// multi-output dot product: each coefficient is broadcast once and
+// applied to 32 consecutive outputs held in four accumulators
+//  _h      :   coefficients array [size: 1 x _n]
+//  _x      :   input array [size: 1 x _n+_m-1]
+//  _n      :   coefficients length
+//  _m      :   number of outputs
+//  _y      :   output array [size: 1 x _m]
+void dotprod_rrrf_run_block_avx2(float *      _h,
+                                 float *      _x,
+                                 unsigned int _n,
+                                 unsigned int _m,
+                                 float *      _y)
+{
+    unsigned int i, k;
+    for (i=0; i+32<=_m; i+=32) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        __m256 sum2 = _mm256_setzero_ps();
+        __m256 sum3 = _mm256_setzero_ps();
+        for (k=0; k<_n; k++) {
+            __m256 h = _mm256_broadcast_ss(&_h[k]);
+            float * x = &_x[i+k];
+            sum0 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[ 0]), sum0);
+            sum1 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[ 8]), sum1);
+            sum2 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[16]), sum2);
+            sum3 = _mm256_fmadd_ps(h, _mm256_loadu_ps(&x[24]), sum3);
+        }
+        _mm256_storeu_ps(&_y[i+ 0], sum0);
+        _mm256_storeu_ps(&_y[i+ 8], sum1);
+        _mm256_storeu_ps(&_y[i+16], sum2);
+        _mm256_storeu_ps(&_y[i+24], sum3);
+    }
+
+    // remaining groups of 8 outputs
+    for ( ; i+8<=_m; i+=8) {
+        __m256 sum = _mm256_setzero_ps();
+        for (k=0; k<_n; k++)
+            sum = _mm256_fmadd_ps(_mm256_broadcast_ss(&_h[k]), _mm256_loadu_ps(&_x[i+k]), sum);
+        _mm256_storeu_ps(&_y[i], sum);
+    }
+
+    // remaining outputs
+    for ( ; i<_m; i++) {
+        float sum = 0.0f;
+        for (k=0; k<_n; k++)
+            sum += _h[k] * _x[i+k];
+        _y[i] = sum;
+    }
+}
+
+// bank of dot products over a common input: each input sample is
+// broadcast once and applied to a row of coefficients, _m outputs wide;
+// even and odd taps accumulate separately to hide FMA latency
+//  _h      :   coefficients, tap by tap [size: 1 x _n*_m]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   input length (number of taps)
+//  _m      :   number of outputs
+//  _y      :   output array [size: 1 x _m]
+void dotprod_rrrf_run_bank_avx2(float *      _h,
+                                float *      _x,
+                                unsigned int _n,
+                                unsigned int _m,
+                                float *      _y)
+{
+    unsigned int i, k;
+
+    // groups of 16 outputs
+    for (i=0; i+16<=_m; i+=16) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        __m256 sum2 = _mm256_setzero_ps();
+        __m256 sum3 = _mm256_setzero_ps();
+        float * h = &_h[i];
+        for (k=0; k+2<=_n; k+=2, h+=2*_m) {
+            __m256 x0 = _mm256_broadcast_ss(&_x[k  ]);
+            __m256 x1 = _mm256_broadcast_ss(&_x[k+1]);
+            sum0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&h[     0]), sum0);
+            sum1 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&h[     8]), sum1);
+            sum2 = _mm256_fmadd_ps(x1, _mm256_loadu_ps(&h[_m+  0]), sum2);
+            sum3 = _mm256_fmadd_ps(x1, _mm256_loadu_ps(&h[_m+  8]), sum3);
+        }
+        if (k < _n) {
+            __m256 x0 = _mm256_broadcast_ss(&_x[k]);
+            sum0 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&h[0]), sum0);
+            sum1 = _mm256_fmadd_ps(x0, _mm256_loadu_ps(&h[8]), sum1);
+        }
+        _mm256_storeu_ps(&_y[i  ], _mm256_add_ps(sum0, sum2));
+        _mm256_storeu_ps(&_y[i+8], _mm256_add_ps(sum1, sum3));
+    }
+
+    // group of 8 outputs, four taps at a time
+    if (i+8 <= _m) {
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        __m256 sum2 = _mm256_setzero_ps();
+        __m256 sum3 = _mm256_setzero_ps();
+        float * h = &_h[i];
+        for (k=0; k+4<=_n; k+=4, h+=4*_m) {
+            sum0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_x[k  ]), _mm256_loadu_ps(&h[   0]), sum0);
+            sum1 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_x[k+1]), _mm256_loadu_ps(&h[  _m]), sum1);
+            sum2 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_x[k+2]), _mm256_loadu_ps(&h[2*_m]), sum2);
+            sum3 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_x[k+3]), _mm256_loadu_ps(&h[3*_m]), sum3);
+        }
+        for ( ; k<_n; k++, h+=_m)
+            sum0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&_x[k]), _mm256_loadu_ps(h), sum0);
+        sum0 = _mm256_add_ps(_mm256_add_ps(sum0, sum1), _mm256_add_ps(sum2, sum3));
+        _mm256_storeu_ps(&_y[i], sum0);
+        i += 8;
+    }
+
+    // group of 4 outputs, four taps at a time
+    if (i+4 <= _m) {
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        __m128 sum2 = _mm_setzero_ps();
+        __m128 sum3 = _mm_setzero_ps();
+        float * h = &_h[i];
+        for (k=0; k+4<=_n; k+=4, h+=4*_m) {
+            sum0 = _mm_fmadd_ps(_mm_broadcast_ss(&_x[k  ]), _mm_loadu_ps(&h[   0]), sum0);
+            sum1 = _mm_fmadd_ps(_mm_broadcast_ss(&_x[k+1]), _mm_loadu_ps(&h[  _m]), sum1);
+            sum2 = _mm_fmadd_ps(_mm_broadcast_ss(&_x[k+2]), _mm_loadu_ps(&h[2*_m]), sum2);
+            sum3 = _mm_fmadd_ps(_mm_broadcast_ss(&_x[k+3]), _mm_loadu_ps(&h[3*_m]), sum3);
+        }
+        for ( ; k<_n; k++, h+=_m)
+            sum0 = _mm_fmadd_ps(_mm_broadcast_ss(&_x[k]), _mm_loadu_ps(h), sum0);
+        sum0 = _mm_add_ps(_mm_add_ps(sum0, sum1), _mm_add_ps(sum2, sum3));
+        _mm_storeu_ps(&_y[i], sum0);
+        i += 4;
+    }
+
+    // remaining outputs
+    for ( ; i<_m; i++) {
+        float sum = 0.0f;
+        for (k=0; k<_n; k++)
+            sum += _h[k*_m+i] * _x[k];
+        _y[i] = sum;
+    }
+}
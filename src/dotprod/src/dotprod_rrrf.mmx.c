@@ -108,6 +108,15 @@ void dotprod_rrrf_run4(float *      _h,
 struct dotprod_rrrf_s {
     unsigned int n;     // length
     float * h;          // coefficients array
+
+    // wide-vector kernel selected at run time (NULL if unavailable)
+    void (*run)(float *, float *, unsigned int, float *);
+
+    // multi-output kernel selected at run time (NULL if unavailable)
+    void (*run_block)(float *, float *, unsigned int, unsigned int, float *);
+
+    // bank kernel selected at run time (NULL if unavailable)
+    void (*run_bank)(float *, float *, unsigned int, unsigned int, float *);
 };
 
 dotprod_rrrf dotprod_rrrf_create(float *      _h,
@@ -116,12 +125,33 @@ dotprod_rrrf dotprod_rrrf_create(float *      _h,
     dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->h = (float*) _mm_malloc( q->n*sizeof(float), 16);
+    // allocate memory for coefficients, 64-byte aligned
+    q->h = (float*) _mm_malloc( q->n*sizeof(float), 64);
 
     // set coefficients
     memmove(q->h, _h, _n*sizeof(float));
 
+    // select kernel based on length and processor extensions
+    q->run = NULL;
+#if LIQUID_SIMD_AVX512F
+    if (q->run == NULL && q->n >= 64 && liquid_cpu_has(LIQUID_CPU_AVX512F))
+        q->run = dotprod_rrrf_run_avx512f;
+#endif
+#if LIQUID_SIMD_AVX2
+    if (q->run == NULL && q->n >= 16 && liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+        q->run = dotprod_rrrf_run_avx2;
+#endif
+    q->run_block = NULL;
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+        q->run_block = dotprod_rrrf_run_block_avx2;
+#endif
+    q->run_bank = NULL;
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+        q->run_bank = dotprod_rrrf_run_bank_avx2;
+#endif
+
     // return object
     return q;
 }
@@ -156,14 +186,53 @@ void dotprod_rrrf_execute(dotprod_rrrf _q,
                           float *      _x,
                           float *      _y)
 {
-    // switch based on size
-    if (_q->n < 16) {
+    // switch based on size and available kernels
+    if (_q->run != NULL) {
+        _q->run(_q->h, _x, _q->n, _y);
+    } else if (_q->n < 16) {
         dotprod_rrrf_execute_mmx(_q, _x, _y);
     } else {
         dotprod_rrrf_execute_mmx4(_q, _x, _y);
     }
 }
 
+// execute dot products on _m consecutive windows of input
+void dotprod_rrrf_execute_block(dotprod_rrrf  _q,
+                                float *       _x,
+                                unsigned int  _m,
+                                float *       _y)
+{
+    if (_q->run_block != NULL) {
+        _q->run_block(_q->h, _x, _q->n, _m, _y);
+        return;
+    }
+
+    unsigned int i;
+    for (i=0; i<_m; i++)
+        dotprod_rrrf_execute(_q, &_x[i], &_y[i]);
+}
+
+// execute bank of _m dot products over the same input
+void dotprod_rrrf_execute_bank(dotprod_rrrf    _q,
+                               float *         _x,
+                               unsigned int    _m,
+                               float *         _y)
+{
+    unsigned int n = _q->n / _m;
+    if (_q->run_bank != NULL) {
+        _q->run_bank(_q->h, _x, n, _m, _y);
+        return;
+    }
+
+    unsigned int i, k;
+    for (i=0; i<_m; i++)
+        _y[i] = 0.0f;
+    for (k=0; k<n; k++) {
+        for (i=0; i<_m; i++)
+            _y[i] += _q->h[k*_m+i] * _x[k];
+    }
+}
+
 // use MMX/SSE extensions
 void dotprod_rrrf_execute_mmx(dotprod_rrrf _q,
                               float *      _x,
@@ -156,6 +156,33 @@ void dotprod_rrrf_execute(dotprod_rrrf _q,
     }
 }
 
+// execute dot products on _m consecutive windows of input
+void dotprod_rrrf_execute_block(dotprod_rrrf _q,
+                                float *      _x,
+                                unsigned int _m,
+                                float *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_m; i++)
+        dotprod_rrrf_execute(_q, &_x[i], &_y[i]);
+}
+
+// execute bank of _m dot products over the same input
+void dotprod_rrrf_execute_bank(dotprod_rrrf    _q,
+                               float *         _x,
+                               unsigned int    _m,
+                               float *         _y)
+{
+    unsigned int n = _q->n / _m;
+    unsigned int i, k;
+    for (i=0; i<_m; i++)
+        _y[i] = 0.0f;
+    for (k=0; k<n; k++) {
+        for (i=0; i<_m; i++)
+            _y[i] += _q->h[k*_m+i] * _x[k];
+    }
+}
+
 // use MMX/SSE extensions
 void dotprod_rrrf_execute_sse4(dotprod_rrrf _q,
                                float *      _x,
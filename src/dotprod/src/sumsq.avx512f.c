@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// sumsq.avx512f.c : floating-point sum of squares (AVX-512F)
+//
+// This file is compiled with -mavx512f regardless of the build host;
+// the kernel is only called when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX-512F
+
+// sum squares using 512-bit FMA, two-way unrolled with masked tail
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+float liquid_sumsqf_avx512f(float *      _v,
+                            unsigned int _n)
+{
+    // load zeros into sum registers
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+
+    // r = 32*floor(n/32)
+    unsigned int r = (_n >> 5) << 5;
+
+    __m512 v0, v1;
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        v0 = _mm512_loadu_ps(&_v[i+ 0]);
+        v1 = _mm512_loadu_ps(&_v[i+16]);
+        sum0 = _mm512_fmadd_ps(v0, v0, sum0);
+        sum1 = _mm512_fmadd_ps(v1, v1, sum1);
+    }
+
+    // remaining group of 16
+    if (i+16 <= _n) {
+        v0 = _mm512_loadu_ps(&_v[i]);
+        sum0 = _mm512_fmadd_ps(v0, v0, sum0);
+        i += 16;
+    }
+
+    // cleanup using masked load (inactive lanes are zeroed)
+    if (i < _n) {
+        __mmask16 m = (__mmask16)((1u << (_n - i)) - 1);
+        v1 = _mm512_maskz_loadu_ps(m, &_v[i]);
+        sum1 = _mm512_fmadd_ps(v1, v1, sum1);
+    }
+
+    // fold down and return
+    return _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+}
@@ -49,11 +49,11 @@
 #include <pmmintrin.h>  // SSE3
 #endif
 
-// sum squares, basic loop
+// sum squares, SSE
 //  _v      :   input array [size: 1 x _n]
 //  _n      :   input length
-float liquid_sumsqf(float *      _v,
-                    unsigned int _n)
+static float liquid_sumsqf_sse(float *      _v,
+                               unsigned int _n)
 {
     // first cut: ...
     __m128 v;   // input vector
@@ -102,6 +102,26 @@ float liquid_sumsqf(float *      _v,
     return total;
 }
 
+// sum squares, selecting kernel based on length and processor extensions
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+float liquid_sumsqf(float *      _v,
+                    unsigned int _n)
+{
+#if LIQUID_SIMD_AVX512F || LIQUID_SIMD_AVX2
+    unsigned int features = liquid_cpu_features();
+#endif
+#if LIQUID_SIMD_AVX512F
+    if (_n >= 64 && (features & LIQUID_CPU_AVX512F))
+        return liquid_sumsqf_avx512f(_v, _n);
+#endif
+#if LIQUID_SIMD_AVX2
+    if (_n >= 16 && (features & LIQUID_CPU_AVX2) && (features & LIQUID_CPU_FMA))
+        return liquid_sumsqf_avx2(_v, _n);
+#endif
+    return liquid_sumsqf_sse(_v, _n);
+}
+
 // sum squares, basic loop
 //  _v      :   input array [size: 1 x _n]
 //  _n      :   input length
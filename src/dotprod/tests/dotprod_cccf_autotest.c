@@ -220,3 +220,101 @@ void autotest_dotprod_cccf_struct_vs_ordinal()
         runtest_dotprod_cccf(i);
 }
 
+
+// compare run-time selected wide-vector kernels to ordinal computation
+// over all lengths, including those where the structured object would
+// select a different kernel
+void autotest_dotprod_cccf_simd_kernels()
+{
+#if LIQUID_SIMD_AVX2 || LIQUID_SIMD_AVX512F
+    float tol = 1e-3;
+    float complex h[300];
+    float hi[600];  // repeated coefficients (real)
+    float hq[600];  // repeated coefficients (imag)
+    float complex x[300];
+    float complex y_test, y;
+
+    unsigned int i, n;
+    for (i=0; i<300; i++) {
+        h[i] = randnf() + randnf() * _Complex_I;
+        x[i] = randnf() + randnf() * _Complex_I;
+        hi[2*i+0] = hi[2*i+1] = crealf(h[i]);
+        hq[2*i+0] = hq[2*i+1] = cimagf(h[i]);
+    }
+
+    for (n=1; n<=300; n++) {
+        // compute expected value (ordinal computation)
+        dotprod_cccf_run(h, x, n, &y_test);
+
+#if LIQUID_SIMD_AVX2
+        if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA)) {
+            dotprod_cccf_run_avx2(hi, hq, x, n, &y);
+            CONTEND_DELTA(crealf(y), crealf(y_test), tol);
+            CONTEND_DELTA(cimagf(y), cimagf(y_test), tol);
+        }
+#endif
+#if LIQUID_SIMD_AVX512F
+        if (liquid_cpu_has(LIQUID_CPU_AVX512F)) {
+            dotprod_cccf_run_avx512f(hi, hq, x, n, &y);
+            CONTEND_DELTA(crealf(y), crealf(y_test), tol);
+            CONTEND_DELTA(cimagf(y), cimagf(y_test), tol);
+        }
+#endif
+    }
+#endif
+}
+
+// compare block execution (many outputs over sliding input) to
+// individual calls to execute() for many filter and block lengths
+void autotest_dotprod_cccf_execute_block()
+{
+    float tol = 1e-4;
+    float complex h[64];
+    float complex x[64+100];
+    float complex y[100], y_test;
+
+    unsigned int i, n, m;
+    for (i=0; i<64;     i++) h[i] = randnf() + randnf() * _Complex_I;
+    for (i=0; i<64+100; i++) x[i] = randnf() + randnf() * _Complex_I;
+
+    for (n=1; n<=64; n+=7) {
+        dotprod_cccf q = dotprod_cccf_create(h, n);
+        for (m=1; m<=100; m+=11) {
+            dotprod_cccf_execute_block(q, x, m, y);
+            for (i=0; i<m; i++) {
+                dotprod_cccf_execute(q, &x[i], &y_test);
+                CONTEND_DELTA(crealf(y[i]), crealf(y_test), tol);
+                CONTEND_DELTA(cimagf(y[i]), cimagf(y_test), tol);
+            }
+        }
+        dotprod_cccf_destroy(q);
+    }
+}
+
+// compare bank execution (many outputs over common input) to
+// dotprod_cccf_run() on each column for many bank sizes and lengths
+void autotest_dotprod_cccf_execute_bank()
+{
+    float tol = 1e-4;
+    float complex h[21*33], h_col[33];
+    float complex x[33];
+    float complex y[21], y_test;
+
+    unsigned int i, k, n, m;
+    for (i=0; i<21*33; i++) h[i] = randnf() + randnf() * _Complex_I;
+    for (i=0; i<33;    i++) x[i] = randnf() + randnf() * _Complex_I;
+
+    for (m=1; m<=21; m++) {
+        for (n=1; n<=33; n+=4) {
+            dotprod_cccf q = dotprod_cccf_create(h, n*m);
+            dotprod_cccf_execute_bank(q, x, m, y);
+            for (i=0; i<m; i++) {
+                for (k=0; k<n; k++) h_col[k] = h[k*m+i];
+                dotprod_cccf_run(h_col, x, n, &y_test);
+                CONTEND_DELTA(crealf(y[i]), crealf(y_test), tol);
+                CONTEND_DELTA(cimagf(y[i]), cimagf(y_test), tol);
+            }
+            dotprod_cccf_destroy(q);
+        }
+    }
+}
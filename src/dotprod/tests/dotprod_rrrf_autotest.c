@@ -370,3 +370,93 @@ void autotest_dotprod_rrrf_struct_vs_ordinal()
         runtest_dotprod_rrrf(i);
 }
 
+
+// compare run-time selected wide-vector kernels to ordinal computation
+// over all lengths, including those where the structured object would
+// select a different kernel
+void autotest_dotprod_rrrf_simd_kernels()
+{
+#if LIQUID_SIMD_AVX2 || LIQUID_SIMD_AVX512F
+    float tol = 1e-4;
+    float h[300];
+    float x[300];
+    float y_test, y;
+
+    unsigned int i, n;
+    for (i=0; i<300; i++) {
+        h[i] = randnf();
+        x[i] = randnf();
+    }
+
+    for (n=1; n<=300; n++) {
+        // compute expected value (ordinal computation)
+        dotprod_rrrf_run(h, x, n, &y_test);
+
+#if LIQUID_SIMD_AVX2
+        if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA)) {
+            dotprod_rrrf_run_avx2(h, x, n, &y);
+            CONTEND_DELTA(y, y_test, tol);
+        }
+#endif
+#if LIQUID_SIMD_AVX512F
+        if (liquid_cpu_has(LIQUID_CPU_AVX512F)) {
+            dotprod_rrrf_run_avx512f(h, x, n, &y);
+            CONTEND_DELTA(y, y_test, tol);
+        }
+#endif
+    }
+#endif
+}
+
+// compare block execution (many outputs over sliding input) to
+// individual calls to execute() for many filter and block lengths
+void autotest_dotprod_rrrf_execute_block()
+{
+    float tol = 1e-4;
+    float h[64];
+    float x[64+100];
+    float y[100], y_test;
+
+    unsigned int i, n, m;
+    for (i=0; i<64;     i++) h[i] = randnf();
+    for (i=0; i<64+100; i++) x[i] = randnf();
+
+    for (n=1; n<=64; n+=7) {
+        dotprod_rrrf q = dotprod_rrrf_create(h, n);
+        for (m=1; m<=100; m+=11) {
+            dotprod_rrrf_execute_block(q, x, m, y);
+            for (i=0; i<m; i++) {
+                dotprod_rrrf_execute(q, &x[i], &y_test);
+                CONTEND_DELTA(y[i], y_test, tol);
+            }
+        }
+        dotprod_rrrf_destroy(q);
+    }
+}
+
+// compare bank execution (many outputs over common input) to
+// dotprod_rrrf_run() on each column for many bank sizes and lengths
+void autotest_dotprod_rrrf_execute_bank()
+{
+    float tol = 1e-4;
+    float h[21*33], h_col[33];
+    float x[33];
+    float y[21], y_test;
+
+    unsigned int i, k, n, m;
+    for (i=0; i<21*33; i++) h[i] = randnf();
+    for (i=0; i<33;    i++) x[i] = randnf();
+
+    for (m=1; m<=21; m++) {
+        for (n=1; n<=33; n+=4) {
+            dotprod_rrrf q = dotprod_rrrf_create(h, n*m);
+            dotprod_rrrf_execute_bank(q, x, m, y);
+            for (i=0; i<m; i++) {
+                for (k=0; k<n; k++) h_col[k] = h[k*m+i];
+                dotprod_rrrf_run(h_col, x, n, &y_test);
+                CONTEND_DELTA(y[i], y_test, tol);
+            }
+            dotprod_rrrf_destroy(q);
+        }
+    }
+}
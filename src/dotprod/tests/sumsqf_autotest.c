@@ -54,6 +54,33 @@ void autotest_sumsqf_8()    {   sumsqf_runtest( sumsqf_test_x8,  8,  sumsqf_test
 void autotest_sumsqf_15()   {   sumsqf_runtest( sumsqf_test_x15, 15, sumsqf_test_y15 ); }
 void autotest_sumsqf_16()   {   sumsqf_runtest( sumsqf_test_x16, 16, sumsqf_test_y16 ); }
 
+// compare against ordinal computation for lengths which select the
+// run-time wide-vector kernels
+void autotest_sumsqf_lengths()
+{
+    float tol = 1e-4;
+    float x[300];
+    unsigned int i, n;
+    for (i=0; i<300; i++)
+        x[i] = randnf();
+
+    for (n=1; n<=300; n++) {
+        float y_test = 0.0f;
+        for (i=0; i<n; i++)
+            y_test += x[i]*x[i];
+
+        CONTEND_DELTA( liquid_sumsqf(x,n), y_test, tol*n );
+#if LIQUID_SIMD_AVX2
+        if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+            CONTEND_DELTA( liquid_sumsqf_avx2(x,n), y_test, tol*n );
+#endif
+#if LIQUID_SIMD_AVX512F
+        if (liquid_cpu_has(LIQUID_CPU_AVX512F))
+            CONTEND_DELTA( liquid_sumsqf_avx512f(x,n), y_test, tol*n );
+#endif
+    }
+}
+
 float sumsqf_test_x3[3] = {
   -0.4546496371984978f,
    0.4451201395218938f,
@@ -41,8 +41,8 @@ void crc_bench(struct rusage *_start,
                unsigned int _n)
 {
     // normalize number of iterations
-    if (_crc != LIQUID_CRC_CHECKSUM)
-        *_num_iterations /= 8;
+    *_num_iterations /= (_n / 64) + 1;
+    if (*_num_iterations < 1) *_num_iterations = 1;
 
     unsigned long int i;
 
@@ -63,7 +63,9 @@ void crc_bench(struct rusage *_start,
         key ^= crc_generate_key(_crc, msg, _n);
     }
     getrusage(RUSAGE_SELF, _finish);
-    *_num_iterations *= 4;
+
+    // report one trial per byte so that the rate is in bytes/second
+    *_num_iterations *= 4 * _n;
 }
 
 //
@@ -76,3 +78,11 @@ void benchmark_crc_crc16_n256       CRC_BENCH_API(LIQUID_CRC_16,        256)
 void benchmark_crc_crc24_n256       CRC_BENCH_API(LIQUID_CRC_24,        256)
 void benchmark_crc_crc32_n256       CRC_BENCH_API(LIQUID_CRC_32,        256)
 
+void benchmark_crc_crc8_n4096       CRC_BENCH_API(LIQUID_CRC_8,         4096)
+void benchmark_crc_crc16_n4096      CRC_BENCH_API(LIQUID_CRC_16,        4096)
+void benchmark_crc_crc24_n4096      CRC_BENCH_API(LIQUID_CRC_24,        4096)
+void benchmark_crc_crc32_n4096      CRC_BENCH_API(LIQUID_CRC_32,        4096)
+
+void benchmark_crc_crc32_n16        CRC_BENCH_API(LIQUID_CRC_32,        16)
+void benchmark_crc_crc32_n65536     CRC_BENCH_API(LIQUID_CRC_32,        65536)
+
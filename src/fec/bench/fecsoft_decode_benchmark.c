@@ -48,32 +48,6 @@ void fecsoft_decode_bench(
     unsigned int _n,
     void * _opts)
 {
-#if !LIBFEC_ENABLED
-    if ( _fs == LIQUID_FEC_CONV_V27    ||
-         _fs == LIQUID_FEC_CONV_V29    ||
-         _fs == LIQUID_FEC_CONV_V39    ||
-         _fs == LIQUID_FEC_CONV_V615   ||
-         _fs == LIQUID_FEC_CONV_V27P23 ||
-         _fs == LIQUID_FEC_CONV_V27P34 ||
-         _fs == LIQUID_FEC_CONV_V27P45 ||
-         _fs == LIQUID_FEC_CONV_V27P56 ||
-         _fs == LIQUID_FEC_CONV_V27P67 ||
-         _fs == LIQUID_FEC_CONV_V27P78 ||
-         _fs == LIQUID_FEC_CONV_V29P23 ||
-         _fs == LIQUID_FEC_CONV_V29P34 ||
-         _fs == LIQUID_FEC_CONV_V29P45 ||
-         _fs == LIQUID_FEC_CONV_V29P56 ||
-         _fs == LIQUID_FEC_CONV_V29P67 ||
-         _fs == LIQUID_FEC_CONV_V29P78 ||
-         _fs == LIQUID_FEC_RS_M8)
-    {
-        fprintf(stderr,"warning: convolutional, Reed-Solomon codes unavailable (install libfec)\n");
-        getrusage(RUSAGE_SELF, _start);
-        memmove((void*)_finish,(void*)_start,sizeof(struct rusage));
-        return;
-    }
-#endif
-
     // normalize number of iterations
     *_num_iterations /= _n;
 
@@ -84,6 +58,10 @@ void fecsoft_decode_bench(
     case LIQUID_FEC_HAMMING74:     *_num_iterations *= 1;   break;
     case LIQUID_FEC_HAMMING84:     *_num_iterations *= 1;   break;
     case LIQUID_FEC_HAMMING128:    *_num_iterations *= 1;   break;
+    case LIQUID_FEC_GOLAY2412:     *_num_iterations *= 1;   break;
+    case LIQUID_FEC_SECDED2216:    *_num_iterations *= 1;   break;
+    case LIQUID_FEC_SECDED3932:    *_num_iterations *= 1;   break;
+    case LIQUID_FEC_SECDED7264:    *_num_iterations *= 1;   break;
     case LIQUID_FEC_CONV_V27:      *_num_iterations /= 5;   break;
     case LIQUID_FEC_CONV_V29:      *_num_iterations /= 50;  break;
     case LIQUID_FEC_CONV_V39:      *_num_iterations /= 50;  break;
@@ -166,6 +144,10 @@ void benchmark_fecsoft_dec_rep5_n64       FECSOFT_DECODE_BENCH_API(LIQUID_FEC_RE
 void benchmark_fecsoft_dec_hamming74_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_HAMMING74, 64,  NULL)
 void benchmark_fecsoft_dec_hamming84_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_HAMMING84, 64,  NULL)
 void benchmark_fecsoft_dec_hamming128_n64 FECSOFT_DECODE_BENCH_API(LIQUID_FEC_HAMMING128,64,  NULL)
+void benchmark_fecsoft_dec_golay2412_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_GOLAY2412, 64,  NULL)
+void benchmark_fecsoft_dec_secded2216_n64 FECSOFT_DECODE_BENCH_API(LIQUID_FEC_SECDED2216,64,  NULL)
+void benchmark_fecsoft_dec_secded3932_n64 FECSOFT_DECODE_BENCH_API(LIQUID_FEC_SECDED3932,64,  NULL)
+void benchmark_fecsoft_dec_secded7264_n64 FECSOFT_DECODE_BENCH_API(LIQUID_FEC_SECDED7264,64,  NULL)
 
 void benchmark_fecsoft_dec_conv27_n64     FECSOFT_DECODE_BENCH_API(LIQUID_FEC_CONV_V27,  64,  NULL)
 void benchmark_fecsoft_dec_conv29_n64     FECSOFT_DECODE_BENCH_API(LIQUID_FEC_CONV_V29,  64,  NULL)
@@ -188,3 +170,6 @@ void benchmark_fecsoft_dec_conv29p78_n64  FECSOFT_DECODE_BENCH_API(LIQUID_FEC_CO
 
 void benchmark_fecsoft_dec_rs8_n64        FECSOFT_DECODE_BENCH_API(LIQUID_FEC_RS_M8,      64, NULL)
 
+void benchmark_fecsoft_dec_ldpc648_n64    FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_N648,  64, NULL)
+void benchmark_fecsoft_dec_ldpc1944_n64   FECSOFT_DECODE_BENCH_API(LIQUID_FEC_LDPC_N1944, 64, NULL)
+
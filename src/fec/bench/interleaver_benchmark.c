@@ -29,13 +29,20 @@
 (   struct rusage *_start,              \
     struct rusage *_finish,             \
     unsigned long int *_num_iterations) \
-{ interleaver_bench(_start, _finish, _num_iterations, N); }
+{ interleaver_bench(_start, _finish, _num_iterations, N, 0); }
+
+#define INTERLEAVER_SOFT_BENCH_API(N)   \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ interleaver_bench(_start, _finish, _num_iterations, N, 1); }
 
 // Helper function to keep code base small
 void interleaver_bench(struct rusage *_start,
                        struct rusage *_finish,
                        unsigned long int *_num_iterations,
-                       unsigned int _n)
+                       unsigned int _n,
+                       int _soft)
 {
     // scale number of iterations by block size
     // iterations = 4: cycles/trial ~ exp( -0.883 + 0.708*log(_n) )
@@ -45,20 +52,29 @@ void interleaver_bench(struct rusage *_start,
     interleaver q = interleaver_create(_n);
     interleaver_set_depth(q, 4);
 
-    unsigned char x[_n];
-    unsigned char y[_n];
+    unsigned char x[8*_n];
+    unsigned char y[8*_n];
     
     unsigned long int i;
-    for (i=0; i<_n; i++)
+    for (i=0; i<8*_n; i++)
         x[i] = rand() & 0xff;
 
     // start trials
     getrusage(RUSAGE_SELF, _start);
-    for (i=0; i<(*_num_iterations); i++) {
-        interleaver_encode(q, x, y);
-        interleaver_encode(q, x, y);
-        interleaver_encode(q, x, y);
-        interleaver_encode(q, x, y);
+    if (_soft) {
+        for (i=0; i<(*_num_iterations); i++) {
+            interleaver_encode_soft(q, x, y);
+            interleaver_encode_soft(q, x, y);
+            interleaver_encode_soft(q, x, y);
+            interleaver_encode_soft(q, x, y);
+        }
+    } else {
+        for (i=0; i<(*_num_iterations); i++) {
+            interleaver_encode(q, x, y);
+            interleaver_encode(q, x, y);
+            interleaver_encode(q, x, y);
+            interleaver_encode(q, x, y);
+        }
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
@@ -76,3 +92,6 @@ void benchmark_interleaver_256  INTERLEAVER_BENCH_API(256   )
 void benchmark_interleaver_512  INTERLEAVER_BENCH_API(512   )
 void benchmark_interleaver_1024 INTERLEAVER_BENCH_API(1024  )
 
+void benchmark_interleaver_soft_64   INTERLEAVER_SOFT_BENCH_API(64    )
+void benchmark_interleaver_soft_256  INTERLEAVER_SOFT_BENCH_API(256   )
+void benchmark_interleaver_soft_1024 INTERLEAVER_SOFT_BENCH_API(1024  )
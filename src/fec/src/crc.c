@@ -27,6 +27,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "liquid.internal.h"
 
@@ -237,31 +238,214 @@ unsigned int checksum_generate_key(unsigned char *_data,
 }
 
 
+//
+// table-driven engine
+//
+
+// Each of the cyclic redundancy checks below is a reflected crc over a
+// 32-bit register initialized to all ones.  For widths w below 32 bits the
+// register carries the polynomial x^(32-w) P(x), so a single engine serves
+// every width and the key is simply masked on output.
+struct crc_engine_s {
+    uint32_t table[8][256];     // slicing-by-8 tables
+    uint64_t fold[4];           // carry-less multiply folding constants
+};
+
+// engines for crc8, crc16, crc24, and crc32
+static struct crc_engine_s crc_engine[4];
+static int crc_engine_ready = 0;
+
+// minimum message length (bytes) for the folding kernel
+#define CRC_FOLD_MIN_LEN (128)
+
+// build tables and folding constants for reflected polynomial _poly
+static void crc_engine_init_poly(struct crc_engine_s * _e,
+                                 uint32_t              _poly)
+{
+    unsigned int i, j;
+
+    // table[0] advances the register by one byte, table[j] by one byte
+    // followed by j zero bytes
+    for (i=0; i<256; i++) {
+        uint32_t key = i;
+        for (j=0; j<8; j++)
+            key = (key >> 1) ^ (_poly & -(key & 1));
+        _e->table[0][i] = key;
+    }
+    for (j=1; j<8; j++) {
+        for (i=0; i<256; i++) {
+            uint32_t key = _e->table[j-1][i];
+            _e->table[j][i] = (key >> 8) ^ _e->table[0][key & 0xff];
+        }
+    }
+
+    // folding constants x^k mod Q(x) for k = 575, 511 (64 bytes) and
+    // k = 191, 127 (16 bytes), stored bit-reflected in 64 bits; the
+    // exponents are one less than the fold distance to absorb the shift
+    // inherent to reflected carry-less multiplication
+    uint64_t q = ((uint64_t)1 << 32) | liquid_reverse_uint32(_poly);
+    unsigned int k[4] = {575, 511, 191, 127};
+    for (i=0; i<4; i++) {
+        uint64_t r = 1;
+        for (j=0; j<k[i]; j++) {
+            r <<= 1;
+            if (r >> 32)
+                r ^= q;
+        }
+        _e->fold[i] = 0;
+        for (j=0; j<32; j++)
+            _e->fold[i] |= ((r >> j) & 1) << (63-j);
+    }
+}
+
+// build all engines once, when the library is loaded
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void crc_engine_init(void)
+{
+    crc_engine_init_poly(&crc_engine[0], liquid_reverse_byte_gentab[CRC8_POLY]);
+    crc_engine_init_poly(&crc_engine[1], liquid_reverse_uint16(CRC16_POLY));
+    crc_engine_init_poly(&crc_engine[2], liquid_reverse_uint24(CRC24_POLY));
+    crc_engine_init_poly(&crc_engine[3], liquid_reverse_uint32(CRC32_POLY));
+    crc_engine_ready = 1;
+}
+
+// advance register _key over _n bytes of _msg, eight bytes at a time
+static uint32_t crc_engine_update(const struct crc_engine_s * _e,
+                                  uint32_t                    _key,
+                                  const unsigned char *       _msg,
+                                  unsigned int                _n)
+{
+    const uint32_t (*t)[256] = _e->table;
+    while (_n >= 8) {
+        uint32_t a = _key ^ ( (uint32_t)_msg[0]        | ((uint32_t)_msg[1] <<  8) |
+                             ((uint32_t)_msg[2] << 16) | ((uint32_t)_msg[3] << 24) );
+        _key = t[7][ a        & 0xff] ^ t[6][(a >>  8) & 0xff] ^
+               t[5][(a >> 16) & 0xff] ^ t[4][ a >> 24        ] ^
+               t[3][_msg[4]] ^ t[2][_msg[5]] ^ t[1][_msg[6]] ^ t[0][_msg[7]];
+        _msg += 8;
+        _n   -= 8;
+    }
+    while (_n--)
+        _key = (_key >> 8) ^ t[0][(_key ^ *_msg++) & 0xff];
+    return _key;
+}
+
+// advance register _key over _n bytes of _src while copying them to _dst;
+// _dst may be equal to _src but must not otherwise overlap it
+static uint32_t crc_engine_update_copy(const struct crc_engine_s * _e,
+                                       uint32_t                    _key,
+                                       const unsigned char *       _src,
+                                       unsigned int                _n,
+                                       unsigned char *             _dst)
+{
+    const uint32_t (*t)[256] = _e->table;
+    while (_n >= 8) {
+        uint64_t w;
+        memcpy(&w, _src, 8);
+        memcpy(_dst, &w, 8);
+        uint32_t a = _key ^ ( (uint32_t)_src[0]        | ((uint32_t)_src[1] <<  8) |
+                             ((uint32_t)_src[2] << 16) | ((uint32_t)_src[3] << 24) );
+        _key = t[7][ a        & 0xff] ^ t[6][(a >>  8) & 0xff] ^
+               t[5][(a >> 16) & 0xff] ^ t[4][ a >> 24        ] ^
+               t[3][_src[4]] ^ t[2][_src[5]] ^ t[1][_src[6]] ^ t[0][_src[7]];
+        _src += 8;
+        _dst += 8;
+        _n   -= 8;
+    }
+    while (_n--) {
+        *_dst++ = *_src;
+        _key = (_key >> 8) ^ t[0][(_key ^ *_src++) & 0xff];
+    }
+    return _key;
+}
+
+// generate (unmasked) key using engine _index
+static uint32_t crc_engine_generate_key(unsigned int    _index,
+                                        unsigned char * _msg,
+                                        unsigned int    _n)
+{
+    if (!crc_engine_ready)
+        crc_engine_init();
+    const struct crc_engine_s * e = &crc_engine[_index];
+
+    uint32_t key = ~0;
+#if LIQUID_SIMD_PCLMUL
+    // fold long messages down to 16 bytes with carry-less multiplies
+    if (_n >= CRC_FOLD_MIN_LEN && liquid_cpu_has(LIQUID_CPU_PCLMUL)) {
+        unsigned int  n = _n & ~15u;
+        unsigned char r[16];
+        crc_fold_pclmul(e->fold, key, _msg, n, r);
+        key   = crc_engine_update(e, 0, r, 16);
+        _msg += n;
+        _n   -= n;
+    }
+#endif
+    return ~crc_engine_update(e, key, _msg, _n);
+}
+
+// copy message to _dst while generating its error-detection key, and
+// append the key to the end of the copy (as crc_append_key)
+//  _scheme     :   error-detection scheme (resulting in 'p' bytes)
+//  _src        :   input data message, [size: _n x 1]
+//  _n          :   input data message size
+//  _dst        :   output message, [size: _n+p x 1]; may equal _src
+void crc_copy_append_key(crc_scheme            _scheme,
+                         const unsigned char * _src,
+                         unsigned int          _n,
+                         unsigned char *       _dst)
+{
+    unsigned int len = crc_sizeof_key(_scheme);
+    unsigned int key = 0;
+    unsigned int i;
+
+    switch (_scheme) {
+    case LIQUID_CRC_NONE:
+        memmove(_dst, _src, _n);
+        return;
+    case LIQUID_CRC_CHECKSUM:
+        for (i=0; i<_n; i++) {
+            _dst[i] = _src[i];
+            key    += _src[i];
+        }
+        key = (unsigned char)(~(key & 0xff) + 1);
+        break;
+    default:
+#if LIQUID_SIMD_PCLMUL
+        // long messages are folded with carry-less multiplies, which
+        // outpaces the table engine even with the extra pass over the data
+        if (_n >= CRC_FOLD_MIN_LEN && liquid_cpu_has(LIQUID_CPU_PCLMUL)) {
+            memmove(_dst, _src, _n);
+            key = crc_generate_key(_scheme, _dst, _n);
+            break;
+        }
+#endif
+        if (!crc_engine_ready)
+            crc_engine_init();
+        key = ~crc_engine_update_copy(&crc_engine[len-1], ~0, _src, _n, _dst);
+        if (len < 4)
+            key &= (1u << (8*len)) - 1;
+    }
+
+    // append key to end of message
+    for (i=0; i<len; i++)
+        _dst[_n+i] = (key >> (len - i - 1)*8) & 0xff;
+}
+
+
 // 
 // CRC-8
 //
 
 // generate 8-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
-//
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc8_generate_key(unsigned char *_msg,
                                unsigned int _n)
 {
-    unsigned int i, j, b, mask, key8=~0;
-    unsigned int poly = liquid_reverse_byte_gentab[CRC8_POLY];
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key8 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key8 & 1);
-            key8 = (key8>>1) ^ (poly & mask);
-        }
-    }
-    return (~key8) & 0xff;
+    return crc_engine_generate_key(0, _msg, _n) & 0xff;
 }
 
 
@@ -271,25 +455,12 @@ unsigned int crc8_generate_key(unsigned char *_msg,
 
 // generate 16-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
-//
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc16_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key16=~0;
-    unsigned int poly = liquid_reverse_uint16(CRC16_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key16 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key16 & 1);
-            key16 = (key16>>1) ^ (poly & mask);
-        }
-    }
-    return (~key16) & 0xffff;
+    return crc_engine_generate_key(1, _msg, _n) & 0xffff;
 }
 
 
@@ -299,25 +470,12 @@ unsigned int crc16_generate_key(unsigned char *_msg,
 
 // generate 24-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
-//
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc24_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key24=~0;
-    unsigned int poly = liquid_reverse_uint24(CRC24_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key24 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key24 & 1);
-            key24 = (key24>>1) ^ (poly & mask);
-        }
-    }
-    return (~key24) & 0xffffff;
+    return crc_engine_generate_key(2, _msg, _n) & 0xffffff;
 }
 
 
@@ -327,25 +485,12 @@ unsigned int crc24_generate_key(unsigned char *_msg,
 
 // generate 32-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
-//
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc32_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key32=~0;
-    unsigned int poly = liquid_reverse_uint32(CRC32_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key32 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key32 & 1);
-            key32 = (key32>>1) ^ (poly & mask);
-        }
-    }
-    return (~key32) & 0xffffffff;
+    return crc_engine_generate_key(3, _msg, _n) & 0xffffffff;
 }
 
 #if 0
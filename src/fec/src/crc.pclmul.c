@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// cyclic redundancy check folding (PCLMULQDQ)
+//
+
+#include <stdint.h>
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#include "liquid.internal.h"
+
+// advance 128-bit residue _a by the distance encoded in _k and add _d
+static inline __m128i crc_fold_pclmul_step(__m128i _a,
+                                           __m128i _k,
+                                           __m128i _d)
+{
+    __m128i lo = _mm_clmulepi64_si128(_a, _k, 0x00);
+    __m128i hi = _mm_clmulepi64_si128(_a, _k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(lo, hi), _d);
+}
+
+void crc_fold_pclmul(const uint64_t *      _k,
+                     uint32_t              _key,
+                     const unsigned char * _msg,
+                     unsigned int          _n,
+                     unsigned char *       _r)
+{
+    // the low quad word holds the higher-order coefficients
+    __m128i k64 = _mm_set_epi64x((long long)_k[1], (long long)_k[0]);
+    __m128i k16 = _mm_set_epi64x((long long)_k[3], (long long)_k[2]);
+
+    // four independent residues hide the multiply latency
+    const __m128i * m = (const __m128i*) _msg;
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(m+0), _mm_cvtsi32_si128((int)_key));
+    __m128i x1 = _mm_loadu_si128(m+1);
+    __m128i x2 = _mm_loadu_si128(m+2);
+    __m128i x3 = _mm_loadu_si128(m+3);
+    m  += 4;
+    _n -= 64;
+    while (_n >= 64) {
+        x0 = crc_fold_pclmul_step(x0, k64, _mm_loadu_si128(m+0));
+        x1 = crc_fold_pclmul_step(x1, k64, _mm_loadu_si128(m+1));
+        x2 = crc_fold_pclmul_step(x2, k64, _mm_loadu_si128(m+2));
+        x3 = crc_fold_pclmul_step(x3, k64, _mm_loadu_si128(m+3));
+        m  += 4;
+        _n -= 64;
+    }
+
+    // combine residues and fold remaining 16-byte blocks
+    x0 = crc_fold_pclmul_step(x0, k16, x1);
+    x0 = crc_fold_pclmul_step(x0, k16, x2);
+    x0 = crc_fold_pclmul_step(x0, k16, x3);
+    while (_n >= 16) {
+        x0 = crc_fold_pclmul_step(x0, k16, _mm_loadu_si128(m));
+        m  += 1;
+        _n -= 16;
+    }
+    _mm_storeu_si128((__m128i*)_r, x0);
+}
@@ -27,9 +27,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "liquid.internal.h"
 
+#if defined(__SSE4_1__)
+#include <smmintrin.h>  // SSE4.1
+#endif
+
 // object-independent methods
 
 const char * fec_scheme_str[LIQUID_FEC_NUM_SCHEMES][2] = {
@@ -61,7 +66,10 @@ const char * fec_scheme_str[LIQUID_FEC_NUM_SCHEMES][2] = {
     {"v29p56",      "convolutional r5/6 K=9 (punctured)"},
     {"v29p67",      "convolutional r6/7 K=9 (punctured)"},
     {"v29p78",      "convolutional r7/8 K=9 (punctured)"},
-    {"rs8",         "Reed-Solomon, 223/255"}
+    {"rs8",         "Reed-Solomon, 223/255"},
+    {"ldpc648",     "LDPC r1/2 n=648"},
+    {"ldpc1296",    "LDPC r1/2 n=1296"},
+    {"ldpc1944",    "LDPC r1/2 n=1944"}
 };
 
 // Print compact list of existing and available fec schemes
@@ -73,10 +81,6 @@ void liquid_print_fec_schemes()
     // print all available MOD schemes
     printf("          ");
     for (i=0; i<LIQUID_FEC_NUM_SCHEMES; i++) {
-#if !LIBFEC_ENABLED
-        if ( fec_scheme_is_convolutional(i) || fec_scheme_is_reedsolomon(i) )
-            continue;
-#endif
         printf("%s", fec_scheme_str[i][0]);
 
         if (i != LIQUID_FEC_NUM_SCHEMES-1)
@@ -220,7 +224,6 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
     case LIQUID_FEC_SECDED3932:     return _msg_len + _msg_len/4 + ((_msg_len%4) ? 1 : 0);
     case LIQUID_FEC_SECDED7264:     return _msg_len + _msg_len/8 + ((_msg_len%8) ? 1 : 0);
 
-#if LIBFEC_ENABLED
     // convolutional codes
     case LIQUID_FEC_CONV_V27:       return 2*_msg_len + 2;  // (K-1)/r=12, round up to 2 bytes
     case LIQUID_FEC_CONV_V29:       return 2*_msg_len + 2;  // (K-1)/r=16, 2 bytes
@@ -242,32 +245,11 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
 
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:          return fec_rs_get_enc_msg_len(_msg_len,32,255,223);
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
-
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr, "error: fec_get_enc_msg_length(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
 
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr, "error: fec_get_enc_msg_length(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+    // LDPC codes
+    case LIQUID_FEC_LDPC_N648:      return fec_ldpc_get_enc_msg_len(_msg_len, 648, 324);
+    case LIQUID_FEC_LDPC_N1296:     return fec_ldpc_get_enc_msg_len(_msg_len,1296, 648);
+    case LIQUID_FEC_LDPC_N1944:     return fec_ldpc_get_enc_msg_len(_msg_len,1944, 972);
     default:
         printf("error: fec_get_enc_msg_length(), unknown/unsupported scheme: %d\n", _scheme);
         exit(-1);
@@ -317,6 +299,309 @@ unsigned int fec_block_get_enc_msg_len(unsigned int _dec_msg_len,
     return num_bytes_out;
 }
 
+// pack hard decisions of soft bits into bytes
+//  _soft_bits  :   soft bits [size: 8*_n x 1]
+//  _n          :   number of output bytes
+//  _hard       :   hard decisions [size: _n x 1]
+void fecsoft_hard_decision(unsigned char * _soft_bits,
+                           unsigned int    _n,
+                           unsigned char * _hard)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        // gather the sign bits of eight soft bits with a single multiply,
+        // first soft bit into the most significant bit
+        uint64_t x;
+        memcpy(&x, &_soft_bits[8*i], 8);
+        x = (x >> 7) & 0x0101010101010101ULL;
+        _hard[i] = (x * 0x8040201008040201ULL) >> 56;
+#else
+        unsigned int k;
+        _hard[i] = 0;
+        for (k=0; k<8; k++)
+            _hard[i] |= (_soft_bits[8*i+k] >> 7) << (7-k);
+#endif
+    }
+}
+
+// find least reliable soft bits for Chase decoding, sorted by
+// increasing reliability
+//  _soft_bits  :   soft bits [size: _n x 1]
+//  _n          :   number of soft bits
+//  _p          :   number of positions to find, _p <= _n
+//  _index      :   output positions [size: _p x 1]
+void fecsoft_chase_find_positions(unsigned char * _soft_bits,
+                                  unsigned int    _n,
+                                  unsigned int    _p,
+                                  unsigned int *  _index)
+{
+    unsigned int rel[_p];   // reliabilities of retained positions
+    unsigned int i, k;
+    for (i=0; i<_p; i++)
+        rel[i] = 0x100;
+
+    // insertion into a short sorted list
+    for (i=0; i<_n; i++) {
+        unsigned int r = FECSOFT_RELIABILITY(_soft_bits[i]);
+        if (r >= rel[_p-1])
+            continue;
+        for (k=_p-1; k>0 && rel[k-1] > r; k--) {
+            rel[k]    = rel[k-1];
+            _index[k] = _index[k-1];
+        }
+        rel[k]    = r;
+        _index[k] = i;
+    }
+}
+
+// soft decoding of one SEC-DED symbol (Chase-II): combinations of the
+// least reliable bits are flipped and each test vector with at most a
+// single error syndrome yields a candidate codeword; the candidate with
+// the smallest soft distance (total reliability of bits differing from
+// the hard decision) is kept
+//  _soft_bits  :   soft bits of encoded symbol [size: 8*(_msg_len+1) x 1]
+//  _n          :   number of codeword bits
+//  _offset     :   position of first codeword bit (leading bits unused)
+//  _msg_len    :   number of message bytes, following the parity byte
+//  _p          :   number of least reliable positions to test
+//  _syndrome   :   syndrome of hard-decision symbol
+//  _locate     :   errors detected for syndrome (0/1/2), and position of
+//                  erroneous bit for a single error
+//  _sym_dec    :   decoded symbol [size: _msg_len x 1]
+void fecsoft_chase_decode(unsigned char *             _soft_bits,
+                          unsigned int                _n,
+                          unsigned int                _offset,
+                          unsigned int                _msg_len,
+                          unsigned int                _p,
+                          fecsoft_chase_syndrome_func _syndrome,
+                          fecsoft_chase_locate_func   _locate,
+                          unsigned char *             _sym_dec)
+{
+    // hard decisions
+    unsigned char v[_msg_len+1];
+    unsigned int i, n;
+    fecsoft_hard_decision(_soft_bits, _msg_len+1, v);
+
+    // received vector is a codeword: no other codeword can be closer
+    unsigned char s = _syndrome(v);
+    if (s == 0) {
+        memmove(_sym_dec, &v[1], _msg_len);
+        return;
+    }
+
+    // find least reliable positions (skipping unused bits), their
+    // syndromes and reliabilities
+    unsigned int  p = _p;
+    unsigned int  index[p];
+    unsigned char syn[p];
+    unsigned int  rel[p];
+    unsigned char u[_msg_len+1];
+    memset(u, 0x00, _msg_len+1);
+    fecsoft_chase_find_positions(&_soft_bits[_offset], _n, p, index);
+    for (i=0; i<p; i++) {
+        index[i] += _offset;
+        u[index[i]/8] = 0x80 >> (index[i] % 8);
+        syn[i] = _syndrome(u);
+        u[index[i]/8] = 0x00;
+        rel[i] = FECSOFT_RELIABILITY(_soft_bits[index[i]]);
+    }
+
+    // test all combinations of flipping the least reliable bits
+    unsigned int t;
+    unsigned int d_min  = 0;
+    int          t_best = -1;   // best test pattern
+    unsigned int e_best = 0;    // corrected position of best candidate, plus one
+    for (t=0; t<(1U<<p); t++) {
+        unsigned char st = s;
+        unsigned int  d  = 0;
+        for (n=0; n<p; n++) {
+            if ((t >> n) & 1) {
+                st ^= syn[n];
+                d  += rel[n];
+            }
+        }
+
+        // skip test vectors with multiple errors detected
+        unsigned int q;
+        int num_errors = _locate(st, &q);
+        if (num_errors == 2)
+            continue;
+
+        // single error: correction either restores a flipped bit or
+        // flips another one
+        unsigned int e = 0;
+        if (num_errors == 1) {
+            int flipped = 0;
+            for (n=0; n<p; n++)
+                flipped |= ((t >> n) & 1) && index[n] == q;
+            unsigned int r = FECSOFT_RELIABILITY(_soft_bits[q]);
+            d = flipped ? d - r : d + r;
+            e = q + 1;
+        }
+
+        if (t_best < 0 || d < d_min) {
+            d_min  = d;
+            t_best = t;
+            e_best = e;
+        }
+    }
+
+    // apply best candidate (hard decision if none found)
+    if (t_best >= 0) {
+        for (n=0; n<p; n++) {
+            if ((t_best >> n) & 1)
+                v[index[n]/8] ^= 0x80 >> (index[n] % 8);
+        }
+        if (e_best)
+            v[(e_best-1)/8] ^= 0x80 >> ((e_best-1) % 8);
+    }
+    memmove(_sym_dec, &v[1], _msg_len);
+}
+
+// expand codeword into byte mask for fecsoft_nearest(): byte k is 0xff
+// if bit k of the codeword (most-significant bit first) is set
+//  _c      :   codeword
+//  _n      :   codeword length (bits), _n <= 16
+//  _mask   :   output mask [size: 16 x 1]
+void fecsoft_codeword_mask(unsigned int    _c,
+                           unsigned int    _n,
+                           unsigned char * _mask)
+{
+    unsigned int k;
+    for (k=0; k<16; k++)
+        _mask[k] = (k < _n && ((_c >> (_n-k-1)) & 1)) ? 0xff : 0x00;
+}
+
+// find codeword nearest to soft bits by exhaustive search over a list
+// of candidates, returning its position in the list (first on ties).
+// The distance to codeword c is sum_k (c_k ? 255 - b_k : b_k), i.e. the
+// sum of the soft bits xor-ed with the codeword's byte mask.
+//  _soft_bits  :   soft bits [size: _n x 1]
+//  _n          :   codeword length (bits), _n <= 16
+//  _masks      :   byte masks of all codewords [size: 16*M x 1]
+//  _index      :   codeword of each candidate, or NULL for 0,1,...
+//  _num        :   number of candidates
+unsigned int fecsoft_nearest(const unsigned char * _soft_bits,
+                             unsigned int          _n,
+                             const unsigned char * _masks,
+                             const unsigned char * _index,
+                             unsigned int          _num)
+{
+    unsigned int i;
+    unsigned int i_min = 0;
+    unsigned int d_min = 0xffff;
+#if defined(__SSE4_1__)
+    unsigned char b[16] = {0};
+    memcpy(b, _soft_bits, _n);
+    __m128i x    = _mm_loadu_si128((const __m128i*)b);
+    __m128i zero = _mm_setzero_si128();
+    __m128i ones = _mm_set1_epi16(1);
+
+    // eight candidates at a time, padding the last group with copies of
+    // the final candidate (which can never win a tie against it)
+    for (i=0; i<_num; i+=8) {
+        __m128i h[4];
+        unsigned int j;
+        for (j=0; j<8; j+=2) {
+            unsigned int c0 = (i+j   < _num) ? i+j   : _num-1;
+            unsigned int c1 = (i+j+1 < _num) ? i+j+1 : _num-1;
+            if (_index != NULL) {
+                c0 = _index[c0];
+                c1 = _index[c1];
+            }
+            // partial sums over each half of the mask: [lo, hi] per candidate
+            __m128i r0 = _mm_sad_epu8(_mm_xor_si128(x, _mm_loadu_si128((const __m128i*)&_masks[16*c0])), zero);
+            __m128i r1 = _mm_sad_epu8(_mm_xor_si128(x, _mm_loadu_si128((const __m128i*)&_masks[16*c1])), zero);
+            h[j/2] = _mm_madd_epi16(_mm_packs_epi32(r0, r1), ones);
+        }
+        // add halves and narrow to eight 16-bit distances
+        __m128i d = _mm_packs_epi32(_mm_hadd_epi32(h[0], h[1]),
+                                    _mm_hadd_epi32(h[2], h[3]));
+
+        // minimum and its (first) position
+        unsigned int m = _mm_cvtsi128_si32(_mm_minpos_epu16(d));
+        if ((m & 0xffff) < d_min) {
+            d_min = m & 0xffff;
+            i_min = i + (m >> 16);
+        }
+    }
+#else
+    for (i=0; i<_num; i++) {
+        const unsigned char * mask = &_masks[16*(_index ? _index[i] : i)];
+        unsigned int k, d=0;
+        for (k=0; k<_n; k++)
+            d += _soft_bits[k] ^ mask[k];
+        if (d < d_min) {
+            d_min = d;
+            i_min = i;
+        }
+    }
+#endif
+    return i_min;
+}
+
+// find nearest codeword for each of a sequence of received symbols,
+// equivalent to calling fecsoft_nearest() once per symbol
+//  _soft_bits  :   soft bits of all symbols [size: _n*_num_sym x 1]
+//  _n          :   codeword length (bits), _n <= 16
+//  _num_sym    :   number of received symbols
+//  _masks      :   byte masks of all codewords [size: 16*M x 1]
+//  _index      :   codeword of each candidate, or NULL for 0,1,...
+//  _num        :   number of candidates
+//  _sym        :   candidate position for each symbol [size: _num_sym x 1]
+void fecsoft_nearest_block(const unsigned char * _soft_bits,
+                           unsigned int          _n,
+                           unsigned int          _num_sym,
+                           const unsigned char * _masks,
+                           const unsigned char * _index,
+                           unsigned int          _num,
+                           unsigned char *       _sym)
+{
+    unsigned int i = 0;
+#if defined(__SSE4_1__)
+    // codewords of at most eight bits with sixteen candidates (Hamming(7,4)
+    // and Hamming(8,4)): two candidates share a register and all masks stay
+    // in registers across symbols
+    if (_n <= 8 && _num == 16 && _index == NULL) {
+        __m128i m[8];
+        unsigned int j;
+        for (j=0; j<8; j++) {
+            m[j] = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)&_masks[16*(2*j  )]),
+                                      _mm_loadl_epi64((const __m128i*)&_masks[16*(2*j+1)]));
+        }
+        __m128i zero = _mm_setzero_si128();
+
+        // each symbol is read as eight bytes; bytes beyond the codeword
+        // meet zero mask bytes and add the same amount to every distance,
+        // but the last symbol must not read past the end of the input
+        unsigned int num_fast = (_n == 8 || _num_sym == 0) ? _num_sym : _num_sym - 1;
+        for (i=0; i<num_fast; i++) {
+            __m128i x = _mm_loadl_epi64((const __m128i*)&_soft_bits[i*_n]);
+            x = _mm_unpacklo_epi64(x, x);
+
+            // distances [d(2j), d(2j+1)] in the low 16 bits of each half
+            __m128i r[8];
+            for (j=0; j<8; j++)
+                r[j] = _mm_sad_epu8(_mm_xor_si128(x, m[j]), zero);
+
+            // narrow to sixteen 16-bit distances
+            __m128i d0 = _mm_packs_epi32(_mm_packs_epi32(r[0], r[1]),
+                                         _mm_packs_epi32(r[2], r[3]));
+            __m128i d1 = _mm_packs_epi32(_mm_packs_epi32(r[4], r[5]),
+                                         _mm_packs_epi32(r[6], r[7]));
+
+            // minimum and its (first) position
+            unsigned int m0 = _mm_cvtsi128_si32(_mm_minpos_epu16(d0));
+            unsigned int m1 = _mm_cvtsi128_si32(_mm_minpos_epu16(d1));
+            _sym[i] = ((m1 & 0xffff) < (m0 & 0xffff)) ? 8 + (m1 >> 16) : (m0 >> 16);
+        }
+    }
+#endif
+    for ( ; i<_num_sym; i++)
+        _sym[i] = fecsoft_nearest(&_soft_bits[i*_n], _n, _masks, _index, _num);
+}
+
 // compute encoded message length for convolutional codes
 //  _dec_msg_len    :   decoded message length
 //  _K              :   constraint length
@@ -415,7 +700,6 @@ float fec_get_rate(fec_scheme _scheme)
     case LIQUID_FEC_SECDED7264:     return 8./9.;
 
     // convolutional codes
-#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:       return 1./2.;
     case LIQUID_FEC_CONV_V29:       return 1./2.;
     case LIQUID_FEC_CONV_V39:       return 1./3.;
@@ -435,32 +719,11 @@ float fec_get_rate(fec_scheme _scheme)
 
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:          return 223./255.;
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
-
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr,"error: fec_get_rate(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
 
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_get_rate(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+    // LDPC codes
+    case LIQUID_FEC_LDPC_N648:
+    case LIQUID_FEC_LDPC_N1296:
+    case LIQUID_FEC_LDPC_N1944:     return 1./2.;
 
     default:
         printf("error: fec_get_rate(), unknown/unsupported scheme: %d\n", _scheme);
@@ -471,7 +734,8 @@ float fec_get_rate(fec_scheme _scheme)
 
 // create a fec object of a particular scheme
 //  _scheme     :   error-correction scheme
-//  _opts       :   (ignored)
+//  _opts       :   scheme options: fecrsprops_s for LIQUID_FEC_RS_M8,
+//                  ignored otherwise (NULL selects defaults)
 fec fec_create(fec_scheme _scheme, void *_opts)
 {
     switch (_scheme) {
@@ -503,7 +767,6 @@ fec fec_create(fec_scheme _scheme, void *_opts)
         return fec_secded7264_create(_opts);
 
     // convolutional codes
-#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:
     case LIQUID_FEC_CONV_V29:
     case LIQUID_FEC_CONV_V39:
@@ -528,33 +791,13 @@ fec fec_create(fec_scheme _scheme, void *_opts)
 
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:
-        return fec_rs_create(_scheme);
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
-
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr,"error: fec_create(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
+        return fec_rs_create(_scheme, _opts);
 
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_create(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+    // LDPC codes
+    case LIQUID_FEC_LDPC_N648:
+    case LIQUID_FEC_LDPC_N1296:
+    case LIQUID_FEC_LDPC_N1944:
+        return fec_ldpc_create(_scheme);
 
     default:
         printf("error: fec_create(), unknown/unsupported scheme: %d\n", _scheme);
@@ -569,12 +812,13 @@ fec fec_create(fec_scheme _scheme, void *_opts)
 // recreate a fec object
 //  _q      :   initial fec object
 //  _scheme :   new scheme
-//  _opts   :   options (ignored)
+//  _opts   :   scheme options (see fec_create()); the object is
+//              rebuilt if the scheme changes or _opts is not NULL
 fec fec_recreate(fec _q,
                  fec_scheme _scheme,
                  void *_opts)
 {
-    if (_q->scheme != _scheme) {
+    if (_q->scheme != _scheme || _opts != NULL) {
         // destroy old object and create new one
         fec_destroy(_q);
         _q = fec_create(_scheme,_opts);
@@ -626,7 +870,6 @@ void fec_destroy(fec _q)
         return;
 
     // convolutional codes
-#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:
     case LIQUID_FEC_CONV_V29:
     case LIQUID_FEC_CONV_V39:
@@ -655,32 +898,13 @@ void fec_destroy(fec _q)
     case LIQUID_FEC_RS_M8:
         fec_rs_destroy(_q);
         return;
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
 
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr,"error: fec_destroy(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_destroy(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
+    // LDPC codes
+    case LIQUID_FEC_LDPC_N648:
+    case LIQUID_FEC_LDPC_N1296:
+    case LIQUID_FEC_LDPC_N1944:
+        fec_ldpc_destroy(_q);
+        return;
 
     default:
         printf("error: fec_destroy(), unknown/unsupported scheme: %d\n", _q->scheme);
@@ -694,6 +918,28 @@ void fec_print(fec _q)
     printf("fec: %s [rate: %4.3f]\n",
         fec_scheme_str[_q->scheme][1],
         _q->rate);
+    if (_q->scheme == LIQUID_FEC_RS_M8)
+        printf("  Reed-Solomon (n=%d, k=%d), %d parity symbols\n",
+            _q->kk + _q->nroots, _q->kk, _q->nroots);
+}
+
+// get the rate of a fec object, including any options given at
+// creation (e.g. Reed-Solomon properties)
+float fec_get_code_rate(fec _q)
+{
+    return _q->rate;
+}
+
+// return the encoded message length for a fec object, including any
+// options given at creation (e.g. Reed-Solomon properties)
+//  _q          :   fec object
+//  _msg_len    :   raw, uncoded message length
+unsigned int fec_get_enc_msg_len(fec          _q,
+                                 unsigned int _msg_len)
+{
+    if (_q->scheme == LIQUID_FEC_RS_M8)
+        return fec_rs_get_enc_msg_len(_msg_len, _q->nroots, _q->kk + _q->nroots, _q->kk);
+    return fec_get_enc_msg_length(_q->scheme, _msg_len);
 }
 
 // encode a block of data using a fec scheme
@@ -739,25 +985,63 @@ void fec_decode_soft(fec _q,
         _q->decode_soft_func(_q, _dec_msg_len, _msg_enc, _msg_dec);
     } else {
         // pack bytes and use hard-decision decoding
-        unsigned enc_msg_len = fec_get_enc_msg_length(_q->scheme, _dec_msg_len);
+        unsigned enc_msg_len = fec_get_enc_msg_len(_q, _dec_msg_len);
         unsigned char msg_enc_hard[enc_msg_len];
-        unsigned int i;
-        for (i=0; i<enc_msg_len; i++) {
-            // TODO : use pack bytes
-            msg_enc_hard[i] = 0;
-            msg_enc_hard[i] |= (_msg_enc[8*i+0] >> 0) & 0x80;
-            msg_enc_hard[i] |= (_msg_enc[8*i+1] >> 1) & 0x40;
-            msg_enc_hard[i] |= (_msg_enc[8*i+2] >> 2) & 0x20;
-            msg_enc_hard[i] |= (_msg_enc[8*i+3] >> 3) & 0x10;
-            msg_enc_hard[i] |= (_msg_enc[8*i+4] >> 4) & 0x08;
-            msg_enc_hard[i] |= (_msg_enc[8*i+5] >> 5) & 0x04;
-            msg_enc_hard[i] |= (_msg_enc[8*i+6] >> 6) & 0x02;
-            msg_enc_hard[i] |= (_msg_enc[8*i+7] >> 7) & 0x01;
-        }
+        fecsoft_hard_decision(_msg_enc, enc_msg_len, msg_enc_hard);
 
         // use hard-decoding method
         fec_decode(_q, _dec_msg_len, msg_enc_hard, _msg_dec);
     }
 }
 
+// decode several blocks of data stored one after another
+//  _q              :   fec object
+//  _dec_msg_len    :   decoded message length (each block)
+//  _num            :   number of blocks
+//  _msg_enc        :   encoded messages [size: _num*enc_msg_len x 1]
+//  _msg_dec        :   decoded messages [size: _num*_dec_msg_len x 1]
+void fec_decode_block(fec _q,
+                      unsigned int _dec_msg_len,
+                      unsigned int _num,
+                      unsigned char * _msg_enc,
+                      unsigned char * _msg_dec)
+{
+    // Reed-Solomon codewords of all messages are decoded together
+    if (_q->scheme == LIQUID_FEC_RS_M8) {
+        fec_rs_decode_block(_q, _dec_msg_len, _num, _msg_enc, _msg_dec);
+        return;
+    }
+
+    unsigned int enc_msg_len = fec_get_enc_msg_len(_q, _dec_msg_len);
+    unsigned int i;
+    for (i=0; i<_num; i++)
+        fec_decode(_q, _dec_msg_len, &_msg_enc[i*enc_msg_len], &_msg_dec[i*_dec_msg_len]);
+}
+
+// decode several blocks of data stored one after another (soft decision)
+//  _q              :   fec object
+//  _dec_msg_len    :   decoded message length (each block)
+//  _num            :   number of blocks
+//  _msg_enc        :   encoded messages (soft bits) [size: 8*_num*enc_msg_len x 1]
+//  _msg_dec        :   decoded messages [size: _num*_dec_msg_len x 1]
+void fec_decode_soft_block(fec _q,
+                           unsigned int _dec_msg_len,
+                           unsigned int _num,
+                           unsigned char * _msg_enc,
+                           unsigned char * _msg_dec)
+{
+    unsigned int enc_msg_len = fec_get_enc_msg_len(_q, _dec_msg_len);
+    unsigned int i;
+    if (_q->decode_soft_func != NULL) {
+        for (i=0; i<_num; i++)
+            _q->decode_soft_func(_q, _dec_msg_len, &_msg_enc[8*i*enc_msg_len], &_msg_dec[i*_dec_msg_len]);
+    } else {
+        // pack bytes of all messages and use hard-decision decoding
+        unsigned char * msg_enc_hard = (unsigned char*) malloc(_num*enc_msg_len*sizeof(unsigned char));
+        fecsoft_hard_decision(_msg_enc, _num*enc_msg_len, msg_enc_hard);
+        fec_decode_block(_q, _dec_msg_len, _num, msg_enc_hard, _msg_dec);
+        free(msg_enc_hard);
+    }
+}
+
 
@@ -32,9 +32,6 @@
 
 #define VERBOSE_FEC_CONV    0
 
-#if LIBFEC_ENABLED
-#include "fec.h"
-
 fec fec_conv_create(fec_scheme _fs)
 {
     fec q = (fec) malloc(sizeof(struct fec_s));
@@ -68,7 +65,7 @@ void fec_conv_destroy(fec _q)
 {
     // delete viterbi decoder
     if (_q->vp != NULL)
-        _q->delete_viterbi(_q->vp);
+        fec_viterbi_destroy(_q->vp);
 
     if (_q->enc_bits != NULL)
         free(_q->enc_bits);
@@ -100,7 +97,7 @@ void fec_conv_encode(fec _q,
 
             // compute parity bits for each polynomial
             for (r=0; r<_q->R; r++) {
-                byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                 _msg_enc[n/8] = byte_out;
                 n++;
             }
@@ -114,7 +111,7 @@ void fec_conv_encode(fec _q,
 
         // compute parity bits for each polynomial
         for (r=0; r<_q->R; r++) {
-            byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+            byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
             _msg_enc[n/8] = byte_out;
             n++;
         }
@@ -191,9 +188,9 @@ void fec_conv_decode(fec _q,
                      unsigned char *_msg_dec)
 {
     // run decoder
-    _q->init_viterbi(_q->vp,0);
-    _q->update_viterbi_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
-    _q->chainback_viterbi(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
+    fec_viterbi_reset(_q->vp);
+    fec_viterbi_update(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
+    fec_viterbi_chainback(_q->vp, _msg_dec, 8*_q->num_dec_bytes);
 
 #if VERBOSE_FEC_CONV
     for (i=0; i<_dec_msg_len; i++)
@@ -222,10 +219,10 @@ void fec_conv_setlength(fec _q, unsigned int _dec_msg_len)
 
     // delete old decoder if necessary
     if (_q->vp != NULL)
-        _q->delete_viterbi(_q->vp);
+        fec_viterbi_destroy(_q->vp);
 
     // re-create / re-allocate memory buffers
-    _q->vp = _q->create_viterbi(8*_q->num_dec_bytes);
+    _q->vp = fec_viterbi_create(_q->K, _q->R, _q->poly, 8*_q->num_dec_bytes);
     _q->enc_bits = (unsigned char*) realloc(_q->enc_bits,
                                             _q->num_enc_bytes*8*sizeof(unsigned char));
 }
@@ -239,11 +236,6 @@ void fec_conv_init_v27(fec _q)
     _q->R=2;
     _q->K=7;
     _q->poly = fec_conv27_poly;
-    _q->create_viterbi = create_viterbi27;
-    _q->init_viterbi = init_viterbi27;
-    _q->update_viterbi_blk = update_viterbi27_blk;
-    _q->chainback_viterbi = chainback_viterbi27;
-    _q->delete_viterbi = delete_viterbi27;
 }
 
 void fec_conv_init_v29(fec _q)
@@ -251,11 +243,6 @@ void fec_conv_init_v29(fec _q)
     _q->R=2;
     _q->K=9;
     _q->poly = fec_conv29_poly;
-    _q->create_viterbi = create_viterbi29;
-    _q->init_viterbi = init_viterbi29;
-    _q->update_viterbi_blk = update_viterbi29_blk;
-    _q->chainback_viterbi = chainback_viterbi29;
-    _q->delete_viterbi = delete_viterbi29;
 }
 
 void fec_conv_init_v39(fec _q)
@@ -263,11 +250,6 @@ void fec_conv_init_v39(fec _q)
     _q->R=3;
     _q->K=9;
     _q->poly = fec_conv39_poly;
-    _q->create_viterbi = create_viterbi39;
-    _q->init_viterbi = init_viterbi39;
-    _q->update_viterbi_blk = update_viterbi39_blk;
-    _q->chainback_viterbi = chainback_viterbi39;
-    _q->delete_viterbi = delete_viterbi39;
 }
 
 void fec_conv_init_v615(fec _q)
@@ -275,25 +257,5 @@ void fec_conv_init_v615(fec _q)
     _q->R=6;
     _q->K=15;
     _q->poly = fec_conv615_poly;
-    _q->create_viterbi = create_viterbi615;
-    _q->init_viterbi = init_viterbi615;
-    _q->update_viterbi_blk = update_viterbi615_blk;
-    _q->chainback_viterbi = chainback_viterbi615;
-    _q->delete_viterbi = delete_viterbi615;
 }
 
-
-
-#else   // LIBFEC_ENABLED
-
-fec fec_conv_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_conv_destroy(fec _q)
-{
-}
-
-#endif  // LIBFEC_ENABLED
-
@@ -32,9 +32,6 @@
 
 #define VERBOSE_FEC_CONV_PUNCTURED    0
 
-#if LIBFEC_ENABLED
-#include "fec.h"
-
 fec fec_conv_punctured_create(fec_scheme _fs)
 {
     fec q = (fec) malloc(sizeof(struct fec_s));
@@ -77,7 +74,7 @@ void fec_conv_punctured_destroy(fec _q)
 {
     // delete viterbi decoder
     if (_q->vp != NULL)
-        _q->delete_viterbi(_q->vp);
+        fec_viterbi_destroy(_q->vp);
 
     if (_q->enc_bits != NULL)
         free(_q->enc_bits);
@@ -112,7 +109,7 @@ void fec_conv_punctured_encode(fec _q,
             for (r=0; r<_q->R; r++) {
                 // enable output determined by puncturing matrix
                 if (_q->puncturing_matrix[r*(_q->P)+p]) {
-                    byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                    byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                     _msg_enc[n/8] = byte_out;
                     n++;
                 } else {
@@ -134,7 +131,7 @@ void fec_conv_punctured_encode(fec _q,
         // compute parity bits for each polynomial
         for (r=0; r<_q->R; r++) {
             if (_q->puncturing_matrix[r*(_q->P)+p]) {
-                byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                 _msg_enc[n/8] = byte_out;
                 n++;
             }
@@ -174,19 +171,17 @@ void fec_conv_punctured_decode_hard(fec _q,
     unsigned int k=0;   // intput bit index (0<=k<8)
     unsigned int p=0;   // puncturing matrix column index
     unsigned char bit;
-    unsigned char byte_in = _msg_enc[n];
     for (i=0; i<num_enc_bits; i+=_q->R) {
         //
         for (r=0; r<_q->R; r++) {
             if (_q->puncturing_matrix[r*(_q->P)+p]) {
-                // push bit from input
-                bit = (byte_in >> (7-k)) & 0x01;
+                // push bit from input (without reading past its end)
+                bit = (_msg_enc[n] >> (7-k)) & 0x01;
                 _q->enc_bits[i+r] = bit ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
                 k++;
                 if (k==8) {
                     k = 0;
                     n++;
-                    byte_in = _msg_enc[n];
                 }
             } else {
                 // push erasure
@@ -208,10 +203,9 @@ void fec_conv_punctured_decode_hard(fec _q,
 #endif
 
     // run decoder
-    _q->init_viterbi(_q->vp,0);
-    // TODO : check to see if this shouldn't be num_enc_bits (punctured)
-    _q->update_viterbi_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
-    _q->chainback_viterbi(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
+    fec_viterbi_reset(_q->vp);
+    fec_viterbi_update(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
+    fec_viterbi_chainback(_q->vp, _msg_dec, 8*_q->num_dec_bytes);
 
 #if VERBOSE_FEC_CONV_PUNCTURED
     for (ii=0; ii<_dec_msg_len; ii++)
@@ -261,10 +255,9 @@ void fec_conv_punctured_decode_soft(fec _q,
 #endif
 
     // run decoder
-    _q->init_viterbi(_q->vp,0);
-    // TODO : check to see if this shouldn't be num_enc_bits (punctured)
-    _q->update_viterbi_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
-    _q->chainback_viterbi(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
+    fec_viterbi_reset(_q->vp);
+    fec_viterbi_update(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
+    fec_viterbi_chainback(_q->vp, _msg_dec, 8*_q->num_dec_bytes);
 
 #if VERBOSE_FEC_CONV_PUNCTURED
     for (ii=0; ii<_dec_msg_len; ii++)
@@ -303,10 +296,10 @@ void fec_conv_punctured_setlength(fec _q, unsigned int _dec_msg_len)
 
     // delete old decoder if necessary
     if (_q->vp != NULL)
-        _q->delete_viterbi(_q->vp);
+        fec_viterbi_destroy(_q->vp);
 
     // re-create / re-allocate memory buffers
-    _q->vp = _q->create_viterbi(8*_q->num_dec_bytes);
+    _q->vp = fec_viterbi_create(_q->K, _q->R, _q->poly, 8*_q->num_dec_bytes);
     _q->enc_bits = (unsigned char*) realloc(_q->enc_bits,
                                             num_enc_bits*sizeof(unsigned char));
 
@@ -318,7 +311,7 @@ void fec_conv_punctured_setlength(fec _q, unsigned int _dec_msg_len)
 
 void fec_conv_init_v27p23(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 2;
@@ -327,7 +320,7 @@ void fec_conv_init_v27p23(fec _q)
 
 void fec_conv_init_v27p34(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 3;
@@ -336,7 +329,7 @@ void fec_conv_init_v27p34(fec _q)
 
 void fec_conv_init_v27p45(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 4;
@@ -345,7 +338,7 @@ void fec_conv_init_v27p45(fec _q)
 
 void fec_conv_init_v27p56(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 5;
@@ -355,7 +348,7 @@ void fec_conv_init_v27p56(fec _q)
 
 void fec_conv_init_v27p67(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 6;
@@ -364,7 +357,7 @@ void fec_conv_init_v27p67(fec _q)
 
 void fec_conv_init_v27p78(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v27(_q);
 
     _q->P = 7;
@@ -374,7 +367,7 @@ void fec_conv_init_v27p78(fec _q)
 
 void fec_conv_init_v29p23(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 2;
@@ -383,7 +376,7 @@ void fec_conv_init_v29p23(fec _q)
 
 void fec_conv_init_v29p34(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 3;
@@ -392,7 +385,7 @@ void fec_conv_init_v29p34(fec _q)
 
 void fec_conv_init_v29p45(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 4;
@@ -401,7 +394,7 @@ void fec_conv_init_v29p45(fec _q)
 
 void fec_conv_init_v29p56(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 5;
@@ -411,7 +404,7 @@ void fec_conv_init_v29p56(fec _q)
 
 void fec_conv_init_v29p67(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 6;
@@ -420,39 +413,10 @@ void fec_conv_init_v29p67(fec _q)
 
 void fec_conv_init_v29p78(fec _q)
 {
-    // initialize R, K, polynomial, and viterbi methods
+    // initialize R, K, and polynomial
     fec_conv_init_v29(_q);
 
     _q->P = 7;
     _q->puncturing_matrix = fec_conv29p78_matrix;
 }
 
-
-#else   // LIBFEC_ENABLED
-
-fec fec_conv_punctured_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_conv_punctured_destroy(fec _q)
-{
-}
-
-void fec_conv_punctured_encode(fec _q,
-                               unsigned int _dec_msg_len,
-                               unsigned char *_msg_dec,
-                               unsigned char *_msg_enc)
-{
-}
-
-//unsigned int
-void fec_conv_punctured_decode(fec _q,
-                               unsigned int _dec_msg_len,
-                               unsigned char *_msg_enc,
-                               unsigned char *_msg_dec)
-{
-}
-
-#endif  // LIBFEC_ENABLED
-
@@ -36,6 +36,9 @@
 
 #define DEBUG_FEC_GOLAY2412 0
 
+// number of least reliable bits flipped in soft decoding (Chase-II)
+#define GOLAY2412_CHASE_NUM_POSITIONS   4
+
 // P matrix [12 x 12]
 unsigned int golay2412_P[12] = {
     0x08ed, 0x01db, 0x03b5, 0x0769,
@@ -127,25 +130,11 @@ int golay2412_parity_search(unsigned int _v)
     return -1;
 }
 
-unsigned int fec_golay2412_decode_symbol(unsigned int _sym_enc)
+// estimate error vector from 12-bit syndrome, s
+unsigned int golay2412_estimate_ehat(unsigned int _s)
 {
-    // validate input
-    if (_sym_enc >= (1<<24)) {
-        fprintf(stderr,"error, fec_golay2412_decode_symbol(), input symbol too large\n");
-        exit(1);
-    }
-
-    // state variables
-    unsigned int s=0;       // syndrome vector
-    unsigned int e_hat=0;   // estimated error vector
-    unsigned int v_hat=0;   // estimated transmitted message
-    unsigned int m_hat=0;   // estimated original message
-    
-    // compute syndrome vector, s = r*H^T = ( H*r^T )^T
-    s = golay2412_matrix_mul(_sym_enc, golay2412_H, 12);
-#if DEBUG_FEC_GOLAY2412
-    printf("s (syndrome vector): "); liquid_print_bitstring(s,12); printf("\n");
-#endif
+    unsigned int s     = _s;    // syndrome vector
+    unsigned int e_hat = 0;     // estimated error vector
 
     // compute weight of s (12 bits)
     unsigned int ws = liquid_count_ones_uint16(s);
@@ -154,7 +143,6 @@ unsigned int fec_golay2412_decode_symbol(unsigned int _sym_enc)
 #endif
 
     // step 2:
-    e_hat = 0;
     if (ws <= 3) {
 #if DEBUG_FEC_GOLAY2412
         printf("    w(s) <= 3: estimating error vector as [s, 0(12)]\n");
@@ -220,8 +208,28 @@ unsigned int fec_golay2412_decode_symbol(unsigned int _sym_enc)
         }
     }
 
+    return e_hat;
+}
+
+unsigned int fec_golay2412_decode_symbol(unsigned int _sym_enc)
+{
+    // validate input
+    if (_sym_enc >= (1<<24)) {
+        fprintf(stderr,"error, fec_golay2412_decode_symbol(), input symbol too large\n");
+        exit(1);
+    }
+
+    // compute syndrome vector, s = r*H^T = ( H*r^T )^T
+    unsigned int s = golay2412_matrix_mul(_sym_enc, golay2412_H, 12);
+#if DEBUG_FEC_GOLAY2412
+    printf("s (syndrome vector): "); liquid_print_bitstring(s,12); printf("\n");
+#endif
+
+    // estimate error vector
+    unsigned int e_hat = golay2412_estimate_ehat(s);
+
     // step 8: compute estimated transmitted message: v_hat = r + e_hat
-    v_hat = _sym_enc ^ e_hat;
+    unsigned int v_hat = _sym_enc ^ e_hat;
 #if DEBUG_FEC_GOLAY2412
     printf("r (recevied vector):            "); liquid_print_bitstring(_sym_enc,24); printf("\n");
     printf("e-hat (estimated error vector): "); liquid_print_bitstring(e_hat,24);    printf("\n");
@@ -229,9 +237,56 @@ unsigned int fec_golay2412_decode_symbol(unsigned int _sym_enc)
 #endif
     
     // compute estimated original message: (last 12 bits of encoded message)
-    m_hat = v_hat & 0x0fff;
+    return v_hat & 0x0fff;
+}
+
+// look-up tables built when the library is loaded: encoded symbol for
+// each half of the message, syndrome contribution of each byte of the
+// received symbol, and estimated error vector for each syndrome
+static unsigned int       golay2412_enc_tab[2][64];
+static unsigned short int golay2412_syn_tab[3][256];
+static unsigned int       golay2412_ehat_tab[4096];
+static int                golay2412_tables_ready = 0;
+
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void fec_golay2412_init_tables(void)
+{
+    unsigned int i;
+    for (i=0; i<64; i++) {
+        golay2412_enc_tab[0][i] = golay2412_matrix_mul(i,    golay2412_Gt, 24);
+        golay2412_enc_tab[1][i] = golay2412_matrix_mul(i<<6, golay2412_Gt, 24);
+    }
+    for (i=0; i<256; i++) {
+        golay2412_syn_tab[0][i] = golay2412_matrix_mul(i,     golay2412_H, 12);
+        golay2412_syn_tab[1][i] = golay2412_matrix_mul(i<< 8, golay2412_H, 12);
+        golay2412_syn_tab[2][i] = golay2412_matrix_mul(i<<16, golay2412_H, 12);
+    }
+    for (i=0; i<4096; i++)
+        golay2412_ehat_tab[i] = golay2412_estimate_ehat(i);
+    golay2412_tables_ready = 1;
+}
 
-    return m_hat;
+// encode 12-bit symbol using look-up tables
+static inline unsigned int golay2412_encode_fast(unsigned int _m)
+{
+    return golay2412_enc_tab[0][_m & 0x3f] ^ golay2412_enc_tab[1][_m >> 6];
+}
+
+// compute syndrome of 24-bit symbol using look-up tables
+static inline unsigned int golay2412_syndrome_fast(unsigned int _v)
+{
+    return golay2412_syn_tab[0][(_v      ) & 0xff] ^
+           golay2412_syn_tab[1][(_v >>  8) & 0xff] ^
+           golay2412_syn_tab[2][(_v >> 16) & 0xff];
+}
+
+// decode 24-bit symbol using look-up tables
+static inline unsigned int golay2412_decode_fast(unsigned int _v)
+{
+    unsigned int s = golay2412_syndrome_fast(_v);
+    return (_v ^ golay2412_ehat_tab[s]) & 0x0fff;
 }
 
 // create Golay(24,12) codec object
@@ -246,7 +301,7 @@ fec fec_golay2412_create(void * _opts)
     // set internal function pointers
     q->encode_func      = &fec_golay2412_encode;
     q->decode_func      = &fec_golay2412_decode;
-    q->decode_soft_func = NULL;
+    q->decode_soft_func = &fec_golay2412_decode_soft;
 
     return q;
 }
@@ -274,6 +329,9 @@ void fec_golay2412_encode(fec _q,
     unsigned int m0, m1;        // two 12-bit symbols (uncoded)
     unsigned int v0, v1;        // two 24-bit symbols (encoded)
 
+    if (!golay2412_tables_ready)
+        fec_golay2412_init_tables();
+
     // determine remainder of input length / 3
     unsigned int r = _dec_msg_len % 3;
 
@@ -288,8 +346,8 @@ void fec_golay2412_encode(fec _q,
         m1 = ((s1 << 8) & 0x0f00) | ((s2     ) & 0x00ff);
 
         // encode each 12-bit symbol into a 24-bit symbol
-        v0 = fec_golay2412_encode_symbol(m0);
-        v1 = fec_golay2412_encode_symbol(m1);
+        v0 = golay2412_encode_fast(m0);
+        v1 = golay2412_encode_fast(m1);
 
         // unpack two 24-bit symbols into six 8-bit bytes
         // retaining order of bits in output
@@ -312,7 +370,7 @@ void fec_golay2412_encode(fec _q,
         m0 = s0;
 
         // encode into 24-bit symbol
-        v0 = fec_golay2412_encode_symbol(m0);
+        v0 = golay2412_encode_fast(m0);
 
         // unpack one 24-bit symbol into three 8-bit bytes, and
         // append to output array
@@ -345,6 +403,9 @@ void fec_golay2412_decode(fec _q,
     unsigned int r0, r1, r2, r3, r4, r5;    // six 8-bit bytes
     unsigned int v0, v1;                    // two 24-bit encoded symbols
     unsigned int m0_hat, m1_hat;            // two 12-bit decoded symbols
+
+    if (!golay2412_tables_ready)
+        fec_golay2412_init_tables();
     
     // determine remainder of input length / 3
     unsigned int r = _dec_msg_len % 3;
@@ -363,8 +424,8 @@ void fec_golay2412_decode(fec _q,
         v1 = ((r3 << 16) & 0xff0000) | ((r4 <<  8) & 0x00ff00) | ((r5 << 0) & 0x0000ff);
 
         // decode each symbol into a 12-bit symbol
-        m0_hat = fec_golay2412_decode_symbol(v0);
-        m1_hat = fec_golay2412_decode_symbol(v1);
+        m0_hat = golay2412_decode_fast(v0);
+        m1_hat = golay2412_decode_fast(v1);
 
         // unpack two 12-bit symbols into three 8-bit bytes
         _msg_dec[i+0] = ((m0_hat >> 4) & 0xff);
@@ -385,7 +446,7 @@ void fec_golay2412_decode(fec _q,
         v0 = ((r0 << 16) & 0xff0000) | ((r1 <<  8) & 0x00ff00) | ((r2     ) & 0x0000ff);
 
         // decode into a 12-bit symbol
-        m0_hat = fec_golay2412_decode_symbol(v0);
+        m0_hat = golay2412_decode_fast(v0);
 
         // retain last 8 bits of 12-bit symbol
         _msg_dec[i] = m0_hat & 0xff;
@@ -399,3 +460,137 @@ void fec_golay2412_decode(fec _q,
     //return num_errors;
 }
 
+// decode 24-bit symbol from hard decisions if its syndrome is zero,
+// otherwise from soft bits
+static inline unsigned int golay2412_decode_soft_symbol(unsigned char * _soft_bits,
+                                                        unsigned char * _v)
+{
+    unsigned int v = (_v[0] << 16) | (_v[1] << 8) | _v[2];
+    if (golay2412_syndrome_fast(v) == 0)
+        return v & 0x0fff;
+    return fecsoft_golay2412_decode(_soft_bits);
+}
+
+// decode block of data using Golay(24,12) soft decoder
+//
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: 8*_enc_msg_len x 1]
+//  _msg_dec        :   decoded message [size: _dec_msg_len x 1]
+void fec_golay2412_decode_soft(fec _q,
+                               unsigned int _dec_msg_len,
+                               unsigned char *_msg_enc,
+                               unsigned char *_msg_dec)
+{
+    unsigned int i=0;               // decoded byte counter
+    unsigned int k=0;               // soft bit counter
+    unsigned int m0_hat, m1_hat;    // two 12-bit decoded symbols
+
+    if (!golay2412_tables_ready)
+        fec_golay2412_init_tables();
+
+    // hard decisions for the whole message; only symbols with a
+    // non-zero syndrome are decoded from their soft bits
+    unsigned int enc_msg_len = fec_get_enc_msg_length(LIQUID_FEC_GOLAY2412,_dec_msg_len);
+    unsigned char v_hard[enc_msg_len];
+    fecsoft_hard_decision(_msg_enc, enc_msg_len, v_hard);
+
+    // determine remainder of input length / 3
+    unsigned int r = _dec_msg_len % 3;
+
+    for (i=0; i<_dec_msg_len-r; i+=3) {
+        // decode two 24-bit symbols
+        m0_hat = golay2412_decode_soft_symbol(&_msg_enc[k   ], &v_hard[k/8  ]);
+        m1_hat = golay2412_decode_soft_symbol(&_msg_enc[k+24], &v_hard[k/8+3]);
+
+        // unpack two 12-bit symbols into three 8-bit bytes
+        _msg_dec[i+0] = ((m0_hat >> 4) & 0xff);
+        _msg_dec[i+1] = ((m0_hat << 4) & 0xf0) | ((m1_hat >> 8) & 0x0f);
+        _msg_dec[i+2] = ((m1_hat     ) & 0xff);
+
+        k += 48;
+    }
+
+    // if input length isn't divisible by 3, decode last 1 or two bytes
+    for (i=_dec_msg_len-r; i<_dec_msg_len; i++) {
+        // decode into a 12-bit symbol and retain last 8 bits
+        m0_hat = golay2412_decode_soft_symbol(&_msg_enc[k], &v_hard[k/8]);
+        _msg_dec[i] = m0_hat & 0xff;
+
+        k += 24;
+    }
+
+    assert( k == 8*enc_msg_len );
+}
+
+// soft decoding of one symbol (Chase-II): combinations of the least
+// reliable bits are flipped, each test vector is decoded with the
+// syndrome table (up to three errors), and the codeword with the
+// smallest soft distance (total reliability of bits differing from the
+// hard decision) is kept
+//  _soft_bits  :   soft bits [size: 24 x 1]
+unsigned int fecsoft_golay2412_decode(unsigned char * _soft_bits)
+{
+    if (!golay2412_tables_ready)
+        fec_golay2412_init_tables();
+
+    // hard decisions, first bit is most significant
+    unsigned int i;
+    unsigned char h[3];
+    fecsoft_hard_decision(_soft_bits, 3, h);
+    unsigned int v = (h[0] << 16) | (h[1] << 8) | h[2];
+
+    // received vector is a codeword: no other codeword can be closer
+    unsigned int s = golay2412_syndrome_fast(v);
+    if (s == 0)
+        return v & 0x0fff;
+
+    // find least reliable positions and their syndromes
+    unsigned int p = GOLAY2412_CHASE_NUM_POSITIONS;
+    unsigned int index[p];
+    unsigned int mask[p];
+    unsigned int syn[p];
+    fecsoft_chase_find_positions(_soft_bits, 24, p, index);
+    for (i=0; i<p; i++) {
+        mask[i] = 1 << (23 - index[i]);
+        syn[i]  = golay2412_syndrome_fast(mask[i]);
+    }
+
+    // test all combinations of flipping the least reliable bits
+    unsigned int t, n;
+    unsigned int d_min  = 0;
+    int          found  = 0;    // candidate codeword found?
+    unsigned int e_best = 0;    // error vector of best candidate
+    for (t=0; t<(1U<<p); t++) {
+        unsigned int e  = 0;
+        unsigned int st = s;
+        for (n=0; n<p; n++) {
+            if ((t >> n) & 1) {
+                e  ^= mask[n];
+                st ^= syn[n];
+            }
+        }
+        // skip test vectors with more than three errors detected
+        if (st != 0 && golay2412_ehat_tab[st] == 0)
+            continue;
+        e ^= golay2412_ehat_tab[st];
+
+        // soft distance
+        unsigned int d = 0;
+        unsigned int x = e;
+        while (x) {
+            unsigned int b = liquid_msb_index(x);
+            d += FECSOFT_RELIABILITY(_soft_bits[24-b]);
+            x ^= 1 << (b-1);
+        }
+
+        if (!found || d < d_min) {
+            found  = 1;
+            d_min  = d;
+            e_best = e;
+        }
+    }
+
+    // hard decision if no candidate was found
+    return (v ^ e_best) & 0x0fff;
+}
@@ -33,6 +33,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 #include "liquid.internal.h"
@@ -140,6 +141,22 @@ unsigned int fec_hamming128_decode_symbol(unsigned int _sym_enc)
     return sym_dec;
 }
 
+// decoder look-up table for all 12-bit received symbols, built when
+// the library is loaded
+static unsigned char hamming128_dec_tab[4096];
+static int           hamming128_tables_ready = 0;
+
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void fec_hamming128_init_tables(void)
+{
+    unsigned int i;
+    for (i=0; i<4096; i++)
+        hamming128_dec_tab[i] = fec_hamming128_decode_symbol(i);
+    hamming128_tables_ready = 1;
+}
+
 // create Hamming(12,8) codec object
 fec fec_hamming128_create(void * _opts)
 {
@@ -244,6 +261,9 @@ void fec_hamming128_decode(fec _q,
     unsigned char r0, r1, r2;
     unsigned int m0, m1;
 
+    if (!hamming128_tables_ready)
+        fec_hamming128_init_tables();
+
     for (i=0; i<_dec_msg_len-r; i+=2) {
         // strip three input symbols
         r0 = _msg_enc[j+0];
@@ -255,8 +275,8 @@ void fec_hamming128_decode(fec _q,
         m1 = ((r1 << 8) & 0x0f00) | ((r2     ) & 0x00ff);
 
         // decode each symbol into an 8-bit byte
-        _msg_dec[i+0] = fec_hamming128_decode_symbol(m0);
-        _msg_dec[i+1] = fec_hamming128_decode_symbol(m1);
+        _msg_dec[i+0] = hamming128_dec_tab[m0];
+        _msg_dec[i+1] = hamming128_dec_tab[m1];
 
         j += 3;
     }
@@ -272,7 +292,7 @@ void fec_hamming128_decode(fec _q,
         m0 = ((r0 << 4) & 0x0ff0) | ((r1 >> 4) & 0x000f);
 
         // decode symbol into an 8-bit byte
-        _msg_dec[i++] = fec_hamming128_decode_symbol(m0);
+        _msg_dec[i++] = hamming128_dec_tab[m0];
 
         j += 2;
     }
@@ -331,61 +351,49 @@ void fec_hamming128_decode_soft(fec _q,
 // internal methods
 //
 
-// soft decoding of one symbol
-// NOTE : because this method compares the received symbol to every
-//        possible (256) encoded symbols, it is painfully slow to
-//        run.
-unsigned int fecsoft_hamming128_decode(unsigned char * _soft_bits)
-{
-    // find symbol with minimum distance from all 2^8 possible
-    unsigned int d;             // distance metric
-    unsigned int dmin = 0;      // minimum distance
-    unsigned int s_hat = 0;     // estimated transmitted symbol
-    unsigned int c;             // encoded symbol
+// codeword masks for soft-decision decoding (see fecsoft_nearest),
+// built when the library is loaded
+static unsigned char hamming128_soft_masks[256*16];
+static int           hamming128_soft_masks_ready = 0;
 
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void fecsoft_hamming128_init_masks(void)
+{
     unsigned int s;
     for (s=0; s<256; s++) {
-        // encode symbol
 #if FEC_HAMMING128_ENC_GENTAB
-        c = hamming128_enc_gentab[s];
+        unsigned int c = hamming128_enc_gentab[s];
 #else
-        c = fec_hamming128_encode_symbol(s);
+        unsigned int c = fec_hamming128_encode_symbol(s);
 #endif
-
-        // compute distance metric
-        d = 0;
-        d += (c & 0x0800) ? 255 - _soft_bits[ 0] : _soft_bits[ 0];
-        d += (c & 0x0400) ? 255 - _soft_bits[ 1] : _soft_bits[ 1];
-        d += (c & 0x0200) ? 255 - _soft_bits[ 2] : _soft_bits[ 2];
-        d += (c & 0x0100) ? 255 - _soft_bits[ 3] : _soft_bits[ 3];
-        d += (c & 0x0080) ? 255 - _soft_bits[ 4] : _soft_bits[ 4];
-        d += (c & 0x0040) ? 255 - _soft_bits[ 5] : _soft_bits[ 5];
-        d += (c & 0x0020) ? 255 - _soft_bits[ 6] : _soft_bits[ 6];
-        d += (c & 0x0010) ? 255 - _soft_bits[ 7] : _soft_bits[ 7];
-        d += (c & 0x0008) ? 255 - _soft_bits[ 8] : _soft_bits[ 8];
-        d += (c & 0x0004) ? 255 - _soft_bits[ 9] : _soft_bits[ 9];
-        d += (c & 0x0002) ? 255 - _soft_bits[10] : _soft_bits[10];
-        d += (c & 0x0001) ? 255 - _soft_bits[11] : _soft_bits[11];
-
-        if (d < dmin || s==0) {
-            s_hat = s;
-            dmin = d;
-        }
+        fecsoft_codeword_mask(c, 12, &hamming128_soft_masks[16*s]);
     }
-    return s_hat;
+    hamming128_soft_masks_ready = 1;
+}
+
+// soft decoding of one symbol
+// NOTE : because this method compares the received symbol to every
+//        possible (256) encoded symbols, it is painfully slow to
+//        run.
+unsigned int fecsoft_hamming128_decode(unsigned char * _soft_bits)
+{
+    if (!hamming128_soft_masks_ready)
+        fecsoft_hamming128_init_masks();
+
+    // find symbol with minimum distance from all 2^8 possible
+    return fecsoft_nearest(_soft_bits, 12, hamming128_soft_masks, NULL, 256);
 }
 
 // soft decoding of one symbol using nearest neighbors
 unsigned int fecsoft_hamming128_decode_n3(unsigned char * _soft_bits)
 {
-    // find symbol with minimum distance from 17 nearest neighbors
-    unsigned int d;             // distance metric
-    unsigned int dmin = 0;      // minimum distance
-    unsigned int s_hat = 0;     // estimated transmitted symbol
-    unsigned int c;             // encoded symbol
+    if (!hamming128_soft_masks_ready)
+        fecsoft_hamming128_init_masks();
 
     // compute hard-decoded symbol
-    c = 0x0000;
+    unsigned int c = 0x0000;
     c |= (_soft_bits[ 0] > 127) ? 0x0800 : 0;
     c |= (_soft_bits[ 1] > 127) ? 0x0400 : 0;
     c |= (_soft_bits[ 2] > 127) ? 0x0200 : 0;
@@ -399,68 +407,13 @@ unsigned int fecsoft_hamming128_decode_n3(unsigned char * _soft_bits)
     c |= (_soft_bits[10] > 127) ? 0x0002 : 0;
     c |= (_soft_bits[11] > 127) ? 0x0001 : 0;
 
-    // decode symbol
-    s_hat = fec_hamming128_decode_symbol(c);
-
-    // re-encode and compute distance
-#if FEC_HAMMING128_ENC_GENTAB
-    c = hamming128_enc_gentab[s_hat];
-#else
-    c = fec_hamming128_encode_symbol(s_hat);
-#endif
-
-    // compute distance metric
-    d = 0;
-    d += (c & 0x0800) ? 255 - _soft_bits[ 0] : _soft_bits[ 0];
-    d += (c & 0x0400) ? 255 - _soft_bits[ 1] : _soft_bits[ 1];
-    d += (c & 0x0200) ? 255 - _soft_bits[ 2] : _soft_bits[ 2];
-    d += (c & 0x0100) ? 255 - _soft_bits[ 3] : _soft_bits[ 3];
-    d += (c & 0x0080) ? 255 - _soft_bits[ 4] : _soft_bits[ 4];
-    d += (c & 0x0040) ? 255 - _soft_bits[ 5] : _soft_bits[ 5];
-    d += (c & 0x0020) ? 255 - _soft_bits[ 6] : _soft_bits[ 6];
-    d += (c & 0x0010) ? 255 - _soft_bits[ 7] : _soft_bits[ 7];
-    d += (c & 0x0008) ? 255 - _soft_bits[ 8] : _soft_bits[ 8];
-    d += (c & 0x0004) ? 255 - _soft_bits[ 9] : _soft_bits[ 9];
-    d += (c & 0x0002) ? 255 - _soft_bits[10] : _soft_bits[10];
-    d += (c & 0x0001) ? 255 - _soft_bits[11] : _soft_bits[11];
-
-    dmin = d;
-
-    // search over 17 nearest neighbors
-    unsigned int s;
-    unsigned int i;
-    for (i=0; i<17; i++) {
-        // use look-up table for nearest neighbors
-        s = fecsoft_hamming128_n3[s_hat][i];
-
-        // encode symbol
-#if FEC_HAMMING128_ENC_GENTAB
-        c = hamming128_enc_gentab[s];
-#else
-        c = fec_hamming128_encode_symbol(s);
-#endif
-
-        // compute distance metric
-        d = 0;
-        d += (c & 0x0800) ? 255 - _soft_bits[ 0] : _soft_bits[ 0];
-        d += (c & 0x0400) ? 255 - _soft_bits[ 1] : _soft_bits[ 1];
-        d += (c & 0x0200) ? 255 - _soft_bits[ 2] : _soft_bits[ 2];
-        d += (c & 0x0100) ? 255 - _soft_bits[ 3] : _soft_bits[ 3];
-        d += (c & 0x0080) ? 255 - _soft_bits[ 4] : _soft_bits[ 4];
-        d += (c & 0x0040) ? 255 - _soft_bits[ 5] : _soft_bits[ 5];
-        d += (c & 0x0020) ? 255 - _soft_bits[ 6] : _soft_bits[ 6];
-        d += (c & 0x0010) ? 255 - _soft_bits[ 7] : _soft_bits[ 7];
-        d += (c & 0x0008) ? 255 - _soft_bits[ 8] : _soft_bits[ 8];
-        d += (c & 0x0004) ? 255 - _soft_bits[ 9] : _soft_bits[ 9];
-        d += (c & 0x0002) ? 255 - _soft_bits[10] : _soft_bits[10];
-        d += (c & 0x0001) ? 255 - _soft_bits[11] : _soft_bits[11];
-
-        if (d < dmin) {
-            s_hat = s;
-            dmin = d;
-        }
-    }
+    // candidates: hard-decoded symbol followed by its 17 nearest
+    // neighbors (ties resolve to the hard decision)
+    unsigned char idx[18];
+    idx[0] = fec_hamming128_decode_symbol(c);
+    memmove(&idx[1], fecsoft_hamming128_n3[idx[0]], 17);
 
-    return s_hat;
+    // find symbol with minimum distance among candidates
+    return idx[ fecsoft_nearest(_soft_bits, 12, hamming128_soft_masks, idx, 18) ];
 }
 
@@ -27,6 +27,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <stdint.h>
 
 #include "liquid.internal.h"
 
@@ -97,7 +98,23 @@ void fec_hamming74_encode(fec _q,
     unsigned char s0, s1;   // decoded symbols
     unsigned char m0, m1;   // encoded symbols
 
-    for (i=0; i<_dec_msg_len; i++) {
+    // encode four bytes at a time: eight 7-bit symbols fill exactly
+    // seven output bytes, so each group can be assembled in a single
+    // 64-bit word without per-symbol bit packing
+    unsigned int n;
+    for (i=0; i+4<=_dec_msg_len; i+=4) {
+        uint64_t v = 0;
+        for (n=0; n<4; n++) {
+            v = (v << 14) | ((uint64_t)hamming74_enc_gentab[_msg_dec[i+n] >> 4  ] << 7)
+                          |            hamming74_enc_gentab[_msg_dec[i+n] & 0x0f];
+        }
+        for (n=0; n<7; n++)
+            _msg_enc[k/8 + n] = (v >> (48 - 8*n)) & 0xff;
+        k += 56;
+    }
+
+    // encode remaining bytes
+    for ( ; i<_dec_msg_len; i++) {
         // strip two 4-bit symbols from input byte
         s0 = (_msg_dec[i] >> 4) & 0x0f;
         s1 = (_msg_dec[i] >> 0) & 0x0f;
@@ -138,8 +155,22 @@ void fec_hamming74_decode(fec _q,
     unsigned char r0, r1;   // received 7-bit symbols
     unsigned char s0, s1;   // decoded 4-bit symbols
 
+    // decode four bytes (seven input bytes) at a time
+    unsigned int n;
+    for (i=0; i+4<=_dec_msg_len; i+=4) {
+        uint64_t v = 0;
+        for (n=0; n<7; n++)
+            v = (v << 8) | _msg_enc[k/8 + n];
+        for (n=0; n<4; n++) {
+            r0 = (v >> (49 - 14*n)) & 0x7f;
+            r1 = (v >> (42 - 14*n)) & 0x7f;
+            _msg_dec[i+n] = (hamming74_dec_gentab[r0] << 4) | hamming74_dec_gentab[r1];
+        }
+        k += 56;
+    }
+
     //unsigned char num_errors=0;
-    for (i=0; i<_dec_msg_len; i++) {
+    for ( ; i<_dec_msg_len; i++) {
         // strip two 7-bit symbols from 
         liquid_unpack_array(_msg_enc, enc_msg_len, k, 7, &r0);
         k += 7;
@@ -175,20 +206,19 @@ void fec_hamming74_decode_soft(fec _q,
     // compute encoded message length
     unsigned int enc_msg_len = fec_block_get_enc_msg_len(_dec_msg_len,4,7);
 
-    // decoded 4-bit symbols
-    unsigned char s0;
-    unsigned char s1;
+    // decoded 4-bit symbols, two per byte
+    unsigned char s[64];
+    unsigned int j;
+    unsigned int num;
 
-    //unsigned char num_errors=0;
-    for (i=0; i<_dec_msg_len; i++) {
-        s0 = fecsoft_hamming74_decode(&_msg_enc[k  ]);
-        s1 = fecsoft_hamming74_decode(&_msg_enc[k+7]);
-        k += 14;
-
-        // pack two 4-bit symbols into one 8-bit byte
-        _msg_dec[i] = (s0 << 4) | s1;
+    for (i=0; i<_dec_msg_len; i+=num) {
+        num = (_dec_msg_len - i < 32) ? _dec_msg_len - i : 32;
+        fecsoft_hamming74_decode_block(&_msg_enc[k], 2*num, s);
+        k += 14*num;
 
-        //printf("  %3u : 0x%.2x > 0x%.2x,  0x%.2x > 0x%.2x (k=%u)\n", i, r0, s0, r1, s1, k);
+        // pack pairs of 4-bit symbols into 8-bit bytes
+        for (j=0; j<num; j++)
+            _msg_dec[i+j] = (s[2*j] << 4) | s[2*j+1];
     }
     assert(k == 8*enc_msg_len);
     //return num_errors;
@@ -198,34 +228,39 @@ void fec_hamming74_decode_soft(fec _q,
 // internal methods
 //
 
+// codeword masks for soft-decision decoding (see fecsoft_nearest),
+// built when the library is loaded
+static unsigned char hamming74_soft_masks[16*16];
+static int           hamming74_soft_masks_ready = 0;
+
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void fecsoft_hamming74_init_masks(void)
+{
+    unsigned int s;
+    for (s=0; s<16; s++)
+        fecsoft_codeword_mask(hamming74_enc_gentab[s], 7, &hamming74_soft_masks[16*s]);
+    hamming74_soft_masks_ready = 1;
+}
+
 // soft decoding of one symbol
 unsigned char fecsoft_hamming74_decode(unsigned char * _soft_bits)
 {
+    if (!hamming74_soft_masks_ready)
+        fecsoft_hamming74_init_masks();
+
     // find symbol with minimum distance from all 2^4 possible
-    unsigned int d;             // distance metric
-    unsigned int dmin = 0;      // minimum distance
-    unsigned char s_hat = 0;    // estimated transmitted symbol
-    unsigned char c;            // encoded symbol
-
-    unsigned char s;
-    for (s=0; s<16; s++) {
-        // encode symbol
-        c = hamming74_enc_gentab[s];
-
-        // compute distance metric
-        d = 0;
-        d += (c & 0x40) ? 255 - _soft_bits[0] : _soft_bits[0];
-        d += (c & 0x20) ? 255 - _soft_bits[1] : _soft_bits[1];
-        d += (c & 0x10) ? 255 - _soft_bits[2] : _soft_bits[2];
-        d += (c & 0x08) ? 255 - _soft_bits[3] : _soft_bits[3];
-        d += (c & 0x04) ? 255 - _soft_bits[4] : _soft_bits[4];
-        d += (c & 0x02) ? 255 - _soft_bits[5] : _soft_bits[5];
-        d += (c & 0x01) ? 255 - _soft_bits[6] : _soft_bits[6];
-
-        if (d < dmin || s==0) {
-            s_hat = s;
-            dmin = d;
-        }
-    }
-    return s_hat;
+    return fecsoft_nearest(_soft_bits, 7, hamming74_soft_masks, NULL, 16);
+}
+
+// soft decoding of a sequence of symbols
+void fecsoft_hamming74_decode_block(unsigned char * _soft_bits,
+                                    unsigned int    _num,
+                                    unsigned char * _sym)
+{
+    if (!hamming74_soft_masks_ready)
+        fecsoft_hamming74_init_masks();
+
+    fecsoft_nearest_block(_soft_bits, 7, _num, hamming74_soft_masks, NULL, 16, _sym);
 }
@@ -30,6 +30,10 @@
 
 #include "liquid.internal.h"
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>  // SSSE3
+#endif
+
 // encoder look-up table
 unsigned char hamming84_enc_gentab[16] = {
     0x00, 0xd2, 0x55, 0x87, 0x99, 0x4b, 0xcc, 0x1e,
@@ -70,6 +74,74 @@ unsigned char hamming84_dec_gentab[256] = {
     0x08, 0x08, 0x01, 0x01, 0x0a, 0x0a, 0x0f, 0x0f,
     0x0c, 0x0c, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f};
 
+#if defined(__SSSE3__)
+// Decoder table split into nibble look-ups for byte shuffles: for a
+// received byte r = (h<<4)|l the decoded symbol is
+//   DL[l] ^ DH[h] ^ F[SL[l] ^ SH[h]]
+// where SL/SH give the (syndrome, overall parity) of each nibble and F
+// maps those to the bit correction of the data nibble.
+static const unsigned char hamming84_ssse3_DL[16] = {
+    0x00, 0x00, 0x01, 0x01, 0x02, 0x02, 0x03, 0x03,
+    0x04, 0x04, 0x05, 0x05, 0x06, 0x06, 0x07, 0x07};
+static const unsigned char hamming84_ssse3_DH[16] = {
+    0x00, 0x00, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08,
+    0x00, 0x00, 0x08, 0x08, 0x00, 0x00, 0x08, 0x08};
+static const unsigned char hamming84_ssse3_SL[16] = {
+    0x00, 0x01, 0x0e, 0x0f, 0x07, 0x06, 0x09, 0x08,
+    0x0b, 0x0a, 0x05, 0x04, 0x0c, 0x0d, 0x02, 0x03};
+static const unsigned char hamming84_ssse3_SH[16] = {
+    0x00, 0x02, 0x0d, 0x0f, 0x04, 0x06, 0x09, 0x0b,
+    0x08, 0x0a, 0x05, 0x07, 0x0c, 0x0e, 0x01, 0x03};
+static const unsigned char hamming84_ssse3_F[16] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x02,
+    0x00, 0x00, 0x04, 0x04, 0x08, 0x08, 0x01, 0x01};
+
+// encode 16 bytes into 32 using byte shuffles
+static inline void fec_hamming84_encode_ssse3(const unsigned char * _msg_dec,
+                                              unsigned char *       _msg_enc)
+{
+    __m128i T   = _mm_loadu_si128((const __m128i*)hamming84_enc_gentab);
+    __m128i m0f = _mm_set1_epi8(0x0f);
+    __m128i x   = _mm_loadu_si128((const __m128i*)_msg_dec);
+    __m128i lo  = _mm_and_si128(x, m0f);
+    __m128i hi  = _mm_and_si128(_mm_srli_epi16(x, 4), m0f);
+    __m128i e0  = _mm_shuffle_epi8(T, hi);
+    __m128i e1  = _mm_shuffle_epi8(T, lo);
+    _mm_storeu_si128((__m128i*)(_msg_enc   ), _mm_unpacklo_epi8(e0, e1));
+    _mm_storeu_si128((__m128i*)(_msg_enc+16), _mm_unpackhi_epi8(e0, e1));
+}
+
+// decode 16 received bytes into 16 4-bit symbols, one per byte
+static inline __m128i fec_hamming84_decode_ssse3_step(__m128i _r)
+{
+    __m128i m0f = _mm_set1_epi8(0x0f);
+    __m128i lo  = _mm_and_si128(_r, m0f);
+    __m128i hi  = _mm_and_si128(_mm_srli_epi16(_r, 4), m0f);
+    __m128i s   = _mm_xor_si128(
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)hamming84_ssse3_SL), lo),
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)hamming84_ssse3_SH), hi));
+    __m128i d   = _mm_xor_si128(
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)hamming84_ssse3_DL), lo),
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)hamming84_ssse3_DH), hi));
+    return _mm_xor_si128(d,
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)hamming84_ssse3_F), s));
+}
+
+// decode 32 bytes into 16 using byte shuffles
+static inline void fec_hamming84_decode_ssse3(const unsigned char * _msg_enc,
+                                              unsigned char *       _msg_dec)
+{
+    __m128i d0 = fec_hamming84_decode_ssse3_step(_mm_loadu_si128((const __m128i*)(_msg_enc   )));
+    __m128i d1 = fec_hamming84_decode_ssse3_step(_mm_loadu_si128((const __m128i*)(_msg_enc+16)));
+
+    // combine symbol pairs: (d[2i] << 4) | d[2i+1]
+    __m128i w  = _mm_set1_epi16(0x0110);
+    __m128i p0 = _mm_maddubs_epi16(d0, w);
+    __m128i p1 = _mm_maddubs_epi16(d1, w);
+    _mm_storeu_si128((__m128i*)_msg_dec, _mm_packus_epi16(p0, p1));
+}
+#endif
+
 // create Hamming(8,4) codec object
 fec fec_hamming84_create(void * _opts)
 {
@@ -104,9 +176,15 @@ void fec_hamming84_encode(fec _q,
                           unsigned char *_msg_dec,
                           unsigned char *_msg_enc)
 {
-    unsigned int i, j=0;
+    unsigned int i=0, j=0;
     unsigned char s0, s1;
-    for (i=0; i<_dec_msg_len; i++) {
+#if defined(__SSSE3__)
+    if (liquid_cpu_has(LIQUID_CPU_SSSE3)) {
+        for ( ; i+16<=_dec_msg_len; i+=16, j+=32)
+            fec_hamming84_encode_ssse3(&_msg_dec[i], &_msg_enc[j]);
+    }
+#endif
+    for ( ; i<_dec_msg_len; i++) {
         s0 = (_msg_dec[i] >> 4) & 0x0f;
         s1 = (_msg_dec[i] >> 0) & 0x0f;
         _msg_enc[j+0] = hamming84_enc_gentab[s0];
@@ -128,11 +206,17 @@ void fec_hamming84_decode(fec _q,
                           unsigned char *_msg_enc,
                           unsigned char *_msg_dec)
 {
-    unsigned int i;
+    unsigned int i=0;
     unsigned char r0, r1;   // received 8-bit symbols
     unsigned char s0, s1;   // decoded 4-bit symbols
+#if defined(__SSSE3__)
+    if (liquid_cpu_has(LIQUID_CPU_SSSE3)) {
+        for ( ; i+16<=_dec_msg_len; i+=16)
+            fec_hamming84_decode_ssse3(&_msg_enc[2*i], &_msg_dec[i]);
+    }
+#endif
     //unsigned char num_errors=0;
-    for (i=0; i<_dec_msg_len; i++) {
+    for ( ; i<_dec_msg_len; i++) {
         r0 = _msg_enc[2*i+0] & 0xff;
         r1 = _msg_enc[2*i+1] & 0xff;
 
@@ -163,20 +247,19 @@ void fec_hamming84_decode_soft(fec _q,
     // compute encoded message length
     unsigned int enc_msg_len = fec_block_get_enc_msg_len(_dec_msg_len,4,8);
 
-    // decoded 4-bit symbols
-    unsigned char s0;
-    unsigned char s1;
-
-    //unsigned char num_errors=0;
-    for (i=0; i<_dec_msg_len; i++) {
-        s0 = fecsoft_hamming84_decode(&_msg_enc[k  ]);
-        s1 = fecsoft_hamming84_decode(&_msg_enc[k+8]);
-        k += 16;
+    // decoded 4-bit symbols, two per byte
+    unsigned char s[64];
+    unsigned int j;
+    unsigned int num;
 
-        // pack two 4-bit symbols into one 8-bit byte
-        _msg_dec[i] = (s0 << 4) | s1;
+    for (i=0; i<_dec_msg_len; i+=num) {
+        num = (_dec_msg_len - i < 32) ? _dec_msg_len - i : 32;
+        fecsoft_hamming84_decode_block(&_msg_enc[k], 2*num, s);
+        k += 16*num;
 
-        //printf("  %3u : 0x%.2x > 0x%.2x,  0x%.2x > 0x%.2x (k=%u)\n", i, r0, s0, r1, s1, k);
+        // pack pairs of 4-bit symbols into 8-bit bytes
+        for (j=0; j<num; j++)
+            _msg_dec[i+j] = (s[2*j] << 4) | s[2*j+1];
     }
     assert(k == 8*enc_msg_len);
     //return num_errors;
@@ -186,35 +269,39 @@ void fec_hamming84_decode_soft(fec _q,
 // internal methods
 //
 
+// codeword masks for soft-decision decoding (see fecsoft_nearest),
+// built when the library is loaded
+static unsigned char hamming84_soft_masks[16*16];
+static int           hamming84_soft_masks_ready = 0;
+
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void fecsoft_hamming84_init_masks(void)
+{
+    unsigned int s;
+    for (s=0; s<16; s++)
+        fecsoft_codeword_mask(hamming84_enc_gentab[s], 8, &hamming84_soft_masks[16*s]);
+    hamming84_soft_masks_ready = 1;
+}
+
 // soft decoding of one symbol
 unsigned char fecsoft_hamming84_decode(unsigned char * _soft_bits)
 {
+    if (!hamming84_soft_masks_ready)
+        fecsoft_hamming84_init_masks();
+
     // find symbol with minimum distance from all 2^4 possible
-    unsigned int d;             // distance metric
-    unsigned int dmin = 0;      // minimum distance
-    unsigned char s_hat = 0;    // estimated transmitted symbol
-    unsigned char c;            // encoded symbol
-
-    unsigned char s;
-    for (s=0; s<16; s++) {
-        // encode symbol
-        c = hamming84_enc_gentab[s];
-
-        // compute distance metric
-        d = 0;
-        d += (c & 0x80) ? 255 - _soft_bits[0] : _soft_bits[0];
-        d += (c & 0x40) ? 255 - _soft_bits[1] : _soft_bits[1];
-        d += (c & 0x20) ? 255 - _soft_bits[2] : _soft_bits[2];
-        d += (c & 0x10) ? 255 - _soft_bits[3] : _soft_bits[3];
-        d += (c & 0x08) ? 255 - _soft_bits[4] : _soft_bits[4];
-        d += (c & 0x04) ? 255 - _soft_bits[5] : _soft_bits[5];
-        d += (c & 0x02) ? 255 - _soft_bits[6] : _soft_bits[6];
-        d += (c & 0x01) ? 255 - _soft_bits[7] : _soft_bits[7];
-
-        if (d < dmin || s==0) {
-            s_hat = s;
-            dmin = d;
-        }
-    }
-    return s_hat;
+    return fecsoft_nearest(_soft_bits, 8, hamming84_soft_masks, NULL, 16);
+}
+
+// soft decoding of a sequence of symbols
+void fecsoft_hamming84_decode_block(unsigned char * _soft_bits,
+                                    unsigned int    _num,
+                                    unsigned char * _sym)
+{
+    if (!hamming84_soft_masks_ready)
+        fecsoft_hamming84_init_masks();
+
+    fecsoft_nearest_block(_soft_bits, 8, _num, hamming84_soft_masks, NULL, 16, _sym);
 }
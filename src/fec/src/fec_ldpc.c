@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// quasi-cyclic LDPC codes
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+// LLR of message bits removed by shortening (known zeros)
+#define FEC_LDPC_LLR_KNOWN  (32767)
+
+fec fec_ldpc_create(fec_scheme _fs)
+{
+    fec q = (fec) malloc(sizeof(struct fec_s));
+
+    q->scheme = _fs;
+    q->rate = fec_get_rate(q->scheme);
+
+    q->encode_func      = &fec_ldpc_encode;
+    q->decode_func      = &fec_ldpc_decode_hard;
+    q->decode_soft_func = &fec_ldpc_decode_soft;
+
+    switch (q->scheme) {
+    case LIQUID_FEC_LDPC_N648:  q->lp = fec_ldpc_code_create(12, 24, 27, fec_ldpc648_base);  break;
+    case LIQUID_FEC_LDPC_N1296: q->lp = fec_ldpc_code_create(12, 24, 54, fec_ldpc1296_base); break;
+    case LIQUID_FEC_LDPC_N1944: q->lp = fec_ldpc_code_create(12, 24, 81, fec_ldpc1944_base); break;
+    default:
+        fprintf(stderr,"error: fec_ldpc_create(), invalid type\n");
+        exit(1);
+    }
+
+    return q;
+}
+
+void fec_ldpc_destroy(fec _q)
+{
+    fec_ldpc_code_destroy(_q->lp);
+    free(_q);
+}
+
+// compute encoded message length for LDPC codes
+unsigned int fec_ldpc_get_enc_msg_len(unsigned int _dec_msg_len,
+                                      unsigned int _n,
+                                      unsigned int _k)
+{
+    unsigned int num_bits_in  = 8*_dec_msg_len;
+    unsigned int num_blocks   = (num_bits_in + _k - 1) / _k;
+    unsigned int num_bits_out = num_bits_in + num_blocks*(_n - _k);
+    return num_bits_out/8 + (num_bits_out%8 ? 1 : 0);
+}
+
+// number of message bits carried by block _b of _num_blocks
+static unsigned int fec_ldpc_block_len(unsigned int _num_bits,
+                                       unsigned int _num_blocks,
+                                       unsigned int _b)
+{
+    return _num_bits / _num_blocks + (_b < _num_bits % _num_blocks ? 1 : 0);
+}
+
+void fec_ldpc_encode(fec _q,
+                     unsigned int _dec_msg_len,
+                     unsigned char *_msg_dec,
+                     unsigned char *_msg_enc)
+{
+    unsigned int n = fec_ldpc_code_get_n(_q->lp);
+    unsigned int k = fec_ldpc_code_get_k(_q->lp);
+    unsigned int num_bits   = 8*_dec_msg_len;
+    unsigned int num_blocks = (num_bits + k - 1) / k;
+    memset(_msg_enc, 0x00, fec_ldpc_get_enc_msg_len(_dec_msg_len, n, k));
+
+    unsigned char msg[k];   // message bits
+    unsigned char cw[n];    // codeword bits
+    unsigned int b, i;
+    unsigned int i0 = 0;    // input bit counter
+    unsigned int j  = 0;    // output bit counter
+    for (b=0; b<num_blocks; b++) {
+        // shortened message: zero-pad to full block
+        unsigned int kb = fec_ldpc_block_len(num_bits, num_blocks, b);
+        for (i=0; i<kb; i++, i0++)
+            msg[i] = (_msg_dec[i0/8] >> (7-(i0%8))) & 1;
+        memset(&msg[kb], 0x00, (k-kb)*sizeof(unsigned char));
+
+        fec_ldpc_code_encode(_q->lp, msg, cw);
+
+        // transmit message bits and parity, skipping padding
+        for (i=0; i<n; i++) {
+            if (i >= kb && i < k)
+                continue;
+            _msg_enc[j/8] |= cw[i] << (7-(j%8));
+            j++;
+        }
+    }
+}
+
+// decode from either packed bits or soft bits
+static void fec_ldpc_decode(fec             _q,
+                            unsigned int    _dec_msg_len,
+                            unsigned char * _msg_enc,
+                            unsigned char * _msg_dec,
+                            int             _soft)
+{
+    unsigned int n = fec_ldpc_code_get_n(_q->lp);
+    unsigned int k = fec_ldpc_code_get_k(_q->lp);
+    unsigned int num_bits   = 8*_dec_msg_len;
+    unsigned int num_blocks = (num_bits + k - 1) / k;
+    memset(_msg_dec, 0x00, _dec_msg_len);
+
+    int16_t llr[n];         // log-likelihood ratios
+    unsigned char msg[k];   // decoded message bits
+    unsigned int b, i;
+    unsigned int i0 = 0;    // output bit counter
+    unsigned int j  = 0;    // input bit counter
+    for (b=0; b<num_blocks; b++) {
+        unsigned int kb = fec_ldpc_block_len(num_bits, num_blocks, b);
+        for (i=0; i<n; i++) {
+            if (i >= kb && i < k) {
+                llr[i] = FEC_LDPC_LLR_KNOWN;
+                continue;
+            }
+            unsigned int v = _soft ? _msg_enc[j] :
+                             ((_msg_enc[j/8] >> (7-(j%8))) & 1) * LIQUID_SOFTBIT_1;
+            llr[i] = 255 - 2*(int)v;
+            j++;
+        }
+
+        fec_ldpc_code_decode(_q->lp, llr, msg);
+
+        for (i=0; i<kb; i++, i0++)
+            _msg_dec[i0/8] |= msg[i] << (7-(i0%8));
+    }
+}
+
+void fec_ldpc_decode_hard(fec _q,
+                          unsigned int _dec_msg_len,
+                          unsigned char *_msg_enc,
+                          unsigned char *_msg_dec)
+{
+    fec_ldpc_decode(_q, _dec_msg_len, _msg_enc, _msg_dec, 0);
+}
+
+void fec_ldpc_decode_soft(fec _q,
+                          unsigned int _dec_msg_len,
+                          unsigned char *_msg_enc,
+                          unsigned char *_msg_dec)
+{
+    fec_ldpc_decode(_q, _dec_msg_len, _msg_enc, _msg_dec, 1);
+}
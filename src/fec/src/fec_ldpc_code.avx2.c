@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fec_ldpc_code.avx2.c : LDPC check-node layer update (AVX2)
+//
+// This file is compiled with -mavx2 regardless of the build host; the
+// kernel is only called when the processor reports support for AVX2
+// at run time. Results are bit-exact with fec_ldpc_layer_port().
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX2
+
+// AVX2 check-node update, sixteen check nodes at a time
+void fec_ldpc_layer_avx2(int16_t *    _t,
+                         int16_t *    _r,
+                         unsigned int _dc,
+                         unsigned int _Zp,
+                         int16_t      _offset)
+{
+    __m256i zero   = _mm256_setzero_si256();
+    __m256i offset = _mm256_set1_epi16(_offset);
+    unsigned int c, e;
+    for (c=0; c<_Zp; c+=16) {
+        // variable-to-check messages; two smallest magnitudes, index of
+        // the smallest, and the parity of the signs
+        __m256i min1 = _mm256_set1_epi16(32767);
+        __m256i min2 = min1;
+        __m256i idx  = zero;
+        __m256i sgn  = zero;
+        for (e=0; e<_dc; e++) {
+            __m256i * t = (__m256i*)&_t[e*_Zp+c];
+            __m256i   v = _mm256_subs_epi16(_mm256_load_si256(t), _mm256_load_si256((__m256i*)&_r[e*_Zp+c]));
+            __m256i   a = _mm256_max_epi16(v, _mm256_subs_epi16(zero, v));
+            _mm256_store_si256(t, v);
+            sgn = _mm256_xor_si256(sgn, v);
+
+            __m256i lt = _mm256_cmpgt_epi16(min1, a);
+            min2 = _mm256_min_epi16(min2, _mm256_max_epi16(min1, a));
+            min1 = _mm256_min_epi16(min1, a);
+            idx  = _mm256_blendv_epi8(idx, _mm256_set1_epi16(e), lt);
+        }
+
+        // offset magnitudes
+        min1 = _mm256_max_epi16(_mm256_subs_epi16(min1, offset), zero);
+        min2 = _mm256_max_epi16(_mm256_subs_epi16(min2, offset), zero);
+
+        // check-to-variable messages and updated a posteriori LLRs
+        for (e=0; e<_dc; e++) {
+            __m256i * t   = (__m256i*)&_t[e*_Zp+c];
+            __m256i   v   = _mm256_load_si256(t);
+            __m256i   sel = _mm256_cmpeq_epi16(idx, _mm256_set1_epi16(e));
+            __m256i   m   = _mm256_blendv_epi8(min1, min2, sel);
+            __m256i   r   = _mm256_sign_epi16(m, _mm256_or_si256(_mm256_xor_si256(sgn, v), _mm256_set1_epi16(1)));
+            _mm256_store_si256((__m256i*)&_r[e*_Zp+c], r);
+            _mm256_store_si256(t, _mm256_adds_epi16(v, r));
+        }
+    }
+}
@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fec_ldpc_code.c
+//
+// Quasi-cyclic LDPC code with a dual-diagonal parity structure (e.g.
+// IEEE 802.11n). The parity-check matrix H is described by a base
+// matrix of cyclic shifts: block (i,j) with shift s has a one in row
+// c at column (c+s) mod Z. Encoding is linear-time using the
+// dual-diagonal structure. Decoding is layered offset min-sum over
+// 16-bit log-likelihood ratios: each block row is a layer of Z check
+// nodes that share the same structure, so the check-node update is
+// run across all Z checks at once by the portable, SSE2 or AVX2
+// kernel (bit-exact with one another) selected at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define DEBUG_FEC_LDPC_CODE     0
+
+// maximum number of decoding iterations
+#define FEC_LDPC_MAX_ITERATIONS (20)
+
+// min-sum magnitude offset (LLR units; soft bits map to [-255,255])
+#define FEC_LDPC_OFFSET         (24)
+
+// saturate to 16-bit signed range
+#define FEC_LDPC_SAT(_v) ((_v) > 32767 ? 32767 : ((_v) < -32768 ? -32768 : (_v)))
+
+struct fec_ldpc_code_s {
+    unsigned int mb;            // number of block rows (layers)
+    unsigned int nb;            // number of block columns
+    unsigned int Z;             // lifting size
+    unsigned int Zp;            // lifting size, padded to vector length
+    unsigned int n;             // codeword length, nb*Z
+    unsigned int k;             // message length, (nb-mb)*Z
+    unsigned int x;             // row of the zero shift in first parity column
+    unsigned int s0;            // shift of first/last row in first parity column
+    smatrixb H;                 // parity-check matrix [n-k x n]
+
+    // compressed layer layout (non-zero blocks in each block row)
+    unsigned int num_edges;     // number of non-zero blocks
+    unsigned int * layer;       // first block of each layer [mb+1]
+    unsigned int * col;         // block column of each block [num_edges]
+    unsigned int * shift;       // cyclic shift of each block [num_edges]
+    unsigned int max_degree;    // maximum number of blocks in a layer
+
+    // decoder state (aligned)
+    int16_t * L;                // a posteriori LLRs [n]
+    int16_t * R;                // check-to-variable messages [num_edges x Zp]
+    int16_t * T;                // layer working buffer [max_degree x Zp]
+    int16_t * S;                // syndrome accumulator [Zp]
+    unsigned char * p;          // encoder working buffer [Z]
+
+    // check-node layer kernel
+    fec_ldpc_layer_func update;
+};
+
+// allocate memory aligned to 32 bytes for vector loads/stores
+static void * fec_ldpc_code_malloc(size_t _n)
+{
+    void * p = NULL;
+    if (posix_memalign(&p, 32, _n) != 0) {
+        fprintf(stderr,"error: fec_ldpc_code_create(), could not allocate memory\n");
+        exit(1);
+    }
+    memset(p, 0x00, _n);
+    return p;
+}
+
+// create quasi-cyclic LDPC code
+//  _mb     :   number of block rows
+//  _nb     :   number of block columns, _nb > _mb
+//  _Z      :   lifting size
+//  _base   :   base matrix of shifts, -1 for zero blocks [size: _mb x _nb]
+fec_ldpc_code fec_ldpc_code_create(unsigned int _mb,
+                                   unsigned int _nb,
+                                   unsigned int _Z,
+                                   short int *  _base)
+{
+    // validate input
+    if (_mb < 2 || _nb <= _mb) {
+        fprintf(stderr,"error: fec_ldpc_code_create(), invalid base matrix dimensions (%u x %u)\n", _mb, _nb);
+        exit(1);
+    } else if (_Z == 0) {
+        fprintf(stderr,"error: fec_ldpc_code_create(), lifting size must be greater than zero\n");
+        exit(1);
+    }
+
+    unsigned int i, j;
+    unsigned int kb = _nb - _mb;
+    for (i=0; i<_mb*_nb; i++) {
+        if (_base[i] >= (int)_Z) {
+            fprintf(stderr,"error: fec_ldpc_code_create(), shift %d exceeds lifting size %u\n", _base[i], _Z);
+            exit(1);
+        }
+    }
+
+    // validate dual-diagonal parity structure: first parity column has
+    // equal shifts in the first and last rows and a zero shift in one
+    // other row; remaining parity columns form an unshifted staircase
+    unsigned int x = 0;
+    int valid = _base[kb] >= 0 && _base[kb] == _base[(_mb-1)*_nb + kb];
+    for (i=1; i<_mb-1; i++) {
+        int s = _base[i*_nb + kb];
+        if (s == 0 && x == 0) x = i;
+        else if (s >= 0)      valid = 0;
+    }
+    if (x == 0) valid = 0;
+    for (j=1; j<_mb; j++) {
+        for (i=0; i<_mb; i++) {
+            int s = _base[i*_nb + kb + j];
+            if (i == j-1 || i == j) valid &= (s == 0);
+            else                    valid &= (s <  0);
+        }
+    }
+    if (!valid) {
+        fprintf(stderr,"error: fec_ldpc_code_create(), base matrix parity part is not dual diagonal\n");
+        exit(1);
+    }
+
+    fec_ldpc_code q = (fec_ldpc_code) malloc(sizeof(struct fec_ldpc_code_s));
+    q->mb = _mb;
+    q->nb = _nb;
+    q->Z  = _Z;
+    q->Zp = (_Z + 15) & ~15u;
+    q->n  = _nb*_Z;
+    q->k  = kb*_Z;
+    q->x  = x;
+    q->s0 = _base[kb];
+
+    // layer layout
+    q->num_edges = 0;
+    for (i=0; i<_mb*_nb; i++)
+        q->num_edges += _base[i] >= 0 ? 1 : 0;
+    q->layer = (unsigned int*) malloc((_mb+1)*sizeof(unsigned int));
+    q->col   = (unsigned int*) malloc(q->num_edges*sizeof(unsigned int));
+    q->shift = (unsigned int*) malloc(q->num_edges*sizeof(unsigned int));
+    q->max_degree = 0;
+    unsigned int e = 0;
+    for (i=0; i<_mb; i++) {
+        q->layer[i] = e;
+        for (j=0; j<_nb; j++) {
+            if (_base[i*_nb + j] < 0)
+                continue;
+            q->col[e]   = j;
+            q->shift[e] = _base[i*_nb + j];
+            e++;
+        }
+        if (e - q->layer[i] > q->max_degree)
+            q->max_degree = e - q->layer[i];
+    }
+    q->layer[_mb] = e;
+
+    // expand parity-check matrix
+    q->H = smatrixb_create(q->n - q->k, q->n);
+    unsigned int c;
+    for (i=0; i<_mb; i++) {
+        for (e=q->layer[i]; e<q->layer[i+1]; e++) {
+            for (c=0; c<_Z; c++)
+                smatrixb_set(q->H, i*_Z + c, q->col[e]*_Z + (c + q->shift[e]) % _Z, 1);
+        }
+    }
+
+    // decoder state
+    q->L = (int16_t*) fec_ldpc_code_malloc(q->n*sizeof(int16_t));
+    q->R = (int16_t*) fec_ldpc_code_malloc(q->num_edges*q->Zp*sizeof(int16_t));
+    q->T = (int16_t*) fec_ldpc_code_malloc(q->max_degree*q->Zp*sizeof(int16_t));
+    q->S = (int16_t*) fec_ldpc_code_malloc(q->Zp*sizeof(int16_t));
+    q->p = (unsigned char*) malloc(_Z*sizeof(unsigned char));
+
+    // select check-node kernel
+    q->update = fec_ldpc_layer_port;
+#if defined(__SSE2__)
+    if (liquid_cpu_has(LIQUID_CPU_SSE2))
+        q->update = fec_ldpc_layer_sse2;
+#endif
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2))
+        q->update = fec_ldpc_layer_avx2;
+#endif
+
+    return q;
+}
+
+// destroy LDPC code object, freeing all internal memory
+void fec_ldpc_code_destroy(fec_ldpc_code _q)
+{
+    smatrixb_destroy(_q->H);
+    free(_q->layer);
+    free(_q->col);
+    free(_q->shift);
+    free(_q->L);
+    free(_q->R);
+    free(_q->T);
+    free(_q->S);
+    free(_q->p);
+    free(_q);
+}
+
+// print LDPC code object
+void fec_ldpc_code_print(fec_ldpc_code _q)
+{
+    printf("fec_ldpc_code [n=%u, k=%u, Z=%u, base=%u x %u, edges=%u]\n",
+            _q->n, _q->k, _q->Z, _q->mb, _q->nb, _q->num_edges*_q->Z);
+}
+
+// get codeword length (bits)
+unsigned int fec_ldpc_code_get_n(fec_ldpc_code _q)
+{
+    return _q->n;
+}
+
+// get message length (bits)
+unsigned int fec_ldpc_code_get_k(fec_ldpc_code _q)
+{
+    return _q->k;
+}
+
+// get parity-check matrix
+smatrixb fec_ldpc_code_get_H(fec_ldpc_code _q)
+{
+    return _q->H;
+}
+
+// encode block, codeword is systematic: message followed by parity
+//  _q      :   LDPC code object
+//  _msg    :   message bits [size: k x 1]
+//  _cw     :   codeword bits [size: n x 1]
+void fec_ldpc_code_encode(fec_ldpc_code   _q,
+                          unsigned char * _msg,
+                          unsigned char * _cw)
+{
+    unsigned int Z  = _q->Z;
+    unsigned int mb = _q->mb;
+    unsigned int kb = _q->nb - mb;
+    unsigned int i, c, e;
+
+    // lambda[i] = sum of shifted message blocks in row i, stored in
+    // the parity part of the codeword; p0 = sum of all lambda[i]
+    unsigned char * lambda = &_cw[_q->k];
+    unsigned char * p0     = _q->p;
+    memmove(_cw, _msg, _q->k*sizeof(unsigned char));
+    memset(lambda, 0x00, mb*Z*sizeof(unsigned char));
+    memset(p0,     0x00, Z*sizeof(unsigned char));
+    for (i=0; i<mb; i++) {
+        unsigned char * l = &lambda[i*Z];
+        for (e=_q->layer[i]; e<_q->layer[i+1] && _q->col[e] < kb; e++) {
+            unsigned char * u = &_msg[_q->col[e]*Z];
+            unsigned int    s = _q->shift[e];
+            for (c=0; c<Z-s; c++) l[c]       ^= u[c+s];
+            for (c=0; c<s;   c++) l[Z-s+c]   ^= u[c];
+        }
+        for (c=0; c<Z; c++)
+            p0[c] ^= l[c];
+    }
+
+    // staircase: p[1] = lambda[0] + P^s p[0]; p[i+1] = p[i] + lambda[i]
+    // (+ p[0] in row x); parity blocks overwrite lambda in place
+    unsigned char * p = lambda;
+    unsigned char carry[Z];
+    for (c=0; c<Z; c++)
+        carry[c] = p[c] ^ p0[(c+_q->s0)%Z];
+    memmove(p, p0, Z*sizeof(unsigned char));
+    for (i=1; i<mb; i++) {
+        // p[i] = carry; carry = p[i] + lambda[i] (+ p0)
+        for (c=0; c<Z; c++) {
+            unsigned char v = carry[c];
+            carry[c] ^= p[i*Z+c] ^ (i == _q->x ? p0[c] : 0);
+            p[i*Z+c] = v;
+        }
+    }
+}
+
+// compute syndrome from the signs of the a posteriori LLRs, returning
+// 1 if all parity checks pass, 0 otherwise
+static int fec_ldpc_code_check(fec_ldpc_code _q)
+{
+    unsigned int Z = _q->Z;
+    unsigned int i, c, e;
+    for (i=0; i<_q->mb; i++) {
+        // the sign of the xor over all blocks in the layer is the
+        // parity of the hard decisions for each check
+        int16_t * S = _q->S;
+        memset(S, 0x00, Z*sizeof(int16_t));
+        for (e=_q->layer[i]; e<_q->layer[i+1]; e++) {
+            int16_t *    L = &_q->L[_q->col[e]*Z];
+            unsigned int s = _q->shift[e];
+            for (c=0; c<Z-s; c++) S[c]     ^= L[c+s];
+            for (c=0; c<s;   c++) S[Z-s+c] ^= L[c];
+        }
+        int16_t v = 0;
+        for (c=0; c<Z; c++)
+            v |= S[c];
+        if (v < 0)
+            return 0;
+    }
+    return 1;
+}
+
+// decode block using layered offset min-sum
+//  _q      :   LDPC code object
+//  _llr    :   input LLRs, positive values favor 0 [size: n x 1]
+//  _msg    :   decoded message bits [size: k x 1]
+//  returns 1 if all parity checks pass, 0 otherwise
+int fec_ldpc_code_decode(fec_ldpc_code _q,
+                         int16_t *     _llr,
+                         unsigned char * _msg)
+{
+    unsigned int Z  = _q->Z;
+    unsigned int Zp = _q->Zp;
+    unsigned int i, c, e, it;
+
+    memmove(_q->L, _llr, _q->n*sizeof(int16_t));
+    memset(_q->R, 0x00, _q->num_edges*Zp*sizeof(int16_t));
+
+    int pass = 0;
+    for (it=0; ; it++) {
+        // early termination
+        if ( (pass = fec_ldpc_code_check(_q)) || it == FEC_LDPC_MAX_ITERATIONS )
+            break;
+
+        for (i=0; i<_q->mb; i++) {
+            unsigned int e0 = _q->layer[i];
+            unsigned int dc = _q->layer[i+1] - e0;
+
+            // gather rotated blocks so each lane holds one check node
+            for (e=0; e<dc; e++) {
+                int16_t *    T = &_q->T[e*Zp];
+                int16_t *    L = &_q->L[_q->col[e0+e]*Z];
+                unsigned int s = _q->shift[e0+e];
+                memmove(T,       &L[s], (Z-s)*sizeof(int16_t));
+                memmove(&T[Z-s], L,     s*sizeof(int16_t));
+            }
+
+            // update all checks in the layer
+            _q->update(_q->T, &_q->R[e0*Zp], dc, Zp, FEC_LDPC_OFFSET);
+
+            // scatter updated a posteriori LLRs
+            for (e=0; e<dc; e++) {
+                int16_t *    T = &_q->T[e*Zp];
+                int16_t *    L = &_q->L[_q->col[e0+e]*Z];
+                unsigned int s = _q->shift[e0+e];
+                memmove(&L[s], T,       (Z-s)*sizeof(int16_t));
+                memmove(L,     &T[Z-s], s*sizeof(int16_t));
+            }
+        }
+    }
+#if DEBUG_FEC_LDPC_CODE
+    printf("fec_ldpc_code_decode(), %s after %u iterations\n", pass ? "pass" : "FAIL", it);
+#endif
+
+    // hard decisions on message bits
+    for (c=0; c<_q->k; c++)
+        _msg[c] = _q->L[c] < 0 ? 1 : 0;
+
+    return pass;
+}
+
+// portable check-node update for one layer, one lane per check node
+//  _t      :   a posteriori LLRs of each block [size: _dc x _Zp]
+//  _r      :   check-to-variable messages of each block [size: _dc x _Zp]
+//  _dc     :   number of blocks in layer (check node degree)
+//  _Zp     :   number of lanes (padded lifting size)
+//  _offset :   min-sum magnitude offset
+void fec_ldpc_layer_port(int16_t *    _t,
+                         int16_t *    _r,
+                         unsigned int _dc,
+                         unsigned int _Zp,
+                         int16_t      _offset)
+{
+    unsigned int c, e;
+    for (c=0; c<_Zp; c++) {
+        // variable-to-check messages; two smallest magnitudes and the
+        // parity of the signs
+        int min1 = 32767, min2 = 32767, idx = 0, sgn = 0;
+        for (e=0; e<_dc; e++) {
+            int v = FEC_LDPC_SAT(_t[e*_Zp+c] - _r[e*_Zp+c]);
+            int a = v < 0 ? FEC_LDPC_SAT(-v) : v;
+            _t[e*_Zp+c] = v;
+            sgn ^= v;
+            if (a < min1) {
+                min2 = min1;
+                min1 = a;
+                idx  = e;
+            } else if (a < min2) {
+                min2 = a;
+            }
+        }
+
+        // offset magnitudes
+        min1 = min1 > _offset ? min1 - _offset : 0;
+        min2 = min2 > _offset ? min2 - _offset : 0;
+
+        // check-to-variable messages and updated a posteriori LLRs
+        for (e=0; e<_dc; e++) {
+            int v = _t[e*_Zp+c];
+            int m = e == idx ? min2 : min1;
+            int r = (sgn ^ v) < 0 ? -m : m;
+            _r[e*_Zp+c] = r;
+            _t[e*_Zp+c] = FEC_LDPC_SAT(v + r);
+        }
+    }
+}
+
+#if defined(__SSE2__)
+// SSE2 check-node update, eight check nodes at a time
+void fec_ldpc_layer_sse2(int16_t *    _t,
+                         int16_t *    _r,
+                         unsigned int _dc,
+                         unsigned int _Zp,
+                         int16_t      _offset)
+{
+    __m128i zero   = _mm_setzero_si128();
+    __m128i offset = _mm_set1_epi16(_offset);
+    unsigned int c, e;
+    for (c=0; c<_Zp; c+=8) {
+        __m128i min1 = _mm_set1_epi16(32767);
+        __m128i min2 = min1;
+        __m128i idx  = zero;
+        __m128i sgn  = zero;
+        for (e=0; e<_dc; e++) {
+            __m128i * t = (__m128i*)&_t[e*_Zp+c];
+            __m128i   v = _mm_subs_epi16(_mm_load_si128(t), _mm_load_si128((__m128i*)&_r[e*_Zp+c]));
+            __m128i   a = _mm_max_epi16(v, _mm_subs_epi16(zero, v));
+            _mm_store_si128(t, v);
+            sgn = _mm_xor_si128(sgn, v);
+
+            __m128i lt = _mm_cmplt_epi16(a, min1);
+            min2 = _mm_min_epi16(min2, _mm_max_epi16(min1, a));
+            min1 = _mm_min_epi16(min1, a);
+            idx  = _mm_or_si128(_mm_andnot_si128(lt, idx), _mm_and_si128(lt, _mm_set1_epi16(e)));
+        }
+
+        min1 = _mm_max_epi16(_mm_subs_epi16(min1, offset), zero);
+        min2 = _mm_max_epi16(_mm_subs_epi16(min2, offset), zero);
+
+        for (e=0; e<_dc; e++) {
+            __m128i * t   = (__m128i*)&_t[e*_Zp+c];
+            __m128i   v   = _mm_load_si128(t);
+            __m128i   sel = _mm_cmpeq_epi16(idx, _mm_set1_epi16(e));
+            __m128i   m   = _mm_or_si128(_mm_andnot_si128(sel, min1), _mm_and_si128(sel, min2));
+            __m128i   neg = _mm_srai_epi16(_mm_xor_si128(sgn, v), 15);
+            __m128i   r   = _mm_sub_epi16(_mm_xor_si128(m, neg), neg);
+            _mm_store_si128((__m128i*)&_r[e*_Zp+c], r);
+            _mm_store_si128(t, _mm_adds_epi16(v, r));
+        }
+    }
+}
+#endif
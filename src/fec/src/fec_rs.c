@@ -21,7 +21,7 @@
  */
 
 //
-// Reed-Solomon (macros)
+// Reed-Solomon codes over GF(256)
 //
 
 #include <stdio.h>
@@ -31,17 +31,612 @@
 
 #include "liquid.internal.h"
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>  // SSSE3
+#endif
+
 #define VERBOSE_FEC_RS    0
 
-#if LIBFEC_ENABLED
-#include "fec.h"
+// number of codewords whose syndromes and error positions are computed
+// together (one per byte lane)
+#define FEC_RSCODEC_BATCH (16)
+
+// Reed-Solomon codec over GF(2^8), compatible with libfec's
+// encode_rs_char()/decode_rs_char(): codewords are the data symbols
+// followed by nroots parity symbols, the generator polynomial has roots
+// beta^(fcr+i), i=0..nroots-1, with beta = alpha^prim. Shortened codes
+// (fewer than 255-nroots data symbols) are handled by the block length.
+struct fec_rscodec_s {
+    unsigned int gfpoly;            // field generator polynomial
+    unsigned int fcr;               // first consecutive root (log)
+    unsigned int prim;              // primitive element (log)
+    unsigned int nroots;            // number of parity symbols
+
+    unsigned char alpha_to[512];    // antilog table (doubled)
+    unsigned char index_of[256];    // log table
+    unsigned char * genpoly;        // generator polynomial [nroots+1]
+
+    // encoder feedback table: row f holds f times the generator
+    // coefficients, aligned with the parity shift register
+    unsigned int    rowlen;         // row length, multiple of 16
+    unsigned char * enc_tab;        // [256 x rowlen]
+
+    // Chien search: nibble tables for multiplying the i-th term by
+    // beta^(-16 i), i=1..nroots/2
+    unsigned char * chien_tab;      // [(nroots/2+1) x 32]
+
+    // syndromes: nibble tables for multiplying by beta^(fcr+i),
+    // i=0..nroots-1
+    unsigned char * syn_tab;        // [nroots x 32]
+};
+
+// multiply two field elements
+static inline unsigned char fec_rscodec_mul(fec_rscodec   _q,
+                                            unsigned char _a,
+                                            unsigned char _b)
+{
+    if (_a == 0 || _b == 0)
+        return 0;
+    return _q->alpha_to[_q->index_of[_a] + _q->index_of[_b]];
+}
+
+// beta^_k as a field element
+static inline unsigned char fec_rscodec_beta(fec_rscodec _q,
+                                             int         _k)
+{
+    int e = (_k * (int)_q->prim) % 255;
+    return _q->alpha_to[e < 0 ? e + 255 : e];
+}
+
+// create Reed-Solomon codec
+//  _gfpoly     :   field generator polynomial, e.g. 0x11d
+//  _fcr        :   first consecutive root of the generator polynomial
+//  _prim       :   primitive element used to generate roots
+//  _nroots     :   number of parity symbols, 0 < _nroots < 255
+fec_rscodec fec_rscodec_create(unsigned int _gfpoly,
+                               unsigned int _fcr,
+                               unsigned int _prim,
+                               unsigned int _nroots)
+{
+    // validate input
+    if (_gfpoly < 0x100 || _gfpoly > 0x1ff) {
+        fprintf(stderr,"error: fec_rscodec_create(), field polynomial must have degree 8\n");
+        exit(1);
+    } else if (_nroots == 0 || _nroots >= 255) {
+        fprintf(stderr,"error: fec_rscodec_create(), number of roots must be in [1,254]\n");
+        exit(1);
+    } else if (_fcr >= 255) {
+        fprintf(stderr,"error: fec_rscodec_create(), first consecutive root must be less than 255\n");
+        exit(1);
+    } else if (_prim == 0 || _prim >= 255 || (_prim % 3)==0 || (_prim % 5)==0 || (_prim % 17)==0) {
+        fprintf(stderr,"error: fec_rscodec_create(), primitive element must be coprime to 255\n");
+        exit(1);
+    }
+
+    fec_rscodec q = (fec_rscodec) malloc(sizeof(struct fec_rscodec_s));
+    q->gfpoly = _gfpoly;
+    q->fcr    = _fcr;
+    q->prim   = _prim;
+    q->nroots = _nroots;
+
+    // log/antilog tables
+    unsigned int i, j, x = 1;
+    q->index_of[0] = 0;
+    for (i=0; i<255; i++) {
+        q->alpha_to[i] = x;
+        q->index_of[x] = i;
+        x <<= 1;
+        if (x & 0x100)
+            x ^= _gfpoly;
+    }
+    if (x != 1) {
+        fprintf(stderr,"error: fec_rscodec_create(), field polynomial 0x%.3x is not primitive\n", _gfpoly);
+        exit(1);
+    }
+    for (i=255; i<512; i++)
+        q->alpha_to[i] = q->alpha_to[i-255];
+
+    // generator polynomial, g[0] is the constant term:
+    //  g(x) = prod_{i=0}^{nroots-1} (x + beta^(fcr+i))
+    q->genpoly = (unsigned char*) calloc(_nroots+1, sizeof(unsigned char));
+    q->genpoly[0] = 1;
+    for (i=0; i<_nroots; i++) {
+        unsigned char r = fec_rscodec_beta(q, _fcr+i);
+        for (j=i+1; j>0; j--)
+            q->genpoly[j] = q->genpoly[j-1] ^ fec_rscodec_mul(q, q->genpoly[j], r);
+        q->genpoly[0] = fec_rscodec_mul(q, q->genpoly[0], r);
+    }
+
+    // encoder feedback table
+    q->rowlen  = _nroots <= 32 ? 32 : 16*((_nroots+15)/16);
+    q->enc_tab = (unsigned char*) calloc(256*q->rowlen, sizeof(unsigned char));
+    for (i=0; i<256; i++) {
+        for (j=0; j<_nroots; j++)
+            q->enc_tab[i*q->rowlen + j] = fec_rscodec_mul(q, i, q->genpoly[_nroots-1-j]);
+    }
+
+    // Chien search tables
+    q->chien_tab = (unsigned char*) calloc((_nroots/2+1)*32, sizeof(unsigned char));
+    for (i=1; i<=_nroots/2; i++) {
+        unsigned char c = fec_rscodec_beta(q, -16*(int)i);
+        for (x=0; x<16; x++) {
+            q->chien_tab[32*i +      x] = fec_rscodec_mul(q, c, x);
+            q->chien_tab[32*i + 16 + x] = fec_rscodec_mul(q, c, x << 4);
+        }
+    }
+
+    // syndrome tables
+    q->syn_tab = (unsigned char*) malloc(_nroots*32*sizeof(unsigned char));
+    for (i=0; i<_nroots; i++) {
+        unsigned char c = fec_rscodec_beta(q, _fcr+i);
+        for (x=0; x<16; x++) {
+            q->syn_tab[32*i +      x] = fec_rscodec_mul(q, c, x);
+            q->syn_tab[32*i + 16 + x] = fec_rscodec_mul(q, c, x << 4);
+        }
+    }
+
+    return q;
+}
 
-fec fec_rs_create(fec_scheme _fs)
+// destroy Reed-Solomon codec
+void fec_rscodec_destroy(fec_rscodec _q)
+{
+    free(_q->genpoly);
+    free(_q->enc_tab);
+    free(_q->chien_tab);
+    free(_q->syn_tab);
+    free(_q);
+}
+
+// compute parity shift register contents for _n data symbols (remainder
+// of the data polynomial times x^nroots divided by the generator)
+//  _q      :   codec
+//  _msg    :   data symbols [size: _n x 1]
+//  _n      :   number of data symbols
+//  _bb     :   remainder, first symbol is highest order [size: rowlen x 1]
+static void fec_rscodec_remainder(fec_rscodec     _q,
+                                  unsigned char * _msg,
+                                  unsigned int    _n,
+                                  unsigned char * _bb)
+{
+    unsigned int i, j;
+    unsigned int nroots = _q->nroots;
+
+#if defined(__SSSE3__)
+    // keep the register in two vectors: shift by one symbol and add
+    // the table row selected by the feedback symbol
+    if (nroots <= 32 && liquid_cpu_has(LIQUID_CPU_SSSE3)) {
+        __m128i b0 = _mm_setzero_si128();
+        __m128i b1 = _mm_setzero_si128();
+        for (i=0; i<_n; i++) {
+            unsigned int f = _msg[i] ^ (_mm_cvtsi128_si32(b0) & 0xff);
+            const unsigned char * t = &_q->enc_tab[f*32];
+            b0 = _mm_xor_si128(_mm_alignr_epi8(b1, b0, 1), _mm_loadu_si128((const __m128i*)(t   )));
+            b1 = _mm_xor_si128(_mm_srli_si128(b1, 1),      _mm_loadu_si128((const __m128i*)(t+16)));
+        }
+        _mm_storeu_si128((__m128i*)(_bb   ), b0);
+        _mm_storeu_si128((__m128i*)(_bb+16), b1);
+        return;
+    }
+#endif
+
+    memset(_bb, 0x00, _q->rowlen);
+    for (i=0; i<_n; i++) {
+        const unsigned char * t = &_q->enc_tab[(_msg[i] ^ _bb[0])*_q->rowlen];
+        for (j=0; j<nroots-1; j++)
+            _bb[j] = _bb[j+1] ^ t[j];
+        _bb[nroots-1] = t[nroots-1];
+    }
+}
+
+// encode block of data symbols
+//  _q      :   codec
+//  _msg    :   data symbols [size: _n x 1]
+//  _n      :   number of data symbols, 0 < _n <= 255-nroots
+//  _parity :   parity symbols [size: nroots x 1]
+void fec_rscodec_encode(fec_rscodec     _q,
+                        unsigned char * _msg,
+                        unsigned int    _n,
+                        unsigned char * _parity)
+{
+    if (_n == 0 || _n + _q->nroots > 255) {
+        fprintf(stderr,"error: fec_rscodec_encode(), invalid block length\n");
+        exit(1);
+    }
+
+    unsigned char bb[_q->rowlen];
+    fec_rscodec_remainder(_q, _msg, _n, bb);
+    memmove(_parity, bb, _q->nroots);
+}
+
+// syndromes of a batch of codewords: the remainder of each received
+// polynomial evaluated at the roots of the generator polynomial
+//  _q      :   codec
+//  _rem    :   remainders, symbol j of codeword l at _rem[16*j+l] [size: nroots x 16]
+//  _num    :   number of codewords, _num <= 16
+//  _s      :   syndromes, s_i of codeword l at _s[16*i+l] [size: nroots x 16]
+static void fec_rscodec_syndromes(fec_rscodec     _q,
+                                  unsigned char * _rem,
+                                  unsigned int    _num,
+                                  unsigned char * _s)
+{
+    unsigned int i, j, l;
+    unsigned int nroots = _q->nroots;
+
+#if defined(__SSSE3__)
+    // one codeword per lane; every lane is multiplied by the same root
+    if (liquid_cpu_has(LIQUID_CPU_SSSE3)) {
+        __m128i m0f = _mm_set1_epi8(0x0f);
+        for (i=0; i<nroots; i++) {
+            __m128i lo  = _mm_loadu_si128((const __m128i*)&_q->syn_tab[32*i   ]);
+            __m128i hi  = _mm_loadu_si128((const __m128i*)&_q->syn_tab[32*i+16]);
+            __m128i acc = _mm_setzero_si128();
+            for (j=0; j<nroots; j++) {
+                acc = _mm_xor_si128(_mm_shuffle_epi8(lo, _mm_and_si128(acc, m0f)),
+                                    _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(acc, 4), m0f)));
+                acc = _mm_xor_si128(acc, _mm_loadu_si128((const __m128i*)&_rem[16*j]));
+            }
+            _mm_storeu_si128((__m128i*)&_s[16*i], acc);
+        }
+        return;
+    }
+#endif
+
+    for (i=0; i<nroots; i++) {
+        unsigned int r = (((_q->fcr + i) * _q->prim) % 255);
+        for (l=0; l<_num; l++) {
+            unsigned char acc = 0;
+            for (j=0; j<nroots; j++)
+                acc = (acc ? _q->alpha_to[_q->index_of[acc] + r] : 0) ^ _rem[16*j+l];
+            _s[16*i+l] = acc;
+        }
+    }
+}
+
+// Berlekamp-Massey: error locator polynomial from syndromes
+//  _q      :   codec
+//  _s      :   syndromes [size: nroots x 1]
+//  _lambda :   error locator, _lambda[0] = 1 [size: nroots+1 x 1]
+//  returns degree of error locator, or -1 if it exceeds nroots/2
+static int fec_rscodec_bm(fec_rscodec     _q,
+                          unsigned char * _s,
+                          unsigned char * _lambda)
+{
+    unsigned int nroots = _q->nroots;
+    unsigned int i, k;
+    unsigned char b[nroots+1];
+    unsigned char t[nroots+1];
+    memset(_lambda, 0x00, nroots+1);
+    memset(b,       0x00, nroots+1);
+    _lambda[0] = 1;
+    b[0]       = 1;
+    unsigned int  L  = 0;   // current number of errors
+    unsigned int  m  = 1;   // shift since last length change
+    unsigned char db = 1;   // discrepancy at last length change
+    for (k=0; k<nroots; k++) {
+        // discrepancy
+        unsigned char d = _s[k];
+        for (i=1; i<=L; i++)
+            d ^= fec_rscodec_mul(_q, _lambda[i], _s[k-i]);
+
+        if (d == 0) {
+            m++;
+            continue;
+        }
+
+        // lambda(x) -= (d/db) x^m b(x)
+        unsigned int c = (_q->index_of[d] + 255 - _q->index_of[db]) % 255;
+        memmove(t, _lambda, nroots+1);
+        for (i=0; i+m<=nroots; i++) {
+            if (b[i])
+                _lambda[i+m] ^= _q->alpha_to[_q->index_of[b[i]] + c];
+        }
+
+        if (2*L <= k) {
+            L  = k + 1 - L;
+            memmove(b, t, nroots+1);
+            db = d;
+            m  = 1;
+        } else {
+            m++;
+        }
+    }
+    return 2*L > nroots ? -1 : (int)L;
+}
+
+// find roots of error locators, beta^(-e), for positions e < _n, for a
+// batch of codewords
+//  _q      :   codec
+//  _lambda :   error locators, _lambda[0] = 1 [size: _num x (nroots+1)]
+//  _L      :   degree of each error locator, at least 1 [size: _num x 1]
+//  _num    :   number of codewords
+//  _n      :   block length
+//  _loc    :   positions of roots [size: _num x nroots]
+//  _nloc   :   number of roots found, at most _L [size: _num x 1]
+static void fec_rscodec_chien(fec_rscodec     _q,
+                              unsigned char * _lambda,
+                              unsigned int *  _L,
+                              unsigned int    _num,
+                              unsigned int    _n,
+                              unsigned int *  _loc,
+                              unsigned int *  _nloc)
+{
+    unsigned int nroots = _q->nroots;
+    unsigned int c, i, e;
+    for (c=0; c<_num; c++)
+        _nloc[c] = 0;
+    if (_num == 0)
+        return;
+
+#if defined(__SSSE3__)
+    // evaluate sixteen consecutive positions of every codeword per pass;
+    // term i of lane l holds lambda_i beta^(-i(e+l)) and advances by a
+    // constant factor, so each table is loaded once for all codewords
+    if (liquid_cpu_has(LIQUID_CPU_SSSE3)) {
+        unsigned int Lmax = 0;
+        for (c=0; c<_num; c++)
+            Lmax = _L[c] > Lmax ? _L[c] : Lmax;
+
+        __m128i v[_num][Lmax+1];
+        unsigned char v0[16];
+        unsigned int l;
+        for (c=0; c<_num; c++) {
+            for (i=1; i<=_L[c]; i++) {
+                for (l=0; l<16; l++)
+                    v0[l] = fec_rscodec_mul(_q, _lambda[c*(nroots+1)+i], fec_rscodec_beta(_q, -(int)(i*l)));
+                v[c][i] = _mm_loadu_si128((const __m128i*)v0);
+            }
+        }
+
+        __m128i m0f = _mm_set1_epi8(0x0f);
+        for (e=0; e<_n; e+=16) {
+            for (c=0; c<_num; c++) {
+                // sum terms (lambda_0 = 1)
+                __m128i s = _mm_set1_epi8(1);
+                for (i=1; i<=_L[c]; i++)
+                    s = _mm_xor_si128(s, v[c][i]);
+
+                unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(s, _mm_setzero_si128()));
+                if (_n - e < 16)
+                    mask &= (1U << (_n - e)) - 1;
+                while (mask && _nloc[c] < _L[c]) {
+                    unsigned int b = liquid_msb_index(mask) - 1;
+                    _loc[c*nroots + _nloc[c]++] = e + b;
+                    mask ^= 1U << b;
+                }
+            }
+
+            // advance by sixteen positions
+            for (i=1; i<=Lmax; i++) {
+                __m128i lo = _mm_loadu_si128((const __m128i*)&_q->chien_tab[32*i   ]);
+                __m128i hi = _mm_loadu_si128((const __m128i*)&_q->chien_tab[32*i+16]);
+                for (c=0; c<_num; c++) {
+                    if (i > _L[c]) continue;
+                    v[c][i] = _mm_xor_si128(_mm_shuffle_epi8(lo, _mm_and_si128(v[c][i], m0f)),
+                                            _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(v[c][i], 4), m0f)));
+                }
+            }
+        }
+        return;
+    }
+#endif
+
+    for (c=0; c<_num; c++) {
+        // term logs and step sizes
+        unsigned char * lambda = &_lambda[c*(nroots+1)];
+        unsigned int L = _L[c];
+        int t[L+1];
+        unsigned int step[L+1];
+        for (i=1; i<=L; i++) {
+            t[i]    = lambda[i] ? (int)_q->index_of[lambda[i]] : -1;
+            step[i] = (255 - (i*_q->prim) % 255) % 255;
+        }
+        for (e=0; e<_n && _nloc[c] < L; e++) {
+            unsigned char s = 1;
+            for (i=1; i<=L; i++) {
+                if (t[i] < 0) continue;
+                s ^= _q->alpha_to[t[i]];
+                t[i] = (t[i] + step[i]) % 255;
+            }
+            if (s == 0)
+                _loc[c*nroots + _nloc[c]++] = e;
+        }
+    }
+}
+
+// Forney: correct errors at known positions in place
+//  e = X^(1-fcr) omega(X^-1) / lambda'(X^-1),  X = beta^loc
+// where omega(x) = s(x) lambda(x) mod x^nroots
+//  _q      :   codec
+//  _s      :   syndromes [size: nroots x 1]
+//  _lambda :   error locator [size: _L+1 x 1]
+//  _L      :   degree of error locator (number of errors)
+//  _loc    :   error positions (power of x) [size: _L x 1]
+//  _block  :   received block [size: _n x 1]
+//  _n      :   block length
+//  returns 0 on success, -1 if a magnitude could not be computed
+static int fec_rscodec_forney(fec_rscodec     _q,
+                              unsigned char * _s,
+                              unsigned char * _lambda,
+                              unsigned int    _L,
+                              unsigned int *  _loc,
+                              unsigned char * _block,
+                              unsigned int    _n)
+{
+    unsigned int i, j, k;
+    unsigned char omega[_L];
+    for (i=0; i<_L; i++) {
+        omega[i] = 0;
+        for (j=0; j<=i; j++)
+            omega[i] ^= fec_rscodec_mul(_q, _s[i-j], _lambda[j]);
+    }
+    for (k=0; k<_L; k++) {
+        unsigned char xinv = fec_rscodec_beta(_q, -(int)_loc[k]);
+        unsigned char num = 0, den = 0, xp = 1;
+        for (i=0; i<_L; i++) {
+            num ^= fec_rscodec_mul(_q, omega[i], xp);
+            // odd terms of lambda contribute to the formal derivative
+            if (i & 1)
+                den ^= fec_rscodec_mul(_q, _lambda[i], fec_rscodec_mul(_q, xp, fec_rscodec_beta(_q, _loc[k])));
+            xp = fec_rscodec_mul(_q, xp, xinv);
+        }
+        if (_L & 1)
+            den ^= fec_rscodec_mul(_q, _lambda[_L], fec_rscodec_mul(_q, xp, fec_rscodec_beta(_q, _loc[k])));
+        if (den == 0)
+            return -1;
+
+        num = fec_rscodec_mul(_q, num, fec_rscodec_beta(_q, (int)_loc[k]*(1-(int)_q->fcr)));
+        unsigned char y = _q->alpha_to[(_q->index_of[num] + 255 - _q->index_of[den]) % 255];
+        if (num == 0)
+            y = 0;
+        _block[_n - 1 - _loc[k]] ^= y;
+    }
+    return 0;
+}
+
+// decode batch of independent blocks in place; clean blocks are found
+// by re-encoding, then the syndromes and Chien search of the remaining
+// blocks are computed FEC_RSCODEC_BATCH codewords at a time
+//  _q      :   codec
+//  _blocks :   received blocks, data followed by parity [size: _num*_n x 1]
+//  _n      :   block length, nroots < _n <= 255
+//  _num    :   number of blocks
+//  _nerr   :   number of corrected symbol errors per block, or -1 if the
+//              block could not be corrected (ignored if NULL) [size: _num x 1]
+void fec_rscodec_decode_block(fec_rscodec     _q,
+                              unsigned char * _blocks,
+                              unsigned int    _n,
+                              unsigned int    _num,
+                              int *           _nerr)
+{
+    if (_n <= _q->nroots || _n > 255) {
+        fprintf(stderr,"error: fec_rscodec_decode_block(), invalid block length\n");
+        exit(1);
+    }
+    unsigned int nroots = _q->nroots;
+    unsigned int b, c, i, l;
+
+    unsigned char rem[_q->rowlen];
+    unsigned char rem_t[16*nroots];                 // remainders by lane
+    unsigned char s_t  [16*nroots];                 // syndromes by lane
+    unsigned char s     [FEC_RSCODEC_BATCH*nroots]; // syndromes of active blocks
+    unsigned char lambda[FEC_RSCODEC_BATCH*(nroots+1)];
+    unsigned int  L     [FEC_RSCODEC_BATCH];
+    unsigned int  idx   [FEC_RSCODEC_BATCH];        // lane of each active block
+    unsigned int  loc   [FEC_RSCODEC_BATCH*nroots];
+    unsigned int  nloc  [FEC_RSCODEC_BATCH];
+    int           r     [FEC_RSCODEC_BATCH];
+
+    for (b=0; b<_num; b+=FEC_RSCODEC_BATCH) {
+        unsigned int    num    = _num - b < FEC_RSCODEC_BATCH ? _num - b : FEC_RSCODEC_BATCH;
+        unsigned char * blocks = _blocks + b*_n;
+
+        // remainder of each received polynomial: re-encode data and
+        // compare with received parity; zero if and only if the block is
+        // a codeword
+        unsigned int dirty = 0;
+        memset(rem_t, 0x00, sizeof(rem_t));
+        for (l=0; l<num; l++) {
+            unsigned char * block = blocks + l*_n;
+            fec_rscodec_remainder(_q, block, _n - nroots, rem);
+            unsigned char nz = 0;
+            for (i=0; i<nroots; i++) {
+                rem_t[16*i+l] = rem[i] ^ block[_n - nroots + i];
+                nz |= rem_t[16*i+l];
+            }
+            r[l] = 0;
+            dirty |= nz ? 1U << l : 0;
+        }
+        if (dirty == 0) {
+            if (_nerr != NULL)
+                memset(_nerr + b, 0x00, num*sizeof(int));
+            continue;
+        }
+
+        // syndromes for every block in the batch, then error locators for
+        // those with errors (a non-zero remainder has at least one error)
+        fec_rscodec_syndromes(_q, rem_t, num, s_t);
+        unsigned int num_active = 0;
+        for (l=0; l<num; l++) {
+            if ( !(dirty & (1U << l)) )
+                continue;
+            unsigned char * sc = &s[num_active*nroots];
+            for (i=0; i<nroots; i++)
+                sc[i] = s_t[16*i+l];
+            int Lc = fec_rscodec_bm(_q, sc, &lambda[num_active*(nroots+1)]);
+            if (Lc <= 0) {
+                r[l] = -1;
+                continue;
+            }
+            L  [num_active] = Lc;
+            idx[num_active] = l;
+            num_active++;
+        }
+
+        // error positions, then magnitudes
+        fec_rscodec_chien(_q, lambda, L, num_active, _n, loc, nloc);
+        for (c=0; c<num_active; c++) {
+            l = idx[c];
+            if (nloc[c] != L[c] ||
+                fec_rscodec_forney(_q, &s[c*nroots], &lambda[c*(nroots+1)], L[c],
+                                   &loc[c*nroots], blocks + l*_n, _n) < 0)
+            {
+                r[l] = -1;
+            } else {
+                r[l] = L[c];
+            }
+        }
+        if (_nerr != NULL)
+            memmove(_nerr + b, r, num*sizeof(int));
+    }
+}
+
+// decode block in place, returning the number of corrected symbol
+// errors, or -1 if the block could not be corrected
+//  _q      :   codec
+//  _block  :   received data and parity symbols [size: _n x 1]
+//  _n      :   block length, nroots < _n <= 255
+int fec_rscodec_decode(fec_rscodec     _q,
+                       unsigned char * _block,
+                       unsigned int    _n)
+{
+    int nerr;
+    fec_rscodec_decode_block(_q, _block, _n, 1, &nerr);
+    return nerr;
+}
+
+//
+// fec interface
+//
+
+// initialize Reed-Solomon properties to RS(255,223)
+void fecrsprops_init_default(fecrsprops_s * _props)
+{
+    _props->nroots = 32;
+    _props->kk     = 223;
+}
+
+// encoded message length for Reed-Solomon code with particular
+// properties (NULL selects the defaults)
+unsigned int fecrsprops_get_enc_msg_length(fecrsprops_s * _props,
+                                           unsigned int   _msg_len)
+{
+    fecrsprops_s props;
+    fecrsprops_init_default(&props);
+    if (_props != NULL)
+        props = *_props;
+    return fec_rs_get_enc_msg_len(_msg_len, props.nroots, props.nroots + props.kk, props.kk);
+}
+
+// create Reed-Solomon fec object
+//  _fs     :   scheme
+//  _opts   :   code properties, fecrsprops_s (NULL selects defaults)
+fec fec_rs_create(fec_scheme _fs,
+                  void *     _opts)
 {
     fec q = (fec) malloc(sizeof(struct fec_s));
 
     q->scheme = _fs;
-    q->rate = fec_get_rate(q->scheme);
 
     q->encode_func      = &fec_rs_encode;
     q->decode_func      = &fec_rs_decode;
@@ -58,29 +653,38 @@ fec fec_rs_create(fec_scheme _fs)
     q->nn = (1 << q->symsize) - 1;
     q->kk = q->nn - q->nroots;
 
+    // override number of parity symbols and (shortened) block length
+    if (_opts != NULL) {
+        fecrsprops_s * props = (fecrsprops_s*) _opts;
+        if (props->nroots == 0 || props->nroots >= (unsigned int)q->nn) {
+            fprintf(stderr,"error: fec_rs_create(), number of roots must be in [1,%d]\n", q->nn-1);
+            exit(1);
+        } else if (props->kk == 0 || props->kk + props->nroots > (unsigned int)q->nn) {
+            fprintf(stderr,"error: fec_rs_create(), block length must be in [1,%d]\n", q->nn-(int)props->nroots);
+            exit(1);
+        }
+        q->nroots = props->nroots;
+        q->kk     = props->kk;
+    }
+    q->rate = (float)q->kk / (float)(q->kk + q->nroots);
+
     // lengths
     q->num_dec_bytes = 0;
-    q->rs = NULL;
 
-    // allocate memory for arrays
-    q->tblock   = (unsigned char*) malloc(q->nn*sizeof(unsigned char));
-    q->errlocs  = (int *) malloc(q->nn*sizeof(int));
-    q->derrlocs = (int *) malloc(q->nn*sizeof(int));
+    // codec and decoding buffer
+    q->rs     = fec_rscodec_create(q->genpoly, q->fcs, q->prim, q->nroots);
+    q->tblock = (unsigned char*) malloc(FEC_RSCODEC_BATCH*q->nn*sizeof(unsigned char));
 
     return q;
 }
 
 void fec_rs_destroy(fec _q)
 {
-    // delete internal Reed-Solomon decoder object
-    if (_q->rs != NULL) {
-        free_rs_char(_q->rs);
-    }
+    // delete internal Reed-Solomon codec
+    fec_rscodec_destroy(_q->rs);
 
     // delete internal memory arrays
     free(_q->tblock);
-    free(_q->errlocs);
-    free(_q->derrlocs);
 
     // delete fec object
     free(_q);
@@ -110,17 +714,13 @@ void fec_rs_encode(fec _q,
         if (i == _q->num_blocks-1)
             block_size -= _q->res_block_len;
 
-        // copy sequence
-        memmove(_q->tblock, &_msg_dec[n0], block_size*sizeof(unsigned char));
-
-        // last block: we could pad end with zeros, but it's not really
-        // necessary as these bits are going to be thrown away anyway
+        // copy sequence directly to output, padding the end of the last
+        // block with zeros
+        memmove(&_msg_enc[n1], &_msg_dec[n0], block_size*sizeof(unsigned char));
+        memset(&_msg_enc[n1+block_size], 0x00, _q->dec_block_len - block_size);
 
         // encode data, appending parity bits to end of sequence
-        encode_rs_char(_q->rs, _q->tblock, &_q->tblock[_q->dec_block_len]);
-
-        // copy result to output
-        memmove(&_msg_enc[n1], _q->tblock, _q->enc_block_len*sizeof(unsigned char));
+        fec_rscodec_encode(_q->rs, &_msg_enc[n1], _q->dec_block_len, &_msg_enc[n1+_q->dec_block_len]);
 
         // increment counters
         n0 += block_size;
@@ -137,53 +737,58 @@ void fec_rs_decode(fec _q,
                    unsigned int _dec_msg_len,
                    unsigned char *_msg_enc,
                    unsigned char *_msg_dec)
+{
+    fec_rs_decode_block(_q, _dec_msg_len, 1, _msg_enc, _msg_dec);
+}
+
+// decode several messages; the codewords of all messages are stored
+// back to back and are decoded together, FEC_RSCODEC_BATCH at a time
+void fec_rs_decode_block(fec _q,
+                         unsigned int _dec_msg_len,
+                         unsigned int _num,
+                         unsigned char *_msg_enc,
+                         unsigned char *_msg_dec)
 {
     // validate input
     if (_dec_msg_len == 0) {
-        fprintf(stderr,"error: fec_rs_encode(), input lenght must be > 0\n");
+        fprintf(stderr,"error: fec_rs_decode(), input lenght must be > 0\n");
         exit(1);
     }
 
     // re-allocate resources if necessary
     fec_rs_setlength(_q, _dec_msg_len);
 
-    // set erasures, error locations to zero
-    memset(_q->errlocs,  0x00, _q->nn*sizeof(unsigned char));
-    memset(_q->derrlocs, 0x00, _q->nn*sizeof(unsigned char));
-    _q->erasures = 0;
-
-    unsigned int i;
+    unsigned int num_codewords = _num*_q->num_blocks;
+    unsigned int i, j;
     unsigned int n0=0;
     unsigned int n1=0;
-    unsigned int block_size = _q->dec_block_len;
-    //int derrors; // number of decoder errors
-    for (i=0; i<_q->num_blocks; i++) {
-
-        // the last block is smaller by the residual block length
-        if (i == _q->num_blocks-1)
-            block_size -= _q->res_block_len;
+    for (i=0; i<num_codewords; i+=FEC_RSCODEC_BATCH) {
+        unsigned int num = num_codewords - i < FEC_RSCODEC_BATCH ?
+                           num_codewords - i : FEC_RSCODEC_BATCH;
 
         // copy sequence
-        memmove(_q->tblock, &_msg_enc[n0], _q->enc_block_len*sizeof(unsigned char));
-
-        // decode block
-        //derrors = 
-        decode_rs_char(_q->rs,
-                       _q->tblock,
-                       _q->derrlocs,
-                       _q->erasures);
-
-        // copy result
-        memmove(&_msg_dec[n1], _q->tblock, block_size*sizeof(unsigned char));
-
-        // increment counters
-        n0 += _q->enc_block_len;
-        n1 += block_size;
+        memmove(_q->tblock, &_msg_enc[n0], num*_q->enc_block_len*sizeof(unsigned char));
+
+        // decode blocks
+        fec_rscodec_decode_block(_q->rs, _q->tblock, _q->enc_block_len, num, NULL);
+
+        // copy result; the last block of each message is smaller by the
+        // residual block length
+        for (j=0; j<num; j++) {
+            unsigned int block_size = _q->dec_block_len;
+            if ((i+j) % _q->num_blocks == _q->num_blocks-1)
+                block_size -= _q->res_block_len;
+            memmove(&_msg_dec[n1], &_q->tblock[j*_q->enc_block_len], block_size*sizeof(unsigned char));
+            n1 += block_size;
+        }
+
+        // increment counter
+        n0 += num*_q->enc_block_len;
     }
 
     // sanity check
-    assert( n0 == _q->num_enc_bytes );
-    assert( n1 == _q->num_dec_bytes );
+    assert( n0 == _num*_q->num_enc_bytes );
+    assert( n1 == _num*_q->num_dec_bytes );
 }
 
 // Set dec_msg_len, re-allocating resources as necessary.  Effectively, it
@@ -214,9 +819,9 @@ void fec_rs_decode(fec _q,
 // Thus, the 1024-byte input message is broken into 5 blocks, the first
 // four have a length 205, and the last block has a length 204 (which is
 // externally padded to 205, e.g. res_block_len = 1). This code adds 32
-// parity symbols, so each block is extended to 237 bytes. libfec auto-
-// matically extends the internal data to 255 bytes by padding with 18
-// symbols.  Therefore, the final output length is 237 * 5 = 1185 symbols.
+// parity symbols, so each block is extended to 237 bytes; the code is
+// shortened by the 18 symbols left out of each block.
+// Therefore, the final output length is 237 * 5 = 1185 symbols.
 void fec_rs_setlength(fec _q,
                       unsigned int _dec_msg_len)
 {
@@ -244,12 +849,12 @@ void fec_rs_setlength(fec _q,
     // mod(num_blocks*dec_block_len, num_dec_bytes)
     _q->res_block_len = (_q->num_blocks*_q->dec_block_len) % _q->num_dec_bytes;
 
-    // compute the internal libfec padding factor: kk - dec_block_len
+    // compute the shortening factor: kk - dec_block_len
     _q->pad = _q->kk - _q->dec_block_len;
 
     // compute the final encoded block length: enc_block_len * num_blocks
     _q->num_enc_bytes = _q->enc_block_len * _q->num_blocks;
-    
+
 #if VERBOSE_FEC_RS
     printf("dec_msg_len     :   %u\n", _q->num_dec_bytes);
     printf("num_blocks      :   %u\n", _q->num_blocks);
@@ -259,18 +864,6 @@ void fec_rs_setlength(fec _q,
     printf("pad             :   %u\n", _q->pad);
     printf("enc_msg_len     :   %u\n", _q->num_enc_bytes);
 #endif
-
-    // delete old decoder if necessary
-    if (_q->rs != NULL)
-        free_rs_char(_q->rs);
-
-    // Reed-Solomon specific decoding
-    _q->rs = init_rs_char(_q->symsize,
-                          _q->genpoly,
-                          _q->fcs,
-                          _q->prim,
-                          _q->nroots,
-                          _q->pad);
 }
 
 // 
@@ -285,32 +878,3 @@ void fec_rs_init_p8(fec _q)
     _q->prim = 1;
     _q->nroots = 32;
 }
-
-#else   // LIBFEC_ENABLED
-
-fec fec_rs_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_rs_destroy(fec _q)
-{
-}
-
-void fec_rs_encode(fec _q,
-                   unsigned int _dec_msg_len,
-                   unsigned char *_msg_dec,
-                   unsigned char *_msg_enc)
-{
-}
-
-//unsigned int
-void fec_rs_decode(fec _q,
-                   unsigned int _dec_msg_len,
-                   unsigned char *_msg_enc,
-                   unsigned char *_msg_dec)
-{
-}
-
-#endif  // LIBFEC_ENABLED
-
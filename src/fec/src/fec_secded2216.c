@@ -37,6 +37,9 @@
 
 #define DEBUG_FEC_SECDED2216 0
 
+// number of least reliable bits flipped in soft decoding (Chase-II)
+#define SECDED2216_CHASE_NUM_POSITIONS  3
+
 // P matrix [6 x 16 bits], [6 x 2 bytes]
 //  1001 1001 0011 1100 :
 //  0011 1110 1000 1010 :
@@ -61,44 +64,62 @@ unsigned char secded2216_syndrome_w1[22] = {
     0x01, 0x02, 0x04, 0x08, 
     0x10, 0x20};
 
-// compute parity on 16-bit input
-unsigned char fec_secded2216_compute_parity(unsigned char * _m)
+// look-up tables, built from P and the weight-1 syndromes when the
+// library is loaded: parity contribution of each byte value at each
+// position, and the decoding outcome for each syndrome
+static unsigned char secded2216_parity_tab[2][256];
+static unsigned char secded2216_ehat_flag[256];  // 0/1/2 errors detected
+static unsigned char secded2216_ehat_byte[256];  // index of erroneous byte
+static unsigned char secded2216_ehat_mask[256];  // erroneous bit in byte
+static unsigned char secded2216_ehat_pos[256];   // erroneous bit in symbol
+static int           secded2216_tables_ready = 0;
+
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void fec_secded2216_init_tables(void)
 {
-    // compute encoded/transmitted message: v = m*G
-    unsigned char parity = 0x00;
-
-    // TODO : unwrap this loop
-    unsigned int i;
-    for (i=0; i<6; i++) {
-        parity <<= 1;
-
-        unsigned int p = liquid_c_ones[ secded2216_P[2*i+0] & _m[0] ] +
-                         liquid_c_ones[ secded2216_P[2*i+1] & _m[1] ];
+    unsigned int i, k, b, n;
+    for (k=0; k<2; k++) {
+        for (b=0; b<256; b++) {
+            unsigned char parity = 0x00;
+            for (i=0; i<6; i++)
+                parity = (parity << 1) | (liquid_c_ones[ secded2216_P[2*i+k] & b ] & 0x01);
+            secded2216_parity_tab[k][b] = parity;
+        }
+    }
 
-        parity |= p & 0x01;
+    for (b=0; b<256; b++) {
+        secded2216_ehat_flag[b] = b ? 2 : 0;
+        secded2216_ehat_byte[b] = 0;
+        secded2216_ehat_mask[b] = 0;
+        secded2216_ehat_pos[b]  = 0;
+    }
+    for (n=0; n<22; n++) {
+        unsigned char s = secded2216_syndrome_w1[n];
+        secded2216_ehat_flag[s] = 1;
+        secded2216_ehat_byte[s] = 3-n/8-1;
+        secded2216_ehat_mask[s] = 1 << (n%8);
+        secded2216_ehat_pos[s]  = 23-n;
     }
+    secded2216_tables_ready = 1;
+}
+
+// compute parity on 16-bit input
+unsigned char fec_secded2216_compute_parity(unsigned char * _m)
+{
+    if (!secded2216_tables_ready)
+        fec_secded2216_init_tables();
 
-    return parity;
+    return secded2216_parity_tab[0][_m[0]] ^
+           secded2216_parity_tab[1][_m[1]];
 }
 
 // compute syndrome on 22-bit input
 unsigned char fec_secded2216_compute_syndrome(unsigned char * _v)
 {
-    // TODO : unwrap this loop
-    unsigned int i;
-    unsigned char syndrome = 0x00;
-    for (i=0; i<6; i++) {
-        syndrome <<= 1;
-
-        unsigned int p =
-            ( (_v[0] & (1<<(6-i-1))) ? 1 : 0 )+
-            liquid_c_ones[ secded2216_P[2*i+0] & _v[1] ] +
-            liquid_c_ones[ secded2216_P[2*i+1] & _v[2] ];
-
-        syndrome |= p & 0x01;
-    }
-
-    return syndrome;
+    // syndrome is received parity plus parity computed on received data
+    return (_v[0] & 0x3f) ^ fec_secded2216_compute_parity(&_v[1]);
 }
 
 // encode symbol
@@ -166,32 +187,11 @@ int fec_secded2216_estimate_ehat(unsigned char * _sym_enc,
     // compute syndrome vector, s = r*H^T = ( H*r^T )^T
     unsigned char s = fec_secded2216_compute_syndrome(_sym_enc);
 
-    // compute weight of s
-    unsigned int ws = liquid_c_ones[s];
-    
-    if (ws == 0) {
-        // no errors detected
-        return 0;
-    } else {
-        // estimate error location; search for syndrome with error
-        // vector of weight one
-
-        unsigned int n;
-        // estimate error location
-        for (n=0; n<22; n++) {
-            if (s == secded2216_syndrome_w1[n]) {
-                // single error detected at location 'n'
-                div_t d = div(n,8);
-                _e_hat[3-d.quot-1] = 1 << d.rem;
-
-                return 1;
-            }
-        }
+    // look up error location (single error only)
+    if (secded2216_ehat_flag[s] == 1)
+        _e_hat[secded2216_ehat_byte[s]] = secded2216_ehat_mask[s];
 
-    }
-
-    // no syndrome match; multiple errors detected
-    return 2;
+    return secded2216_ehat_flag[s];
 }
 
 // create SEC-DED (22,16) codec object
@@ -206,7 +206,7 @@ fec fec_secded2216_create(void * _opts)
     // set internal function pointers
     q->encode_func      = &fec_secded2216_encode;
     q->decode_func      = &fec_secded2216_decode;
-    q->decode_soft_func = NULL;
+    q->decode_soft_func = &fec_secded2216_decode_soft;
 
     return q;
 }
@@ -295,8 +295,11 @@ void fec_secded2216_decode(fec _q,
     unsigned int r = _dec_msg_len % 2;
 
     for (i=0; i<_dec_msg_len-r; i+=2) {
-        // decode straight to output
-        fec_secded2216_decode_symbol(&_msg_enc[j], &_msg_dec[i]);
+        // correct single errors in data bytes directly
+        unsigned char s = fec_secded2216_compute_syndrome(&_msg_enc[j]);
+        memmove(&_msg_dec[i], &_msg_enc[j+1], 2);
+        if (secded2216_ehat_byte[s] > 0)
+            _msg_dec[i + secded2216_ehat_byte[s] - 1] ^= secded2216_ehat_mask[s];
 
         j += 3;
     }
@@ -325,3 +328,81 @@ void fec_secded2216_decode(fec _q,
 
     //return num_errors;
 }
+
+// decode block of data using SEC-DED (22,16) soft decoder
+//
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: 8*_enc_msg_len x 1]
+//  _msg_dec        :   decoded message [size: _dec_msg_len x 1]
+void fec_secded2216_decode_soft(fec _q,
+                                unsigned int _dec_msg_len,
+                                unsigned char *_msg_enc,
+                                unsigned char *_msg_dec)
+{
+    unsigned int i=0;       // decoded byte counter
+    unsigned int k=0;       // soft bit counter
+
+    // hard decisions for the whole message; only symbols with a
+    // non-zero syndrome are decoded from their soft bits
+    unsigned int enc_msg_len = fec_get_enc_msg_length(LIQUID_FEC_SECDED2216,_dec_msg_len);
+    unsigned char v_hard[enc_msg_len];
+    fecsoft_hard_decision(_msg_enc, enc_msg_len, v_hard);
+
+    // determine remainder of input length / 2
+    unsigned int r = _dec_msg_len % 2;
+
+    for (i=0; i<_dec_msg_len-r; i+=2) {
+        if (fec_secded2216_compute_syndrome(&v_hard[k/8]) == 0)
+            memmove(&_msg_dec[i], &v_hard[k/8+1], 2);
+        else
+            fecsoft_secded2216_decode(&_msg_enc[k], &_msg_dec[i]);
+        k += 24;
+    }
+
+    // if input length isn't divisible by 2, decode last several bytes
+    if (r) {
+        // one 22-bit symbol (soft bits); bytes artificially set to
+        // zero at the receiver are taken as certain
+        unsigned char v[24];
+        memset(v, 0x00, sizeof(v));
+        memmove(v, &_msg_enc[k], 8*(r+1));
+
+        // one 16-bit symbol (decoded)
+        unsigned char m_hat[2];
+        fecsoft_secded2216_decode(v, m_hat);
+
+        // copy non-zero bytes to output
+        memmove(&_msg_dec[i], m_hat, r);
+
+        i += r;
+        k += 8*(r+1);
+    }
+
+    assert( k == 8*enc_msg_len );
+    assert( i == _dec_msg_len);
+}
+
+// error locator for soft decoding: errors detected for syndrome, and
+// position of erroneous bit for a single error
+static int fecsoft_secded2216_locate(unsigned char  _s,
+                                      unsigned int * _pos)
+{
+    *_pos = secded2216_ehat_pos[_s];
+    return secded2216_ehat_flag[_s];
+}
+
+// soft decoding of one symbol (Chase-II, see fecsoft_chase_decode())
+//  _soft_bits  :   soft bits of encoded symbol [size: 24 x 1]
+//  _sym_dec    :   decoded symbol [size: 2 x 1]
+void fecsoft_secded2216_decode(unsigned char * _soft_bits,
+                              unsigned char * _sym_dec)
+{
+    if (!secded2216_tables_ready)
+        fec_secded2216_init_tables();
+
+    fecsoft_chase_decode(_soft_bits, 22, 2, 2, SECDED2216_CHASE_NUM_POSITIONS,
+                         fec_secded2216_compute_syndrome,
+                         fecsoft_secded2216_locate,
+                         _sym_dec);
+}
@@ -37,6 +37,9 @@
 
 #define DEBUG_FEC_SECDED3932 0
 
+// number of least reliable bits flipped in soft decoding (Chase-II)
+#define SECDED3932_CHASE_NUM_POSITIONS  3
+
 // P matrix [7 x 32 bits], [7 x 4 bytes]
 //  1000 1010 1000 0010 0000 1111 0001 1011
 //  0001 0000 0001 1111 0111 0001 0110 0001
@@ -68,48 +71,64 @@ unsigned char secded3932_syndrome_w1[39] = {
     0x01, 0x02, 0x04, 0x08, 
     0x10, 0x20, 0x40};
 
-// compute parity on 32-bit input
-unsigned char fec_secded3932_compute_parity(unsigned char * _m)
+// look-up tables, built from P and the weight-1 syndromes when the
+// library is loaded: parity contribution of each byte value at each
+// position, and the decoding outcome for each syndrome
+static unsigned char secded3932_parity_tab[4][256];
+static unsigned char secded3932_ehat_flag[256];  // 0/1/2 errors detected
+static unsigned char secded3932_ehat_byte[256];  // index of erroneous byte
+static unsigned char secded3932_ehat_mask[256];  // erroneous bit in byte
+static unsigned char secded3932_ehat_pos[256];   // erroneous bit in symbol
+static int           secded3932_tables_ready = 0;
+
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void fec_secded3932_init_tables(void)
 {
-    // compute encoded/transmitted message: v = m*G
-    unsigned char parity = 0x00;
-
-    // TODO : unwrap this loop
-    unsigned int i;
-    for (i=0; i<7; i++) {
-        parity <<= 1;
-
-        unsigned int p = liquid_c_ones[ secded3932_P[4*i+0] & _m[0] ] +
-                         liquid_c_ones[ secded3932_P[4*i+1] & _m[1] ] +
-                         liquid_c_ones[ secded3932_P[4*i+2] & _m[2] ] +
-                         liquid_c_ones[ secded3932_P[4*i+3] & _m[3] ];
+    unsigned int i, k, b, n;
+    for (k=0; k<4; k++) {
+        for (b=0; b<256; b++) {
+            unsigned char parity = 0x00;
+            for (i=0; i<7; i++)
+                parity = (parity << 1) | (liquid_c_ones[ secded3932_P[4*i+k] & b ] & 0x01);
+            secded3932_parity_tab[k][b] = parity;
+        }
+    }
 
-        parity |= p & 0x01;
+    for (b=0; b<256; b++) {
+        secded3932_ehat_flag[b] = b ? 2 : 0;
+        secded3932_ehat_byte[b] = 0;
+        secded3932_ehat_mask[b] = 0;
+        secded3932_ehat_pos[b]  = 0;
+    }
+    for (n=0; n<39; n++) {
+        unsigned char s = secded3932_syndrome_w1[n];
+        secded3932_ehat_flag[s] = 1;
+        secded3932_ehat_byte[s] = 5-n/8-1;
+        secded3932_ehat_mask[s] = 1 << (n%8);
+        secded3932_ehat_pos[s]  = 39-n;
     }
+    secded3932_tables_ready = 1;
+}
+
+// compute parity on 32-bit input
+unsigned char fec_secded3932_compute_parity(unsigned char * _m)
+{
+    if (!secded3932_tables_ready)
+        fec_secded3932_init_tables();
 
-    return parity;
+    return secded3932_parity_tab[0][_m[0]] ^
+           secded3932_parity_tab[1][_m[1]] ^
+           secded3932_parity_tab[2][_m[2]] ^
+           secded3932_parity_tab[3][_m[3]];
 }
 
 // compute syndrome on 39-bit input
 unsigned char fec_secded3932_compute_syndrome(unsigned char * _v)
 {
-    // TODO : unwrap this loop
-    unsigned int i;
-    unsigned char syndrome = 0x00;
-    for (i=0; i<7; i++) {
-        syndrome <<= 1;
-
-        unsigned int p =
-            ( (_v[0] & (1<<(7-i-1))) ? 1 : 0 )+
-            liquid_c_ones[ secded3932_P[4*i+0] & _v[1] ] +
-            liquid_c_ones[ secded3932_P[4*i+1] & _v[2] ] +
-            liquid_c_ones[ secded3932_P[4*i+2] & _v[3] ] +
-            liquid_c_ones[ secded3932_P[4*i+3] & _v[4] ];
-
-        syndrome |= p & 0x01;
-    }
-
-    return syndrome;
+    // syndrome is received parity plus parity computed on received data
+    return (_v[0] & 0x7f) ^ fec_secded3932_compute_parity(&_v[1]);
 }
 
 // encode symbol
@@ -182,32 +201,11 @@ int fec_secded3932_estimate_ehat(unsigned char * _sym_enc,
     // compute syndrome vector, s = r*H^T = ( H*r^T )^T
     unsigned char s = fec_secded3932_compute_syndrome(_sym_enc);
 
-    // compute weight of s
-    unsigned int ws = liquid_c_ones[s];
-    
-    if (ws == 0) {
-        // no errors detected
-        return 0;
-    } else {
-        // estimate error location; search for syndrome with error
-        // vector of weight one
-
-        unsigned int n;
-        // estimate error location
-        for (n=0; n<39; n++) {
-            if (s == secded3932_syndrome_w1[n]) {
-                // single error detected at location 'n'
-                div_t d = div(n,8);
-                _e_hat[5-d.quot-1] = 1 << d.rem;
-
-                return 1;
-            }
-        }
-
-    }
+    // look up error location (single error only)
+    if (secded3932_ehat_flag[s] == 1)
+        _e_hat[secded3932_ehat_byte[s]] = secded3932_ehat_mask[s];
 
-    // no syndrome match; multiple errors detected
-    return 2;
+    return secded3932_ehat_flag[s];
 }
 
 // create SEC-DED (39,32) codec object
@@ -222,7 +220,7 @@ fec fec_secded3932_create(void * _opts)
     // set internal function pointers
     q->encode_func      = &fec_secded3932_encode;
     q->decode_func      = &fec_secded3932_decode;
-    q->decode_soft_func = NULL;
+    q->decode_soft_func = &fec_secded3932_decode_soft;
 
     return q;
 }
@@ -317,8 +315,11 @@ void fec_secded3932_decode(fec _q,
     unsigned int r = _dec_msg_len % 4;
 
     for (i=0; i<_dec_msg_len-r; i+=4) {
-        // decode straight to output
-        fec_secded3932_decode_symbol(&_msg_enc[j], &_msg_dec[i]);
+        // correct single errors in data bytes directly
+        unsigned char s = fec_secded3932_compute_syndrome(&_msg_enc[j]);
+        memmove(&_msg_dec[i], &_msg_enc[j+1], 4);
+        if (secded3932_ehat_byte[s] > 0)
+            _msg_dec[i + secded3932_ehat_byte[s] - 1] ^= secded3932_ehat_mask[s];
 
         j += 5;
     }
@@ -351,3 +352,81 @@ void fec_secded3932_decode(fec _q,
 
     //return num_errors;
 }
+
+// decode block of data using SEC-DED (39,32) soft decoder
+//
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: 8*_enc_msg_len x 1]
+//  _msg_dec        :   decoded message [size: _dec_msg_len x 1]
+void fec_secded3932_decode_soft(fec _q,
+                                unsigned int _dec_msg_len,
+                                unsigned char *_msg_enc,
+                                unsigned char *_msg_dec)
+{
+    unsigned int i=0;       // decoded byte counter
+    unsigned int k=0;       // soft bit counter
+
+    // hard decisions for the whole message; only symbols with a
+    // non-zero syndrome are decoded from their soft bits
+    unsigned int enc_msg_len = fec_get_enc_msg_length(LIQUID_FEC_SECDED3932,_dec_msg_len);
+    unsigned char v_hard[enc_msg_len];
+    fecsoft_hard_decision(_msg_enc, enc_msg_len, v_hard);
+
+    // determine remainder of input length / 4
+    unsigned int r = _dec_msg_len % 4;
+
+    for (i=0; i<_dec_msg_len-r; i+=4) {
+        if (fec_secded3932_compute_syndrome(&v_hard[k/8]) == 0)
+            memmove(&_msg_dec[i], &v_hard[k/8+1], 4);
+        else
+            fecsoft_secded3932_decode(&_msg_enc[k], &_msg_dec[i]);
+        k += 40;
+    }
+
+    // if input length isn't divisible by 4, decode last several bytes
+    if (r) {
+        // one 39-bit symbol (soft bits); bytes artificially set to
+        // zero at the receiver are taken as certain
+        unsigned char v[40];
+        memset(v, 0x00, sizeof(v));
+        memmove(v, &_msg_enc[k], 8*(r+1));
+
+        // one 32-bit symbol (decoded)
+        unsigned char m_hat[4];
+        fecsoft_secded3932_decode(v, m_hat);
+
+        // copy non-zero bytes to output
+        memmove(&_msg_dec[i], m_hat, r);
+
+        i += r;
+        k += 8*(r+1);
+    }
+
+    assert( k == 8*enc_msg_len );
+    assert( i == _dec_msg_len);
+}
+
+// error locator for soft decoding: errors detected for syndrome, and
+// position of erroneous bit for a single error
+static int fecsoft_secded3932_locate(unsigned char  _s,
+                                      unsigned int * _pos)
+{
+    *_pos = secded3932_ehat_pos[_s];
+    return secded3932_ehat_flag[_s];
+}
+
+// soft decoding of one symbol (Chase-II, see fecsoft_chase_decode())
+//  _soft_bits  :   soft bits of encoded symbol [size: 40 x 1]
+//  _sym_dec    :   decoded symbol [size: 4 x 1]
+void fecsoft_secded3932_decode(unsigned char * _soft_bits,
+                              unsigned char * _sym_dec)
+{
+    if (!secded3932_tables_ready)
+        fec_secded3932_init_tables();
+
+    fecsoft_chase_decode(_soft_bits, 39, 1, 4, SECDED3932_CHASE_NUM_POSITIONS,
+                         fec_secded3932_compute_syndrome,
+                         fecsoft_secded3932_locate,
+                         _sym_dec);
+}
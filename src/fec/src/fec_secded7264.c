@@ -37,6 +37,9 @@
 
 #define DEBUG_FEC_SECDED7264 0
 
+// number of least reliable bits flipped in soft decoding (Chase-II)
+#define SECDED7264_CHASE_NUM_POSITIONS  3
+
 // P matrix [8 x 64]
 //  11111111 00001111 00001111 00001100 01101000 10001000 10001000 10000000 : 
 //  11110000 11111111 00000000 11110011 01100100 01000100 01000100 01000000 : 
@@ -68,57 +71,69 @@ unsigned char secded7264_syndrome_w1[72] = {
     0x91, 0x92, 0x94, 0x98, 0xe0, 0xec, 0xdc, 0xd0,
     0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
 
+// look-up tables, built from P and the weight-1 syndromes when the
+// library is loaded: parity contribution of each byte value at each
+// position, and the decoding outcome for each syndrome
+static unsigned char secded7264_parity_tab[8][256];
+static unsigned char secded7264_ehat_flag[256];  // 0/1/2 errors detected
+static unsigned char secded7264_ehat_byte[256];  // index of erroneous byte
+static unsigned char secded7264_ehat_mask[256];  // erroneous bit in byte
+static unsigned char secded7264_ehat_pos[256];   // erroneous bit in symbol
+static int           secded7264_tables_ready = 0;
+
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void fec_secded7264_init_tables(void)
+{
+    unsigned int i, k, b, n;
+    for (k=0; k<8; k++) {
+        for (b=0; b<256; b++) {
+            unsigned char parity = 0x00;
+            for (i=0; i<8; i++)
+                parity = (parity << 1) | (liquid_c_ones[ secded7264_P[8*i+k] & b ] & 0x01);
+            secded7264_parity_tab[k][b] = parity;
+        }
+    }
+
+    for (b=0; b<256; b++) {
+        secded7264_ehat_flag[b] = b ? 2 : 0;
+        secded7264_ehat_byte[b] = 0;
+        secded7264_ehat_mask[b] = 0;
+        secded7264_ehat_pos[b]  = 0;
+    }
+    for (n=0; n<72; n++) {
+        unsigned char s = secded7264_syndrome_w1[n];
+        secded7264_ehat_flag[s] = 1;
+        secded7264_ehat_byte[s] = 9-n/8-1;
+        secded7264_ehat_mask[s] = 1 << (n%8);
+        secded7264_ehat_pos[s]  = 71-n;
+    }
+    secded7264_tables_ready = 1;
+}
+
 
 // compute parity byte on 64-byte input
 unsigned char fec_secded7264_compute_parity(unsigned char * _v)
 {
-    // compute parity byte on message
-    unsigned int i;
-    unsigned char parity = 0x00;
-    for (i=0; i<8; i++) {
-        parity <<= 1;
-
-        unsigned int p = liquid_c_ones[ secded7264_P[8*i+0] & _v[0] ] +
-                         liquid_c_ones[ secded7264_P[8*i+1] & _v[1] ] +
-                         liquid_c_ones[ secded7264_P[8*i+2] & _v[2] ] +
-                         liquid_c_ones[ secded7264_P[8*i+3] & _v[3] ] +
-                         liquid_c_ones[ secded7264_P[8*i+4] & _v[4] ] +
-                         liquid_c_ones[ secded7264_P[8*i+5] & _v[5] ] +
-                         liquid_c_ones[ secded7264_P[8*i+6] & _v[6] ] +
-                         liquid_c_ones[ secded7264_P[8*i+7] & _v[7] ];
-
-        parity |= p & 0x01;
-    }
-
-    // return parity byte
-    return parity;
+    if (!secded7264_tables_ready)
+        fec_secded7264_init_tables();
+
+    return secded7264_parity_tab[0][_v[0]] ^
+           secded7264_parity_tab[1][_v[1]] ^
+           secded7264_parity_tab[2][_v[2]] ^
+           secded7264_parity_tab[3][_v[3]] ^
+           secded7264_parity_tab[4][_v[4]] ^
+           secded7264_parity_tab[5][_v[5]] ^
+           secded7264_parity_tab[6][_v[6]] ^
+           secded7264_parity_tab[7][_v[7]];
 }
 
 // compute syndrome on 72-bit input
 unsigned char fec_secded7264_compute_syndrome(unsigned char * _v)
 {
-    // TODO : unwrap this loop
-    unsigned int i;
-    unsigned char syndrome = 0x00;
-    for (i=0; i<8; i++) {
-        syndrome <<= 1;
-
-        // compute parity bit
-        unsigned int p =
-            ( (_v[0] & (1<<(8-i-1))) ? 1 : 0 ) +
-            liquid_c_ones[ secded7264_P[8*i+0] & _v[1] ] +
-            liquid_c_ones[ secded7264_P[8*i+1] & _v[2] ] +
-            liquid_c_ones[ secded7264_P[8*i+2] & _v[3] ] +
-            liquid_c_ones[ secded7264_P[8*i+3] & _v[4] ] +
-            liquid_c_ones[ secded7264_P[8*i+4] & _v[5] ] +
-            liquid_c_ones[ secded7264_P[8*i+5] & _v[6] ] +
-            liquid_c_ones[ secded7264_P[8*i+6] & _v[7] ] +
-            liquid_c_ones[ secded7264_P[8*i+7] & _v[8] ];
-
-        syndrome |= p & 0x01;
-    }
-
-    return syndrome;
+    // syndrome is received parity plus parity computed on received data
+    return _v[0] ^ fec_secded7264_compute_parity(&_v[1]);
 }
 
 void fec_secded7264_encode_symbol(unsigned char * _sym_dec,
@@ -185,32 +200,11 @@ int fec_secded7264_estimate_ehat(unsigned char * _sym_enc,
     // compute syndrome vector, s = r*H^T = ( H*r^T )^T
     unsigned char s = fec_secded7264_compute_syndrome(_sym_enc);
 
-    // compute weight of s
-    unsigned int ws = liquid_c_ones[s];
-    
-    if (ws == 0) {
-        // no errors detected
-        return 0;
-    } else {
-        // estimate error location; search for syndrome with error
-        // vector of weight one
-
-        unsigned int n;
-        // estimate error location
-        for (n=0; n<72; n++) {
-            if (s == secded7264_syndrome_w1[n]) {
-                // single error detected at location 'n'
-                div_t d = div(n,8);
-                _e_hat[9-d.quot-1] = 1 << d.rem;
-
-                return 1;
-            }
-        }
-
-    }
+    // look up error location (single error only)
+    if (secded7264_ehat_flag[s] == 1)
+        _e_hat[secded7264_ehat_byte[s]] = secded7264_ehat_mask[s];
 
-    // no syndrome match; multiple errors detected
-    return 2;
+    return secded7264_ehat_flag[s];
 }
 
 // create SEC-DED (72,64) codec object
@@ -225,7 +219,7 @@ fec fec_secded7264_create(void * _opts)
     // set internal function pointers
     q->encode_func      = &fec_secded7264_encode;
     q->decode_func      = &fec_secded7264_decode;
-    q->decode_soft_func = NULL;
+    q->decode_soft_func = &fec_secded7264_decode_soft;
 
     return q;
 }
@@ -307,8 +301,11 @@ void fec_secded7264_decode(fec _q,
     unsigned int r = _dec_msg_len % 8;
 
     for (i=0; i<_dec_msg_len-r; i+=8) {
-        // decode nine input bytes
-        fec_secded7264_decode_symbol(&_msg_enc[j], &_msg_dec[i]);
+        // correct single errors in data bytes directly
+        unsigned char s = fec_secded7264_compute_syndrome(&_msg_enc[j]);
+        memmove(&_msg_dec[i], &_msg_enc[j+1], 8);
+        if (secded7264_ehat_byte[s] > 0)
+            _msg_dec[i + secded7264_ehat_byte[s] - 1] ^= secded7264_ehat_mask[s];
 
         j += 9;
     }
@@ -340,3 +337,81 @@ void fec_secded7264_decode(fec _q,
 
     //return num_errors;
 }
+
+// decode block of data using SEC-DED (72,64) soft decoder
+//
+//  _q              :   encoder/decoder object
+//  _dec_msg_len    :   decoded message length (number of bytes)
+//  _msg_enc        :   encoded message [size: 8*_enc_msg_len x 1]
+//  _msg_dec        :   decoded message [size: _dec_msg_len x 1]
+void fec_secded7264_decode_soft(fec _q,
+                                unsigned int _dec_msg_len,
+                                unsigned char *_msg_enc,
+                                unsigned char *_msg_dec)
+{
+    unsigned int i=0;       // decoded byte counter
+    unsigned int k=0;       // soft bit counter
+
+    // hard decisions for the whole message; only symbols with a
+    // non-zero syndrome are decoded from their soft bits
+    unsigned int enc_msg_len = fec_get_enc_msg_length(LIQUID_FEC_SECDED7264,_dec_msg_len);
+    unsigned char v_hard[enc_msg_len];
+    fecsoft_hard_decision(_msg_enc, enc_msg_len, v_hard);
+
+    // determine remainder of input length / 8
+    unsigned int r = _dec_msg_len % 8;
+
+    for (i=0; i<_dec_msg_len-r; i+=8) {
+        if (fec_secded7264_compute_syndrome(&v_hard[k/8]) == 0)
+            memmove(&_msg_dec[i], &v_hard[k/8+1], 8);
+        else
+            fecsoft_secded7264_decode(&_msg_enc[k], &_msg_dec[i]);
+        k += 72;
+    }
+
+    // if input length isn't divisible by 8, decode last several bytes
+    if (r) {
+        // one 72-bit symbol (soft bits); bytes artificially set to
+        // zero at the receiver are taken as certain
+        unsigned char v[72];
+        memset(v, 0x00, sizeof(v));
+        memmove(v, &_msg_enc[k], 8*(r+1));
+
+        // one 64-bit symbol (decoded)
+        unsigned char m_hat[8];
+        fecsoft_secded7264_decode(v, m_hat);
+
+        // copy non-zero bytes to output
+        memmove(&_msg_dec[i], m_hat, r);
+
+        i += r;
+        k += 8*(r+1);
+    }
+
+    assert( k == 8*enc_msg_len );
+    assert( i == _dec_msg_len);
+}
+
+// error locator for soft decoding: errors detected for syndrome, and
+// position of erroneous bit for a single error
+static int fecsoft_secded7264_locate(unsigned char  _s,
+                                      unsigned int * _pos)
+{
+    *_pos = secded7264_ehat_pos[_s];
+    return secded7264_ehat_flag[_s];
+}
+
+// soft decoding of one symbol (Chase-II, see fecsoft_chase_decode())
+//  _soft_bits  :   soft bits of encoded symbol [size: 72 x 1]
+//  _sym_dec    :   decoded symbol [size: 8 x 1]
+void fecsoft_secded7264_decode(unsigned char * _soft_bits,
+                              unsigned char * _sym_dec)
+{
+    if (!secded7264_tables_ready)
+        fec_secded7264_init_tables();
+
+    fecsoft_chase_decode(_soft_bits, 72, 0, 8, SECDED7264_CHASE_NUM_POSITIONS,
+                         fec_secded7264_compute_syndrome,
+                         fecsoft_secded7264_locate,
+                         _sym_dec);
+}
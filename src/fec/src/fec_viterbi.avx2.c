@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fec_viterbi.avx2.c : Viterbi add-compare-select (AVX2)
+//
+// This file is compiled with -mavx2 regardless of the build host; the
+// kernel is only called when the processor reports support for AVX2
+// at run time. Results are bit-exact with fec_viterbi_acs_port().
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX2
+
+// add-compare-select over all butterflies for one trellis step
+static inline __attribute__((always_inline))
+void fec_viterbi_acs_avx2_step(const int16_t *       _bt,
+                               const unsigned char * _idx,
+                               unsigned int          _R,
+                               unsigned int          _half,
+                               const unsigned char * _sym,
+                               const int16_t *       _old,
+                               int16_t *             _new,
+                               uint32_t *            _d)
+{
+    // branch metrics for input bit 0 for each combination of inverted
+    // polynomial outputs
+    __m256i bm[1<<_R];
+    __m256i ones = _mm256_set1_epi16(255);
+    unsigned int c, i, r;
+    __m256i v = _mm256_xor_si256(_mm256_load_si256((__m256i*)&_bt[0]), _mm256_set1_epi16(_sym[0]));
+    bm[0] = v;
+    bm[1] = _mm256_xor_si256(v, ones);
+    for (r=1; r<_R; r++) {
+        v = _mm256_xor_si256(_mm256_load_si256((__m256i*)&_bt[r*16]), _mm256_set1_epi16(_sym[r]));
+        __m256i w = _mm256_xor_si256(v, ones);
+        for (c=0; c<(1u<<r); c++) {
+            bm[c + (1<<r)] = _mm256_add_epi16(bm[c], w);
+            bm[c]          = _mm256_add_epi16(bm[c], v);
+        }
+    }
+
+    // metrics are kept relative to state zero
+    unsigned int mask = (1<<_R) - 1;
+    __m256i norm = _mm256_set1_epi16(_old[0]);
+
+    for (i=0; i<_half; i+=16) {
+        unsigned int k = _idx[i/16];
+        __m256i b0 = bm[k];
+        __m256i b1 = bm[k ^ mask];  // complement: M - b0
+
+        __m256i a = _mm256_sub_epi16(_mm256_load_si256((__m256i*)&_old[i]),       norm);
+        __m256i b = _mm256_sub_epi16(_mm256_load_si256((__m256i*)&_old[i+_half]), norm);
+
+        // add, compare, select
+        __m256i m00 = _mm256_adds_epi16(a, b0);
+        __m256i m01 = _mm256_adds_epi16(b, b1);
+        __m256i m10 = _mm256_adds_epi16(a, b1);
+        __m256i m11 = _mm256_adds_epi16(b, b0);
+        __m256i n0  = _mm256_min_epi16(m00, m01);
+        __m256i n1  = _mm256_min_epi16(m10, m11);
+        __m256i d0  = _mm256_cmpgt_epi16(m00, m01);
+        __m256i d1  = _mm256_cmpgt_epi16(m10, m11);
+
+        // interleave within 128-bit lanes: lo holds new states
+        // [0,8) and [16,24), hi holds [8,16) and [24,32)
+        __m256i lo = _mm256_unpacklo_epi16(n0, n1);
+        __m256i hi = _mm256_unpackhi_epi16(n0, n1);
+        _mm256_store_si256((__m256i*)&_new[2*i],    _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_store_si256((__m256i*)&_new[2*i+16], _mm256_permute2x128_si256(lo, hi, 0x31));
+
+        // the in-lane pack restores new-state order for the decisions
+        __m256i dv = _mm256_packs_epi16(_mm256_unpacklo_epi16(d0, d1),
+                                        _mm256_unpackhi_epi16(d0, d1));
+        _d[i/16] = (uint32_t) _mm256_movemask_epi8(dv);
+    }
+}
+
+// run trellis steps with a constant _R so that the branch-metric table
+// construction is unrolled
+static inline __attribute__((always_inline))
+void fec_viterbi_acs_avx2_R(const int16_t *       _bt,
+                            const unsigned char * _idx,
+                            unsigned int          _R,
+                            unsigned int          _half,
+                            const unsigned char * _sym,
+                            unsigned int          _num_steps,
+                            int16_t *             _m0,
+                            int16_t *             _m1,
+                            uint32_t *            _d)
+{
+    unsigned int n;
+    for (n=0; n<_num_steps; n++) {
+        fec_viterbi_acs_avx2_step(_bt, _idx, _R, _half, &_sym[n*_R],
+                                  n%2 ? _m1 : _m0, n%2 ? _m0 : _m1,
+                                  &_d[n*_half/16]);
+    }
+}
+
+// AVX2 add-compare-select kernel, sixteen butterflies at a time
+void fec_viterbi_acs_avx2(const int16_t *       _bt,
+                          const unsigned char * _idx,
+                          unsigned int          _R,
+                          unsigned int          _half,
+                          const unsigned char * _sym,
+                          unsigned int          _num_steps,
+                          int16_t *             _m0,
+                          int16_t *             _m1,
+                          uint32_t *            _d)
+{
+    switch (_R) {
+    case 2:  fec_viterbi_acs_avx2_R(_bt, _idx, 2,  _half, _sym, _num_steps, _m0, _m1, _d); break;
+    case 3:  fec_viterbi_acs_avx2_R(_bt, _idx, 3,  _half, _sym, _num_steps, _m0, _m1, _d); break;
+    case 6:  fec_viterbi_acs_avx2_R(_bt, _idx, 6,  _half, _sym, _num_steps, _m0, _m1, _d); break;
+    default: fec_viterbi_acs_avx2_R(_bt, _idx, _R, _half, _sym, _num_steps, _m0, _m1, _d);
+    }
+}
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fec_viterbi.c
+//
+// Soft-decision Viterbi decoder for the rate 1/r convolutional codes
+// (v27, v29, v39, v615). The trellis state is the last K-1 input bits
+// with the newest bit in the least-significant position, matching the
+// shift register in fec_conv_encode(). Path metrics are 16-bit signed
+// distances kept relative to the metric of state zero; any state is
+// reachable from any other in K-1 steps so their spread never exceeds
+// (K-1)*M for the maximum branch metric M = 255*r, which fits for all
+// supported codes. The add-compare-select (ACS) step is selected at
+// run time between the portable, SSE2 and AVX2 kernels which all
+// produce bit-exact results.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// initial metric for states other than the (known) starting state
+#define FEC_VITERBI_INIT_METRIC(_M) (2*(_M))
+
+// saturate to 16-bit signed metric range
+#define FEC_VITERBI_SAT(_m) ((_m) > 32767 ? 32767 : (_m))
+
+struct fec_viterbi_s {
+    unsigned int K;             // constraint length
+    unsigned int R;             // inverse rate (number of polynomials)
+    unsigned int num_states;    // number of trellis states, 2^(K-1)
+    unsigned int num_words;     // decision words per step, num_states/32
+    unsigned int max_steps;     // maximum number of trellis steps
+    unsigned int num_steps;     // number of steps since reset
+
+    int16_t * bt;               // branch table, low state bits [R x 16]
+    unsigned char * idx;        // branch table index per block [num_states/32]
+    int16_t * metric0;          // path metrics (aligned) [num_states]
+    int16_t * metric1;          // path metrics (aligned) [num_states]
+    uint32_t * decisions;       // decision bits [max_steps x num_words]
+
+    // add-compare-select kernel
+    fec_viterbi_acs_func acs;
+};
+
+// allocate memory aligned to 32 bytes for vector loads/stores
+static void * fec_viterbi_malloc(size_t _n)
+{
+    void * p = NULL;
+    if (posix_memalign(&p, 32, _n) != 0) {
+        fprintf(stderr,"error: fec_viterbi_create(), could not allocate memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+// create Viterbi decoder
+//  _K          :   constraint length, 6 <= _K <= 16
+//  _R          :   inverse rate (number of polynomials), 1 <= _R <= 8
+//  _poly       :   generator polynomials [size: _R x 1]
+//  _num_bits   :   maximum number of decoded bits (excluding tail)
+fec_viterbi fec_viterbi_create(unsigned int _K,
+                               unsigned int _R,
+                               int *        _poly,
+                               unsigned int _num_bits)
+{
+    // validate input
+    if (_K < 6 || _K > 16) {
+        fprintf(stderr,"error: fec_viterbi_create(), constraint length must be in [6,16]\n");
+        exit(1);
+    } else if (_R < 1 || _R > 8) {
+        fprintf(stderr,"error: fec_viterbi_create(), inverse rate must be in [1,8]\n");
+        exit(1);
+    }
+
+    // the butterfly structure relies on the first and last register
+    // taps of every polynomial being set
+    unsigned int r;
+    for (r=0; r<_R; r++) {
+        if ( (_poly[r] & 1) == 0 || ((_poly[r] >> (_K-1)) & 1) == 0 ) {
+            fprintf(stderr,"error: fec_viterbi_create(), polynomial 0x%x does not span constraint length\n", _poly[r]);
+            exit(1);
+        }
+    }
+
+    fec_viterbi q = (fec_viterbi) malloc(sizeof(struct fec_viterbi_s));
+    q->K          = _K;
+    q->R          = _R;
+    q->num_states = 1 << (_K-1);
+    q->num_words  = q->num_states / 32;
+    q->max_steps  = _num_bits + _K - 1;
+
+    // branch table: expected (hard) symbol for the transition from state
+    // i with input bit 0; all other branches of the butterfly are either
+    // the same or the complement. Parity is linear in i, so the table is
+    // split into the sixteen low-order states and, for each block of
+    // sixteen, a bit mask of the polynomials whose output is inverted.
+    unsigned int half = q->num_states / 2;
+    q->bt  = (int16_t*) fec_viterbi_malloc(_R*16*sizeof(int16_t));
+    q->idx = (unsigned char*) malloc(half/16*sizeof(unsigned char));
+    unsigned int i;
+    for (r=0; r<_R; r++) {
+        for (i=0; i<16; i++)
+            q->bt[r*16 + i] = liquid_count_ones_mod2((2*i) & _poly[r]) ? 255 : 0;
+    }
+    for (i=0; i<half/16; i++) {
+        q->idx[i] = 0;
+        for (r=0; r<_R; r++)
+            q->idx[i] |= liquid_count_ones_mod2((32*i) & _poly[r]) << r;
+    }
+
+    q->metric0   = (int16_t*) fec_viterbi_malloc(q->num_states*sizeof(int16_t));
+    q->metric1   = (int16_t*) fec_viterbi_malloc(q->num_states*sizeof(int16_t));
+    q->decisions = (uint32_t*)fec_viterbi_malloc(q->max_steps*q->num_words*sizeof(uint32_t));
+
+    // select add-compare-select kernel
+    q->acs = fec_viterbi_acs_port;
+#if defined(__SSE2__)
+    if (liquid_cpu_has(LIQUID_CPU_SSE2))
+        q->acs = fec_viterbi_acs_sse2;
+#endif
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2))
+        q->acs = fec_viterbi_acs_avx2;
+#endif
+
+    fec_viterbi_reset(q);
+    return q;
+}
+
+// destroy Viterbi decoder, freeing all internal memory
+void fec_viterbi_destroy(fec_viterbi _q)
+{
+    free(_q->bt);
+    free(_q->idx);
+    free(_q->metric0);
+    free(_q->metric1);
+    free(_q->decisions);
+    free(_q);
+}
+
+// reset decoder to the all-zeros starting state
+void fec_viterbi_reset(fec_viterbi _q)
+{
+    int16_t m = FEC_VITERBI_INIT_METRIC(255*_q->R);
+    unsigned int i;
+    for (i=0; i<_q->num_states; i++)
+        _q->metric0[i] = m;
+    _q->metric0[0] = 0;
+    _q->num_steps  = 0;
+}
+
+// run trellis over soft-decision input symbols
+//  _q          :   decoder object
+//  _sym        :   soft bits, _R per step, 0 (strong 0) to 255 (strong 1)
+//  _num_steps  :   number of trellis steps (decoded bits + K-1 tail)
+void fec_viterbi_update(fec_viterbi    _q,
+                        unsigned char * _sym,
+                        unsigned int    _num_steps)
+{
+    if (_q->num_steps + _num_steps > _q->max_steps) {
+        fprintf(stderr,"error: fec_viterbi_update(), too many steps (%u > %u)\n",
+                _q->num_steps + _num_steps, _q->max_steps);
+        exit(1);
+    }
+
+    _q->acs(_q->bt, _q->idx, _q->R, _q->num_states/2, _sym, _num_steps,
+            _q->metric0, _q->metric1,
+            &_q->decisions[_q->num_steps*_q->num_words]);
+    _q->num_steps += _num_steps;
+
+    // kernel alternates between buffers; keep current metrics in metric0
+    if (_num_steps % 2) {
+        int16_t * tmp = _q->metric0;
+        _q->metric0   = _q->metric1;
+        _q->metric1   = tmp;
+    }
+}
+
+// trace back through the trellis from the all-zeros end state reached
+// after the K-1 tail bits, writing packed bits (msb first) to _msg_dec
+//  _q          :   decoder object
+//  _msg_dec    :   decoded message [size: ceil(_num_bits/8) x 1]
+//  _num_bits   :   number of decoded bits
+void fec_viterbi_chainback(fec_viterbi     _q,
+                           unsigned char * _msg_dec,
+                           unsigned int    _num_bits)
+{
+    if (_num_bits + _q->K - 1 != _q->num_steps) {
+        fprintf(stderr,"error: fec_viterbi_chainback(), expected %u steps but trellis has %u\n",
+                _num_bits + _q->K - 1, _q->num_steps);
+        exit(1);
+    }
+
+    memset(_msg_dec, 0x00, (_num_bits+7)/8);
+
+    // decision for the state after step n is the bit shifted out of the
+    // register, i.e. input bit n-(K-1); skip past the tail
+    unsigned int s = 0;
+    unsigned int n;
+    for (n=_num_bits; n>0; n--) {
+        uint32_t * d = &_q->decisions[(n+_q->K-2)*_q->num_words];
+        unsigned int bit = (d[s/32] >> (s%32)) & 1;
+        s = (s >> 1) | (bit << (_q->K-2));
+        _msg_dec[(n-1)/8] |= bit << (7 - ((n-1)%8));
+    }
+}
+
+// portable add-compare-select; one trellis step over all states
+static void fec_viterbi_acs_port_step(const int16_t *       _bt,
+                                      const unsigned char * _idx,
+                                      unsigned int          _R,
+                                      unsigned int          _half,
+                                      const unsigned char * _sym,
+                                      const int16_t *       _old,
+                                      int16_t *             _new,
+                                      uint32_t *            _d)
+{
+    // branch metrics for input bit 0 for each combination of inverted
+    // polynomial outputs [(1<<_R) x 16]
+    int bm[1<<_R][16];
+    unsigned int c, i, j, r;
+    for (i=0; i<16; i++) {
+        bm[0][i] = _bt[i] ^ _sym[0];
+        bm[1][i] = 255 - bm[0][i];
+    }
+    for (r=1; r<_R; r++) {
+        for (c=0; c<(1u<<r); c++) {
+            for (i=0; i<16; i++) {
+                int v = _bt[r*16+i] ^ _sym[r];
+                bm[c + (1<<r)][i] = bm[c][i] + 255 - v;
+                bm[c][i]         += v;
+            }
+        }
+    }
+
+    // metrics are kept relative to state zero
+    int M    = 255*_R;
+    int norm = _old[0];
+    for (j=0; j<_half/16; j++) {
+        _d[j] = 0;
+        for (i=0; i<16; i++) {
+            unsigned int k = 16*j + i;
+            int a  = _old[k]       - norm;
+            int b  = _old[k+_half] - norm;
+            int b0 = bm[_idx[j]][i];
+
+            // new state 2k (input bit 0)
+            int m0 = FEC_VITERBI_SAT(a + b0);
+            int m1 = FEC_VITERBI_SAT(b + M - b0);
+            int d0 = m0 > m1;
+            _new[2*k] = d0 ? m1 : m0;
+
+            // new state 2k+1 (input bit 1)
+            m0 = FEC_VITERBI_SAT(a + M - b0);
+            m1 = FEC_VITERBI_SAT(b + b0);
+            int d1 = m0 > m1;
+            _new[2*k+1] = d1 ? m1 : m0;
+
+            _d[j] |= (uint32_t)(d0 | (d1 << 1)) << (2*i);
+        }
+    }
+}
+
+// portable add-compare-select kernel
+void fec_viterbi_acs_port(const int16_t *       _bt,
+                          const unsigned char * _idx,
+                          unsigned int          _R,
+                          unsigned int          _half,
+                          const unsigned char * _sym,
+                          unsigned int          _num_steps,
+                          int16_t *             _m0,
+                          int16_t *             _m1,
+                          uint32_t *            _d)
+{
+    unsigned int n;
+    for (n=0; n<_num_steps; n++) {
+        fec_viterbi_acs_port_step(_bt, _idx, _R, _half, &_sym[n*_R],
+                                  n%2 ? _m1 : _m0, n%2 ? _m0 : _m1,
+                                  &_d[n*_half/16]);
+    }
+}
+
+#if defined(__SSE2__)
+// add-compare-select over all butterflies for one trellis step
+static inline __attribute__((always_inline))
+void fec_viterbi_acs_sse2_step(const int16_t *       _bt,
+                               const unsigned char * _idx,
+                               unsigned int          _R,
+                               unsigned int          _half,
+                               const unsigned char * _sym,
+                               const int16_t *       _old,
+                               int16_t *             _new,
+                               uint32_t *            _d)
+{
+    // branch metrics for input bit 0 for each combination of inverted
+    // polynomial outputs, low/high eight states of each block
+    __m128i bm[2<<_R];
+    __m128i ones = _mm_set1_epi16(255);
+    unsigned int c, i, r;
+    for (i=0; i<2; i++) {
+        __m128i s = _mm_set1_epi16(_sym[0]);
+        __m128i v = _mm_xor_si128(_mm_load_si128((__m128i*)&_bt[8*i]), s);
+        bm[0*2+i] = v;
+        bm[1*2+i] = _mm_xor_si128(v, ones);
+        for (r=1; r<_R; r++) {
+            s = _mm_set1_epi16(_sym[r]);
+            v = _mm_xor_si128(_mm_load_si128((__m128i*)&_bt[r*16+8*i]), s);
+            __m128i w = _mm_xor_si128(v, ones);
+            for (c=0; c<(1u<<r); c++) {
+                bm[(c + (1<<r))*2+i] = _mm_add_epi16(bm[c*2+i], w);
+                bm[c*2+i]            = _mm_add_epi16(bm[c*2+i], v);
+            }
+        }
+    }
+
+    // metrics are kept relative to state zero
+    unsigned int mask = (1<<_R) - 1;
+    __m128i norm = _mm_set1_epi16(_old[0]);
+    uint16_t * d = (uint16_t*) _d;
+
+    for (i=0; i<_half; i+=8) {
+        unsigned int k = _idx[i/16]*2 + (i/8)%2;
+        __m128i b0 = bm[k];
+        __m128i b1 = bm[k ^ (2*mask)];  // complement: M - b0
+
+        __m128i a = _mm_sub_epi16(_mm_load_si128((__m128i*)&_old[i]),       norm);
+        __m128i b = _mm_sub_epi16(_mm_load_si128((__m128i*)&_old[i+_half]), norm);
+
+        // add, compare, select
+        __m128i m00 = _mm_adds_epi16(a, b0);
+        __m128i m01 = _mm_adds_epi16(b, b1);
+        __m128i m10 = _mm_adds_epi16(a, b1);
+        __m128i m11 = _mm_adds_epi16(b, b0);
+        __m128i n0  = _mm_min_epi16(m00, m01);
+        __m128i n1  = _mm_min_epi16(m10, m11);
+        __m128i d0  = _mm_cmpgt_epi16(m00, m01);
+        __m128i d1  = _mm_cmpgt_epi16(m10, m11);
+
+        // interleave into new-state order
+        _mm_store_si128((__m128i*)&_new[2*i],   _mm_unpacklo_epi16(n0, n1));
+        _mm_store_si128((__m128i*)&_new[2*i+8], _mm_unpackhi_epi16(n0, n1));
+
+        __m128i dv = _mm_packs_epi16(_mm_unpacklo_epi16(d0, d1),
+                                     _mm_unpackhi_epi16(d0, d1));
+        d[i/8] = (uint16_t) _mm_movemask_epi8(dv);
+    }
+}
+
+// run trellis steps with a constant _R so that the branch-metric table
+// construction is unrolled
+static inline __attribute__((always_inline))
+void fec_viterbi_acs_sse2_R(const int16_t *       _bt,
+                            const unsigned char * _idx,
+                            unsigned int          _R,
+                            unsigned int          _half,
+                            const unsigned char * _sym,
+                            unsigned int          _num_steps,
+                            int16_t *             _m0,
+                            int16_t *             _m1,
+                            uint32_t *            _d)
+{
+    unsigned int n;
+    for (n=0; n<_num_steps; n++) {
+        fec_viterbi_acs_sse2_step(_bt, _idx, _R, _half, &_sym[n*_R],
+                                  n%2 ? _m1 : _m0, n%2 ? _m0 : _m1,
+                                  &_d[n*_half/16]);
+    }
+}
+
+// SSE2 add-compare-select kernel, eight butterflies at a time
+void fec_viterbi_acs_sse2(const int16_t *       _bt,
+                          const unsigned char * _idx,
+                          unsigned int          _R,
+                          unsigned int          _half,
+                          const unsigned char * _sym,
+                          unsigned int          _num_steps,
+                          int16_t *             _m0,
+                          int16_t *             _m1,
+                          uint32_t *            _d)
+{
+    switch (_R) {
+    case 2:  fec_viterbi_acs_sse2_R(_bt, _idx, 2,  _half, _sym, _num_steps, _m0, _m1, _d); break;
+    case 3:  fec_viterbi_acs_sse2_R(_bt, _idx, 3,  _half, _sym, _num_steps, _m0, _m1, _d); break;
+    case 6:  fec_viterbi_acs_sse2_R(_bt, _idx, 6,  _half, _sym, _num_steps, _m0, _m1, _d); break;
+    default: fec_viterbi_acs_sse2_R(_bt, _idx, _R, _half, _sym, _num_steps, _m0, _m1, _d);
+    }
+}
+#endif
@@ -25,10 +25,17 @@
 //
 // Create and initialize interleaver objects
 //
+// The interleaver applies up to four passes, each swapping (a masked set
+// of bits of) even-indexed bytes with odd-indexed bytes along a block
+// permutation. The byte pairs of each pass are computed once when the
+// object is created, and the soft-bit passes move the eight soft bits of
+// a byte with single 64-bit word operations.
+//
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -37,32 +44,29 @@
 // internal methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N);
-
-// permute one iteration (soft bit input)
-void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N);
+// compute byte pairs for one pass: bytes 2*i and _j[i] (odd) are swapped
+// for i in [0,_n/2)
+void interleaver_compute_pairs(unsigned int   _n,
+                               unsigned int   _M,
+                               unsigned int   _N,
+                               unsigned int * _j);
 
 // permute one iteration with mask
-void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
-                              unsigned char   _mask);
+void interleaver_permute_mask(unsigned char *      _x,
+                              unsigned int         _n,
+                              const unsigned int * _j,
+                              unsigned char        _mask);
 
 // permute one iteration (soft bit input) with mask
-void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
-                                   unsigned char   _mask);
+void interleaver_permute_mask_soft(unsigned char *      _x,
+                                   unsigned int         _n,
+                                   const unsigned int * _j,
+                                   unsigned char        _mask);
 
+// number of passes and the bits each one swaps
+#define INTERLEAVER_MAX_DEPTH   (4)
+static const unsigned char interleaver_pass_mask[INTERLEAVER_MAX_DEPTH] =
+    {0xff, 0x0f, 0x55, 0x33};
 
 // structured interleaver object
 struct interleaver_s {
@@ -73,6 +77,9 @@ struct interleaver_s {
 
     // interleaving depth (number of permutations)
     unsigned int depth;
+
+    // odd byte swapped with byte 2*i for each pass [size: 4 x n/2]
+    unsigned int * pairs;
 };
 
 // create interleaver of length _n input/output bytes
@@ -90,12 +97,23 @@ interleaver interleaver_create(unsigned int _n)
     q->N = q->n / q->M;
     while (q->n >= (q->M*q->N)) q->N++;  // ensures M*N >= n
 
+    // compute byte pairs for each pass; each pass increases the column
+    // dimension (N, N+2, N+4, N+8)
+    unsigned int n2 = q->n / 2;
+    unsigned int p;
+    q->pairs = (unsigned int*) malloc((INTERLEAVER_MAX_DEPTH*n2+1)*sizeof(unsigned int));
+    for (p=0; p<INTERLEAVER_MAX_DEPTH; p++)
+        interleaver_compute_pairs(q->n, q->M, q->N + (p ? 1<<p : 0), &q->pairs[p*n2]);
+
     return q;
 }
 
 // destroy interleaver object
 void interleaver_destroy(interleaver _q)
 {
+    // free internal arrays
+    free(_q->pairs);
+
     // free main object memory
     free(_q);
 }
@@ -127,10 +145,10 @@ void interleaver_encode(interleaver _q,
     // copy data to output
     memmove(_msg_enc, _msg_dec, _q->n);
 
-    if (_q->depth > 0) interleaver_permute(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    unsigned int n2 = _q->n / 2;
+    unsigned int p;
+    for (p=0; p<_q->depth && p<INTERLEAVER_MAX_DEPTH; p++)
+        interleaver_permute_mask(_msg_enc, _q->n, &_q->pairs[p*n2], interleaver_pass_mask[p]);
 }
 
 // execute forward interleaver (encoder) on soft bits
@@ -144,10 +162,10 @@ void interleaver_encode_soft(interleaver _q,
     // copy data to output
     memmove(_msg_enc, _msg_dec, 8*_q->n);
 
-    if (_q->depth > 0) interleaver_permute_soft(_msg_enc, _q->n, _q->M, _q->N);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_enc, _q->n, _q->M, _q->N+8, 0x33);
+    unsigned int n2 = _q->n / 2;
+    unsigned int p;
+    for (p=0; p<_q->depth && p<INTERLEAVER_MAX_DEPTH; p++)
+        interleaver_permute_mask_soft(_msg_enc, _q->n, &_q->pairs[p*n2], interleaver_pass_mask[p]);
 }
 
 // execute reverse interleaver (decoder)
@@ -161,10 +179,11 @@ void interleaver_decode(interleaver _q,
     // copy data to output
     memmove(_msg_dec, _msg_enc, _q->n);
 
-    if (_q->depth > 3) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute(_msg_dec, _q->n, _q->M, _q->N);
+    // each pass is its own inverse; apply in reverse order
+    unsigned int n2 = _q->n / 2;
+    unsigned int p = _q->depth < INTERLEAVER_MAX_DEPTH ? _q->depth : INTERLEAVER_MAX_DEPTH;
+    while (p--)
+        interleaver_permute_mask(_msg_dec, _q->n, &_q->pairs[p*n2], interleaver_pass_mask[p]);
 }
 
 // execute reverse interleaver (decoder) on soft bits
@@ -178,145 +197,85 @@ void interleaver_decode_soft(interleaver _q,
     // copy data to output
     memmove(_msg_dec, _msg_enc, 8*_q->n);
 
-    if (_q->depth > 3) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+8, 0x33);
-    if (_q->depth > 2) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+4, 0x55);
-    if (_q->depth > 1) interleaver_permute_mask_soft(_msg_dec, _q->n, _q->M, _q->N+2, 0x0f);
-    if (_q->depth > 0) interleaver_permute_soft(_msg_dec, _q->n, _q->M, _q->N);
+    unsigned int n2 = _q->n / 2;
+    unsigned int p = _q->depth < INTERLEAVER_MAX_DEPTH ? _q->depth : INTERLEAVER_MAX_DEPTH;
+    while (p--)
+        interleaver_permute_mask_soft(_msg_dec, _q->n, &_q->pairs[p*n2], interleaver_pass_mask[p]);
 }
 
 // 
 // internal permutation methods
 //
 
-// permute one iteration
-void interleaver_permute(unsigned char * _x,
-                         unsigned int    _n,
-                         unsigned int    _M,
-                         unsigned int    _N)
+// compute byte pairs for one pass
+void interleaver_compute_pairs(unsigned int   _n,
+                               unsigned int   _M,
+                               unsigned int   _N,
+                               unsigned int * _j)
 {
-    unsigned int i;
+    // walk the block column by column, starting at column _n/3; indices
+    // increase down each column so the walk moves on to the next column
+    // at the first one out of range
+    unsigned int i=0;
     unsigned int j;
-    unsigned int m=0;
+    unsigned int m;
     unsigned int n=_n/3;
     unsigned int n2=_n/2;
-    unsigned char tmp;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
+    while (i < n2) {
+        for (m=0; m<_M && i<n2; m++) {
             j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-
-        // swap indices
-        tmp = _x[2*j+1];
-        _x[2*j+1] = _x[2*i+0];
-        _x[2*i+0] = tmp;
+            if (j >= n2)
+                break;
+            _j[i++] = 2*j+1;
+        }
+        n = (n+1) % _N;
     }
 }
 
-// permute one iteration (soft bit input)
-void interleaver_permute_soft(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N)
+// permute one iteration with mask; the pairs are disjoint so the swaps
+// are independent of one another
+void interleaver_permute_mask(unsigned char *      _x,
+                              unsigned int         _n,
+                              const unsigned int * _j,
+                              unsigned char        _mask)
 {
     unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
     unsigned int n2=_n/2;
-    unsigned char tmp[8];
     for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-    
-        // swap soft bits at indices
-        memmove( tmp,            &_x[8*(2*j+1)], 8);
-        memmove( &_x[8*(2*j+1)], &_x[8*(2*i+0)], 8);
-        memmove( &_x[8*(2*i+0)], tmp,            8);
+        unsigned int  j = _j[i];
+        unsigned char a = _x[2*i];
+        unsigned char b = _x[j];
+        unsigned char t = (a ^ b) & _mask;
+        _x[2*i] = a ^ t;
+        _x[j]   = b ^ t;
     }
-    //printf("\n");
 }
 
-
-// permute one iteration with mask
-void interleaver_permute_mask(unsigned char * _x,
-                              unsigned int    _n,
-                              unsigned int    _M,
-                              unsigned int    _N,
-                              unsigned char   _mask)
+// permute one iteration (soft bit input) with mask, swapping the soft
+// bits of a byte as one 64-bit word
+void interleaver_permute_mask_soft(unsigned char *      _x,
+                                   unsigned int         _n,
+                                   const unsigned int * _j,
+                                   unsigned char        _mask)
 {
+    // expand mask to soft bits (soft bit k corresponds to bit 0x80 >> k)
+    unsigned char m[8];
     unsigned int i;
-    unsigned int j;
-    unsigned int m=0;
-    unsigned int n=_n/3;
-    unsigned int n2=_n/2;
-    unsigned char tmp0;
-    unsigned char tmp1;
-    for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-
-        // swap indices, applying mask
-        tmp0 = (_x[2*i+0] & (~_mask)) | (_x[2*j+1] & ( _mask));
-        tmp1 = (_x[2*i+0] & ( _mask)) | (_x[2*j+1] & (~_mask));
-        _x[2*i+0] = tmp0;
-        _x[2*j+1] = tmp1;
-    }
-}
+    for (i=0; i<8; i++)
+        m[i] = (_mask >> (7-i)) & 1 ? 0xff : 0x00;
+    uint64_t mask;
+    memmove(&mask, m, 8);
 
-// permute one iteration (soft bit input)
-void interleaver_permute_mask_soft(unsigned char * _x,
-                                   unsigned int    _n,
-                                   unsigned int    _M,
-                                   unsigned int    _N,
-                                   unsigned char   _mask)
-{
-    unsigned int i;
-    unsigned int j;
-    unsigned int k;
-    unsigned int m=0;
-    unsigned int n=_n/3;
     unsigned int n2=_n/2;
-    unsigned char tmp;
     for (i=0; i<n2; i++) {
-        //j = m*N + n; // input
-        do {
-            j = m*_N + n; // output
-            m++;
-            if (m == _M) {
-                n = (n+1) % (_N);
-                m=0;
-            }
-        } while (j>=n2);
-
-        // swap bits matching the mask
-        for (k=0; k<8; k++) {
-            if ( (_mask >> (8-k-1)) & 0x01 ) {
-                tmp = _x[8*(2*j+1)+k];
-                _x[8*(2*j+1)+k] = _x[8*(2*i+0)+k];
-                _x[8*(2*i+0)+k] = tmp;
-            }
-        }
+        unsigned int j = _j[i];
+        uint64_t a, b;
+        memmove(&a, &_x[8*(2*i)], 8);
+        memmove(&b, &_x[8*j],     8);
+        uint64_t t = (a ^ b) & mask;
+        a ^= t;
+        b ^= t;
+        memmove(&_x[8*(2*i)], &a, 8);
+        memmove(&_x[8*j],     &b, 8);
     }
-    //printf("\n");
 }
-
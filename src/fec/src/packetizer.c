@@ -30,8 +30,19 @@
 
 #include "liquid.internal.h"
 
-// reallocate memory for buffers
-void packetizer_realloc_buffers(packetizer _p, unsigned int _len);
+// set lengths and schemes, re-using existing fec/interleaver objects and
+// scratch memory where possible
+void packetizer_configure(packetizer   _p,
+                          unsigned int _n,
+                          int          _crc,
+                          int          _fec0,
+                          int          _fec1);
+
+// remove whitening and validate crc of decoded message in _buf, copying
+// the result to _msg
+int packetizer_validate(packetizer      _p,
+                        unsigned char * _buf,
+                        unsigned char * _msg);
 
 // computes the number of encoded bytes after packetizing
 //
@@ -97,44 +108,21 @@ packetizer packetizer_create(unsigned int _n,
 {
     packetizer p = (packetizer) malloc(sizeof(struct packetizer_s));
 
-    p->msg_len      = _n;
-    p->packet_len   = packetizer_compute_enc_msg_len(_n, _crc, _fec0, _fec1);
-    p->check        = _crc;
-    p->crc_length   = crc_get_length(p->check);
-
-    // allocate memory for buffers (scale by 8 for soft decoding)
-    p->buffer_len = p->packet_len;
-    p->buffer_0 = (unsigned char*) malloc(8*p->buffer_len);
-    p->buffer_1 = (unsigned char*) malloc(8*p->buffer_len);
-
-    // create plan
+    // create empty plan
     p->plan_len = 2;
     p->plan = (struct fecintlv_plan*) malloc((p->plan_len)*sizeof(struct fecintlv_plan));
-
-    // set schemes
     unsigned int i;
-    unsigned int n0 = _n + p->crc_length;
     for (i=0; i<p->plan_len; i++) {
-        // set schemes
-        p->plan[i].fs = (i==0) ? _fec0 : _fec1;
-
-        // compute lengths
-        p->plan[i].dec_msg_len = n0;
-        p->plan[i].enc_msg_len = fec_get_enc_msg_length(p->plan[i].fs,
-                                                        p->plan[i].dec_msg_len);
-
-        // create objects
-        p->plan[i].f = fec_create(p->plan[i].fs, NULL);
-        p->plan[i].q = interleaver_create(p->plan[i].enc_msg_len);
+        p->plan[i].f = NULL;
+        p->plan[i].q = NULL;
+    }
 
-        // set interleaver depth to zero if no error correction scheme
-        // is applied to this plan
-        if (p->plan[i].fs == LIQUID_FEC_NONE)
-            interleaver_set_depth(p->plan[i].q, 0);
+    // scratch memory is allocated when configured
+    p->buffer_len = 0;
+    p->buffer     = NULL;
 
-        // update length
-        n0 = p->plan[i].enc_msg_len;
-    }
+    // set schemes, create objects
+    packetizer_configure(p, _n, _crc, _fec0, _fec1);
 
     return p;
 }
@@ -167,10 +155,9 @@ packetizer packetizer_recreate(packetizer _p,
         return _p;
     }
 
-    // something has changed; destroy old object and create new one
-    // TODO : rather than completely destroying object, only change values that are necessary
-    packetizer_destroy(_p);
-    return packetizer_create(_n,_crc,_fec0,_fec1);
+    // something has changed; re-configure existing object
+    packetizer_configure(_p, _n, _crc, _fec0, _fec1);
+    return _p;
 }
 
 // destroy packetizer object
@@ -190,9 +177,8 @@ void packetizer_destroy(packetizer _p)
     // free plan
     free(_p->plan);
 
-    // free buffers
-    free(_p->buffer_0);
-    free(_p->buffer_1);
+    // free scratch memory
+    free(_p->buffer);
 
     // free packetizer object
     free(_p);
@@ -243,6 +229,14 @@ fec_scheme packetizer_get_fec1(packetizer _p)
     return _p->plan[1].fs;
 }
 
+// get length of scratch buffer required by the _scratch methods (bytes):
+// soft decoding de-interleaves the outer level (8 soft bits per byte) and
+// decodes into a second, hard-decision buffer
+unsigned int packetizer_get_scratch_len(packetizer _p)
+{
+    return 9*_p->packet_len;
+}
+
 // Execute the packetizer on an input message
 //
 //  _p      :   packetizer object
@@ -252,46 +246,62 @@ void packetizer_encode(packetizer            _p,
                        const unsigned char * _msg,
                        unsigned char *       _pkt)
 {
+    packetizer_encode_scratch(_p, _msg, _pkt, _p->buffer);
+}
+
+// Execute the packetizer on an input message using caller-supplied
+// scratch memory
+//
+//  _p      :   packetizer object
+//  _msg    :   input message (uncoded bytes)
+//  _pkt    :   encoded output message
+//  _buf    :   scratch memory [size: packetizer_get_scratch_len() x 1]
+void packetizer_encode_scratch(packetizer            _p,
+                               const unsigned char * _msg,
+                               unsigned char *       _pkt,
+                               unsigned char *       _buf)
+{
+    // plans without error correction neither change the length nor
+    // interleave the data and are skipped entirely; the remaining stages
+    // alternate between the output and scratch memory, so start in
+    // whichever makes the last stage land in the output
     unsigned int i;
+    unsigned int num_stages = 0;
+    for (i=0; i<_p->plan_len; i++)
+        num_stages += (_p->plan[i].fs != LIQUID_FEC_NONE);
+    unsigned char * b0 = (num_stages % 2) ? _buf : _pkt;
+    unsigned char * b1 = (num_stages % 2) ? _pkt : _buf;
 
-    // copy input message to internal buffer[0] (or initialize to zeros)
+    // copy input message (or initialize to zeros) and append crc
     if (_msg != NULL) {
-        // copy user-defined input
-        memmove(_p->buffer_0, _msg, _p->msg_len);
+        crc_copy_append_key(_p->check, _msg, _p->msg_len, b0);
     } else {
-        // initialize with zeros
-        memset(_p->buffer_0, 0x00, _p->msg_len);
-    }
-
-    // compute crc, append to buffer
-    unsigned int key = crc_generate_key(_p->check, _p->buffer_0, _p->msg_len);
-    for (i=0; i<_p->crc_length; i++) {
-        // append byte to buffer
-        _p->buffer_0[_p->msg_len+_p->crc_length-i-1] = key & 0xff;
-
-        // shift key by 8 bits
-        key >>= 8;
+        memset(b0, 0x00, _p->msg_len);
+        crc_append_key(_p->check, b0, _p->msg_len);
     }
 
     // whiten input sequence
-    scramble_data(_p->buffer_0, _p->msg_len + _p->crc_length);
+    scramble_data(b0, _p->msg_len + _p->crc_length);
 
     // execute fec/interleaver plans
     for (i=0; i<_p->plan_len; i++) {
-        // run the encoder: buffer[0] > buffer[1]
+        if (_p->plan[i].fs == LIQUID_FEC_NONE)
+            continue;
+
+        // run the encoder: b0 > b1
         fec_encode(_p->plan[i].f,
                    _p->plan[i].dec_msg_len,
-                   _p->buffer_0,
-                   _p->buffer_1);
+                   b0,
+                   b1);
 
-        // run the interleaver: buffer[1] > buffer[0]
-        interleaver_encode(_p->plan[i].q,
-                           _p->buffer_1,
-                           _p->buffer_0);
-    }
+        // run the interleaver in place
+        interleaver_encode(_p->plan[i].q, b1, b1);
 
-    // copy result to output
-    memmove(_pkt, _p->buffer_0, _p->packet_len);
+        // swap buffers
+        unsigned char * tmp = b0;
+        b0 = b1;
+        b1 = tmp;
+    }
 }
 
 // Execute the packetizer to decode an input message, return validity
@@ -304,43 +314,53 @@ int packetizer_decode(packetizer            _p,
                       const unsigned char * _pkt,
                       unsigned char *       _msg)
 {
-    // copy coded message to internal buffer[0]
-    memmove(_p->buffer_0, _pkt, _p->packet_len);
+    return packetizer_decode_scratch(_p, _pkt, _msg, _p->buffer);
+}
 
-    // execute fec/interleaver plans
+// Decode an input message using caller-supplied scratch memory, return
+// validity check of resulting data
+//
+//  _p      :   packetizer object
+//  _pkt    :   input message (coded bytes)
+//  _msg    :   decoded output message
+//  _buf    :   scratch memory [size: packetizer_get_scratch_len() x 1]
+int packetizer_decode_scratch(packetizer            _p,
+                              const unsigned char * _pkt,
+                              unsigned char *       _msg,
+                              unsigned char *       _buf)
+{
+    unsigned char * b0 = _buf;
+    unsigned char * b1 = _buf + _p->packet_len;
+
+    // execute fec/interleaver plans; the first de-interleaver reads
+    // directly from the input and later ones run in place
+    unsigned char * r = (unsigned char*) _pkt;
     unsigned int i;
     for (i=_p->plan_len; i>0; i--) {
-        // run the de-interleaver: buffer[0] > buffer[1]
-        interleaver_decode(_p->plan[i-1].q,
-                           _p->buffer_0,
-                           _p->buffer_1);
+        if (_p->plan[i-1].fs == LIQUID_FEC_NONE)
+            continue;
+
+        unsigned char * x = (r == b1) ? b1 : b0;
+        unsigned char * y = (x == b0) ? b1 : b0;
 
-        // run the decoder: buffer[1] > buffer[0]
+        // run the de-interleaver: r > x
+        interleaver_decode(_p->plan[i-1].q, r, x);
+
+        // run the decoder: x > y
         fec_decode(_p->plan[i-1].f,
                    _p->plan[i-1].dec_msg_len,
-                   _p->buffer_1,
-                   _p->buffer_0);
+                   x,
+                   y);
+        r = y;
     }
 
-    // remove sequence whitening
-    unscramble_data(_p->buffer_0, _p->msg_len + _p->crc_length);
-
-    // strip crc, validate message
-    unsigned int key = 0;
-    for (i=0; i<_p->crc_length; i++) {
-        key <<= 8;
-
-        key |= _p->buffer_0[_p->msg_len+i];
+    // no error correction; input must not be modified
+    if (r == _pkt) {
+        memmove(b0, _pkt, _p->msg_len + _p->crc_length);
+        r = b0;
     }
 
-    // copy result to output
-    memmove(_msg, _p->buffer_0, _p->msg_len);
-
-    // return crc validity
-    return crc_validate_message(_p->check,
-                                _p->buffer_0,
-                                _p->msg_len,
-                                key);
+    return packetizer_validate(_p, r, _msg);
 }
 
 // Execute the packetizer to decode an input message, return validity
@@ -353,59 +373,115 @@ int packetizer_decode_soft(packetizer            _p,
                            const unsigned char * _pkt,
                            unsigned char *       _msg)
 {
-    // copy coded message to internal buffer[0]
-    memmove(_p->buffer_0, _pkt, 8*_p->packet_len);
+    return packetizer_decode_soft_scratch(_p, _pkt, _msg, _p->buffer);
+}
+
+// Decode an input message of soft bits using caller-supplied scratch
+// memory, return validity check of resulting data
+//
+//  _p      :   packetizer object
+//  _pkt    :   input message (coded soft bits)
+//  _msg    :   decoded output message
+//  _buf    :   scratch memory [size: packetizer_get_scratch_len() x 1]
+int packetizer_decode_soft_scratch(packetizer            _p,
+                                   const unsigned char * _pkt,
+                                   unsigned char *       _msg,
+                                   unsigned char *       _buf)
+{
+    unsigned char * b0 = _buf;
+    unsigned char * b1 = _buf + 8*_p->packet_len;
 
     // 
-    // decode outer level using soft decoding
+    // decode outer level using soft decoding: _pkt > b0 > b1
     //
-
-    // run the de-interleaver: buffer[0] > buffer[1]
-    interleaver_decode_soft(_p->plan[1].q,
-                            _p->buffer_0,
-                            _p->buffer_1);
-
-    // run the decoder: buffer[1] > buffer[0]
-    fec_decode_soft(_p->plan[1].f,
-                    _p->plan[1].dec_msg_len,
-                    _p->buffer_1,
-                    _p->buffer_0);
+    if (_p->plan[1].fs != LIQUID_FEC_NONE) {
+        interleaver_decode_soft(_p->plan[1].q, (unsigned char*)_pkt, b0);
+        fec_decode_soft(_p->plan[1].f, _p->plan[1].dec_msg_len, b0, b1);
+    } else {
+        // no interleaving; only take hard decisions
+        fec_decode_soft(_p->plan[1].f, _p->plan[1].dec_msg_len, (unsigned char*)_pkt, b1);
+    }
 
     // 
-    // decode inner level using hard decoding
+    // decode inner level using hard decoding: b1 > b1 > b0
     //
+    if (_p->plan[0].fs == LIQUID_FEC_NONE)
+        return packetizer_validate(_p, b1, _msg);
 
-    // run the de-interleaver: buffer[0] > buffer[1]
-    interleaver_decode(_p->plan[0].q,
-                       _p->buffer_0,
-                       _p->buffer_1);
+    interleaver_decode(_p->plan[0].q, b1, b1);
+    fec_decode(_p->plan[0].f, _p->plan[0].dec_msg_len, b1, b0);
 
-    // run the decoder: buffer[1] > buffer[0]
-    fec_decode(_p->plan[0].f,
-               _p->plan[0].dec_msg_len,
-               _p->buffer_1,
-               _p->buffer_0);
+    return packetizer_validate(_p, b0, _msg);
+}
 
-    // remove sequence whitening
-    unscramble_data(_p->buffer_0, _p->msg_len + _p->crc_length);
+// Decode a block of input messages of soft bits, returning the number
+// of messages which pass the validity check. Each stage of error
+// correction runs across all messages at once (e.g. the Reed-Solomon
+// codewords of every message are decoded together).
+//
+//  _p      :   packetizer object
+//  _pkts   :   input messages (coded soft bits) [size: _num*_stride x 1]
+//  _stride :   distance between input messages, _stride >= 8*enc_msg_len
+//  _num    :   number of messages
+//  _msgs   :   decoded output messages [size: _num*msg_len x 1]
+//  _valid  :   validity check of each message [size: _num x 1] (ignored if NULL)
+unsigned int packetizer_decode_soft_block(packetizer            _p,
+                                          const unsigned char * _pkts,
+                                          unsigned int          _stride,
+                                          unsigned int          _num,
+                                          unsigned char *       _msgs,
+                                          int *                 _valid)
+{
+    if (_stride < 8*_p->packet_len) {
+        fprintf(stderr,"error: packetizer_decode_soft_block(), stride must be at least %u\n", 8*_p->packet_len);
+        exit(1);
+    }
 
-    // strip crc, validate message
-    unsigned int key = 0;
+    unsigned int len0 = _p->plan[0].enc_msg_len;    // inner code, encoded
+    unsigned int len1 = _p->plan[0].dec_msg_len;    // inner code, decoded
+    unsigned char * s  = (unsigned char*) malloc(_num*8*_p->packet_len*sizeof(unsigned char));
+    unsigned char * b0 = (unsigned char*) malloc(_num*len0*sizeof(unsigned char));
+    unsigned char * b1 = (unsigned char*) malloc(_num*len1*sizeof(unsigned char));
     unsigned int i;
-    for (i=0; i<_p->crc_length; i++) {
-        key <<= 8;
 
-        key |= _p->buffer_0[_p->msg_len+i];
+    //
+    // decode outer level using soft decoding: _pkts > s > b0
+    //
+    if (_p->plan[1].fs != LIQUID_FEC_NONE) {
+        for (i=0; i<_num; i++)
+            interleaver_decode_soft(_p->plan[1].q, (unsigned char*)&_pkts[i*_stride], &s[i*8*_p->packet_len]);
+        fec_decode_soft_block(_p->plan[1].f, _p->plan[1].dec_msg_len, _num, s, b0);
+    } else {
+        // no interleaving; only take hard decisions
+        for (i=0; i<_num; i++)
+            fec_decode_soft(_p->plan[1].f, _p->plan[1].dec_msg_len, (unsigned char*)&_pkts[i*_stride], &b0[i*len0]);
     }
 
-    // copy result to output
-    memmove(_msg, _p->buffer_0, _p->msg_len);
+    //
+    // decode inner level using hard decoding: b0 > b0 > b1
+    //
+    unsigned char * r = b0;
+    if (_p->plan[0].fs != LIQUID_FEC_NONE) {
+        for (i=0; i<_num; i++)
+            interleaver_decode(_p->plan[0].q, &b0[i*len0], &b0[i*len0]);
+        fec_decode_block(_p->plan[0].f, len1, _num, b0, b1);
+        r = b1;
+    }
 
-    // return crc validity
-    return crc_validate_message(_p->check,
-                                _p->buffer_0,
-                                _p->msg_len,
-                                key);
+    // validate each message
+    unsigned int num_valid = 0;
+    unsigned int step = (r == b0) ? len0 : len1;
+    for (i=0; i<_num; i++) {
+        int valid = packetizer_validate(_p, &r[i*step], &_msgs[i*_p->msg_len]);
+        if (_valid != NULL)
+            _valid[i] = valid;
+        num_valid += valid ? 1 : 0;
+    }
+
+    free(s);
+    free(b0);
+    free(b1);
+    return num_valid;
 }
 
 void packetizer_set_scheme(packetizer _p, int _fec0, int _fec1)
@@ -417,10 +493,86 @@ void packetizer_set_scheme(packetizer _p, int _fec0, int _fec1)
 // internal methods
 //
 
-void packetizer_realloc_buffers(packetizer _p, unsigned int _len)
+// set lengths and schemes, re-using existing fec/interleaver objects and
+// scratch memory where possible
+void packetizer_configure(packetizer   _p,
+                          unsigned int _n,
+                          int          _crc,
+                          int          _fec0,
+                          int          _fec1)
 {
-    _p->buffer_len = _len;
-    _p->buffer_0 = (unsigned char*) realloc(_p->buffer_0, _p->buffer_len);
-    _p->buffer_1 = (unsigned char*) realloc(_p->buffer_1, _p->buffer_len);
+    _p->msg_len      = _n;
+    _p->packet_len   = packetizer_compute_enc_msg_len(_n, _crc, _fec0, _fec1);
+    _p->check        = _crc;
+    _p->crc_length   = crc_get_length(_p->check);
+
+    // set schemes
+    unsigned int i;
+    unsigned int n0 = _n + _p->crc_length;
+    for (i=0; i<_p->plan_len; i++) {
+        // set schemes
+        _p->plan[i].fs = (i==0) ? _fec0 : _fec1;
+
+        // compute lengths, keeping the old interleaver length
+        unsigned int q_len = _p->plan[i].q == NULL ? 0 : _p->plan[i].enc_msg_len;
+        _p->plan[i].dec_msg_len = n0;
+        _p->plan[i].enc_msg_len = fec_get_enc_msg_length(_p->plan[i].fs,
+                                                         _p->plan[i].dec_msg_len);
+
+        // create objects (fec_recreate() only rebuilds on a new scheme)
+        if (_p->plan[i].f == NULL)
+            _p->plan[i].f = fec_create(_p->plan[i].fs, NULL);
+        else
+            _p->plan[i].f = fec_recreate(_p->plan[i].f, _p->plan[i].fs, NULL);
+
+        if (_p->plan[i].q != NULL && q_len != _p->plan[i].enc_msg_len) {
+            interleaver_destroy(_p->plan[i].q);
+            _p->plan[i].q = NULL;
+        }
+        if (_p->plan[i].q == NULL)
+            _p->plan[i].q = interleaver_create(_p->plan[i].enc_msg_len);
+
+        // set interleaver depth to zero if no error correction scheme
+        // is applied to this plan
+        interleaver_set_depth(_p->plan[i].q, _p->plan[i].fs == LIQUID_FEC_NONE ? 0 : 4);
+
+        // update length
+        n0 = _p->plan[i].enc_msg_len;
+    }
+
+    // grow scratch memory if necessary
+    unsigned int buffer_len = packetizer_get_scratch_len(_p);
+    if (buffer_len > _p->buffer_len) {
+        free(_p->buffer);
+        _p->buffer_len = buffer_len;
+        _p->buffer = (unsigned char*) malloc(_p->buffer_len);
+    }
 }
 
+// remove whitening and validate crc of decoded message in _buf, copying
+// the result to _msg
+int packetizer_validate(packetizer      _p,
+                        unsigned char * _buf,
+                        unsigned char * _msg)
+{
+    // remove sequence whitening
+    unscramble_data(_buf, _p->msg_len + _p->crc_length);
+
+    // strip crc, validate message
+    unsigned int key = 0;
+    unsigned int i;
+    for (i=0; i<_p->crc_length; i++) {
+        key <<= 8;
+
+        key |= _buf[_p->msg_len+i];
+    }
+
+    // copy result to output
+    memmove(_msg, _buf, _p->msg_len);
+
+    // return crc validity
+    return crc_validate_message(_p->check,
+                                _buf,
+                                _p->msg_len,
+                                key);
+}
@@ -23,11 +23,15 @@
 //
 // sumproduct.c
 //
-// floating-point implementation of the sum-product algorithm
+// floating-point implementation of the sum-product algorithm over a
+// compressed (edge list) representation of the sparse parity-check
+// matrix; memory and time per iteration are linear in the number of
+// non-zero entries
 //
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -60,35 +64,51 @@ int fec_sumproduct(unsigned int    _m,
         exit(1);
     }
 
-    // internal variables
-    unsigned int num_iterations = 0;
-    float Lq[_m*_n];
-    float Lr[_m*_n];
-    float Lc[_n];
-    float LQ[_n];
-    unsigned char parity[_m];
     unsigned int i;
     unsigned int j;
-    int parity_pass;
-    int continue_running = 1;
+    unsigned int e;
 
-    // initialize Lq with log-likelihood values
+    // compressed row layout: edges of check j are [row_ptr[j],row_ptr[j+1])
+    unsigned int * row_ptr = (unsigned int*) malloc((_m+1)*sizeof(unsigned int));
+    row_ptr[0] = 0;
+    for (j=0; j<_m; j++)
+        row_ptr[j+1] = row_ptr[j] + smatrixb_get_row_indices(_H, j, NULL);
+    unsigned int num_edges = row_ptr[_m];
+    unsigned int * col_idx = (unsigned int*) malloc(num_edges*sizeof(unsigned int));
+    for (j=0; j<_m; j++)
+        smatrixb_get_row_indices(_H, j, &col_idx[row_ptr[j]]);
+
+    // compressed column layout: edges of variable i are
+    // col_edge[col_ptr[i]..col_ptr[i+1]-1]
+    unsigned int * col_ptr  = (unsigned int*) calloc(_n+1, sizeof(unsigned int));
+    unsigned int * col_edge = (unsigned int*) malloc(num_edges*sizeof(unsigned int));
+    for (e=0; e<num_edges; e++)
+        col_ptr[col_idx[e]+1]++;
     for (i=0; i<_n; i++)
-        Lc[i] = _LLR[i];
-        //Lc[i] = 2.0f * _y[i] / (sigma*sigma);
+        col_ptr[i+1] += col_ptr[i];
+    unsigned int * col_fill = (unsigned int*) malloc(_n*sizeof(unsigned int));
+    memmove(col_fill, col_ptr, _n*sizeof(unsigned int));
+    for (e=0; e<num_edges; e++)
+        col_edge[col_fill[col_idx[e]]++] = e;
+    free(col_fill);
+
+    // messages (one per edge)
+    float * Lq = (float*) malloc(num_edges*sizeof(float));
+    float * Lr = (float*) malloc(num_edges*sizeof(float));
+    float * LQ = (float*) malloc(_n*sizeof(float));
 
-    for (j=0; j<_m; j++) {
-        for (i=0; i<_n; i++) {
-            Lq[j*_n+i] = smatrixb_get(_H,j,i) ? Lc[i] : 0.0f;
-        }
-    }
+    // initialize Lq with log-likelihood values
+    for (e=0; e<num_edges; e++)
+        Lq[e] = _LLR[col_idx[e]];
 
 #if DEBUG_SUMPRODUCT
-    // print Lc
-    matrixf_print(Lc,1,_n);
+    // print LLR
+    matrixf_print(_LLR,1,_n);
 #endif
 
-    // TODO : run multiple iterations
+    unsigned int num_iterations = 0;
+    int parity_pass;
+    int continue_running = 1;
     while (continue_running) {
 #if DEBUG_SUMPRODUCT
         //
@@ -97,8 +117,8 @@ int fec_sumproduct(unsigned int    _m,
 #endif
 
         // step sum-product algorithm
-        //parity_pass = fec_sumproduct_step(_H,_m,_n,_c_hat,Lq,Lr,Lc,LQ,parity);
-        parity_pass = fec_sumproduct_step(_m,_n,_H,_c_hat,Lq,Lr,Lc,LQ,parity);
+        parity_pass = fec_sumproduct_step(_m,_n,row_ptr,col_idx,col_ptr,col_edge,
+                                          _c_hat,Lq,Lr,_LLR,LQ);
 
         // update...
         num_iterations++;
@@ -106,93 +126,73 @@ int fec_sumproduct(unsigned int    _m,
             continue_running = 0;
     }
 
+    // free allocated memory
+    free(row_ptr);
+    free(col_idx);
+    free(col_ptr);
+    free(col_edge);
+    free(Lq);
+    free(Lr);
+    free(LQ);
+
     return parity_pass;
 }
 
 // sum-product algorithm, returns 1 if parity checks, 0 otherwise
-//  _m      :   rows
-//  _n      :   cols
-//  _H      :   sparse binary parity check matrix [size: _m x _n]
-//  _c_hat  :   estimated transmitted signal [size: _n x 1]
+//  _m          :   rows
+//  _n          :   cols
+//  _row_ptr    :   first edge of each check [size: _m+1 x 1]
+//  _col_idx    :   variable (column) of each edge [size: num_edges x 1]
+//  _col_ptr    :   first entry in _col_edge of each variable [size: _n+1 x 1]
+//  _col_edge   :   edges grouped by variable [size: num_edges x 1]
+//  _c_hat      :   estimated transmitted signal [size: _n x 1]
 //
 // internal state arrays
-//  _Lq     :   [size: _m x _n]
-//  _Lr     :   [size: _m x _n]
-//  _Lc     :   [size: _n x 1]
-//  _LQ     :   [size: _n x 1]
-//  _parity :   _H * _c_hat [size: _m x 1]
+//  _Lq     :   variable-to-check messages [size: num_edges x 1]
+//  _Lr     :   check-to-variable messages [size: num_edges x 1]
+//  _Lc     :   channel LLRs [size: _n x 1]
+//  _LQ     :   a posteriori LLRs [size: _n x 1]
 int fec_sumproduct_step(unsigned int    _m,
                         unsigned int    _n,
-                        smatrixb        _H,
+                        unsigned int *  _row_ptr,
+                        unsigned int *  _col_idx,
+                        unsigned int *  _col_ptr,
+                        unsigned int *  _col_edge,
                         unsigned char * _c_hat,
                         float *         _Lq,
                         float *         _Lr,
                         float *         _Lc,
-                        float *         _LQ,
-                        unsigned char * _parity)
+                        float *         _LQ)
 {
     unsigned int i;
     unsigned int j;
-    unsigned int ip;
-    unsigned int jp;
-    float alpha_prod;
-    float phi_sum;
-    int parity_pass;
+    unsigned int e;
 
-    // compute Lr
-    for (i=0; i<_n; i++) {
-        for (j=0; j<_m; j++) {
-            alpha_prod = 1.0f;
-            phi_sum    = 0.0f;
-            for (ip=0; ip<_n; ip++) {
-                //if (_H[j*_n+ip]==1 && i != ip) {
-                if (smatrixb_get(_H,j,ip)==1 && i != ip) {
-                    float alpha = _Lq[j*_n+ip] > 0.0f ? 1.0f : -1.0f;
-                    float beta  = fabsf(_Lq[j*_n+ip]);
-                    phi_sum += sumproduct_phi(beta);
-                    alpha_prod *= alpha;
-                }
-            }
-            _Lr[j*_n+i] = alpha_prod * sumproduct_phi(phi_sum);
+    // compute Lr: exclude each edge from the sum over its check
+    for (j=0; j<_m; j++) {
+        float alpha_prod = 1.0f;
+        float phi_sum    = 0.0f;
+        for (e=_row_ptr[j]; e<_row_ptr[j+1]; e++) {
+            alpha_prod *= _Lq[e] > 0.0f ? 1.0f : -1.0f;
+            phi_sum    += sumproduct_phi(fabsf(_Lq[e]));
         }
-    }
-
-#if DEBUG_SUMPRODUCT
-    // print Lq
-    matrixf_print(_Lq,_m,_n);
-
-    // print Lr
-    matrixf_print(_Lr,_m,_n);
-#endif
-
-    // compute next iteration of Lq
-    for (i=0; i<_n; i++) {
-        for (j=0; j<_m; j++) {
-            // initialize with LLR
-            _Lq[j*_n+i] = _Lc[i];
-
-            for (jp=0; jp<_m; jp++) {
-                //if (_H[jp*_n+i]==1 && j != jp)
-                if (smatrixb_get(_H,jp,i)==1 && j != jp)
-                    _Lq[j*_n+i] += _Lr[jp*_n+i];
-            }
+        for (e=_row_ptr[j]; e<_row_ptr[j+1]; e++) {
+            float alpha = _Lq[e] > 0.0f ? 1.0f : -1.0f;
+            float beta  = fabsf(_Lq[e]);
+            float phi   = phi_sum - sumproduct_phi(beta);
+            _Lr[e] = alpha_prod * alpha * sumproduct_phi(phi > 0.0f ? phi : 0.0f);
         }
     }
 
-#if DEBUG_SUMPRODUCT
-    // print Lq
-    matrixf_print(_Lq,_m,_n);
-#endif
-
-    // compute LQ
+    // compute LQ and next iteration of Lq
     for (i=0; i<_n; i++) {
-        _LQ[i] = _Lc[i];  // initialize with LLR value
+        // initialize with LLR value
+        _LQ[i] = _Lc[i];
+        for (e=_col_ptr[i]; e<_col_ptr[i+1]; e++)
+            _LQ[i] += _Lr[_col_edge[e]];
 
-        for (j=0; j<_m; j++) {
-            //if (_H[j*_n+i]==1)
-            if (smatrixb_get(_H,j,i)==1)
-                _LQ[i] += _Lr[j*_n+i];
-        }
+        for (e=_col_ptr[i]; e<_col_ptr[i+1]; e++)
+            _Lq[_col_edge[e]] = _LQ[i] - _Lr[_col_edge[e]];
     }
 
 #if DEBUG_SUMPRODUCT
@@ -204,13 +204,13 @@ int fec_sumproduct_step(unsigned int    _m,
     for (i=0; i<_n; i++)
         _c_hat[i] = _LQ[i] < 0.0f ? 1 : 0;
 
-    // compute parity check: p = H*c_hat
-    smatrixb_vmul(_H, _c_hat, _parity);
-
-    // check parity
-    parity_pass = 1;
-    for (j=0; j<_m; j++) {
-        if (_parity[j]) parity_pass = 0;
+    // check parity: p = H*c_hat
+    int parity_pass = 1;
+    for (j=0; j<_m && parity_pass; j++) {
+        unsigned char parity = 0;
+        for (e=_row_ptr[j]; e<_row_ptr[j+1]; e++)
+            parity ^= _c_hat[_col_idx[e]];
+        if (parity) parity_pass = 0;
     }
 
 #if DEBUG_SUMPRODUCT
@@ -218,17 +218,8 @@ int fec_sumproduct_step(unsigned int    _m,
     printf("    : c hat = [");
     for (i=0; i<_n; i++)
         printf(" %1u", _c_hat[i]);
-    printf(" ],  ");
-
-    // print parity
-    printf("parity = [");
-    for (j=0; j<_m; j++)
-        printf(" %1u", _parity[j]);
-    printf(" ],  ");
-
-    printf(" (%s)\n", parity_pass ? "pass" : "FAIL");
+    printf(" ],  (%s)\n", parity_pass ? "pass" : "FAIL");
 #endif
 
     return parity_pass;
 }
-
@@ -20,10 +20,11 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 //
 // AUTOTEST: reverse byte
@@ -120,3 +121,83 @@ void autotest_crc24()    { validate_crc(LIQUID_CRC_24,          64); }
 void autotest_crc32()    { validate_crc(LIQUID_CRC_32,          64); }
 
 
+// bit-at-a-time reference for reflected keys over a 32-bit register
+unsigned int crc_reference_key(unsigned int    _poly,
+                               unsigned int    _mask,
+                               unsigned char * _msg,
+                               unsigned int    _n)
+{
+    unsigned int i, j, key=~0;
+    for (i=0; i<_n; i++) {
+        key ^= _msg[i];
+        for (j=0; j<8; j++)
+            key = (key >> 1) ^ (_poly & -(key & 1));
+    }
+    return (~key) & _mask;
+}
+
+// compare table-driven and folding keys against reference for all
+// lengths up to 320 bytes and every alignment within 16 bytes
+void crc_test_reference(crc_scheme   _check,
+                        unsigned int _poly,
+                        unsigned int _mask)
+{
+    unsigned char buf[320+16];
+    unsigned int i, n, offset;
+    for (i=0; i<320+16; i++)
+        buf[i] = rand() & 0xff;
+
+    for (offset=0; offset<16; offset+=5) {
+        for (n=0; n<=320; n++) {
+            unsigned int key_ref  = crc_reference_key(_poly, _mask, buf+offset, n);
+            unsigned int key_test = crc_generate_key(_check, buf+offset, n);
+            if (key_ref != key_test) {
+                // only report failures to keep the check count manageable
+                CONTEND_EQUALITY(key_test, key_ref);
+                return;
+            }
+        }
+    }
+    CONTEND_EXPRESSION(1);
+}
+
+void autotest_crc8_reference()  { crc_test_reference(LIQUID_CRC_8,  liquid_reverse_byte(CRC8_POLY),    0xff);       }
+void autotest_crc16_reference() { crc_test_reference(LIQUID_CRC_16, liquid_reverse_uint16(CRC16_POLY), 0xffff);     }
+void autotest_crc24_reference() { crc_test_reference(LIQUID_CRC_24, liquid_reverse_uint24(CRC24_POLY), 0xffffff);   }
+void autotest_crc32_reference() { crc_test_reference(LIQUID_CRC_32, liquid_reverse_uint32(CRC32_POLY), 0xffffffff); }
+
+// standard CRC-32 check value
+void autotest_crc32_check()
+{
+    unsigned char msg[] = "123456789";
+    CONTEND_EQUALITY(crc_generate_key(LIQUID_CRC_32, msg, 9), 0xcbf43926);
+}
+
+
+// fused copy/append matches crc_append_key() for short (table) and long
+// (folded) messages, both out of place and in place
+void autotest_crc_copy_append_key()
+{
+    crc_scheme check[5] = {LIQUID_CRC_NONE, LIQUID_CRC_CHECKSUM, LIQUID_CRC_8,
+                           LIQUID_CRC_16, LIQUID_CRC_32};
+    unsigned int len[4] = {0, 13, 64, 300};
+    unsigned char msg[304], ref[304], buf[304];
+    unsigned int c, n, i;
+    for (i=0; i<304; i++)
+        msg[i] = rand() & 0xff;
+
+    for (c=0; c<5; c++) {
+        for (n=0; n<4; n++) {
+            unsigned int k = len[n] + crc_sizeof_key(check[c]);
+            memmove(ref, msg, len[n]);
+            crc_append_key(check[c], ref, len[n]);
+
+            crc_copy_append_key(check[c], msg, len[n], buf);
+            CONTEND_SAME_DATA(buf, ref, k);
+
+            memmove(buf, msg, len[n]);
+            crc_copy_append_key(check[c], buf, len[n], buf);
+            CONTEND_SAME_DATA(buf, ref, k);
+        }
+    }
+}
@@ -105,3 +105,35 @@ void autotest_golay2412_codec()
     }
 }
 
+//
+// AUTOTEST: Golay(24,12) block codec, up to three errors in every symbol
+//
+void autotest_golay2412_codec_block()
+{
+    unsigned int n = 37;    // decoded message length (not a multiple of 3)
+    fec_scheme fs = LIQUID_FEC_GOLAY2412;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_dec[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    fec q = fec_create(fs,NULL);
+    fec_encode(q, n, msg, msg_enc);
+
+    // add errors to each 24-bit symbol (three bytes)
+    for (i=0; i<n_enc/3; i++) {
+        unsigned int e = golay2412_generate_error_vector(i % 4);
+        msg_enc[3*i+0] ^= (e >> 16) & 0xff;
+        msg_enc[3*i+1] ^= (e >>  8) & 0xff;
+        msg_enc[3*i+2] ^= (e      ) & 0xff;
+    }
+
+    fec_decode(q, n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, n);
+    fec_destroy(q);
+}
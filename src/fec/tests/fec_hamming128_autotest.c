@@ -103,3 +103,33 @@ void autotest_hamming128_codec_soft()
     }
 }
 
+//
+// AUTOTEST: Hamming (12,8) block codec, one error in every symbol
+//
+void autotest_hamming128_codec_block()
+{
+    unsigned int n = 37;    // decoded message length (odd)
+    fec_scheme fs = LIQUID_FEC_HAMMING128;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_dec[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    fec q = fec_create(fs,NULL);
+    fec_encode(q, n, msg, msg_enc);
+
+    // flip a random bit in each 12-bit symbol
+    for (i=0; i<n; i++) {
+        unsigned int k = 12*i + (rand() % 12);
+        msg_enc[k/8] ^= 0x80 >> (k%8);
+    }
+
+    fec_decode(q, n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, n);
+    fec_destroy(q);
+}
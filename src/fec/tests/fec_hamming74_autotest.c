@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
 #include "liquid.internal.h"
 
@@ -99,3 +101,47 @@ void autotest_hamming74_codec_soft()
     }
 }
 
+//
+// AUTOTEST: Hamming (7,4) block codec, one error in every symbol
+//
+void autotest_hamming74_codec_block()
+{
+    unsigned int n = 37;    // decoded message length (not a multiple of 4)
+    fec_scheme fs = LIQUID_FEC_HAMMING74;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_ref[n_enc];
+    unsigned char msg_dec[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    // clear unused trailing bits
+    for (i=0; i<n_enc; i++) {
+        msg_enc[i] = 0;
+        msg_ref[i] = 0;
+    }
+
+    fec q = fec_create(fs,NULL);
+    fec_encode(q, n, msg, msg_enc);
+
+    // pack encoded symbols one at a time for reference
+    for (i=0; i<n; i++) {
+        liquid_pack_array(msg_ref, n_enc, 14*i,   7, hamming74_enc_gentab[msg[i] >> 4  ]);
+        liquid_pack_array(msg_ref, n_enc, 14*i+7, 7, hamming74_enc_gentab[msg[i] & 0x0f]);
+    }
+    CONTEND_SAME_DATA(msg_enc, msg_ref, n_enc);
+
+    // flip a random bit in each 7-bit symbol
+    for (i=0; i<2*n; i++) {
+        unsigned int k = 7*i + (rand() % 7);
+        msg_enc[k/8] ^= 0x80 >> (k%8);
+    }
+
+    fec_decode(q, n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, n);
+    fec_destroy(q);
+}
@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
 #include "liquid.internal.h"
 
@@ -99,3 +101,42 @@ void autotest_hamming84_codec_soft()
     }
 }
 
+//
+// AUTOTEST: Hamming (8,4) block codec against look-up tables
+//
+void autotest_hamming84_codec_block()
+{
+    // every received byte value appears in the encoded message, with a
+    // tail that is not a multiple of the vector length
+    unsigned int n = 128 + 7;
+    fec_scheme fs = LIQUID_FEC_HAMMING84;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_dec[n];
+
+    fec q = fec_create(fs,NULL);
+
+    // encode
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+    fec_encode(q, n, msg, msg_enc);
+    for (i=0; i<n; i++) {
+        CONTEND_EQUALITY(msg_enc[2*i+0], hamming84_enc_gentab[msg[i] >> 4  ]);
+        CONTEND_EQUALITY(msg_enc[2*i+1], hamming84_enc_gentab[msg[i] & 0x0f]);
+    }
+
+    // decode all received byte values
+    for (i=0; i<n_enc; i++)
+        msg_enc[i] = (i*37 + 11) & 0xff;
+    fec_decode(q, n, msg_enc, msg_dec);
+    for (i=0; i<n; i++) {
+        unsigned char s = (hamming84_dec_gentab[msg_enc[2*i+0]] << 4) |
+                           hamming84_dec_gentab[msg_enc[2*i+1]];
+        CONTEND_EQUALITY(msg_dec[i], s);
+    }
+
+    fec_destroy(q);
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// compare SIMD check-node kernels against the portable version
+void autotest_fec_ldpc_layer()
+{
+    unsigned int dc = 7;
+    unsigned int Zp = 32;
+
+    // random a posteriori LLRs and check-to-variable messages, including
+    // values near saturation
+    int16_t * t0 = (int16_t*) aligned_alloc(32, dc*Zp*sizeof(int16_t));
+    int16_t * r0 = (int16_t*) aligned_alloc(32, dc*Zp*sizeof(int16_t));
+    int16_t * t1 = (int16_t*) aligned_alloc(32, dc*Zp*sizeof(int16_t));
+    int16_t * r1 = (int16_t*) aligned_alloc(32, dc*Zp*sizeof(int16_t));
+    unsigned int i;
+    for (i=0; i<dc*Zp; i++) {
+        t0[i] = (int)(rand() % 2001) - 1000;
+        r0[i] = (int)(rand() % 401)  - 200;
+    }
+    t0[3] = 32767;  r0[3] = -100;
+    t0[5] = -32768; r0[5] =  100;
+    t0[9] = 0;      r0[9] =  0;
+
+    int16_t t[dc*Zp], r[dc*Zp];
+    memmove(t, t0, sizeof(t));
+    memmove(r, r0, sizeof(r));
+    fec_ldpc_layer_port(t0, r0, dc, Zp, 16);
+
+#if defined(__SSE2__)
+    memmove(t1, t, sizeof(t));
+    memmove(r1, r, sizeof(r));
+    fec_ldpc_layer_sse2(t1, r1, dc, Zp, 16);
+    CONTEND_SAME_DATA(t0, t1, sizeof(t));
+    CONTEND_SAME_DATA(r0, r1, sizeof(r));
+#endif
+
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2)) {
+        memmove(t1, t, sizeof(t));
+        memmove(r1, r, sizeof(r));
+        fec_ldpc_layer_avx2(t1, r1, dc, Zp, 16);
+        CONTEND_SAME_DATA(t0, t1, sizeof(t));
+        CONTEND_SAME_DATA(r0, r1, sizeof(r));
+    }
+#endif
+
+    free(t0);
+    free(r0);
+    free(t1);
+    free(r1);
+}
+
+// encoded blocks satisfy all parity checks
+void fec_ldpc_test_codeword(unsigned int _Z, short int * _base)
+{
+    fec_ldpc_code q = fec_ldpc_code_create(12, 24, _Z, _base);
+    unsigned int n = fec_ldpc_code_get_n(q);
+    unsigned int k = fec_ldpc_code_get_k(q);
+
+    unsigned char msg[k];
+    unsigned char cw[n];
+    unsigned char parity[n-k];
+    unsigned int i;
+    for (i=0; i<k; i++)
+        msg[i] = rand() & 1;
+    fec_ldpc_code_encode(q, msg, cw);
+
+    // systematic
+    CONTEND_SAME_DATA(msg, cw, k);
+
+    // H*c = 0
+    smatrixb_vmul(fec_ldpc_code_get_H(q), cw, parity);
+    unsigned int num_errors = 0;
+    for (i=0; i<n-k; i++)
+        num_errors += parity[i];
+    CONTEND_EQUALITY(num_errors, 0);
+
+    // decoding noiseless codeword passes immediately
+    int16_t llr[n];
+    unsigned char msg_dec[k];
+    for (i=0; i<n; i++)
+        llr[i] = cw[i] ? -255 : 255;
+    CONTEND_EQUALITY(fec_ldpc_code_decode(q, llr, msg_dec), 1);
+    CONTEND_SAME_DATA(msg, msg_dec, k);
+
+    fec_ldpc_code_destroy(q);
+}
+
+void autotest_fec_ldpc_codeword_n648()  { fec_ldpc_test_codeword(27, fec_ldpc648_base);  }
+void autotest_fec_ldpc_codeword_n1296() { fec_ldpc_test_codeword(54, fec_ldpc1296_base); }
+void autotest_fec_ldpc_codeword_n1944() { fec_ldpc_test_codeword(81, fec_ldpc1944_base); }
+
+// decode noisy soft bits with hard errors spread across the frame
+void fec_ldpc_test_errors(fec_scheme _fs, unsigned int _n)
+{
+    fec q = fec_create(_fs, NULL);
+
+    unsigned int n_enc = fec_get_enc_msg_length(_fs,_n);
+    unsigned char msg[_n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[_n];
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+    fec_encode(q, _n, msg, msg_enc);
+
+    // soft bits with deterministic noise and every 37th bit in error
+    for (i=0; i<8*n_enc; i++) {
+        unsigned int bit = (msg_enc[i/8] >> (7-(i%8))) & 1;
+        unsigned int v   = 32 + ((i*97) % 64);
+        msg_soft[i] = bit ? 255 - v : v;
+        if ( (i % 37) == 0 )
+            msg_soft[i] = 255 - msg_soft[i];
+    }
+
+    // soft decoding corrects all errors
+    memset(msg_dec, 0x00, _n);
+    fec_decode_soft(q, _n, msg_soft, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, _n);
+
+    // hard decoding from the same (sliced) bits
+    for (i=0; i<n_enc; i++)
+        msg_enc[i] = 0;
+    for (i=0; i<8*n_enc; i++)
+        msg_enc[i/8] |= (msg_soft[i] > 127) << (7-(i%8));
+    memset(msg_dec, 0x00, _n);
+    fec_decode(q, _n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, _n);
+
+    fec_destroy(q);
+}
+
+void autotest_fec_ldpc_errors_n648()    { fec_ldpc_test_errors(LIQUID_FEC_LDPC_N648,   100); }
+void autotest_fec_ldpc_errors_n1296()   { fec_ldpc_test_errors(LIQUID_FEC_LDPC_N1296,  100); }
+void autotest_fec_ldpc_errors_n1944()   { fec_ldpc_test_errors(LIQUID_FEC_LDPC_N1944,  100); }
+
+// sum-product decoding over a full-size sparse parity-check matrix
+void autotest_fec_sumproduct_n648()
+{
+    fec_ldpc_code q = fec_ldpc_code_create(12, 24, 27, fec_ldpc648_base);
+    unsigned int n = fec_ldpc_code_get_n(q);
+    unsigned int k = fec_ldpc_code_get_k(q);
+
+    unsigned char msg[k];
+    unsigned char cw[n];
+    unsigned int i;
+    for (i=0; i<k; i++)
+        msg[i] = rand() & 1;
+    fec_ldpc_code_encode(q, msg, cw);
+
+    // noisy LLRs with every 29th bit in error
+    float LLR[n];
+    for (i=0; i<n; i++) {
+        float v = 1.0f + (float)((i*53) % 16) / 4.0f;
+        LLR[i] = cw[i] ? -v : v;
+        if ( (i % 29) == 0 )
+            LLR[i] = -LLR[i];
+    }
+
+    unsigned char c_hat[n];
+    int parity_pass = fec_sumproduct(n-k, n, fec_ldpc_code_get_H(q), LLR, c_hat, 20);
+    CONTEND_EQUALITY(parity_pass, 1);
+    CONTEND_SAME_DATA(cw, c_hat, n);
+
+    fec_ldpc_code_destroy(q);
+}
@@ -31,11 +31,6 @@
 //
 void autotest_reedsolomon_223_255()
 {
-#if !LIBFEC_ENABLED
-    printf("warning: Reed-Solomon codes unavailable\n");
-    return;
-#endif
-
     unsigned int dec_msg_len = 223;
 
     // compute and test encoded message length
@@ -83,3 +78,208 @@ void autotest_reedsolomon_223_255()
     fec_destroy(q);
 }
 
+
+// multiply in GF(2^8) defined by polynomial _p (bitwise reference)
+static unsigned char reedsolomon_gf_mul(unsigned char _a,
+                                        unsigned char _b,
+                                        unsigned int  _p)
+{
+    unsigned int r = 0, a = _a;
+    while (_b) {
+        if (_b & 1) r ^= a;
+        a <<= 1;
+        if (a & 0x100) a ^= _p;
+        _b >>= 1;
+    }
+    return r;
+}
+
+// encode random (shortened) blocks, verify the codeword vanishes at the
+// roots of the generator polynomial, then correct nroots/2 random errors
+void reedsolomon_test_codec(unsigned int _gfpoly,
+                            unsigned int _fcr,
+                            unsigned int _prim,
+                            unsigned int _nroots,
+                            unsigned int _n)
+{
+    fec_rscodec q = fec_rscodec_create(_gfpoly, _fcr, _prim, _nroots);
+
+    unsigned int k = _n - _nroots;
+    unsigned char msg[_n];
+    unsigned char rec[_n];
+    unsigned int i, j, t;
+    for (t=0; t<8; t++) {
+        for (i=0; i<k; i++)
+            msg[i] = rand() & 0xff;
+        fec_rscodec_encode(q, msg, k, &msg[k]);
+
+        // evaluate codeword at beta^(fcr+i), beta = alpha^prim
+        unsigned char beta = 1;
+        for (i=0; i<_prim; i++)
+            beta = reedsolomon_gf_mul(beta, 2, _gfpoly);
+        unsigned char root = 1;
+        for (i=0; i<_fcr; i++)
+            root = reedsolomon_gf_mul(root, beta, _gfpoly);
+        for (i=0; i<_nroots; i++) {
+            unsigned char v = 0;
+            for (j=0; j<_n; j++)
+                v = reedsolomon_gf_mul(v, root, _gfpoly) ^ msg[j];
+            CONTEND_EQUALITY(v, 0);
+            root = reedsolomon_gf_mul(root, beta, _gfpoly);
+        }
+
+        // clean codeword
+        memmove(rec, msg, _n);
+        CONTEND_EQUALITY(fec_rscodec_decode(q, rec, _n), 0);
+
+        // corrupt distinct symbols
+        unsigned int num_errors = _nroots / 2;
+        unsigned char hit[_n];
+        memset(hit, 0x00, _n);
+        for (i=0; i<num_errors; i++) {
+            do j = rand() % _n; while (hit[j]);
+            hit[j] = 1;
+            rec[j] ^= 1 + (rand() % 255);
+        }
+        CONTEND_EQUALITY(fec_rscodec_decode(q, rec, _n), (int)num_errors);
+        CONTEND_SAME_DATA(rec, msg, _n);
+    }
+
+    fec_rscodec_destroy(q);
+}
+
+void autotest_reedsolomon_codec_n255_r32() { reedsolomon_test_codec(0x11d,  1,  1, 32, 255); }
+void autotest_reedsolomon_codec_n100_r32() { reedsolomon_test_codec(0x11d,  1,  1, 32, 100); }
+void autotest_reedsolomon_codec_n255_r16() { reedsolomon_test_codec(0x11d,  0,  1, 16, 255); }
+void autotest_reedsolomon_codec_n40_r8()   { reedsolomon_test_codec(0x11d,  1,  1,  8,  40); }
+void autotest_reedsolomon_codec_n12_r2()   { reedsolomon_test_codec(0x11d,  1,  1,  2,  12); }
+void autotest_reedsolomon_codec_n255_r64() { reedsolomon_test_codec(0x11d,  1,  1, 64, 255); }
+void autotest_reedsolomon_codec_ccsds()    { reedsolomon_test_codec(0x187,112, 11, 32, 255); }
+
+// multi-block message with the maximum number of errors in every block
+void autotest_reedsolomon_blocks()
+{
+    unsigned int dec_msg_len = 1024;
+    unsigned int enc_msg_len = fec_get_enc_msg_length(LIQUID_FEC_RS_M8,dec_msg_len);
+    CONTEND_EQUALITY( enc_msg_len, 1185 );
+
+    unsigned char msg_org[dec_msg_len];
+    unsigned char msg_enc[enc_msg_len];
+    unsigned char msg_dec[dec_msg_len];
+    unsigned int i;
+    for (i=0; i<dec_msg_len; i++)
+        msg_org[i] = rand() & 0xff;
+
+    fec q = fec_create(LIQUID_FEC_RS_M8,NULL);
+    fec_encode(q, dec_msg_len, msg_org, msg_enc);
+
+    // 16 errors in each 237-symbol block
+    for (i=0; i<enc_msg_len; i++) {
+        if ( (i % 237) % 14 == 3 && (i % 237) < 16*14 )
+            msg_enc[i] ^= 0x5a;
+    }
+
+    fec_decode(q, dec_msg_len, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg_org, msg_dec, dec_msg_len);
+
+    fec_destroy(q);
+}
+
+// batched decoding of independent blocks matches decoding each block on
+// its own, including blocks that are clean or cannot be corrected
+void reedsolomon_test_batch(unsigned int _nroots,
+                            unsigned int _n,
+                            unsigned int _num)
+{
+    fec_rscodec q = fec_rscodec_create(0x11d, 1, 1, _nroots);
+
+    unsigned int k = _n - _nroots;
+    unsigned char msg[_num*_n];
+    unsigned char rec0[_num*_n];
+    unsigned char rec1[_num*_n];
+    int nerr[_num];
+    unsigned int b, i, j;
+    for (b=0; b<_num; b++) {
+        unsigned char * m = &msg[b*_n];
+        for (i=0; i<k; i++)
+            m[i] = rand() & 0xff;
+        fec_rscodec_encode(q, m, k, &m[k]);
+
+        // between zero and two more errors than can be corrected
+        unsigned int num_errors = b % (_nroots/2 + 3);
+        unsigned char hit[_n];
+        memset(hit, 0x00, _n);
+        memmove(&rec0[b*_n], m, _n);
+        for (i=0; i<num_errors; i++) {
+            do j = rand() % _n; while (hit[j]);
+            hit[j] = 1;
+            rec0[b*_n + j] ^= 1 + (rand() % 255);
+        }
+    }
+    memmove(rec1, rec0, sizeof(rec0));
+
+    fec_rscodec_decode_block(q, rec1, _n, _num, nerr);
+    for (b=0; b<_num; b++) {
+        unsigned int num_errors = b % (_nroots/2 + 3);
+        CONTEND_EQUALITY(fec_rscodec_decode(q, &rec0[b*_n], _n), nerr[b]);
+        CONTEND_SAME_DATA(&rec0[b*_n], &rec1[b*_n], _n);
+        if (num_errors <= _nroots/2) {
+            CONTEND_EQUALITY(nerr[b], (int)num_errors);
+            CONTEND_SAME_DATA(&msg[b*_n], &rec1[b*_n], _n);
+        }
+    }
+
+    fec_rscodec_destroy(q);
+}
+
+void autotest_reedsolomon_batch_n255_r32() { reedsolomon_test_batch(32, 255, 40); }
+void autotest_reedsolomon_batch_n60_r16()  { reedsolomon_test_batch(16,  60, 23); }
+void autotest_reedsolomon_batch_n20_r4()   { reedsolomon_test_batch( 4,  20,  5); }
+
+// fec interface with non-default parity and block lengths
+void reedsolomon_test_props(unsigned int _nroots,
+                            unsigned int _kk,
+                            unsigned int _dec_msg_len)
+{
+    fecrsprops_s props;
+    fecrsprops_init_default(&props);
+    CONTEND_EQUALITY(fecrsprops_get_enc_msg_length(&props, 1024),
+                     fec_get_enc_msg_length(LIQUID_FEC_RS_M8, 1024));
+    props.nroots = _nroots;
+    props.kk     = _kk;
+
+    // blocks of at most kk data symbols, each with nroots parity symbols
+    unsigned int num_blocks  = (_dec_msg_len + _kk - 1) / _kk;
+    unsigned int block_len   = (_dec_msg_len + num_blocks - 1) / num_blocks + _nroots;
+    unsigned int enc_msg_len = fecrsprops_get_enc_msg_length(&props, _dec_msg_len);
+    CONTEND_EQUALITY(enc_msg_len, num_blocks*block_len);
+
+    unsigned char msg_org[_dec_msg_len];
+    unsigned char msg_enc[enc_msg_len];
+    unsigned char msg_dec[_dec_msg_len];
+    unsigned int i;
+    for (i=0; i<_dec_msg_len; i++)
+        msg_org[i] = rand() & 0xff;
+
+    fec q = fec_create(LIQUID_FEC_RS_M8, &props);
+    CONTEND_EQUALITY(fec_get_enc_msg_len(q, _dec_msg_len), enc_msg_len);
+    CONTEND_DELTA(fec_get_code_rate(q), (float)_kk / (float)(_kk + _nroots), 1e-6f);
+    fec_encode(q, _dec_msg_len, msg_org, msg_enc);
+
+    // maximum number of errors in every other block
+    for (i=0; i<enc_msg_len; i++) {
+        unsigned int b = i / block_len;
+        unsigned int j = i % block_len;
+        if ( (b & 1) && j % 3 == 1 && j/3 < _nroots/2 )
+            msg_enc[i] ^= 0xa5;
+    }
+
+    fec_decode(q, _dec_msg_len, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg_org, msg_dec, _dec_msg_len);
+
+    fec_destroy(q);
+}
+
+void autotest_reedsolomon_props_r16_k100() { reedsolomon_test_props(16, 100, 2000); }
+void autotest_reedsolomon_props_r8_k40()   { reedsolomon_test_props( 8,  40,  777); }
+void autotest_reedsolomon_props_r64_k191() { reedsolomon_test_props(64, 191,  500); }
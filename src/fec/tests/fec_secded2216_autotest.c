@@ -146,3 +146,33 @@ void autotest_secded2216_codec_e2()
     }
 }
 
+//
+// AUTOTEST: SEC-DED (22,16) block codec, one error in every symbol
+//
+void autotest_secded2216_codec_block()
+{
+    unsigned int n = 31*2;    // decoded message length
+    fec_scheme fs = LIQUID_FEC_SECDED2216;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_dec[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    fec q = fec_create(fs,NULL);
+    fec_encode(q, n, msg, msg_enc);
+
+    // flip a random bit in each 22-bit symbol (3 bytes)
+    for (i=0; i<n/2; i++) {
+        div_t d = div(rand() % 22, 8);
+        msg_enc[3*i + 3-d.quot-1] ^= 1 << d.rem;
+    }
+
+    fec_decode(q, n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, n);
+    fec_destroy(q);
+}
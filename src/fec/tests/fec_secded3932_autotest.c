@@ -162,3 +162,33 @@ void autotest_secded3932_codec_e2()
     }
 }
 
+//
+// AUTOTEST: SEC-DED (39,32) block codec, one error in every symbol
+//
+void autotest_secded3932_codec_block()
+{
+    unsigned int n = 15*4;    // decoded message length
+    fec_scheme fs = LIQUID_FEC_SECDED3932;
+    unsigned int n_enc = fec_get_enc_msg_length(fs,n);
+
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_dec[n];
+
+    unsigned int i;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    fec q = fec_create(fs,NULL);
+    fec_encode(q, n, msg, msg_enc);
+
+    // flip a random bit in each 39-bit symbol (5 bytes)
+    for (i=0; i<n/4; i++) {
+        div_t d = div(rand() % 39, 8);
+        msg_enc[5*i + 5-d.quot-1] ^= 1 << d.rem;
+    }
+
+    fec_decode(q, n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, n);
+    fec_destroy(q);
+}
@@ -31,30 +31,6 @@ void fec_test_soft_codec(fec_scheme _fs,
                          unsigned int _n,
                          void * _opts)
 {
-#if !LIBFEC_ENABLED
-    if ( _fs == LIQUID_FEC_CONV_V27    ||
-         _fs == LIQUID_FEC_CONV_V29    ||
-         _fs == LIQUID_FEC_CONV_V39    ||
-         _fs == LIQUID_FEC_CONV_V615   ||
-         _fs == LIQUID_FEC_CONV_V27P23 ||
-         _fs == LIQUID_FEC_CONV_V27P34 ||
-         _fs == LIQUID_FEC_CONV_V27P45 ||
-         _fs == LIQUID_FEC_CONV_V27P56 ||
-         _fs == LIQUID_FEC_CONV_V27P67 ||
-         _fs == LIQUID_FEC_CONV_V27P78 ||
-         _fs == LIQUID_FEC_CONV_V29P23 ||
-         _fs == LIQUID_FEC_CONV_V29P34 ||
-         _fs == LIQUID_FEC_CONV_V29P45 ||
-         _fs == LIQUID_FEC_CONV_V29P56 ||
-         _fs == LIQUID_FEC_CONV_V29P67 ||
-         _fs == LIQUID_FEC_CONV_V29P78 ||
-         _fs == LIQUID_FEC_RS_M8)
-    {
-        AUTOTEST_WARN("convolutional, Reed-Solomon codes unavailable (install libfec)\n");
-        return;
-    }
-#endif
-
     // generate fec object
     fec q = fec_create(_fs,_opts);
 
@@ -100,6 +76,124 @@ void fec_test_soft_codec(fec_scheme _fs,
     fec_destroy(q);
 }
 
+// Test nearest-codeword search against exhaustive distance computation
+//  _n      :   codeword length (bits)
+//  _num    :   number of candidates
+//  _index  :   use candidate index list?
+void fec_test_soft_nearest(unsigned int _n,
+                           unsigned int _num,
+                           int          _index)
+{
+    unsigned char masks[16*256];
+    unsigned char index[256];
+    unsigned char soft_bits[16];
+    unsigned int i, j, k, t;
+    for (i=0; i<256; i++)
+        fecsoft_codeword_mask(rand() & ((1<<_n)-1), _n, &masks[16*i]);
+
+    for (t=0; t<100; t++) {
+        for (i=0; i<_num; i++)
+            index[i] = _index ? rand() & 0xff : i;
+        // coarse soft bits to exercise ties
+        for (k=0; k<_n; k++)
+            soft_bits[k] = (t & 1) ? rand() & 0xff : 64*(rand() % 4);
+
+        // reference: first candidate at minimum distance
+        unsigned int i_min = 0, d_min = 0;
+        for (i=0; i<_num; i++) {
+            j = index[i];
+            unsigned int d = 0;
+            for (k=0; k<_n; k++)
+                d += masks[16*j+k] ? 255 - soft_bits[k] : soft_bits[k];
+            if (i==0 || d < d_min) {
+                i_min = i;
+                d_min = d;
+            }
+        }
+        CONTEND_EQUALITY(fecsoft_nearest(soft_bits, _n, masks, _index ? index : NULL, _num), i_min);
+    }
+}
+
+void autotest_fecsoft_nearest_n7()     { fec_test_soft_nearest( 7,  16, 0); }
+void autotest_fecsoft_nearest_n12()    { fec_test_soft_nearest(12, 256, 0); }
+void autotest_fecsoft_nearest_index()  { fec_test_soft_nearest(12,  18, 1); }
+void autotest_fecsoft_nearest_one()    { fec_test_soft_nearest( 8,   1, 1); }
+
+// Test nearest-codeword search over a sequence of symbols against
+// searching each symbol on its own
+//  _n      :   codeword length (bits)
+//  _num    :   number of candidates
+void fec_test_soft_nearest_block(unsigned int _n,
+                                 unsigned int _num)
+{
+    unsigned int num_sym = 37;
+    unsigned char masks[16*256];
+    unsigned char soft_bits[16*37];
+    unsigned char sym[37];
+    unsigned int i;
+    for (i=0; i<256; i++)
+        fecsoft_codeword_mask(rand() & ((1<<_n)-1), _n, &masks[16*i]);
+
+    // coarse soft bits in every other symbol to exercise ties
+    for (i=0; i<_n*num_sym; i++)
+        soft_bits[i] = ((i/_n) & 1) ? rand() & 0xff : 64*(rand() % 4);
+
+    fecsoft_nearest_block(soft_bits, _n, num_sym, masks, NULL, _num, sym);
+    for (i=0; i<num_sym; i++)
+        CONTEND_EQUALITY(sym[i], fecsoft_nearest(&soft_bits[i*_n], _n, masks, NULL, _num));
+}
+
+void autotest_fecsoft_nearest_block_n7()  { fec_test_soft_nearest_block( 7,  16); }
+void autotest_fecsoft_nearest_block_n8()  { fec_test_soft_nearest_block( 8,  16); }
+void autotest_fecsoft_nearest_block_n12() { fec_test_soft_nearest_block(12, 256); }
+
+// Test Chase soft-decoding of a block code with weak errors beyond
+// the hard-decision correction capability in every symbol
+//  _fs         :   coding scheme
+//  _n          :   decoded message length (multiple of symbol size)
+//  _m          :   number of soft bits per encoded symbol
+//  _s          :   number of unused leading soft bits in each symbol
+//  _num_errors :   number of weak errors per symbol
+void fec_test_soft_chase(fec_scheme   _fs,
+                         unsigned int _n,
+                         unsigned int _m,
+                         unsigned int _s,
+                         unsigned int _num_errors)
+{
+    fec q = fec_create(_fs,NULL);
+
+    unsigned int n_enc = fec_get_enc_msg_length(_fs,_n);
+    unsigned char msg[_n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[_n];
+
+    unsigned int i, k;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+    fec_encode(q, _n, msg, msg_enc);
+    for (i=0; i<8*n_enc; i++)
+        msg_soft[i] = (msg_enc[i/8] >> (7-(i%8))) & 1 ? 255 : 0;
+
+    // flip distinct bits in each symbol, each just across the threshold
+    // with increasing reliability
+    for (i=0; i<8*n_enc/_m; i++) {
+        unsigned char * v = &msg_soft[i*_m];
+        for (k=0; k<_num_errors; k++) {
+            unsigned int pos;
+            do {
+                pos = _s + (rand() % (_m - _s));
+            } while (v[pos] != 0 && v[pos] != 255);
+            v[pos] = v[pos] ? 127 - 4*k : 128 + 4*k;
+        }
+    }
+
+    fec_decode_soft(q, _n, msg_soft, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, _n);
+
+    fec_destroy(q);
+}
+
 // 
 // AUTOTESTS: basic encode/decode functionality
 //
@@ -113,6 +207,18 @@ void autotest_fecsoft_h74()    { fec_test_soft_codec(LIQUID_FEC_HAMMING74,   64,
 void autotest_fecsoft_h84()    { fec_test_soft_codec(LIQUID_FEC_HAMMING84,   64, NULL); }
 void autotest_fecsoft_h128()   { fec_test_soft_codec(LIQUID_FEC_HAMMING128,  64, NULL); }
 
+// Golay and SEC-DED block codes
+void autotest_fecsoft_g2412()  { fec_test_soft_codec(LIQUID_FEC_GOLAY2412,   37, NULL); }
+void autotest_fecsoft_secded2216() { fec_test_soft_codec(LIQUID_FEC_SECDED2216, 37, NULL); }
+void autotest_fecsoft_secded3932() { fec_test_soft_codec(LIQUID_FEC_SECDED3932, 37, NULL); }
+void autotest_fecsoft_secded7264() { fec_test_soft_codec(LIQUID_FEC_SECDED7264, 37, NULL); }
+
+// Chase decoding beyond hard-decision capability
+void autotest_fecsoft_chase_g2412()      { fec_test_soft_chase(LIQUID_FEC_GOLAY2412,  48, 24, 0, 5); }
+void autotest_fecsoft_chase_secded2216() { fec_test_soft_chase(LIQUID_FEC_SECDED2216, 48, 24, 2, 2); }
+void autotest_fecsoft_chase_secded3932() { fec_test_soft_chase(LIQUID_FEC_SECDED3932, 48, 40, 1, 2); }
+void autotest_fecsoft_chase_secded7264() { fec_test_soft_chase(LIQUID_FEC_SECDED7264, 48, 72, 0, 2); }
+
 // convolutional codes
 void autotest_fecsoft_v27()    { fec_test_soft_codec(LIQUID_FEC_CONV_V27,    64, NULL); }
 void autotest_fecsoft_v29()    { fec_test_soft_codec(LIQUID_FEC_CONV_V29,    64, NULL); }
@@ -137,4 +243,9 @@ void autotest_fecsoft_v29p78() { fec_test_soft_codec(LIQUID_FEC_CONV_V29P78, 64,
 // Reed-Solomon block codes
 void autotest_fecsoft_rs8()    { fec_test_soft_codec(LIQUID_FEC_RS_M8,       64, NULL); }
 
+// LDPC codes
+void autotest_fecsoft_ldpc648()  { fec_test_soft_codec(LIQUID_FEC_LDPC_N648,   64, NULL); }
+void autotest_fecsoft_ldpc1296() { fec_test_soft_codec(LIQUID_FEC_LDPC_N1296,  64, NULL); }
+void autotest_fecsoft_ldpc1944() { fec_test_soft_codec(LIQUID_FEC_LDPC_N1944,  64, NULL); }
+
 
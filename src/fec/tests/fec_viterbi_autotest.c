@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// compare SIMD add-compare-select kernels against the portable version
+// over a few trellis steps from random path metrics
+void fec_viterbi_test_acs(unsigned int _K,
+                          unsigned int _R,
+                          int *        _poly)
+{
+    unsigned int num_states = 1 << (_K-1);
+    unsigned int half       = num_states / 2;
+    unsigned int num_words  = num_states / 32;
+    unsigned int num_steps  = 5;
+
+    // branch table as built by fec_viterbi_create()
+    int16_t * bt = (int16_t*) aligned_alloc(32, _R*16*sizeof(int16_t));
+    unsigned char idx[half/16];
+    unsigned int i, r;
+    for (r=0; r<_R; r++) {
+        for (i=0; i<16; i++)
+            bt[r*16+i] = liquid_count_ones_mod2((2*i) & _poly[r]) ? 255 : 0;
+    }
+    for (i=0; i<half/16; i++) {
+        idx[i] = 0;
+        for (r=0; r<_R; r++)
+            idx[i] |= liquid_count_ones_mod2((32*i) & _poly[r]) << r;
+    }
+
+    // random path metrics (within the spread the decoder maintains)
+    // and input symbols
+    int16_t * m0 = (int16_t*) aligned_alloc(32, num_states*sizeof(int16_t));
+    int16_t * m1 = (int16_t*) aligned_alloc(32, num_states*sizeof(int16_t));
+    int16_t * v0 = (int16_t*) aligned_alloc(32, num_states*sizeof(int16_t));
+    int16_t * v1 = (int16_t*) aligned_alloc(32, num_states*sizeof(int16_t));
+    uint32_t  d0[num_steps*num_words];
+    uint32_t  d1[num_steps*num_words];
+    int spread = 255*_R*(_K-1);
+    for (i=0; i<num_states; i++)
+        m0[i] = (int)(rand() % spread) - spread/2;
+    unsigned char sym[num_steps*_R];
+    for (i=0; i<num_steps*_R; i++)
+        sym[i] = rand() & 0xff;
+
+    int16_t tmp[num_states];
+    memmove(tmp, m0, num_states*sizeof(int16_t));
+    fec_viterbi_acs_port(bt, idx, _R, half, sym, num_steps, m0, m1, d0);
+
+#if defined(__SSE2__)
+    memmove(v0, tmp, num_states*sizeof(int16_t));
+    fec_viterbi_acs_sse2(bt, idx, _R, half, sym, num_steps, v0, v1, d1);
+    CONTEND_SAME_DATA(m1, v1, num_states*sizeof(int16_t));
+    CONTEND_SAME_DATA(d0, d1, num_steps*num_words*sizeof(uint32_t));
+#endif
+
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2)) {
+        memmove(v0, tmp, num_states*sizeof(int16_t));
+        fec_viterbi_acs_avx2(bt, idx, _R, half, sym, num_steps, v0, v1, d1);
+        CONTEND_SAME_DATA(m1, v1, num_states*sizeof(int16_t));
+        CONTEND_SAME_DATA(d0, d1, num_steps*num_words*sizeof(uint32_t));
+    }
+#endif
+
+    free(bt);
+    free(m0);
+    free(m1);
+    free(v0);
+    free(v1);
+}
+
+// decode noisy soft bits with hard errors spread across the frame
+void fec_viterbi_test_errors(fec_scheme _fs, unsigned int _n)
+{
+    fec q = fec_create(_fs, NULL);
+
+    unsigned int n_enc = fec_get_enc_msg_length(_fs,_n);
+    unsigned char msg[_n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[_n];
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+    fec_encode(q, _n, msg, msg_enc);
+
+    // soft bits with deterministic noise and every 37th bit in error
+    for (i=0; i<8*n_enc; i++) {
+        unsigned int bit = (msg_enc[i/8] >> (7-(i%8))) & 1;
+        unsigned int v   = 48 + ((i*97) % 64);
+        msg_soft[i] = bit ? 255 - v : v;
+        if ( (i % 37) == 0 )
+            msg_soft[i] = 255 - msg_soft[i];
+    }
+
+    // soft decoding corrects all errors
+    memset(msg_dec, 0x00, _n);
+    fec_decode_soft(q, _n, msg_soft, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, _n);
+
+    // hard decoding from the same (sliced) bits
+    for (i=0; i<n_enc; i++)
+        msg_enc[i] = 0;
+    for (i=0; i<8*n_enc; i++)
+        msg_enc[i/8] |= (msg_soft[i] > 127) << (7-(i%8));
+    memset(msg_dec, 0x00, _n);
+    fec_decode(q, _n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, _n);
+
+    fec_destroy(q);
+}
+
+void autotest_fec_viterbi_acs_v27()  { fec_viterbi_test_acs( 7, 2, fec_conv27_poly);  }
+void autotest_fec_viterbi_acs_v29()  { fec_viterbi_test_acs( 9, 2, fec_conv29_poly);  }
+void autotest_fec_viterbi_acs_v39()  { fec_viterbi_test_acs( 9, 3, fec_conv39_poly);  }
+void autotest_fec_viterbi_acs_v615() { fec_viterbi_test_acs(15, 6, fec_conv615_poly); }
+
+void autotest_fec_viterbi_errors_v27()  { fec_viterbi_test_errors(LIQUID_FEC_CONV_V27,  100); }
+void autotest_fec_viterbi_errors_v29()  { fec_viterbi_test_errors(LIQUID_FEC_CONV_V29,  100); }
+void autotest_fec_viterbi_errors_v39()  { fec_viterbi_test_errors(LIQUID_FEC_CONV_V39,  100); }
+void autotest_fec_viterbi_errors_v615() { fec_viterbi_test_errors(LIQUID_FEC_CONV_V615, 100); }
+
@@ -21,6 +21,8 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
 #include "autotest/autotest.h"
 #include "liquid.h"
@@ -85,3 +87,84 @@ void autotest_interleaver_soft_16()     { interleaver_test_soft(16  ); }
 void autotest_interleaver_soft_64()     { interleaver_test_soft(64  ); }
 void autotest_interleaver_soft_256()    { interleaver_test_soft(256 ); }
 
+
+// reference permutation: swap bits _mask of byte pairs one at a time
+static void interleaver_permute_ref(unsigned char * _x,
+                                    unsigned int    _n,
+                                    unsigned int    _M,
+                                    unsigned int    _N,
+                                    unsigned char   _mask)
+{
+    unsigned int i, j, m=0, n=_n/3, n2=_n/2;
+    for (i=0; i<n2; i++) {
+        do {
+            j = m*_N + n;
+            m++;
+            if (m == _M) {
+                n = (n+1) % (_N);
+                m=0;
+            }
+        } while (j>=n2);
+
+        unsigned char tmp0 = (_x[2*i+0] & (~_mask)) | (_x[2*j+1] & ( _mask));
+        unsigned char tmp1 = (_x[2*i+0] & ( _mask)) | (_x[2*j+1] & (~_mask));
+        _x[2*i+0] = tmp0;
+        _x[2*j+1] = tmp1;
+    }
+}
+
+// compare against the reference passes for each depth, check that soft
+// bits follow the hard bits, and run in place
+void interleaver_test_reference(unsigned int _n)
+{
+    unsigned int M = 1 + (unsigned int) floorf(sqrtf(_n));
+    unsigned int N = _n / M;
+    while (_n >= M*N) N++;
+
+    unsigned char x[_n], y[_n], r[_n];
+    unsigned char xs[8*_n], ys[8*_n];
+    unsigned int i, k, depth;
+    for (i=0; i<_n; i++)
+        x[i] = rand() & 0xff;
+    for (i=0; i<8*_n; i++)
+        xs[i] = ((x[i/8] >> (7-(i%8))) & 1) ? 255 - (rand() % 64) : rand() % 64;
+
+    interleaver q = interleaver_create(_n);
+    for (depth=0; depth<=4; depth++) {
+        interleaver_set_depth(q, depth);
+
+        // reference
+        memmove(r, x, _n);
+        if (depth > 0) interleaver_permute_ref(r, _n, M, N,   0xff);
+        if (depth > 1) interleaver_permute_ref(r, _n, M, N+2, 0x0f);
+        if (depth > 2) interleaver_permute_ref(r, _n, M, N+4, 0x55);
+        if (depth > 3) interleaver_permute_ref(r, _n, M, N+8, 0x33);
+
+        interleaver_encode(q, x, y);
+        CONTEND_SAME_DATA(y, r, _n);
+
+        // soft bits
+        interleaver_encode_soft(q, xs, ys);
+        for (i=0; i<_n; i++) {
+            for (k=0; k<8; k++)
+                CONTEND_EQUALITY((ys[8*i+k] > 127), (r[i] >> (7-k)) & 1);
+        }
+
+        // in place
+        memmove(y, x, _n);
+        interleaver_encode(q, y, y);
+        CONTEND_SAME_DATA(y, r, _n);
+        interleaver_decode(q, y, y);
+        CONTEND_SAME_DATA(y, x, _n);
+        memmove(ys, xs, 8*_n);
+        interleaver_encode_soft(q, ys, ys);
+        interleaver_decode_soft(q, ys, ys);
+        CONTEND_SAME_DATA(ys, xs, 8*_n);
+    }
+    interleaver_destroy(q);
+}
+
+void autotest_interleaver_reference_7()    { interleaver_test_reference(7   ); }
+void autotest_interleaver_reference_64()   { interleaver_test_reference(64  ); }
+void autotest_interleaver_reference_203()  { interleaver_test_reference(203 ); }
+void autotest_interleaver_reference_1024() { interleaver_test_reference(1024); }
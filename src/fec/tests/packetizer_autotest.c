@@ -20,6 +20,9 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -65,3 +68,135 @@ void autotest_packetizer_n16_0_0()  { packetizer_test_codec(16, LIQUID_CRC_32, L
 void autotest_packetizer_n16_0_1()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_REP3);       }
 void autotest_packetizer_n16_0_2()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_HAMMING74);  }
 
+
+// encode a packet stage by stage with the primitive objects
+void packetizer_test_reference(unsigned int    _n,
+                               crc_scheme      _crc,
+                               fec_scheme      _fec0,
+                               fec_scheme      _fec1,
+                               unsigned char * _msg,
+                               unsigned char * _pkt)
+{
+    unsigned int pkt_len = packetizer_compute_enc_msg_len(_n,_crc,_fec0,_fec1);
+    unsigned char b0[pkt_len];
+    unsigned char b1[pkt_len];
+    fec_scheme fs[2] = {_fec0, _fec1};
+
+    unsigned int k = _n + crc_sizeof_key(_crc);
+    memmove(b0, _msg, _n);
+    crc_append_key(_crc, b0, _n);
+    scramble_data(b0, k);
+
+    unsigned int i;
+    for (i=0; i<2; i++) {
+        unsigned int n_enc = fec_get_enc_msg_length(fs[i], k);
+        fec         f = fec_create(fs[i], NULL);
+        interleaver q = interleaver_create(n_enc);
+        if (fs[i] == LIQUID_FEC_NONE)
+            interleaver_set_depth(q, 0);
+        fec_encode(f, k, b0, b1);
+        interleaver_encode(q, b1, b0);
+        fec_destroy(f);
+        interleaver_destroy(q);
+        k = n_enc;
+    }
+    memmove(_pkt, b0, pkt_len);
+}
+
+// check encoder against reference, and hard/soft decoders using both
+// internal and caller-supplied scratch memory, in place and out of place
+void packetizer_test_scratch(unsigned int _n,
+                             crc_scheme   _crc,
+                             fec_scheme   _fec0,
+                             fec_scheme   _fec1)
+{
+    packetizer p = packetizer_create(_n,_crc,_fec0,_fec1);
+    unsigned int pkt_len = packetizer_get_enc_msg_len(p);
+    unsigned char msg[_n];
+    unsigned char msg_rx[_n];
+    unsigned char pkt_ref[pkt_len];
+    unsigned char pkt[pkt_len];
+    unsigned char pkt_soft[8*pkt_len];
+    unsigned char buf[packetizer_get_scratch_len(p)];
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+    packetizer_test_reference(_n, _crc, _fec0, _fec1, msg, pkt_ref);
+
+    // encode
+    packetizer_encode(p, msg, pkt);
+    CONTEND_SAME_DATA(pkt, pkt_ref, pkt_len);
+    memset(pkt, 0x00, pkt_len);
+    packetizer_encode_scratch(p, msg, pkt, buf);
+    CONTEND_SAME_DATA(pkt, pkt_ref, pkt_len);
+    memmove(pkt, msg, _n);
+    packetizer_encode_scratch(p, pkt, pkt, buf);
+    CONTEND_SAME_DATA(pkt, pkt_ref, pkt_len);
+
+    // decode (input must be left untouched)
+    memset(msg_rx, 0x00, _n);
+    CONTEND_EQUALITY(packetizer_decode_scratch(p, pkt, msg_rx, buf), 1);
+    CONTEND_SAME_DATA(msg_rx, msg, _n);
+    CONTEND_SAME_DATA(pkt, pkt_ref, pkt_len);
+
+    // soft decode
+    for (i=0; i<8*pkt_len; i++)
+        pkt_soft[i] = ((pkt[i/8] >> (7-(i%8))) & 1) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+    memset(msg_rx, 0x00, _n);
+    CONTEND_EQUALITY(packetizer_decode_soft_scratch(p, pkt_soft, msg_rx, buf), 1);
+    CONTEND_SAME_DATA(msg_rx, msg, _n);
+    memset(msg_rx, 0x00, _n);
+    CONTEND_EQUALITY(packetizer_decode_soft(p, pkt_soft, msg_rx), 1);
+    CONTEND_SAME_DATA(msg_rx, msg, _n);
+
+    // decode in place
+    CONTEND_EQUALITY(packetizer_decode_scratch(p, pkt, pkt, buf), 1);
+    CONTEND_SAME_DATA(pkt, msg, _n);
+
+    packetizer_destroy(p);
+}
+
+void autotest_packetizer_scratch_none()  { packetizer_test_scratch( 40, LIQUID_CRC_32,       LIQUID_FEC_NONE,       LIQUID_FEC_NONE);         }
+void autotest_packetizer_scratch_inner() { packetizer_test_scratch( 40, LIQUID_CRC_16,       LIQUID_FEC_HAMMING128, LIQUID_FEC_NONE);         }
+void autotest_packetizer_scratch_outer() { packetizer_test_scratch( 57, LIQUID_CRC_8,        LIQUID_FEC_NONE,       LIQUID_FEC_CONV_V27);     }
+void autotest_packetizer_scratch_both()  { packetizer_test_scratch(200, LIQUID_CRC_32,       LIQUID_FEC_RS_M8,      LIQUID_FEC_CONV_V29P23);  }
+void autotest_packetizer_scratch_long()  { packetizer_test_scratch(500, LIQUID_CRC_CHECKSUM, LIQUID_FEC_GOLAY2412,  LIQUID_FEC_SECDED7264);   }
+
+// re-configuring an object matches a newly created one
+void autotest_packetizer_recreate()
+{
+    struct { unsigned int n; crc_scheme crc; fec_scheme fec0, fec1; } cfg[5] = {
+        {100, LIQUID_CRC_32,   LIQUID_FEC_NONE,       LIQUID_FEC_HAMMING74},
+        { 20, LIQUID_CRC_16,   LIQUID_FEC_HAMMING128, LIQUID_FEC_CONV_V27},
+        {300, LIQUID_CRC_8,    LIQUID_FEC_RS_M8,      LIQUID_FEC_NONE},
+        {300, LIQUID_CRC_8,    LIQUID_FEC_RS_M8,      LIQUID_FEC_HAMMING84},
+        { 64, LIQUID_CRC_NONE, LIQUID_FEC_NONE,       LIQUID_FEC_NONE},
+    };
+    unsigned char msg[300];
+    unsigned char pkt_ref[8*300];
+    unsigned char pkt[8*300];
+    unsigned int i, j;
+    for (i=0; i<300; i++)
+        msg[i] = rand() & 0xff;
+
+    packetizer p = NULL;
+    for (i=0; i<5; i++) {
+        p = packetizer_recreate(p, cfg[i].n, cfg[i].crc, cfg[i].fec0, cfg[i].fec1);
+        packetizer r = packetizer_create(cfg[i].n, cfg[i].crc, cfg[i].fec0, cfg[i].fec1);
+        unsigned int pkt_len = packetizer_get_enc_msg_len(r);
+        CONTEND_EQUALITY(packetizer_get_enc_msg_len(p), pkt_len);
+
+        packetizer_encode(r, msg, pkt_ref);
+        packetizer_encode(p, msg, pkt);
+        CONTEND_SAME_DATA(pkt, pkt_ref, pkt_len);
+
+        unsigned char msg_rx[cfg[i].n];
+        for (j=0; j<cfg[i].n; j++)
+            msg_rx[j] = 0;
+        CONTEND_EQUALITY(packetizer_decode(p, pkt, msg_rx), 1);
+        CONTEND_SAME_DATA(msg_rx, msg, cfg[i].n);
+        packetizer_destroy(r);
+    }
+    packetizer_destroy(p);
+}
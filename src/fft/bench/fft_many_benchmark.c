@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_many_benchmark.c : benchmark batched FFTs (one trial is one
+//                        transform of the batch)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// helper function to keep code base small
+void fft_many_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _nfft,
+                    unsigned int        _howmany)
+{
+    // initialize arrays, plan
+    unsigned int num = _nfft * _howmany;
+    float complex * x = (float complex *) malloc(num*sizeof(float complex));
+    float complex * y = (float complex *) malloc(num*sizeof(float complex));
+    fftplan q = fft_create_plan_many(_nfft, _howmany, x, 1, _nfft, y, 1, _nfft,
+                                     LIQUID_FFT_FORWARD, 0);
+
+    unsigned long int i;
+    for (i=0; i<num; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= _nfft;
+    *_num_iterations /= _howmany;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        fft_execute(q);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _howmany;
+
+    fft_destroy_plan(q);
+    free(x);
+    free(y);
+}
+
+#define FFT_MANY_BENCHMARK_API(N,B)         \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ fft_many_bench(_start, _finish, _num_iterations, N, B); }
+
+void benchmark_fft_many_16x64     FFT_MANY_BENCHMARK_API(16,   64)
+void benchmark_fft_many_32x64     FFT_MANY_BENCHMARK_API(32,   64)
+void benchmark_fft_many_64x64     FFT_MANY_BENCHMARK_API(64,   64)
+void benchmark_fft_many_128x64    FFT_MANY_BENCHMARK_API(128,  64)
+void benchmark_fft_many_256x64    FFT_MANY_BENCHMARK_API(256,  64)
+void benchmark_fft_many_96x64     FFT_MANY_BENCHMARK_API(96,   64)
+
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_r2c_benchmark.c : benchmark real-to-complex transforms
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// helper function to keep code base small
+void fft_r2c_bench(struct rusage *     _start,
+                   struct rusage *     _finish,
+                   unsigned long int * _num_iterations,
+                   unsigned int        _nfft)
+{
+    // initialize arrays, plan
+    float *         x = (float *)         malloc(_nfft*sizeof(float));
+    float complex * y = (float complex *) malloc((_nfft/2+1)*sizeof(float complex));
+    fftplan q = fft_create_plan_r2c(_nfft, x, y, 0);
+
+    unsigned long int i;
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf();
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= _nfft;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        fft_execute(q);
+        fft_execute(q);
+        fft_execute(q);
+        fft_execute(q);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    fft_destroy_plan(q);
+    free(x);
+    free(y);
+}
+
+#define FFT_R2C_BENCHMARK_API(N)            \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ fft_r2c_bench(_start, _finish, _num_iterations, N); }
+
+void benchmark_fft_r2c_64     FFT_R2C_BENCHMARK_API(64)
+void benchmark_fft_r2c_256    FFT_R2C_BENCHMARK_API(256)
+void benchmark_fft_r2c_1024   FFT_R2C_BENCHMARK_API(1024)
+void benchmark_fft_r2c_4096   FFT_R2C_BENCHMARK_API(4096)
+void benchmark_fft_r2c_240    FFT_R2C_BENCHMARK_API(240)
+
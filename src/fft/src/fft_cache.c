@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_cache.c : process-wide plan cache and wisdom store
+//
+// Plans keep their buffers and sub-plans to themselves, but the tables
+// computed when creating them (twiddle factors, index sequences, the
+// pre-computed transforms of Rader's algorithm) depend only on the
+// size, direction and method. These tables are created once, shared
+// by reference count, and kept after the last plan using them is
+// destroyed until fft_cache_purge() is called.
+//
+// The wisdom store records the fastest measured method for each
+// transform size. It is filled by creating plans with the
+// LIQUID_FFT_MEASURE flag and can be exported to and imported from a
+// text file with one "<size> <method>" entry per line.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+static pthread_mutex_t FFT(_cache_mutex) = PTHREAD_MUTEX_INITIALIZER;
+#   define FFT_CACHE_LOCK()    pthread_mutex_lock(&FFT(_cache_mutex))
+#   define FFT_CACHE_UNLOCK()  pthread_mutex_unlock(&FFT(_cache_mutex))
+#else
+#   define FFT_CACHE_LOCK()
+#   define FFT_CACHE_UNLOCK()
+#endif
+
+// longest transform for which the regular DFT is a measured candidate
+#define FFT_WISDOM_DFT_MAXLEN 64
+
+// minimum time spent measuring each candidate method [seconds]
+#define FFT_WISDOM_MEASURE_TIME 2e-3
+
+// cached tables (linked list)
+static FFT(table) FFT(_cache_tables) = NULL;
+
+// wisdom entry: fastest method for transform size
+struct FFT(_wisdom_s) {
+    unsigned int      nfft;
+    liquid_fft_method method;
+};
+static struct FFT(_wisdom_s) * FFT(_wisdom)     = NULL;
+static unsigned int            FFT(_wisdom_len) = 0;
+
+// method names used in wisdom files
+static const char * FFT(_wisdom_names)[] = {
+    "unknown", "radix2", "mixed-radix", "rader", "rader2", "dft", "many",
+};
+#define FFT_WISDOM_NUM_NAMES (sizeof(FFT(_wisdom_names))/sizeof(char*))
+
+// find cached table (cache must be locked)
+static FFT(table) FFT(_cache_find)(liquid_fft_method _method,
+                                   unsigned int      _nfft,
+                                   int               _dir)
+{
+    FFT(table) t;
+    for (t=FFT(_cache_tables); t!=NULL; t=t->next) {
+        if (t->method == _method && t->nfft == _nfft && t->direction == _dir)
+            return t;
+    }
+    return NULL;
+}
+
+// free table memory
+static void FFT(_table_destroy)(FFT(table) _t)
+{
+    if (_t->dotprod != NULL) {
+        unsigned int i;
+        for (i=0; i<_t->n; i++)
+            DOTPROD(_destroy)(_t->dotprod[i]);
+        free(_t->dotprod);
+    }
+    free(_t->twiddle);
+    free(_t->index);
+    free(_t);
+}
+
+// get table for plan's size, direction and method
+//  _q      :   plan being created (method, nfft, direction set)
+//  _init   :   method-specific function to fill new table
+FFT(table) FFT(_cache_acquire)(FFT(plan)             _q,
+                               FFT(_table_init_t) *  _init)
+{
+    FFT_CACHE_LOCK();
+    FFT(table) t = FFT(_cache_find)(_q->method, _q->nfft, _q->direction);
+    if (t != NULL)
+        t->num_refs++;
+    FFT_CACHE_UNLOCK();
+    if (t != NULL)
+        return t;
+
+    // create table without holding the lock: initialization may itself
+    // create plans (e.g. Rader's sub-transforms) which use the cache
+    t = (FFT(table)) malloc(sizeof(struct FFT(table_s)));
+    t->method    = _q->method;
+    t->nfft      = _q->nfft;
+    t->direction = _q->direction;
+    t->num_refs  = 1;
+    t->next      = NULL;
+    t->n         = 0;
+    t->twiddle   = NULL;
+    t->index     = NULL;
+    t->dotprod   = NULL;
+    _init(_q, t);
+
+    // add to cache unless another thread got there first
+    FFT_CACHE_LOCK();
+    FFT(table) t_cached = FFT(_cache_find)(t->method, t->nfft, t->direction);
+    if (t_cached == NULL) {
+        t->next = FFT(_cache_tables);
+        FFT(_cache_tables) = t;
+    } else {
+        t_cached->num_refs++;
+    }
+    FFT_CACHE_UNLOCK();
+
+    if (t_cached != NULL) {
+        FFT(_table_destroy)(t);
+        return t_cached;
+    }
+    return t;
+}
+
+// release table obtained with FFT(_cache_acquire)
+void FFT(_cache_release)(FFT(table) _t)
+{
+    FFT_CACHE_LOCK();
+    if (_t->num_refs == 0)
+        fprintf(stderr,"warning: fft_cache_release(), table released too many times\n");
+    else
+        _t->num_refs--;
+    FFT_CACHE_UNLOCK();
+}
+
+// free cached tables no longer used by any plan
+void FFT(_cache_purge)(void)
+{
+    FFT_CACHE_LOCK();
+    FFT(table) * p = &FFT(_cache_tables);
+    while (*p != NULL) {
+        FFT(table) t = *p;
+        if (t->num_refs == 0) {
+            *p = t->next;
+            FFT(_table_destroy)(t);
+        } else {
+            p = &t->next;
+        }
+    }
+    FFT_CACHE_UNLOCK();
+}
+
+// look up wisdom (cache must be locked)
+static liquid_fft_method FFT(_wisdom_find)(unsigned int _nfft)
+{
+    unsigned int i;
+    for (i=0; i<FFT(_wisdom_len); i++) {
+        if (FFT(_wisdom)[i].nfft == _nfft)
+            return FFT(_wisdom)[i].method;
+    }
+    return LIQUID_FFT_METHOD_UNKNOWN;
+}
+
+// add or replace wisdom (cache must be locked)
+static void FFT(_wisdom_set)(unsigned int      _nfft,
+                             liquid_fft_method _method)
+{
+    unsigned int i;
+    for (i=0; i<FFT(_wisdom_len); i++) {
+        if (FFT(_wisdom)[i].nfft == _nfft) {
+            FFT(_wisdom)[i].method = _method;
+            return;
+        }
+    }
+    FFT(_wisdom) = (struct FFT(_wisdom_s)*) realloc(FFT(_wisdom),
+                        (FFT(_wisdom_len)+1)*sizeof(struct FFT(_wisdom_s)));
+    FFT(_wisdom)[FFT(_wisdom_len)].nfft   = _nfft;
+    FFT(_wisdom)[FFT(_wisdom_len)].method = _method;
+    FFT(_wisdom_len)++;
+}
+
+// can transform size be computed with method?
+static int FFT(_method_valid)(unsigned int      _nfft,
+                              liquid_fft_method _method)
+{
+    switch (_method) {
+    case LIQUID_FFT_METHOD_DFT:         return 1;
+    case LIQUID_FFT_METHOD_RADIX2:      return fft_is_radix2(_nfft);
+    case LIQUID_FFT_METHOD_MIXED_RADIX:
+        // both factors must be smaller than the transform itself
+        if (_nfft < 4 || liquid_is_prime(_nfft))
+            return 0;
+        unsigned int Q = FFT(_estimate_mixed_radix)(_nfft);
+        return Q > 1 && Q < _nfft;
+    case LIQUID_FFT_METHOD_RADER:       return _nfft > 3 &&  liquid_is_prime(_nfft);
+    case LIQUID_FFT_METHOD_RADER2:      return _nfft > 3 &&  liquid_is_prime(_nfft);
+    default:;
+    }
+    return 0;
+}
+
+// measure execution time of method for transform size [seconds]
+static double FFT(_measure)(unsigned int      _nfft,
+                            liquid_fft_method _method,
+                            int               _flags)
+{
+    TC * x = (TC*) malloc(_nfft*sizeof(TC));
+    TC * y = (TC*) malloc(_nfft*sizeof(TC));
+    unsigned int i;
+    for (i=0; i<_nfft; i++)
+        x[i] = (i % 3) == 0 ? 1.0f : -0.5f*_Complex_I;
+
+    FFT(plan) q = NULL;
+    switch (_method) {
+    case LIQUID_FFT_METHOD_RADIX2:      q = FFT(_create_plan_radix2)     (_nfft,x,y,LIQUID_FFT_FORWARD,_flags); break;
+    case LIQUID_FFT_METHOD_MIXED_RADIX: q = FFT(_create_plan_mixed_radix)(_nfft,x,y,LIQUID_FFT_FORWARD,_flags); break;
+    case LIQUID_FFT_METHOD_RADER:       q = FFT(_create_plan_rader)      (_nfft,x,y,LIQUID_FFT_FORWARD,_flags); break;
+    case LIQUID_FFT_METHOD_RADER2:      q = FFT(_create_plan_rader2)     (_nfft,x,y,LIQUID_FFT_FORWARD,_flags); break;
+    case LIQUID_FFT_METHOD_DFT:         q = FFT(_create_plan_dft)        (_nfft,x,y,LIQUID_FFT_FORWARD,_flags); break;
+    default:
+        fprintf(stderr,"error: fft_measure(), invalid method\n");
+        exit(1);
+    }
+
+    // double number of trials until minimum measurement time is reached
+    double dt = 0.0;
+    unsigned long int n, num_trials = 1;
+    while (1) {
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (n=0; n<num_trials; n++)
+            FFT(_execute)(q);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        dt = (double)(t1.tv_sec - t0.tv_sec) + 1e-9*(double)(t1.tv_nsec - t0.tv_nsec);
+        if (dt >= FFT_WISDOM_MEASURE_TIME)
+            break;
+        num_trials *= 2;
+    }
+
+    FFT(_destroy_plan)(q);
+    free(x);
+    free(y);
+    return dt / (double)num_trials;
+}
+
+// select method for transform size
+//  _nfft   :   transform size
+//  _flags  :   fft flags (LIQUID_FFT_MEASURE)
+liquid_fft_method FFT(_cache_method)(unsigned int _nfft,
+                                     int          _flags)
+{
+    FFT_CACHE_LOCK();
+    liquid_fft_method method = FFT(_wisdom_find)(_nfft);
+    FFT_CACHE_UNLOCK();
+    if (FFT(_method_valid)(_nfft, method))
+        return method;
+
+    // small transforms use codelets: nothing to measure
+    method = liquid_fft_estimate_method(_nfft);
+    if ( !(_flags & LIQUID_FFT_MEASURE) || _nfft <= 8)
+        return method;
+
+    // candidate methods for this size
+    liquid_fft_method candidates[5];
+    unsigned int num_candidates = 0;
+    liquid_fft_method k;
+    for (k=LIQUID_FFT_METHOD_RADIX2; k<=LIQUID_FFT_METHOD_DFT; k++) {
+        if (k == LIQUID_FFT_METHOD_DFT && _nfft > FFT_WISDOM_DFT_MAXLEN)
+            continue;
+        if (FFT(_method_valid)(_nfft, k))
+            candidates[num_candidates++] = k;
+    }
+
+    // time each candidate; sub-transforms are measured recursively
+    double dt_min = 0.0;
+    unsigned int i;
+    for (i=0; i<num_candidates; i++) {
+        double dt = FFT(_measure)(_nfft, candidates[i], _flags);
+        if (i == 0 || dt < dt_min) {
+            dt_min = dt;
+            method = candidates[i];
+        }
+    }
+
+    FFT_CACHE_LOCK();
+    FFT(_wisdom_set)(_nfft, method);
+    FFT_CACHE_UNLOCK();
+    return method;
+}
+
+// import wisdom from file
+//  _filename   :   input file name
+int FFT(_wisdom_import)(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"r");
+    if (fid == NULL) {
+        fprintf(stderr,"error: fft_wisdom_import(), could not open '%s' for reading\n", _filename);
+        return -1;
+    }
+
+    // parse all entries before adding any of them
+    struct FFT(_wisdom_s) * w = NULL;
+    unsigned int num_entries = 0;
+    unsigned int line = 0;
+    int rc = 0;
+    char buf[256];
+    while (fgets(buf, sizeof(buf), fid) != NULL) {
+        line++;
+
+        // skip comments and blank lines
+        char * s = buf + strspn(buf, " \t");
+        if (*s == '#' || *s == '\n' || *s == '\r' || *s == '\0')
+            continue;
+
+        unsigned int nfft = 0;
+        char name[32];
+        liquid_fft_method method = LIQUID_FFT_METHOD_UNKNOWN;
+        if (sscanf(s, "%u %31s", &nfft, name) == 2) {
+            unsigned int k;
+            for (k=1; k<FFT_WISDOM_NUM_NAMES; k++) {
+                if (strcmp(name, FFT(_wisdom_names)[k]) == 0)
+                    method = (liquid_fft_method) k;
+            }
+        }
+        if (nfft == 0 || method == LIQUID_FFT_METHOD_UNKNOWN || method == LIQUID_FFT_METHOD_MANY) {
+            fprintf(stderr,"error: fft_wisdom_import(), '%s' line %u: invalid entry\n", _filename, line);
+            rc = -1;
+            break;
+        }
+        w = (struct FFT(_wisdom_s)*) realloc(w, (num_entries+1)*sizeof(struct FFT(_wisdom_s)));
+        w[num_entries].nfft   = nfft;
+        w[num_entries].method = method;
+        num_entries++;
+    }
+    fclose(fid);
+
+    if (rc == 0) {
+        FFT_CACHE_LOCK();
+        unsigned int i;
+        for (i=0; i<num_entries; i++)
+            FFT(_wisdom_set)(w[i].nfft, w[i].method);
+        FFT_CACHE_UNLOCK();
+    }
+    free(w);
+    return rc;
+}
+
+// export wisdom to file
+//  _filename   :   output file name
+int FFT(_wisdom_export)(const char * _filename)
+{
+    FILE * fid = fopen(_filename,"w");
+    if (fid == NULL) {
+        fprintf(stderr,"error: fft_wisdom_export(), could not open '%s' for writing\n", _filename);
+        return -1;
+    }
+    fprintf(fid,"# liquid-dsp fft wisdom: <size> <method>\n");
+
+    FFT_CACHE_LOCK();
+    unsigned int i;
+    for (i=0; i<FFT(_wisdom_len); i++)
+        fprintf(fid,"%u %s\n", FFT(_wisdom)[i].nfft, FFT(_wisdom_names)[FFT(_wisdom)[i].method]);
+    FFT_CACHE_UNLOCK();
+
+    fclose(fid);
+    return 0;
+}
+
+// forget all wisdom
+void FFT(_wisdom_forget)(void)
+{
+    FFT_CACHE_LOCK();
+    free(FFT(_wisdom));
+    FFT(_wisdom)     = NULL;
+    FFT(_wisdom_len) = 0;
+    FFT_CACHE_UNLOCK();
+}
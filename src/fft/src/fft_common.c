@@ -28,6 +28,26 @@
 #include <stdlib.h>
 #include "liquid.internal.h"
 
+// read-only tables (twiddle factors, index sequences) of a transform
+// size, direction, and method; shared by all plans through the cache
+struct FFT(table_s)
+{
+    // cache key
+    liquid_fft_method method;   // transform method
+    unsigned int nfft;          // fft size
+    int direction;              // forward/reverse
+
+    // cache bookkeeping
+    unsigned int num_refs;      // number of plans using this table
+    FFT(table) next;            // next table in cache
+
+    // method-specific data
+    unsigned int n;             // table size (method specific)
+    TC * twiddle;               // twiddle factors
+    unsigned int * index;       // index sequence
+    DOTPROD() * dotprod;        // dot product objects [size: n x 1]
+};
+
 struct FFT(plan_s)
 {
     // common data
@@ -52,13 +72,17 @@ struct FFT(plan_s)
         struct {
             TC * twiddle;               // twiddle factors
             DOTPROD() * dotprod;        // inner dot products
+            FFT(table) table;           // shared tables
+            TC * x;                     // input copy (in-place only)
         } dft;
 
         // radix-2 transform data
         struct {
             unsigned int m;             // log2(nfft)
             unsigned int * index_rev;   // reversed indices
-            TC * twiddle;               // twiddle factors
+            TC * twiddle;               // twiddle factors (per radix-4 pass)
+            FFT(_pass_t) * pass;        // radix-4 butterfly pass kernel
+            FFT(table) table;           // shared tables
         } radix2;
 
         // recursive mixed-radix transform data:
@@ -69,12 +93,13 @@ struct FFT(plan_s)
         struct {
             unsigned int P;     // first FFT size
             unsigned int Q;     // second FFT size
-            TC * x;             // input buffer (copied)
+            TC * x;             // intermediate buffer
             TC * t0;            // temporary buffer (small FFT input)
             TC * t1;            // temporary buffer (small FFT output)
             TC * twiddle;       // twiddle factors
             FFT(plan) fft_P;    // sub-transform of size P
             FFT(plan) fft_Q;    // sub-transform of size Q
+            FFT(table) table;   // shared tables
         } mixedradix;
 
         // Rader's algorithm for computing FFTs of prime length
@@ -85,6 +110,7 @@ struct FFT(plan_s)
             TC * X_prime;       // sub-transform freq-domain buffer
             FFT(plan) fft;      // sub-FFT of size nfft-1
             FFT(plan) ifft;     // sub-IFFT of size nfft-1
+            FFT(table) table;   // shared tables
         } rader;
 
         // Rader's alternate algorithm for computing FFTs of prime length
@@ -96,7 +122,34 @@ struct FFT(plan_s)
             TC * X_prime;       // sub-transform freq-domain buffer
             FFT(plan) fft;      // sub-FFT of size nfft_prime
             FFT(plan) ifft;     // sub-IFFT of size nfft_prime
+            FFT(table) table;   // shared tables
         } rader2;
+
+        // batch of same-size transforms
+        struct {
+            unsigned int howmany;       // number of transforms
+            unsigned int istride;       // input sample stride
+            unsigned int idist;         // input distance between transforms
+            unsigned int ostride;       // output sample stride
+            unsigned int odist;         // output distance between transforms
+            unsigned int * index_rev;   // reversed indices (lanes only)
+            T * twiddle;                // twiddle factors (lanes only)
+            T * buf;                    // lane buffer (lanes only)
+            FFT(_many_butterflies_t) * butterflies; // lane kernel
+            FFT(_many_gather_t)      * gather;      // transposing gather
+            FFT(_many_scatter_t)     * scatter;     // transposing scatter
+            TC * t0;                    // sub-transform input buffer
+            TC * t1;                    // sub-transform output buffer
+            FFT(plan) fft;              // sub-transform (NULL if lanes)
+        } many;
+
+        // real-to-complex/complex-to-real transforms
+        struct {
+            TC * z;             // packed time-domain buffer
+            TC * Z;             // packed freq-domain buffer
+            TC * twiddle;       // twiddle factors (even lengths only)
+            FFT(plan) fft;      // half-length (full if odd) transform
+        } r2c;
     } data;
 };
 
@@ -112,9 +165,9 @@ FFT(plan) FFT(_create_plan)(unsigned int _nfft,
                             int          _dir,
                             int          _flags)
 {
-    // determine best method for execution
-    // TODO : check flags and allow user override
-    liquid_fft_method method = liquid_fft_estimate_method(_nfft);
+    // determine best method for execution: recorded wisdom, measured
+    // (LIQUID_FFT_MEASURE), or estimated from the transform size
+    liquid_fft_method method = FFT(_cache_method)(_nfft, _flags);
 
     // initialize fft based on method
     switch (method) {
@@ -160,6 +213,7 @@ void FFT(_destroy_plan)(FFT(plan) _q)
         case LIQUID_FFT_METHOD_MIXED_RADIX: FFT(_destroy_plan_mixed_radix)(_q); return;
         case LIQUID_FFT_METHOD_RADER:       FFT(_destroy_plan_rader)(_q);       return;
         case LIQUID_FFT_METHOD_RADER2:      FFT(_destroy_plan_rader2)(_q);      return;
+        case LIQUID_FFT_METHOD_MANY:        FFT(_destroy_plan_many)(_q);        return;
         case LIQUID_FFT_METHOD_UNKNOWN:
         default:
             fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft method\n");
@@ -183,6 +237,12 @@ void FFT(_destroy_plan)(FFT(plan) _q)
     case LIQUID_FFT_MDCT:   break;
     case LIQUID_FFT_IMDCT:  break;
 
+    // real-input transforms
+    case LIQUID_FFT_R2C:
+    case LIQUID_FFT_C2R:
+        FFT(_destroy_plan_r2c)(_q);
+        break;
+
     case LIQUID_FFT_UNKNOWN:
     default:
         fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft type\n");
@@ -206,6 +266,7 @@ void FFT(_print_plan)(FFT(plan) _q)
         case LIQUID_FFT_METHOD_MIXED_RADIX: printf("Cooley-Tukey\n");       break;
         case LIQUID_FFT_METHOD_RADER:       printf("Rader (Type I)\n");     break;
         case LIQUID_FFT_METHOD_RADER2:      printf("Rader (Type II)\n");    break;
+        case LIQUID_FFT_METHOD_MANY:        printf("Batch\n");              break;
         case LIQUID_FFT_METHOD_UNKNOWN:
         default:
             fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft method\n");
@@ -231,6 +292,16 @@ void FFT(_print_plan)(FFT(plan) _q)
     case LIQUID_FFT_MDCT:   break;
     case LIQUID_FFT_IMDCT:  break;
 
+    // real-input transforms
+    case LIQUID_FFT_R2C:
+    case LIQUID_FFT_C2R:
+        printf("fft plan [%s], n=%u, ",
+                _q->type == LIQUID_FFT_R2C ? "real-to-complex" : "complex-to-real",
+                _q->nfft);
+        printf("%s\n", _q->nfft % 2 ? "full-length complex" : "half-length complex");
+        FFT(_print_plan_recursive)(_q->data.r2c.fft, 1);
+        break;
+
     case LIQUID_FFT_UNKNOWN:
     default:
         fprintf(stderr,"error: fft_print_plan(), unknown/invalid fft type\n");
@@ -276,6 +347,16 @@ void FFT(_print_plan_recursive)(FFT(plan)    _q,
         FFT(_print_plan_recursive)(_q->data.rader2.fft, _level+1);
         break;
 
+    case LIQUID_FFT_METHOD_MANY:
+        printf("batch of %u transforms", _q->data.many.howmany);
+        if (_q->data.many.fft == NULL) {
+            printf(", %u lanes\n", LIQUID_FFT_MANY_LANES);
+        } else {
+            printf("\n");
+            FFT(_print_plan_recursive)(_q->data.many.fft, _level+1);
+        }
+        break;
+
     case LIQUID_FFT_METHOD_UNKNOWN:     printf("(unknown)\n");      break;
     default:                            printf("(unknown)\n");      break;
     }
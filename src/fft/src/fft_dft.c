@@ -26,6 +26,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "liquid.internal.h"
 
@@ -54,6 +55,8 @@ FFT(plan) FFT(_create_plan_dft)(unsigned int _nfft,
         
     q->data.dft.twiddle = NULL;
     q->data.dft.dotprod = NULL;
+    q->data.dft.table   = NULL;
+    q->data.dft.x       = NULL;
 
     // check size, use specific codelet for small DFTs
     if      (q->nfft == 2) q->execute = FFT(_execute_dft_2);
@@ -67,54 +70,60 @@ FFT(plan) FFT(_create_plan_dft)(unsigned int _nfft,
     else {
         q->execute = FFT(_execute_dft);
 
-        // initialize twiddle factors
-        q->data.dft.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
+        // get twiddle factors, dotprod objects from cache
+        q->data.dft.table   = FFT(_cache_acquire)(q, FFT(_table_init_dft));
+        q->data.dft.twiddle = q->data.dft.table->twiddle;
+        q->data.dft.dotprod = q->data.dft.table->dotprod;
 
-        // create dotprod objects
-        q->data.dft.dotprod = (DOTPROD()*) malloc(q->nfft * sizeof(DOTPROD()));
-        
-        // create dotprod objects
-        // twiddles: exp(-j*2*pi*W/n), W=
-        //  0   0   0   0   0...
-        //  0   1   2   3   4...
-        //  0   2   4   6   8...
-        //  0   3   6   9   12...
-        //  ...
-        // Note that first row/column is zero, no multiplication necessary.
-        // Create dotprod for first row anyway because it's still faster...
-        unsigned int i;
-        unsigned int k;
-        T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-        for (i=0; i<q->nfft; i++) {
-            // initialize twiddle factors
-            // NOTE: no need to compute first twiddle because exp(-j*2*pi*0) = 1
-            for (k=1; k<q->nfft; k++)
-                q->data.dft.twiddle[k-1] = cexpf(_Complex_I*d*2*M_PI*(T)(k*i) / (T)(q->nfft));
-
-            // create dotprod object
-            q->data.dft.dotprod[i] = DOTPROD(_create)(q->data.dft.twiddle, q->nfft-1);
-        }
+        // in-place transforms need a copy of the input
+        if (_x == _y)
+            q->data.dft.x = (TC *) malloc(q->nfft * sizeof(TC));
     }
 
     return q;
 }
 
+// initialize table of dotprod objects for plan
+void FFT(_table_init_dft)(FFT(plan)  _q,
+                          FFT(table) _t)
+{
+    // initialize twiddle factors
+    _t->twiddle = (TC *) malloc(_q->nfft * sizeof(TC));
+
+    // create dotprod objects
+    _t->n       = _q->nfft;
+    _t->dotprod = (DOTPROD()*) malloc(_q->nfft * sizeof(DOTPROD()));
+
+    // create dotprod objects
+    // twiddles: exp(-j*2*pi*W/n), W=
+    //  0   0   0   0   0...
+    //  0   1   2   3   4...
+    //  0   2   4   6   8...
+    //  0   3   6   9   12...
+    //  ...
+    // Note that first row/column is zero, no multiplication necessary.
+    // Create dotprod for first row anyway because it's still faster...
+    unsigned int i;
+    unsigned int k;
+    T d = (_q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    for (i=0; i<_q->nfft; i++) {
+        // initialize twiddle factors
+        // NOTE: no need to compute first twiddle because exp(-j*2*pi*0) = 1
+        for (k=1; k<_q->nfft; k++)
+            _t->twiddle[k-1] = cexpf(_Complex_I*d*2*M_PI*(T)(k*i) / (T)(_q->nfft));
+
+        // create dotprod object
+        _t->dotprod[i] = DOTPROD(_create)(_t->twiddle, _q->nfft-1);
+    }
+}
+
 // destroy FFT plan
 void FFT(_destroy_plan_dft)(FFT(plan) _q)
 {
-    // free twiddle factors
-    if (_q->data.dft.twiddle != NULL)
-        free(_q->data.dft.twiddle);
-
-    // free dotprod objects
-    if (_q->data.dft.dotprod != NULL) {
-        unsigned int i;
-        for (i=0; i<_q->nfft; i++)
-            DOTPROD(_destroy)(_q->data.dft.dotprod[i]);
-
-        // free dotprod array
-        free(_q->data.dft.dotprod);
-    }
+    // release twiddle factors, dotprod objects
+    if (_q->data.dft.table != NULL)
+        FFT(_cache_release)(_q->data.dft.table);
+    free(_q->data.dft.x);
 
     // free main object memory
     free(_q);
@@ -141,11 +150,18 @@ void FFT(_execute_dft)(FFT(plan) _q)
         }
     }
 #else
+    // copy input for in-place transforms
+    TC * x = _q->x;
+    if (_q->data.dft.x != NULL) {
+        memmove(_q->data.dft.x, _q->x, nfft*sizeof(TC));
+        x = _q->data.dft.x;
+    }
+
     // use vector dot products
     // NOTE: no need to compute first multiplication because exp(-j*2*pi*0) = 1
     for (i=0; i<nfft; i++) {
-        DOTPROD(_execute)(_q->data.dft.dotprod[i], &_q->x[1], &_q->y[i]);
-        _q->y[i] += _q->x[0];
+        DOTPROD(_execute)(_q->data.dft.dotprod[i], &x[1], &_q->y[i]);
+        _q->y[i] += x[0];
     }
 #endif
 }
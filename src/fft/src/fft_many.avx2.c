@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_many.avx2.c : butterflies for batched transforms (AVX2/FMA)
+//
+// This file is compiled with -mavx2 -mfma regardless of the build host;
+// the kernel is only selected when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX, AVX2, FMA
+
+#if LIQUID_FFT_MANY_LANES != 8
+#  error "fft_many.avx2.c assumes one transform per single-precision lane of a 256-bit register"
+#endif
+
+// complex multiply of eight lanes by a broadcast twiddle factor
+#define FFT_MANY_CMUL_AVX2(YR,YI,VR,VI,WR,WI)                 \
+{                                                             \
+    YR = _mm256_fmsub_ps(VR, WR, _mm256_mul_ps(VI, WI));      \
+    YI = _mm256_fmadd_ps(VR, WI, _mm256_mul_ps(VI, WR));      \
+}
+
+// decimation-in-time butterflies across lanes (AVX2/FMA), all eight
+// lanes in one register; see fft_many_butterflies() for a description
+// of the method and arguments
+void fft_many_butterflies_avx2(float *      _re,
+                               float *      _im,
+                               unsigned int _n,
+                               float *      _w,
+                               int          _dir)
+{
+    __m256 s = _mm256_set1_ps((_dir == LIQUID_FFT_FORWARD) ? 1.0f : -1.0f);
+    float * wr = _w;
+    float * wi = _w + _n;
+    unsigned int h, j, k;
+
+    // first stage: radix-2 if log2(n) is odd, radix-4 otherwise
+    if (liquid_msb_index(_n) % 2 == 0) {
+        for (k=0; k<8*_n; k+=16) {
+            __m256 ar = _mm256_loadu_ps(&_re[k]);
+            __m256 ai = _mm256_loadu_ps(&_im[k]);
+            __m256 br = _mm256_loadu_ps(&_re[k+8]);
+            __m256 bi = _mm256_loadu_ps(&_im[k+8]);
+            _mm256_storeu_ps(&_re[k],   _mm256_add_ps(ar, br));
+            _mm256_storeu_ps(&_im[k],   _mm256_add_ps(ai, bi));
+            _mm256_storeu_ps(&_re[k+8], _mm256_sub_ps(ar, br));
+            _mm256_storeu_ps(&_im[k+8], _mm256_sub_ps(ai, bi));
+        }
+        h = 2;
+    } else {
+        for (k=0; k<8*_n; k+=32) {
+            __m256 y0r = _mm256_loadu_ps(&_re[k]),    y0i = _mm256_loadu_ps(&_im[k]);
+            __m256 y1r = _mm256_loadu_ps(&_re[k+8]),  y1i = _mm256_loadu_ps(&_im[k+8]);
+            __m256 y2r = _mm256_loadu_ps(&_re[k+16]), y2i = _mm256_loadu_ps(&_im[k+16]);
+            __m256 y3r = _mm256_loadu_ps(&_re[k+24]), y3i = _mm256_loadu_ps(&_im[k+24]);
+            __m256 t0r = _mm256_add_ps(y0r, y1r), t0i = _mm256_add_ps(y0i, y1i);
+            __m256 t1r = _mm256_sub_ps(y0r, y1r), t1i = _mm256_sub_ps(y0i, y1i);
+            __m256 t2r = _mm256_add_ps(y2r, y3r), t2i = _mm256_add_ps(y2i, y3i);
+            __m256 t3r = _mm256_mul_ps(s, _mm256_sub_ps(y2i, y3i));
+            __m256 t3i = _mm256_mul_ps(s, _mm256_sub_ps(y3r, y2r));
+            _mm256_storeu_ps(&_re[k],    _mm256_add_ps(t0r, t2r));
+            _mm256_storeu_ps(&_im[k],    _mm256_add_ps(t0i, t2i));
+            _mm256_storeu_ps(&_re[k+8],  _mm256_add_ps(t1r, t3r));
+            _mm256_storeu_ps(&_im[k+8],  _mm256_add_ps(t1i, t3i));
+            _mm256_storeu_ps(&_re[k+16], _mm256_sub_ps(t0r, t2r));
+            _mm256_storeu_ps(&_im[k+16], _mm256_sub_ps(t0i, t2i));
+            _mm256_storeu_ps(&_re[k+24], _mm256_sub_ps(t1r, t3r));
+            _mm256_storeu_ps(&_im[k+24], _mm256_sub_ps(t1i, t3i));
+        }
+        h = 4;
+    }
+
+    // radix-4 passes
+    for ( ; 4*h <= _n; h *= 4) {
+        for (j=0; j<h; j++) {
+            __m256 w1r = _mm256_set1_ps(wr[j]),     w1i = _mm256_set1_ps(wi[j]);
+            __m256 w2r = _mm256_set1_ps(wr[h+j]),   w2i = _mm256_set1_ps(wi[h+j]);
+            __m256 w3r = _mm256_set1_ps(wr[2*h+j]), w3i = _mm256_set1_ps(wi[2*h+j]);
+            for (k=8*j; k<8*_n; k+=32*h) {
+                float * p0r = &_re[k],       * p0i = &_im[k];
+                float * p1r = &_re[k+8*h],   * p1i = &_im[k+8*h];
+                float * p2r = &_re[k+16*h],  * p2i = &_im[k+16*h];
+                float * p3r = &_re[k+24*h],  * p3i = &_im[k+24*h];
+
+                __m256 ar = _mm256_loadu_ps(p0r), ai = _mm256_loadu_ps(p0i);
+                __m256 br, bi, cr, ci, dr, di;
+                FFT_MANY_CMUL_AVX2(br, bi, _mm256_loadu_ps(p2r), _mm256_loadu_ps(p2i), w1r, w1i);
+                FFT_MANY_CMUL_AVX2(cr, ci, _mm256_loadu_ps(p1r), _mm256_loadu_ps(p1i), w2r, w2i);
+                FFT_MANY_CMUL_AVX2(dr, di, _mm256_loadu_ps(p3r), _mm256_loadu_ps(p3i), w3r, w3i);
+
+                __m256 t0r = _mm256_add_ps(ar, cr), t0i = _mm256_add_ps(ai, ci);
+                __m256 t1r = _mm256_sub_ps(ar, cr), t1i = _mm256_sub_ps(ai, ci);
+                __m256 t2r = _mm256_add_ps(br, dr), t2i = _mm256_add_ps(bi, di);
+                __m256 t3r = _mm256_mul_ps(s, _mm256_sub_ps(bi, di));
+                __m256 t3i = _mm256_mul_ps(s, _mm256_sub_ps(dr, br));
+                _mm256_storeu_ps(p0r, _mm256_add_ps(t0r, t2r));
+                _mm256_storeu_ps(p0i, _mm256_add_ps(t0i, t2i));
+                _mm256_storeu_ps(p1r, _mm256_add_ps(t1r, t3r));
+                _mm256_storeu_ps(p1i, _mm256_add_ps(t1i, t3i));
+                _mm256_storeu_ps(p2r, _mm256_sub_ps(t0r, t2r));
+                _mm256_storeu_ps(p2i, _mm256_sub_ps(t0i, t2i));
+                _mm256_storeu_ps(p3r, _mm256_sub_ps(t1r, t3r));
+                _mm256_storeu_ps(p3i, _mm256_sub_ps(t1i, t3i));
+            }
+        }
+        wr += 3*h;
+        wi += 3*h;
+    }
+}
+
+// transpose 8 x 8 matrix of single-precision values held in registers
+static inline void fft_many_transpose8_avx2(__m256 * _r)
+{
+    __m256 t0 = _mm256_unpacklo_ps(_r[0], _r[1]);
+    __m256 t1 = _mm256_unpackhi_ps(_r[0], _r[1]);
+    __m256 t2 = _mm256_unpacklo_ps(_r[2], _r[3]);
+    __m256 t3 = _mm256_unpackhi_ps(_r[2], _r[3]);
+    __m256 t4 = _mm256_unpacklo_ps(_r[4], _r[5]);
+    __m256 t5 = _mm256_unpackhi_ps(_r[4], _r[5]);
+    __m256 t6 = _mm256_unpacklo_ps(_r[6], _r[7]);
+    __m256 t7 = _mm256_unpackhi_ps(_r[6], _r[7]);
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1,0,1,0));
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3,2,3,2));
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1,0,1,0));
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3,2,3,2));
+    _r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+    _r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+    _r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+    _r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+    _r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+    _r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+    _r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+    _r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+// gather a full group of contiguous transforms into the lane buffer in
+// bit-reversed order (AVX2), transposing four samples of all eight lanes
+// at a time; see fft_many_gather_sse() for a description of arguments
+void fft_many_gather_avx2(float complex * _x,
+                          unsigned int    _idist,
+                          unsigned int    _n,
+                          unsigned int *  _rev,
+                          float *         _re,
+                          float *         _im)
+{
+    __m256 r[8];
+    unsigned int j, k, l;
+    for (k=0; k<_n; k+=4) {
+        for (l=0; l<8; l++)
+            r[l] = _mm256_loadu_ps((float*)(_x + l*_idist + k));
+        fft_many_transpose8_avx2(r);
+        for (j=0; j<4; j++) {
+            _mm256_storeu_ps(&_re[8*_rev[k+j]], r[2*j  ]);
+            _mm256_storeu_ps(&_im[8*_rev[k+j]], r[2*j+1]);
+        }
+    }
+}
+
+// scatter the lane buffer to a full group of contiguous transforms
+// (AVX2); see fft_many_scatter_sse() for a description of arguments
+void fft_many_scatter_avx2(float *         _re,
+                           float *         _im,
+                           unsigned int    _n,
+                           float complex * _y,
+                           unsigned int    _odist)
+{
+    __m256 r[8];
+    unsigned int j, k, l;
+    for (k=0; k<_n; k+=4) {
+        for (j=0; j<4; j++) {
+            r[2*j  ] = _mm256_loadu_ps(&_re[8*(k+j)]);
+            r[2*j+1] = _mm256_loadu_ps(&_im[8*(k+j)]);
+        }
+        fft_many_transpose8_avx2(r);
+        for (l=0; l<8; l++)
+            _mm256_storeu_ps((float*)(_y + l*_odist + k), r[l]);
+    }
+}
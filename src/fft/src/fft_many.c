@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_many.c : batched transforms (many same-size transforms per call)
+//
+// Short power-of-two transforms are computed LIQUID_FFT_MANY_LANES at a
+// time: the inputs are gathered (in bit-reversed order) into a buffer
+// with one transform per SIMD lane, split into real and imaginary
+// planes, and all lanes share every twiddle factor load. All other
+// sizes run a regular sub-plan once per transform.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>  // SSE
+#endif
+
+// longest transform computed across lanes; the lane buffer for this
+// size (2 x 8 x 256 floats, 16 KiB) leaves room in a typical 32 KiB L1
+// cache for the input and output rows being transposed
+#define FFT_MANY_MAXLEN 256
+
+// create batched FFT plan
+//  _n          :   transform size
+//  _howmany    :   number of transforms
+//  _x          :   input array
+//  _istride    :   input sample stride within each transform
+//  _idist      :   input distance between the first samples of transforms
+//  _y          :   output array
+//  _ostride    :   output sample stride within each transform
+//  _odist      :   output distance between the first samples of transforms
+//  _dir        :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags      :   fft flags
+FFT(plan) FFT(_create_plan_many)(unsigned int _n,
+                                 unsigned int _howmany,
+                                 TC *         _x,
+                                 unsigned int _istride,
+                                 unsigned int _idist,
+                                 TC *         _y,
+                                 unsigned int _ostride,
+                                 unsigned int _odist,
+                                 int          _dir,
+                                 int          _flags)
+{
+    // validate input
+    if (_n == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), transform size must be greater than zero\n");
+        exit(1);
+    } else if (_howmany == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), number of transforms must be greater than zero\n");
+        exit(1);
+    } else if (_istride == 0 || _ostride == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), strides must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _n;
+    q->x         = _x;
+    q->y         = _y;
+    q->flags     = _flags;
+    q->type      = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->direction = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_MANY;
+
+    q->execute   = FFT(_execute_many);
+
+    q->data.many.howmany   = _howmany;
+    q->data.many.istride   = _istride;
+    q->data.many.idist     = _idist;
+    q->data.many.ostride   = _ostride;
+    q->data.many.odist     = _odist;
+    q->data.many.index_rev = NULL;
+    q->data.many.twiddle   = NULL;
+    q->data.many.buf       = NULL;
+    q->data.many.t0        = NULL;
+    q->data.many.t1        = NULL;
+    q->data.many.fft       = NULL;
+
+    if (fft_is_radix2(_n) && _n >= 4 && _n <= FFT_MANY_MAXLEN) {
+        // compute transforms across lanes
+        unsigned int m = liquid_msb_index(_n) - 1;  // m = log2(n)
+        unsigned int i;
+        q->data.many.index_rev = (unsigned int *) malloc(_n*sizeof(unsigned int));
+        for (i=0; i<_n; i++)
+            q->data.many.index_rev[i] = fft_reverse_index(i,m);
+
+        // twiddle factors for each radix-4 pass, in the same order as
+        // for regular radix-2 plans: real parts in the first n entries,
+        // imaginary parts in the next n
+        q->data.many.twiddle = (T *) calloc(2*_n, sizeof(T));
+        double d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+        unsigned int h = (m % 2) ? 2 : 4;
+        unsigned int n = 0;
+        unsigned int j, r;
+        for ( ; 4*h <= _n; h *= 4) {
+            for (r=1; r<=3; r++) {
+                for (j=0; j<h; j++) {
+                    double theta = d*2*M_PI*(double)(r*j) / (double)(4*h);
+                    q->data.many.twiddle[   n] = cos(theta);
+                    q->data.many.twiddle[_n+n] = sin(theta);
+                    n++;
+                }
+            }
+        }
+
+        // lane buffer: real plane followed by imaginary plane; zeroed
+        // so that unused lanes of the last group hold finite values
+        q->data.many.buf = (T *) calloc(2*_n*LIQUID_FFT_MANY_LANES, sizeof(T));
+
+        // select kernels; gather/scatter kernels transpose full groups
+        // of contiguous (unit stride) transforms
+        q->data.many.butterflies = FFT(_many_butterflies);
+        q->data.many.gather      = NULL;
+        q->data.many.scatter     = NULL;
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+        q->data.many.butterflies = FFT(_many_butterflies_sse);
+        q->data.many.gather      = FFT(_many_gather_sse);
+        q->data.many.scatter     = FFT(_many_scatter_sse);
+#endif
+#if LIQUID_SIMD_AVX2
+        if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA)) {
+            q->data.many.butterflies = FFT(_many_butterflies_avx2);
+            q->data.many.gather      = FFT(_many_gather_avx2);
+            q->data.many.scatter     = FFT(_many_scatter_avx2);
+        }
+#endif
+    } else {
+        // run regular sub-transform on each input
+        q->data.many.t0  = (TC *) malloc(_n*sizeof(TC));
+        q->data.many.t1  = (TC *) malloc(_n*sizeof(TC));
+        q->data.many.fft = FFT(_create_plan)(_n, q->data.many.t0, q->data.many.t1, _dir, _flags);
+    }
+
+    return q;
+}
+
+// destroy batched FFT plan
+void FFT(_destroy_plan_many)(FFT(plan) _q)
+{
+    // free data specific to batched transforms
+    free(_q->data.many.index_rev);
+    free(_q->data.many.twiddle);
+    free(_q->data.many.buf);
+    free(_q->data.many.t0);
+    free(_q->data.many.t1);
+    if (_q->data.many.fft != NULL)
+        FFT(_destroy_plan)(_q->data.many.fft);
+
+    // free main object memory
+    free(_q);
+}
+
+// execute batched FFT
+void FFT(_execute_many)(FFT(plan) _q)
+{
+    unsigned int n       = _q->nfft;
+    unsigned int howmany = _q->data.many.howmany;
+    unsigned int istride = _q->data.many.istride;
+    unsigned int idist   = _q->data.many.idist;
+    unsigned int ostride = _q->data.many.ostride;
+    unsigned int odist   = _q->data.many.odist;
+    unsigned int b, k, l;
+
+    if (_q->data.many.fft != NULL) {
+        FFT(plan) p = _q->data.many.fft;
+        for (b=0; b<howmany; b++) {
+            TC * x = _q->x + b*idist;
+            TC * y = _q->y + b*odist;
+            if (istride == 1 && ostride == 1 && x != y) {
+                // contiguous: run sub-transform directly on user arrays
+                p->x = x;
+                p->y = y;
+                FFT(_execute)(p);
+                continue;
+            }
+            for (k=0; k<n; k++)
+                _q->data.many.t0[k] = x[k*istride];
+            p->x = _q->data.many.t0;
+            p->y = _q->data.many.t1;
+            FFT(_execute)(p);
+            for (k=0; k<n; k++)
+                y[k*ostride] = _q->data.many.t1[k];
+        }
+        return;
+    }
+
+    unsigned int * rev = _q->data.many.index_rev;
+    T * re = _q->data.many.buf;
+    T * im = _q->data.many.buf + n*LIQUID_FFT_MANY_LANES;
+    for (b=0; b<howmany; b+=LIQUID_FFT_MANY_LANES) {
+        unsigned int lanes = howmany - b < LIQUID_FFT_MANY_LANES ?
+                             howmany - b : LIQUID_FFT_MANY_LANES;
+        int full = (lanes == LIQUID_FFT_MANY_LANES);
+
+        // gather inputs in bit-reversed order, one transform per lane
+        if (full && istride == 1 && _q->data.many.gather != NULL) {
+            _q->data.many.gather(_q->x + b*idist, idist, n, rev, re, im);
+        } else {
+            for (l=0; l<lanes; l++) {
+                TC * x = _q->x + (b+l)*idist;
+                for (k=0; k<n; k++) {
+                    TC v = x[rev[k]*istride];
+                    re[k*LIQUID_FFT_MANY_LANES + l] = crealf(v);
+                    im[k*LIQUID_FFT_MANY_LANES + l] = cimagf(v);
+                }
+            }
+        }
+
+        _q->data.many.butterflies(re, im, n, _q->data.many.twiddle, _q->direction);
+
+        // scatter outputs
+        if (full && ostride == 1 && _q->data.many.scatter != NULL) {
+            _q->data.many.scatter(re, im, n, _q->y + b*odist, odist);
+        } else {
+            for (l=0; l<lanes; l++) {
+                TC * y = _q->y + (b+l)*odist;
+                for (k=0; k<n; k++) {
+                    y[k*ostride] = re[k*LIQUID_FFT_MANY_LANES + l] +
+                                   _Complex_I*im[k*LIQUID_FFT_MANY_LANES + l];
+                }
+            }
+        }
+    }
+}
+
+// decimation-in-time butterflies across lanes (portable C)
+//
+// The buffer holds LIQUID_FFT_MANY_LANES independent transforms, already
+// permuted into bit-reversed order, with sample k of every lane stored
+// contiguously. The stages are computed as in FFT(_execute_radix2): one
+// radix-2 or radix-4 stage with trivial twiddle factors followed by
+// radix-4 passes (see FFT(_radix2_pass4)). Each twiddle factor is loaded
+// once per pass and applied to every lane of every block that uses it.
+//
+//  _re     :   real plane [size: _n x LIQUID_FFT_MANY_LANES]
+//  _im     :   imaginary plane [size: _n x LIQUID_FFT_MANY_LANES]
+//  _n      :   transform size
+//  _w      :   twiddle factors, real then imaginary [size: 2*_n x 1]
+//  _dir    :   transform direction
+void FFT(_many_butterflies)(T *          _re,
+                            T *          _im,
+                            unsigned int _n,
+                            T *          _w,
+                            int          _dir)
+{
+    const unsigned int L = LIQUID_FFT_MANY_LANES;
+    T s = (_dir == LIQUID_FFT_FORWARD) ? 1 : -1;
+    T * wr = _w;
+    T * wi = _w + _n;
+    unsigned int h, j, k, l;
+
+    // first stage: radix-2 if log2(n) is odd, radix-4 otherwise
+    if (liquid_msb_index(_n) % 2 == 0) {
+        for (k=0; k<_n; k+=2) {
+            T * ar = _re + k*L, * ai = _im + k*L;
+            T * br = ar + L,    * bi = ai + L;
+            for (l=0; l<L; l++) {
+                T tr = br[l], ti = bi[l];
+                br[l] = ar[l] - tr;     bi[l] = ai[l] - ti;
+                ar[l] = ar[l] + tr;     ai[l] = ai[l] + ti;
+            }
+        }
+        h = 2;
+    } else {
+        for (k=0; k<_n; k+=4) {
+            T * y0r = _re + k*L, * y0i = _im + k*L;
+            T * y1r = y0r +   L, * y1i = y0i +   L;
+            T * y2r = y0r + 2*L, * y2i = y0i + 2*L;
+            T * y3r = y0r + 3*L, * y3i = y0i + 3*L;
+            for (l=0; l<L; l++) {
+                T t0r = y0r[l] + y1r[l], t0i = y0i[l] + y1i[l];
+                T t1r = y0r[l] - y1r[l], t1i = y0i[l] - y1i[l];
+                T t2r = y2r[l] + y3r[l], t2i = y2i[l] + y3i[l];
+                T t3r = s*(y2i[l] - y3i[l]), t3i = -s*(y2r[l] - y3r[l]);
+                y0r[l] = t0r + t2r;     y0i[l] = t0i + t2i;
+                y1r[l] = t1r + t3r;     y1i[l] = t1i + t3i;
+                y2r[l] = t0r - t2r;     y2i[l] = t0i - t2i;
+                y3r[l] = t1r - t3r;     y3i[l] = t1i - t3i;
+            }
+        }
+        h = 4;
+    }
+
+    // radix-4 passes
+    for ( ; 4*h <= _n; h *= 4) {
+        for (j=0; j<h; j++) {
+            T w1r = wr[j], w1i = wi[j];
+            T w2r = wr[h+j], w2i = wi[h+j];
+            T w3r = wr[2*h+j], w3i = wi[2*h+j];
+            for (k=j; k<_n; k+=4*h) {
+                T * y0r = _re + k*L,       * y0i = _im + k*L;
+                T * y1r = _re + (k+h)*L,   * y1i = _im + (k+h)*L;
+                T * y2r = _re + (k+2*h)*L, * y2i = _im + (k+2*h)*L;
+                T * y3r = _re + (k+3*h)*L, * y3i = _im + (k+3*h)*L;
+                for (l=0; l<L; l++) {
+                    T ar = y0r[l], ai = y0i[l];
+                    T br = y2r[l]*w1r - y2i[l]*w1i, bi = y2r[l]*w1i + y2i[l]*w1r;
+                    T cr = y1r[l]*w2r - y1i[l]*w2i, ci = y1r[l]*w2i + y1i[l]*w2r;
+                    T dr = y3r[l]*w3r - y3i[l]*w3i, di = y3r[l]*w3i + y3i[l]*w3r;
+                    T t0r = ar + cr, t0i = ai + ci;
+                    T t1r = ar - cr, t1i = ai - ci;
+                    T t2r = br + dr, t2i = bi + di;
+                    T t3r = s*(bi - di), t3i = -s*(br - dr);
+                    y0r[l] = t0r + t2r;     y0i[l] = t0i + t2i;
+                    y1r[l] = t1r + t3r;     y1i[l] = t1i + t3i;
+                    y2r[l] = t0r - t2r;     y2i[l] = t0i - t2i;
+                    y3r[l] = t1r - t3r;     y3i[l] = t1i - t3i;
+                }
+            }
+        }
+        wr += 3*h;
+        wi += 3*h;
+    }
+}
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+// decimation-in-time butterflies across lanes (SSE), four lanes per
+// register; see FFT(_many_butterflies) for a description of arguments
+void FFT(_many_butterflies_sse)(T *          _re,
+                                T *          _im,
+                                unsigned int _n,
+                                T *          _w,
+                                int          _dir)
+{
+    const unsigned int L = LIQUID_FFT_MANY_LANES;
+    __m128 s = _mm_set1_ps((_dir == LIQUID_FFT_FORWARD) ? 1.0f : -1.0f);
+    T * wr = _w;
+    T * wi = _w + _n;
+    unsigned int h, j, k, l;
+
+    // first stage: radix-2 if log2(n) is odd, radix-4 otherwise
+    if (liquid_msb_index(_n) % 2 == 0) {
+        for (k=0; k<_n*L; k+=2*L) {
+            for (l=0; l<L; l+=4) {
+                __m128 ar = _mm_loadu_ps(&_re[k+l]);
+                __m128 ai = _mm_loadu_ps(&_im[k+l]);
+                __m128 br = _mm_loadu_ps(&_re[k+L+l]);
+                __m128 bi = _mm_loadu_ps(&_im[k+L+l]);
+                _mm_storeu_ps(&_re[k+l],   _mm_add_ps(ar, br));
+                _mm_storeu_ps(&_im[k+l],   _mm_add_ps(ai, bi));
+                _mm_storeu_ps(&_re[k+L+l], _mm_sub_ps(ar, br));
+                _mm_storeu_ps(&_im[k+L+l], _mm_sub_ps(ai, bi));
+            }
+        }
+        h = 2;
+    } else {
+        for (k=0; k<_n*L; k+=4*L) {
+            for (l=0; l<L; l+=4) {
+                __m128 y0r = _mm_loadu_ps(&_re[k+l]),     y0i = _mm_loadu_ps(&_im[k+l]);
+                __m128 y1r = _mm_loadu_ps(&_re[k+L+l]),   y1i = _mm_loadu_ps(&_im[k+L+l]);
+                __m128 y2r = _mm_loadu_ps(&_re[k+2*L+l]), y2i = _mm_loadu_ps(&_im[k+2*L+l]);
+                __m128 y3r = _mm_loadu_ps(&_re[k+3*L+l]), y3i = _mm_loadu_ps(&_im[k+3*L+l]);
+                __m128 t0r = _mm_add_ps(y0r, y1r), t0i = _mm_add_ps(y0i, y1i);
+                __m128 t1r = _mm_sub_ps(y0r, y1r), t1i = _mm_sub_ps(y0i, y1i);
+                __m128 t2r = _mm_add_ps(y2r, y3r), t2i = _mm_add_ps(y2i, y3i);
+                __m128 t3r = _mm_mul_ps(s, _mm_sub_ps(y2i, y3i));
+                __m128 t3i = _mm_mul_ps(s, _mm_sub_ps(y3r, y2r));
+                _mm_storeu_ps(&_re[k+l],     _mm_add_ps(t0r, t2r));
+                _mm_storeu_ps(&_im[k+l],     _mm_add_ps(t0i, t2i));
+                _mm_storeu_ps(&_re[k+L+l],   _mm_add_ps(t1r, t3r));
+                _mm_storeu_ps(&_im[k+L+l],   _mm_add_ps(t1i, t3i));
+                _mm_storeu_ps(&_re[k+2*L+l], _mm_sub_ps(t0r, t2r));
+                _mm_storeu_ps(&_im[k+2*L+l], _mm_sub_ps(t0i, t2i));
+                _mm_storeu_ps(&_re[k+3*L+l], _mm_sub_ps(t1r, t3r));
+                _mm_storeu_ps(&_im[k+3*L+l], _mm_sub_ps(t1i, t3i));
+            }
+        }
+        h = 4;
+    }
+
+    // radix-4 passes
+    for ( ; 4*h <= _n; h *= 4) {
+        for (j=0; j<h; j++) {
+            __m128 w1r = _mm_set1_ps(wr[j]),     w1i = _mm_set1_ps(wi[j]);
+            __m128 w2r = _mm_set1_ps(wr[h+j]),   w2i = _mm_set1_ps(wi[h+j]);
+            __m128 w3r = _mm_set1_ps(wr[2*h+j]), w3i = _mm_set1_ps(wi[2*h+j]);
+            for (k=j*L; k<_n*L; k+=4*h*L) {
+                T * p0r = &_re[k],       * p0i = &_im[k];
+                T * p1r = &_re[k+h*L],   * p1i = &_im[k+h*L];
+                T * p2r = &_re[k+2*h*L], * p2i = &_im[k+2*h*L];
+                T * p3r = &_re[k+3*h*L], * p3i = &_im[k+3*h*L];
+                for (l=0; l<L; l+=4) {
+                    __m128 ar = _mm_loadu_ps(&p0r[l]), ai = _mm_loadu_ps(&p0i[l]);
+                    __m128 vr, vi;
+                    vr = _mm_loadu_ps(&p2r[l]); vi = _mm_loadu_ps(&p2i[l]);
+                    __m128 br = _mm_sub_ps(_mm_mul_ps(vr, w1r), _mm_mul_ps(vi, w1i));
+                    __m128 bi = _mm_add_ps(_mm_mul_ps(vr, w1i), _mm_mul_ps(vi, w1r));
+                    vr = _mm_loadu_ps(&p1r[l]); vi = _mm_loadu_ps(&p1i[l]);
+                    __m128 cr = _mm_sub_ps(_mm_mul_ps(vr, w2r), _mm_mul_ps(vi, w2i));
+                    __m128 ci = _mm_add_ps(_mm_mul_ps(vr, w2i), _mm_mul_ps(vi, w2r));
+                    vr = _mm_loadu_ps(&p3r[l]); vi = _mm_loadu_ps(&p3i[l]);
+                    __m128 dr = _mm_sub_ps(_mm_mul_ps(vr, w3r), _mm_mul_ps(vi, w3i));
+                    __m128 di = _mm_add_ps(_mm_mul_ps(vr, w3i), _mm_mul_ps(vi, w3r));
+
+                    __m128 t0r = _mm_add_ps(ar, cr), t0i = _mm_add_ps(ai, ci);
+                    __m128 t1r = _mm_sub_ps(ar, cr), t1i = _mm_sub_ps(ai, ci);
+                    __m128 t2r = _mm_add_ps(br, dr), t2i = _mm_add_ps(bi, di);
+                    __m128 t3r = _mm_mul_ps(s, _mm_sub_ps(bi, di));
+                    __m128 t3i = _mm_mul_ps(s, _mm_sub_ps(dr, br));
+                    _mm_storeu_ps(&p0r[l], _mm_add_ps(t0r, t2r));
+                    _mm_storeu_ps(&p0i[l], _mm_add_ps(t0i, t2i));
+                    _mm_storeu_ps(&p1r[l], _mm_add_ps(t1r, t3r));
+                    _mm_storeu_ps(&p1i[l], _mm_add_ps(t1i, t3i));
+                    _mm_storeu_ps(&p2r[l], _mm_sub_ps(t0r, t2r));
+                    _mm_storeu_ps(&p2i[l], _mm_sub_ps(t0i, t2i));
+                    _mm_storeu_ps(&p3r[l], _mm_sub_ps(t1r, t3r));
+                    _mm_storeu_ps(&p3i[l], _mm_sub_ps(t1i, t3i));
+                }
+            }
+        }
+        wr += 3*h;
+        wi += 3*h;
+    }
+}
+
+// gather a full group of contiguous transforms into the lane buffer in
+// bit-reversed order (SSE), transposing two samples of four lanes at a
+// time
+//  _x      :   input of first transform, unit sample stride
+//  _idist  :   distance between transforms
+//  _n      :   transform size
+//  _rev    :   bit-reversed indices [size: _n x 1]
+//  _re     :   real plane [size: _n x LIQUID_FFT_MANY_LANES]
+//  _im     :   imaginary plane [size: _n x LIQUID_FFT_MANY_LANES]
+void FFT(_many_gather_sse)(TC *           _x,
+                           unsigned int   _idist,
+                           unsigned int   _n,
+                           unsigned int * _rev,
+                           T *            _re,
+                           T *            _im)
+{
+    const unsigned int L = LIQUID_FFT_MANY_LANES;
+    unsigned int k, l;
+    for (l=0; l<L; l+=4) {
+        T * x0 = (T*)(_x + (l  )*_idist);
+        T * x1 = (T*)(_x + (l+1)*_idist);
+        T * x2 = (T*)(_x + (l+2)*_idist);
+        T * x3 = (T*)(_x + (l+3)*_idist);
+        for (k=0; k<_n; k+=2) {
+            // rows: {re,im} of samples k, k+1 for each of four lanes
+            __m128 r0 = _mm_loadu_ps(&x0[2*k]);
+            __m128 r1 = _mm_loadu_ps(&x1[2*k]);
+            __m128 r2 = _mm_loadu_ps(&x2[2*k]);
+            __m128 r3 = _mm_loadu_ps(&x3[2*k]);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(&_re[_rev[k  ]*L+l], r0);
+            _mm_storeu_ps(&_im[_rev[k  ]*L+l], r1);
+            _mm_storeu_ps(&_re[_rev[k+1]*L+l], r2);
+            _mm_storeu_ps(&_im[_rev[k+1]*L+l], r3);
+        }
+    }
+}
+
+// scatter the lane buffer to a full group of contiguous transforms (SSE)
+//  _re     :   real plane [size: _n x LIQUID_FFT_MANY_LANES]
+//  _im     :   imaginary plane [size: _n x LIQUID_FFT_MANY_LANES]
+//  _n      :   transform size
+//  _y      :   output of first transform, unit sample stride
+//  _odist  :   distance between transforms
+void FFT(_many_scatter_sse)(T *          _re,
+                            T *          _im,
+                            unsigned int _n,
+                            TC *         _y,
+                            unsigned int _odist)
+{
+    const unsigned int L = LIQUID_FFT_MANY_LANES;
+    unsigned int k, l;
+    for (l=0; l<L; l+=4) {
+        T * y0 = (T*)(_y + (l  )*_odist);
+        T * y1 = (T*)(_y + (l+1)*_odist);
+        T * y2 = (T*)(_y + (l+2)*_odist);
+        T * y3 = (T*)(_y + (l+3)*_odist);
+        for (k=0; k<_n; k+=2) {
+            __m128 r0 = _mm_loadu_ps(&_re[(k  )*L+l]);
+            __m128 r1 = _mm_loadu_ps(&_im[(k  )*L+l]);
+            __m128 r2 = _mm_loadu_ps(&_re[(k+1)*L+l]);
+            __m128 r3 = _mm_loadu_ps(&_im[(k+1)*L+l]);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(&y0[2*k], r0);
+            _mm_storeu_ps(&y1[2*k], r1);
+            _mm_storeu_ps(&y2[2*k], r2);
+            _mm_storeu_ps(&y3[2*k], r3);
+        }
+    }
+}
+#endif
@@ -33,6 +33,15 @@
 
 #define FFT_DEBUG_MIXED_RADIX 0
 
+// number of columns (rows) processed together in each pass, chosen so
+// that each strided access touches at least one full cache line
+#define FFT_MIXED_RADIX_BLOCK 8
+
+// transforms longer than this are split into two sub-transforms of
+// roughly sqrt(nfft) points ("four-step" method) so that the working set
+// of each sub-transform fits in a typical L2 cache (256 KiB)
+#define FFT_MIXED_RADIX_FOURSTEP 32768
+
 // create FFT plan for regular DFT
 //  _nfft   :   FFT size
 //  _x      :   input array [size: _nfft x 1]
@@ -59,7 +68,6 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
     q->execute   = FFT(_execute_mixed_radix);
 
     // find first 'prime' factor of _nfft
-    unsigned int i;
     unsigned int Q = FFT(_estimate_mixed_radix)(_nfft);
     if (Q==0) {
         fprintf(stderr,"error: fft_create_plan_mixed_radix(), _nfft=%u is prime\n", _nfft);
@@ -74,12 +82,13 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
     q->data.mixedradix.Q = Q;
     q->data.mixedradix.P = P;
 
-    // allocate memory for buffers
-    unsigned int t_len = Q > P ? Q : P;
+    // allocate memory for buffers: sub-transforms are run on blocks of
+    // up to FFT_MIXED_RADIX_BLOCK columns (rows) at a time
+    unsigned int t_len = FFT_MIXED_RADIX_BLOCK * (Q > P ? Q : P);
     q->data.mixedradix.t0 = (TC *) malloc(t_len * sizeof(TC));
     q->data.mixedradix.t1 = (TC *) malloc(t_len * sizeof(TC));
 
-    // allocate memory for input buffers
+    // allocate memory for intermediate buffer
     q->data.mixedradix.x = (TC *) malloc(q->nfft * sizeof(TC));
 
     // create P-point FFT plan
@@ -96,17 +105,30 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
                                                  q->direction,
                                                  q->flags);
 
-    // initialize twiddle factors, indices for mixed-radix transforms
-    // TODO : only allocate necessary twiddle factors
-    q->data.mixedradix.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
-    
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft; i++)
-        q->data.mixedradix.twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(q->nfft));
+    // get twiddle factors from cache
+    q->data.mixedradix.table   = FFT(_cache_acquire)(q, FFT(_table_init_mixed_radix));
+    q->data.mixedradix.twiddle = q->data.mixedradix.table->twiddle;
 
     return q;
 }
 
+// initialize table of twiddle factors for plan, stored in the order
+// they are applied: twiddle[k*Q+i] = W^(i*k)
+void FFT(_table_init_mixed_radix)(FFT(plan)  _q,
+                                  FFT(table) _t)
+{
+    unsigned int P = _q->data.mixedradix.P;
+    unsigned int Q = _q->data.mixedradix.Q;
+    _t->twiddle = (TC *) malloc(_q->nfft * sizeof(TC));
+
+    T d = (_q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    unsigned int i, k;
+    for (k=0; k<P; k++) {
+        for (i=0; i<Q; i++)
+            _t->twiddle[k*Q+i] = cexpf(_Complex_I*d*2*M_PI*(T)(i*k) / (T)(_q->nfft));
+    }
+}
+
 // destroy FFT plan
 void FFT(_destroy_plan_mixed_radix)(FFT(plan) _q)
 {
@@ -118,13 +140,31 @@ void FFT(_destroy_plan_mixed_radix)(FFT(plan) _q)
     free(_q->data.mixedradix.t0);
     free(_q->data.mixedradix.t1);
     free(_q->data.mixedradix.x);
-    free(_q->data.mixedradix.twiddle);
+    FFT(_cache_release)(_q->data.mixedradix.table);
 
     // free main object memory
     free(_q);
 }
 
+// execute sub-transform on arbitrary buffers (sub-plans only ever
+// access data through their x/y pointers at execution time)
+static void FFT(_execute_mixed_radix_sub)(FFT(plan) _p,
+                                          TC *      _x,
+                                          TC *      _y)
+{
+    _p->x = _x;
+    _p->y = _y;
+    FFT(_execute)(_p);
+}
+
 // execute mixed-radix FFT
+//
+// The input is viewed as a P x Q matrix, x[Q*k+i]. The 'Q' column
+// transforms of size 'P' read the input directly (no copy), a block of
+// adjacent columns at a time so that each row access is contiguous; the
+// twiddled results are written row-wise to an intermediate buffer. The
+// 'P' row transforms of size 'Q' then run directly on that buffer, and
+// their results are transposed to the output a block of rows at a time.
 void FFT(_execute_mixed_radix)(FFT(plan) _q)
 {
     // set internal constants
@@ -132,61 +172,55 @@ void FFT(_execute_mixed_radix)(FFT(plan) _q)
     unsigned int Q = _q->data.mixedradix.Q; // second FFT size
 
     // set pointers
-    TC * t0      = _q->data.mixedradix.t0;  // small FFT input buffer
-    TC * t1      = _q->data.mixedradix.t1;  // small FFT output buffer
-    TC * x       = _q->data.mixedradix.x;   // full input buffer (data copied)
+    TC * t0      = _q->data.mixedradix.t0;  // sub-transform input buffer
+    TC * t1      = _q->data.mixedradix.t1;  // sub-transform output buffer
+    TC * z       = _q->data.mixedradix.x;   // intermediate buffer [P x Q]
     TC * twiddle = _q->data.mixedradix.twiddle; // twiddle factors
+    TC * x       = _q->x;
+    TC * y       = _q->y;
 
-    // copy input to internal buffer
-    memmove(x, _q->x, _q->nfft*sizeof(TC));
-
-    unsigned int i;
-    unsigned int k;
+    unsigned int i0, k0, b, nb, k, r;
 
-    // compute 'Q' DFTs of size 'P'
+    // compute 'Q' DFTs of size 'P', FFT_MIXED_RADIX_BLOCK at a time
 #if FFT_DEBUG_MIXED_RADIX
     printf("computing %u DFTs of size %u\n", Q, P);
 #endif
-    for (i=0; i<Q; i++) {
-        // copy to temporary buffer
-        for (k=0; k<P; k++)
-            t0[k] = x[Q*k+i];
+    for (i0=0; i0<Q; i0+=FFT_MIXED_RADIX_BLOCK) {
+        nb = (Q - i0) < FFT_MIXED_RADIX_BLOCK ? (Q - i0) : FFT_MIXED_RADIX_BLOCK;
 
-        // run internal P-point DFT
-        FFT(_execute)(_q->data.mixedradix.fft_P);
+        // gather block of columns into temporary buffer
+        for (k=0; k<P; k++) {
+            for (b=0; b<nb; b++)
+                t0[b*P+k] = x[Q*k+i0+b];
+        }
 
-        // copy back to input, applying twiddle factors
-        for (k=0; k<P; k++)
-            x[Q*k+i] = t1[k] * twiddle[i*k];
+        // run internal P-point DFTs
+        for (b=0; b<nb; b++)
+            FFT(_execute_mixed_radix_sub)(_q->data.mixedradix.fft_P, &t0[b*P], &t1[b*P]);
 
-#if FFT_DEBUG_MIXED_RADIX
-        printf("i=%3u/%3u\n", i, Q);
-        for (k=0; k<P; k++)
-            printf("  %12.6f %12.6f\n", crealf(x[Q*k+i]), cimagf(x[Q*k+i]));
-#endif
+        // store to intermediate buffer, applying twiddle factors
+        for (k=0; k<P; k++) {
+            for (b=0; b<nb; b++)
+                z[Q*k+i0+b] = t1[b*P+k] * twiddle[Q*k+i0+b];
+        }
     }
 
     // compute 'P' DFTs of size 'Q' and transpose
-#if DEBUG
+#if FFT_DEBUG_MIXED_RADIX
     printf("computing %u DFTs of size %u\n", P, Q);
 #endif
-    for (i=0; i<P; i++) {
-        // copy to temporary buffer
-        for (k=0; k<Q; k++)
-            t0[k] = x[Q*i+k];
-
-        // run internal Q-point DFT
-        FFT(_execute)(_q->data.mixedradix.fft_Q);
-
-        // copy and transpose
-        for (k=0; k<Q; k++)
-            _q->y[k*P+i] = t1[k];
-        
-#if DEBUG
-        printf("i=%3u/%3u\n", i, P);
-        for (k=0; k<Q; k++)
-            printf("  %12.6f %12.6f\n", crealf(_q->y[k*P+i]), cimagf(_q->y[k*P+i]));
-#endif
+    for (k0=0; k0<P; k0+=FFT_MIXED_RADIX_BLOCK) {
+        nb = (P - k0) < FFT_MIXED_RADIX_BLOCK ? (P - k0) : FFT_MIXED_RADIX_BLOCK;
+
+        // run internal Q-point DFTs directly on rows of intermediate buffer
+        for (b=0; b<nb; b++)
+            FFT(_execute_mixed_radix_sub)(_q->data.mixedradix.fft_Q, &z[Q*(k0+b)], &t1[b*Q]);
+
+        // transpose block to output
+        for (r=0; r<Q; r++) {
+            for (b=0; b<nb; b++)
+                y[P*r+k0+b] = t1[b*Q+r];
+        }
     }
 }
 
@@ -215,6 +249,23 @@ unsigned int FFT(_estimate_mixed_radix)(unsigned int _nfft)
     num_factors_2 = i;
     //printf("nfft: %u / 2^%u = %u\n", _nfft, num_factors_2, _nfft / (1<<num_factors_2));
 
+    // large transforms: use the divisor closest to sqrt(nfft) if the
+    // result is reasonably balanced (four-step method)
+    if (_nfft > FFT_MIXED_RADIX_FOURSTEP) {
+        unsigned int q;
+        for (q=(unsigned int)sqrtf((float)_nfft); q>=16; q--) {
+            if ( (_nfft % q) == 0 )
+                return q;
+        }
+    }
+
+    // a large power-of-two factor with a small remainder: keep the
+    // power of two whole for the vectorized radix-2 sub-fft method and
+    // let the remaining (odd) factors form the small transform
+    unsigned int r = _nfft >> num_factors_2;
+    if (num_factors_2 >= 5 && r > 1 && r <= 64)
+        return r;
+
     // prefer aggregate radix-2 form if possible
     if (num_factors_2 > 0) {
 #if 0
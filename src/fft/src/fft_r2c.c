@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_r2c.c : real-to-complex and complex-to-real transforms
+//
+// The spectrum of a real sequence x of even length n = 2N is Hermitian,
+// so only the N+1 bins X[0..N] are computed. The even and odd samples
+// are packed into one complex sequence z[m] = x[2m] + j x[2m+1] of
+// length N whose transform Z splits into the transforms E and O of the
+// even and odd samples:
+//
+//      E[k] = ( Z[k] + conj(Z[N-k]) ) / 2
+//      O[k] = ( Z[k] - conj(Z[N-k]) ) / (2j)
+//      X[k] = E[k] + W^k O[k],     W = exp(-j*2*pi/n)
+//
+// The inverse runs these steps backwards. Transforms of odd length are
+// computed with a full-length complex transform.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// create real-to-complex plan (internal)
+FFT(plan) FFT(_create_plan_r2c_internal)(unsigned int _nfft,
+                                         int          _type,
+                                         int          _flags)
+{
+    if (_nfft < 2) {
+        fprintf(stderr,"error: fft_create_plan_%s(), transform size must be at least 2\n",
+                _type == LIQUID_FFT_R2C ? "r2c" : "c2r");
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->x         = NULL;
+    q->y         = NULL;
+    q->xr        = NULL;
+    q->yr        = NULL;
+    q->flags     = _flags;
+    q->type      = _type;
+    q->direction = (_type == LIQUID_FFT_R2C) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_UNKNOWN;
+
+    // sub-transform: half length for even sizes, full length otherwise
+    unsigned int n = (_nfft % 2) ? _nfft : _nfft / 2;
+    q->data.r2c.z       = (TC *) malloc(n*sizeof(TC));
+    q->data.r2c.Z       = (TC *) malloc(n*sizeof(TC));
+    q->data.r2c.twiddle = NULL;
+    if (_type == LIQUID_FFT_R2C)
+        q->data.r2c.fft = FFT(_create_plan)(n, q->data.r2c.z, q->data.r2c.Z, LIQUID_FFT_FORWARD,  _flags);
+    else
+        q->data.r2c.fft = FFT(_create_plan)(n, q->data.r2c.Z, q->data.r2c.z, LIQUID_FFT_BACKWARD, _flags);
+
+    if (_nfft % 2 == 0) {
+        // twiddle factors W^k for k in [0, N/2]; the remaining half
+        // follows from W^(N-k) = -conj(W^k)
+        q->data.r2c.twiddle = (TC *) malloc((n/2+1)*sizeof(TC));
+        unsigned int k;
+        for (k=0; k<=n/2; k++) {
+            double theta = -2*M_PI*(double)k / (double)_nfft;
+            q->data.r2c.twiddle[k] = cos(theta) + _Complex_I*sin(theta);
+        }
+    }
+
+    return q;
+}
+
+// create real-to-complex transform plan
+//  _nfft   :   transform size
+//  _x      :   input array [size: _nfft x 1]
+//  _y      :   output array [size: _nfft/2+1 x 1]
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_r2c)(unsigned int _nfft,
+                                T *          _x,
+                                TC *         _y,
+                                int          _flags)
+{
+    FFT(plan) q = FFT(_create_plan_r2c_internal)(_nfft, LIQUID_FFT_R2C, _flags);
+    q->xr      = _x;
+    q->y       = _y;
+    q->execute = FFT(_execute_r2c);
+    return q;
+}
+
+// create complex-to-real transform plan
+//  _nfft   :   transform size
+//  _x      :   input array [size: _nfft/2+1 x 1]
+//  _y      :   output array [size: _nfft x 1]
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_c2r)(unsigned int _nfft,
+                                TC *         _x,
+                                T *          _y,
+                                int          _flags)
+{
+    FFT(plan) q = FFT(_create_plan_r2c_internal)(_nfft, LIQUID_FFT_C2R, _flags);
+    q->x       = _x;
+    q->yr      = _y;
+    q->execute = FFT(_execute_c2r);
+    return q;
+}
+
+// destroy real-to-complex/complex-to-real transform plan
+void FFT(_destroy_plan_r2c)(FFT(plan) _q)
+{
+    FFT(_destroy_plan)(_q->data.r2c.fft);
+    free(_q->data.r2c.z);
+    free(_q->data.r2c.Z);
+    free(_q->data.r2c.twiddle);
+
+    // free main object memory
+    free(_q);
+}
+
+// execute real-to-complex transform
+void FFT(_execute_r2c)(FFT(plan) _q)
+{
+    unsigned int nfft = _q->nfft;
+    TC * z = _q->data.r2c.z;
+    TC * Z = _q->data.r2c.Z;
+    unsigned int k;
+
+    if (nfft % 2) {
+        // odd length: full complex transform
+        for (k=0; k<nfft; k++)
+            z[k] = _q->xr[k];
+        FFT(_execute)(_q->data.r2c.fft);
+        for (k=0; k<=nfft/2; k++)
+            _q->y[k] = Z[k];
+        return;
+    }
+
+    // pack even/odd samples into half-length complex sequence
+    unsigned int n = nfft / 2;
+    for (k=0; k<n; k++)
+        z[k] = _q->xr[2*k] + _Complex_I*_q->xr[2*k+1];
+    FFT(_execute)(_q->data.r2c.fft);
+
+    // split: DC and Nyquist bins are purely real
+    T z0r = crealf(Z[0]);
+    T z0i = cimagf(Z[0]);
+    _q->y[0] = z0r + z0i;
+    _q->y[n] = z0r - z0i;
+
+    // remaining bins in pairs (k, n-k)
+    TC * w = _q->data.r2c.twiddle;
+    for (k=1; k<=n/2; k++) {
+        TC a = Z[k];
+        TC b = conjf(Z[n-k]);
+        TC e = 0.5f*(a + b);                // E[k]
+        TC o = -0.5f*_Complex_I*(a - b);    // O[k]
+
+        // E[n-k] = conj(E[k]), O[n-k] = conj(O[k]), W^(n-k) = -conj(W^k)
+        _q->y[k]   = e + w[k]*o;
+        _q->y[n-k] = conjf(e - w[k]*o);
+    }
+}
+
+// execute complex-to-real transform (not normalized)
+void FFT(_execute_c2r)(FFT(plan) _q)
+{
+    unsigned int nfft = _q->nfft;
+    TC * z = _q->data.r2c.z;
+    TC * Z = _q->data.r2c.Z;
+    unsigned int k;
+
+    if (nfft % 2) {
+        // odd length: rebuild Hermitian spectrum, full complex transform
+        Z[0] = crealf(_q->x[0]);
+        for (k=1; k<=nfft/2; k++) {
+            Z[k]      = _q->x[k];
+            Z[nfft-k] = conjf(_q->x[k]);
+        }
+        FFT(_execute)(_q->data.r2c.fft);
+        for (k=0; k<nfft; k++)
+            _q->yr[k] = crealf(z[k]);
+        return;
+    }
+
+    // merge bins into half-length spectrum Z[k] = E[k] + j O[k], scaled
+    // by two so that the result matches a full-length inverse transform
+    unsigned int n = nfft / 2;
+    T x0 = crealf(_q->x[0]);
+    T xn = crealf(_q->x[n]);
+    Z[0] = (x0 + xn) + _Complex_I*(x0 - xn);
+
+    TC * w = _q->data.r2c.twiddle;
+    for (k=1; k<=n/2; k++) {
+        TC a = _q->x[k];
+        TC b = conjf(_q->x[n-k]);
+        TC e = a + b;                   // 2 E[k]
+        TC o = (a - b) * conjf(w[k]);   // 2 O[k]
+
+        Z[k]   = e + _Complex_I*o;
+        Z[n-k] = conjf(e) + _Complex_I*conjf(o);
+    }
+    FFT(_execute)(_q->data.r2c.fft);
+
+    // unpack even/odd samples
+    for (k=0; k<n; k++) {
+        _q->yr[2*k  ] = crealf(z[k]);
+        _q->yr[2*k+1] = cimagf(z[k]);
+    }
+}
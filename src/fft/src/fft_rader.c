@@ -81,37 +81,46 @@ FFT(plan) FFT(_create_plan_rader)(unsigned int _nfft,
                                            LIQUID_FFT_BACKWARD,
                                            q->flags);
 
+    // get sequence and its transform from cache
+    q->data.rader.table = FFT(_cache_acquire)(q, FFT(_table_init_rader));
+    q->data.rader.seq   = q->data.rader.table->index;
+    q->data.rader.R     = q->data.rader.table->twiddle;
+
+    // return main object
+    return q;
+}
+
+// initialize table of transformation sequence and its DFT for plan
+void FFT(_table_init_rader)(FFT(plan)  _q,
+                            FFT(table) _t)
+{
     // compute primitive root of nfft
-    unsigned int g = liquid_primitive_root_prime(q->nfft);
+    unsigned int g = liquid_primitive_root_prime(_q->nfft);
 
     // create and initialize sequence
-    q->data.rader.seq = (unsigned int *)malloc((q->nfft-1)*sizeof(unsigned int));
+    _t->index = (unsigned int *)malloc((_q->nfft-1)*sizeof(unsigned int));
     unsigned int i;
-    for (i=0; i<q->nfft-1; i++)
-        q->data.rader.seq[i] = liquid_modpow(g, i+1, q->nfft);
-    
+    for (i=0; i<_q->nfft-1; i++)
+        _t->index[i] = liquid_modpow(g, i+1, _q->nfft);
+
     // compute DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft-1
     // NOTE: R[0] = -1, |R[k]| = sqrt(nfft) for k != 0
     // (use newly-created FFT plan of length nfft-1)
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft-1; i++)
-        q->data.rader.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*q->data.rader.seq[i]/(T)(q->nfft));
-    FFT(_execute)(q->data.rader.fft);
+    T d = (_q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    for (i=0; i<_q->nfft-1; i++)
+        _q->data.rader.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*_t->index[i]/(T)(_q->nfft));
+    FFT(_execute)(_q->data.rader.fft);
 
     // copy result to R
-    q->data.rader.R = (TC*)malloc((q->nfft-1)*sizeof(TC));
-    memmove(q->data.rader.R, q->data.rader.X_prime, (q->nfft-1)*sizeof(TC));
-    
-    // return main object
-    return q;
+    _t->twiddle = (TC*)malloc((_q->nfft-1)*sizeof(TC));
+    memmove(_t->twiddle, _q->data.rader.X_prime, (_q->nfft-1)*sizeof(TC));
 }
 
 // destroy FFT plan
 void FFT(_destroy_plan_rader)(FFT(plan) _q)
 {
     // free data specific to Rader's algorithm
-    free(_q->data.rader.seq);       // sequence
-    free(_q->data.rader.R);         // pre-computed transform of exp(j*2*pi*seq)
+    FFT(_cache_release)(_q->data.rader.table); // sequence, transform of exp(j*2*pi*seq)
     free(_q->data.rader.x_prime);   // sub-transform input array
     free(_q->data.rader.X_prime);   // sub-transform output array
 
@@ -145,16 +154,18 @@ void FFT(_execute_rader)(FFT(plan) _q)
     // equivalent to: FFT(_run)(_q->nfft-1, Xp, xp, LIQUID_FFT_BACKWARD, 0);
     FFT(_execute)(_q->data.rader.ifft);
 
-    // set DC value
-    _q->y[0] = 0.0f;
+    // compute DC value, keep x[0] (input may be overwritten in place)
+    TC x0 = _q->x[0];
+    TC y0 = 0.0f;
     for (i=0; i<_q->nfft; i++)
-        _q->y[0] += _q->x[i];
+        y0 += _q->x[i];
+    _q->y[0] = y0;
 
     // reverse permute result, scale, and add offset x[0]
     for (i=0; i<_q->nfft-1; i++) {
         unsigned int k = _q->data.rader.seq[i];
 
-        _q->y[k] = _q->data.rader.x_prime[i] / (T)(_q->nfft-1) + _q->x[0];
+        _q->y[k] = _q->data.rader.x_prime[i] / (T)(_q->nfft-1) + x0;
     }
 }
 
@@ -62,16 +62,6 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
 
     q->execute   = FFT(_execute_rader2);
 
-    unsigned int i;
-
-    // compute primitive root of nfft
-    unsigned int g = liquid_primitive_root_prime(q->nfft);
-
-    // create and initialize sequence
-    q->data.rader2.seq = (unsigned int *)malloc((q->nfft-1)*sizeof(unsigned int));
-    for (i=0; i<q->nfft-1; i++)
-        q->data.rader2.seq[i] = liquid_modpow(g, i+1, q->nfft);
-
 #if 0
     // compute larger FFT length greater than 2*nfft-4
     // NOTE: while any length greater than 2*nfft-4 will work, use
@@ -81,6 +71,7 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
     //       score(n) = n / sum(factors(n).^2)
     float gamma_max = 0.0f; // score
     unsigned int nfft_prime_opt = 0;
+    unsigned int i;
     unsigned int num_steps = 10;// + q->nfft;
     for (i=1; i<=num_steps; i++) {
         unsigned int n_hat = 2*q->nfft - 4 + i;
@@ -146,28 +137,49 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
                                             LIQUID_FFT_BACKWARD,
                                             q->flags);
 
+    // get sequence and its transform from cache
+    q->data.rader2.table = FFT(_cache_acquire)(q, FFT(_table_init_rader2));
+    q->data.rader2.seq   = q->data.rader2.table->index;
+    q->data.rader2.R     = q->data.rader2.table->twiddle;
+
+    // return main object
+    return q;
+}
+
+// initialize table of transformation sequence and its DFT for plan
+void FFT(_table_init_rader2)(FFT(plan)  _q,
+                             FFT(table) _t)
+{
+    unsigned int nfft_prime = _q->data.rader2.nfft_prime;
+
+    // compute primitive root of nfft
+    unsigned int g = liquid_primitive_root_prime(_q->nfft);
+
+    // create and initialize sequence
+    _t->index = (unsigned int *)malloc((_q->nfft-1)*sizeof(unsigned int));
+    unsigned int i;
+    for (i=0; i<_q->nfft-1; i++)
+        _t->index[i] = liquid_modpow(g, i+1, _q->nfft);
+
     // compute DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft_prime
     // NOTE: R[0] = -1, |R[k]| = sqrt(nfft) for k != 0
     // (use newly-created FFT plan of length nfft_prime)
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->data.rader2.nfft_prime; i++)
-        q->data.rader2.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*q->data.rader2.seq[i%(q->nfft-1)]/(T)(q->nfft));
-    FFT(_execute)(q->data.rader2.fft);
-    
-    // copy result to R
-    q->data.rader2.R = (TC*)malloc(q->data.rader2.nfft_prime*sizeof(TC));
-    memmove(q->data.rader2.R, q->data.rader2.X_prime, q->data.rader2.nfft_prime*sizeof(TC));
+    T d = (_q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    for (i=0; i<nfft_prime; i++)
+        _q->data.rader2.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*_t->index[i%(_q->nfft-1)]/(T)(_q->nfft));
+    FFT(_execute)(_q->data.rader2.fft);
 
-    // return main object
-    return q;
+    // copy result to R
+    _t->n       = nfft_prime;
+    _t->twiddle = (TC*)malloc(nfft_prime*sizeof(TC));
+    memmove(_t->twiddle, _q->data.rader2.X_prime, nfft_prime*sizeof(TC));
 }
 
 // destroy FFT plan
 void FFT(_destroy_plan_rader2)(FFT(plan) _q)
 {
     // free data specific to Rader's algorithm
-    free(_q->data.rader2.seq);      // sequence
-    free(_q->data.rader2.R);        // pre-computed transform of exp(j*2*pi*seq)
+    FFT(_cache_release)(_q->data.rader2.table); // sequence, transform of exp(j*2*pi*seq)
 
     free(_q->data.rader2.x_prime);   // sub-transform input array
     free(_q->data.rader2.X_prime);   // sub-transform output array
@@ -214,16 +226,18 @@ void FFT(_execute_rader2)(FFT(plan) _q)
     // call radix-2 function (IFFT)
     FFT(_execute)(_q->data.rader2.ifft);
 
-    // set DC value
-    _q->y[0] = 0.0f;
+    // compute DC value, keep x[0] (input may be overwritten in place)
+    TC x0 = _q->x[0];
+    TC y0 = 0.0f;
     for (i=0; i<_q->nfft; i++)
-        _q->y[0] += _q->x[i];
+        y0 += _q->x[i];
+    _q->y[0] = y0;
 
     // reverse permute result, scale, and add offset x[0]
     for (i=0; i<_q->nfft-1; i++) {
         unsigned int k = seq[i];
 
-        _q->y[k] = xp[i] / (T)(nfft_prime) + _q->x[0];
+        _q->y[k] = xp[i] / (T)(nfft_prime) + x0;
     }
 }
 
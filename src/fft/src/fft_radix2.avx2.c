@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fft_radix2.avx2.c : radix-4 butterfly pass for radix-2 transforms
+//                     (AVX2/FMA)
+//
+// This file is compiled with -mavx2 -mfma regardless of the build host;
+// the kernel is only selected when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX, AVX2, FMA
+
+// complex multiply, four interleaved values per register
+static inline __m256 fft_cmul_avx2(__m256 _a, __m256 _w)
+{
+    __m256 wr = _mm256_moveldup_ps(_w);
+    __m256 wi = _mm256_movehdup_ps(_w);
+    __m256 as = _mm256_permute_ps(_a, _MM_SHUFFLE(2,3,0,1));
+    return _mm256_fmaddsub_ps(_a, wr, _mm256_mul_ps(as, wi));
+}
+
+// radix-4 decimation-in-time butterfly pass (AVX2/FMA), four
+// butterflies at a time; see fft_radix2_pass4() for a description of
+// the method and arguments
+void fft_radix2_pass4_avx2(float complex * _y,
+                           unsigned int    _n,
+                           unsigned int    _h,
+                           float complex * _w,
+                           int             _dir)
+{
+    // spans narrower than one register use the baseline kernel
+    if (_h < 4) {
+#if HAVE_SSE3 && HAVE_PMMINTRIN_H
+        fft_radix2_pass4_sse(_y, _n, _h, _w, _dir);
+#else
+        fft_radix2_pass4(_y, _n, _h, _w, _dir);
+#endif
+        return;
+    }
+
+    // multiplication by W_4 = -/+j : swap components, negate one
+    __m256 sign = (_dir == LIQUID_FFT_FORWARD) ?
+        _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f) :
+        _mm256_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f);
+
+    float * w1 = (float*)(_w);
+    float * w2 = (float*)(_w +   _h);
+    float * w3 = (float*)(_w + 2*_h);
+
+    unsigned int j, k;
+    for (k=0; k<_n; k+=4*_h) {
+        float * y0 = (float*)(_y + k);
+        float * y1 = (float*)(_y + k +   _h);
+        float * y2 = (float*)(_y + k + 2*_h);
+        float * y3 = (float*)(_y + k + 3*_h);
+        for (j=0; j<2*_h; j+=8) {
+            __m256 a = _mm256_loadu_ps(&y0[j]);
+            __m256 b = fft_cmul_avx2(_mm256_loadu_ps(&y2[j]), _mm256_loadu_ps(&w1[j]));
+            __m256 c = fft_cmul_avx2(_mm256_loadu_ps(&y1[j]), _mm256_loadu_ps(&w2[j]));
+            __m256 d = fft_cmul_avx2(_mm256_loadu_ps(&y3[j]), _mm256_loadu_ps(&w3[j]));
+
+            __m256 t0 = _mm256_add_ps(a, c);
+            __m256 t1 = _mm256_sub_ps(a, c);
+            __m256 t2 = _mm256_add_ps(b, d);
+            __m256 t3 = _mm256_sub_ps(b, d);
+            t3 = _mm256_xor_ps(_mm256_permute_ps(t3, _MM_SHUFFLE(2,3,0,1)), sign);
+
+            _mm256_storeu_ps(&y0[j], _mm256_add_ps(t0, t2));
+            _mm256_storeu_ps(&y1[j], _mm256_add_ps(t1, t3));
+            _mm256_storeu_ps(&y2[j], _mm256_sub_ps(t0, t2));
+            _mm256_storeu_ps(&y3[j], _mm256_sub_ps(t1, t3));
+        }
+    }
+}
@@ -23,12 +23,24 @@
 //
 // fft_radix2.c : definitions for transforms of the form 2^m
 //
+// The transform is computed in place on the output array after a
+// bit-reversal permutation of the input. The first one or two
+// decimation-in-time stages (which have trivial twiddle factors) are
+// fused with the permutation; all remaining stages are computed in
+// pairs as radix-4 butterfly passes. Each pass reads its twiddle
+// factors from a contiguous per-pass table so that the inner loop can
+// be vectorized across butterflies.
+//
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include "liquid.internal.h"
 
+#if HAVE_SSE3 && HAVE_PMMINTRIN_H
+#include <pmmintrin.h>  // SSE3
+#endif
+
 // create FFT plan for regular DFT
 //  _nfft   :   FFT size
 //  _x      :   input array [size: _nfft x 1]
@@ -54,30 +66,59 @@ FFT(plan) FFT(_create_plan_radix2)(unsigned int _nfft,
 
     q->execute   = FFT(_execute_radix2);
 
-    // initialize twiddle factors, indices for radix-2 transforms
-    q->data.radix2.m = liquid_msb_index(q->nfft) - 1;  // m = log2(nfft)
-    
-    q->data.radix2.index_rev = (unsigned int *) malloc((q->nfft)*sizeof(unsigned int));
-    unsigned int i;
-    for (i=0; i<q->nfft; i++)
-        q->data.radix2.index_rev[i] = fft_reverse_index(i,q->data.radix2.m);
+    // get twiddle factors, indices for radix-2 transforms from cache
+    q->data.radix2.m         = liquid_msb_index(q->nfft) - 1;  // m = log2(nfft)
+    q->data.radix2.table     = FFT(_cache_acquire)(q, FFT(_table_init_radix2));
+    q->data.radix2.index_rev = q->data.radix2.table->index;
+    q->data.radix2.twiddle   = q->data.radix2.table->twiddle;
 
-    // initialize twiddle factors
-    q->data.radix2.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
-    
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft; i++)
-        q->data.radix2.twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(q->nfft));
+    // select butterfly pass kernel
+    q->data.radix2.pass = FFT(_radix2_pass4);
+#if HAVE_SSE3 && HAVE_PMMINTRIN_H
+    q->data.radix2.pass = FFT(_radix2_pass4_sse);
+#endif
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+        q->data.radix2.pass = FFT(_radix2_pass4_avx2);
+#endif
 
     return q;
 }
 
+// initialize table of twiddle factors, reversed indices for plan
+void FFT(_table_init_radix2)(FFT(plan)  _q,
+                             FFT(table) _t)
+{
+    unsigned int m = _q->data.radix2.m;
+    _t->index = (unsigned int *) malloc((_q->nfft)*sizeof(unsigned int));
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++)
+        _t->index[i] = fft_reverse_index(i,m);
+
+    // initialize twiddle factors for each radix-4 pass: for a pass on
+    // blocks of size 4h the table holds { u^1, u^2, u^3 } for j < h,
+    // where u = exp(+/- j*2*pi*j/(4h)), one array after the other
+    _t->twiddle = (TC *) malloc(_q->nfft * sizeof(TC));
+
+    double d = (_q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    unsigned int h = (m % 2) ? 2 : 4;
+    unsigned int n = 0;
+    unsigned int j, r;
+    for ( ; 4*h <= _q->nfft; h *= 4) {
+        for (r=1; r<=3; r++) {
+            for (j=0; j<h; j++) {
+                double theta = d*2*M_PI*(double)(r*j) / (double)(4*h);
+                _t->twiddle[n++] = cos(theta) + _Complex_I*sin(theta);
+            }
+        }
+    }
+}
+
 // destroy FFT plan
 void FFT(_destroy_plan_radix2)(FFT(plan) _q)
 {
-    // free data specific to radix-2 transforms
-    free(_q->data.radix2.index_rev);
-    free(_q->data.radix2.twiddle);
+    // release data specific to radix-2 transforms
+    FFT(_cache_release)(_q->data.radix2.table);
 
     // free main object memory
     free(_q);
@@ -86,52 +127,184 @@ void FFT(_destroy_plan_radix2)(FFT(plan) _q)
 // execute radix-2 FFT
 void FFT(_execute_radix2)(FFT(plan) _q)
 {
-    // swap values
-    unsigned int i,j,k;
-
-    // unroll loop
-    unsigned int nfft4 = (_q->nfft>>2)<<2;  // floor(_nfft/4)
-    for (i=0; i<nfft4; i+=4) {
-        _q->y[i  ] = _q->x[ _q->data.radix2.index_rev[i  ] ];
-        _q->y[i+1] = _q->x[ _q->data.radix2.index_rev[i+1] ];
-        _q->y[i+2] = _q->x[ _q->data.radix2.index_rev[i+2] ];
-        _q->y[i+3] = _q->x[ _q->data.radix2.index_rev[i+3] ];
+    unsigned int   n   = _q->nfft;
+    unsigned int * rev = _q->data.radix2.index_rev;
+    TC *           x   = _q->x;
+    TC *           y   = _q->y;
+    unsigned int i, j;
+
+    // in-place transform: permute output array and operate on it
+    if (x == y) {
+        TC t;
+        for (i=0; i<n; i++) {
+            j = rev[i];
+            if (j > i) {
+                t    = y[i];
+                y[i] = y[j];
+                y[j] = t;
+            }
+        }
     }
 
-#if 0
-    // clean up remaining
-    // NOTE : this only happens when _nfft=2 because we know (_nfft%4)==0 otherwise
-    for ( ; i<_q->nfft; i++)
-        _q->y[i] = _q->x[ _q->data.radix2.index_rev[i] ];
-#endif
+    // first stage(s), fused with bit-reversal permutation: radix-2 if
+    // log2(nfft) is odd, radix-4 otherwise (no twiddle multiplications)
+    unsigned int h;
+    if (_q->data.radix2.m % 2) {
+        for (i=0; i<n; i+=2) {
+            TC a = (x==y) ? y[i  ] : x[rev[i  ]];
+            TC b = (x==y) ? y[i+1] : x[rev[i+1]];
+            y[i  ] = a + b;
+            y[i+1] = a - b;
+        }
+        h = 2;
+    } else {
+        // W_4 = exp(-/+ j*pi/2) rotates (b-d) by -/+ 90 degrees
+        int fwd = (_q->direction == LIQUID_FFT_FORWARD);
+        for (i=0; i<n; i+=4) {
+            TC a = (x==y) ? y[i  ] : x[rev[i  ]];
+            TC c = (x==y) ? y[i+1] : x[rev[i+1]];
+            TC b = (x==y) ? y[i+2] : x[rev[i+2]];
+            TC d = (x==y) ? y[i+3] : x[rev[i+3]];
 
-    TC yp;
-    TC *y=_q->y;
-    unsigned int n1 = 0;
-    unsigned int n2 = 1;
-
-    TC t;   // twiddle value
-    unsigned int stride = _q->nfft;
-    unsigned int twiddle_index;
-
-    for (i=0; i<_q->data.radix2.m; i++) {
-        n1 = n2;
-        n2 *= 2;
-        stride >>= 1;
-
-        twiddle_index = 0;
-    
-        for (j=0; j<n1; j++) {
-            t = _q->data.radix2.twiddle[twiddle_index];
-            twiddle_index = (twiddle_index + stride) % _q->nfft;
-
-            for (k=j; k<_q->nfft; k+=n2) {
-                // NOTE: most computation is with the multiplication in next line
-                yp      =  y[k+n1]*t;
-                y[k+n1] =  y[k] - yp;
-                y[k]    += yp;
-            }
+            TC t0 = a + c;
+            TC t1 = a - c;
+            TC t2 = b + d;
+            TC t3 = b - d;
+            t3 = fwd ? cimagf(t3) - _Complex_I*crealf(t3) :
+                      -cimagf(t3) + _Complex_I*crealf(t3);
+
+            y[i  ] = t0 + t2;
+            y[i+1] = t1 + t3;
+            y[i+2] = t0 - t2;
+            y[i+3] = t1 - t3;
+        }
+        h = 4;
+    }
+
+    // remaining stages as radix-4 passes
+    TC * w = _q->data.radix2.twiddle;
+    for ( ; 4*h <= n; h *= 4) {
+        _q->data.radix2.pass(y, n, h, w, _q->direction);
+        w += 3*h;
+    }
+}
+
+// radix-4 decimation-in-time butterfly pass (portable C)
+//
+// After the bit-reversal permutation, each block of 4h samples holds
+// four length-h transforms of the sub-sequences with residues {0,2,1,3}
+// (mod 4). With u = W_{4h}^j these are combined as
+//
+//      A = y[j], B = u*y[j+2h], C = u^2*y[j+h], D = u^3*y[j+3h]
+//      y[j   ] = (A + C) + (B + D)
+//      y[j+ h] = (A - C) + W_4 (B - D)
+//      y[j+2h] = (A + C) - (B + D)
+//      y[j+3h] = (A - C) - W_4 (B - D)
+//
+//  _y      :   data array (in place) [size: _n x 1]
+//  _n      :   transform size
+//  _h      :   butterfly span (quarter block size)
+//  _w      :   twiddle factors { u^1, u^2, u^3 } [size: 3*_h x 1]
+//  _dir    :   transform direction
+void FFT(_radix2_pass4)(TC *         _y,
+                        unsigned int _n,
+                        unsigned int _h,
+                        TC *         _w,
+                        int          _dir)
+{
+    T s = (_dir == LIQUID_FFT_FORWARD) ? 1 : -1;
+    TC * w1 = _w;
+    TC * w2 = _w +   _h;
+    TC * w3 = _w + 2*_h;
+
+    unsigned int j, k;
+    for (k=0; k<_n; k+=4*_h) {
+        T * y0 = (T*)(_y + k);
+        T * y1 = (T*)(_y + k +   _h);
+        T * y2 = (T*)(_y + k + 2*_h);
+        T * y3 = (T*)(_y + k + 3*_h);
+        for (j=0; j<_h; j++) {
+            T wr, wi, vr, vi;
+            T ar = y0[2*j], ai = y0[2*j+1];
+
+            // B = u * y2
+            wr = crealf(w1[j]); wi = cimagf(w1[j]);
+            vr = y2[2*j];       vi = y2[2*j+1];
+            T br = vr*wr - vi*wi, bi = vr*wi + vi*wr;
+
+            // C = u^2 * y1
+            wr = crealf(w2[j]); wi = cimagf(w2[j]);
+            vr = y1[2*j];       vi = y1[2*j+1];
+            T cr = vr*wr - vi*wi, ci = vr*wi + vi*wr;
+
+            // D = u^3 * y3
+            wr = crealf(w3[j]); wi = cimagf(w3[j]);
+            vr = y3[2*j];       vi = y3[2*j+1];
+            T dr = vr*wr - vi*wi, di = vr*wi + vi*wr;
+
+            T t0r = ar + cr, t0i = ai + ci;
+            T t1r = ar - cr, t1i = ai - ci;
+            T t2r = br + dr, t2i = bi + di;
+            T t3r = s*(bi - di), t3i = -s*(br - dr);   // W_4 (B - D)
+
+            y0[2*j] = t0r + t2r;    y0[2*j+1] = t0i + t2i;
+            y1[2*j] = t1r + t3r;    y1[2*j+1] = t1i + t3i;
+            y2[2*j] = t0r - t2r;    y2[2*j+1] = t0i - t2i;
+            y3[2*j] = t1r - t3r;    y3[2*j+1] = t1i - t3i;
         }
     }
 }
 
+#if HAVE_SSE3 && HAVE_PMMINTRIN_H
+// complex multiply, two interleaved values per register
+static inline __m128 FFT(_cmul_sse)(__m128 _a, __m128 _w)
+{
+    __m128 wr = _mm_moveldup_ps(_w);
+    __m128 wi = _mm_movehdup_ps(_w);
+    __m128 as = _mm_shuffle_ps(_a, _a, _MM_SHUFFLE(2,3,0,1));
+    return _mm_addsub_ps(_mm_mul_ps(_a, wr), _mm_mul_ps(as, wi));
+}
+
+// radix-4 decimation-in-time butterfly pass (SSE3), two butterflies
+// at a time; see FFT(_radix2_pass4) for a description of arguments
+void FFT(_radix2_pass4_sse)(TC *         _y,
+                            unsigned int _n,
+                            unsigned int _h,
+                            TC *         _w,
+                            int          _dir)
+{
+    // multiplication by W_4 = -/+j : swap components, negate one
+    __m128 sign = (_dir == LIQUID_FFT_FORWARD) ?
+                  _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f) :
+                  _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+
+    float * w1 = (float*)(_w);
+    float * w2 = (float*)(_w +   _h);
+    float * w3 = (float*)(_w + 2*_h);
+
+    unsigned int j, k;
+    for (k=0; k<_n; k+=4*_h) {
+        float * y0 = (float*)(_y + k);
+        float * y1 = (float*)(_y + k +   _h);
+        float * y2 = (float*)(_y + k + 2*_h);
+        float * y3 = (float*)(_y + k + 3*_h);
+        for (j=0; j<2*_h; j+=4) {
+            __m128 a = _mm_loadu_ps(&y0[j]);
+            __m128 b = FFT(_cmul_sse)(_mm_loadu_ps(&y2[j]), _mm_loadu_ps(&w1[j]));
+            __m128 c = FFT(_cmul_sse)(_mm_loadu_ps(&y1[j]), _mm_loadu_ps(&w2[j]));
+            __m128 d = FFT(_cmul_sse)(_mm_loadu_ps(&y3[j]), _mm_loadu_ps(&w3[j]));
+
+            __m128 t0 = _mm_add_ps(a, c);
+            __m128 t1 = _mm_sub_ps(a, c);
+            __m128 t2 = _mm_add_ps(b, d);
+            __m128 t3 = _mm_sub_ps(b, d);
+            t3 = _mm_xor_ps(_mm_shuffle_ps(t3, t3, _MM_SHUFFLE(2,3,0,1)), sign);
+
+            _mm_storeu_ps(&y0[j], _mm_add_ps(t0, t2));
+            _mm_storeu_ps(&y1[j], _mm_add_ps(t1, t3));
+            _mm_storeu_ps(&y2[j], _mm_sub_ps(t0, t2));
+            _mm_storeu_ps(&y3[j], _mm_sub_ps(t1, t3));
+        }
+    }
+}
+#endif
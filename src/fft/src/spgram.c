@@ -44,8 +44,9 @@ struct SPGRAM(_s) {
     int             accumulate;     // accumulate? or use time-average
 
     WINDOW()        buffer;         // input buffer
-    TC *            buf_time;       // pointer to input array (allocated)
+    TI *            buf_time;       // pointer to input array (allocated)
     TC *            buf_freq;       // output fft (allocated)
+    unsigned int    nfreq;          // number of computed frequency bins
     T  *            w;              // tapering window [size: window_len x 1]
     FFT_PLAN        fft;            // FFT plan
 
@@ -112,11 +113,21 @@ SPGRAM() SPGRAM(_create)(unsigned int _nfft,
     // set object for full accumulation
     SPGRAM(_set_alpha)(q, -1.0f);
 
-    // create FFT arrays, object
-    q->buf_time = (TC*) malloc((q->nfft)*sizeof(TC));
-    q->buf_freq = (TC*) malloc((q->nfft)*sizeof(TC));
-    q->psd      = (T *) malloc((q->nfft)*sizeof(T ));
+    // create FFT arrays, object; real input only needs the
+    // non-negative half of the (Hermitian) spectrum
+#if TI_COMPLEX
+    q->nfreq    = q->nfft;
+#else
+    q->nfreq    = q->nfft/2 + 1;
+#endif
+    q->buf_time = (TI*) malloc((q->nfft) *sizeof(TI));
+    q->buf_freq = (TC*) malloc((q->nfreq)*sizeof(TC));
+    q->psd      = (T *) malloc((q->nfft) *sizeof(T ));
+#if TI_COMPLEX
     q->fft      = FFT_CREATE_PLAN(q->nfft, q->buf_time, q->buf_freq, FFT_DIR_FORWARD, FFT_METHOD);
+#else
+    q->fft      = FFT_CREATE_PLAN_R2C(q->nfft, q->buf_time, q->buf_freq, FFT_METHOD);
+#endif
 
     // create buffer
     q->buffer = WINDOW(_create)(q->window_len);
@@ -386,7 +397,7 @@ void SPGRAM(_step)(SPGRAM() _q)
 
     // accumulate output
     // TODO: vectorize this operation
-    for (i=0; i<_q->nfft; i++) {
+    for (i=0; i<_q->nfreq; i++) {
         T v = crealf( _q->buf_freq[i] * conjf(_q->buf_freq[i]) );
         if (_q->num_transforms == 0)
             _q->psd[i] = v;
@@ -394,6 +405,10 @@ void SPGRAM(_step)(SPGRAM() _q)
             _q->psd[i] = _q->gamma*_q->psd[i] + _q->alpha*v;
     }
 
+    // mirror negative frequencies (real input only)
+    for (i=_q->nfreq; i<_q->nfft; i++)
+        _q->psd[i] = _q->psd[_q->nfft - i];
+
     _q->num_transforms++;
     _q->num_transforms_total++;
 }
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+#include "fft_runtest.h"
+
+// plans sharing cached tables must remain valid when other plans of
+// the same size are destroyed and the cache is purged
+//  _n      :   fft size
+void fft_cache_test_shared(unsigned int _n)
+{
+    float tol = 1e-4f * _n;
+    float complex x[_n], y0[_n], y1[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // reference
+    fftplan q0 = fft_create_plan(_n, x, y0, LIQUID_FFT_FORWARD, 0);
+    fft_execute(q0);
+
+    // second plan shares tables with first
+    fftplan q1 = fft_create_plan(_n, x, y1, LIQUID_FFT_FORWARD, 0);
+    fft_destroy_plan(q0);
+    fft_cache_purge();
+    fft_execute(q1);
+    fft_destroy_plan(q1);
+    for (i=0; i<_n; i++)
+        CONTEND_DELTA( cabsf(y1[i] - y0[i]), 0, tol );
+
+    // new plan after all tables are purged
+    fft_cache_purge();
+    q1 = fft_create_plan(_n, x, y1, LIQUID_FFT_FORWARD, 0);
+    fft_execute(q1);
+    fft_destroy_plan(q1);
+    for (i=0; i<_n; i++)
+        CONTEND_DELTA( cabsf(y1[i] - y0[i]), 0, tol );
+}
+
+void autotest_fft_cache_shared_n64()  { fft_cache_test_shared(  64); }
+void autotest_fft_cache_shared_n100() { fft_cache_test_shared( 100); }
+void autotest_fft_cache_shared_n13()  { fft_cache_test_shared(  13); }
+void autotest_fft_cache_shared_n157() { fft_cache_test_shared( 157); }
+void autotest_fft_cache_shared_n317() { fft_cache_test_shared( 317); }
+
+// plans using measured wisdom, before and after export/import
+void autotest_fft_cache_wisdom()
+{
+    const char * filename = "fft_cache_autotest_wisdom.txt";
+    unsigned int sizes[] = {20, 64, 97, 120, 127, 1024};
+    unsigned int num_sizes = sizeof(sizes)/sizeof(unsigned int);
+    unsigned int i;
+
+    // measure methods for each size; check results
+    fft_wisdom_forget();
+    for (i=0; i<num_sizes; i++) {
+        float complex x[sizes[i]], y[sizes[i]];
+        fftplan q = fft_create_plan(sizes[i], x, y, LIQUID_FFT_FORWARD, LIQUID_FFT_MEASURE);
+        fft_destroy_plan(q);
+        fft_test_dft(sizes[i]);
+    }
+
+    // export, forget, and import again
+    CONTEND_EQUALITY( fft_wisdom_export(filename), 0 );
+    fft_wisdom_forget();
+    CONTEND_EQUALITY( fft_wisdom_import(filename), 0 );
+    for (i=0; i<num_sizes; i++)
+        fft_test_dft(sizes[i]);
+
+    // invalid entries are rejected
+    FILE * fid = fopen(filename,"w");
+    fprintf(fid,"# invalid wisdom\n");
+    fprintf(fid,"64 radix3\n");
+    fclose(fid);
+    CONTEND_EQUALITY( fft_wisdom_import(filename), -1 );
+    CONTEND_EQUALITY( fft_wisdom_import("fft_cache_autotest_missing.txt"), -1 );
+
+    // wisdom not valid for size is ignored
+    fid = fopen(filename,"w");
+    fprintf(fid,"100 radix2\n");
+    fprintf(fid,"101 mixed-radix\n");
+    fclose(fid);
+    CONTEND_EQUALITY( fft_wisdom_import(filename), 0 );
+    fft_test_dft(100);
+    fft_test_dft(101);
+
+    fft_wisdom_forget();
+    remove(filename);
+}
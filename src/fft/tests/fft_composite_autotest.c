@@ -51,3 +51,11 @@ void autotest_fft_120() { fft_test( fft_test_x120,  fft_test_y120, 120); }
 void autotest_fft_130() { fft_test( fft_test_x130,  fft_test_y130, 130); }
 void autotest_fft_192() { fft_test( fft_test_x192,  fft_test_y192, 192); }
 
+// larger composite transforms: power of two with small odd factor,
+// and lengths above the four-step threshold
+void autotest_fft_1536()    { fft_test_dft(  1536); }
+void autotest_fft_2560()    { fft_test_dft(  2560); }
+void autotest_fft_3600()    { fft_test_dft(  3600); }
+void autotest_fft_4224()    { fft_test_dft(  4224); }
+void autotest_fft_49152()   { fft_test_dft( 49152); }
+void autotest_fft_100000()  { fft_test_dft(100000); }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare batched transforms against individual plans
+//  _n          :   transform size
+//  _howmany    :   number of transforms
+//  _interleave :   interleaved layout (stride=_howmany, dist=1) if set,
+//                  contiguous (stride=1, dist=_n) otherwise
+//  _in_place   :   run batch in place
+//  _dir        :   transform direction
+void fft_many_test(unsigned int _n,
+                   unsigned int _howmany,
+                   int          _interleave,
+                   int          _in_place,
+                   int          _dir)
+{
+    float tol = 2e-5f * _n;
+    unsigned int num = _n * _howmany;
+    float complex * x = (float complex*) malloc(num*sizeof(float complex));
+    float complex * y = (float complex*) malloc(num*sizeof(float complex));
+    float complex * t = (float complex*) malloc(_n *sizeof(float complex));
+    float complex * v = (float complex*) malloc(_n *sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<num; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    unsigned int stride = _interleave ? _howmany : 1;
+    unsigned int dist   = _interleave ? 1        : _n;
+
+    // run batch
+    if (_in_place)
+        memmove(y, x, num*sizeof(float complex));
+    fftplan q = fft_create_plan_many(_n, _howmany,
+                                     _in_place ? y : x, stride, dist,
+                                     y,                 stride, dist,
+                                     _dir, 0);
+    fft_execute(q);
+    fft_destroy_plan(q);
+
+    // compare against individual transforms
+    unsigned int b, k;
+    for (b=0; b<_howmany; b++) {
+        for (k=0; k<_n; k++)
+            t[k] = x[b*dist + k*stride];
+        fft_run(_n, t, v, _dir, 0);
+        for (k=0; k<_n; k++)
+            CONTEND_DELTA( cabsf(y[b*dist + k*stride] - v[k]), 0, tol );
+    }
+
+    free(x);
+    free(y);
+    free(t);
+    free(v);
+}
+
+// transforms across lanes (short power-of-two lengths), including a
+// partial final group of lanes
+void autotest_fft_many_n16_b8()       { fft_many_test(  16,  8, 0, 0, LIQUID_FFT_FORWARD ); }
+void autotest_fft_many_n64_b13()      { fft_many_test(  64, 13, 0, 0, LIQUID_FFT_FORWARD ); }
+void autotest_fft_many_n256_b3()      { fft_many_test( 256,  3, 0, 0, LIQUID_FFT_BACKWARD); }
+void autotest_fft_many_n32_b20_il()   { fft_many_test(  32, 20, 1, 0, LIQUID_FFT_FORWARD ); }
+void autotest_fft_many_n128_b9_ip()   { fft_many_test( 128,  9, 0, 1, LIQUID_FFT_BACKWARD); }
+void autotest_fft_many_n256_b16_il()  { fft_many_test( 256, 16, 1, 1, LIQUID_FFT_FORWARD ); }
+
+// sub-transform on each input (other lengths)
+void autotest_fft_many_n2_b5()        { fft_many_test(   2,  5, 0, 0, LIQUID_FFT_FORWARD ); }
+void autotest_fft_many_n48_b7()       { fft_many_test(  48,  7, 0, 0, LIQUID_FFT_FORWARD ); }
+void autotest_fft_many_n60_b6_il()    { fft_many_test(  60,  6, 1, 0, LIQUID_FFT_BACKWARD); }
+void autotest_fft_many_n512_b4_il()   { fft_many_test( 512,  4, 1, 0, LIQUID_FFT_FORWARD ); }
+void autotest_fft_many_n1024_b4_ip()  { fft_many_test(1024,  4, 0, 1, LIQUID_FFT_FORWARD ); }
+
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare real-to-complex and complex-to-real transforms against
+// regular complex transforms
+//  _n      :   transform size
+void fft_r2c_test(unsigned int _n)
+{
+    float tol = 2e-5f * _n;
+    float *         x = (float*)         malloc(_n*sizeof(float));
+    float *         y = (float*)         malloc(_n*sizeof(float));
+    float complex * X = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * z = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * Z = (float complex*) malloc(_n*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        x[i] = randnf();
+        z[i] = x[i];
+    }
+
+    // forward: real input, non-negative half of spectrum
+    fftplan q = fft_create_plan_r2c(_n, x, X, 0);
+    fft_execute(q);
+    fft_destroy_plan(q);
+    fft_run(_n, z, Z, LIQUID_FFT_FORWARD, 0);
+    for (i=0; i<=_n/2; i++)
+        CONTEND_DELTA( cabsf(X[i] - Z[i]), 0, tol );
+
+    // inverse: back to (scaled) real sequence
+    q = fft_create_plan_c2r(_n, X, y, 0);
+    fft_execute(q);
+    fft_destroy_plan(q);
+    for (i=0; i<_n; i++)
+        CONTEND_DELTA( y[i] / (float)_n, x[i], tol );
+
+    free(x);
+    free(y);
+    free(X);
+    free(z);
+    free(Z);
+}
+
+// even lengths (half-length complex transform)
+void autotest_fft_r2c_n2()      { fft_r2c_test(   2); }
+void autotest_fft_r2c_n4()      { fft_r2c_test(   4); }
+void autotest_fft_r2c_n6()      { fft_r2c_test(   6); }
+void autotest_fft_r2c_n64()     { fft_r2c_test(  64); }
+void autotest_fft_r2c_n100()    { fft_r2c_test( 100); }
+void autotest_fft_r2c_n1024()   { fft_r2c_test(1024); }
+
+// odd lengths (full-length complex transform)
+void autotest_fft_r2c_n3()      { fft_r2c_test(   3); }
+void autotest_fft_r2c_n15()     { fft_r2c_test(  15); }
+void autotest_fft_r2c_n127()    { fft_r2c_test( 127); }
+
@@ -40,3 +40,9 @@ void autotest_fft_16()      { fft_test( fft_test_x16,  fft_test_y16,     16);
 void autotest_fft_32()      { fft_test( fft_test_x32,  fft_test_y32,     32);    }
 void autotest_fft_64()      { fft_test( fft_test_x64,  fft_test_y64,     64);    }
 
+// compare larger power-of-two transforms (odd and even log2 sizes)
+// to a direct DFT
+void autotest_fft_radix2_128()  { fft_test_dft(  128); }
+void autotest_fft_radix2_512()  { fft_test_dft(  512); }
+void autotest_fft_radix2_1024() { fft_test_dft( 1024); }
+void autotest_fft_radix2_2048() { fft_test_dft( 2048); }
@@ -20,6 +20,9 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -64,3 +67,53 @@ void fft_test(float complex * _x,
     fft_destroy_plan(pr);
 }
 
+// autotest helper function: compare against direct DFT
+//  _n      :   fft size
+void fft_test_dft(unsigned int _n)
+{
+    float tol = 1e-4f * sqrtf((float)_n);
+    float complex * x = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * y = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * z = (float complex*) malloc(_n*sizeof(float complex));
+    double complex * w = (double complex*) malloc(_n*sizeof(double complex));
+    unsigned int i, k;
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // output bins to check
+    unsigned int step = 1 + _n / 512;
+
+    int dir;
+    for (dir=0; dir<2; dir++) {
+        int fft_dir = dir ? LIQUID_FFT_BACKWARD : LIQUID_FFT_FORWARD;
+        for (i=0; i<_n; i++)
+            w[i] = cexp(_Complex_I*(dir ? 1.0 : -1.0)*2*M_PI*(double)i/(double)_n);
+
+        // out-of-place
+        fftplan q = fft_create_plan(_n, x, y, fft_dir, 0);
+        fft_execute(q);
+        fft_destroy_plan(q);
+
+        // in-place
+        memmove(z, x, _n*sizeof(float complex));
+        q = fft_create_plan(_n, z, z, fft_dir, 0);
+        fft_execute(q);
+        fft_destroy_plan(q);
+
+        for (k=0; k<_n; k+=step) {
+            double complex v = 0;
+            unsigned long int p = 0;
+            for (i=0; i<_n; i++) {
+                v += x[i] * w[p];
+                p = (p + k) % _n;
+            }
+            CONTEND_DELTA( cabs(y[k] - v), 0, tol );
+            CONTEND_DELTA( cabs(z[k] - v), 0, tol );
+        }
+    }
+
+    free(x);
+    free(y);
+    free(z);
+    free(w);
+}
@@ -35,6 +35,13 @@ void fft_test(float complex * _x,
               float complex * _test,
               unsigned int    _n);
 
+// autotest helper function: compare transform of random data against
+// a direct DFT computed in double precision, for both directions and
+// both in- and out-of-place execution; for long transforms only a
+// subset of output bins is checked
+//  _n      :   fft size
+void fft_test_dft(unsigned int _n);
+
 // 
 // autotest datasets
 //
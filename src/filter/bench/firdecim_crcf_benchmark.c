@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include <sys/resource.h>
 #include "liquid.h"
 
@@ -62,6 +63,42 @@ void firdecim_crcf_bench(struct rusage *     _start,
     firdecim_crcf_destroy(q);
 }
 
+// Helper function: block execution, 64 outputs per call
+void firdecim_crcf_block_bench(struct rusage *     _start,
+                               struct rusage *     _finish,
+                               unsigned long int * _num_iterations,
+                               unsigned int        _M,
+                               unsigned int        _h_len)
+{
+    // normalize number of iterations
+    *_num_iterations /= _h_len;
+    if (*_num_iterations < 64) *_num_iterations = 64;
+
+    float h[_h_len];
+    unsigned int i;
+    for (i=0; i<_h_len; i++)
+        h[i] = 1.0f;
+
+    firdecim_crcf q = firdecim_crcf_create(_M,h,_h_len);
+
+    // initialize input
+    unsigned int n = 64;
+    float complex * x = (float complex*) malloc(n*_M*sizeof(float complex));
+    float complex y[n];
+    for (i=0; i<n*_M; i++)
+        x[i] = (i%2) ? 1.0f : -1.0f;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations)/n; i++)
+        firdecim_crcf_execute_block(q, x, n, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = i*n;
+
+    firdecim_crcf_destroy(q);
+    free(x);
+}
+
 #define FIRDECIM_CRCF_BENCHMARK_API(M,H_LEN)    \
 (   struct rusage *_start,                      \
     struct rusage *_finish,                     \
@@ -73,4 +110,19 @@ void benchmark_firdecim_crcf_m4_h16    FIRDECIM_CRCF_BENCHMARK_API(4, 16)
 void benchmark_firdecim_crcf_m8_h32    FIRDECIM_CRCF_BENCHMARK_API(8, 32)
 void benchmark_firdecim_crcf_m16_h64   FIRDECIM_CRCF_BENCHMARK_API(16,64)
 void benchmark_firdecim_cccf_m32_h128  FIRDECIM_CRCF_BENCHMARK_API(32,128)
+void benchmark_firdecim_crcf_m8_h113   FIRDECIM_CRCF_BENCHMARK_API( 8,113)
+void benchmark_firdecim_crcf_m16_h225  FIRDECIM_CRCF_BENCHMARK_API(16,225)
+void benchmark_firdecim_crcf_m32_h449  FIRDECIM_CRCF_BENCHMARK_API(32,449)
+void benchmark_firdecim_crcf_m64_h897  FIRDECIM_CRCF_BENCHMARK_API(64,897)
+
+
+#define FIRDECIM_CRCF_BLOCK_BENCHMARK_API(M,H_LEN)  \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ firdecim_crcf_block_bench(_start, _finish, _num_iterations, M, H_LEN); }
 
+void benchmark_firdecim_crcf_block_m8_h113   FIRDECIM_CRCF_BLOCK_BENCHMARK_API( 8, 113)
+void benchmark_firdecim_crcf_block_m16_h225  FIRDECIM_CRCF_BLOCK_BENCHMARK_API(16, 225)
+void benchmark_firdecim_crcf_block_m32_h449  FIRDECIM_CRCF_BLOCK_BENCHMARK_API(32, 449)
+void benchmark_firdecim_crcf_block_m64_h897  FIRDECIM_CRCF_BLOCK_BENCHMARK_API(64, 897)
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include <sys/resource.h>
 #include "liquid.h"
 
@@ -57,6 +58,42 @@ void firinterp_crcf_bench(struct rusage *_start,
     firinterp_crcf_destroy(q);
 }
 
+// Helper function: block execution, 64 inputs per call
+void firinterp_crcf_block_bench(struct rusage *_start,
+                                struct rusage *_finish,
+                                unsigned long int *_num_iterations,
+                                unsigned int _M,
+                                unsigned int _h_len)
+{
+    // normalize number of iterations
+    *_num_iterations *= 80;
+    *_num_iterations /= _h_len;
+    if (*_num_iterations < 64) *_num_iterations = 64;
+
+    float h[_h_len];
+    unsigned int i;
+    for (i=0; i<_h_len; i++)
+        h[i] = 1.0f;
+
+    firinterp_crcf q = firinterp_crcf_create(_M,h,_h_len);
+
+    unsigned int n = 64;
+    float complex x[n];
+    float complex * y = (float complex*) malloc(n*_M*sizeof(float complex));
+    for (i=0; i<n; i++)
+        x[i] = (i%2) ? 1.0f : -1.0f;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations)/n; i++)
+        firinterp_crcf_execute_block(q,x,n,y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = i*n;
+
+    firinterp_crcf_destroy(q);
+    free(y);
+}
+
 #define FIRINTERP_CRCF_BENCHMARK_API(M,H_LEN)  \
 (   struct rusage *_start,                  \
     struct rusage *_finish,                 \
@@ -69,3 +106,15 @@ void benchmark_firinterp_crcf_m8_h32   FIRINTERP_CRCF_BENCHMARK_API(8, 32)
 void benchmark_firinterp_crcf_m16_h64  FIRINTERP_CRCF_BENCHMARK_API(16,64)
 void benchmark_firinterp_crcf_m32_h128 FIRINTERP_CRCF_BENCHMARK_API(32,128)
 
+
+#define FIRINTERP_CRCF_BLOCK_BENCHMARK_API(M,H_LEN) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ firinterp_crcf_block_bench(_start, _finish, _num_iterations, M, H_LEN); }
+
+void benchmark_firinterp_crcf_block_m2_h8    FIRINTERP_CRCF_BLOCK_BENCHMARK_API(2, 8)
+void benchmark_firinterp_crcf_block_m4_h16   FIRINTERP_CRCF_BLOCK_BENCHMARK_API(4, 16)
+void benchmark_firinterp_crcf_block_m8_h32   FIRINTERP_CRCF_BLOCK_BENCHMARK_API(8, 32)
+void benchmark_firinterp_crcf_block_m16_h64  FIRINTERP_CRCF_BLOCK_BENCHMARK_API(16,64)
+void benchmark_firinterp_crcf_block_m32_h128 FIRINTERP_CRCF_BLOCK_BENCHMARK_API(32,128)
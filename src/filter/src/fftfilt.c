@@ -36,19 +36,29 @@
 //  DOTPROD()       dotprod macro
 //  PRINTVAL()      print macro
 
+// filters with real input, output, and coefficients use real-input
+// transforms and keep only the non-negative half of the spectrum
+#define FFTFILT_REAL (!TI_COMPLEX && !TO_COMPLEX && !TC_COMPLEX)
+
+// time-domain buffer type
+#if FFTFILT_REAL
+#  define FFTFILT_TB float
+#else
+#  define FFTFILT_TB float complex
+#endif
+
 // fftfilt object structure
 struct FFTFILT(_s) {
     TC * h;             // filter coefficients array [size; h_len x 1]
     unsigned int h_len; // filter length
     unsigned int n;     // input/output block size
+    unsigned int nfreq; // number of frequency bins: 2*n (complex), n+1 (real)
 
     // internal memory arrays
-    // TODO: make TI/TO type, but ensuring complex
-    // TODO: use special format for fftfilt_rrrf type
-    float complex * time_buf;   // time buffer [size: 2*n x 1]
-    float complex * freq_buf;   // freq buffer [size: 2*n x 1]
-    float complex * H;          // FFT of filter coefficients [size: 2*n x 1]
-    float complex * w;          // overlap array [size: n x 1]
+    FFTFILT_TB *    time_buf;   // time buffer [size: 2*n x 1]
+    float complex * freq_buf;   // freq buffer [size: nfreq x 1]
+    float complex * H;          // FFT of filter coefficients [size: nfreq x 1]
+    FFTFILT_TB *    w;          // overlap array [size: n x 1]
 
     // FFT objects
 #ifdef LIQUID_FFTOVERRIDE
@@ -92,13 +102,21 @@ FFTFILT() FFTFILT(_create)(TC *         _h,
     memmove(q->h, _h, _h_len*sizeof(TC));
 
     // allocate internal memory arrays
-    q->time_buf = (float complex *) malloc((2*q->n)* sizeof(float complex)); // time buffer
-    q->freq_buf = (float complex *) malloc((2*q->n)* sizeof(float complex)); // frequency buffer
-    q->H        = (float complex *) malloc((2*q->n)* sizeof(float complex)); // FFT{ h }
-    q->w        = (float complex *) malloc((  q->n)* sizeof(float complex)); // delay buffer
+#if FFTFILT_REAL
+    q->nfreq    = q->n + 1;
+#else
+    q->nfreq    = 2*q->n;
+#endif
+    q->time_buf = (FFTFILT_TB *)    malloc((2*q->n)  * sizeof(FFTFILT_TB));    // time buffer
+    q->freq_buf = (float complex *) malloc((q->nfreq)* sizeof(float complex)); // frequency buffer
+    q->H        = (float complex *) malloc((q->nfreq)* sizeof(float complex)); // FFT{ h }
+    q->w        = (FFTFILT_TB *)    malloc((  q->n)  * sizeof(FFTFILT_TB));    // delay buffer
 
     // create internal FFT objects
-#ifdef LIQUID_FFTOVERRIDE
+#if FFTFILT_REAL
+    q->fft  = FFT_CREATE_PLAN_R2C(2*q->n, q->time_buf, q->freq_buf, FFT_METHOD);
+    q->ifft = FFT_CREATE_PLAN_C2R(2*q->n, q->freq_buf, q->time_buf, FFT_METHOD);
+#elif defined LIQUID_FFTOVERRIDE
     q->fft  = fft_create_plan(2*q->n, q->time_buf, q->freq_buf, LIQUID_FFT_FORWARD,  0);
     q->ifft = fft_create_plan(2*q->n, q->freq_buf, q->time_buf, LIQUID_FFT_BACKWARD, 0);
 #else
@@ -116,7 +134,7 @@ FFTFILT() FFTFILT(_create)(TC *         _h,
 #else
     FFT_EXECUTE(q->fft);
 #endif
-    memmove(q->H, q->freq_buf, 2*q->n*sizeof(float complex));
+    memmove(q->H, q->freq_buf, q->nfreq*sizeof(float complex));
 
     // set default scaling
     FFTFILT(_set_scale)(q, 1);
@@ -231,19 +249,7 @@ void FFTFILT(_execute)(FFTFILT() _q,
 #endif
 
     // compute inner product between FFT{ _x } and FFT{ H }
-#if 1
-    for (i=0; i<2*_q->n; i++)
-        _q->freq_buf[i] *= _q->H[i];
-#else
-    // use SIMD vector extensions
-# if TI_COMPLEX
-    // complex floating-point inner product
-    liquid_vectorcf_mul(_q->freq_buf, _q->H, 2*_q->n, _q->freq_buf);
-# else
-    // real floating-point inner product
-    liquid_vectorf_mul(_q->freq_buf, _q->H, 2*_q->n, _q->freq_buf);
-# endif
-#endif
+    liquid_vectorcf_mul(_q->freq_buf, _q->H, _q->nfreq, _q->freq_buf);
 
     // compute inverse transform
 #ifdef LIQUID_FFTOVERRIDE
@@ -253,7 +259,7 @@ void FFTFILT(_execute)(FFTFILT() _q,
 #endif
 
     // copy output summed with buffer and scaled
-#if TI_COMPLEX
+#if TI_COMPLEX || FFTFILT_REAL
     for (i=0; i<_q->n; i++)
         _y[i] = (_q->time_buf[i] + _q->w[i]) * _q->scale;
 #else
@@ -264,7 +270,7 @@ void FFTFILT(_execute)(FFTFILT() _q,
 #endif
 
     // copy buffer
-    memmove(_q->w, &_q->time_buf[_q->n], _q->n*sizeof(float complex));
+    memmove(_q->w, &_q->time_buf[_q->n], _q->n*sizeof(FFTFILT_TB));
 }
 
 // return length of filter object's internal coefficients
@@ -30,6 +30,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+// maximum number of output samples computed per pass of the polyphase
+// sub-filters in FIRDECIM(_execute_block)
+#define LIQUID_FIRDECIM_BLOCK_LEN   (64)
+
 // decimator structure
 struct FIRDECIM(_s) {
     TC *            h;      // coefficients array
@@ -39,8 +43,18 @@ struct FIRDECIM(_s) {
     WINDOW()        w;      // buffer
     DOTPROD()       dp;     // vector dot product
     TC              scale;  // output scaling factor
+
+    // polyphase decomposition for block processing (created on first use)
+    unsigned int    L;      // sub-filter length, ceil(h_len/M)
+    unsigned int    P;      // number of non-empty sub-filters, min(M,h_len)
+    DOTPROD() *     dpp;    // sub-filter dot products [size: P x 1]
+    TI *            b;      // sub-filter staging buffers [size: P*(L-1+BLOCK_LEN) x 1]
+    TO *            t;      // partial outputs [size: BLOCK_LEN x 1]
 };
 
+// create polyphase sub-filters and staging buffers
+void FIRDECIM(_create_polyphase)(FIRDECIM() _q);
+
 // create decimator object
 //  _M      :   decimation factor
 //  _h      :   filter coefficients [size: _h_len x 1]
@@ -79,6 +93,13 @@ FIRDECIM() FIRDECIM(_create)(unsigned int _M,
     // set default scaling
     q->scale = 1;
 
+    // polyphase sub-filters are only created when needed
+    q->L   = 1 + (q->h_len - 1) / q->M;
+    q->P   = q->M < q->h_len ? q->M : q->h_len;
+    q->dpp = NULL;
+    q->b   = NULL;
+    q->t   = NULL;
+
     // reset filter state (clear buffer)
     FIRDECIM(_reset)(q);
 
@@ -168,6 +189,14 @@ void FIRDECIM(_destroy)(FIRDECIM() _q)
 {
     WINDOW(_destroy)(_q->w);
     DOTPROD(_destroy)(_q->dp);
+    if (_q->dpp != NULL) {
+        unsigned int p;
+        for (p=0; p<_q->P; p++)
+            DOTPROD(_destroy)(_q->dpp[p]);
+        free(_q->dpp);
+        free(_q->b);
+        free(_q->t);
+    }
     free(_q->h);
     free(_q);
 }
@@ -244,10 +273,92 @@ void FIRDECIM(_execute_block)(FIRDECIM()   _q,
                               unsigned int _n,
                               TO *         _y)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
-        // execute _M input samples computing just one output each time
-        FIRDECIM(_execute)(_q, &_x[i*_q->M], &_y[i]);
+    if (_n == 0)
+        return;
+
+    if (_q->dpp == NULL)
+        FIRDECIM(_create_polyphase)(_q);
+
+    // Output k is y[k] = sum_p sum_j h[p+j*M] x[k*M-p-j*M], so phase p
+    // is a regular filter of length L over the sub-sampled sequence
+    // u_p[k] = x[k*M-p]. Each phase is staged contiguously behind its
+    // last L-1 samples and filtered with the block dot product.
+    unsigned int M      = _q->M;
+    unsigned int h      = _q->L - 1;
+    unsigned int stride = h + LIQUID_FIRDECIM_BLOCK_LEN;
+    unsigned int p, i;
+
+    // stage sub-filter history from the window; its newest sample is
+    // x[-1] relative to this block, and samples older than the window
+    // only meet zero-valued coefficients
+    TI * r;
+    WINDOW(_read)(_q->w, &r);
+    for (p=0; p<_q->P; p++) {
+        TI * b = _q->b + p*stride;
+        for (i=0; i<h+1; i++) {
+            // b[i] = x[-e], e = p + (h-i)*M
+            unsigned int e = p + (h-i)*M;
+            if (e == 0)
+                continue;   // x[0] is staged with the input below
+            b[i] = e <= _q->h_len ? r[_q->h_len - e] : 0;
+        }
+    }
+
+    // update window with the most recent samples before any output is
+    // written (_x and _y may alias)
+    unsigned int nx = _n*M;
+    if (nx > _q->h_len)
+        WINDOW(_write)(_q->w, &_x[nx - _q->h_len], _q->h_len);
+    else
+        WINDOW(_write)(_q->w, _x, nx);
+
+    unsigned int n = 0;
+    unsigned int m = 0;
+    while (n < _n) {
+        // stage input for all phases, retaining the last L-1 samples of
+        // the previous pass; inputs read here are never at an index
+        // below n, so outputs written so far cannot have overwritten them
+        unsigned int m_prev = m;
+        m = _n - n < LIQUID_FIRDECIM_BLOCK_LEN ? _n - n : LIQUID_FIRDECIM_BLOCK_LEN;
+        for (p=0; p<_q->P; p++) {
+            TI * b = _q->b + p*stride;
+            if (n > 0)
+                memmove(b, b + m_prev, h*sizeof(TI));
+            for (i=(n == 0 && p > 0) ? 1 : 0; i<m; i++)
+                b[h+i] = _x[(n+i)*M - p];
+        }
+
+        // accumulate sub-filter outputs and apply scaling factor
+        DOTPROD(_execute_block)(_q->dpp[0], _q->b, m, &_y[n]);
+        for (p=1; p<_q->P; p++) {
+            DOTPROD(_execute_block)(_q->dpp[p], _q->b + p*stride, m, _q->t);
+            for (i=0; i<m; i++)
+                _y[n+i] += _q->t[i];
+        }
+        for (i=0; i<m; i++)
+            _y[n+i] *= _q->scale;
+
+        n += m;
     }
 }
 
+// create polyphase sub-filters and staging buffers
+void FIRDECIM(_create_polyphase)(FIRDECIM() _q)
+{
+    unsigned int L = _q->L;
+    _q->dpp = (DOTPROD()*) malloc(_q->P*sizeof(DOTPROD()));
+    _q->b   = (TI*) malloc(_q->P*(L - 1 + LIQUID_FIRDECIM_BLOCK_LEN)*sizeof(TI));
+    _q->t   = (TO*) malloc(LIQUID_FIRDECIM_BLOCK_LEN*sizeof(TO));
+
+    // sub-filter p holds taps h[p], h[p+M], ... in reverse order,
+    // zero-padded at the front to length L
+    TC v[L];
+    unsigned int p, j;
+    for (p=0; p<_q->P; p++) {
+        for (j=0; j<L; j++) {
+            unsigned int k = p + j*_q->M;
+            v[L-j-1] = k < _q->h_len ? _q->h[_q->h_len-k-1] : 0;
+        }
+        _q->dpp[p] = DOTPROD(_create)(v, L);
+    }
+}
@@ -37,6 +37,10 @@
 
 #define LIQUID_FIRFILT_USE_WINDOW   (0)
 
+// maximum number of output samples computed per call to the block
+// dot product in FIRFILT(_execute_block)
+#define LIQUID_FIRFILT_BLOCK_LEN    (256)
+
 // firfilt object structure
 struct FIRFILT(_s) {
     TC * h;             // filter coefficients array [size; h_len x 1]
@@ -52,6 +56,7 @@ struct FIRFILT(_s) {
     unsigned int w_mask;    // window index mask
     unsigned int w_index;   // window read index
 #endif
+    TI * b;                 // block staging buffer [size: h_len-1+BLOCK_LEN x 1]
     DOTPROD() dp;           // dot product object
     TC scale;               // output scaling factor
 };
@@ -83,6 +88,7 @@ FIRFILT() FIRFILT(_create)(TC * _h,
     q->w       = (TI *) malloc((q->w_len + q->h_len + 1)*sizeof(TI));
     q->w_index = 0;
 #endif
+    q->b = (TI *) malloc((q->h_len - 1 + LIQUID_FIRFILT_BLOCK_LEN)*sizeof(TI));
 
     // load filter in reverse order
     unsigned int i;
@@ -328,6 +334,7 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT() _q,
         _q->w       = (TI *) malloc((_q->w_len + _q->h_len + 1)*sizeof(TI));
         _q->w_index = 0;
 #endif
+        _q->b = (TI *) realloc(_q->b, (_q->h_len - 1 + LIQUID_FIRFILT_BLOCK_LEN)*sizeof(TI));
     }
 
     // load filter in reverse order
@@ -349,6 +356,7 @@ void FIRFILT(_destroy)(FIRFILT() _q)
     free(_q->w);
 #endif
     DOTPROD(_destroy)(_q->dp);
+    free(_q->b);
     free(_q->h);
     free(_q);
 }
@@ -437,10 +445,16 @@ void FIRFILT(_write)(FIRFILT()    _q,
 #if LIQUID_FIRFILT_USE_WINDOW
     WINDOW(_write)(_q->w, _x, _n);
 #else
-    // TODO: be smarter about this
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        FIRFILT(_push)(_q, _x[i]);
+    if (_n < _q->h_len) {
+        unsigned int i;
+        for (i=0; i<_n; i++)
+            FIRFILT(_push)(_q, _x[i]);
+        return;
+    }
+
+    // entire window is replaced; copy most recent samples directly
+    memmove(_q->w, &_x[_n - _q->h_len], _q->h_len*sizeof(TI));
+    _q->w_index = 0;
 #endif
 }
 
@@ -477,6 +491,7 @@ void FIRFILT(_execute_block)(FIRFILT()    _q,
                              unsigned int _n,
                              TO *         _y)
 {
+#if LIQUID_FIRFILT_USE_WINDOW
     unsigned int i;
     for (i=0; i<_n; i++) {
         // push sample into filter
@@ -485,6 +500,38 @@ void FIRFILT(_execute_block)(FIRFILT()    _q,
         // compute output sample
         FIRFILT(_execute)(_q, &_y[i]);
     }
+#else
+    // stage the most recent h_len-1 samples of the window ahead of
+    // each block of input so the outputs can be computed together
+    unsigned int h = _q->h_len - 1;
+    memmove(_q->b, _q->w + _q->w_index + 1, h*sizeof(TI));
+
+    unsigned int i;
+    unsigned int n = 0;
+    unsigned int m = 0;
+    while (n < _n) {
+        // retain last h_len-1 samples of previous block
+        memmove(_q->b, _q->b + m, h*sizeof(TI));
+
+        m = _n - n < LIQUID_FIRFILT_BLOCK_LEN ? _n - n : LIQUID_FIRFILT_BLOCK_LEN;
+
+        // append input (read before output is written: _x and _y may alias)
+        memmove(_q->b + h, &_x[n], m*sizeof(TI));
+
+        // compute m output samples and apply scaling factor
+        DOTPROD(_execute_block)(_q->dp, _q->b, m, &_y[n]);
+        for (i=0; i<m; i++)
+            _y[n+i] *= _q->scale;
+
+        n += m;
+    }
+
+    // update window with the most recent h_len samples
+    if (_n > 0) {
+        memmove(_q->w, _q->b + m - 1, _q->h_len*sizeof(TI));
+        _q->w_index = 0;
+    }
+#endif
 }
 
 // get filter length
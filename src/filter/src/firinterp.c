@@ -256,10 +256,8 @@ void FIRINTERP(_execute)(FIRINTERP() _q,
     // push sample into filterbank
     FIRPFB(_push)(_q->filterbank,  _x);
 
-    // compute output for each filter in the bank
-    unsigned int i;
-    for (i=0; i<_q->M; i++)
-        FIRPFB(_execute)(_q->filterbank, i, &_y[i]);
+    // compute output for each filter in the bank in one pass
+    FIRPFB(_execute_all)(_q->filterbank, _y);
 }
 
 // execute interpolation on block of input samples
@@ -28,6 +28,10 @@
 #include <string.h>
 #include <stdlib.h>
 
+// maximum number of input samples staged per pass in
+// FIRPFB(_execute_schedule)
+#define LIQUID_FIRPFB_BLOCK_LEN     (64)
+
 struct FIRPFB(_s) {
     TC * h;                     // filter coefficients array
     unsigned int h_len;         // total number of filter coefficients
@@ -36,9 +40,18 @@ struct FIRPFB(_s) {
 
     WINDOW() w;                 // window buffer
     DOTPROD() * dp;             // array of vector dot product objects
+    DOTPROD() dpb;              // all filters as one bank, tap by tap
+    TI * b;                     // linear staging buffer for scheduled execution
     TC scale;                   // output scaling factor
 };
 
+// create (or re-create) bank dot product object with sub-filters
+// interleaved tap by tap: v[k*M + i] = h_sub_i[k] (reversed)
+DOTPROD() FIRPFB(_create_bank)(unsigned int _M,
+                               TC *         _h,
+                               unsigned int _h_sub_len,
+                               DOTPROD()    _dpb);
+
 // create firpfb from external coefficients
 //  _M      : number of filters in the bank
 //  _h      : coefficients [size: _M*_h_len x 1]
@@ -83,12 +96,18 @@ FIRPFB() FIRPFB(_create)(unsigned int _M,
         q->dp[i] = DOTPROD(_create)(h_sub,h_sub_len);
     }
 
+    // interleave sub-filters tap by tap for executing the whole bank
+    q->dpb = FIRPFB(_create_bank)(_M, _h, h_sub_len, NULL);
+
     // save sub-sampled filter length
     q->h_sub_len = h_sub_len;
 
     // create window buffer
     q->w = WINDOW(_create)(q->h_sub_len);
 
+    // staging buffer: window history followed by a block of input
+    q->b = (TI*) malloc((q->h_sub_len - 1 + LIQUID_FIRPFB_BLOCK_LEN)*sizeof(TI));
+
     // set default scaling
     q->scale = 1;
 
@@ -269,6 +288,7 @@ FIRPFB() FIRPFB(_recreate)(FIRPFB()     _q,
 
         _q->dp[i] = DOTPROD(_recreate)(_q->dp[i],h_sub,_q->h_sub_len);
     }
+    _q->dpb = FIRPFB(_create_bank)(_q->num_filters, _h, _q->h_sub_len, _q->dpb);
     return _q;
 }
 
@@ -279,7 +299,9 @@ void FIRPFB(_destroy)(FIRPFB() _q)
     for (i=0; i<_q->num_filters; i++)
         DOTPROD(_destroy)(_q->dp[i]);
     free(_q->dp);
+    DOTPROD(_destroy)(_q->dpb);
     WINDOW(_destroy)(_q->w);
+    free(_q->b);
     free(_q);
 }
 
@@ -351,6 +373,25 @@ void FIRPFB(_execute)(FIRPFB()     _q,
     *_y *= _q->scale;
 }
 
+// execute all filters on internal buffer in a single pass
+//  _q      : firpfb object
+//  _y      : output array [size: num_filters x 1]
+void FIRPFB(_execute_all)(FIRPFB() _q,
+                          TO *     _y)
+{
+    // read buffer
+    TI *r;
+    WINDOW(_read)(_q->w, &r);
+
+    // execute bank of dot products
+    DOTPROD(_execute_bank)(_q->dpb, r, _q->num_filters, _y);
+
+    // apply scaling factor
+    unsigned int i;
+    for (i=0; i<_q->num_filters; i++)
+        _y[i] *= _q->scale;
+}
+
 // execute the filter on a block of input samples; the
 // input and output buffers may be the same
 //  _q      : firpfb object
@@ -374,3 +415,92 @@ void FIRPFB(_execute_block)(FIRPFB()     _q,
     }
 }
 
+// execute the filter bank on a block of input samples, computing each
+// output with its own filter index at its own position in the block
+//  _q      : firpfb object
+//  _x      : input array [size: _nx x 1]
+//  _nx     : number of input samples
+//  _k      : input sample index of each output, non-decreasing [size: _ny x 1]
+//  _i      : filter index of each output [size: _ny x 1]
+//  _ny     : number of output samples
+//  _y      : output array, must not overlap _x [size: _ny x 1]
+void FIRPFB(_execute_schedule)(FIRPFB()       _q,
+                               TI *           _x,
+                               unsigned int   _nx,
+                               unsigned int * _k,
+                               unsigned int * _i,
+                               unsigned int   _ny,
+                               TO *           _y)
+{
+    // validate schedule
+    unsigned int j;
+    for (j=0; j<_ny; j++) {
+        if (_k[j] >= _nx || (j > 0 && _k[j] < _k[j-1])) {
+            fprintf(stderr,"error: firpfb_%s_execute_schedule(), invalid input index (%u) at output %u\n",
+                    EXTENSION_FULL, _k[j], j);
+            exit(1);
+        } else if (_i[j] >= _q->num_filters) {
+            fprintf(stderr,"error: firpfb_%s_execute_schedule(), filterbank index (%u) exceeds maximum (%u)\n",
+                    EXTENSION_FULL, _i[j], _q->num_filters);
+            exit(1);
+        }
+    }
+
+    if (_nx == 0)
+        return;
+
+    // Stage the input behind the last h_sub_len-1 samples of the window;
+    // the buffer contents after pushing input n then start at b[n-n0],
+    // where n0 is the first input of the current pass.
+    unsigned int h = _q->h_sub_len - 1;
+    TI * r;
+    WINDOW(_read)(_q->w, &r);
+    memmove(_q->b, r + 1, h*sizeof(TI));
+
+    unsigned int n = 0;
+    unsigned int m = 0;
+    j = 0;
+    while (n < _nx) {
+        // retain the last h samples of the previous pass
+        if (n > 0)
+            memmove(_q->b, _q->b + m, h*sizeof(TI));
+        m = _nx - n < LIQUID_FIRPFB_BLOCK_LEN ? _nx - n : LIQUID_FIRPFB_BLOCK_LEN;
+        memmove(_q->b + h, &_x[n], m*sizeof(TI));
+
+        // compute every output scheduled within this pass
+        for ( ; j<_ny && _k[j] < n + m; j++) {
+            DOTPROD(_execute)(_q->dp[_i[j]], _q->b + _k[j] - n, &_y[j]);
+            _y[j] *= _q->scale;
+        }
+        n += m;
+    }
+
+    // update window with the most recent samples
+    if (_nx > _q->h_sub_len)
+        WINDOW(_write)(_q->w, &_x[_nx - _q->h_sub_len], _q->h_sub_len);
+    else
+        WINDOW(_write)(_q->w, _x, _nx);
+}
+
+// create (or re-create) bank dot product object with sub-filters
+// interleaved tap by tap: v[k*M + i] = h_sub_i[k] (reversed)
+//  _M          : number of filters in the bank
+//  _h          : prototype coefficients [size: _M*_h_sub_len x 1]
+//  _h_sub_len  : length of each sub-filter
+//  _dpb        : existing object to re-create, or NULL
+DOTPROD() FIRPFB(_create_bank)(unsigned int _M,
+                               TC *         _h,
+                               unsigned int _h_sub_len,
+                               DOTPROD()    _dpb)
+{
+    TC * v = (TC*) malloc(_M*_h_sub_len*sizeof(TC));
+    unsigned int i, k;
+    for (k=0; k<_h_sub_len; k++) {
+        for (i=0; i<_M; i++)
+            v[k*_M + i] = _h[i + (_h_sub_len-k-1)*_M];
+    }
+    _dpb = _dpb == NULL ? DOTPROD(_create)(v, _M*_h_sub_len)
+                        : DOTPROD(_recreate)(_dpb, v, _M*_h_sub_len);
+    free(v);
+    return _dpb;
+}
@@ -31,6 +31,16 @@
 
 #define DEBUG_RESAMP_PRINT  0
 
+// maximum number of input samples and (roughly) output samples
+// scheduled per pass in RESAMP(_execute_block)
+#define LIQUID_RESAMP_BLOCK_LEN     (64)
+#define LIQUID_RESAMP_BLOCK_OUT     (256)
+
+// internal: fill the output schedule for the next _n input samples,
+// advancing the phase; returns the number of outputs scheduled
+unsigned int RESAMP(_schedule)(RESAMP()     _q,
+                               unsigned int _n);
+
 // main object
 struct RESAMP(_s) {
     // filter design parameters
@@ -44,6 +54,14 @@ struct RESAMP(_s) {
     uint32_t        phase;  // sampling phase
     unsigned int    npfb;   // 256
     FIRPFB()        pfb;    // filter bank
+
+    // block processing schedule
+    unsigned int    block_len;  // input samples per pass
+    unsigned int *  k;          // input index of each scheduled output
+    unsigned int *  idx;        // filterbank index of each scheduled output
+    unsigned int    ny_sched;   // number of outputs in cached schedule
+    uint32_t        phase_sched;// phase at start of cached schedule
+    int             sched_valid;// cached schedule is periodic over block_len
 };
 
 // create arbitrary resampler
@@ -80,6 +98,8 @@ RESAMP() RESAMP(_create)(float        _rate,
 
     // allocate memory for resampler
     RESAMP() q = (RESAMP()) malloc(sizeof(struct RESAMP(_s)));
+    q->k   = NULL;
+    q->idx = NULL;
 
     // set rate using formal method (specifies output stride
     // value 'del')
@@ -144,6 +164,10 @@ void RESAMP(_destroy)(RESAMP() _q)
     // free polyphase filterbank
     FIRPFB(_destroy)(_q->pfb);
 
+    // free schedule
+    free(_q->k);
+    free(_q->idx);
+
     // free main object memory
     free(_q);
 }
@@ -187,6 +211,20 @@ void RESAMP(_set_rate)(RESAMP() _q,
 
     // set output stride
     _q->step = (uint32_t)round((1<<24)/_q->r);
+
+    // Size the block schedule: each input yields at most ceil(2^24/step)
+    // outputs. The output times repeat every step/gcd(step,2^24) inputs;
+    // when that period fits in a pass, passes span whole periods so the
+    // schedule of one pass can be reused for the next.
+    unsigned int ny_max = ((1<<24) + _q->step - 1) / _q->step;
+    unsigned int n = LIQUID_RESAMP_BLOCK_OUT / ny_max;
+    n = n < 1 ? 1 : (n > LIQUID_RESAMP_BLOCK_LEN ? LIQUID_RESAMP_BLOCK_LEN : n);
+    uint32_t     g      = _q->step & (~_q->step + 1); // gcd(step,2^24): lowest set bit
+    unsigned int period = _q->step / (g < (1<<24) ? g : (1<<24));
+    _q->block_len   = period <= n ? (n / period) * period : n;
+    _q->k           = (unsigned int*) realloc(_q->k,   _q->block_len*ny_max*sizeof(unsigned int));
+    _q->idx         = (unsigned int*) realloc(_q->idx, _q->block_len*ny_max*sizeof(unsigned int));
+    _q->sched_valid = 0;
 }
 
 // get rate of arbitrary resampler
@@ -282,19 +320,16 @@ void RESAMP(_execute_block)(RESAMP()       _q,
                             TO *           _y,
                             unsigned int * _ny)
 {
-    // initialize number of output samples to zero
+    // Compute the output schedule (input index and filterbank index of
+    // each output) for a pass of input samples, then run the filterbank
+    // over the pass with the schedule.
     unsigned int ny = 0;
-
-    // number of samples written for each individual iteration
-    unsigned int num_written;
-
-    // iterate over each input sample
-    unsigned int i;
-    for (i=0; i<_nx; i++) {
-        // run resampler on single input
-        RESAMP(_execute)(_q, _x[i], &_y[ny], &num_written);
-
-        // update output counter
+    unsigned int n  = 0;
+    while (n < _nx) {
+        unsigned int m = _nx - n < _q->block_len ? _nx - n : _q->block_len;
+        unsigned int num_written = RESAMP(_schedule)(_q, m);
+        FIRPFB(_execute_schedule)(_q->pfb, &_x[n], m, _q->k, _q->idx, num_written, &_y[ny]);
+        n  += m;
         ny += num_written;
     }
 
@@ -302,3 +337,41 @@ void RESAMP(_execute_block)(RESAMP()       _q,
     *_ny = ny;
 }
 
+
+//
+// internal methods
+//
+
+// fill the output schedule for the next _n input samples, advancing the
+// phase exactly as RESAMP(_execute) does; returns the number of outputs
+//  _q      : resamp object
+//  _n      : number of input samples, _n <= block_len
+unsigned int RESAMP(_schedule)(RESAMP()     _q,
+                               unsigned int _n)
+{
+    // a full pass starting at the phase the cached schedule started at
+    // repeats it exactly, leaving the phase unchanged
+    if (_q->sched_valid && _n == _q->block_len && _q->phase == _q->phase_sched)
+        return _q->ny_sched;
+
+    uint32_t     phase = _q->phase;
+    unsigned int ny    = 0;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        while (phase <= 0x00ffffff) {
+            _q->k  [ny] = i;
+            _q->idx[ny] = phase >> 16; // round down
+            ny++;
+            phase += _q->step;
+        }
+        phase -= (1<<24);
+    }
+
+    // cache the schedule if the pass spans a whole number of periods
+    _q->sched_valid = _n == _q->block_len && phase == _q->phase;
+    _q->phase_sched = _q->phase;
+    _q->ny_sched    = ny;
+
+    _q->phase = phase;
+    return ny;
+}
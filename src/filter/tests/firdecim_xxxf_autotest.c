@@ -129,3 +129,103 @@ void autotest_firdecim_cccf_data_M5h23x50()
 }
 
 
+
+// 
+// AUTOTEST: firdecim_xxxf_execute_block vs. execute
+//
+
+// compare block execution (split into uneven, in-place blocks that
+// straddle the internal block length) to execution one output at a time
+void firdecim_crcf_block_test(unsigned int _M,
+                              unsigned int _h_len)
+{
+    float tol = 1e-4f * _h_len;
+    unsigned int n = 300;   // number of output samples
+    float h[_h_len];
+    float complex x[n*_M], y[n*_M], y_test;
+    unsigned int i;
+    for (i=0; i<_h_len; i++) h[i] = randnf();
+    for (i=0; i<n*_M;   i++) x[i] = y[i] = randnf() + _Complex_I*randnf();
+
+    firdecim_crcf q0 = firdecim_crcf_create(_M, h, _h_len);
+    firdecim_crcf q1 = firdecim_crcf_create(_M, h, _h_len);
+    firdecim_crcf_set_scale(q0, 0.5f);
+    firdecim_crcf_set_scale(q1, 0.5f);
+
+    // block sizes, including single outputs and zero-length blocks,
+    // with every fifth block run one output at a time
+    unsigned int b[8] = {1, 0, 3, 17, 100, 2, 65, 64};
+    unsigned int k = 0, j = 0;
+    while (k < n) {
+        unsigned int m = b[j++ % 8];
+        m = k + m > n ? n - k : m;
+        if (j % 5 == 4) {
+            for (i=k; i<k+m; i++)
+                firdecim_crcf_execute(q1, &y[i*_M], &y[i]);
+        } else {
+            firdecim_crcf_execute_block(q1, &y[k*_M], m, &y[k]);
+        }
+        for (i=k; i<k+m; i++) {
+            firdecim_crcf_execute(q0, &x[i*_M], &y_test);
+            CONTEND_DELTA( crealf(y[i]), crealf(y_test), tol );
+            CONTEND_DELTA( cimagf(y[i]), cimagf(y_test), tol );
+        }
+        k += m;
+    }
+    firdecim_crcf_destroy(q0);
+    firdecim_crcf_destroy(q1);
+}
+
+// cccf/rrrf: single large out-of-place block vs. execute
+void firdecim_cccf_block_test(unsigned int _M,
+                              unsigned int _h_len)
+{
+    float tol = 1e-4f * _h_len;
+    unsigned int n = 150;
+    float complex h[_h_len], x[n*_M], y[n], y_test;
+    unsigned int i;
+    for (i=0; i<_h_len; i++) h[i] = randnf() + _Complex_I*randnf();
+    for (i=0; i<n*_M;   i++) x[i] = randnf() + _Complex_I*randnf();
+
+    firdecim_cccf q = firdecim_cccf_create(_M, h, _h_len);
+    firdecim_cccf_execute_block(q, x, n, y);
+    firdecim_cccf_reset(q);
+    for (i=0; i<n; i++) {
+        firdecim_cccf_execute(q, &x[i*_M], &y_test);
+        CONTEND_DELTA( crealf(y[i]), crealf(y_test), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(y_test), tol );
+    }
+    firdecim_cccf_destroy(q);
+}
+
+void firdecim_rrrf_block_test(unsigned int _M,
+                              unsigned int _h_len)
+{
+    float tol = 1e-4f * _h_len;
+    unsigned int n = 150;
+    float h[_h_len], x[n*_M], y[n], y_test;
+    unsigned int i;
+    for (i=0; i<_h_len; i++) h[i] = randnf();
+    for (i=0; i<n*_M;   i++) x[i] = randnf();
+
+    firdecim_rrrf q = firdecim_rrrf_create(_M, h, _h_len);
+    firdecim_rrrf_execute_block(q, x, n, y);
+    firdecim_rrrf_reset(q);
+    for (i=0; i<n; i++) {
+        firdecim_rrrf_execute(q, &x[i*_M], &y_test);
+        CONTEND_DELTA( y[i], y_test, tol );
+    }
+    firdecim_rrrf_destroy(q);
+}
+
+void autotest_firdecim_crcf_block_M2h1()    { firdecim_crcf_block_test( 2,   1); }
+void autotest_firdecim_crcf_block_M2h7()    { firdecim_crcf_block_test( 2,   7); }
+void autotest_firdecim_crcf_block_M3h31()   { firdecim_crcf_block_test( 3,  31); }
+void autotest_firdecim_crcf_block_M8h5()    { firdecim_crcf_block_test( 8,   5); }
+void autotest_firdecim_crcf_block_M8h97()   { firdecim_crcf_block_test( 8,  97); }
+void autotest_firdecim_crcf_block_M32h257() { firdecim_crcf_block_test(32, 257); }
+void autotest_firdecim_cccf_block_M4h33()   { firdecim_cccf_block_test( 4,  33); }
+void autotest_firdecim_cccf_block_M16h200() { firdecim_cccf_block_test(16, 200); }
+void autotest_firdecim_rrrf_block_M4h33()   { firdecim_rrrf_block_test( 4,  33); }
+void autotest_firdecim_rrrf_block_M16h200() { firdecim_rrrf_block_test(16, 200); }
+
@@ -117,3 +117,102 @@ void autotest_firfilt_cccf_data_h23x64()
 }
 
 
+
+// 
+// AUTOTEST: firfilt_xxxf_execute_block vs. push/execute
+//
+
+// compare block execution (split into uneven, in-place blocks that
+// straddle the internal block length) to sample-by-sample execution
+void firfilt_crcf_block_test(unsigned int _h_len)
+{
+    float tol = 1e-4f * _h_len;
+    unsigned int n = 1200;
+    float h[_h_len];
+    float complex x[n], y[n], y_test;
+    unsigned int i;
+    for (i=0; i<_h_len; i++) h[i] = randnf();
+    for (i=0; i<n;      i++) x[i] = y[i] = randnf() + _Complex_I*randnf();
+
+    firfilt_crcf q0 = firfilt_crcf_create(h, _h_len);
+    firfilt_crcf q1 = firfilt_crcf_create(h, _h_len);
+    firfilt_crcf_set_scale(q0, 0.5f);
+    firfilt_crcf_set_scale(q1, 0.5f);
+
+    // block sizes, including single samples, writes, and zero-length blocks
+    unsigned int b[8] = {1, 0, 3, 17, 300, 2, 257, 64};
+    unsigned int k = 0, j = 0;
+    while (k < n) {
+        unsigned int m = b[j++ % 8];
+        m = k + m > n ? n - k : m;
+        if (j % 5 == 4) {
+            // write samples without computing output
+            firfilt_crcf_write(q1, &y[k], m);
+            for (i=k; i<k+m; i++) firfilt_crcf_push(q0, x[i]);
+        } else {
+            firfilt_crcf_execute_block(q1, &y[k], m, &y[k]);
+            for (i=k; i<k+m; i++) {
+                firfilt_crcf_push(q0, x[i]);
+                firfilt_crcf_execute(q0, &y_test);
+                CONTEND_DELTA( crealf(y[i]), crealf(y_test), tol );
+                CONTEND_DELTA( cimagf(y[i]), cimagf(y_test), tol );
+            }
+        }
+        k += m;
+    }
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+}
+
+// cccf/rrrf: single large out-of-place block vs. push/execute
+void firfilt_cccf_block_test(unsigned int _h_len)
+{
+    float tol = 1e-4f * _h_len;
+    unsigned int n = 700;
+    float complex h[_h_len], x[n], y[n], y_test;
+    unsigned int i;
+    for (i=0; i<_h_len; i++) h[i] = randnf() + _Complex_I*randnf();
+    for (i=0; i<n;      i++) x[i] = randnf() + _Complex_I*randnf();
+
+    firfilt_cccf q = firfilt_cccf_create(h, _h_len);
+    firfilt_cccf_execute_block(q, x, n, y);
+    firfilt_cccf_reset(q);
+    for (i=0; i<n; i++) {
+        firfilt_cccf_push(q, x[i]);
+        firfilt_cccf_execute(q, &y_test);
+        CONTEND_DELTA( crealf(y[i]), crealf(y_test), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(y_test), tol );
+    }
+    firfilt_cccf_destroy(q);
+}
+
+void firfilt_rrrf_block_test(unsigned int _h_len)
+{
+    float tol = 1e-4f * _h_len;
+    unsigned int n = 700;
+    float h[_h_len], x[n], y[n], y_test;
+    unsigned int i;
+    for (i=0; i<_h_len; i++) h[i] = randnf();
+    for (i=0; i<n;      i++) x[i] = randnf();
+
+    firfilt_rrrf q = firfilt_rrrf_create(h, _h_len);
+    firfilt_rrrf_execute_block(q, x, n, y);
+    firfilt_rrrf_reset(q);
+    for (i=0; i<n; i++) {
+        firfilt_rrrf_push(q, x[i]);
+        firfilt_rrrf_execute(q, &y_test);
+        CONTEND_DELTA( y[i], y_test, tol );
+    }
+    firfilt_rrrf_destroy(q);
+}
+
+void autotest_firfilt_crcf_block_h1()   { firfilt_crcf_block_test(  1); }
+void autotest_firfilt_crcf_block_h7()   { firfilt_crcf_block_test(  7); }
+void autotest_firfilt_crcf_block_h32()  { firfilt_crcf_block_test( 32); }
+void autotest_firfilt_crcf_block_h91()  { firfilt_crcf_block_test( 91); }
+void autotest_firfilt_cccf_block_h1()   { firfilt_cccf_block_test(  1); }
+void autotest_firfilt_cccf_block_h13()  { firfilt_cccf_block_test( 13); }
+void autotest_firfilt_cccf_block_h64()  { firfilt_cccf_block_test( 64); }
+void autotest_firfilt_rrrf_block_h1()   { firfilt_rrrf_block_test(  1); }
+void autotest_firfilt_rrrf_block_h23()  { firfilt_rrrf_block_test( 23); }
+void autotest_firfilt_rrrf_block_h300() { firfilt_rrrf_block_test(300); }
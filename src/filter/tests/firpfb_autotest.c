@@ -20,6 +20,8 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -72,7 +74,129 @@ void autotest_firpfb_impulse_response()
         firpfb_rrrf_execute(f,i,&y);
         CONTEND_DELTA(test[i],y,tol);
     }
+
+    // all filters in a single pass
+    float y_all[4];
+    firpfb_rrrf_execute_all(f,y_all);
+    for (i=0; i<4; i++)
+        CONTEND_DELTA(test[i],y_all[i],tol);
     
     firpfb_rrrf_destroy(f);
 }
 
+
+// compare executing all filters in a single pass to executing each
+// index in turn, before and after re-creating the filterbank
+void firpfb_crcf_execute_all_test(unsigned int _M,
+                                  unsigned int _h_sub_len)
+{
+    float tol = 1e-4f;
+    unsigned int h_len = _M*_h_sub_len;
+    float h[h_len];
+    unsigned int i, j, t;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    firpfb_crcf q = firpfb_crcf_create(_M, h, h_len);
+    firpfb_crcf_set_scale(q, 0.7f);
+    float complex y[_M], y_test;
+    for (t=0; t<2; t++) {
+        for (i=0; i<3*_h_sub_len; i++) {
+            firpfb_crcf_push(q, randnf() + _Complex_I*randnf());
+            firpfb_crcf_execute_all(q, y);
+            for (j=0; j<_M; j++) {
+                firpfb_crcf_execute(q, j, &y_test);
+                CONTEND_DELTA(crealf(y[j]), crealf(y_test), tol);
+                CONTEND_DELTA(cimagf(y[j]), cimagf(y_test), tol);
+            }
+        }
+
+        // new coefficients of the same length
+        for (i=0; i<h_len; i++)
+            h[i] = randnf();
+        q = firpfb_crcf_recreate(q, _M, h, h_len);
+    }
+    firpfb_crcf_destroy(q);
+}
+
+void firpfb_cccf_execute_all_test(unsigned int _M,
+                                  unsigned int _h_sub_len)
+{
+    float tol = 1e-4f;
+    unsigned int h_len = _M*_h_sub_len;
+    float complex h[h_len];
+    unsigned int i, j;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf() + _Complex_I*randnf();
+
+    firpfb_cccf q = firpfb_cccf_create(_M, h, h_len);
+    float complex y[_M], y_test;
+    for (i=0; i<3*_h_sub_len; i++) {
+        firpfb_cccf_push(q, randnf() + _Complex_I*randnf());
+        firpfb_cccf_execute_all(q, y);
+        for (j=0; j<_M; j++) {
+            firpfb_cccf_execute(q, j, &y_test);
+            CONTEND_DELTA(crealf(y[j]), crealf(y_test), tol);
+            CONTEND_DELTA(cimagf(y[j]), cimagf(y_test), tol);
+        }
+    }
+    firpfb_cccf_destroy(q);
+}
+
+// compare scheduled execution on a block of samples against pushing
+// each sample and executing the scheduled filters
+void firpfb_crcf_execute_schedule_test(unsigned int _M,
+                                       unsigned int _h_sub_len,
+                                       unsigned int _nx)
+{
+    float tol = 1e-4f;
+    unsigned int h_len = _M*_h_sub_len;
+    float h[h_len];
+    unsigned int i, j, t;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    firpfb_crcf q0 = firpfb_crcf_create(_M, h, h_len);
+    firpfb_crcf q1 = firpfb_crcf_create(_M, h, h_len);
+    firpfb_crcf_set_scale(q0, 0.7f);
+    firpfb_crcf_set_scale(q1, 0.7f);
+
+    // zero to three outputs per input at random indices
+    unsigned int ny_max = 3*_nx;
+    unsigned int k[ny_max], idx[ny_max];
+    float complex x[_nx], y[ny_max], y_test;
+    for (t=0; t<3; t++) {
+        unsigned int ny = 0;
+        for (i=0; i<_nx; i++) {
+            x[i] = randnf() + _Complex_I*randnf();
+            unsigned int n = rand() % 4;
+            for (j=0; j<n; j++) {
+                k  [ny] = i;
+                idx[ny] = rand() % _M;
+                ny++;
+            }
+        }
+        firpfb_crcf_execute_schedule(q1, x, _nx, k, idx, ny, y);
+
+        for (i=0, j=0; i<_nx; i++) {
+            firpfb_crcf_push(q0, x[i]);
+            for ( ; j<ny && k[j]==i; j++) {
+                firpfb_crcf_execute(q0, idx[j], &y_test);
+                CONTEND_DELTA(crealf(y[j]), crealf(y_test), tol);
+                CONTEND_DELTA(cimagf(y[j]), cimagf(y_test), tol);
+            }
+        }
+    }
+    firpfb_crcf_destroy(q0);
+    firpfb_crcf_destroy(q1);
+}
+
+void autotest_firpfb_crcf_execute_all_M2()  { firpfb_crcf_execute_all_test( 2, 13); }
+void autotest_firpfb_crcf_execute_all_M3()  { firpfb_crcf_execute_all_test( 3,  8); }
+void autotest_firpfb_crcf_execute_all_M32() { firpfb_crcf_execute_all_test(32, 15); }
+void autotest_firpfb_cccf_execute_all_M5()  { firpfb_cccf_execute_all_test( 5,  7); }
+void autotest_firpfb_cccf_execute_all_M16() { firpfb_cccf_execute_all_test(16, 12); }
+
+void autotest_firpfb_crcf_execute_schedule_n5()   { firpfb_crcf_execute_schedule_test( 8, 12,   5); }
+void autotest_firpfb_crcf_execute_schedule_n64()  { firpfb_crcf_execute_schedule_test(16,  7,  64); }
+void autotest_firpfb_crcf_execute_schedule_n150() { firpfb_crcf_execute_schedule_test(32, 14, 150); }
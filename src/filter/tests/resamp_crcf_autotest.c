@@ -165,3 +165,55 @@ void autotest_resamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+// compare block execution over varying block sizes against running the
+// resampler one sample at a time
+void resamp_crcf_block_test(float _rate)
+{
+    float        tol = 1e-4f;
+    unsigned int nx  = 1000;
+    unsigned int ny_max = (unsigned int)(_rate*nx) + 4;
+    float complex x[nx], y0[ny_max], y1[ny_max];
+    unsigned int i, nw;
+    for (i=0; i<nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    resamp_crcf q0 = resamp_crcf_create(_rate, 7, 0.4f, 60.0f, 256);
+    resamp_crcf q1 = resamp_crcf_create(_rate, 7, 0.4f, 60.0f, 256);
+
+    unsigned int ny0 = 0;
+    for (i=0; i<nx; i++) {
+        resamp_crcf_execute(q0, x[i], &y0[ny0], &nw);
+        ny0 += nw;
+    }
+
+    // cycle through block sizes, including passes over many periods
+    unsigned int block_len[] = {1, 17, 200, 3, 64, 129, 65, 521};
+    unsigned int ny1 = 0, n = 0;
+    for (i=0; n<nx; i++) {
+        unsigned int m = block_len[i % 8] < nx - n ? block_len[i % 8] : nx - n;
+        resamp_crcf_execute_block(q1, &x[n], m, &y1[ny1], &nw);
+        n   += m;
+        ny1 += nw;
+    }
+
+    if (liquid_autotest_verbose)
+        printf("  rate %12.8f: %u inputs, %u outputs\n", _rate, nx, ny1);
+
+    CONTEND_EQUALITY(ny0, ny1);
+    for (i=0; i<ny0 && i<ny1; i++) {
+        CONTEND_DELTA(crealf(y0[i]), crealf(y1[i]), tol);
+        CONTEND_DELTA(cimagf(y0[i]), cimagf(y1[i]), tol);
+    }
+
+    resamp_crcf_destroy(q0);
+    resamp_crcf_destroy(q1);
+}
+
+void autotest_resamp_crcf_block_r0p093() { resamp_crcf_block_test(0.0931f);      }
+void autotest_resamp_crcf_block_r0p5()   { resamp_crcf_block_test(0.5f);         }
+void autotest_resamp_crcf_block_r0p8()   { resamp_crcf_block_test(0.8f);         }
+void autotest_resamp_crcf_block_r1p271() { resamp_crcf_block_test(1.27115323f);  }
+void autotest_resamp_crcf_block_r1p333() { resamp_crcf_block_test(4.0f/3.0f);    }
+void autotest_resamp_crcf_block_r2()     { resamp_crcf_block_test(2.0f);         }
+void autotest_resamp_crcf_block_r13p7()  { resamp_crcf_block_test(13.7f);        }
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2007 - 2017 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <math.h>
+#include "liquid.h"
+
+#define QPACKETMODEM_BENCH_API(FEC0, FEC1, BLOCK)       \
+(   struct rusage *_start,                              \
+    struct rusage *_finish,                             \
+    unsigned long int *_num_iterations)                 \
+{ qpacketmodem_bench(_start, _finish, _num_iterations, FEC0, FEC1, BLOCK); }
+
+// Helper function to keep code base small: soft-decision decoding of
+// frames one at a time or in blocks (one iteration is one frame)
+void qpacketmodem_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        fec_scheme          _fec0,
+                        fec_scheme          _fec1,
+                        int                 _block)
+{
+    unsigned int payload_len = 64;
+    unsigned int num_frames  = 16;
+    *_num_iterations /= 256;
+    *_num_iterations = (*_num_iterations / num_frames) + 1;
+
+    qpacketmodem q = qpacketmodem_create();
+    qpacketmodem_configure(q, payload_len, LIQUID_CRC_32, _fec0, _fec1, LIQUID_MODEM_QPSK);
+    unsigned int frame_len = qpacketmodem_get_frame_len(q);
+
+    unsigned char * payload = (unsigned char*) malloc(num_frames*payload_len*sizeof(unsigned char));
+    float complex * frames  = (float complex*) malloc(num_frames*frame_len*sizeof(float complex));
+
+    // encode frames and add some noise
+    unsigned long int i;
+    unsigned int j;
+    for (i=0; i<num_frames*payload_len; i++)
+        payload[i] = rand() & 0xff;
+    for (j=0; j<num_frames; j++)
+        qpacketmodem_encode(q, &payload[j*payload_len], &frames[j*frame_len]);
+    for (i=0; i<num_frames*frame_len; i++)
+        frames[i] += 0.1f*(randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+
+    // start trials
+    unsigned int num_valid = 0;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_block) {
+            num_valid += qpacketmodem_decode_soft_block(q, frames, num_frames, payload, NULL);
+        } else {
+            for (j=0; j<num_frames; j++)
+                num_valid += qpacketmodem_decode_soft(q, &frames[j*frame_len], &payload[j*payload_len]);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= num_frames;
+
+    if (num_valid != *_num_iterations)
+        printf("warning: qpacketmodem_bench(), %u of %lu frames valid\n", num_valid, *_num_iterations);
+
+    qpacketmodem_destroy(q);
+    free(payload);
+    free(frames);
+}
+
+//
+// BENCHMARKS
+//
+void benchmark_qpacketmodem_none            QPACKETMODEM_BENCH_API(LIQUID_FEC_NONE,  LIQUID_FEC_NONE,      0)
+void benchmark_qpacketmodem_none_block      QPACKETMODEM_BENCH_API(LIQUID_FEC_NONE,  LIQUID_FEC_NONE,      1)
+void benchmark_qpacketmodem_h74             QPACKETMODEM_BENCH_API(LIQUID_FEC_NONE,  LIQUID_FEC_HAMMING74, 0)
+void benchmark_qpacketmodem_h74_block       QPACKETMODEM_BENCH_API(LIQUID_FEC_NONE,  LIQUID_FEC_HAMMING74, 1)
+void benchmark_qpacketmodem_h84             QPACKETMODEM_BENCH_API(LIQUID_FEC_NONE,  LIQUID_FEC_HAMMING84, 0)
+void benchmark_qpacketmodem_h84_block       QPACKETMODEM_BENCH_API(LIQUID_FEC_NONE,  LIQUID_FEC_HAMMING84, 1)
+void benchmark_qpacketmodem_rs8             QPACKETMODEM_BENCH_API(LIQUID_FEC_RS_M8, LIQUID_FEC_NONE,      0)
+void benchmark_qpacketmodem_rs8_block       QPACKETMODEM_BENCH_API(LIQUID_FEC_RS_M8, LIQUID_FEC_NONE,      1)
+void benchmark_qpacketmodem_rs8_h74         QPACKETMODEM_BENCH_API(LIQUID_FEC_RS_M8, LIQUID_FEC_HAMMING74, 0)
+void benchmark_qpacketmodem_rs8_h74_block   QPACKETMODEM_BENCH_API(LIQUID_FEC_RS_M8, LIQUID_FEC_HAMMING74, 1)
@@ -208,9 +208,23 @@ void bpacketsync_execute(bpacketsync _q,
                          unsigned char * _bytes,
                          unsigned int _n)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        bpacketsync_execute_byte(_q, _bytes[i]);
+    unsigned int i=0;   // input byte index
+    unsigned int b=0;   // bit index within byte
+    while (i < _n) {
+        if (_q->state == BPACKETSYNC_STATE_SEEKPN && b == 0) {
+            // search for p/n sequence over whole bytes at once, resuming
+            // bit by bit just after the sequence if it is found
+            unsigned int k = bpacketsync_execute_seekpn_block(_q, &_bytes[i], _n-i);
+            i += k / 8;
+            b  = k % 8;
+        } else {
+            bpacketsync_execute_bit(_q, (_bytes[i] >> (8-b-1)) & 1);
+            if (++b == 8) {
+                b = 0;
+                i++;
+            }
+        }
+    }
 }
 
 // run synchronizer on input byte
@@ -316,6 +330,57 @@ void bpacketsync_execute_seekpn(bpacketsync _q,
     }
 }
 
+// search for p/n sequence in block of input bytes, returning the number
+// of bits consumed (all bits if the sequence was not found)
+unsigned int bpacketsync_execute_seekpn_block(bpacketsync     _q,
+                                              unsigned char * _bytes,
+                                              unsigned int    _n)
+{
+    // limit block size
+    unsigned int n = _n < 256 ? _n : 256;
+
+    // previously received bits followed by block
+    unsigned int num_bits = 8*_q->pnsequence_len;
+    unsigned int len = _q->pnsequence_len + n;
+    unsigned char buf[len];
+    unsigned int i;
+    memset(buf, 0x00, _q->pnsequence_len);
+    for (i=0; i<num_bits; i++)
+        buf[i/8] |= bsequence_index(_q->brx, num_bits-i-1) << (7-(i%8));
+    memmove(&buf[_q->pnsequence_len], _bytes, n);
+
+    // correlation for window ending at each bit of the block
+    int rxy[8*n+1];
+    bsequence_correlate_bytes(_q->bpn, buf, len, rxy);
+
+    // find first window exceeding the threshold; the correlation is
+    // compared directly against the same bounds on rxy which the
+    // bit-wise search derives from |2*rxy/num_bits - 1| > 0.8
+    int rxy_min = 0;            // lowest correlation above threshold
+    int rxy_max = num_bits;     // highest correlation below -threshold
+    while (rxy_min <= (int)num_bits && 2.0f*(float)rxy_min/(float)num_bits - 1.0f <= 0.8f)
+        rxy_min++;
+    while (rxy_max >= 0 && 2.0f*(float)rxy_max/(float)num_bits - 1.0f >= -0.8f)
+        rxy_max--;
+    for (i=1; i<=8*n; i++) {
+        if (rxy[i] >= rxy_min || rxy[i] <= rxy_max) {
+#if DEBUG_BPACKETSYNC
+            printf("p/n sequence found!, rxy = %8.4f\n", 2.0f*(float)rxy[i]/(float)num_bits - 1.0f);
+#endif
+            // flip polarity of bits if correlation is negative
+            _q->byte_mask = rxy[i] >= rxy_min ? 0x00 : 0xff;
+
+            // switch operational mode
+            _q->state = BPACKETSYNC_STATE_RXHEADER;
+            return i;
+        }
+    }
+
+    // retain most recent bits
+    bsequence_init(_q->brx, &buf[n]);
+    return 8*n;
+}
+
 void bpacketsync_execute_rxheader(bpacketsync _q,
                                   unsigned char _bit)
 {
@@ -47,6 +47,10 @@ struct qpacketmodem_s {
     unsigned int    payload_bit_len;    // number of bits in encoded payload
     unsigned int    payload_mod_len;    // number of symbols in encoded payload
     unsigned int    n;                  // index into partially-received payload data
+
+    // block decoding
+    unsigned char * block_enc;          // soft bits of all frames in a block
+    unsigned int    block_enc_len;      // allocated length of block_enc (bytes)
 };
 
 // create packet encoder
@@ -85,6 +89,10 @@ qpacketmodem qpacketmodem_create()
 
     q->n = 0;
 
+    // block decoding buffer is allocated on first use
+    q->block_enc     = NULL;
+    q->block_enc_len = 0;
+
     // return pointer to main object
     return q;
 }
@@ -99,6 +107,7 @@ void qpacketmodem_destroy(qpacketmodem _q)
     // free arrays
     free(_q->payload_enc);
     free(_q->payload_mod);
+    free(_q->block_enc);
 
     free(_q);
 }
@@ -315,24 +324,45 @@ int qpacketmodem_decode_soft(qpacketmodem    _q,
                              float complex * _frame,
                              unsigned char * _payload)
 {
-    unsigned int i;
-
-    // demodulate and pack bytes into decoder input buffer
-    unsigned int sym;
-    //memset(_q->payload_enc, 0x00, _q->payload_enc_len*sizeof(unsigned char));
-    unsigned int n = 0;
-    for (i=0; i<_q->payload_mod_len; i++) {
-        // demodulate symbol
-        modem_demodulate_soft(_q->mod_payload, _frame[i], &sym, _q->payload_enc+n);
-        n += _q->bits_per_symbol;
-    }
-    //printf("received %u bits (expected %u)\n", n, _q->payload_mod_len * _q->bits_per_symbol);
-    assert( n == _q->payload_mod_len * _q->bits_per_symbol);
+    // demodulate soft bits into decoder input buffer
+    modem_demodulate_soft_block(_q->mod_payload, _frame, _q->payload_mod_len, _q->payload_enc);
 
     // decode payload, returning flag if decoded payload is valid
     return packetizer_decode_soft(_q->p, _q->payload_enc, _payload);
 }
 
+// decode block of packets from modulated frame samples, returning the
+// number of frames whose CRC passed
+//  _q          :   qpacketmodem object
+//  _frames     :   encoded/modulated payload symbols, [size: _num_frames*frame_len x 1]
+//  _num_frames :   number of frames
+//  _payloads   :   recovered decoded payload bytes, [size: _num_frames*payload_len x 1]
+//  _valid      :   CRC flag for each frame, [size: _num_frames x 1] (ignored if NULL)
+unsigned int qpacketmodem_decode_soft_block(qpacketmodem    _q,
+                                            float complex * _frames,
+                                            unsigned int    _num_frames,
+                                            unsigned char * _payloads,
+                                            int *           _valid)
+{
+    // soft bits of one frame (includes padding of the last symbol)
+    unsigned int frame_bits = _q->bits_per_symbol*_q->payload_mod_len;
+
+    // grow soft-bit buffer to hold all frames
+    if (_num_frames*frame_bits > _q->block_enc_len) {
+        _q->block_enc_len = _num_frames*frame_bits;
+        _q->block_enc = (unsigned char*) realloc(_q->block_enc,
+                                                 _q->block_enc_len*sizeof(unsigned char));
+    }
+
+    // demodulate all frames in one pass
+    modem_demodulate_soft_block(_q->mod_payload, _frames,
+                                _num_frames*_q->payload_mod_len, _q->block_enc);
+
+    // decode all payloads together, returning number of valid frames
+    return packetizer_decode_soft_block(_q->p, _q->block_enc, frame_bits,
+                                        _num_frames, _payloads, _valid);
+}
+
 // decode symbol from modulated frame samples, returning flag if all symbols received
 //  _q          :   qpacketmodem object
 //  _frame      :   encoded/modulated symbol
@@ -95,3 +95,56 @@ void autotest_bpacketsync()
     bpacketsync_destroy(ps);
 }
 
+
+// packets at arbitrary bit offsets (one with inverted polarity) found by
+// the block search match the bit-by-bit synchronizer
+void autotest_bpacketsync_unaligned()
+{
+    unsigned int num_packets = 8;
+    unsigned int dec_msg_len = 32;
+    bpacketgen pg = bpacketgen_create(0, dec_msg_len, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_NONE);
+    unsigned int enc_msg_len = bpacketgen_get_packet_len(pg);
+
+    // assemble bit stream: random gap of 0..39 bits before each packet
+    unsigned int max_bits = num_packets*(8*enc_msg_len + 40) + 8;
+    unsigned char bits[max_bits];
+    unsigned char msg_org[dec_msg_len];
+    unsigned char msg_enc[enc_msg_len];
+    unsigned int i, j, n, num_bits = 0;
+    for (n=0; n<num_packets; n++) {
+        unsigned int gap = rand() % 40;
+        for (i=0; i<gap; i++)
+            bits[num_bits++] = rand() & 1;
+        for (i=0; i<dec_msg_len; i++)
+            msg_org[i] = rand() & 0xff;
+        bpacketgen_encode(pg, msg_org, msg_enc);
+        for (i=0; i<8*enc_msg_len; i++)
+            bits[num_bits++] = ((msg_enc[i/8] >> (7-(i%8))) & 1) ^ (n==3);
+    }
+    while (num_bits % 8)
+        bits[num_bits++] = 0;
+
+    unsigned char bytes[num_bits/8];
+    for (i=0; i<num_bits/8; i++) {
+        bytes[i] = 0;
+        for (j=0; j<8; j++)
+            bytes[i] |= bits[8*i+j] << (7-j);
+    }
+
+    // block and bit-by-bit synchronizers
+    unsigned int num_found_block = 0;
+    unsigned int num_found_bit   = 0;
+    bpacketsync ps0 = bpacketsync_create(0, bpacketsync_autotest_callback, (void*)&num_found_block);
+    bpacketsync ps1 = bpacketsync_create(0, bpacketsync_autotest_callback, (void*)&num_found_bit);
+    for (i=0; i<num_bits/8; i+=7)
+        bpacketsync_execute(ps0, &bytes[i], i+7 < num_bits/8 ? 7 : num_bits/8 - i);
+    for (i=0; i<num_bits; i++)
+        bpacketsync_execute_bit(ps1, bits[i]);
+
+    CONTEND_EQUALITY( num_found_block, num_packets );
+    CONTEND_EQUALITY( num_found_bit,   num_packets );
+
+    bpacketgen_destroy(pg);
+    bpacketsync_destroy(ps0);
+    bpacketsync_destroy(ps1);
+}
@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -82,6 +83,7 @@ void autotest_qpacketmodem_sqam32() { qpacketmodem_modulated(400,LIQUID_CRC_32,L
 void autotest_qpacketmodem_qam64()  { qpacketmodem_modulated(400,LIQUID_CRC_32,LIQUID_FEC_NONE,LIQUID_FEC_NONE, LIQUID_MODEM_QAM64);   }
 void autotest_qpacketmodem_sqam128(){ qpacketmodem_modulated(400,LIQUID_CRC_32,LIQUID_FEC_NONE,LIQUID_FEC_NONE, LIQUID_MODEM_SQAM128); }
 void autotest_qpacketmodem_qam256() { qpacketmodem_modulated(400,LIQUID_CRC_32,LIQUID_FEC_NONE,LIQUID_FEC_NONE, LIQUID_MODEM_QAM256);  }
+void autotest_qpacketmodem_ldpc648(){ qpacketmodem_modulated(400,LIQUID_CRC_32,LIQUID_FEC_LDPC_N648,LIQUID_FEC_NONE, LIQUID_MODEM_QPSK); }
 
 // 
 // AUTOTEST : test un-modulated frame symbols (hard-decision demod)
@@ -139,4 +141,48 @@ void autotest_qpacketmodem_unmod_sqam32() { qpacketmodem_unmodulated(400,LIQUID_
 void autotest_qpacketmodem_unmod_qam64()  { qpacketmodem_unmodulated(400,LIQUID_CRC_32,LIQUID_FEC_NONE,LIQUID_FEC_NONE, LIQUID_MODEM_QAM64);   }
 void autotest_qpacketmodem_unmod_sqam128(){ qpacketmodem_unmodulated(400,LIQUID_CRC_32,LIQUID_FEC_NONE,LIQUID_FEC_NONE, LIQUID_MODEM_SQAM128); }
 void autotest_qpacketmodem_unmod_qam256() { qpacketmodem_unmodulated(400,LIQUID_CRC_32,LIQUID_FEC_NONE,LIQUID_FEC_NONE, LIQUID_MODEM_QAM256);  }
+void autotest_qpacketmodem_unmod_ldpc648(){ qpacketmodem_unmodulated(400,LIQUID_CRC_32,LIQUID_FEC_LDPC_N648,LIQUID_FEC_NONE, LIQUID_MODEM_QPSK); }
 
+
+// 
+// AUTOTEST : decode a block of frames, one of which is corrupted
+//
+void qpacketmodem_block(unsigned int _payload_len,
+                        int          _fec0,
+                        int          _ms)
+{
+    unsigned int i, num_frames = 5;
+
+    qpacketmodem q = qpacketmodem_create();
+    qpacketmodem_configure(q, _payload_len, LIQUID_CRC_32, _fec0, LIQUID_FEC_NONE, _ms);
+    unsigned int frame_len = qpacketmodem_get_frame_len(q);
+
+    unsigned char payload_tx[num_frames*_payload_len];
+    unsigned char payload_rx[num_frames*_payload_len];
+    float complex frames[num_frames*frame_len];
+    int valid[num_frames];
+    for (i=0; i<num_frames*_payload_len; i++)
+        payload_tx[i] = rand() & 0xff;
+    for (i=0; i<num_frames; i++)
+        qpacketmodem_encode(q, &payload_tx[i*_payload_len], &frames[i*frame_len]);
+
+    // invert every symbol of frame 2
+    for (i=0; i<frame_len; i++)
+        frames[2*frame_len + i] = -frames[2*frame_len + i];
+
+    unsigned int num_valid = qpacketmodem_decode_soft_block(q, frames, num_frames, payload_rx, valid);
+    qpacketmodem_destroy(q);
+
+    CONTEND_EQUALITY( num_valid, num_frames-1 );
+    for (i=0; i<num_frames; i++) {
+        CONTEND_EQUALITY( valid[i], i==2 ? 0 : 1 );
+        if (i != 2)
+            CONTEND_SAME_DATA( &payload_tx[i*_payload_len], &payload_rx[i*_payload_len], _payload_len );
+    }
+}
+
+void autotest_qpacketmodem_block_qpsk()  { qpacketmodem_block(64, LIQUID_FEC_NONE,       LIQUID_MODEM_QPSK);  }
+void autotest_qpacketmodem_block_h128()  { qpacketmodem_block(64, LIQUID_FEC_HAMMING128, LIQUID_MODEM_BPSK);  }
+void autotest_qpacketmodem_block_v27()   { qpacketmodem_block(64, LIQUID_FEC_CONV_V27,   LIQUID_MODEM_QAM16); }
+void autotest_qpacketmodem_block_h74()   { qpacketmodem_block(64, LIQUID_FEC_HAMMING74,  LIQUID_MODEM_QAM16); }
+void autotest_qpacketmodem_block_rs8()   { qpacketmodem_block(800, LIQUID_FEC_RS_M8,     LIQUID_MODEM_QPSK);  }
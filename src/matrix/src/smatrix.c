@@ -458,6 +458,31 @@ T SMATRIX(_get)(SMATRIX()    _q,
     return 0;
 }
 
+// get column indices of non-zero elements in row (sorted), returning
+// the number of non-zero elements
+unsigned int SMATRIX(_get_row_indices)(SMATRIX()      _q,
+                                       unsigned int   _m,
+                                       unsigned int * _idx)
+{
+    // validate input
+    if (_m >= _q->M) {
+        fprintf(stderr,"error: SMATRIX(_get_row_indices)(%u), index exceeds matrix dimension (%u,%u)\n",
+                _m, _q->M, _q->N);
+        exit(1);
+    }
+
+    unsigned int j;
+    unsigned int n = 0;
+    for (j=0; j<_q->num_mlist[_m]; j++) {
+        if (_q->mvals[_m][j] == 0)
+            continue;
+        if (_idx != NULL)
+            _idx[n] = _q->mlist[_m][j];
+        n++;
+    }
+    return n;
+}
+
 // initialize to identity matrix
 void SMATRIX(_eye)(SMATRIX() _q)
 {
@@ -112,6 +112,39 @@ void autotest_smatrixb_vmul()
     smatrixb_destroy(A);
 }
 
+// test retrieving non-zero column indices of each row
+void autotest_smatrixb_get_row_indices()
+{
+    // create sparse matrix, setting values out of order
+    smatrixb A = smatrixb_create(4,12);
+    smatrixb_set(A,0,9,  1);
+    smatrixb_set(A,0,2,  1);
+    smatrixb_set(A,0,5,  1);
+    smatrixb_set(A,2,11, 1);
+    smatrixb_set(A,3,0,  1);
+    smatrixb_set(A,3,7,  1);
+    smatrixb_set(A,3,4,  0);    // allocated but zero
+
+    unsigned int idx[12];
+    CONTEND_EQUALITY( smatrixb_get_row_indices(A,0,NULL), 3 );
+    CONTEND_EQUALITY( smatrixb_get_row_indices(A,0,idx),  3 );
+    CONTEND_EQUALITY( idx[0], 2 );
+    CONTEND_EQUALITY( idx[1], 5 );
+    CONTEND_EQUALITY( idx[2], 9 );
+
+    CONTEND_EQUALITY( smatrixb_get_row_indices(A,1,idx),  0 );
+
+    CONTEND_EQUALITY( smatrixb_get_row_indices(A,2,idx),  1 );
+    CONTEND_EQUALITY( idx[0], 11 );
+
+    CONTEND_EQUALITY( smatrixb_get_row_indices(A,3,idx),  2 );
+    CONTEND_EQUALITY( idx[0], 0 );
+    CONTEND_EQUALITY( idx[1], 7 );
+
+    // destroy matrix object
+    smatrixb_destroy(A);
+}
+
 // test sparse binary matrix multiplication
 void autotest_smatrixb_mul()
 {
@@ -80,11 +80,7 @@ void MODEM(_demodulate_soft_bpsk)(MODEM()         _q,
     T gamma = 4.0f;
 
     // approximate log-likelihood ratio
-    T LLR = -2.0f * crealf(_x) * gamma;
-    int soft_bit = LLR*16 + 127;
-    if (soft_bit > 255) soft_bit = 255;
-    if (soft_bit <   0) soft_bit = 0;
-    _soft_bits[0] = (unsigned char) ( soft_bit );
+    _soft_bits[0] = MODEM(_soft_bit_llr)(crealf(_x), gamma);
 
     // re-modulate symbol and store state
     unsigned int symbol_out = (crealf(_x) > 0 ) ? 0 : 1;
@@ -93,3 +89,33 @@ void MODEM(_demodulate_soft_bpsk)(MODEM()         _q,
     *_s = symbol_out;
 }
 
+// demodulate block of BPSK samples (soft), see MODEM(_demodulate_soft_bpsk)
+void MODEM(_demodulate_soft_block_bpsk)(MODEM()         _q,
+                                        TC *            _x,
+                                        unsigned int    _n,
+                                        unsigned char * _soft_bits)
+{
+    // gamma = 1/(2*sigma^2), approximate for constellation size
+    T gamma = 4.0f;
+
+    unsigned int i=0;
+#if defined(__SSE2__)
+    // sixteen samples at a time, keeping the in-phase components
+    const float * x = (const float*) _x;
+    __m128 g = _mm_set1_ps(gamma);
+    for (i=0; i+16<=_n; i+=16) {
+        __m128i b[4];
+        unsigned int k;
+        for (k=0; k<4; k++) {
+            __m128 v0 = _mm_loadu_ps(x + 2*i + 8*k);
+            __m128 v1 = _mm_loadu_ps(x + 2*i + 8*k + 4);
+            b[k] = MODEM(_soft_bit_llr_sse)(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0)), g);
+        }
+        __m128i h0 = _mm_packs_epi32(b[0], b[1]);
+        __m128i h1 = _mm_packs_epi32(b[2], b[3]);
+        _mm_storeu_si128((__m128i*)(_soft_bits + i), _mm_packus_epi16(h0, h1));
+    }
+#endif
+    for ( ; i<_n; i++)
+        _soft_bits[i] = MODEM(_soft_bit_llr)(crealf(_x[i]), gamma);
+}
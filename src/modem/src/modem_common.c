@@ -30,6 +30,10 @@
 
 #include "liquid.internal.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #define DEBUG_DEMODULATE_SOFT 0
 
 // modem structure used for both modulation and demodulation 
@@ -421,6 +425,57 @@ void MODEM(_demodulate_soft)(MODEM() _q,
     liquid_unpack_soft_bits(symbol_out, _q->m, _soft_bits);
 }
 
+// generic soft demodulation of a block of samples
+void MODEM(_demodulate_soft_block)(MODEM()         _q,
+                                   TC *            _x,
+                                   unsigned int    _n,
+                                   unsigned char * _soft_bits)
+{
+    unsigned int i;
+    unsigned int s;
+
+    // switch scheme
+    switch (_q->scheme) {
+    case LIQUID_MODEM_BPSK: MODEM(_demodulate_soft_block_bpsk)(_q,_x,_n,_soft_bits); break;
+    case LIQUID_MODEM_QPSK: MODEM(_demodulate_soft_block_qpsk)(_q,_x,_n,_soft_bits); break;
+    default:
+        for (i=0; i<_n; i++)
+            MODEM(_demodulate_soft)(_q, _x[i], &s, &_soft_bits[i*_q->m]);
+        return;
+    }
+
+    // leave the demodulator state as if the last sample had been
+    // demodulated on its own
+    if (_n > 0)
+        _q->demodulate_func(_q, _x[_n-1], &s);
+}
+
+// soft bit from a single in-phase or quadrature component with
+// approximate log-likelihood scaling _gamma = 1/(2*sigma^2)
+unsigned char MODEM(_soft_bit_llr)(T _v,
+                                   T _gamma)
+{
+    T LLR = -2.0f * _v * _gamma;
+    int soft_bit = LLR*16 + 127;
+    if (soft_bit > 255) soft_bit = 255;
+    if (soft_bit <   0) soft_bit = 0;
+    return (unsigned char) soft_bit;
+}
+
+#if defined(__SSE2__)
+// soft bits (as 32-bit integers) from four components, matching
+// MODEM(_soft_bit_llr) exactly: scaling by -2 and 16 is exact, so only
+// the products with gamma and the offset are rounded
+static inline __m128i MODEM(_soft_bit_llr_sse)(__m128 _v,
+                                               __m128 _gamma)
+{
+    __m128 t = _mm_mul_ps(_mm_mul_ps(_v, _gamma), _mm_set1_ps(-32.0f));
+    t = _mm_add_ps(t, _mm_set1_ps(127.0f));
+    t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    return _mm_cvttps_epi32(t);
+}
+#endif
+
 #if DEBUG_DEMODULATE_SOFT
 // print a string of bits to the standard output
 void print_bitstring_demod_soft(unsigned int _x,
@@ -83,22 +83,8 @@ void MODEM(_demodulate_soft_qpsk)(MODEM()         _q,
     T gamma = 5.8f;
 
     // approximate log-likelihood ratios
-    T LLR;
-    int soft_bit;
-    
-    // compute soft value for first bit
-    LLR = -2.0f * cimagf(_x) * gamma;
-    soft_bit = LLR*16 + 127;
-    if (soft_bit > 255) soft_bit = 255;
-    if (soft_bit <   0) soft_bit = 0;
-    _soft_bits[0] = (unsigned char) ( soft_bit );
-
-    // compute soft value for first bit
-    LLR = -2.0f * crealf(_x) * gamma;
-    soft_bit = LLR*16 + 127;
-    if (soft_bit > 255) soft_bit = 255;
-    if (soft_bit <   0) soft_bit = 0;
-    _soft_bits[1] = (unsigned char) ( soft_bit );
+    _soft_bits[0] = MODEM(_soft_bit_llr)(cimagf(_x), gamma);
+    _soft_bits[1] = MODEM(_soft_bit_llr)(crealf(_x), gamma);
 
     // re-modulate symbol and store state
     *_s  = (crealf(_x) > 0 ? 0 : 1) +
@@ -107,3 +93,35 @@ void MODEM(_demodulate_soft_qpsk)(MODEM()         _q,
     _q->r = _x;
 }
 
+// demodulate block of QPSK samples (soft), see MODEM(_demodulate_soft_qpsk)
+void MODEM(_demodulate_soft_block_qpsk)(MODEM()         _q,
+                                        TC *            _x,
+                                        unsigned int    _n,
+                                        unsigned char * _soft_bits)
+{
+    // gamma = 1/(2*sigma^2), approximate for constellation size
+    T gamma = 5.8f;
+
+    unsigned int i=0;
+#if defined(__SSE2__)
+    // eight samples at a time; the quadrature component gives the first
+    // bit of each symbol, so swap the components of each sample
+    const float * x = (const float*) _x;
+    __m128 g = _mm_set1_ps(gamma);
+    for (i=0; i+8<=_n; i+=8) {
+        __m128i b[4];
+        unsigned int k;
+        for (k=0; k<4; k++) {
+            __m128 v = _mm_loadu_ps(x + 2*i + 4*k);
+            b[k] = MODEM(_soft_bit_llr_sse)(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2,3,0,1)), g);
+        }
+        __m128i h0 = _mm_packs_epi32(b[0], b[1]);
+        __m128i h1 = _mm_packs_epi32(b[2], b[3]);
+        _mm_storeu_si128((__m128i*)(_soft_bits + 2*i), _mm_packus_epi16(h0, h1));
+    }
+#endif
+    for ( ; i<_n; i++) {
+        _soft_bits[2*i+0] = MODEM(_soft_bit_llr)(cimagf(_x[i]), gamma);
+        _soft_bits[2*i+1] = MODEM(_soft_bit_llr)(crealf(_x[i]), gamma);
+    }
+}
@@ -24,6 +24,9 @@
 // soft demodulation tests
 //
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -128,3 +131,36 @@ void autotest_demodsoft_arb128opt() { modem_test_demodsoft(LIQUID_MODEM_ARB128OP
 void autotest_demodsoft_arb256opt() { modem_test_demodsoft(LIQUID_MODEM_ARB256OPT); }
 void autotest_demodsoft_arb64vt()   { modem_test_demodsoft(LIQUID_MODEM_ARB64VT);   }
 
+
+// Test block soft demodulation against sample-by-sample soft
+// demodulation, including amplitudes which saturate the soft bits
+void modem_test_demodsoft_block(modulation_scheme _ms)
+{
+    modem q0 = modem_create(_ms);
+    modem q1 = modem_create(_ms);
+    unsigned int bps = modem_get_bps(q0);
+
+    unsigned int i, s, n=77;
+    float complex x[n];
+    unsigned char soft_bits_0[n*bps];
+    unsigned char soft_bits_1[n*bps];
+    for (i=0; i<n; i++) {
+        float g = 0.1f + 2.0f*(float)i/(float)n;
+        x[i] = g*((float)rand()/RAND_MAX - 0.5f) + _Complex_I*g*((float)rand()/RAND_MAX - 0.5f);
+        modem_demodulate_soft(q0, x[i], &s, &soft_bits_0[i*bps]);
+    }
+    memset(soft_bits_1, 0x00, n*bps);
+    modem_demodulate_soft_block(q1, x, n, soft_bits_1);
+    CONTEND_SAME_DATA(soft_bits_0, soft_bits_1, n*bps);
+
+    // internal state reflects final sample
+    CONTEND_DELTA(modem_get_demodulator_evm(q0), modem_get_demodulator_evm(q1), 1e-6f);
+
+    modem_destroy(q0);
+    modem_destroy(q1);
+}
+
+void autotest_demodsoft_block_bpsk()  { modem_test_demodsoft_block(LIQUID_MODEM_BPSK);  }
+void autotest_demodsoft_block_qpsk()  { modem_test_demodsoft_block(LIQUID_MODEM_QPSK);  }
+void autotest_demodsoft_block_psk8()  { modem_test_demodsoft_block(LIQUID_MODEM_PSK8);  }
+void autotest_demodsoft_block_qam16() { modem_test_demodsoft_block(LIQUID_MODEM_QAM16); }
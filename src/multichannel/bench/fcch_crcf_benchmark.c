@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define FCCH_EXECUTE_BENCH_API(NFFT,HOP,C,D)                \
+(   struct rusage *     _start,                             \
+    struct rusage *     _finish,                            \
+    unsigned long int * _num_iterations)                    \
+{ fcch_crcf_execute_bench(_start, _finish, _num_iterations, NFFT, HOP, C, D); }
+
+// Helper function to keep code base small
+void fcch_crcf_execute_bench(struct rusage *     _start,
+                             struct rusage *     _finish,
+                             unsigned long int * _num_iterations,
+                             unsigned int        _nfft,
+                             unsigned int        _hop,
+                             unsigned int        _num_channels,
+                             unsigned int        _decim)
+{
+    // initialize channelizer with channels spread across the band
+    fcch_crcf q = fcch_crcf_create(_nfft, _hop);
+    unsigned long int i;
+    for (i=0; i<_num_channels; i++) {
+        float fc = -0.5f + ((float)i + 0.5f) / (float)_num_channels;
+        fcch_crcf_add_channel_kaiser(q, fc, _decim, 0.4f/(float)_decim, 60.0f);
+    }
+
+    float complex * x = (float complex*) malloc(_hop*sizeof(float complex));
+    float complex * y = (float complex*) malloc(fcch_crcf_get_num_outputs(q)*sizeof(float complex));
+    for (i=0; i<_hop; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    unsigned long int n = (*_num_iterations * 20) / (_nfft + 4*_num_channels*_nfft/_decim);
+    n = n < 1 ? 1 : n;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<n; i++) {
+        fcch_crcf_execute(q, x, y);
+        fcch_crcf_execute(q, x, y);
+        fcch_crcf_execute(q, x, y);
+        fcch_crcf_execute(q, x, y);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = n*4;
+
+    fcch_crcf_destroy(q);
+    free(x);
+    free(y);
+}
+
+void benchmark_fcch_crcf_N1024_C008_D64  FCCH_EXECUTE_BENCH_API(1024, 768,   8,  64)
+void benchmark_fcch_crcf_N1024_C064_D64  FCCH_EXECUTE_BENCH_API(1024, 768,  64,  64)
+void benchmark_fcch_crcf_N4096_C050_D128 FCCH_EXECUTE_BENCH_API(4096, 3072,  50, 128)
+void benchmark_fcch_crcf_N4096_C200_D128 FCCH_EXECUTE_BENCH_API(4096, 3072, 200, 128)
+void benchmark_fcch_crcf_N4096_C200_D256 FCCH_EXECUTE_BENCH_API(4096, 3072, 200, 256)
+
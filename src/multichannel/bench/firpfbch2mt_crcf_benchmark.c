@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define FIRPFBCH2MT_EXECUTE_BENCH_API(NUM_CHANNELS,NUM_WORKERS) \
+(   struct rusage *_start,                                  \
+    struct rusage *_finish,                                 \
+    unsigned long int *_num_iterations)                     \
+{ firpfbch2mt_crcf_execute_bench(_start, _finish, _num_iterations, NUM_CHANNELS, NUM_WORKERS); }
+
+// callback: accumulate channel outputs so work is not optimized away
+int firpfbch2mt_crcf_bench_callback(float complex * _y,
+                                    unsigned int    _n,
+                                    unsigned int    _channel,
+                                    void *          _userdata)
+{
+    float complex * v = (float complex*)_userdata;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        v[_channel] += _y[i];
+    return 0;
+}
+
+// Helper function to keep code base small; note that resource usage
+// includes time spent in all threads
+void firpfbch2mt_crcf_execute_bench(struct rusage *     _start,
+                                    struct rusage *     _finish,
+                                    unsigned long int * _num_iterations,
+                                    unsigned int        _num_channels,
+                                    unsigned int        _num_workers)
+{
+    unsigned int block_len = 64;
+    float complex v[_num_channels];
+    unsigned long int i;
+    for (i=0; i<_num_channels; i++)
+        v[i] = 0.0f;
+
+    firpfbch2mt_crcf q = firpfbch2mt_crcf_create(_num_channels, 2, 60.0f, _num_workers,
+                                                 block_len, firpfbch2mt_crcf_bench_callback, v);
+
+    unsigned int num_samples = block_len*_num_channels/2;
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = 1.0f + _Complex_I*1.0f;
+
+    // scale number of iterations to keep execution time
+    // relatively linear (one iteration per M/2 input samples)
+    *_num_iterations /= _num_channels*block_len;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        firpfbch2mt_crcf_execute(q, x, num_samples);
+    firpfbch2mt_crcf_flush(q);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= block_len;
+
+    firpfbch2mt_crcf_destroy(q);
+}
+
+void benchmark_firpfbch2mt_crcf_m64_w0   FIRPFBCH2MT_EXECUTE_BENCH_API(64,   0)
+void benchmark_firpfbch2mt_crcf_m64_w1   FIRPFBCH2MT_EXECUTE_BENCH_API(64,   1)
+void benchmark_firpfbch2mt_crcf_m64_w4   FIRPFBCH2MT_EXECUTE_BENCH_API(64,   4)
+void benchmark_firpfbch2mt_crcf_m256_w0  FIRPFBCH2MT_EXECUTE_BENCH_API(256,  0)
+void benchmark_firpfbch2mt_crcf_m256_w4  FIRPFBCH2MT_EXECUTE_BENCH_API(256,  4)
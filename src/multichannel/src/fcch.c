@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// fcch.c
+//
+// fast-convolution (overlap-save) channelizer: channels at arbitrary
+// center frequencies and decimation rates sharing one forward transform
+// of the input
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// channel definition
+struct FCCH(_channel_s) {
+    float           fc;     // requested center frequency
+    unsigned int    decim;  // decimation factor
+    unsigned int    n;      // inverse transform size, nfft/decim
+    unsigned int    bin;    // center bin, 0 <= bin < nfft
+    unsigned int    group;  // index of inverse transform group
+    unsigned int    slot;   // position of channel within its group
+    unsigned int    phase;  // phase index of next block, 0 <= phase < nfft
+    float complex * H;      // filter response scaled by 1/nfft [size: n x 1]
+};
+
+// channels with the same inverse transform size, transformed together
+struct FCCH(_group_s) {
+    unsigned int    n;          // transform size
+    unsigned int    howmany;    // number of channels in group
+    float complex * Y;          // filtered bins     [size: n*howmany x 1]
+    float complex * y;          // transform outputs [size: n*howmany x 1]
+    fftplan         ifft;       // batch of inverse transforms
+};
+
+// fcch object structure definition
+struct FCCH(_s) {
+    unsigned int    nfft;   // forward transform size
+    unsigned int    hop;    // input samples consumed per transform
+
+    TI *            x;      // input buffer (last nfft samples) [size: nfft x 1]
+    float complex * X;      // input spectrum [size: nfft x 1]
+    fftplan         fft;    // forward transform
+
+    struct FCCH(_channel_s) * ch;   // channels
+    unsigned int    num_channels;   // number of channels
+    struct FCCH(_group_s) *   g;    // inverse transform groups
+    unsigned int    num_groups;     // number of groups
+};
+
+// create fast-convolution channelizer object with no channels
+//  _nfft   : forward transform size, _nfft >= 2
+//  _hop    : input samples consumed per transform, 0 < _hop <= _nfft
+FCCH() FCCH(_create)(unsigned int _nfft,
+                     unsigned int _hop)
+{
+    // validate input
+    if (_nfft < 2) {
+        fprintf(stderr,"error: fcch_%s_create(), transform size must be at least 2\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_hop == 0 || _hop > _nfft) {
+        fprintf(stderr,"error: fcch_%s_create(), hop size must be in (0,nfft]\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create object
+    FCCH() q = (FCCH()) malloc(sizeof(struct FCCH(_s)));
+    q->nfft = _nfft;
+    q->hop  = _hop;
+
+    // create forward transform
+    q->x   = (TI*)            malloc(q->nfft*sizeof(TI));
+    q->X   = (float complex*) malloc(q->nfft*sizeof(float complex));
+    q->fft = fft_create_plan(q->nfft, q->x, q->X, LIQUID_FFT_FORWARD, 0);
+
+    // no channels yet
+    q->ch           = NULL;
+    q->num_channels = 0;
+    q->g            = NULL;
+    q->num_groups   = 0;
+
+    // reset object and return
+    FCCH(_reset)(q);
+    return q;
+}
+
+// destroy fcch object, freeing internal memory
+void FCCH(_destroy)(FCCH() _q)
+{
+    unsigned int i;
+
+    // free channels
+    for (i=0; i<_q->num_channels; i++)
+        free(_q->ch[i].H);
+    free(_q->ch);
+
+    // free inverse transform groups
+    for (i=0; i<_q->num_groups; i++) {
+        fft_destroy_plan(_q->g[i].ifft);
+        free(_q->g[i].Y);
+        free(_q->g[i].y);
+    }
+    free(_q->g);
+
+    // free forward transform and buffers
+    fft_destroy_plan(_q->fft);
+    free(_q->x);
+    free(_q->X);
+
+    // free main object memory
+    free(_q);
+}
+
+// reset fcch object internals
+void FCCH(_reset)(FCCH() _q)
+{
+    // clear input buffer
+    memset(_q->x, 0x00, _q->nfft*sizeof(TI));
+
+    // reset block phase of each channel
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++)
+        _q->ch[i].phase = (unsigned int)(((unsigned long long)_q->ch[i].bin * _q->hop) % _q->nfft);
+}
+
+// print fcch object internals
+void FCCH(_print)(FCCH() _q)
+{
+    printf("fcch_%s:\n", EXTENSION_FULL);
+    printf("    nfft        :   %u\n", _q->nfft);
+    printf("    hop         :   %u\n", _q->hop);
+    printf("    channels    :   %u\n", _q->num_channels);
+    unsigned int i;
+    for (i=0; i<_q->num_channels; i++) {
+        printf("    [%3u] fc = %9.6f (bin %5u), decim = %u\n",
+                i, FCCH(_get_frequency)(_q,i), _q->ch[i].bin, _q->ch[i].decim);
+    }
+}
+
+// get forward transform size
+unsigned int FCCH(_get_nfft)(FCCH() _q)
+{
+    return _q->nfft;
+}
+
+// get number of input samples consumed by each call to execute()
+unsigned int FCCH(_get_hop)(FCCH() _q)
+{
+    return _q->hop;
+}
+
+// get number of channels
+unsigned int FCCH(_get_num_channels)(FCCH() _q)
+{
+    return _q->num_channels;
+}
+
+// get total number of output samples written by each call to execute()
+unsigned int FCCH(_get_num_outputs)(FCCH() _q)
+{
+    unsigned int i, n = 0;
+    for (i=0; i<_q->num_channels; i++)
+        n += _q->hop / _q->ch[i].decim;
+    return n;
+}
+
+// add channel from external filter coefficients, returning its index
+//  _q      : channelizer object
+//  _fc     : channel center frequency, -0.5 <= _fc <= 0.5
+//  _decim  : decimation factor, which must divide both nfft and hop
+//  _h      : filter coefficients at the input rate [size: _h_len x 1]
+//  _h_len  : filter length, 0 < _h_len <= nfft - hop + 1
+unsigned int FCCH(_add_channel)(FCCH()       _q,
+                                float        _fc,
+                                unsigned int _decim,
+                                TC *         _h,
+                                unsigned int _h_len)
+{
+    // validate input
+    if (_fc < -0.5f || _fc > 0.5f) {
+        fprintf(stderr,"error: fcch_%s_add_channel(), center frequency must be in [-0.5,0.5]\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_decim == 0 || (_q->nfft % _decim) || (_q->hop % _decim)) {
+        fprintf(stderr,"error: fcch_%s_add_channel(), decimation factor (%u) must divide nfft (%u) and hop (%u)\n",
+                EXTENSION_FULL, _decim, _q->nfft, _q->hop);
+        exit(1);
+    } else if (_h_len == 0 || _h_len > _q->nfft - _q->hop + 1) {
+        fprintf(stderr,"error: fcch_%s_add_channel(), filter length must be in (0,%u]\n",
+                EXTENSION_FULL, _q->nfft - _q->hop + 1);
+        exit(1);
+    }
+
+    unsigned int nfft = _q->nfft;
+    unsigned int n    = nfft / _decim;
+
+    // find (or create) group of channels with the same transform size
+    unsigned int i;
+    for (i=0; i<_q->num_groups; i++) {
+        if (_q->g[i].n == n)
+            break;
+    }
+    if (i == _q->num_groups) {
+        _q->num_groups++;
+        _q->g = (struct FCCH(_group_s)*) realloc(_q->g, _q->num_groups*sizeof(struct FCCH(_group_s)));
+        _q->g[i].n       = n;
+        _q->g[i].howmany = 0;
+        _q->g[i].Y       = NULL;
+        _q->g[i].y       = NULL;
+        _q->g[i].ifft    = NULL;
+    }
+    struct FCCH(_group_s) * g = &_q->g[i];
+
+    // grow group buffers and re-create its batch of transforms
+    g->howmany++;
+    g->Y = (float complex*) realloc(g->Y, n*g->howmany*sizeof(float complex));
+    g->y = (float complex*) realloc(g->y, n*g->howmany*sizeof(float complex));
+    if (g->ifft != NULL)
+        fft_destroy_plan(g->ifft);
+    g->ifft = fft_create_plan_many(n, g->howmany, g->Y, 1, n, g->y, 1, n, LIQUID_FFT_BACKWARD, 0);
+
+    // append channel
+    _q->num_channels++;
+    _q->ch = (struct FCCH(_channel_s)*) realloc(_q->ch, _q->num_channels*sizeof(struct FCCH(_channel_s)));
+    struct FCCH(_channel_s) * c = &_q->ch[_q->num_channels-1];
+    int bin = (int)roundf(_fc * (float)nfft);
+    c->fc    = _fc;
+    c->decim = _decim;
+    c->n     = n;
+    c->bin   = (unsigned int)((bin % (int)nfft + (int)nfft) % (int)nfft);
+    c->group = i;
+    c->slot  = g->howmany - 1;
+    c->phase = (unsigned int)(((unsigned long long)c->bin * _q->hop) % nfft);
+
+    // Compute filter response on the forward transform's grid and keep
+    // the n bins nearest DC, in transform order: offsets 0, 1, ... and
+    // then -1, -2, ... from the end. Including 1/nfft here normalizes
+    // the inverse transform.
+    float complex * hc = (float complex*) malloc(nfft*sizeof(float complex));
+    float complex * Hc = (float complex*) malloc(nfft*sizeof(float complex));
+    for (i=0; i<nfft; i++)
+        hc[i] = i < _h_len ? _h[i] : 0.0f;
+    fft_run(nfft, hc, Hc, LIQUID_FFT_FORWARD, 0);
+    c->H = (float complex*) malloc(n*sizeof(float complex));
+    for (i=0; i<n; i++)
+        c->H[i] = Hc[i <= (n-1)/2 ? i : nfft - n + i] / (float)nfft;
+    free(hc);
+    free(Hc);
+
+    return _q->num_channels - 1;
+}
+
+// add channel with a Kaiser-window filter, returning its index
+//  _q      : channelizer object
+//  _fc     : channel center frequency, -0.5 <= _fc <= 0.5
+//  _decim  : decimation factor, which must divide both nfft and hop
+//  _bw     : filter cut-off frequency, 0 < _bw < 0.5
+//  _As     : filter stop-band attenuation [dB], _As > 0
+unsigned int FCCH(_add_channel_kaiser)(FCCH()       _q,
+                                       float        _fc,
+                                       unsigned int _decim,
+                                       float        _bw,
+                                       float        _As)
+{
+    // validate input
+    if (_bw <= 0.0f || _bw >= 0.5f) {
+        fprintf(stderr,"error: fcch_%s_add_channel_kaiser(), filter cut-off must be in (0,0.5)\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_As <= 0.0f) {
+        fprintf(stderr,"error: fcch_%s_add_channel_kaiser(), stop-band attenuation must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // design filter of the longest length that avoids aliasing in the
+    // retained portion of each block, normalized to unity gain at DC
+    unsigned int h_len = _q->nfft - _q->hop + 1;
+    float hf[h_len];
+    liquid_firdes_kaiser(h_len, _bw, _As, 0.0f, hf);
+    float hf_sum = 0.0f;
+    unsigned int i;
+    for (i=0; i<h_len; i++) hf_sum += hf[i];
+
+    TC h[h_len];
+    for (i=0; i<h_len; i++)
+        h[i] = hf[i] / hf_sum;
+
+    return FCCH(_add_channel)(_q, _fc, _decim, h, h_len);
+}
+
+// get decimation factor of channel _i
+unsigned int FCCH(_get_decim)(FCCH()       _q,
+                              unsigned int _i)
+{
+    if (_i >= _q->num_channels) {
+        fprintf(stderr,"error: fcch_%s_get_decim(), channel index (%u) exceeds maximum (%u)\n",
+                EXTENSION_FULL, _i, _q->num_channels);
+        exit(1);
+    }
+    return _q->ch[_i].decim;
+}
+
+// get (rounded) center frequency of channel _i
+float FCCH(_get_frequency)(FCCH()       _q,
+                           unsigned int _i)
+{
+    if (_i >= _q->num_channels) {
+        fprintf(stderr,"error: fcch_%s_get_frequency(), channel index (%u) exceeds maximum (%u)\n",
+                EXTENSION_FULL, _i, _q->num_channels);
+        exit(1);
+    }
+    unsigned int bin = _q->ch[_i].bin;
+    float fc = (float)bin / (float)_q->nfft;
+    return 2*bin > _q->nfft ? fc - 1.0f : fc;
+}
+
+// execute channelizer on a block of _hop input samples
+//  _q      : channelizer object
+//  _x      : input array [size: _hop x 1]
+//  _y      : output array [size: get_num_outputs() x 1]
+void FCCH(_execute)(FCCH() _q,
+                    TI *   _x,
+                    TO *   _y)
+{
+    unsigned int nfft = _q->nfft;
+    unsigned int hop  = _q->hop;
+    unsigned int i, k;
+
+    // slide input buffer and run forward transform
+    memmove(_q->x, _q->x + hop, (nfft - hop)*sizeof(TI));
+    memmove(_q->x + nfft - hop, _x, hop*sizeof(TI));
+    fft_execute(_q->fft);
+
+    // select bins around each channel's center and apply its filter
+    for (k=0; k<_q->num_channels; k++) {
+        struct FCCH(_channel_s) * c = &_q->ch[k];
+        float complex * Y = _q->g[c->group].Y + c->slot*c->n;
+        unsigned int n  = c->n;
+        unsigned int np = (n-1)/2 + 1;  // non-negative offsets
+
+        // offsets 0..np-1 from bin, wrapping at nfft
+        unsigned int b = c->bin;
+        for (i=0; i<np; i++) {
+            Y[i] = _q->X[b] * c->H[i];
+            b = b + 1 == nfft ? 0 : b + 1;
+        }
+
+        // offsets -(n-np)..-1
+        b = c->bin + nfft - (n - np);
+        b = b >= nfft ? b - nfft : b;
+        for (i=np; i<n; i++) {
+            Y[i] = _q->X[b] * c->H[i];
+            b = b + 1 == nfft ? 0 : b + 1;
+        }
+    }
+
+    // run inverse transforms, batched by size
+    for (i=0; i<_q->num_groups; i++)
+        fft_execute(_q->g[i].ifft);
+
+    // Keep the last hop/decim samples of each inverse transform (earlier
+    // samples are corrupted by circular wrap-around) and correct for the
+    // phase of the channel's carrier at the start of the block.
+    for (k=0; k<_q->num_channels; k++) {
+        struct FCCH(_channel_s) * c = &_q->ch[k];
+        unsigned int    n_out = hop / c->decim;
+        float complex * y     = _q->g[c->group].y + c->slot*c->n + c->n - n_out;
+        if (c->phase == 0) {
+            memmove(_y, y, n_out*sizeof(TO));
+        } else {
+            float complex r = cexpf(-_Complex_I*2*M_PI*(float)c->phase/(float)nfft);
+            for (i=0; i<n_out; i++)
+                _y[i] = y[i] * r;
+        }
+        _y += n_out;
+
+        // advance carrier phase by hop samples
+        c->phase = (unsigned int)((c->phase + (unsigned long long)c->bin * hop) % nfft);
+    }
+}
+
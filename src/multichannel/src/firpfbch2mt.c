@@ -0,0 +1,577 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// firpfbch2mt.c
+//
+// threaded firpfbch2 analyzer: a producer thread runs the filterbank and
+// a pool of worker threads passes each channel's output to a callback
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+// number of slots in each ring buffer
+#define FIRPFBCH2MT_NUM_SLOTS   (4)
+
+// slot flags
+#define FIRPFBCH2MT_FLUSH       (1)     // acknowledge once slot is consumed
+#define FIRPFBCH2MT_STOP        (2)     // consumer thread exits
+
+#if HAVE_PTHREAD_H
+// Single-producer, single-consumer ring of fixed-size slots. The head and
+// tail counters are published with atomic stores; a thread only takes
+// the mutex to sleep when the ring is full (producer) or empty
+// (consumer), and the other side only takes it to wake a sleeper.
+struct FIRPFBCH2MT(_ring_s) {
+    unsigned int    slot_len;   // samples per slot
+    TO *            buf;        // slot memory [size: NUM_SLOTS*slot_len x 1]
+    unsigned int    n   [FIRPFBCH2MT_NUM_SLOTS];   // samples in each slot
+    int             flag[FIRPFBCH2MT_NUM_SLOTS];   // flags of each slot
+    unsigned int    head;       // number of slots written
+    unsigned int    tail;       // number of slots read
+    int             wait_read;  // consumer is sleeping (ring empty)
+    int             wait_write; // producer is sleeping (ring full)
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+};
+#endif
+
+// threaded analyzer object
+struct FIRPFBCH2MT(_s) {
+    unsigned int    M;              // number of channels
+    unsigned int    m;              // prototype filter semi-length
+    unsigned int    num_workers;    // number of worker threads
+    unsigned int    block_len;      // output samples per channel per callback
+    FIRPFBCH2()     ch;             // analysis filterbank
+    TO *            Y;              // filterbank output [size: M x 1]
+
+    FIRPFBCH2MT(_callback) callback;
+    void *          userdata;
+
+    // inline operation: outputs staged by channel [size: M*block_len x 1]
+    TO *            y;
+    unsigned int    t;              // outputs staged per channel
+
+#if HAVE_PTHREAD_H
+    // input ring (caller to producer) and worker rings (producer to workers)
+    struct FIRPFBCH2MT(_ring_s)   input;
+    struct FIRPFBCH2MT(_ring_s) * rings;
+    unsigned int    n_in;           // samples staged in current input slot
+
+    pthread_t       producer;
+    pthread_t *     workers;
+
+    // flush acknowledgements from workers
+    pthread_mutex_t flush_mutex;
+    pthread_cond_t  flush_cond;
+    unsigned long   flush_acks;     // number received
+    unsigned long   flush_count;    // number of flushes requested
+#endif
+};
+
+// internal: run the filterbank over input samples, staging outputs by
+// channel and passing full blocks to _dispatch
+void FIRPFBCH2MT(_analyze)(FIRPFBCH2MT() _q,
+                           TI *          _x,
+                           unsigned int  _n);
+
+// internal: pass staged outputs on (to callbacks or to worker rings)
+void FIRPFBCH2MT(_dispatch)(FIRPFBCH2MT() _q,
+                            int           _flag);
+
+#if HAVE_PTHREAD_H
+void   FIRPFBCH2MT(_ring_init)       (struct FIRPFBCH2MT(_ring_s) * _r, unsigned int _slot_len);
+void   FIRPFBCH2MT(_ring_free)       (struct FIRPFBCH2MT(_ring_s) * _r);
+TO *   FIRPFBCH2MT(_ring_write_begin)(struct FIRPFBCH2MT(_ring_s) * _r);
+void   FIRPFBCH2MT(_ring_write_end)  (struct FIRPFBCH2MT(_ring_s) * _r, unsigned int _n, int _flag);
+TO *   FIRPFBCH2MT(_ring_read_begin) (struct FIRPFBCH2MT(_ring_s) * _r, unsigned int * _n, int * _flag);
+void   FIRPFBCH2MT(_ring_read_end)   (struct FIRPFBCH2MT(_ring_s) * _r);
+void * FIRPFBCH2MT(_producer_thread) (void * _arg);
+void * FIRPFBCH2MT(_worker_thread)   (void * _arg);
+
+// worker thread argument
+struct FIRPFBCH2MT(_worker_s) {
+    FIRPFBCH2MT()   q;
+    unsigned int    index;
+};
+#endif
+
+// create threaded analyzer using Kaiser window prototype
+//  _M          : number of channels (must be even)
+//  _m          : prototype filter semi-length, length=2*M*m+1
+//  _As         : filter stop-band attenuation [dB]
+//  _num_workers: number of worker threads; 0 runs the analyzer and
+//                callbacks on the calling thread
+//  _block_len  : output samples per channel per callback
+//  _callback   : user-defined callback function
+//  _userdata   : user-defined data pointer
+FIRPFBCH2MT() FIRPFBCH2MT(_create)(unsigned int           _M,
+                                   unsigned int           _m,
+                                   float                  _As,
+                                   unsigned int           _num_workers,
+                                   unsigned int           _block_len,
+                                   FIRPFBCH2MT(_callback) _callback,
+                                   void *                 _userdata)
+{
+    // validate input (filterbank parameters are validated on creation)
+    if (_block_len == 0) {
+        fprintf(stderr,"error: firpfbch2mt_%s_create(), block length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_callback == NULL) {
+        fprintf(stderr,"error: firpfbch2mt_%s_create(), callback must not be NULL\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_num_workers > _M) {
+        fprintf(stderr,"error: firpfbch2mt_%s_create(), number of workers (%u) exceeds number of channels (%u)\n",
+                EXTENSION_FULL, _num_workers, _M);
+        exit(1);
+    }
+
+    FIRPFBCH2MT() q = (FIRPFBCH2MT()) malloc(sizeof(struct FIRPFBCH2MT(_s)));
+    q->ch          = FIRPFBCH2(_create_kaiser)(LIQUID_ANALYZER, _M, _m, _As);
+    q->M           = _M;
+    q->m           = _m;
+    q->block_len   = _block_len;
+    q->callback    = _callback;
+    q->userdata    = _userdata;
+    q->Y           = (TO*) malloc(q->M*sizeof(TO));
+    q->y           = NULL;
+    q->t           = 0;
+#if HAVE_PTHREAD_H
+    q->num_workers = _num_workers;
+#else
+    // run on calling thread
+    q->num_workers = 0;
+#endif
+
+    if (q->num_workers == 0) {
+        q->y = (TO*) malloc(q->M*q->block_len*sizeof(TO));
+        return q;
+    }
+
+#if HAVE_PTHREAD_H
+    // input ring holds block_len filterbank steps per slot; worker w
+    // serves channels w, w+W, w+2W, ... with each slot holding block_len
+    // samples for each of them
+    unsigned int W = q->num_workers;
+    unsigned int w;
+    FIRPFBCH2MT(_ring_init)(&q->input, q->block_len*q->M/2);
+    q->n_in  = 0;
+    q->rings = (struct FIRPFBCH2MT(_ring_s)*) malloc(W*sizeof(struct FIRPFBCH2MT(_ring_s)));
+    for (w=0; w<W; w++)
+        FIRPFBCH2MT(_ring_init)(&q->rings[w], ((q->M - w + W - 1)/W)*q->block_len);
+
+    pthread_mutex_init(&q->flush_mutex, NULL);
+    pthread_cond_init (&q->flush_cond,  NULL);
+    q->flush_acks  = 0;
+    q->flush_count = 0;
+
+    // start threads
+    q->workers = (pthread_t*) malloc(W*sizeof(pthread_t));
+    struct FIRPFBCH2MT(_worker_s) * args =
+        (struct FIRPFBCH2MT(_worker_s)*) malloc(W*sizeof(struct FIRPFBCH2MT(_worker_s)));
+    for (w=0; w<W; w++) {
+        args[w].q     = q;
+        args[w].index = w;
+        if (pthread_create(&q->workers[w], NULL, FIRPFBCH2MT(_worker_thread), &args[w]) != 0)
+            break;
+    }
+    if (w == W && pthread_create(&q->producer, NULL, FIRPFBCH2MT(_producer_thread), args) == 0)
+        return q;
+
+    // could not start all threads: stop those already running and run on
+    // the calling thread instead
+    fprintf(stderr,"warning: firpfbch2mt_%s_create(), could not start threads; running without workers\n",
+            EXTENSION_FULL);
+    unsigned int num_started = w;
+    for (w=0; w<num_started; w++) {
+        FIRPFBCH2MT(_ring_write_begin)(&q->rings[w]);
+        FIRPFBCH2MT(_ring_write_end)(&q->rings[w], 0, FIRPFBCH2MT_STOP);
+        pthread_join(q->workers[w], NULL);
+    }
+    for (w=0; w<W; w++)
+        FIRPFBCH2MT(_ring_free)(&q->rings[w]);
+    free(args);
+    free(q->workers);
+    free(q->rings);
+    FIRPFBCH2MT(_ring_free)(&q->input);
+    pthread_mutex_destroy(&q->flush_mutex);
+    pthread_cond_destroy (&q->flush_cond);
+    q->num_workers = 0;
+    q->y = (TO*) malloc(q->M*q->block_len*sizeof(TO));
+#endif
+    return q;
+}
+
+// destroy object, delivering all pending outputs to the callbacks
+// before stopping threads and freeing memory
+void FIRPFBCH2MT(_destroy)(FIRPFBCH2MT() _q)
+{
+    FIRPFBCH2MT(_flush)(_q);
+
+#if HAVE_PTHREAD_H
+    if (_q->num_workers > 0) {
+        // stop producer, which stops each worker
+        FIRPFBCH2MT(_ring_write_begin)(&_q->input);
+        FIRPFBCH2MT(_ring_write_end)(&_q->input, 0, FIRPFBCH2MT_STOP);
+
+        void * args;
+        pthread_join(_q->producer, &args);
+        unsigned int w;
+        for (w=0; w<_q->num_workers; w++) {
+            pthread_join(_q->workers[w], NULL);
+            FIRPFBCH2MT(_ring_free)(&_q->rings[w]);
+        }
+        free(args);
+        free(_q->workers);
+        free(_q->rings);
+        FIRPFBCH2MT(_ring_free)(&_q->input);
+        pthread_mutex_destroy(&_q->flush_mutex);
+        pthread_cond_destroy (&_q->flush_cond);
+    }
+#endif
+
+    FIRPFBCH2(_destroy)(_q->ch);
+    free(_q->Y);
+    free(_q->y);
+    free(_q);
+}
+
+// deliver pending outputs, then reset the filterbank
+void FIRPFBCH2MT(_reset)(FIRPFBCH2MT() _q)
+{
+    // once flushed, the producer is idle until more input arrives
+    FIRPFBCH2MT(_flush)(_q);
+    FIRPFBCH2(_reset)(_q->ch);
+}
+
+// print object internals
+void FIRPFBCH2MT(_print)(FIRPFBCH2MT() _q)
+{
+    printf("firpfbch2mt_%s:\n", EXTENSION_FULL);
+    printf("    channels    :   %u\n", _q->M);
+    printf("    semi-length :   %u\n", _q->m);
+    printf("    workers     :   %u\n", _q->num_workers);
+    printf("    block length:   %u\n", _q->block_len);
+}
+
+// get number of channels
+unsigned int FIRPFBCH2MT(_get_M)(FIRPFBCH2MT() _q)
+{
+    return _q->M;
+}
+
+// get number of worker threads
+unsigned int FIRPFBCH2MT(_get_num_workers)(FIRPFBCH2MT() _q)
+{
+    return _q->num_workers;
+}
+
+// push block of input samples into the pipeline
+//  _q      : channelizer object
+//  _x      : input samples [size: _n x 1]
+//  _n      : number of input samples, a multiple of M/2
+void FIRPFBCH2MT(_execute)(FIRPFBCH2MT() _q,
+                           TI *          _x,
+                           unsigned int  _n)
+{
+    if (_n % (_q->M/2)) {
+        fprintf(stderr,"error: firpfbch2mt_%s_execute(), number of samples (%u) must be a multiple of M/2 (%u)\n",
+                EXTENSION_FULL, _n, _q->M/2);
+        exit(1);
+    }
+
+    if (_q->num_workers == 0) {
+        FIRPFBCH2MT(_analyze)(_q, _x, _n);
+        return;
+    }
+
+#if HAVE_PTHREAD_H
+    // fill input slots, committing each as it becomes full
+    unsigned int slot_len = _q->input.slot_len;
+    while (_n > 0) {
+        TO * v = FIRPFBCH2MT(_ring_write_begin)(&_q->input);
+        unsigned int k = _n < slot_len - _q->n_in ? _n : slot_len - _q->n_in;
+        memmove(v + _q->n_in, _x, k*sizeof(TI));
+        _q->n_in += k;
+        _x       += k;
+        _n       -= k;
+        if (_q->n_in == slot_len) {
+            FIRPFBCH2MT(_ring_write_end)(&_q->input, slot_len, 0);
+            _q->n_in = 0;
+        }
+    }
+#endif
+}
+
+// wait until outputs for all input pushed so far have been passed to
+// the callbacks, including partial blocks
+void FIRPFBCH2MT(_flush)(FIRPFBCH2MT() _q)
+{
+    if (_q->num_workers == 0) {
+        FIRPFBCH2MT(_dispatch)(_q, 0);
+        return;
+    }
+
+#if HAVE_PTHREAD_H
+    // commit staged input with a flush request, which the producer
+    // forwards to every worker after the input has been processed
+    FIRPFBCH2MT(_ring_write_begin)(&_q->input);
+    FIRPFBCH2MT(_ring_write_end)(&_q->input, _q->n_in, FIRPFBCH2MT_FLUSH);
+    _q->n_in = 0;
+
+    pthread_mutex_lock(&_q->flush_mutex);
+    _q->flush_count++;
+    while (_q->flush_acks < _q->flush_count*_q->num_workers)
+        pthread_cond_wait(&_q->flush_cond, &_q->flush_mutex);
+    pthread_mutex_unlock(&_q->flush_mutex);
+#endif
+}
+
+//
+// internal methods
+//
+
+// run the filterbank over input samples, staging outputs by channel
+//  _q      : channelizer object
+//  _x      : input samples [size: _n x 1]
+//  _n      : number of input samples, a multiple of M/2
+void FIRPFBCH2MT(_analyze)(FIRPFBCH2MT() _q,
+                           TI *          _x,
+                           unsigned int  _n)
+{
+    unsigned int M = _q->M;
+    unsigned int i, k;
+    for (i=0; i<_n; i+=M/2) {
+        // stage buffers are acquired with the first sample of each block
+        if (_q->t == 0)
+            FIRPFBCH2MT(_dispatch)(_q, -1);
+
+        FIRPFBCH2(_execute)(_q->ch, &_x[i], _q->Y);
+
+#if HAVE_PTHREAD_H
+        if (_q->num_workers > 0) {
+            // channel k = w + j*W goes to slot position j of worker w
+            unsigned int W = _q->num_workers;
+            for (k=0; k<M; k++) {
+                TO * v = _q->rings[k % W].buf +
+                         (_q->rings[k % W].head % FIRPFBCH2MT_NUM_SLOTS)*_q->rings[k % W].slot_len;
+                v[(k / W)*_q->block_len + _q->t] = _q->Y[k];
+            }
+        } else
+#endif
+        {
+            for (k=0; k<M; k++)
+                _q->y[k*_q->block_len + _q->t] = _q->Y[k];
+        }
+
+        if (++_q->t == _q->block_len)
+            FIRPFBCH2MT(_dispatch)(_q, 0);
+    }
+}
+
+// pass staged outputs on: to the callbacks directly when running on the
+// calling thread, otherwise by committing a slot to each worker ring
+//  _q      : channelizer object
+//  _flag   : slot flags, or -1 to acquire slots for a new block
+void FIRPFBCH2MT(_dispatch)(FIRPFBCH2MT() _q,
+                            int           _flag)
+{
+    unsigned int k, w;
+    if (_q->num_workers == 0) {
+        if (_flag < 0)
+            return;
+        if (_q->t > 0) {
+            for (k=0; k<_q->M; k++)
+                _q->callback(&_q->y[k*_q->block_len], _q->t, k, _q->userdata);
+        }
+        _q->t = 0;
+        return;
+    }
+
+#if HAVE_PTHREAD_H
+    if (_flag < 0) {
+        // wait for a free slot in every worker ring
+        for (w=0; w<_q->num_workers; w++)
+            FIRPFBCH2MT(_ring_write_begin)(&_q->rings[w]);
+        return;
+    }
+
+    // flushing without staged outputs still needs a slot to carry the flag
+    if (_q->t == 0 && _flag == 0)
+        return;
+    if (_q->t == 0)
+        FIRPFBCH2MT(_dispatch)(_q, -1);
+    for (w=0; w<_q->num_workers; w++)
+        FIRPFBCH2MT(_ring_write_end)(&_q->rings[w], _q->t, _flag);
+    _q->t = 0;
+#endif
+}
+
+#if HAVE_PTHREAD_H
+// producer: run filterbank on input slots until stopped
+void * FIRPFBCH2MT(_producer_thread)(void * _arg)
+{
+    struct FIRPFBCH2MT(_worker_s) * args = (struct FIRPFBCH2MT(_worker_s)*) _arg;
+    FIRPFBCH2MT() q = args[0].q;
+    for (;;) {
+        unsigned int n;
+        int flag;
+        TO * v = FIRPFBCH2MT(_ring_read_begin)(&q->input, &n, &flag);
+        FIRPFBCH2MT(_analyze)(q, v, n);
+        FIRPFBCH2MT(_ring_read_end)(&q->input);
+
+        // forward flush and stop requests with any partial block
+        if (flag)
+            FIRPFBCH2MT(_dispatch)(q, flag);
+        if (flag & FIRPFBCH2MT_STOP)
+            break;
+    }
+
+    // return worker arguments so they can be freed once threads join
+    return _arg;
+}
+
+// worker: pass each channel's outputs in each slot to the callback
+void * FIRPFBCH2MT(_worker_thread)(void * _arg)
+{
+    struct FIRPFBCH2MT(_worker_s) * args = (struct FIRPFBCH2MT(_worker_s)*) _arg;
+    FIRPFBCH2MT() q = args->q;
+    unsigned int  w = args->index;
+    unsigned int  W = q->num_workers;
+    struct FIRPFBCH2MT(_ring_s) * r = &q->rings[w];
+    for (;;) {
+        unsigned int n;
+        int flag;
+        TO * v = FIRPFBCH2MT(_ring_read_begin)(r, &n, &flag);
+        unsigned int k, j;
+        for (k=w, j=0; n > 0 && k<q->M; k+=W, j++)
+            q->callback(&v[j*q->block_len], n, k, q->userdata);
+        FIRPFBCH2MT(_ring_read_end)(r);
+
+        if (flag & FIRPFBCH2MT_FLUSH) {
+            pthread_mutex_lock(&q->flush_mutex);
+            q->flush_acks++;
+            pthread_cond_broadcast(&q->flush_cond);
+            pthread_mutex_unlock(&q->flush_mutex);
+        }
+        if (flag & FIRPFBCH2MT_STOP)
+            break;
+    }
+    return NULL;
+}
+
+// initialize ring buffer
+void FIRPFBCH2MT(_ring_init)(struct FIRPFBCH2MT(_ring_s) * _r,
+                             unsigned int                  _slot_len)
+{
+    _r->slot_len   = _slot_len;
+    _r->buf        = (TO*) malloc(FIRPFBCH2MT_NUM_SLOTS*_slot_len*sizeof(TO));
+    _r->head       = 0;
+    _r->tail       = 0;
+    _r->wait_read  = 0;
+    _r->wait_write = 0;
+    pthread_mutex_init(&_r->mutex, NULL);
+    pthread_cond_init (&_r->cond,  NULL);
+}
+
+// free ring buffer memory
+void FIRPFBCH2MT(_ring_free)(struct FIRPFBCH2MT(_ring_s) * _r)
+{
+    free(_r->buf);
+    pthread_mutex_destroy(&_r->mutex);
+    pthread_cond_destroy (&_r->cond);
+}
+
+// get next slot to write, waiting while the ring is full (producer only)
+TO * FIRPFBCH2MT(_ring_write_begin)(struct FIRPFBCH2MT(_ring_s) * _r)
+{
+    unsigned int head = _r->head;
+    if (head - __atomic_load_n(&_r->tail, __ATOMIC_SEQ_CST) == FIRPFBCH2MT_NUM_SLOTS) {
+        // Announce the wait before re-checking: either the consumer sees
+        // the flag after releasing a slot, or this thread sees the slot.
+        pthread_mutex_lock(&_r->mutex);
+        __atomic_store_n(&_r->wait_write, 1, __ATOMIC_SEQ_CST);
+        while (head - __atomic_load_n(&_r->tail, __ATOMIC_SEQ_CST) == FIRPFBCH2MT_NUM_SLOTS)
+            pthread_cond_wait(&_r->cond, &_r->mutex);
+        __atomic_store_n(&_r->wait_write, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&_r->mutex);
+    }
+    return _r->buf + (head % FIRPFBCH2MT_NUM_SLOTS)*_r->slot_len;
+}
+
+// publish slot (producer only)
+void FIRPFBCH2MT(_ring_write_end)(struct FIRPFBCH2MT(_ring_s) * _r,
+                                  unsigned int                  _n,
+                                  int                           _flag)
+{
+    unsigned int head = _r->head;
+    _r->n   [head % FIRPFBCH2MT_NUM_SLOTS] = _n;
+    _r->flag[head % FIRPFBCH2MT_NUM_SLOTS] = _flag;
+    __atomic_store_n(&_r->head, head + 1, __ATOMIC_SEQ_CST);
+
+    // wake consumer if it is waiting for data
+    if (__atomic_load_n(&_r->wait_read, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&_r->mutex);
+        pthread_cond_broadcast(&_r->cond);
+        pthread_mutex_unlock(&_r->mutex);
+    }
+}
+
+// get next slot to read, waiting while the ring is empty (consumer only)
+TO * FIRPFBCH2MT(_ring_read_begin)(struct FIRPFBCH2MT(_ring_s) * _r,
+                                   unsigned int *                _n,
+                                   int *                         _flag)
+{
+    unsigned int tail = _r->tail;
+    if (__atomic_load_n(&_r->head, __ATOMIC_SEQ_CST) == tail) {
+        pthread_mutex_lock(&_r->mutex);
+        __atomic_store_n(&_r->wait_read, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&_r->head, __ATOMIC_SEQ_CST) == tail)
+            pthread_cond_wait(&_r->cond, &_r->mutex);
+        __atomic_store_n(&_r->wait_read, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&_r->mutex);
+    }
+    *_n    = _r->n   [tail % FIRPFBCH2MT_NUM_SLOTS];
+    *_flag = _r->flag[tail % FIRPFBCH2MT_NUM_SLOTS];
+    return _r->buf + (tail % FIRPFBCH2MT_NUM_SLOTS)*_r->slot_len;
+}
+
+// release slot (consumer only)
+void FIRPFBCH2MT(_ring_read_end)(struct FIRPFBCH2MT(_ring_s) * _r)
+{
+    __atomic_store_n(&_r->tail, _r->tail + 1, __ATOMIC_SEQ_CST);
+
+    // wake producer if it is waiting for space
+    if (__atomic_load_n(&_r->wait_write, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&_r->mutex);
+        pthread_cond_broadcast(&_r->cond);
+        pthread_mutex_unlock(&_r->mutex);
+    }
+}
+#endif
+
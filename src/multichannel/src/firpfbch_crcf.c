@@ -33,7 +33,9 @@
 // 
 #define FIRPFBCH(name)      LIQUID_CONCAT(firpfbch_crcf,name)
 #define FIRPFBCH2(name)     LIQUID_CONCAT(firpfbch2_crcf,name)
+#define FIRPFBCH2MT(name)   LIQUID_CONCAT(firpfbch2mt_crcf,name)
 #define FIRPFBCHR(name)     LIQUID_CONCAT(firpfbchr_crcf,name)
+#define FCCH(name)          LIQUID_CONCAT(fcch_crcf,name)
 
 #define T                   float complex   // general
 #define TO                  float complex   // output
@@ -53,5 +55,7 @@
 // source files
 #include "firpfbch.c"       // maximally-decimated polyphase filterbank
 #include "firpfbch2.c"      // polyphase filterbank w/ output rate 2 Fs / M
+#include "firpfbch2mt.c"    // threaded firpfbch2 analyzer, per-channel workers
 #include "firpfbchr.c"      // polyphase filterbank w/ output rate P Fs / M
+#include "fcch.c"           // fast-convolution channelizer, arbitrary channels
 
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// Compare each channel against mixing the input down to the channel's
+// (rounded) center frequency, filtering in the time domain, and
+// decimating. With decim = 1 the two are identical; otherwise they
+// differ only by the filter response beyond the channel's retained bins,
+// so filters are designed with their stop band inside those bins.
+void fcch_crcf_runtest(unsigned int   _nfft,
+                       unsigned int   _hop,
+                       unsigned int   _num_channels,
+                       float *        _fc,
+                       unsigned int * _decim,
+                       float          _tol)
+{
+    unsigned int num_blocks  = 12;
+    unsigned int num_samples = num_blocks*_hop;
+    unsigned int h_len       = _nfft - _hop + 1;
+    unsigned int i, j, k, b;
+
+    // input: noise
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = (randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+
+    // create channelizer, each channel with a filter matched to its rate
+    fcch_crcf q = fcch_crcf_create(_nfft, _hop);
+    float h[_num_channels][h_len];
+    for (k=0; k<_num_channels; k++) {
+        liquid_firdes_kaiser(h_len, 0.25f/(float)_decim[k], 80.0f, 0.0f, h[k]);
+        CONTEND_EQUALITY(fcch_crcf_add_channel(q, _fc[k], _decim[k], h[k], h_len), k);
+    }
+    CONTEND_EQUALITY(fcch_crcf_get_num_channels(q), _num_channels);
+
+    // run channelizer, keeping the outputs of each channel contiguous
+    unsigned int num_outputs = fcch_crcf_get_num_outputs(q);
+    float complex y[num_blocks*num_outputs];
+    float complex * y_block = (float complex*) malloc(num_outputs*sizeof(float complex));
+    unsigned int offset[_num_channels];
+    for (k=0, i=0; k<_num_channels; k++) {
+        offset[k] = i;
+        i += num_blocks * (_hop/_decim[k]);
+    }
+    for (b=0; b<num_blocks; b++) {
+        fcch_crcf_execute(q, &x[b*_hop], y_block);
+        float complex * r = y_block;
+        for (k=0; k<_num_channels; k++) {
+            unsigned int n = _hop/_decim[k];
+            for (i=0; i<n; i++)
+                y[offset[k] + b*n + i] = r[i];
+            r += n;
+        }
+    }
+
+    // compare to reference
+    for (k=0; k<_num_channels; k++) {
+        // center frequency is rounded to the transform's bin spacing
+        float fc = fcch_crcf_get_frequency(q, k);
+        float df = fc - _fc[k];
+        CONTEND_DELTA(df - roundf(df), 0.0f, 0.5f/(float)_nfft);
+        CONTEND_EQUALITY(fcch_crcf_get_decim(q, k), _decim[k]);
+        int bin = (int)roundf(fc*(float)_nfft);
+        bin = bin < 0 ? bin + _nfft : bin;
+
+        unsigned int num_out = num_blocks * (_hop/_decim[k]);
+        float rmse = 0.0f;
+        for (i=0; i<num_out; i++) {
+            unsigned int n = i*_decim[k];
+            float complex v = 0.0f;
+            for (j=0; j<h_len && j<=n; j++)
+                v += h[k][j] * x[n-j] * cexpf(-_Complex_I*2*M_PI*(float)((bin*(n-j)) % _nfft)/(float)_nfft);
+            float complex e = y[offset[k] + i] - v;
+            rmse += crealf(e*conjf(e));
+        }
+        rmse = sqrtf(rmse / (float)num_out);
+        if (liquid_autotest_verbose)
+            printf("  channel %2u, fc=%9.6f, decim=%3u : rmse = %12.4e\n", k, fc, _decim[k], rmse);
+        CONTEND_LESS_THAN(rmse, _tol);
+    }
+
+    free(y_block);
+    fcch_crcf_destroy(q);
+}
+
+void autotest_fcch_crcf_decim1()
+{
+    float        fc[]    = {0.0f, 0.1875f, -0.25f, 0.5f};
+    unsigned int decim[] = {1, 1, 1, 1};
+    fcch_crcf_runtest(64, 32, 4, fc, decim, 1e-5f);
+}
+
+void autotest_fcch_crcf_radix2()
+{
+    float        fc[]    = {0.0f, 0.13f, -0.377f, 0.49f, -0.5f, 0.2f};
+    unsigned int decim[] = {4, 8, 16, 16, 8, 2};
+    fcch_crcf_runtest(256, 64, 6, fc, decim, 1e-3f);
+}
+
+void autotest_fcch_crcf_mixed()
+{
+    float        fc[]    = {0.011f, -0.2f, 0.3f, -0.45f};
+    unsigned int decim[] = {5, 6, 12, 3};
+    fcch_crcf_runtest(240, 60, 4, fc, decim, 1e-3f);
+}
+
+// resetting the channelizer clears its buffer and carrier phases, so
+// running the same input again reproduces the same output
+void autotest_fcch_crcf_reset()
+{
+    unsigned int nfft = 128, hop = 96, num_blocks = 4;
+    fcch_crcf q = fcch_crcf_create(nfft, hop);
+    fcch_crcf_add_channel_kaiser(q,  0.1f,  4, 0.1f,  60.0f);
+    fcch_crcf_add_channel_kaiser(q, -0.33f, 8, 0.05f, 60.0f);
+    CONTEND_EQUALITY(fcch_crcf_get_nfft(q), nfft);
+    CONTEND_EQUALITY(fcch_crcf_get_hop(q),  hop);
+
+    unsigned int num_outputs = fcch_crcf_get_num_outputs(q);
+    CONTEND_EQUALITY(num_outputs, hop/4 + hop/8);
+
+    float complex x[num_blocks*hop];
+    float complex y0[num_blocks*num_outputs];
+    float complex y1[num_blocks*num_outputs];
+    unsigned int i;
+    for (i=0; i<num_blocks*hop; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    for (i=0; i<num_blocks; i++)
+        fcch_crcf_execute(q, &x[i*hop], &y0[i*num_outputs]);
+    fcch_crcf_reset(q);
+    for (i=0; i<num_blocks; i++)
+        fcch_crcf_execute(q, &x[i*hop], &y1[i*num_outputs]);
+    CONTEND_SAME_DATA(y0, y1, sizeof(y0));
+
+    fcch_crcf_destroy(q);
+}
+
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// per-channel outputs collected by the callback
+struct firpfbch2mt_crcf_autotest_s {
+    unsigned int    M;
+    unsigned int    num_max;    // capacity per channel
+    unsigned int *  num;        // outputs received per channel
+    float complex * y;          // outputs [size: M x num_max]
+};
+
+int firpfbch2mt_crcf_autotest_callback(float complex * _y,
+                                       unsigned int    _n,
+                                       unsigned int    _channel,
+                                       void *          _userdata)
+{
+    // each channel is only ever passed to one worker, so no locking needed
+    struct firpfbch2mt_crcf_autotest_s * s = (struct firpfbch2mt_crcf_autotest_s*)_userdata;
+    if (s->num[_channel] + _n > s->num_max) {
+        AUTOTEST_FAIL("too many outputs");
+        return -1;
+    }
+    memmove(&s->y[_channel*s->num_max + s->num[_channel]], _y, _n*sizeof(float complex));
+    s->num[_channel] += _n;
+    return 0;
+}
+
+// Run input through threaded analyzer in irregular pieces, flushing
+// part way through, and compare every channel against the regular
+// single-threaded analyzer.
+void firpfbch2mt_crcf_runtest(unsigned int _M,
+                              unsigned int _num_workers,
+                              unsigned int _block_len)
+{
+    unsigned int m          = 3;
+    float        As         = 60.0f;
+    unsigned int num_steps  = 37;
+    unsigned int num_samples= num_steps*_M/2;
+    unsigned int i, k;
+
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // reference: outputs by channel
+    float complex y_ref[_M*num_steps];
+    float complex Y[_M];
+    firpfbch2_crcf ch = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, _M, m, As);
+    for (i=0; i<num_steps; i++) {
+        firpfbch2_crcf_execute(ch, &x[i*_M/2], Y);
+        for (k=0; k<_M; k++)
+            y_ref[k*num_steps + i] = Y[k];
+    }
+    firpfbch2_crcf_destroy(ch);
+
+    // threaded analyzer
+    struct firpfbch2mt_crcf_autotest_s s;
+    unsigned int num[_M];
+    float complex y[_M*num_steps];
+    memset(num, 0, sizeof(num));
+    s.M       = _M;
+    s.num_max = num_steps;
+    s.num     = num;
+    s.y       = y;
+    firpfbch2mt_crcf q = firpfbch2mt_crcf_create(_M, m, As, _num_workers, _block_len,
+                                                 firpfbch2mt_crcf_autotest_callback, &s);
+    CONTEND_EQUALITY(firpfbch2mt_crcf_get_M(q), _M);
+    // builds without threads (or failing to start them) run without workers
+    unsigned int num_workers = firpfbch2mt_crcf_get_num_workers(q);
+    CONTEND_EXPRESSION(num_workers == _num_workers || num_workers == 0);
+
+    unsigned int steps[] = {1, 3, 0, 7, 2, 11};   // 0: flush
+    unsigned int n = 0;
+    for (i=0; n < num_steps; i++) {
+        unsigned int r = steps[i % 6];
+        r = r > num_steps - n ? num_steps - n : r;
+        if (r == 0) {
+            firpfbch2mt_crcf_flush(q);
+            // everything pushed so far has been delivered
+            for (k=0; k<_M; k++)
+                CONTEND_EQUALITY(num[k], n);
+            continue;
+        }
+        firpfbch2mt_crcf_execute(q, &x[n*_M/2], r*_M/2);
+        n += r;
+    }
+    firpfbch2mt_crcf_destroy(q);
+
+    for (k=0; k<_M; k++) {
+        CONTEND_EQUALITY(num[k], num_steps);
+        CONTEND_SAME_DATA(&y[k*num_steps], &y_ref[k*num_steps], num_steps*sizeof(float complex));
+    }
+}
+
+void autotest_firpfbch2mt_crcf_inline()     { firpfbch2mt_crcf_runtest(16, 0,  4); }
+void autotest_firpfbch2mt_crcf_w1()         { firpfbch2mt_crcf_runtest(16, 1,  5); }
+void autotest_firpfbch2mt_crcf_w3()         { firpfbch2mt_crcf_runtest(32, 3,  8); }
+void autotest_firpfbch2mt_crcf_w4_b1()      { firpfbch2mt_crcf_runtest( 8, 4,  1); }
+void autotest_firpfbch2mt_crcf_w2_long()    { firpfbch2mt_crcf_runtest(64, 2, 64); }
+
+// resetting restarts the filterbank, so the same input reproduces the
+// same output after all earlier outputs have been delivered
+void autotest_firpfbch2mt_crcf_reset()
+{
+    unsigned int M = 8, num_steps = 20, block_len = 3;
+    float complex x[num_steps*M/2];
+    float complex y[M*2*num_steps];
+    unsigned int  num[M];
+    unsigned int i, k;
+    for (i=0; i<num_steps*M/2; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    struct firpfbch2mt_crcf_autotest_s s = {M, 2*num_steps, num, y};
+    memset(num, 0, sizeof(num));
+    firpfbch2mt_crcf q = firpfbch2mt_crcf_create(M, 4, 60.0f, 2, block_len,
+                                                 firpfbch2mt_crcf_autotest_callback, &s);
+    firpfbch2mt_crcf_execute(q, x, num_steps*M/2);
+    firpfbch2mt_crcf_reset(q);
+    for (k=0; k<M; k++)
+        CONTEND_EQUALITY(num[k], num_steps);
+    firpfbch2mt_crcf_execute(q, x, num_steps*M/2);
+    firpfbch2mt_crcf_destroy(q);
+
+    for (k=0; k<M; k++) {
+        CONTEND_EQUALITY(num[k], 2*num_steps);
+        CONTEND_SAME_DATA(&y[k*2*num_steps], &y[k*2*num_steps + num_steps],
+                          num_steps*sizeof(float complex));
+    }
+}
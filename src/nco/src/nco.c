@@ -35,6 +35,9 @@
 
 #define LIQUID_DEBUG_NCO            (0)
 
+// number of samples per rotator vector in block mixing
+#define NCO_MIX_BLOCK_LEN           (64)
+
 struct NCO(_s) {
     liquid_ncotype  type;           // NCO type (e.g. LIQUID_VCO)
     T               sintab[1024];   // sine look-up table
@@ -52,6 +55,13 @@ uint32_t NCO(_constrain)(float _theta);
 // compute index for sine look-up table
 unsigned int NCO(_index)(NCO() _q);
 
+// rotate block of samples by NCO angle (up or down)
+void NCO(_mix_block)(NCO()        _q,
+                     TC *         _x,
+                     TC *         _y,
+                     unsigned int _n,
+                     int          _down);
+
 // create nco/vco object
 NCO() NCO(_create)(liquid_ncotype _type)
 {
@@ -263,7 +273,6 @@ void NCO(_mix_down)(NCO() _q,
 
 // Rotate input vector array up by NCO angle:
 //      y(t) = x(t) exp{+j (f*t + theta)}
-// TODO : implement NCO/VCO-specific versions
 //  _q      :   nco object
 //  _x      :   input array [size: _n x 1]
 //  _y      :   output sample [size: _n x 1]
@@ -273,34 +282,11 @@ void NCO(_mix_block_up)(NCO() _q,
                         TC *_y,
                         unsigned int _n)
 {
-    unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(theta) + _Complex_I*sin(theta)]
-        _y[i] = _x[i] * liquid_cexpjf(theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
-#else
-    for (i=0; i<_n; i++) {
-        // mix single sample up
-        NCO(_mix_up)(_q, _x[i], &_y[i]);
-
-        // step NCO phase
-        NCO(_step)(_q);
-    }
-#endif
+    NCO(_mix_block)(_q, _x, _y, _n, 0);
 }
 
 // Rotate input vector array down by NCO angle:
 //      y(t) = x(t) exp{-j (f*t + theta)}
-// TODO : implement NCO/VCO-specific versions
 //  _q      :   nco object
 //  _x      :   input array [size: _n x 1]
 //  _y      :   output sample [size: _n x 1]
@@ -310,29 +296,7 @@ void NCO(_mix_block_down)(NCO() _q,
                           TC *_y,
                           unsigned int _n)
 {
-    unsigned int i;
-    // FIXME: this method should be more efficient but is causing occasional
-    //        errors so instead favor slower but more reliable algorithm
-#if 0
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(-theta) + _Complex_I*sin(-theta)]
-        _y[i] = _x[i] * liquid_cexpjf(-theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
-#else
-    for (i=0; i<_n; i++) {
-        // mix single sample down
-        NCO(_mix_down)(_q, _x[i], &_y[i]);
-
-        // step NCO phase
-        NCO(_step)(_q);
-    }
-#endif
+    NCO(_mix_block)(_q, _x, _y, _n, 1);
 }
 
 //
@@ -362,3 +326,40 @@ unsigned int NCO(_index)(NCO() _q)
     return ((_q->theta + (1<<21)) >> 22) & 0x3ff; // round appropriately
 }
 
+// rotate block of samples by NCO angle (up or down)
+//  _q      :   nco object
+//  _x      :   input array [size: _n x 1]
+//  _y      :   output sample [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _down   :   rotate down (negative phase) flag
+//
+// The phase of each sample is taken directly from the 32-bit phase
+// accumulator (theta + i*d_theta, modulo 2^32) so there is no drift
+// within or across blocks, and the object state after the call is
+// identical to that of _n individual steps. The rotator vector is
+// computed with liquid_vectorcf_cexpj() rather than the sine table.
+void NCO(_mix_block)(NCO()        _q,
+                     TC *         _x,
+                     TC *         _y,
+                     unsigned int _n,
+                     int          _down)
+{
+    // scale fixed-point phase (as signed integer) to [-pi, pi)
+    T scale = (_down ? -2.0f : 2.0f) * M_PI / (float)(1LLU<<32);
+
+    T  phi[NCO_MIX_BLOCK_LEN];  // phase of each sample [radians]
+    TC v  [NCO_MIX_BLOCK_LEN];  // rotator vector
+    unsigned int i, n;
+    for (n=0; n<_n; n+=NCO_MIX_BLOCK_LEN) {
+        unsigned int m = _n - n < NCO_MIX_BLOCK_LEN ? _n - n : NCO_MIX_BLOCK_LEN;
+
+        // phase of each sample (independent lanes, wraps modulo 2^32)
+        for (i=0; i<m; i++)
+            phi[i] = (T)(int32_t)(_q->theta + i*_q->d_theta) * scale;
+        _q->theta += m*_q->d_theta;
+
+        // generate rotator and mix
+        liquid_vectorcf_cexpj(phi, m, v);
+        liquid_vectorcf_mul(&_x[n], v, m, &_y[n]);
+    }
+}
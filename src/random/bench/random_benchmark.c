@@ -153,3 +153,46 @@ void benchmark_random_ricek(struct rusage *_start,
     *_num_iterations *= 4;
 }
 
+
+// 
+// BENCHMARK: uniform/normal (block)
+//
+void random_fill_bench(struct rusage *     _start,
+                       struct rusage *     _finish,
+                       unsigned long int * _num_iterations,
+                       int                 _normal)
+{
+    unsigned int n = 256;
+    float y[n];
+    float x = 0.0f;
+    unsigned long int i;
+
+    // normalize number of iterations
+    *_num_iterations /= 16;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_normal) randnf_fill(y, n);
+        else         randf_fill (y, n);
+        x += y[i & (n-1)];
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+}
+
+void benchmark_random_uniform_fill(struct rusage *_start,
+                                   struct rusage *_finish,
+                                   unsigned long int *_num_iterations)
+{
+    random_fill_bench(_start, _finish, _num_iterations, 0);
+}
+
+void benchmark_random_normal_fill(struct rusage *_start,
+                                  struct rusage *_finish,
+                                  unsigned long int *_num_iterations)
+{
+    random_fill_bench(_start, _finish, _num_iterations, 1);
+}
+
@@ -35,6 +35,16 @@ float randf() {
     return randf_inline();
 }
 
+// fill array with uniform random numbers
+void randf_fill(float *      _y,
+                unsigned int _n)
+{
+    // private stream, seeded from rand() so that srand() selects it
+    randgen q = randgen_create(randgen_seed_from_rand());
+    randgen_randf_fill(q, _y, _n);
+    randgen_destroy(q);
+}
+
 // uniform random number probability distribution function
 float randf_pdf(float _x)
 {
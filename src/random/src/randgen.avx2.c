@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// block fill kernels (AVX2)
+//
+// This file is compiled with -mavx2 regardless of the build host; the
+// kernels are only called when the processor reports support for AVX2
+// at run time. The eight lanes are advanced as two vectors of four
+// 64-bit words; the ziggurat fast path splits eight outputs into
+// abscissa and layer index and reads the layer tables with gathers.
+//
+
+#include <stdint.h>
+#include <immintrin.h>  // AVX2
+
+#include "liquid.internal.h"
+
+static inline __m256i randgen_rotl_avx2(__m256i _x, int _k)
+{
+    return _mm256_or_si256(_mm256_slli_epi64(_x, _k), _mm256_srli_epi64(_x, 64-_k));
+}
+
+// advance four lanes held in _s0.._s3, storing their outputs to _v;
+// the multiplications by 5 and 9 are done with shifts and adds
+#define RANDGEN_STEP_AVX2(_s0,_s1,_s2,_s3,_v) {                         \
+    __m256i x = _mm256_add_epi64(_mm256_slli_epi64(_s1, 2), _s1);       \
+    x = randgen_rotl_avx2(x, 7);                                        \
+    x = _mm256_add_epi64(_mm256_slli_epi64(x, 3), x);                   \
+    _mm256_storeu_si256((__m256i*)(_v), x);                             \
+    __m256i t = _mm256_slli_epi64(_s1, 17);                             \
+    _s2 = _mm256_xor_si256(_s2, _s0);                                   \
+    _s3 = _mm256_xor_si256(_s3, _s1);                                   \
+    _s1 = _mm256_xor_si256(_s1, _s2);                                   \
+    _s0 = _mm256_xor_si256(_s0, _s3);                                   \
+    _s2 = _mm256_xor_si256(_s2, t);                                     \
+    _s3 = randgen_rotl_avx2(_s3, 45);                                   \
+}
+
+// advance block fill lanes, as two vectors of four lanes
+void randgen_lanes_run_avx2(uint64_t *   _b,
+                            unsigned int _num_steps,
+                            uint64_t *   _v)
+{
+    __m256i a0 = _mm256_loadu_si256((const __m256i*)&_b[0*RANDGEN_LANES+0]);
+    __m256i a1 = _mm256_loadu_si256((const __m256i*)&_b[1*RANDGEN_LANES+0]);
+    __m256i a2 = _mm256_loadu_si256((const __m256i*)&_b[2*RANDGEN_LANES+0]);
+    __m256i a3 = _mm256_loadu_si256((const __m256i*)&_b[3*RANDGEN_LANES+0]);
+    __m256i b0 = _mm256_loadu_si256((const __m256i*)&_b[0*RANDGEN_LANES+4]);
+    __m256i b1 = _mm256_loadu_si256((const __m256i*)&_b[1*RANDGEN_LANES+4]);
+    __m256i b2 = _mm256_loadu_si256((const __m256i*)&_b[2*RANDGEN_LANES+4]);
+    __m256i b3 = _mm256_loadu_si256((const __m256i*)&_b[3*RANDGEN_LANES+4]);
+
+    unsigned int i;
+    for (i=0; i<_num_steps; i++) {
+        RANDGEN_STEP_AVX2(a0, a1, a2, a3, &_v[i*RANDGEN_LANES+0]);
+        RANDGEN_STEP_AVX2(b0, b1, b2, b3, &_v[i*RANDGEN_LANES+4]);
+    }
+
+    _mm256_storeu_si256((__m256i*)&_b[0*RANDGEN_LANES+0], a0);
+    _mm256_storeu_si256((__m256i*)&_b[1*RANDGEN_LANES+0], a1);
+    _mm256_storeu_si256((__m256i*)&_b[2*RANDGEN_LANES+0], a2);
+    _mm256_storeu_si256((__m256i*)&_b[3*RANDGEN_LANES+0], a3);
+    _mm256_storeu_si256((__m256i*)&_b[0*RANDGEN_LANES+4], b0);
+    _mm256_storeu_si256((__m256i*)&_b[1*RANDGEN_LANES+4], b1);
+    _mm256_storeu_si256((__m256i*)&_b[2*RANDGEN_LANES+4], b2);
+    _mm256_storeu_si256((__m256i*)&_b[3*RANDGEN_LANES+4], b3);
+}
+
+// convert outputs to uniform in [0,1) from their upper 24 bits
+void randgen_uniform_run_avx2(const uint64_t * _v,
+                              unsigned int     _n,
+                              float *          _y)
+{
+    __m256i perm = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256  g    = _mm256_set1_ps(0x1.0p-24f);
+
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        // upper 24 bits of outputs 0-3 in even words and of 4-7 in odd
+        // words, then restored to output order
+        __m256i v0 = _mm256_srli_epi64(_mm256_loadu_si256((const __m256i*)&_v[i+0]), 40);
+        __m256i v1 = _mm256_srli_epi64(_mm256_loadu_si256((const __m256i*)&_v[i+4]), 40);
+        __m256i u  = _mm256_or_si256(v0, _mm256_slli_epi64(v1, 32));
+        u = _mm256_permutevar8x32_epi32(u, perm);
+        _mm256_storeu_ps(&_y[i], _mm256_mul_ps(_mm256_cvtepi32_ps(u), g));
+    }
+    if (i < _n)
+        randgen_uniform_run_port(&_v[i], _n-i, &_y[i]);
+}
+
+// run ziggurat fast path on outputs
+uint64_t randgen_zig_run_avx2(const uint64_t * _v,
+                              unsigned int     _n,
+                              const uint32_t * _kn,
+                              const float *    _wn,
+                              float *          _y)
+{
+    __m256i lo   = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    __m256i mask = _mm256_set1_epi32(RANDGEN_ZIG_LAYERS-1);
+    __m256i sign = _mm256_set1_epi32((int)0x80000000);
+
+    uint64_t rejected = 0;
+    unsigned int i;
+    for (i=0; i+8<=_n; i+=8) {
+        // low words (abscissa) to lanes 0-3, high words (layer) to 4-7
+        __m256i v0 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)&_v[i+0]), lo);
+        __m256i v1 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)&_v[i+4]), lo);
+        __m256i hz = _mm256_permute2x128_si256(v0, v1, 0x20);
+        __m256i iz = _mm256_and_si256(_mm256_permute2x128_si256(v0, v1, 0x31), mask);
+
+        // candidate output
+        __m256  w = _mm256_i32gather_ps(_wn, iz, 4);
+        _mm256_storeu_ps(&_y[i], _mm256_mul_ps(_mm256_cvtepi32_ps(hz), w));
+
+        // reject where |hz| >= kn[iz] (unsigned compare)
+        __m256i kn = _mm256_i32gather_epi32((const int*)_kn, iz, 4);
+        __m256i a  = _mm256_abs_epi32(hz);
+        __m256i rj = _mm256_cmpgt_epi32(_mm256_xor_si256(a,  sign),
+                                        _mm256_xor_si256(kn, sign));
+        rj = _mm256_or_si256(rj, _mm256_cmpeq_epi32(a, kn));
+        rejected |= (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(rj)) << i;
+    }
+    if (i < _n)
+        rejected |= randgen_zig_run_port(&_v[i], _n-i, _kn, _wn, &_y[i]) << i;
+    return rejected;
+}
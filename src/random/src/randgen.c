@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2007 - 2018 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Pseudo-random number generator (xoshiro256**) with ziggurat Gauss
+// sampler; each object carries its own state so that streams are
+// reproducible and lock-free across threads
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "liquid.internal.h"
+
+// right-most ziggurat layer edge
+#define RANDGEN_ZIG_R       (3.442619855899)
+
+// number of 64-bit outputs generated at a time by the block fills
+#define RANDGEN_BLOCK_LEN   (8*RANDGEN_LANES)
+
+struct randgen_s {
+    uint64_t s[4];                  // generator state
+    uint64_t b[4*RANDGEN_LANES];    // block fill lane states, word-major
+};
+
+// ziggurat tables (Marsaglia & Tsang, 2000)
+static uint32_t randgen_kn[RANDGEN_ZIG_LAYERS];    // acceptance thresholds
+static float    randgen_wn[RANDGEN_ZIG_LAYERS];    // layer widths (scaled)
+static float    randgen_fn[RANDGEN_ZIG_LAYERS];    // density at layer edges
+static int      randgen_tables_ready = 0;
+
+// build ziggurat tables once, when the library is loaded
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void randgen_init_tables(void)
+{
+    double m  = 2147483648.0;   // 2^31
+    double dn = RANDGEN_ZIG_R;
+    double tn = dn;
+    double vn = 9.91256303526217e-3;    // area of each layer
+    double q  = vn / exp(-0.5*dn*dn);
+
+    randgen_kn[0] = (uint32_t)((dn/q)*m);
+    randgen_kn[1] = 0;
+    randgen_wn[0] = (float)(q/m);
+    randgen_wn[RANDGEN_ZIG_LAYERS-1] = (float)(dn/m);
+    randgen_fn[0] = 1.0f;
+    randgen_fn[RANDGEN_ZIG_LAYERS-1] = (float)exp(-0.5*dn*dn);
+
+    int i;
+    for (i=RANDGEN_ZIG_LAYERS-2; i>=1; i--) {
+        dn = sqrt(-2.0*log(vn/dn + exp(-0.5*dn*dn)));
+        randgen_kn[i+1] = (uint32_t)((dn/tn)*m);
+        tn = dn;
+        randgen_fn[i] = (float)exp(-0.5*dn*dn);
+        randgen_wn[i] = (float)(dn/m);
+    }
+    randgen_tables_ready = 1;
+}
+
+static inline uint64_t randgen_rotl(uint64_t _x, int _k)
+{
+    return (_x << _k) | (_x >> (64 - _k));
+}
+
+// advance state and return next 64-bit output
+static inline uint64_t randgen_next(randgen _q)
+{
+    uint64_t * s = _q->s;
+    uint64_t   r = randgen_rotl(s[1]*5, 7) * 9;
+    uint64_t   t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3]  = randgen_rotl(s[3], 45);
+    return r;
+}
+
+// expand a 31-bit rand() output into the fields read from a 64-bit
+// output: the upper 24 bits (uniform), the layer index (bits 32-38) and
+// the ziggurat abscissa (low word, 24 significant bits)
+static uint64_t randgen_rand_expand(void)
+{
+#if RAND_MAX >= 0x7fffffff
+    uint32_t r = (uint32_t)rand() & 0x7fffffff;
+#else
+    uint32_t r = (((uint32_t)rand() << 30) ^ ((uint32_t)rand() << 15) ^ (uint32_t)rand()) & 0x7fffffff;
+#endif
+    uint32_t u = r >> 7;
+    return ((uint64_t)u << 40) | ((uint64_t)(r & 0x7f) << 32) | (uint64_t)(u << 8);
+}
+
+// next 64-bit output from generator or, without one, from rand()
+static inline uint64_t randgen_draw(randgen _q)
+{
+    return _q == NULL ? randgen_rand_expand() : randgen_next(_q);
+}
+
+// convert 64-bit output to uniform in [0,1) from its upper 24 bits
+static inline float randgen_u64_to_uniform(uint64_t _v)
+{
+    return (float)(_v >> 40) * 0x1.0p-24f;
+}
+
+// uniform in (0,1), safe as an argument to logf()
+static inline float randgen_uniform_open(randgen _q)
+{
+    return ((float)(randgen_draw(_q) >> 40) + 0.5f) * 0x1.0p-24f;
+}
+
+// ziggurat slow path: sample wedges and the tail (rarely taken)
+static float randgen_gauss_fix(randgen      _q,
+                               int32_t      _hz,
+                               unsigned int _iz)
+{
+    const float r = (float)RANDGEN_ZIG_R;
+    for (;;) {
+        float x = _hz * randgen_wn[_iz];
+
+        // base layer: sample from the tail beyond r
+        if (_iz == 0) {
+            float y;
+            do {
+                x = -logf(randgen_uniform_open(_q)) / r;
+                y = -logf(randgen_uniform_open(_q));
+            } while (y+y < x*x);
+            return _hz > 0 ? r + x : -r - x;
+        }
+
+        // wedge: accept if under the density
+        float u = randgen_u64_to_uniform(randgen_draw(_q));
+        float f = randgen_fn[_iz] + u*(randgen_fn[_iz-1] - randgen_fn[_iz]);
+        if (f < expf(-0.5f*x*x))
+            return x;
+
+        // try again with a new sample
+        uint64_t v = randgen_draw(_q);
+        _hz = (int32_t)(uint32_t)v;
+        _iz = (unsigned int)(v >> 32) & (RANDGEN_ZIG_LAYERS-1);
+        uint32_t a = _hz < 0 ? -(uint32_t)_hz : (uint32_t)_hz;
+        if (a < randgen_kn[_iz])
+            return _hz * randgen_wn[_iz];
+    }
+}
+
+// Gauss sample from 64-bit output _v; the layer index and the abscissa
+// are taken from independent bits
+static inline float randgen_gauss(randgen _q, uint64_t _v)
+{
+    int32_t      hz = (int32_t)(uint32_t)_v;
+    unsigned int iz = (unsigned int)(_v >> 32) & (RANDGEN_ZIG_LAYERS-1);
+    uint32_t     a  = hz < 0 ? -(uint32_t)hz : (uint32_t)hz;
+    if (a < randgen_kn[iz])
+        return hz * randgen_wn[iz];
+    return randgen_gauss_fix(_q, hz, iz);
+}
+
+// create generator object with a particular seed
+randgen randgen_create(uint64_t _seed)
+{
+    if (!randgen_tables_ready)
+        randgen_init_tables();
+
+    randgen q = (randgen) malloc(sizeof(struct randgen_s));
+    randgen_seed(q, _seed);
+    return q;
+}
+
+// destroy generator object
+void randgen_destroy(randgen _q)
+{
+    free(_q);
+}
+
+// print generator object
+void randgen_print(randgen _q)
+{
+    printf("randgen: xoshiro256**, state = {%016llx, %016llx, %016llx, %016llx}, %u block lanes\n",
+            (unsigned long long)_q->s[0], (unsigned long long)_q->s[1],
+            (unsigned long long)_q->s[2], (unsigned long long)_q->s[3], RANDGEN_LANES);
+}
+
+// reset generator state from a 64-bit seed, expanded with splitmix64
+// into the main state followed by the block fill lane states
+void randgen_seed(randgen  _q,
+                  uint64_t _seed)
+{
+    unsigned int i;
+    for (i=0; i<4+4*RANDGEN_LANES; i++) {
+        uint64_t z = (_seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z ^= z >> 31;
+        if (i < 4) _q->s[i]   = z;
+        else       _q->b[i-4] = z;
+    }
+}
+
+// generate uniform 64-bit integer
+uint64_t randgen_u64(randgen _q)
+{
+    return randgen_next(_q);
+}
+
+// generate uniform random number in [0,1)
+float randgen_randf(randgen _q)
+{
+    return randgen_u64_to_uniform(randgen_next(_q));
+}
+
+// generate Gauss random number, N(0,1)
+float randgen_randnf(randgen _q)
+{
+    return randgen_gauss(_q, randgen_next(_q));
+}
+
+// advance block fill lanes (portable); lanes are taken two at a time so
+// that their independent updates can overlap
+void randgen_lanes_run_port(uint64_t *   _b,
+                            unsigned int _num_steps,
+                            uint64_t *   _v)
+{
+    unsigned int i, j;
+    for (j=0; j<RANDGEN_LANES; j+=2) {
+        uint64_t a0 = _b[0*RANDGEN_LANES+j],   a1 = _b[1*RANDGEN_LANES+j];
+        uint64_t a2 = _b[2*RANDGEN_LANES+j],   a3 = _b[3*RANDGEN_LANES+j];
+        uint64_t b0 = _b[0*RANDGEN_LANES+j+1], b1 = _b[1*RANDGEN_LANES+j+1];
+        uint64_t b2 = _b[2*RANDGEN_LANES+j+1], b3 = _b[3*RANDGEN_LANES+j+1];
+        for (i=0; i<_num_steps; i++) {
+            uint64_t ta = a1 << 17;
+            uint64_t tb = b1 << 17;
+            _v[i*RANDGEN_LANES+j]   = randgen_rotl(a1*5, 7) * 9;
+            _v[i*RANDGEN_LANES+j+1] = randgen_rotl(b1*5, 7) * 9;
+            a2 ^= a0;   b2 ^= b0;
+            a3 ^= a1;   b3 ^= b1;
+            a1 ^= a2;   b1 ^= b2;
+            a0 ^= a3;   b0 ^= b3;
+            a2 ^= ta;   b2 ^= tb;
+            a3 = randgen_rotl(a3, 45);
+            b3 = randgen_rotl(b3, 45);
+        }
+        _b[0*RANDGEN_LANES+j]   = a0;   _b[1*RANDGEN_LANES+j]   = a1;
+        _b[2*RANDGEN_LANES+j]   = a2;   _b[3*RANDGEN_LANES+j]   = a3;
+        _b[0*RANDGEN_LANES+j+1] = b0;   _b[1*RANDGEN_LANES+j+1] = b1;
+        _b[2*RANDGEN_LANES+j+1] = b2;   _b[3*RANDGEN_LANES+j+1] = b3;
+    }
+}
+
+// run ziggurat fast path on outputs (portable)
+uint64_t randgen_zig_run_port(const uint64_t * _v,
+                              unsigned int     _n,
+                              const uint32_t * _kn,
+                              const float *    _wn,
+                              float *          _y)
+{
+    uint64_t rejected = 0;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        int32_t      hz = (int32_t)(uint32_t)_v[i];
+        unsigned int iz = (unsigned int)(_v[i] >> 32) & (RANDGEN_ZIG_LAYERS-1);
+        uint32_t     a  = hz < 0 ? -(uint32_t)hz : (uint32_t)hz;
+        _y[i] = hz * _wn[iz];
+        rejected |= (uint64_t)(a >= _kn[iz]) << i;
+    }
+    return rejected;
+}
+
+// convert outputs to uniform in [0,1) (portable)
+void randgen_uniform_run_port(const uint64_t * _v,
+                              unsigned int     _n,
+                              float *          _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = randgen_u64_to_uniform(_v[i]);
+}
+
+// fill array with uniform random numbers in [0,1)
+void randgen_randf_fill(randgen      _q,
+                        float *      _y,
+                        unsigned int _n)
+{
+    // select kernels
+    void (*lanes)(uint64_t *, unsigned int, uint64_t *) = randgen_lanes_run_port;
+    void (*run)(const uint64_t *, unsigned int, float *) = randgen_uniform_run_port;
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2)) {
+        lanes = randgen_lanes_run_avx2;
+        run   = randgen_uniform_run_avx2;
+    }
+#endif
+
+    uint64_t v[RANDGEN_BLOCK_LEN];
+    unsigned int i;
+    for (i=0; i<_n; i+=RANDGEN_BLOCK_LEN) {
+        unsigned int m = _n-i < RANDGEN_BLOCK_LEN ? _n-i : RANDGEN_BLOCK_LEN;
+        lanes(_q->b, (m + RANDGEN_LANES - 1) / RANDGEN_LANES, v);
+        run(v, m, &_y[i]);
+    }
+}
+
+// fill array with Gauss random numbers, N(0,1); the ziggurat fast path
+// runs over a block of lane outputs at a time, and the rare rejections
+// are then resolved with draws from the main stream
+void randgen_randnf_fill(randgen      _q,
+                         float *      _y,
+                         unsigned int _n)
+{
+    // select kernels
+    void (*lanes)(uint64_t *, unsigned int, uint64_t *) = randgen_lanes_run_port;
+    uint64_t (*run)(const uint64_t *, unsigned int, const uint32_t *,
+                    const float *, float *) = randgen_zig_run_port;
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2)) {
+        lanes = randgen_lanes_run_avx2;
+        run   = randgen_zig_run_avx2;
+    }
+#endif
+
+    uint64_t v[RANDGEN_BLOCK_LEN];
+    unsigned int i, k;
+    for (i=0; i<_n; i+=RANDGEN_BLOCK_LEN) {
+        unsigned int m = _n-i < RANDGEN_BLOCK_LEN ? _n-i : RANDGEN_BLOCK_LEN;
+        lanes(_q->b, (m + RANDGEN_LANES - 1) / RANDGEN_LANES, v);
+        uint64_t rejected = run(v, m, randgen_kn, randgen_wn, &_y[i]);
+        for (k=0; rejected != 0; k++, rejected >>= 1) {
+            if (rejected & 1) {
+                int32_t      hz = (int32_t)(uint32_t)v[k];
+                unsigned int iz = (unsigned int)(v[k] >> 32) & (RANDGEN_ZIG_LAYERS-1);
+                _y[i+k] = randgen_gauss_fix(_q, hz, iz);
+            }
+        }
+    }
+}
+
+// fill array with complex Gauss random numbers, unit variance in
+// each of the real and imaginary components
+void randgen_crandnf_fill(randgen         _q,
+                          float complex * _y,
+                          unsigned int    _n)
+{
+    randgen_randnf_fill(_q, (float*)_y, 2*_n);
+}
+
+// draw a seed from rand() so that srand() selects the stream
+uint64_t randgen_seed_from_rand(void)
+{
+    return ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+}
+
+// Gauss sample drawn from rand() outputs, so that srand() selects the
+// sequence (used by randnf())
+float randgen_gauss_rand(void)
+{
+    if (!randgen_tables_ready)
+        randgen_init_tables();
+    return randgen_gauss(NULL, randgen_rand_expand());
+}
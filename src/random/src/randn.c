@@ -33,18 +33,17 @@
 // Gauss
 float randnf()
 {
-    // generate two uniform random numbers
-    float u1, u2;
-
-    // ensure u1 does not equal zero
-    do {
-        u1 = randf();
-    } while (u1 == 0.0f);
-
-    u2 = randf();
+    return randgen_gauss_rand();
+}
 
-    return sqrtf(-2*logf(u1)) * sinf(2*M_PI*u2);
-    //return sqrtf(-2*logf(u1)) * cosf(2*M_PI*u2);
+// fill array with Gauss random numbers
+void randnf_fill(float *      _y,
+                 unsigned int _n)
+{
+    // private stream, seeded from rand() so that srand() selects it
+    randgen q = randgen_create(randgen_seed_from_rand());
+    randgen_randnf_fill(q, _y, _n);
+    randgen_destroy(q);
 }
 
 void awgn(float *_x, float _nstd)
@@ -55,17 +54,9 @@ void awgn(float *_x, float _nstd)
 // Complex Gauss
 void crandnf(float complex * _y)
 {
-    // generate two uniform random numbers
-    float u1, u2;
-
-    // ensure u1 does not equal zero
-    do {
-        u1 = randf();
-    } while (u1 == 0.0f);
-
-    u2 = randf();
-
-    *_y = sqrtf(-2*logf(u1)) * cexpf(_Complex_I*2*M_PI*u2);
+    float yi = randgen_gauss_rand();
+    float yq = randgen_gauss_rand();
+    *_y = yi + _Complex_I*yq;
 }
 
 // Internal complex Gauss (inline)
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// same seed reproduces the same stream; different seeds differ
+void autotest_randgen_seed()
+{
+    randgen q0 = randgen_create(12345);
+    randgen q1 = randgen_create(12345);
+    randgen q2 = randgen_create(12346);
+
+    unsigned int i, num_same=0;
+    for (i=0; i<100; i++) {
+        uint64_t v0 = randgen_u64(q0);
+        uint64_t v1 = randgen_u64(q1);
+        uint64_t v2 = randgen_u64(q2);
+        CONTEND_EXPRESSION(v0 == v1);
+        num_same += (v0 == v2);
+    }
+    CONTEND_EQUALITY(num_same, 0);
+
+    // re-seeding restarts the stream
+    randgen_seed(q1, 12345);
+    randgen_seed(q2, 12345);
+    CONTEND_EXPRESSION(randgen_u64(q1) == randgen_u64(q2));
+
+    randgen_destroy(q0);
+    randgen_destroy(q1);
+    randgen_destroy(q2);
+}
+
+// srand() replays randf(), randnf(), crandnf() and the block fills,
+// including after the stream has been used
+void autotest_randgen_srand()
+{
+    unsigned int i, n = 50;
+    float v0[6*n], v1[6*n];
+    float complex z0, z1;
+
+    // draw seed from the current sequence to keep the run reproducible
+    unsigned int seed = (unsigned int) rand();
+
+    srand(seed);
+    for (i=0; i<n; i++) {
+        v0[2*i+0] = randf();
+        v0[2*i+1] = randnf();
+    }
+    crandnf(&z0);
+    randf_fill (&v0[2*n], 2*n);
+    randnf_fill(&v0[4*n], 2*n);
+
+    srand(seed);
+    for (i=0; i<n; i++) {
+        v1[2*i+0] = randf();
+        v1[2*i+1] = randnf();
+    }
+    crandnf(&z1);
+    CONTEND_EXPRESSION(z0 == z1);
+    randf_fill (&v1[2*n], 2*n);
+    randnf_fill(&v1[4*n], 2*n);
+    CONTEND_SAME_DATA(v0, v1, sizeof(v0));
+
+    // a different seed gives a different sequence
+    srand(seed+1);
+    unsigned int num_same = 0;
+    for (i=0; i<n; i++) {
+        num_same += randf()  == v0[2*i+0];
+        num_same += randnf() == v0[2*i+1];
+    }
+    CONTEND_LESS_THAN(num_same, 4);
+}
+
+// block fills are reproducible and independent of how the request is
+// split into multiples of the lane count
+void autotest_randgen_fill()
+{
+    unsigned int n = 1000;
+    float y0[n], y1[n];
+    float complex z[n/2];
+
+    randgen q = randgen_create(1);
+    randgen_randf_fill(q, y0, n);
+    randgen_seed(q, 1);
+    randgen_randf_fill(q, y1,     400);
+    randgen_randf_fill(q, y1+400, 600);
+    CONTEND_SAME_DATA(y0, y1, n*sizeof(float));
+
+    randgen_seed(q, 2);
+    randgen_randnf_fill(q, y0, n);
+    randgen_seed(q, 2);
+    randgen_randnf_fill(q, y1,     24);
+    randgen_randnf_fill(q, y1+24,  n-24);
+    CONTEND_SAME_DATA(y0, y1, n*sizeof(float));
+
+    randgen_seed(q, 2);
+    randgen_crandnf_fill(q, z, n/2);
+    CONTEND_SAME_DATA(y0, z, n*sizeof(float));
+    randgen_destroy(q);
+}
+
+// compare run-time selected block fill kernels against the portable ones
+void autotest_randgen_kernels()
+{
+    unsigned int num_steps = 9;                         // lane steps
+    unsigned int n  = num_steps*RANDGEN_LANES - 3;      // uniform outputs
+    unsigned int nz = 61;                               // ziggurat outputs
+    uint64_t b0[4*RANDGEN_LANES], v0[num_steps*RANDGEN_LANES];
+    float    u0[n], y0[nz];
+    uint32_t kn[RANDGEN_ZIG_LAYERS];
+    float    wn[RANDGEN_ZIG_LAYERS];
+    unsigned int i;
+    for (i=0; i<4*RANDGEN_LANES; i++)
+        b0[i] = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ rand();
+
+    // layer tables with some layers rejecting everything or nothing
+    for (i=0; i<RANDGEN_ZIG_LAYERS; i++) {
+        kn[i] = i % 5 == 0 ? 0 : (i % 5 == 1 ? 0x80000000 : (uint32_t)rand() << 1);
+        wn[i] = (float)(i+1) * 1e-9f;
+    }
+
+#if LIQUID_SIMD_AVX2
+    uint64_t b1[4*RANDGEN_LANES], v1[num_steps*RANDGEN_LANES];
+    float    u1[n], y1[nz];
+    memmove(b1, b0, sizeof(b0));
+#endif
+
+    randgen_lanes_run_port(b0, num_steps, v0);
+    randgen_uniform_run_port(v0, n, u0);
+    uint64_t r0 = randgen_zig_run_port(v0, nz, kn, wn, y0);
+    CONTEND_EXPRESSION(r0 != 0);
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2)) {
+        randgen_lanes_run_avx2(b1, num_steps, v1);
+        CONTEND_SAME_DATA(v0, v1, sizeof(v0));
+        CONTEND_SAME_DATA(b0, b1, sizeof(b0));
+        randgen_uniform_run_avx2(v1, n, u1);
+        CONTEND_SAME_DATA(u0, u1, sizeof(u0));
+
+        // outputs must agree where accepted
+        uint64_t r1 = randgen_zig_run_avx2(v1, nz, kn, wn, y1);
+        CONTEND_EXPRESSION(r0 == r1);
+        for (i=0; i<nz; i++) {
+            if (((r0 >> i) & 1) == 0)
+                CONTEND_EQUALITY(y0[i], y1[i]);
+        }
+    }
+#endif
+}
+
+// uniform samples lie in [0,1) with expected moments
+void autotest_randgen_uniform()
+{
+    unsigned int i, n = 100000, num_outside = 0;
+    float m1 = 0.0f, m2 = 0.0f;
+    randgen q = randgen_create(7);
+    for (i=0; i<n; i++) {
+        float x = randgen_randf(q);
+        num_outside += (x < 0.0f || x >= 1.0f);
+        m1 += x;
+        m2 += x*x;
+    }
+    m1 /= (float)n;
+    m2 = m2/(float)n - m1*m1;
+    CONTEND_EQUALITY(num_outside, 0);
+    CONTEND_DELTA(m1, 0.5f,      0.01f);
+    CONTEND_DELTA(m2, 1/12.0f,   0.005f);
+    randgen_destroy(q);
+}
+
+// ziggurat Gauss samples: moments and tail probabilities
+void autotest_randgen_gauss()
+{
+    unsigned int i, n = 1000000;
+    float * y = (float*) malloc(n*sizeof(float));
+    randgen q = randgen_create(3);
+    randgen_randnf_fill(q, y, n);
+
+    double m1=0, m2=0, m4=0;
+    unsigned int n1=0, n2=0, n3=0;
+    for (i=0; i<n; i++) {
+        double x = y[i];
+        m1 += x;
+        m2 += x*x;
+        m4 += x*x*x*x;
+        n1 += fabs(x) > 1.0;
+        n2 += fabs(x) > 2.0;
+        n3 += fabs(x) > 3.442620;   // beyond the base layer
+    }
+    m1 /= n; m2 /= n; m4 /= n;
+    CONTEND_DELTA(m1, 0.0, 0.005);
+    CONTEND_DELTA(m2, 1.0, 0.01);
+    CONTEND_DELTA(m4, 3.0, 0.05);
+    CONTEND_DELTA((double)n1/n, 0.317311,  0.002);
+    CONTEND_DELTA((double)n2/n, 0.0455003, 0.001);
+    CONTEND_DELTA((double)n3/n, 5.7617e-4, 1e-4);
+
+    randgen_destroy(q);
+    free(y);
+}
+
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include <sys/resource.h>
 #include "liquid.h"
 
@@ -69,3 +70,45 @@ void benchmark_bsequence_xcorr_n64      BSEQUENCE_BENCHMARK_API(64)
 void benchmark_bsequence_xcorr_n256     BSEQUENCE_BENCHMARK_API(256)
 void benchmark_bsequence_xcorr_n1024    BSEQUENCE_BENCHMARK_API(1024)
 
+
+// correlate sequence against a byte buffer at every bit offset
+void bsequence_correlate_bytes_bench(struct rusage *_start,
+                                     struct rusage *_finish,
+                                     unsigned long int *_num_iterations,
+                                     unsigned int _n)
+{
+    // normalize number of iterations
+    unsigned int num_bytes = 256;
+    *_num_iterations /= 100;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create and initialize binary sequence and input buffer
+    bsequence bs = bsequence_create(_n);
+    unsigned char v[num_bytes];
+    int rxy[8*num_bytes];
+
+    unsigned long int i;
+    for (i=0; i<_n; i++)
+        bsequence_push(bs, rand() & 1);
+    for (i=0; i<num_bytes; i++)
+        v[i] = rand() & 0xff;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        bsequence_correlate_bytes(bs, v, num_bytes, rxy);
+    getrusage(RUSAGE_SELF, _finish);
+
+    // clean up memory
+    bsequence_destroy(bs);
+}
+
+#define BSEQUENCE_BYTES_BENCHMARK_API(N)    \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ bsequence_correlate_bytes_bench(_start, _finish, _num_iterations, N); }
+
+// 
+void benchmark_bsequence_xcorr_bytes_n64    BSEQUENCE_BYTES_BENCHMARK_API(64)
+void benchmark_bsequence_xcorr_bytes_n256   BSEQUENCE_BYTES_BENCHMARK_API(256)
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// binary sequence correlator (AVX2)
+//
+// This file is compiled with -mavx2 regardless of the build host; the
+// kernel is only called when the processor reports support for AVX2
+// at run time. The eight windows of each byte position are held in two
+// vectors of four 64-bit lanes and counted with a vpshufb nibble table.
+//
+
+#include <stdint.h>
+#include <immintrin.h>  // AVX2
+
+#include "liquid.internal.h"
+
+// correlate reference against stream windows
+void bsequence_scan_avx2(const uint64_t *      _ref,
+                         unsigned int          _num_words,
+                         uint64_t              _mask,
+                         unsigned int          _num_bits,
+                         const unsigned char * _v,
+                         unsigned int          _num_pos,
+                         int *                 _rxy)
+{
+    // number of ones in each nibble
+    __m256i lut  = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                    0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    __m256i m0f  = _mm256_set1_epi8(0x0f);
+    __m256i sl0  = _mm256_setr_epi64x(0, 1, 2, 3);
+    __m256i sl1  = _mm256_setr_epi64x(4, 5, 6, 7);
+    __m256i sr0  = _mm256_setr_epi64x(8, 7, 6, 5);
+    __m256i sr1  = _mm256_setr_epi64x(4, 3, 2, 1);
+    __m256i nb   = _mm256_set1_epi32(_num_bits);
+    __m256i perm = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    unsigned int p, j;
+    for (p=0; p<_num_pos; p++) {
+        __m256i d0 = _mm256_setzero_si256();
+        __m256i d1 = _mm256_setzero_si256();
+        for (j=0; j<_num_words; j++) {
+            const unsigned char * v = &_v[p+8*j];
+            __m256i w = _mm256_set1_epi64x((long long)BSEQUENCE_LOAD_BE64(v));
+            __m256i n = _mm256_set1_epi64x((long long)v[8]);
+            __m256i r = _mm256_set1_epi64x((long long)_ref[j]);
+            __m256i m = _mm256_set1_epi64x(j+1 == _num_words ? (long long)_mask : -1LL);
+
+            // windows for shifts 0-3 and 4-7, xor with reference
+            __m256i x0 = _mm256_or_si256(_mm256_sllv_epi64(w, sl0), _mm256_srlv_epi64(n, sr0));
+            __m256i x1 = _mm256_or_si256(_mm256_sllv_epi64(w, sl1), _mm256_srlv_epi64(n, sr1));
+            x0 = _mm256_and_si256(_mm256_xor_si256(x0, r), m);
+            x1 = _mm256_and_si256(_mm256_xor_si256(x1, r), m);
+
+            // count ones in each byte and sum bytes of each lane
+            __m256i c0 = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(x0, m0f)),
+                                         _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x0,4), m0f)));
+            __m256i c1 = _mm256_add_epi8(_mm256_shuffle_epi8(lut, _mm256_and_si256(x1, m0f)),
+                                         _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x1,4), m0f)));
+            d0 = _mm256_add_epi64(d0, _mm256_sad_epu8(c0, _mm256_setzero_si256()));
+            d1 = _mm256_add_epi64(d1, _mm256_sad_epu8(c1, _mm256_setzero_si256()));
+        }
+
+        // gather the low 32 bits of each count: shifts 0-7 in order
+        __m256i d = _mm256_blend_epi32(d0, _mm256_slli_epi64(d1, 32), 0xaa);
+        d = _mm256_permutevar8x32_epi32(d, perm);
+        _mm256_storeu_si256((__m256i*)&_rxy[8*p], _mm256_sub_epi32(nb, d));
+    }
+}
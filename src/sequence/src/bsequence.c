@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <math.h>
 
 #include "liquid.internal.h"
@@ -200,6 +201,62 @@ signed int bsequence_correlate(bsequence _bs1,
     return rxy;
 }
 
+// Correlate binary sequence against a packed bit stream at every bit
+// offset. The reference is packed into 64-bit words in stream order and
+// eight windows (one per bit shift) are evaluated for each input byte.
+void bsequence_correlate_bytes(bsequence       _bs,
+                               unsigned char * _v,
+                               unsigned int    _n,
+                               int *           _rxy)
+{
+    if (8*_n < _bs->num_bits) {
+        fprintf(stderr,"error: bsequence_correlate_bytes(), input shorter than sequence\n");
+        exit(-1);
+    }
+
+    // pack reference in stream order (oldest bit first), msb first
+    unsigned int num_words = (_bs->num_bits + 63) / 64;
+    uint64_t ref[num_words];
+    memset(ref, 0x00, num_words*sizeof(uint64_t));
+    unsigned int i;
+    unsigned int p = 8*sizeof(unsigned int);
+    for (i=0; i<_bs->num_bits; i++) {
+        // most-significant block holds the oldest num_bits_msb bits
+        unsigned int k = i + p - _bs->num_bits_msb;
+        unsigned int b = (_bs->s[k/p] >> (p-1-(k%p))) & 1;
+        ref[i/64] |= (uint64_t)b << (63 - (i%64));
+    }
+    unsigned int r = _bs->num_bits % 64;
+    uint64_t mask = r ? ~(uint64_t)0 << (64-r) : ~(uint64_t)0;
+
+    // select kernel
+    void (*scan)(const uint64_t *, unsigned int, uint64_t, unsigned int,
+                 const unsigned char *, unsigned int, int *) = bsequence_scan_port;
+#if LIQUID_SIMD_POPCNT
+    if (liquid_cpu_has(LIQUID_CPU_POPCNT))
+        scan = bsequence_scan_popcnt;
+#endif
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2))
+        scan = bsequence_scan_avx2;
+#endif
+
+    // byte positions whose windows lie entirely within the input
+    unsigned int num_offsets = 8*_n - _bs->num_bits + 1;
+    unsigned int num_pos = _n > 8*num_words ? _n - 8*num_words : 0;
+    scan(ref, num_words, mask, _bs->num_bits, _v, num_pos, _rxy);
+
+    // remaining positions from a zero-padded copy of the input tail
+    unsigned int num_tail = _n - num_pos;
+    unsigned char tail[num_tail + 8*num_words + 1];
+    int rxy[8*num_tail];
+    memset(tail, 0x00, sizeof(tail));
+    memmove(tail, &_v[num_pos], num_tail);
+    scan(ref, num_words, mask, _bs->num_bits, tail, num_tail, rxy);
+    for (i=8*num_pos; i<num_offsets; i++)
+        _rxy[i] = rxy[i - 8*num_pos];
+}
+
 // compute the binary addition of two bit sequences
 void bsequence_add(bsequence _bs1,
                    bsequence _bs2,
@@ -270,13 +327,13 @@ unsigned int bsequence_index(bsequence _bs,
         fprintf(stderr,"error: bsequence_index(), invalid index %u\n", _i);
         exit(-1);
     }
-    div_t d = div( _i, 8*sizeof(unsigned int) );
+    unsigned int p = 8*sizeof(unsigned int);
 
     // compute byte index
-    unsigned int k = _bs->s_len - d.quot - 1;
+    unsigned int k = _bs->s_len - _i/p - 1;
 
     // return particular bit at byte index
-    return (_bs->s[k] >> d.rem ) & 1;
+    return (_bs->s[k] >> (_i%p) ) & 1;
 }
 
 // intialize two sequences to complementary codes.  sequences must
@@ -336,3 +393,50 @@ void bsequence_create_ccodes(bsequence _qa, bsequence _qb)
     bsequence_init(_qb, b);
 }
 
+// count the number of ones in a 64-bit word
+static inline unsigned int bsequence_count_ones_uint64(uint64_t _x)
+{
+    _x = _x - ((_x >> 1) & 0x5555555555555555ULL);
+    _x = (_x & 0x3333333333333333ULL) + ((_x >> 2) & 0x3333333333333333ULL);
+    _x = (_x + (_x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (unsigned int)((_x * 0x0101010101010101ULL) >> 56);
+}
+
+// correlate reference against stream windows (portable)
+void bsequence_scan_port(const uint64_t *      _ref,
+                         unsigned int          _num_words,
+                         uint64_t              _mask,
+                         unsigned int          _num_bits,
+                         const unsigned char * _v,
+                         unsigned int          _num_pos,
+                         int *                 _rxy)
+{
+    unsigned int p, j;
+    for (p=0; p<_num_pos; p++) {
+        int d0=0, d1=0, d2=0, d3=0, d4=0, d5=0, d6=0, d7=0;
+        for (j=0; j<_num_words; j++) {
+            // 72 input bits cover the windows for all eight shifts
+            uint64_t w = BSEQUENCE_LOAD_BE64(&_v[p+8*j]);
+            uint64_t n = _v[p+8*j+8];
+            uint64_t r = _ref[j];
+            uint64_t m = j+1 == _num_words ? _mask : ~(uint64_t)0;
+            d0 += bsequence_count_ones_uint64(( w                      ^ r) & m);
+            d1 += bsequence_count_ones_uint64((((w << 1) | (n >> 7)) ^ r) & m);
+            d2 += bsequence_count_ones_uint64((((w << 2) | (n >> 6)) ^ r) & m);
+            d3 += bsequence_count_ones_uint64((((w << 3) | (n >> 5)) ^ r) & m);
+            d4 += bsequence_count_ones_uint64((((w << 4) | (n >> 4)) ^ r) & m);
+            d5 += bsequence_count_ones_uint64((((w << 5) | (n >> 3)) ^ r) & m);
+            d6 += bsequence_count_ones_uint64((((w << 6) | (n >> 2)) ^ r) & m);
+            d7 += bsequence_count_ones_uint64((((w << 7) | (n >> 1)) ^ r) & m);
+        }
+        int * rxy = &_rxy[8*p];
+        rxy[0] = (int)_num_bits - d0;
+        rxy[1] = (int)_num_bits - d1;
+        rxy[2] = (int)_num_bits - d2;
+        rxy[3] = (int)_num_bits - d3;
+        rxy[4] = (int)_num_bits - d4;
+        rxy[5] = (int)_num_bits - d5;
+        rxy[6] = (int)_num_bits - d6;
+        rxy[7] = (int)_num_bits - d7;
+    }
+}
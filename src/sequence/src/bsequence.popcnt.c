@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// binary sequence correlator (POPCNT)
+//
+// This file is compiled with -mpopcnt regardless of the build host; the
+// kernel is only called when the processor reports support for POPCNT
+// at run time.
+//
+
+#include <stdint.h>
+#include <nmmintrin.h>  // POPCNT
+
+#include "liquid.internal.h"
+
+// correlate reference against stream windows
+void bsequence_scan_popcnt(const uint64_t *      _ref,
+                           unsigned int          _num_words,
+                           uint64_t              _mask,
+                           unsigned int          _num_bits,
+                           const unsigned char * _v,
+                           unsigned int          _num_pos,
+                           int *                 _rxy)
+{
+    unsigned int p, j;
+    for (p=0; p<_num_pos; p++) {
+        int d0=0, d1=0, d2=0, d3=0, d4=0, d5=0, d6=0, d7=0;
+        for (j=0; j<_num_words; j++) {
+            // 72 input bits cover the windows for all eight shifts
+            uint64_t w = BSEQUENCE_LOAD_BE64(&_v[p+8*j]);
+            uint64_t n = _v[p+8*j+8];
+            uint64_t r = _ref[j];
+            uint64_t m = j+1 == _num_words ? _mask : ~(uint64_t)0;
+            d0 += _mm_popcnt_u64(( w                      ^ r) & m);
+            d1 += _mm_popcnt_u64((((w << 1) | (n >> 7)) ^ r) & m);
+            d2 += _mm_popcnt_u64((((w << 2) | (n >> 6)) ^ r) & m);
+            d3 += _mm_popcnt_u64((((w << 3) | (n >> 5)) ^ r) & m);
+            d4 += _mm_popcnt_u64((((w << 4) | (n >> 4)) ^ r) & m);
+            d5 += _mm_popcnt_u64((((w << 5) | (n >> 3)) ^ r) & m);
+            d6 += _mm_popcnt_u64((((w << 6) | (n >> 2)) ^ r) & m);
+            d7 += _mm_popcnt_u64((((w << 7) | (n >> 1)) ^ r) & m);
+        }
+        int * rxy = &_rxy[8*p];
+        rxy[0] = (int)_num_bits - d0;
+        rxy[1] = (int)_num_bits - d1;
+        rxy[2] = (int)_num_bits - d2;
+        rxy[3] = (int)_num_bits - d3;
+        rxy[4] = (int)_num_bits - d4;
+        rxy[5] = (int)_num_bits - d5;
+        rxy[6] = (int)_num_bits - d6;
+        rxy[7] = (int)_num_bits - d7;
+    }
+}
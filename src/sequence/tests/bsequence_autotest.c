@@ -20,8 +20,10 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 // 
 // test initialization of binary sequence
@@ -202,3 +204,71 @@ void autotest_bsequence_accumulate()
 }
 
 
+
+// correlate sequence against packed bytes at every offset and compare
+// with pushing the bits one at a time
+void bsequence_test_correlate_bytes(unsigned int _num_bits,
+                                    unsigned int _n)
+{
+    unsigned char v[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        v[i] = rand() & 0xff;
+
+    bsequence ref = bsequence_create(_num_bits);
+    bsequence rx  = bsequence_create(_num_bits);
+    for (i=0; i<_num_bits; i++)
+        bsequence_push(ref, rand() & 1);
+
+    unsigned int num_offsets = 8*_n - _num_bits + 1;
+    int rxy[num_offsets];
+    bsequence_correlate_bytes(ref, v, _n, rxy);
+
+    for (i=0; i<8*_n; i++) {
+        bsequence_push(rx, (v[i/8] >> (7-(i%8))) & 1);
+        if (i+1 >= _num_bits)
+            CONTEND_EQUALITY( rxy[i+1-_num_bits], bsequence_correlate(ref, rx) );
+    }
+
+    bsequence_destroy(ref);
+    bsequence_destroy(rx);
+}
+
+void autotest_bsequence_correlate_bytes_n13()  { bsequence_test_correlate_bytes( 13,  5); }
+void autotest_bsequence_correlate_bytes_n64()  { bsequence_test_correlate_bytes( 64, 40); }
+void autotest_bsequence_correlate_bytes_n100() { bsequence_test_correlate_bytes(100, 13); }
+void autotest_bsequence_correlate_bytes_n256() { bsequence_test_correlate_bytes(256, 90); }
+
+// compare run-time selected correlator kernels against the portable one
+void autotest_bsequence_scan_kernels()
+{
+    unsigned int num_words = 3;
+    unsigned int num_pos   = 20;
+    unsigned int num_bits  = 150;
+    uint64_t     mask      = ~(uint64_t)0 << (64*num_words - num_bits);
+    uint64_t     ref[num_words];
+    unsigned char v[num_pos + 8*num_words + 1];
+    int r0[8*num_pos];
+#if LIQUID_SIMD_POPCNT || LIQUID_SIMD_AVX2
+    int r1[8*num_pos];
+#endif
+    unsigned int i;
+    for (i=0; i<num_words; i++)
+        ref[i] = ((uint64_t)rand() << 40) ^ ((uint64_t)rand() << 20) ^ rand();
+    for (i=0; i<sizeof(v); i++)
+        v[i] = rand() & 0xff;
+
+    bsequence_scan_port(ref, num_words, mask, num_bits, v, num_pos, r0);
+#if LIQUID_SIMD_POPCNT
+    if (liquid_cpu_has(LIQUID_CPU_POPCNT)) {
+        bsequence_scan_popcnt(ref, num_words, mask, num_bits, v, num_pos, r1);
+        CONTEND_SAME_DATA(r0, r1, sizeof(r0));
+    }
+#endif
+#if LIQUID_SIMD_AVX2
+    if (liquid_cpu_has(LIQUID_CPU_AVX2)) {
+        bsequence_scan_avx2(ref, num_words, mask, num_bits, v, num_pos, r1);
+        CONTEND_SAME_DATA(r0, r1, sizeof(r0));
+    }
+#endif
+}
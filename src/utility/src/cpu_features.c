@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// cpu_features.c
+//
+// Run-time detection of processor SIMD extensions. The result is
+// computed once (on first use or at library load) and used to select
+// between kernels that are compiled for instruction sets beyond what
+// the library as a whole was configured for.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+// cached feature flags; zero until detection has run
+static unsigned int liquid_cpu_features_cache = 0;
+
+// query processor for supported extensions
+static unsigned int liquid_cpu_features_detect(void)
+{
+    unsigned int f = LIQUID_CPU_DETECTED;
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    // __builtin_cpu_supports() issues cpuid and also verifies that the
+    // operating system saves the extended (ymm/zmm) register state
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2"))     f |= LIQUID_CPU_SSE2;
+    if (__builtin_cpu_supports("sse3"))     f |= LIQUID_CPU_SSE3;
+    if (__builtin_cpu_supports("ssse3"))    f |= LIQUID_CPU_SSSE3;
+    if (__builtin_cpu_supports("sse4.1"))   f |= LIQUID_CPU_SSE41;
+    if (__builtin_cpu_supports("popcnt"))   f |= LIQUID_CPU_POPCNT;
+    if (__builtin_cpu_supports("avx"))      f |= LIQUID_CPU_AVX;
+    if (__builtin_cpu_supports("avx2"))     f |= LIQUID_CPU_AVX2;
+    if (__builtin_cpu_supports("fma"))      f |= LIQUID_CPU_FMA;
+    if (__builtin_cpu_supports("avx512f"))  f |= LIQUID_CPU_AVX512F;
+    if (__builtin_cpu_supports("avx512bw")) f |= LIQUID_CPU_AVX512BW;
+#  if defined(__clang__) || (__GNUC__ >= 11)
+    if (__builtin_cpu_supports("pclmul"))   f |= LIQUID_CPU_PCLMUL;
+#  endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    // NEON availability is fixed when the library is compiled
+    f |= LIQUID_CPU_NEON;
+#endif
+
+    // allow extensions to be masked off at run time, e.g. for testing
+    // fall-back kernels on a capable host: LIQUID_CPU_MASK=0x0f
+    char * mask = getenv("LIQUID_CPU_MASK");
+    if (mask != NULL)
+        f &= (unsigned int) strtoul(mask, NULL, 0) | LIQUID_CPU_DETECTED;
+
+    return f;
+}
+
+// run detection when the library is loaded so that kernel selection
+// never races on first use
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void liquid_cpu_features_init(void)
+{
+    liquid_cpu_features_cache = liquid_cpu_features_detect();
+}
+
+// get processor features as a bit field of LIQUID_CPU_* flags
+unsigned int liquid_cpu_features(void)
+{
+    if (liquid_cpu_features_cache == 0)
+        liquid_cpu_features_init();
+    return liquid_cpu_features_cache;
+}
+
+// test if all features in _flags are supported
+int liquid_cpu_has(unsigned int _flags)
+{
+    return (liquid_cpu_features() & _flags) == _flags;
+}
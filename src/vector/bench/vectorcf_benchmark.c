@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vectorcf_benchmark.c : benchmark complex vector operations
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// helper function to keep code base small
+//  _op     :   operation: 0 (mul), 1 (cexpj), 2 (carg)
+void vectorcf_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _n,
+                    int                 _op)
+{
+    float complex * x     = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * y     = (float complex*) malloc(_n*sizeof(float complex));
+    float *         theta = (float*)         malloc(_n*sizeof(float));
+    unsigned long int i;
+    for (i=0; i<_n; i++) {
+        x[i]     = randnf() + _Complex_I*randnf();
+        theta[i] = randnf();
+    }
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations = *_num_iterations * 16 / _n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        switch (_op) {
+        case 0: liquid_vectorcf_mul(x, x, _n, y);       break;
+        case 1: liquid_vectorcf_cexpj(theta, _n, y);    break;
+        default: liquid_vectorcf_carg(x, _n, theta);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    free(x);
+    free(y);
+    free(theta);
+}
+
+#define VECTORCF_BENCHMARK_API(N,OP)        \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ vectorcf_bench(_start, _finish, _num_iterations, N, OP); }
+
+void benchmark_vectorcf_mul_n16       VECTORCF_BENCHMARK_API(  16, 0)
+void benchmark_vectorcf_mul_n1024     VECTORCF_BENCHMARK_API(1024, 0)
+void benchmark_vectorcf_cexpj_n16     VECTORCF_BENCHMARK_API(  16, 1)
+void benchmark_vectorcf_cexpj_n1024   VECTORCF_BENCHMARK_API(1024, 1)
+void benchmark_vectorcf_carg_n16      VECTORCF_BENCHMARK_API(  16, 2)
+void benchmark_vectorcf_carg_n1024    VECTORCF_BENCHMARK_API(1024, 2)
+
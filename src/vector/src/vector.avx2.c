@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vector.avx2.c : floating-point vector operations (AVX2/FMA)
+//
+// This file is compiled with -mavx2 -mfma regardless of the build host;
+// the kernels are only called when the processor reports support for
+// these extensions at run time.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX, AVX2, FMA
+
+// multiply four pairs of interleaved complex values
+static inline __m256 vectorcf_mul_avx2(__m256 _x,
+                                       __m256 _y)
+{
+    __m256 yr = _mm256_moveldup_ps(_y);                 // [yr0 yr0 yr1 yr1 ...]
+    __m256 yi = _mm256_movehdup_ps(_y);                 // [yi0 yi0 yi1 yi1 ...]
+    __m256 xs = _mm256_permute_ps(_x, _MM_SHUFFLE(2,3,0,1)); // [xi0 xr0 ...]
+    return _mm256_fmaddsub_ps(_x, yr, _mm256_mul_ps(xs, yi));
+}
+
+// de-interleave eight complex values into real and imaginary parts
+static inline void vectorcf_split_avx2(float *  _x,
+                                       __m256 * _re,
+                                       __m256 * _im)
+{
+    __m256 v0 = _mm256_loadu_ps(&_x[0]);
+    __m256 v1 = _mm256_loadu_ps(&_x[8]);
+    // shuffle within lanes, then restore order of 64-bit pairs
+    __m256 re = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0));
+    __m256 im = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1));
+    *_re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re), _MM_SHUFFLE(3,1,2,0)));
+    *_im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im), _MM_SHUFFLE(3,1,2,0)));
+}
+
+// compute cos(theta), sin(theta) for eight values
+static inline void vector_sincos_avx2(__m256   _theta,
+                                      __m256 * _cos,
+                                      __m256 * _sin)
+{
+    // quadrant (round to nearest) and reduced argument
+    __m256i j  = _mm256_cvtps_epi32(_mm256_mul_ps(_theta, _mm256_set1_ps(LIQUID_VECTOR_2_OVER_PI)));
+    __m256  jf = _mm256_cvtepi32_ps(j);
+    __m256  r  = _mm256_fnmadd_ps(jf, _mm256_set1_ps(LIQUID_VECTOR_PIO2_1), _theta);
+    r = _mm256_fnmadd_ps(jf, _mm256_set1_ps(LIQUID_VECTOR_PIO2_2), r);
+    r = _mm256_fnmadd_ps(jf, _mm256_set1_ps(LIQUID_VECTOR_PIO2_3), r);
+    __m256  z  = _mm256_mul_ps(r, r);
+
+    // polynomials on [-pi/4, pi/4]
+    __m256 s = _mm256_fmadd_ps(_mm256_set1_ps(LIQUID_VECTOR_SIN_C0), z, _mm256_set1_ps(LIQUID_VECTOR_SIN_C1));
+    s = _mm256_fmadd_ps(s, z, _mm256_set1_ps(LIQUID_VECTOR_SIN_C2));
+    s = _mm256_fmadd_ps(_mm256_mul_ps(s, z), r, r);
+    __m256 c = _mm256_fmadd_ps(_mm256_set1_ps(LIQUID_VECTOR_COS_C0), z, _mm256_set1_ps(LIQUID_VECTOR_COS_C1));
+    c = _mm256_fmadd_ps(c, z, _mm256_set1_ps(LIQUID_VECTOR_COS_C2));
+    c = _mm256_fmadd_ps(_mm256_mul_ps(c, z), z, _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), _mm256_set1_ps(1.0f)));
+
+    // swap for odd quadrants, negate sin in quadrants 2,3 and cos in 1,2
+    __m256i one  = _mm256_set1_epi32(1);
+    __m256i two  = _mm256_set1_epi32(2);
+    __m256  swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, one), one));
+    __m256  sign_s = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, two), 30));
+    __m256  sign_c = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(j, one), two), 30));
+    *_cos = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), sign_c);
+    *_sin = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sign_s);
+}
+
+// compute atan2(y,x) for eight values
+static inline __m256 vector_atan2_avx2(__m256 _y,
+                                       __m256 _x)
+{
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 ax = _mm256_andnot_ps(sign, _x);
+    __m256 ay = _mm256_andnot_ps(sign, _y);
+    __m256 mx = _mm256_max_ps(ax, ay);
+    __m256 mn = _mm256_min_ps(ax, ay);
+
+    // ratio in [0,1], zero when both inputs are zero
+    __m256 a = _mm256_and_ps(_mm256_div_ps(mn, mx),
+                             _mm256_cmp_ps(mx, _mm256_setzero_ps(), _CMP_GT_OQ));
+
+    // reduce to [0, tan(pi/8)]
+    __m256 big = _mm256_cmp_ps(a, _mm256_set1_ps(LIQUID_VECTOR_TAN_PI_8), _CMP_GT_OQ);
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 t   = _mm256_blendv_ps(a, _mm256_div_ps(_mm256_sub_ps(a, one), _mm256_add_ps(a, one)), big);
+    __m256 off = _mm256_and_ps(big, _mm256_set1_ps(M_PI/4));
+
+    __m256 z = _mm256_mul_ps(t, t);
+    __m256 p = _mm256_fmadd_ps(_mm256_set1_ps(LIQUID_VECTOR_ATAN_C0), z, _mm256_set1_ps(LIQUID_VECTOR_ATAN_C1));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(LIQUID_VECTOR_ATAN_C2));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(LIQUID_VECTOR_ATAN_C3));
+    p = _mm256_fmadd_ps(_mm256_mul_ps(p, z), t, t);
+    __m256 r = _mm256_add_ps(off, p);
+
+    // octant corrections (sign of _x selects blend directly)
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(M_PI/2), r),
+                         _mm256_cmp_ps(ay, ax, _CMP_GT_OQ));
+    r = _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(M_PI), r), _x);
+    return _mm256_or_ps(r, _mm256_and_ps(_y, sign));
+}
+
+// z[i] = x[i] + y[i]
+void liquid_vectorf_add_avx2(float *      _x,
+                             float *      _y,
+                             unsigned int _n,
+                             float *      _z)
+{
+    unsigned int t = (_n >> 3) << 3;
+    unsigned int i;
+    for (i=0; i<t; i+=8)
+        _mm256_storeu_ps(&_z[i], _mm256_add_ps(_mm256_loadu_ps(&_x[i]), _mm256_loadu_ps(&_y[i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] + _y[i];
+}
+
+// y[i] = x[i] + v
+void liquid_vectorf_addscalar_avx2(float *      _x,
+                                   unsigned int _n,
+                                   float        _v,
+                                   float *      _y)
+{
+    __m256 v = _mm256_set1_ps(_v);
+    unsigned int t = (_n >> 3) << 3;
+    unsigned int i;
+    for (i=0; i<t; i+=8)
+        _mm256_storeu_ps(&_y[i], _mm256_add_ps(_mm256_loadu_ps(&_x[i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] + _v;
+}
+
+// z[i] = x[i] * y[i]
+void liquid_vectorf_mul_avx2(float *      _x,
+                             float *      _y,
+                             unsigned int _n,
+                             float *      _z)
+{
+    unsigned int t = (_n >> 3) << 3;
+    unsigned int i;
+    for (i=0; i<t; i+=8)
+        _mm256_storeu_ps(&_z[i], _mm256_mul_ps(_mm256_loadu_ps(&_x[i]), _mm256_loadu_ps(&_y[i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// y[i] = x[i] * v
+void liquid_vectorf_mulscalar_avx2(float *      _x,
+                                   unsigned int _n,
+                                   float        _v,
+                                   float *      _y)
+{
+    __m256 v = _mm256_set1_ps(_v);
+    unsigned int t = (_n >> 3) << 3;
+    unsigned int i;
+    for (i=0; i<t; i+=8)
+        _mm256_storeu_ps(&_y[i], _mm256_mul_ps(_mm256_loadu_ps(&_x[i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
+
+// y[i] = x[i] + v (complex)
+void liquid_vectorcf_addscalar_avx2(float complex * _x,
+                                    unsigned int    _n,
+                                    float complex   _v,
+                                    float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float vr = crealf(_v), vi = cimagf(_v);
+    __m256 v = _mm256_setr_ps(vr, vi, vr, vi, vr, vi, vr, vi);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm256_storeu_ps(&y[2*i], _mm256_add_ps(_mm256_loadu_ps(&x[2*i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] + _v;
+}
+
+// z[i] = x[i] * y[i] (complex)
+void liquid_vectorcf_mul_avx2(float complex * _x,
+                              float complex * _y,
+                              unsigned int    _n,
+                              float complex * _z)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float * z = (float*) _z;
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm256_storeu_ps(&z[2*i], vectorcf_mul_avx2(_mm256_loadu_ps(&x[2*i]), _mm256_loadu_ps(&y[2*i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// y[i] = x[i] * v (complex)
+void liquid_vectorcf_mulscalar_avx2(float complex * _x,
+                                    unsigned int    _n,
+                                    float complex   _v,
+                                    float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float vr = crealf(_v), vi = cimagf(_v);
+    __m256 v = _mm256_setr_ps(vr, vi, vr, vi, vr, vi, vr, vi);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm256_storeu_ps(&y[2*i], vectorcf_mul_avx2(_mm256_loadu_ps(&x[2*i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
+
+// x[i] = exp{ j theta[i] }
+void liquid_vectorcf_cexpj_avx2(float *         _theta,
+                                unsigned int    _n,
+                                float complex * _x)
+{
+    float * x = (float*) _x;
+    __m256 c, s;
+    unsigned int t = (_n >> 3) << 3;
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        vector_sincos_avx2(_mm256_loadu_ps(&_theta[i]), &c, &s);
+        // interleave within lanes, then across lanes
+        __m256 lo = _mm256_unpacklo_ps(c, s);
+        __m256 hi = _mm256_unpackhi_ps(c, s);
+        _mm256_storeu_ps(&x[2*i+0], _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(&x[2*i+8], _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _x[i] = cexpf(_Complex_I*_theta[i]);
+}
+
+// theta[i] = arg{ x[i] }
+void liquid_vectorcf_carg_avx2(float complex * _x,
+                               unsigned int    _n,
+                               float *         _theta)
+{
+    float * x = (float*) _x;
+    __m256 re, im;
+    unsigned int t = (_n >> 3) << 3;
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        vectorcf_split_avx2(&x[2*i], &re, &im);
+        _mm256_storeu_ps(&_theta[i], vector_atan2_avx2(im, re));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _theta[i] = cargf(_x[i]);
+}
+
+// y[i] = |x[i]|
+void liquid_vectorcf_abs_avx2(float complex * _x,
+                              unsigned int    _n,
+                              float *         _y)
+{
+    float * x = (float*) _x;
+    __m256 re, im;
+    unsigned int t = (_n >> 3) << 3;
+    unsigned int i;
+    for (i=0; i<t; i+=8) {
+        vectorcf_split_avx2(&x[2*i], &re, &im);
+        __m256 s = _mm256_fmadd_ps(re, re, _mm256_mul_ps(im, im));
+        _mm256_storeu_ps(&_y[i], _mm256_sqrt_ps(s));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = cabsf(_x[i]);
+}
+
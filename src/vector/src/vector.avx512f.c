@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vector.avx512f.c : floating-point vector operations (AVX-512F)
+//
+// This file is compiled with -mavx512f regardless of the build host;
+// the kernels are only called when the processor reports support for
+// these extensions at run time. Element-wise arithmetic only; the
+// trigonometric kernels are provided by the AVX2 object.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>  // AVX-512F
+
+// mask for the _r (< 16) lowest lanes
+#define VECTOR_MASK_AVX512F(_r) ((__mmask16)((1u << (_r)) - 1))
+
+// multiply eight pairs of interleaved complex values
+static inline __m512 vectorcf_mul_avx512f(__m512 _x,
+                                          __m512 _y)
+{
+    __m512 yr = _mm512_moveldup_ps(_y);
+    __m512 yi = _mm512_movehdup_ps(_y);
+    __m512 xs = _mm512_permute_ps(_x, _MM_SHUFFLE(2,3,0,1));
+    return _mm512_fmaddsub_ps(_x, yr, _mm512_mul_ps(xs, yi));
+}
+
+// z[i] = x[i] + y[i]
+void liquid_vectorf_add_avx512f(float *      _x,
+                                float *      _y,
+                                unsigned int _n,
+                                float *      _z)
+{
+    unsigned int i;
+    for (i=0; i+16<=_n; i+=16)
+        _mm512_storeu_ps(&_z[i], _mm512_add_ps(_mm512_loadu_ps(&_x[i]), _mm512_loadu_ps(&_y[i])));
+
+    // cleanup using masked load/store
+    if (i < _n) {
+        __mmask16 m = VECTOR_MASK_AVX512F(_n - i);
+        _mm512_mask_storeu_ps(&_z[i], m, _mm512_add_ps(_mm512_maskz_loadu_ps(m, &_x[i]),
+                                                       _mm512_maskz_loadu_ps(m, &_y[i])));
+    }
+}
+
+// y[i] = x[i] + v
+void liquid_vectorf_addscalar_avx512f(float *      _x,
+                                      unsigned int _n,
+                                      float        _v,
+                                      float *      _y)
+{
+    __m512 v = _mm512_set1_ps(_v);
+    unsigned int i;
+    for (i=0; i+16<=_n; i+=16)
+        _mm512_storeu_ps(&_y[i], _mm512_add_ps(_mm512_loadu_ps(&_x[i]), v));
+
+    // cleanup using masked load/store
+    if (i < _n) {
+        __mmask16 m = VECTOR_MASK_AVX512F(_n - i);
+        _mm512_mask_storeu_ps(&_y[i], m, _mm512_add_ps(_mm512_maskz_loadu_ps(m, &_x[i]), v));
+    }
+}
+
+// z[i] = x[i] * y[i]
+void liquid_vectorf_mul_avx512f(float *      _x,
+                                float *      _y,
+                                unsigned int _n,
+                                float *      _z)
+{
+    unsigned int i;
+    for (i=0; i+16<=_n; i+=16)
+        _mm512_storeu_ps(&_z[i], _mm512_mul_ps(_mm512_loadu_ps(&_x[i]), _mm512_loadu_ps(&_y[i])));
+
+    // cleanup using masked load/store
+    if (i < _n) {
+        __mmask16 m = VECTOR_MASK_AVX512F(_n - i);
+        _mm512_mask_storeu_ps(&_z[i], m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, &_x[i]),
+                                                       _mm512_maskz_loadu_ps(m, &_y[i])));
+    }
+}
+
+// y[i] = x[i] * v
+void liquid_vectorf_mulscalar_avx512f(float *      _x,
+                                      unsigned int _n,
+                                      float        _v,
+                                      float *      _y)
+{
+    __m512 v = _mm512_set1_ps(_v);
+    unsigned int i;
+    for (i=0; i+16<=_n; i+=16)
+        _mm512_storeu_ps(&_y[i], _mm512_mul_ps(_mm512_loadu_ps(&_x[i]), v));
+
+    // cleanup using masked load/store
+    if (i < _n) {
+        __mmask16 m = VECTOR_MASK_AVX512F(_n - i);
+        _mm512_mask_storeu_ps(&_y[i], m, _mm512_mul_ps(_mm512_maskz_loadu_ps(m, &_x[i]), v));
+    }
+}
+
+// y[i] = x[i] + v (complex)
+void liquid_vectorcf_addscalar_avx512f(float complex * _x,
+                                       unsigned int    _n,
+                                       float complex   _v,
+                                       float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    unsigned int n = 2*_n;
+    float vr = crealf(_v), vi = cimagf(_v);
+    __m512 v = _mm512_setr_ps(vr, vi, vr, vi, vr, vi, vr, vi,
+                              vr, vi, vr, vi, vr, vi, vr, vi);
+    unsigned int i;
+    for (i=0; i+16<=n; i+=16)
+        _mm512_storeu_ps(&y[i], _mm512_add_ps(_mm512_loadu_ps(&x[i]), v));
+
+    // cleanup using masked load/store
+    if (i < n) {
+        __mmask16 m = VECTOR_MASK_AVX512F(n - i);
+        _mm512_mask_storeu_ps(&y[i], m, _mm512_add_ps(_mm512_maskz_loadu_ps(m, &x[i]), v));
+    }
+}
+
+// z[i] = x[i] * y[i] (complex)
+void liquid_vectorcf_mul_avx512f(float complex * _x,
+                                 float complex * _y,
+                                 unsigned int    _n,
+                                 float complex * _z)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float * z = (float*) _z;
+    unsigned int n = 2*_n;
+    unsigned int i;
+    for (i=0; i+16<=n; i+=16)
+        _mm512_storeu_ps(&z[i], vectorcf_mul_avx512f(_mm512_loadu_ps(&x[i]), _mm512_loadu_ps(&y[i])));
+
+    // cleanup using masked load/store
+    if (i < n) {
+        __mmask16 m = VECTOR_MASK_AVX512F(n - i);
+        _mm512_mask_storeu_ps(&z[i], m, vectorcf_mul_avx512f(_mm512_maskz_loadu_ps(m, &x[i]),
+                                                             _mm512_maskz_loadu_ps(m, &y[i])));
+    }
+}
+
+// y[i] = x[i] * v (complex)
+void liquid_vectorcf_mulscalar_avx512f(float complex * _x,
+                                       unsigned int    _n,
+                                       float complex   _v,
+                                       float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    unsigned int n = 2*_n;
+    float vr = crealf(_v), vi = cimagf(_v);
+    __m512 v = _mm512_setr_ps(vr, vi, vr, vi, vr, vi, vr, vi,
+                              vr, vi, vr, vi, vr, vi, vr, vi);
+    unsigned int i;
+    for (i=0; i+16<=n; i+=16)
+        _mm512_storeu_ps(&y[i], vectorcf_mul_avx512f(_mm512_loadu_ps(&x[i]), v));
+
+    // cleanup using masked load/store
+    if (i < n) {
+        __mmask16 m = VECTOR_MASK_AVX512F(n - i);
+        _mm512_mask_storeu_ps(&y[i], m, vectorcf_mul_avx512f(_mm512_maskz_loadu_ps(m, &x[i]), v));
+    }
+}
+
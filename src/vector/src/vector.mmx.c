@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vector.mmx.c : floating-point vector operations (SSE)
+//
+// Real and complex vector operations using SSE/SSE2 (SSE3 if available),
+// selecting AVX2 or AVX-512F kernels at run time when the processor
+// supports them and the vectors are long enough to benefit.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_SSE && HAVE_XMMINTRIN_H
+#include <xmmintrin.h>  // SSE
+#endif
+
+#if HAVE_SSE2 && HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#if HAVE_SSE3 && HAVE_PMMINTRIN_H
+#include <pmmintrin.h>  // SSE3
+#endif
+
+// minimum lengths (in floats) for selecting wide-vector kernels
+#define LIQUID_VECTOR_MIN_AVX2      (16)
+#define LIQUID_VECTOR_MIN_AVX512F   (64)
+
+// run-time kernel selection for length-_n float operations
+#define VECTOR_USE_AVX2(_n)    ((_n) >= LIQUID_VECTOR_MIN_AVX2 && \
+                                liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA))
+#define VECTOR_USE_AVX512F(_n) ((_n) >= LIQUID_VECTOR_MIN_AVX512F && \
+                                liquid_cpu_has(LIQUID_CPU_AVX512F))
+
+// multiply two pairs of complex values: [x0 x1] * [y0 y1]
+static inline __m128 vectorcf_mul_sse(__m128 _x,
+                                      __m128 _y)
+{
+    // swap real/imaginary components of _x: [xi0 xr0 xi1 xr1]
+    __m128 xs = _mm_shuffle_ps(_x, _x, _MM_SHUFFLE(2,3,0,1));
+#if HAVE_SSE3 && HAVE_PMMINTRIN_H
+    __m128 yr = _mm_moveldup_ps(_y);    // [yr0 yr0 yr1 yr1]
+    __m128 yi = _mm_movehdup_ps(_y);    // [yi0 yi0 yi1 yi1]
+    return _mm_addsub_ps(_mm_mul_ps(_x, yr), _mm_mul_ps(xs, yi));
+#else
+    __m128 yr = _mm_shuffle_ps(_y, _y, _MM_SHUFFLE(2,2,0,0));
+    __m128 yi = _mm_shuffle_ps(_y, _y, _MM_SHUFFLE(3,3,1,1));
+    __m128 sign = _mm_castsi128_ps(_mm_set_epi32(0, 0x80000000, 0, 0x80000000));
+    return _mm_add_ps(_mm_mul_ps(_x, yr), _mm_xor_ps(_mm_mul_ps(xs, yi), sign));
+#endif
+}
+
+// select _b where _mask is set, _a otherwise
+static inline __m128 vector_select_sse(__m128 _mask,
+                                       __m128 _a,
+                                       __m128 _b)
+{
+    return _mm_or_ps(_mm_and_ps(_mask, _b), _mm_andnot_ps(_mask, _a));
+}
+
+// compute cos(theta), sin(theta) for four values
+static inline void vector_sincos_sse(__m128   _theta,
+                                     __m128 * _cos,
+                                     __m128 * _sin)
+{
+    // quadrant (round to nearest) and reduced argument
+    __m128i j  = _mm_cvtps_epi32(_mm_mul_ps(_theta, _mm_set1_ps(LIQUID_VECTOR_2_OVER_PI)));
+    __m128  jf = _mm_cvtepi32_ps(j);
+    __m128  r  = _mm_sub_ps(_theta, _mm_mul_ps(jf, _mm_set1_ps(LIQUID_VECTOR_PIO2_1)));
+    r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(LIQUID_VECTOR_PIO2_2)));
+    r = _mm_sub_ps(r, _mm_mul_ps(jf, _mm_set1_ps(LIQUID_VECTOR_PIO2_3)));
+    __m128  z  = _mm_mul_ps(r, r);
+
+    // polynomials on [-pi/4, pi/4]
+    __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(LIQUID_VECTOR_SIN_C0), z), _mm_set1_ps(LIQUID_VECTOR_SIN_C1));
+    s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(LIQUID_VECTOR_SIN_C2));
+    s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), r), r);
+    __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(LIQUID_VECTOR_COS_C0), z), _mm_set1_ps(LIQUID_VECTOR_COS_C1));
+    c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(LIQUID_VECTOR_COS_C2));
+    c = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(c, z), z), _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(z, _mm_set1_ps(0.5f))));
+
+    // swap for odd quadrants, negate sin in quadrants 2,3 and cos in 1,2
+    __m128i one  = _mm_set1_epi32(1);
+    __m128i two  = _mm_set1_epi32(2);
+    __m128  swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, one), one));
+    __m128  sign_s = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, two), 30));
+    __m128  sign_c = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, one), two), 30));
+    *_cos = _mm_xor_ps(vector_select_sse(swap, c, s), sign_c);
+    *_sin = _mm_xor_ps(vector_select_sse(swap, s, c), sign_s);
+}
+
+// compute atan2(y,x) for four values
+static inline __m128 vector_atan2_sse(__m128 _y,
+                                      __m128 _x)
+{
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 ax = _mm_andnot_ps(sign, _x);
+    __m128 ay = _mm_andnot_ps(sign, _y);
+    __m128 mx = _mm_max_ps(ax, ay);
+    __m128 mn = _mm_min_ps(ax, ay);
+
+    // ratio in [0,1], zero when both inputs are zero
+    __m128 a = _mm_and_ps(_mm_div_ps(mn, mx), _mm_cmpgt_ps(mx, _mm_setzero_ps()));
+
+    // reduce to [0, tan(pi/8)]
+    __m128 big = _mm_cmpgt_ps(a, _mm_set1_ps(LIQUID_VECTOR_TAN_PI_8));
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 t   = vector_select_sse(big, a, _mm_div_ps(_mm_sub_ps(a, one), _mm_add_ps(a, one)));
+    __m128 off = _mm_and_ps(big, _mm_set1_ps(M_PI/4));
+
+    __m128 z = _mm_mul_ps(t, t);
+    __m128 p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(LIQUID_VECTOR_ATAN_C0), z), _mm_set1_ps(LIQUID_VECTOR_ATAN_C1));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(LIQUID_VECTOR_ATAN_C2));
+    p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(LIQUID_VECTOR_ATAN_C3));
+    p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), t), t);
+    __m128 r = _mm_add_ps(off, p);
+
+    // octant corrections
+    r = vector_select_sse(_mm_cmpgt_ps(ay, ax), r, _mm_sub_ps(_mm_set1_ps(M_PI/2), r));
+    __m128 xneg = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(_x), 31));
+    r = vector_select_sse(xneg, r, _mm_sub_ps(_mm_set1_ps(M_PI), r));
+    return _mm_or_ps(r, _mm_and_ps(_y, sign));
+}
+
+//
+// real vectors
+//
+
+// basic vector addition
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorf_add(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+#if LIQUID_SIMD_AVX512F
+    if (VECTOR_USE_AVX512F(_n)) { liquid_vectorf_add_avx512f(_x, _y, _n, _z); return; }
+#endif
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(_n))    { liquid_vectorf_add_avx2(_x, _y, _n, _z);    return; }
+#endif
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(&_z[i], _mm_add_ps(_mm_loadu_ps(&_x[i]), _mm_loadu_ps(&_y[i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] + _y[i];
+}
+
+// basic vector scalar addition
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorf_addscalar(float *      _x,
+                              unsigned int _n,
+                              float        _v,
+                              float *      _y)
+{
+#if LIQUID_SIMD_AVX512F
+    if (VECTOR_USE_AVX512F(_n)) { liquid_vectorf_addscalar_avx512f(_x, _n, _v, _y); return; }
+#endif
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(_n))    { liquid_vectorf_addscalar_avx2(_x, _n, _v, _y);    return; }
+#endif
+    __m128 v = _mm_set1_ps(_v);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(&_y[i], _mm_add_ps(_mm_loadu_ps(&_x[i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] + _v;
+}
+
+// basic vector multiplication
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorf_mul(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+#if LIQUID_SIMD_AVX512F
+    if (VECTOR_USE_AVX512F(_n)) { liquid_vectorf_mul_avx512f(_x, _y, _n, _z); return; }
+#endif
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(_n))    { liquid_vectorf_mul_avx2(_x, _y, _n, _z);    return; }
+#endif
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(&_z[i], _mm_mul_ps(_mm_loadu_ps(&_x[i]), _mm_loadu_ps(&_y[i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// basic vector scalar multiplication
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorf_mulscalar(float *      _x,
+                              unsigned int _n,
+                              float        _v,
+                              float *      _y)
+{
+#if LIQUID_SIMD_AVX512F
+    if (VECTOR_USE_AVX512F(_n)) { liquid_vectorf_mulscalar_avx512f(_x, _n, _v, _y); return; }
+#endif
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(_n))    { liquid_vectorf_mulscalar_avx2(_x, _n, _v, _y);    return; }
+#endif
+    __m128 v = _mm_set1_ps(_v);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(&_y[i], _mm_mul_ps(_mm_loadu_ps(&_x[i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
+
+// compute sign of each element: x[i] = theta[i] > 0 ? 1 : -1
+//  _theta  :   input primitive array [size: _n x 1]
+//  _n      :   array length
+//  _x      :   output array pointer [size: _n x 1]
+void liquid_vectorf_cexpj(float *      _theta,
+                          unsigned int _n,
+                          float *      _x)
+{
+    __m128 one  = _mm_set1_ps(1.0f);
+    __m128 sign = _mm_set1_ps(-0.0f);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 pos = _mm_cmpgt_ps(_mm_loadu_ps(&_theta[i]), _mm_setzero_ps());
+        _mm_storeu_ps(&_x[i], _mm_or_ps(one, _mm_andnot_ps(pos, sign)));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _x[i] = _theta[i] > 0 ? 1.0 : -1.0;
+}
+
+// compute angle of each element: theta[i] = x[i] > 0 ? 0 : pi
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _theta  :   output primitive array [size: _n x 1]
+void liquid_vectorf_carg(float *      _x,
+                         unsigned int _n,
+                         float *      _theta)
+{
+    __m128 pi = _mm_set1_ps(M_PI);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 pos = _mm_cmpgt_ps(_mm_loadu_ps(&_x[i]), _mm_setzero_ps());
+        _mm_storeu_ps(&_theta[i], _mm_andnot_ps(pos, pi));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _theta[i] = _x[i] > 0 ? 0 : M_PI;
+}
+
+// compute absolute value of each element: y[i] = |x[i]|
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output primitive array pointer [size: _n x 1]
+void liquid_vectorf_abs(float *      _x,
+                        unsigned int _n,
+                        float *      _y)
+{
+    __m128 sign = _mm_set1_ps(-0.0f);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        _mm_storeu_ps(&_y[i], _mm_andnot_ps(sign, _mm_loadu_ps(&_x[i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = fabsf(_x[i]);
+}
+
+// compute l2-norm on vector
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+float liquid_vectorf_norm(float *      _x,
+                          unsigned int _n)
+{
+    return sqrtf(liquid_sumsqf(_x, _n));
+}
+
+// scale vector to its l2-norm
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorf_normalize(float *      _x,
+                              unsigned int _n,
+                              float *      _y)
+{
+    liquid_vectorf_mulscalar(_x, _n, 1.0f / liquid_vectorf_norm(_x, _n), _y);
+}
+
+//
+// complex vectors
+//
+
+// basic vector addition
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_add(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    // run real addition on interleaved components
+    liquid_vectorf_add((float*)_x, (float*)_y, 2*_n, (float*)_z);
+}
+
+// basic vector scalar addition
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_addscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _v,
+                               float complex * _y)
+{
+#if LIQUID_SIMD_AVX512F
+    if (VECTOR_USE_AVX512F(2*_n)) { liquid_vectorcf_addscalar_avx512f(_x, _n, _v, _y); return; }
+#endif
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(2*_n))    { liquid_vectorcf_addscalar_avx2(_x, _n, _v, _y);    return; }
+#endif
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m128 v = _mm_set_ps(cimagf(_v), crealf(_v), cimagf(_v), crealf(_v));
+    unsigned int t = (_n >> 1) << 1;
+    unsigned int i;
+    for (i=0; i<t; i+=2)
+        _mm_storeu_ps(&y[2*i], _mm_add_ps(_mm_loadu_ps(&x[2*i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] + _v;
+}
+
+// basic vector multiplication
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_mul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+#if LIQUID_SIMD_AVX512F
+    if (VECTOR_USE_AVX512F(2*_n)) { liquid_vectorcf_mul_avx512f(_x, _y, _n, _z); return; }
+#endif
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(2*_n))    { liquid_vectorcf_mul_avx2(_x, _y, _n, _z);    return; }
+#endif
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float * z = (float*) _z;
+    unsigned int t = (_n >> 1) << 1;
+    unsigned int i;
+    for (i=0; i<t; i+=2)
+        _mm_storeu_ps(&z[2*i], vectorcf_mul_sse(_mm_loadu_ps(&x[2*i]), _mm_loadu_ps(&y[2*i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// basic vector scalar multiplication
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_mulscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _v,
+                               float complex * _y)
+{
+#if LIQUID_SIMD_AVX512F
+    if (VECTOR_USE_AVX512F(2*_n)) { liquid_vectorcf_mulscalar_avx512f(_x, _n, _v, _y); return; }
+#endif
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(2*_n))    { liquid_vectorcf_mulscalar_avx2(_x, _n, _v, _y);    return; }
+#endif
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    __m128 v = _mm_set_ps(cimagf(_v), crealf(_v), cimagf(_v), crealf(_v));
+    unsigned int t = (_n >> 1) << 1;
+    unsigned int i;
+    for (i=0; i<t; i+=2)
+        _mm_storeu_ps(&y[2*i], vectorcf_mul_sse(_mm_loadu_ps(&x[2*i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
+
+// compute complex phase rotation: x[i] = exp{ j theta[i] }
+//  _theta  :   input primitive array [size: _n x 1]
+//  _n      :   array length
+//  _x      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_cexpj(float *         _theta,
+                           unsigned int    _n,
+                           float complex * _x)
+{
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(2*_n)) { liquid_vectorcf_cexpj_avx2(_theta, _n, _x); return; }
+#endif
+    float * x = (float*) _x;
+    __m128 c, s;
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        vector_sincos_sse(_mm_loadu_ps(&_theta[i]), &c, &s);
+        _mm_storeu_ps(&x[2*i+0], _mm_unpacklo_ps(c, s));
+        _mm_storeu_ps(&x[2*i+4], _mm_unpackhi_ps(c, s));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _x[i] = cexpf(_Complex_I*_theta[i]);
+}
+
+// compute angle of each element: theta[i] = arg{ x[i] }
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _theta  :   output primitive array [size: _n x 1]
+void liquid_vectorcf_carg(float complex * _x,
+                          unsigned int    _n,
+                          float *         _theta)
+{
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(2*_n)) { liquid_vectorcf_carg_avx2(_x, _n, _theta); return; }
+#endif
+    float * x = (float*) _x;
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // de-interleave real and imaginary components
+        __m128 v0 = _mm_loadu_ps(&x[2*i+0]);
+        __m128 v1 = _mm_loadu_ps(&x[2*i+4]);
+        __m128 re = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0));
+        __m128 im = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1));
+        _mm_storeu_ps(&_theta[i], vector_atan2_sse(im, re));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _theta[i] = cargf(_x[i]);
+}
+
+// compute absolute value of each element: y[i] = |x[i]|
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output primitive array pointer [size: _n x 1]
+void liquid_vectorcf_abs(float complex * _x,
+                         unsigned int    _n,
+                         float *         _y)
+{
+#if LIQUID_SIMD_AVX2
+    if (VECTOR_USE_AVX2(2*_n)) { liquid_vectorcf_abs_avx2(_x, _n, _y); return; }
+#endif
+    float * x = (float*) _x;
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        __m128 v0 = _mm_loadu_ps(&x[2*i+0]);
+        __m128 v1 = _mm_loadu_ps(&x[2*i+4]);
+        v0 = _mm_mul_ps(v0, v0);
+        v1 = _mm_mul_ps(v1, v1);
+        __m128 s = _mm_add_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2,0,2,0)),
+                              _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3,1,3,1)));
+        _mm_storeu_ps(&_y[i], _mm_sqrt_ps(s));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = cabsf(_x[i]);
+}
+
+// compute l2-norm on vector
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+float liquid_vectorcf_norm(float complex * _x,
+                           unsigned int    _n)
+{
+    return sqrtf(liquid_sumsqcf(_x, _n));
+}
+
+// scale vector to its l2-norm
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorcf_normalize(float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    // scale interleaved components by real-valued inverse
+    float norm_inv = 1.0f / liquid_vectorcf_norm(_x, _n);
+    liquid_vectorf_mulscalar((float*)_x, 2*_n, norm_inv, (float*)_y);
+}
+
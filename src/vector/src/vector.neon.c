@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// vector.neon.c : floating-point vector operations (ARM Neon)
+//
+// Uses ARMv7 Neon intrinsics only: division and square root are computed
+// from the reciprocal (square-root) estimates with Newton-Raphson steps.
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for ARM Neon
+#include <arm_neon.h>
+
+// compute 1/_d using estimate and two Newton-Raphson iterations
+static inline float32x4_t vector_recip_neon(float32x4_t _d)
+{
+    float32x4_t r = vrecpeq_f32(_d);
+    r = vmulq_f32(r, vrecpsq_f32(_d, r));
+    r = vmulq_f32(r, vrecpsq_f32(_d, r));
+    return r;
+}
+
+// compute sqrt(_v) for _v >= 0 using reciprocal square-root estimate
+static inline float32x4_t vector_sqrt_neon(float32x4_t _v)
+{
+    float32x4_t r = vrsqrteq_f32(_v);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(_v, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(_v, r), r));
+    // sqrt(0) = 0 (estimate is infinite)
+    uint32x4_t zero = vceqq_f32(_v, vdupq_n_f32(0.0f));
+    return vbslq_f32(zero, vdupq_n_f32(0.0f), vmulq_f32(_v, r));
+}
+
+// compute cos(theta), sin(theta) for four values
+static inline void vector_sincos_neon(float32x4_t   _theta,
+                                      float32x4_t * _cos,
+                                      float32x4_t * _sin)
+{
+    // quadrant (round to nearest; conversion truncates toward zero)
+    float32x4_t q    = vmulq_n_f32(_theta, LIQUID_VECTOR_2_OVER_PI);
+    uint32x4_t  qneg = vcltq_f32(q, vdupq_n_f32(0.0f));
+    int32x4_t   j    = vcvtq_s32_f32(vaddq_f32(q, vbslq_f32(qneg, vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f))));
+    float32x4_t jf   = vcvtq_f32_s32(j);
+    float32x4_t r    = vmlsq_n_f32(_theta, jf, LIQUID_VECTOR_PIO2_1);
+    r = vmlsq_n_f32(r, jf, LIQUID_VECTOR_PIO2_2);
+    r = vmlsq_n_f32(r, jf, LIQUID_VECTOR_PIO2_3);
+    float32x4_t z = vmulq_f32(r, r);
+
+    // polynomials on [-pi/4, pi/4]
+    float32x4_t s = vmlaq_n_f32(vdupq_n_f32(LIQUID_VECTOR_SIN_C1), z, LIQUID_VECTOR_SIN_C0);
+    s = vmlaq_f32(vdupq_n_f32(LIQUID_VECTOR_SIN_C2), s, z);
+    s = vmlaq_f32(r, vmulq_f32(s, z), r);
+    float32x4_t c = vmlaq_n_f32(vdupq_n_f32(LIQUID_VECTOR_COS_C1), z, LIQUID_VECTOR_COS_C0);
+    c = vmlaq_f32(vdupq_n_f32(LIQUID_VECTOR_COS_C2), c, z);
+    c = vmlaq_f32(vmlsq_n_f32(vdupq_n_f32(1.0f), z, 0.5f), vmulq_f32(c, z), z);
+
+    // swap for odd quadrants, negate sin in quadrants 2,3 and cos in 1,2
+    uint32x4_t ju     = vreinterpretq_u32_s32(j);
+    uint32x4_t one    = vdupq_n_u32(1);
+    uint32x4_t two    = vdupq_n_u32(2);
+    uint32x4_t swap   = vceqq_u32(vandq_u32(ju, one), one);
+    uint32x4_t sign_s = vshlq_n_u32(vandq_u32(ju, two), 30);
+    uint32x4_t sign_c = vshlq_n_u32(vandq_u32(vaddq_u32(ju, one), two), 30);
+    *_cos = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, s, c)), sign_c));
+    *_sin = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vbslq_f32(swap, c, s)), sign_s));
+}
+
+// compute atan2(y,x) for four values
+static inline float32x4_t vector_atan2_neon(float32x4_t _y,
+                                            float32x4_t _x)
+{
+    float32x4_t ax = vabsq_f32(_x);
+    float32x4_t ay = vabsq_f32(_y);
+    float32x4_t mx = vmaxq_f32(ax, ay);
+    float32x4_t mn = vminq_f32(ax, ay);
+
+    // ratio in [0,1], zero when both inputs are zero
+    uint32x4_t  nz = vcgtq_f32(mx, vdupq_n_f32(0.0f));
+    float32x4_t a  = vbslq_f32(nz, vmulq_f32(mn, vector_recip_neon(mx)), vdupq_n_f32(0.0f));
+
+    // reduce to [0, tan(pi/8)]
+    uint32x4_t  big = vcgtq_f32(a, vdupq_n_f32(LIQUID_VECTOR_TAN_PI_8));
+    float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t tr  = vmulq_f32(vsubq_f32(a, one), vector_recip_neon(vaddq_f32(a, one)));
+    float32x4_t t   = vbslq_f32(big, tr, a);
+    float32x4_t off = vbslq_f32(big, vdupq_n_f32(M_PI/4), vdupq_n_f32(0.0f));
+
+    float32x4_t z = vmulq_f32(t, t);
+    float32x4_t p = vmlaq_n_f32(vdupq_n_f32(LIQUID_VECTOR_ATAN_C1), z, LIQUID_VECTOR_ATAN_C0);
+    p = vmlaq_f32(vdupq_n_f32(LIQUID_VECTOR_ATAN_C2), p, z);
+    p = vmlaq_f32(vdupq_n_f32(LIQUID_VECTOR_ATAN_C3), p, z);
+    p = vmlaq_f32(t, vmulq_f32(p, z), t);
+    float32x4_t r = vaddq_f32(off, p);
+
+    // octant corrections
+    r = vbslq_f32(vcgtq_f32(ay, ax), vsubq_f32(vdupq_n_f32(M_PI/2), r), r);
+    uint32x4_t xneg = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_f32(_x), 31));
+    r = vbslq_f32(xneg, vsubq_f32(vdupq_n_f32(M_PI), r), r);
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(_y), vdupq_n_u32(0x80000000));
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(r), sign));
+}
+
+//
+// real vectors
+//
+
+// basic vector addition
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorf_add(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        vst1q_f32(&_z[i], vaddq_f32(vld1q_f32(&_x[i]), vld1q_f32(&_y[i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] + _y[i];
+}
+
+// basic vector scalar addition
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorf_addscalar(float *      _x,
+                              unsigned int _n,
+                              float        _v,
+                              float *      _y)
+{
+    float32x4_t v = vdupq_n_f32(_v);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        vst1q_f32(&_y[i], vaddq_f32(vld1q_f32(&_x[i]), v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] + _v;
+}
+
+// basic vector multiplication
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorf_mul(float *      _x,
+                        float *      _y,
+                        unsigned int _n,
+                        float *      _z)
+{
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        vst1q_f32(&_z[i], vmulq_f32(vld1q_f32(&_x[i]), vld1q_f32(&_y[i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// basic vector scalar multiplication
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorf_mulscalar(float *      _x,
+                              unsigned int _n,
+                              float        _v,
+                              float *      _y)
+{
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        vst1q_f32(&_y[i], vmulq_n_f32(vld1q_f32(&_x[i]), _v));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
+
+// compute sign of each element: x[i] = theta[i] > 0 ? 1 : -1
+//  _theta  :   input primitive array [size: _n x 1]
+//  _n      :   array length
+//  _x      :   output array pointer [size: _n x 1]
+void liquid_vectorf_cexpj(float *      _theta,
+                          unsigned int _n,
+                          float *      _x)
+{
+    float32x4_t pos_one = vdupq_n_f32( 1.0f);
+    float32x4_t neg_one = vdupq_n_f32(-1.0f);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        uint32x4_t pos = vcgtq_f32(vld1q_f32(&_theta[i]), vdupq_n_f32(0.0f));
+        vst1q_f32(&_x[i], vbslq_f32(pos, pos_one, neg_one));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _x[i] = _theta[i] > 0 ? 1.0 : -1.0;
+}
+
+// compute angle of each element: theta[i] = x[i] > 0 ? 0 : pi
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _theta  :   output primitive array [size: _n x 1]
+void liquid_vectorf_carg(float *      _x,
+                         unsigned int _n,
+                         float *      _theta)
+{
+    float32x4_t pi   = vdupq_n_f32(M_PI);
+    float32x4_t zero = vdupq_n_f32(0.0f);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        uint32x4_t pos = vcgtq_f32(vld1q_f32(&_x[i]), zero);
+        vst1q_f32(&_theta[i], vbslq_f32(pos, zero, pi));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _theta[i] = _x[i] > 0 ? 0 : M_PI;
+}
+
+// compute absolute value of each element: y[i] = |x[i]|
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output primitive array pointer [size: _n x 1]
+void liquid_vectorf_abs(float *      _x,
+                        unsigned int _n,
+                        float *      _y)
+{
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4)
+        vst1q_f32(&_y[i], vabsq_f32(vld1q_f32(&_x[i])));
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = fabsf(_x[i]);
+}
+
+// compute l2-norm on vector
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+float liquid_vectorf_norm(float *      _x,
+                          unsigned int _n)
+{
+    return sqrtf(liquid_sumsqf(_x, _n));
+}
+
+// scale vector to its l2-norm
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorf_normalize(float *      _x,
+                              unsigned int _n,
+                              float *      _y)
+{
+    liquid_vectorf_mulscalar(_x, _n, 1.0f / liquid_vectorf_norm(_x, _n), _y);
+}
+
+//
+// complex vectors
+//
+
+// basic vector addition
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_add(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    // run real addition on interleaved components
+    liquid_vectorf_add((float*)_x, (float*)_y, 2*_n, (float*)_z);
+}
+
+// basic vector scalar addition
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_addscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _v,
+                               float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float32x4x2_t v;
+    v.val[0] = vdupq_n_f32(crealf(_v));
+    v.val[1] = vdupq_n_f32(cimagf(_v));
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        float32x4x2_t a = vld2q_f32(&x[2*i]);
+        a.val[0] = vaddq_f32(a.val[0], v.val[0]);
+        a.val[1] = vaddq_f32(a.val[1], v.val[1]);
+        vst2q_f32(&y[2*i], a);
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] + _v;
+}
+
+// basic vector multiplication
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_mul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float * z = (float*) _z;
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        // load de-interleaved real, imaginary components
+        float32x4x2_t a = vld2q_f32(&x[2*i]);
+        float32x4x2_t b = vld2q_f32(&y[2*i]);
+        float32x4x2_t c;
+        c.val[0] = vmlsq_f32(vmulq_f32(a.val[0], b.val[0]), a.val[1], b.val[1]);
+        c.val[1] = vmlaq_f32(vmulq_f32(a.val[0], b.val[1]), a.val[1], b.val[0]);
+        vst2q_f32(&z[2*i], c);
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// basic vector scalar multiplication
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_mulscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _v,
+                               float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float vr = crealf(_v);
+    float vi = cimagf(_v);
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        float32x4x2_t a = vld2q_f32(&x[2*i]);
+        float32x4x2_t c;
+        c.val[0] = vmlsq_n_f32(vmulq_n_f32(a.val[0], vr), a.val[1], vi);
+        c.val[1] = vmlaq_n_f32(vmulq_n_f32(a.val[0], vi), a.val[1], vr);
+        vst2q_f32(&y[2*i], c);
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
+
+// compute complex phase rotation: x[i] = exp{ j theta[i] }
+//  _theta  :   input primitive array [size: _n x 1]
+//  _n      :   array length
+//  _x      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_cexpj(float *         _theta,
+                           unsigned int    _n,
+                           float complex * _x)
+{
+    float * x = (float*) _x;
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        float32x4x2_t c;
+        vector_sincos_neon(vld1q_f32(&_theta[i]), &c.val[0], &c.val[1]);
+        vst2q_f32(&x[2*i], c);
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _x[i] = cexpf(_Complex_I*_theta[i]);
+}
+
+// compute angle of each element: theta[i] = arg{ x[i] }
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _theta  :   output primitive array [size: _n x 1]
+void liquid_vectorcf_carg(float complex * _x,
+                          unsigned int    _n,
+                          float *         _theta)
+{
+    float * x = (float*) _x;
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        float32x4x2_t a = vld2q_f32(&x[2*i]);
+        vst1q_f32(&_theta[i], vector_atan2_neon(a.val[1], a.val[0]));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _theta[i] = cargf(_x[i]);
+}
+
+// compute absolute value of each element: y[i] = |x[i]|
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output primitive array pointer [size: _n x 1]
+void liquid_vectorcf_abs(float complex * _x,
+                         unsigned int    _n,
+                         float *         _y)
+{
+    float * x = (float*) _x;
+    unsigned int t = (_n >> 2) << 2;
+    unsigned int i;
+    for (i=0; i<t; i+=4) {
+        float32x4x2_t a = vld2q_f32(&x[2*i]);
+        float32x4_t   s = vmlaq_f32(vmulq_f32(a.val[0], a.val[0]), a.val[1], a.val[1]);
+        vst1q_f32(&_y[i], vector_sqrt_neon(s));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = cabsf(_x[i]);
+}
+
+// compute l2-norm on vector
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+float liquid_vectorcf_norm(float complex * _x,
+                           unsigned int    _n)
+{
+    return sqrtf(liquid_sumsqcf(_x, _n));
+}
+
+// scale vector to its l2-norm
+//  _x      :   input array [size: _n x 1]
+//  _n      :   array length
+//  _y      :   output array [size: _n x 1]
+void liquid_vectorcf_normalize(float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    // scale interleaved components by real-valued inverse
+    float norm_inv = 1.0f / liquid_vectorcf_norm(_x, _n);
+    liquid_vectorf_mulscalar((float*)_x, 2*_n, norm_inv, (float*)_y);
+}
+
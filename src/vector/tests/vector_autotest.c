@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2007 - 2020 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// compare real vector operations to ordinal computation
+//  _n      :   vector length
+void vectorf_test(unsigned int _n)
+{
+    float tol = 1e-6f;
+    float x[_n], y[_n], z[_n], w[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        x[i] = randnf();
+        y[i] = randnf();
+    }
+    float v = randnf();
+
+    liquid_vectorf_add(x, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(z[i], x[i] + y[i], tol);
+
+    liquid_vectorf_addscalar(x, _n, v, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(z[i], x[i] + v, tol);
+
+    liquid_vectorf_mul(x, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(z[i], x[i] * y[i], tol);
+
+    liquid_vectorf_mulscalar(x, _n, v, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(z[i], x[i] * v, tol);
+
+    liquid_vectorf_cexpj(x, _n, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], x[i] > 0 ? 1.0f : -1.0f);
+
+    liquid_vectorf_carg(x, _n, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(z[i], x[i] > 0 ? 0.0f : M_PI, tol);
+
+    liquid_vectorf_abs(x, _n, z);
+    for (i=0; i<_n; i++) CONTEND_EQUALITY(z[i], fabsf(x[i]));
+
+    float norm = 0;
+    for (i=0; i<_n; i++) norm += x[i]*x[i];
+    norm = sqrtf(norm);
+    CONTEND_DELTA(liquid_vectorf_norm(x, _n), norm, 1e-5f*norm);
+
+    // in-place operation
+    memmove(w, x, _n*sizeof(float));
+    liquid_vectorf_normalize(w, _n, w);
+    for (i=0; i<_n; i++) CONTEND_DELTA(w[i], x[i] / norm, tol);
+}
+
+// compare complex vector operations to ordinal computation
+//  _n      :   vector length
+void vectorcf_test(unsigned int _n)
+{
+    float tol = 1e-5f;
+    float complex x[_n], y[_n], z[_n], w[_n];
+    float theta[_n], r[_n];
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        y[i] = randnf() + _Complex_I*randnf();
+        theta[i] = 20.0f*randnf();
+    }
+    float complex v = randnf() + _Complex_I*randnf();
+
+    // include values on the axes (and the origin)
+    if (_n > 4) {
+        x[0] = 0; x[1] = -1.0f; x[2] = _Complex_I; x[3] = -2.0f*_Complex_I;
+    }
+
+    liquid_vectorcf_add(x, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(z[i] - (x[i] + y[i])), 0, tol);
+
+    liquid_vectorcf_addscalar(x, _n, v, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(z[i] - (x[i] + v)), 0, tol);
+
+    liquid_vectorcf_mul(x, y, _n, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*y[i]), 0, tol);
+
+    liquid_vectorcf_mulscalar(x, _n, v, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*v), 0, tol);
+
+    liquid_vectorcf_cexpj(theta, _n, z);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(z[i] - cexpf(_Complex_I*theta[i])), 0, tol);
+
+    liquid_vectorcf_carg(x, _n, r);
+    for (i=0; i<_n; i++) CONTEND_DELTA(r[i], cargf(x[i]), tol);
+
+    liquid_vectorcf_abs(x, _n, r);
+    for (i=0; i<_n; i++) CONTEND_DELTA(r[i], cabsf(x[i]), tol);
+
+    float norm = 0;
+    for (i=0; i<_n; i++) norm += crealf(x[i]*conjf(x[i]));
+    norm = sqrtf(norm);
+    CONTEND_DELTA(liquid_vectorcf_norm(x, _n), norm, 1e-5f*norm);
+
+    // in-place operation
+    memmove(w, x, _n*sizeof(float complex));
+    liquid_vectorcf_normalize(w, _n, w);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(w[i] - x[i]/norm), 0, tol);
+
+    memmove(w, x, _n*sizeof(float complex));
+    liquid_vectorcf_mul(w, y, _n, w);
+    for (i=0; i<_n; i++) CONTEND_DELTA(cabsf(w[i] - x[i]*y[i]), 0, tol);
+}
+
+// lengths cover baseline, remainder and wide-vector kernels
+void autotest_vectorf_n1()      { vectorf_test(  1); }
+void autotest_vectorf_n7()      { vectorf_test(  7); }
+void autotest_vectorf_n16()     { vectorf_test( 16); }
+void autotest_vectorf_n37()     { vectorf_test( 37); }
+void autotest_vectorf_n255()    { vectorf_test(255); }
+void autotest_vectorcf_n1()     { vectorcf_test(  1); }
+void autotest_vectorcf_n7()     { vectorcf_test(  7); }
+void autotest_vectorcf_n16()    { vectorcf_test( 16); }
+void autotest_vectorcf_n37()    { vectorcf_test( 37); }
+void autotest_vectorcf_n255()   { vectorcf_test(255); }
+
+// compare run-time selected wide-vector kernels to ordinal computation
+// over all lengths, including those below the selection threshold
+void autotest_vectorcf_simd_kernels()
+{
+#if LIQUID_SIMD_AVX2 || LIQUID_SIMD_AVX512F
+    float tol = 1e-5f;
+    float complex x[100], y[100], z[100];
+    float theta[100], r[100];
+    float complex v = randnf() + _Complex_I*randnf();
+    unsigned int i, n;
+    for (i=0; i<100; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        y[i] = randnf() + _Complex_I*randnf();
+        theta[i] = 20.0f*randnf();
+    }
+
+    for (n=1; n<=100; n++) {
+#if LIQUID_SIMD_AVX2
+        if (liquid_cpu_has(LIQUID_CPU_AVX2 | LIQUID_CPU_FMA)) {
+            liquid_vectorcf_mul_avx2(x, y, n, z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*y[i]), 0, tol);
+            liquid_vectorcf_mulscalar_avx2(x, n, v, z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*v), 0, tol);
+            liquid_vectorcf_addscalar_avx2(x, n, v, z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - (x[i]+v)), 0, tol);
+            liquid_vectorf_add_avx2((float*)x, (float*)y, 2*n, (float*)z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - (x[i]+y[i])), 0, tol);
+            liquid_vectorf_mul_avx2((float*)x, (float*)y, 2*n, (float*)z);
+            for (i=0; i<n; i++) CONTEND_DELTA(crealf(z[i]), crealf(x[i])*crealf(y[i]), tol);
+            liquid_vectorcf_cexpj_avx2(theta, n, z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - cexpf(_Complex_I*theta[i])), 0, tol);
+            liquid_vectorcf_carg_avx2(x, n, r);
+            for (i=0; i<n; i++) CONTEND_DELTA(r[i], cargf(x[i]), tol);
+            liquid_vectorcf_abs_avx2(x, n, r);
+            for (i=0; i<n; i++) CONTEND_DELTA(r[i], cabsf(x[i]), tol);
+        }
+#endif
+#if LIQUID_SIMD_AVX512F
+        if (liquid_cpu_has(LIQUID_CPU_AVX512F)) {
+            liquid_vectorcf_mul_avx512f(x, y, n, z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*y[i]), 0, tol);
+            liquid_vectorcf_mulscalar_avx512f(x, n, v, z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - x[i]*v), 0, tol);
+            liquid_vectorcf_addscalar_avx512f(x, n, v, z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - (x[i]+v)), 0, tol);
+            liquid_vectorf_add_avx512f((float*)x, (float*)y, 2*n, (float*)z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - (x[i]+y[i])), 0, tol);
+            liquid_vectorf_mulscalar_avx512f((float*)x, 2*n, 0.5f, (float*)z);
+            for (i=0; i<n; i++) CONTEND_DELTA(cabsf(z[i] - 0.5f*x[i]), 0, tol);
+        }
+#endif
+    }
+#endif
+}
+